@@ -91,6 +91,8 @@ static void display_test_reload_config(DisplayTest* instance) {
         instance->config_contrast,
         instance->config_regulation_ratio,
         instance->config_bias);
+    // Controller was reset, display memory no longer matches last frame
+    gui_invalidate_display(instance->gui);
 }
 
 static void display_config_set_bias(VariableItem* item) {
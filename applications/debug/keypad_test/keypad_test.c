@@ -4,6 +4,16 @@
 
 #define TAG "KeypadTest"
 
+// Key discs, in press[] order: right, left, up, down, ok
+static const uint8_t keypad_test_disc[5][2] = {
+    {118, 26},
+    {82, 26},
+    {100, 8},
+    {100, 44},
+    {100, 26},
+};
+#define KEYPAD_TEST_DISC_RADIUS (5)
+
 typedef struct {
     bool press[5];
     uint16_t up;
@@ -45,17 +55,59 @@ static void keypad_test_render_callback(Canvas* canvas, void* ctx) {
     canvas_draw_str(canvas, 0, 48, strings[0]);
     canvas_draw_circle(canvas, 100, 26, 25);
 
-    if(state->press[0]) canvas_draw_disc(canvas, 118, 26, 5);
-    if(state->press[1]) canvas_draw_disc(canvas, 82, 26, 5);
-    if(state->press[2]) canvas_draw_disc(canvas, 100, 8, 5);
-    if(state->press[3]) canvas_draw_disc(canvas, 100, 44, 5);
-    if(state->press[4]) canvas_draw_disc(canvas, 100, 26, 5);
+    for(size_t i = 0; i < COUNT_OF(keypad_test_disc); i++) {
+        if(state->press[i]) {
+            canvas_draw_disc(
+                canvas,
+                keypad_test_disc[i][0],
+                keypad_test_disc[i][1],
+                KEYPAD_TEST_DISC_RADIUS);
+        }
+    }
 
     canvas_draw_str(canvas, 10, 63, "[back] - reset, hold to exit");
 
     furi_mutex_release(state->mutex);
 }
 
+/** Redraw only what the event changed: key disc on press and release, counters otherwise */
+static void keypad_test_update(ViewPort* view_port, InputEvent* event) {
+    size_t index;
+    switch(event->key) {
+    case InputKeyRight:
+        index = 0;
+        break;
+    case InputKeyLeft:
+        index = 1;
+        break;
+    case InputKeyUp:
+        index = 2;
+        break;
+    case InputKeyDown:
+        index = 3;
+        break;
+    case InputKeyOk:
+        index = 4;
+        break;
+    default:
+        index = COUNT_OF(keypad_test_disc);
+        break;
+    }
+
+    if(index < COUNT_OF(keypad_test_disc) &&
+       (event->type == InputTypePress || event->type == InputTypeRelease)) {
+        view_port_update_rect(
+            view_port,
+            keypad_test_disc[index][0] - KEYPAD_TEST_DISC_RADIUS,
+            keypad_test_disc[index][1] - KEYPAD_TEST_DISC_RADIUS,
+            KEYPAD_TEST_DISC_RADIUS * 2 + 1,
+            KEYPAD_TEST_DISC_RADIUS * 2 + 1);
+    } else {
+        // Counter strings
+        view_port_update_rect(view_port, 0, 14, 75, 36);
+    }
+}
+
 static void keypad_test_input_callback(InputEvent* input_event, void* ctx) {
     FuriMessageQueue* event_queue = ctx;
     furi_message_queue_put(event_queue, input_event, FuriWaitForever);
@@ -142,7 +194,7 @@ int32_t keypad_test_app(void* p) {
         }
 
         furi_mutex_release(state.mutex);
-        view_port_update(view_port);
+        keypad_test_update(view_port, &event);
     }
 
     // remove & free all stuff created by app
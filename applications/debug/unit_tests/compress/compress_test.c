@@ -0,0 +1,173 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+#include <toolbox/compress.h>
+#include <gui/icon_i.h>
+#include <applications.h>
+#include <assets_icons.h>
+
+#define COMPRESS_ICON_TEST_TICKS (256U)
+#define COMPRESS_ICON_TEST_MENU_ITEMS (3U)
+
+static size_t compress_icon_test_size(const Icon* icon) {
+    return ((icon->width + 7) / 8) * icon->height;
+}
+
+/* Menu view: selected item animated, neighbours show their current frame */
+static uint32_t compress_icon_test_menu(CompressIcon* compress_icon) {
+    uint32_t cycles = 0;
+    uint8_t* decoded = NULL;
+    for(size_t tick = 0; tick < COMPRESS_ICON_TEST_TICKS; tick++) {
+        size_t selected = (tick / 32) % FLIPPER_APPS_COUNT;
+        for(size_t i = 0; i < COMPRESS_ICON_TEST_MENU_ITEMS; i++) {
+            const Icon* icon = FLIPPER_APPS[(selected + i) % FLIPPER_APPS_COUNT].icon;
+            if(!icon) continue;
+            size_t frame = i == 1 ? tick % icon->frame_count : 0;
+
+            uint32_t cycle_start = DWT->CYCCNT;
+            compress_icon_decode(compress_icon, icon->frames[frame], &decoded);
+            cycles += DWT->CYCCNT - cycle_start;
+        }
+    }
+    return cycles;
+}
+
+/* Desktop animation loop, full screen frames */
+static uint32_t compress_icon_test_animation(CompressIcon* compress_icon, const Icon* icon) {
+    uint32_t cycles = 0;
+    uint8_t* decoded = NULL;
+    for(size_t tick = 0; tick < COMPRESS_ICON_TEST_TICKS; tick++) {
+        uint32_t cycle_start = DWT->CYCCNT;
+        compress_icon_decode(compress_icon, icon->frames[tick % icon->frame_count], &decoded);
+        cycles += DWT->CYCCNT - cycle_start;
+    }
+    return cycles;
+}
+
+static bool compress_icon_test_frames_match(
+    CompressIcon* cached,
+    CompressIcon* uncached,
+    const Icon* icon) {
+    const size_t size = compress_icon_test_size(icon);
+    // Twice to compare cache hits too
+    for(size_t i = 0; i < icon->frame_count * 2u; i++) {
+        uint8_t* expected = NULL;
+        uint8_t* actual = NULL;
+        compress_icon_decode(uncached, icon->frames[i % icon->frame_count], &expected);
+        compress_icon_decode(cached, icon->frames[i % icon->frame_count], &actual);
+        if(memcmp(expected, actual, size) != 0) return false;
+    }
+    return true;
+}
+
+MU_TEST(compress_icon_cache_test) {
+    CompressIcon* cached = compress_icon_alloc();
+    CompressIcon* uncached = compress_icon_alloc();
+    compress_icon_cache_set_budget(uncached, 0);
+
+    mu_assert(
+        compress_icon_test_frames_match(cached, uncached, &A_Levelup1_128x64),
+        "Cached animation frame differs\r\n");
+    for(size_t i = 0; i < FLIPPER_APPS_COUNT; i++) {
+        if(!FLIPPER_APPS[i].icon) continue;
+        mu_assert(
+            compress_icon_test_frames_match(cached, uncached, FLIPPER_APPS[i].icon),
+            "Cached menu icon differs\r\n");
+    }
+
+    CompressIconCacheStats stats;
+    compress_icon_cache_get_stats(cached, &stats);
+    mu_assert(stats.hits > 0, "No cache hits\r\n");
+    mu_assert(stats.size <= stats.budget, "Cache over budget\r\n");
+    compress_icon_cache_get_stats(uncached, &stats);
+    mu_assert_int_eq(0, stats.hits + stats.misses + stats.size);
+
+    compress_icon_cache_flush(cached);
+    compress_icon_cache_get_stats(cached, &stats);
+    mu_assert_int_eq(0, stats.size);
+
+    compress_icon_free(uncached);
+    compress_icon_free(cached);
+}
+
+MU_TEST(compress_icon_cache_reuse_test) {
+    // Same RAM address holding other icon, as with unloaded animation or FAP
+    const uint8_t* first = A_Levelup1_128x64.frames[0];
+    const uint8_t* second = A_Levelup1_128x64.frames[1];
+    const size_t first_size = 4 + (first[2] | (first[3] << 8));
+    const size_t second_size = 4 + (second[2] | (second[3] << 8));
+    mu_assert(first[0] && second[0], "Test frames are not compressed\r\n");
+
+    CompressIcon* cached = compress_icon_alloc();
+    CompressIcon* uncached = compress_icon_alloc();
+    compress_icon_cache_set_budget(uncached, 0);
+    const size_t size = compress_icon_test_size(&A_Levelup1_128x64);
+    uint8_t* icon_data = malloc(MAX(first_size, second_size));
+    uint8_t* expected = NULL;
+    uint8_t* actual = NULL;
+
+    memcpy(icon_data, first, first_size);
+    compress_icon_decode(cached, icon_data, &actual);
+    compress_icon_decode(uncached, first, &expected);
+    mu_assert(memcmp(expected, actual, size) == 0, "First frame differs\r\n");
+
+    memcpy(icon_data, second, second_size);
+    compress_icon_decode(cached, icon_data, &actual);
+    compress_icon_decode(uncached, second, &expected);
+    mu_assert(memcmp(expected, actual, size) == 0, "Stale frame after data change\r\n");
+
+    free(icon_data);
+    compress_icon_free(uncached);
+    compress_icon_free(cached);
+}
+
+MU_TEST(compress_icon_cache_bench_test) {
+    CompressIcon* compress_icon = compress_icon_alloc();
+    const uint32_t ipus = furi_hal_cortex_instructions_per_microsecond();
+    CompressIconCacheStats stats;
+
+    compress_icon_cache_set_budget(compress_icon, 0);
+    uint32_t menu_off = compress_icon_test_menu(compress_icon);
+    uint32_t animation_off = compress_icon_test_animation(compress_icon, &A_Levelup1_128x64);
+
+    compress_icon_cache_set_budget(compress_icon, COMPRESS_ICON_CACHE_BUDGET_DEFAULT);
+    uint32_t menu_on = compress_icon_test_menu(compress_icon);
+    compress_icon_cache_get_stats(compress_icon, &stats);
+    printf(
+        "Icon cache menu %u ticks: off %lu us, on %lu us, %lu hits, %lu misses\r\n",
+        COMPRESS_ICON_TEST_TICKS,
+        menu_off / ipus,
+        menu_on / ipus,
+        stats.hits,
+        stats.misses);
+
+    compress_icon_cache_flush(compress_icon);
+    compress_icon_cache_reset_stats(compress_icon);
+    uint32_t animation_on = compress_icon_test_animation(compress_icon, &A_Levelup1_128x64);
+    compress_icon_cache_get_stats(compress_icon, &stats);
+    printf(
+        "Icon cache animation %u ticks: off %lu us, on %lu us, "
+        "%lu hits, %lu misses, %lu bytes\r\n",
+        COMPRESS_ICON_TEST_TICKS,
+        animation_off / ipus,
+        animation_on / ipus,
+        stats.hits,
+        stats.misses,
+        (uint32_t)stats.size);
+
+    mu_assert(menu_on < menu_off, "Icon cache doesn't speed up menu\r\n");
+    mu_assert(stats.size <= stats.budget, "Cache over budget\r\n");
+
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST_SUITE(compress_icon_suite) {
+    MU_RUN_TEST(compress_icon_cache_test);
+    MU_RUN_TEST(compress_icon_cache_reuse_test);
+    MU_RUN_TEST(compress_icon_cache_bench_test);
+}
+
+int run_minunit_test_compress() {
+    MU_RUN_SUITE(compress_icon_suite);
+    return MU_EXIT_CODE;
+}
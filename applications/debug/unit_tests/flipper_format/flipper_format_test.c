@@ -415,10 +415,11 @@ static bool test_write_multikey(const char* file_name) {
     return result;
 }
 
-static bool test_read_multikey(const char* file_name) {
+static bool test_read_multikey(const char* file_name, bool key_index) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     bool result = false;
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, key_index);
 
     FuriString* string_value;
     string_value = furi_string_alloc();
@@ -456,6 +457,312 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_read_key_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, true);
+    FuriString* string_value;
+    string_value = furi_string_alloc();
+    uint32_t uint32_value;
+    void* scratchpad = malloc(512);
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+
+        // Last key first, every next read has to go back
+        if(!flipper_format_get_value_count(file, test_hex_key, &uint32_value)) break;
+        if(uint32_value != COUNT_OF(test_hex_data)) break;
+        if(!flipper_format_read_hex(file, test_hex_key, scratchpad, uint32_value)) break;
+        if(memcmp(scratchpad, test_hex_data, sizeof(uint8_t) * COUNT_OF(test_hex_data)) != 0)
+            break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_bool(file, test_bool_key, scratchpad, COUNT_OF(test_bool_data)))
+            break;
+        if(memcmp(scratchpad, test_bool_data, sizeof(bool) * COUNT_OF(test_bool_data)) != 0) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_float(
+               file, test_float_key, scratchpad, COUNT_OF(test_float_data)))
+            break;
+        if(memcmp(scratchpad, test_float_data, sizeof(float) * COUNT_OF(test_float_data)) != 0)
+            break;
+
+        // Key was passed already and there is no other one after it
+        if(flipper_format_read_uint32(file, test_uint_key, scratchpad, COUNT_OF(test_uint_data)))
+            break;
+        if(!flipper_format_key_exist(file, test_uint_key)) break;
+        if(flipper_format_key_exist(file, "Missing key")) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_uint32(file, test_uint_key, scratchpad, COUNT_OF(test_uint_data)))
+            break;
+        if(memcmp(scratchpad, test_uint_data, sizeof(uint32_t) * COUNT_OF(test_uint_data)) != 0)
+            break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_int32(file, test_int_key, scratchpad, COUNT_OF(test_int_data)))
+            break;
+        if(memcmp(scratchpad, test_int_data, sizeof(int32_t) * COUNT_OF(test_int_data)) != 0)
+            break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_data) != 0) break;
+
+        // Comment line is not a key
+        if(!flipper_format_rewind(file)) break;
+        if(flipper_format_key_exist(file, "# This is comment")) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+        if(furi_string_cmp_str(string_value, test_filetype) != 0) break;
+        if(uint32_value != test_version) break;
+
+        result = true;
+    } while(false);
+
+    free(scratchpad);
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_update_key_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, true);
+    FuriString* string_value;
+    string_value = furi_string_alloc();
+    uint8_t hex_value[COUNT_OF(test_hex_data)];
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+
+        // Index all keys
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+
+        // Moves every key after it
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_update_string_cstr(file, test_string_key, test_string_updated_data))
+            break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, sizeof(hex_value)) != 0) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_updated_data) != 0) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_update_string_cstr(file, test_string_key, test_string_data)) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, sizeof(hex_value)) != 0) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+#define KEY_INDEX_TEST_MFC_BLOCKS (256U)
+#define KEY_INDEX_TEST_MFC_BLOCK_SIZE (16U)
+#define KEY_INDEX_TEST_IR_SIGNALS (120U)
+#define KEY_INDEX_TEST_IR_RAW_SAMPLES (64U)
+
+static bool test_key_index_write_mfc(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* key = furi_string_alloc();
+    uint8_t block[KEY_INDEX_TEST_MFC_BLOCK_SIZE];
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, "Flipper NFC device", 3)) break;
+        if(!flipper_format_write_string_cstr(file, "Device type", "Mifare Classic")) break;
+        if(!flipper_format_write_string_cstr(file, "Mifare Classic type", "4K")) break;
+
+        size_t i = 0;
+        for(; i < KEY_INDEX_TEST_MFC_BLOCKS; i++) {
+            for(size_t j = 0; j < sizeof(block); j++) block[j] = i + j;
+            furi_string_printf(key, "Block %u", i);
+            if(!flipper_format_write_hex(file, furi_string_get_cstr(key), block, sizeof(block)))
+                break;
+        }
+        if(i != KEY_INDEX_TEST_MFC_BLOCKS) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(key);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+/* Dump loading with blocks requested backwards, every block from file start */
+static bool test_key_index_read_mfc(
+    const char* file_name,
+    bool key_index,
+    uint8_t* data,
+    uint32_t* ticks) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, key_index);
+    FuriString* key = furi_string_alloc();
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+
+        uint32_t start = furi_get_tick();
+        size_t i = KEY_INDEX_TEST_MFC_BLOCKS;
+        for(; i > 0; i--) {
+            furi_string_printf(key, "Block %u", i - 1);
+            if(!flipper_format_rewind(file)) break;
+            if(!flipper_format_read_hex(
+                   file,
+                   furi_string_get_cstr(key),
+                   &data[(i - 1) * KEY_INDEX_TEST_MFC_BLOCK_SIZE],
+                   KEY_INDEX_TEST_MFC_BLOCK_SIZE))
+                break;
+        }
+        *ticks = furi_get_tick() - start;
+        if(i != 0) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(key);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_key_index_write_ir(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
+    uint32_t* samples = malloc(sizeof(uint32_t) * KEY_INDEX_TEST_IR_RAW_SAMPLES);
+    const float duty_cycle = 0.33f;
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, "IR library file", 1)) break;
+
+        size_t i = 0;
+        for(; i < KEY_INDEX_TEST_IR_SIGNALS; i++) {
+            const uint32_t address = i;
+            const uint32_t command = i * 3;
+            furi_string_printf(name, "Signal_%u", i);
+            if(!flipper_format_write_comment_cstr(file, "")) break;
+            if(!flipper_format_write_string(file, "name", name)) break;
+            if(i % 4 == 0) {
+                for(size_t j = 0; j < KEY_INDEX_TEST_IR_RAW_SAMPLES; j++) {
+                    samples[j] = 500 + i + j * 10;
+                }
+                if(!flipper_format_write_string_cstr(file, "type", "raw")) break;
+                if(!flipper_format_write_uint32(file, "frequency", &command, 1)) break;
+                if(!flipper_format_write_float(file, "duty_cycle", &duty_cycle, 1)) break;
+                if(!flipper_format_write_uint32(
+                       file, "data", samples, KEY_INDEX_TEST_IR_RAW_SAMPLES))
+                    break;
+            } else {
+                if(!flipper_format_write_string_cstr(file, "type", "parsed")) break;
+                if(!flipper_format_write_string_cstr(file, "protocol", "NEC")) break;
+                if(!flipper_format_write_hex(file, "address", (uint8_t*)&address, 4)) break;
+                if(!flipper_format_write_hex(file, "command", (uint8_t*)&command, 4)) break;
+            }
+        }
+        if(i != KEY_INDEX_TEST_IR_SIGNALS) break;
+
+        result = true;
+    } while(false);
+
+    free(samples);
+    furi_string_free(name);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+/* Signal lookup by number, as picking a button from the library list */
+static bool test_key_index_read_ir(
+    const char* file_name,
+    bool key_index,
+    uint32_t* commands,
+    uint32_t* ticks) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, key_index);
+    FuriString* name = furi_string_alloc();
+    FuriString* expected = furi_string_alloc();
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+
+        uint32_t start = furi_get_tick();
+        size_t i = KEY_INDEX_TEST_IR_SIGNALS;
+        for(; i > 0; i--) {
+            const size_t signal = (i * 7) % KEY_INDEX_TEST_IR_SIGNALS;
+            if(!flipper_format_rewind(file)) break;
+
+            size_t skipped = 0;
+            for(; skipped <= signal; skipped++) {
+                if(!flipper_format_read_string(file, "name", name)) break;
+            }
+            if(skipped <= signal) break;
+            furi_string_printf(expected, "Signal_%u", signal);
+            if(!furi_string_equal(name, expected)) break;
+
+            if(!flipper_format_read_string(file, "type", name)) break;
+            if(furi_string_equal(name, "raw")) {
+                uint32_t count;
+                if(!flipper_format_read_uint32(file, "frequency", &commands[signal], 1)) break;
+                if(!flipper_format_get_value_count(file, "data", &count)) break;
+                if(count != KEY_INDEX_TEST_IR_RAW_SAMPLES) break;
+            } else {
+                if(!flipper_format_read_hex(file, "command", (uint8_t*)&commands[signal], 4))
+                    break;
+            }
+        }
+        *ticks = furi_get_tick() - start;
+        if(i != 0) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(expected);
+    furi_string_free(name);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -519,7 +826,11 @@ MU_TEST(flipper_format_update_2_result_test) {
 
 MU_TEST(flipper_format_multikey_test) {
     mu_assert(test_write_multikey(TEST_DIR "ff_multiline.test"), "Multikey write test error");
-    mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
+    mu_assert(
+        test_read_multikey(TEST_DIR "ff_multiline.test", false), "Multikey read test error");
+    mu_assert(
+        test_read_multikey(TEST_DIR "ff_multiline.test", true),
+        "Multikey read test error [Key index]");
 }
 
 MU_TEST(flipper_format_oddities_test) {
@@ -528,6 +839,58 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+MU_TEST(flipper_format_key_index_test) {
+    mu_assert(test_read_key_index(test_file_linux), "Key index read error [Linux]");
+    mu_assert(test_read_key_index(test_file_windows), "Key index read error [Windows]");
+    mu_assert(test_read_key_index(test_file_flipper), "Key index read error [Flipper]");
+    mu_assert(test_update_key_index(test_file_flipper), "Key index update error [Flipper]");
+    mu_assert(test_read(test_file_flipper), "Key index update result error [Flipper]");
+}
+
+MU_TEST(flipper_format_key_index_bench_test) {
+    const char* mfc_file = TEST_DIR "ff_index_mfc.test";
+    const char* ir_file = TEST_DIR "ff_index_ir.test";
+    uint32_t ticks_off = 0;
+    uint32_t ticks_on = 0;
+
+    const size_t mfc_size = KEY_INDEX_TEST_MFC_BLOCKS * KEY_INDEX_TEST_MFC_BLOCK_SIZE;
+    uint8_t* mfc_expected = malloc(mfc_size);
+    uint8_t* mfc_actual = malloc(mfc_size);
+    mu_assert(test_key_index_write_mfc(mfc_file), "MFC dump write error");
+    mu_assert(
+        test_key_index_read_mfc(mfc_file, false, mfc_expected, &ticks_off),
+        "MFC dump read error");
+    mu_assert(
+        test_key_index_read_mfc(mfc_file, true, mfc_actual, &ticks_on),
+        "MFC dump read error [Key index]");
+    mu_assert(memcmp(mfc_expected, mfc_actual, mfc_size) == 0, "MFC dump data differs");
+    printf(
+        "Key index 4K dump, %u blocks: off %lu ms, on %lu ms\r\n",
+        KEY_INDEX_TEST_MFC_BLOCKS,
+        ticks_off,
+        ticks_on);
+    free(mfc_actual);
+    free(mfc_expected);
+
+    const size_t ir_size = sizeof(uint32_t) * KEY_INDEX_TEST_IR_SIGNALS;
+    uint32_t* ir_expected = malloc(ir_size);
+    uint32_t* ir_actual = malloc(ir_size);
+    mu_assert(test_key_index_write_ir(ir_file), "IR library write error");
+    mu_assert(
+        test_key_index_read_ir(ir_file, false, ir_expected, &ticks_off), "IR library read error");
+    mu_assert(
+        test_key_index_read_ir(ir_file, true, ir_actual, &ticks_on),
+        "IR library read error [Key index]");
+    mu_assert(memcmp(ir_expected, ir_actual, ir_size) == 0, "IR library data differs");
+    printf(
+        "Key index IR library, %u signals: off %lu ms, on %lu ms\r\n",
+        KEY_INDEX_TEST_IR_SIGNALS,
+        ticks_off,
+        ticks_on);
+    free(ir_actual);
+    free(ir_expected);
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -542,6 +905,8 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_TEST(flipper_format_key_index_test);
+    MU_RUN_TEST(flipper_format_key_index_bench_test);
     tests_teardown();
 }
 
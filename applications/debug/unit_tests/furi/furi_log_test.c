@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TAG "LogTest"
+
+#define LOG_TEST_THREADS 4
+#define LOG_TEST_RECORDS 250
+#define LOG_TEST_MARKER "LogStress "
+
+static volatile uint32_t log_test_count = 0;
+static char log_test_line[64];
+static uint32_t log_test_sync_time = 0;
+static uint32_t log_test_async_time = 0;
+static uint32_t log_test_dropped = 0;
+
+static void log_test_puts(const char* data) {
+    // Only log mutex holder calls puts, no extra locking needed
+    if(strncmp(data, LOG_TEST_MARKER, strlen(LOG_TEST_MARKER)) == 0) {
+        log_test_count++;
+        strlcpy(log_test_line, data, sizeof(log_test_line));
+    }
+}
+
+static int32_t log_test_producer(void* context) {
+    uint32_t id = (uint32_t)context;
+    for(uint32_t i = 0; i < LOG_TEST_RECORDS; i++) {
+        FURI_LOG_I(TAG, LOG_TEST_MARKER "%lu %lu %s", id, i, "payload");
+    }
+    return 0;
+}
+
+static uint32_t log_test_run_producers() {
+    FuriThread* threads[LOG_TEST_THREADS];
+    uint32_t start = furi_get_tick();
+
+    for(uint32_t i = 0; i < LOG_TEST_THREADS; i++) {
+        threads[i] = furi_thread_alloc_ex("LogTestProducer", 1024, log_test_producer, (void*)i);
+        furi_thread_start(threads[i]);
+    }
+    for(uint32_t i = 0; i < LOG_TEST_THREADS; i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+    }
+
+    return furi_get_tick() - start;
+}
+
+static void test_furi_log_format() {
+    // Deferred formatting must match printf
+    log_test_count = 0;
+    FURI_LOG_I(
+        TAG, LOG_TEST_MARKER "%s|%5d|%08lX|%.*s|%c|%%", "str", -42, 0xBEEFUL, 3, "abcdef", 'x');
+    furi_log_flush();
+    mu_assert_int_eq(1, log_test_count);
+    mu_assert_string_eq(LOG_TEST_MARKER "str|  -42|0000BEEF|abc|x|%", log_test_line);
+
+    // Long strings are truncated, not dropped
+    char long_string[200];
+    memset(long_string, 'a', sizeof(long_string) - 1);
+    long_string[sizeof(long_string) - 1] = '\0';
+    log_test_count = 0;
+    FURI_LOG_I(TAG, LOG_TEST_MARKER "%s", long_string);
+    furi_log_flush();
+    mu_assert_int_eq(1, log_test_count);
+
+    // Format in RAM is copied, buffer can be reused right after the call
+    char format[32];
+    strlcpy(format, LOG_TEST_MARKER "ram %d", sizeof(format));
+    log_test_count = 0;
+    FURI_LOG_I(TAG, format, 1);
+    memset(format, 0, sizeof(format));
+    furi_log_flush();
+    mu_assert_int_eq(1, log_test_count);
+    mu_assert_string_eq(LOG_TEST_MARKER "ram 1", log_test_line);
+}
+
+static void test_furi_log_tag_filter() {
+    // Tag is copied, caller buffer is not referenced after the call
+    char tag[16];
+    strlcpy(tag, TAG "Filter", sizeof(tag));
+    mu_check(furi_log_set_tag_level(tag, FuriLogLevelNone));
+    memset(tag, 0, sizeof(tag));
+
+    log_test_count = 0;
+    FURI_LOG_E(TAG "Filter", LOG_TEST_MARKER "filtered");
+    FURI_LOG_I(TAG, LOG_TEST_MARKER "passed");
+    furi_log_flush();
+    mu_assert_int_eq(1, log_test_count);
+
+    mu_check(furi_log_set_tag_level(TAG "Filter", FuriLogLevelDefault));
+    FURI_LOG_E(TAG "Filter", LOG_TEST_MARKER "passed");
+    furi_log_flush();
+    mu_assert_int_eq(2, log_test_count);
+}
+
+static void test_furi_log_stress() {
+    const uint32_t total = LOG_TEST_THREADS * LOG_TEST_RECORDS;
+
+    log_test_count = 0;
+    log_test_sync_time = log_test_run_producers();
+    mu_assert_int_eq(total, log_test_count);
+
+    furi_log_set_async(true);
+    log_test_count = 0;
+    uint32_t dropped = furi_log_get_dropped();
+    log_test_async_time = log_test_run_producers();
+    furi_log_flush();
+    log_test_dropped = furi_log_get_dropped() - dropped;
+    // Every record is either printed or accounted as dropped
+    mu_assert_int_eq(total, log_test_count + log_test_dropped);
+}
+
+void test_furi_log() {
+    FuriLogLevel level = furi_log_get_level();
+    bool async = furi_log_is_async();
+    furi_log_set_level(FuriLogLevelInfo);
+    furi_log_set_puts(log_test_puts);
+
+    furi_log_set_async(true);
+    test_furi_log_format();
+    test_furi_log_tag_filter();
+    furi_log_set_async(false);
+    test_furi_log_format();
+    test_furi_log_tag_filter();
+    test_furi_log_stress();
+
+    furi_log_set_async(async);
+    furi_log_set_puts(furi_hal_console_puts);
+    furi_log_set_level(level);
+
+    FURI_LOG_I(
+        TAG,
+        "%d records from %d threads: sync %lums, async %lums, %lu dropped",
+        LOG_TEST_THREADS * LOG_TEST_RECORDS,
+        LOG_TEST_THREADS,
+        log_test_sync_time,
+        log_test_async_time,
+        log_test_dropped);
+}
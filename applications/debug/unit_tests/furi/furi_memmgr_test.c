@@ -1,4 +1,5 @@
 #include "../minunit.h"
+#include <furi.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -37,3 +38,108 @@ void test_furi_memmgr() {
     }
     free(ptr);
 }
+
+typedef struct {
+    void* blocks[3];
+    volatile bool ready;
+} MemmgrTraceTestContext;
+
+static int32_t memmgr_trace_test_thread(void* context) {
+    MemmgrTraceTestContext* ctx = context;
+    FuriThreadId thread_id = furi_thread_get_current_id();
+
+    memmgr_heap_enable_thread_trace(thread_id);
+    // Block sizes land in 64, 512 and >1024 byte histogram buckets
+    ctx->blocks[0] = malloc(40);
+    ctx->blocks[1] = malloc(300);
+    ctx->blocks[2] = malloc(1500);
+    free(ctx->blocks[1]);
+    ctx->blocks[1] = NULL;
+    ctx->ready = true;
+
+    // Wait for other thread to release one of our blocks
+    furi_thread_flags_wait(1, FuriFlagWaitAny, FuriWaitForever);
+    free(ctx->blocks[0]);
+    memmgr_heap_disable_thread_trace(thread_id);
+    return 0;
+}
+
+void test_furi_memmgr_thread_trace() {
+    MemmgrTraceTestContext ctx = {0};
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrTraceTest", 1024, memmgr_trace_test_thread, &ctx);
+    // Trace is controlled by the test itself
+    furi_thread_disable_heap_trace(thread);
+    furi_thread_start(thread);
+    FuriThreadId thread_id = furi_thread_get_id(thread);
+
+    while(!ctx.ready) {
+        furi_delay_tick(1);
+    }
+
+    MemmgrHeapThreadStats stats;
+    mu_check(memmgr_heap_get_thread_stats(thread_id, &stats));
+    mu_assert_int_eq(3, stats.allocations);
+    mu_assert_int_eq(1, stats.histogram[2]);
+    mu_assert_int_eq(1, stats.histogram[5]);
+    mu_assert_int_eq(1, stats.histogram[MEMMGR_HEAP_HISTOGRAM_SIZE - 1]);
+    mu_check(stats.live >= 40 + 1500);
+    mu_check(stats.peak >= stats.live + 300);
+    mu_assert_int_eq(stats.live, memmgr_heap_get_thread_memory(thread_id));
+
+    // Memory released by other thread is credited to the owner
+    size_t live = stats.live;
+    free(ctx.blocks[2]);
+    mu_check(memmgr_heap_get_thread_stats(thread_id, &stats));
+    mu_check(stats.live < live);
+    mu_check(stats.live >= 40);
+
+    furi_thread_flags_set(thread_id, 1);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    mu_assert_int_eq(MEMMGR_HEAP_UNKNOWN, memmgr_heap_get_thread_memory(thread_id));
+}
+
+void test_furi_memmgr_slab() {
+    MemmgrSlabStats before, after;
+    if(!memmgr_heap_get_slab_stats(&before) ||
+       memmgr_heap_get_thread_memory(furi_thread_get_current_id()) != MEMMGR_HEAP_UNKNOWN) {
+        // Slab is disabled or bypassed for traced threads
+        return;
+    }
+
+    // Sizes above slab limit go to heap, objects must be zeroed and distinct
+    const size_t sizes[] = {1, 16, 17, 48, 100, 128, 129, 300};
+    void* ptrs[COUNT_OF(sizes)];
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        ptrs[i] = malloc(sizes[i]);
+        for(size_t j = 0; j < sizes[i]; j++) {
+            mu_assert_int_eq(0, ((uint8_t*)ptrs[i])[j]);
+        }
+        memset(ptrs[i], 0xA5, sizes[i]);
+    }
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        for(size_t j = 0; j < sizes[i]; j++) {
+            mu_assert_int_eq(0xA5, ((uint8_t*)ptrs[i])[j]);
+        }
+    }
+
+    mu_check(memmgr_heap_get_slab_stats(&after));
+    uint32_t allocations = 0;
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+        allocations += after.classes[i].allocations - before.classes[i].allocations;
+        allocations += after.classes[i].fallbacks - before.classes[i].fallbacks;
+    }
+    // Other threads may allocate meanwhile
+    mu_check(allocations >= 6);
+
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        free(ptrs[i]);
+    }
+
+    MemmgrHeapLatency slab_latency, heap_latency;
+    memmgr_heap_get_latency(&slab_latency, &heap_latency);
+    mu_check(heap_latency.count > 0);
+    mu_check(slab_latency.cycles_max >= slab_latency.cycles_total / MAX(slab_latency.count, 1U));
+}
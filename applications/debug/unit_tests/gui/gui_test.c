@@ -0,0 +1,160 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/gui.h>
+#include "../minunit.h"
+
+#define GUI_TEST_WIDTH (128)
+#define GUI_TEST_HEIGHT (64)
+#define GUI_TEST_FRAME_SIZE (GUI_TEST_WIDTH * GUI_TEST_HEIGHT / 8)
+#define GUI_TEST_FRAME_TIMEOUT (1000)
+#define GUI_TEST_ATTEMPTS (5)
+
+typedef struct {
+    Gui* gui;
+    ViewPort* view_port;
+    FuriSemaphore* frame_ready;
+    uint8_t frame[GUI_TEST_FRAME_SIZE];
+    bool capture; /**< frame requested */
+    bool armed; /**< frame drawn after request, capture it */
+    bool fill;
+} GuiTest;
+
+static GuiTest* gui_test = NULL;
+
+static void gui_test_draw_callback(Canvas* canvas, void* context) {
+    GuiTest* test = context;
+    test->armed = test->capture;
+    canvas_clear(canvas);
+    if(test->fill) {
+        canvas_draw_box(canvas, 0, 0, canvas_width(canvas), canvas_height(canvas));
+    }
+}
+
+static void gui_test_framebuffer_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(orientation);
+    GuiTest* test = context;
+    if(test->armed) {
+        memcpy(test->frame, data, MIN(size, sizeof(test->frame)));
+        test->armed = false;
+        test->capture = false;
+        furi_semaphore_release(test->frame_ready);
+    }
+}
+
+static void gui_test_setup() {
+    gui_test = malloc(sizeof(GuiTest));
+    gui_test->gui = furi_record_open(RECORD_GUI);
+    gui_test->frame_ready = furi_semaphore_alloc(1, 0);
+    gui_test->view_port = view_port_alloc();
+    view_port_draw_callback_set(gui_test->view_port, gui_test_draw_callback, gui_test);
+    gui_add_framebuffer_callback(gui_test->gui, gui_test_framebuffer_callback, gui_test);
+    gui_add_view_port(gui_test->gui, gui_test->view_port, GuiLayerFullscreen);
+}
+
+static void gui_test_teardown() {
+    gui_remove_view_port(gui_test->gui, gui_test->view_port);
+    gui_remove_framebuffer_callback(gui_test->gui, gui_test_framebuffer_callback, gui_test);
+    view_port_free(gui_test->view_port);
+    furi_semaphore_free(gui_test->frame_ready);
+    furi_record_close(RECORD_GUI);
+    free(gui_test);
+    gui_test = NULL;
+}
+
+static bool gui_test_pixel(uint8_t x, uint8_t y) {
+    return gui_test->frame[(y / 8) * GUI_TEST_WIDTH + x] & (1 << (y % 8));
+}
+
+/** Draw with fill state, then wait for frame caused by update
+ *
+ * GUI holds its lock until frame is counted, stats read after return include it.
+ */
+static bool gui_test_draw(bool fill, void (*update)(GuiTest* test)) {
+    gui_test->fill = fill;
+    gui_test->capture = true;
+    update(gui_test);
+    return furi_semaphore_acquire(gui_test->frame_ready, GUI_TEST_FRAME_TIMEOUT) ==
+           FuriStatusOk;
+}
+
+static void gui_test_update(GuiTest* test) {
+    view_port_update(test->view_port);
+}
+
+static void gui_test_update_rect(GuiTest* test) {
+    view_port_update_rect(test->view_port, 8, 8, 16, 16);
+}
+
+static void gui_test_invalidate(GuiTest* test) {
+    gui_invalidate_display(test->gui);
+}
+
+MU_TEST(gui_test_partial_redraw) {
+    if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient)) {
+        // Partial redraw is not done for left handed orientation
+        return;
+    }
+
+    bool partial = false;
+    for(size_t attempt = 0; attempt < GUI_TEST_ATTEMPTS && !partial; attempt++) {
+        mu_assert(gui_test_draw(true, gui_test_update), "no full frame");
+
+        // Dark mode swaps colors, take ink from filled frame
+        const bool ink = gui_test_pixel(0, 0);
+        for(uint8_t y = 0; y < GUI_TEST_HEIGHT; y++) {
+            for(uint8_t x = 0; x < GUI_TEST_WIDTH; x++) {
+                mu_assert(gui_test_pixel(x, y) == ink, "frame not filled");
+            }
+        }
+
+        // Draw callback clears canvas, clear must stay within damaged area
+        GuiRedrawStats before, after;
+        gui_get_redraw_stats(gui_test->gui, &before);
+        mu_assert(gui_test_draw(false, gui_test_update_rect), "no partial frame");
+        gui_get_redraw_stats(gui_test->gui, &after);
+
+        // Something else asked for full redraw meanwhile, try again
+        const uint32_t frames = after.frames - before.frames;
+        if(frames == 0 || frames != after.partial_frames - before.partial_frames) continue;
+        partial = true;
+
+        for(uint8_t y = 0; y < GUI_TEST_HEIGHT; y++) {
+            for(uint8_t x = 0; x < GUI_TEST_WIDTH; x++) {
+                bool inside = x >= 8 && x < 8 + 16 && y >= 8 && y < 8 + 16;
+                mu_assert(gui_test_pixel(x, y) == (inside ? !ink : ink), "wrong pixel");
+            }
+        }
+    }
+    mu_assert(partial, "no partial redraw");
+}
+
+MU_TEST(gui_test_invalidate_display) {
+    mu_assert(gui_test_draw(true, gui_test_update), "no frame");
+
+    // Same frame again sends nothing, unless display was invalidated
+    GuiRedrawStats before, after;
+    gui_get_redraw_stats(gui_test->gui, &before);
+    mu_assert(gui_test_draw(true, gui_test_update), "no frame");
+    gui_get_redraw_stats(gui_test->gui, &after);
+    mu_assert_int_eq(0, after.bytes_pushed - before.bytes_pushed);
+
+    gui_get_redraw_stats(gui_test->gui, &before);
+    mu_assert(gui_test_draw(true, gui_test_invalidate), "no frame after invalidate");
+    gui_get_redraw_stats(gui_test->gui, &after);
+    mu_check(after.bytes_pushed - before.bytes_pushed >= GUI_TEST_FRAME_SIZE);
+}
+
+MU_TEST_SUITE(gui_suite) {
+    MU_SUITE_CONFIGURE(&gui_test_setup, &gui_test_teardown);
+    MU_RUN_TEST(gui_test_partial_redraw);
+    MU_RUN_TEST(gui_test_invalidate_display);
+}
+
+int run_minunit_test_gui() {
+    MU_RUN_SUITE(gui_suite);
+    return MU_EXIT_CODE;
+}
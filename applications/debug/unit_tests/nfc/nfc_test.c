@@ -4,6 +4,7 @@
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
+#include <lib/nfc/protocols/crypto1.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/pulse_reader/pulse_reader.h>
@@ -21,6 +22,7 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define NFC_TEST_DICT_CACHE_PATH EXT_PATH("unit_tests/.mf_classic_dict.cache")
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -485,6 +487,125 @@ MU_TEST(mf_classic_dict_load_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+/** Overwrite last entry of sorted dictionary cache, the one with the largest key */
+static bool nfc_test_dict_cache_corrupt(Storage* storage, uint64_t entry) {
+    File* file = storage_file_alloc(storage);
+    bool corrupted = false;
+    if(storage_file_open(file, NFC_TEST_DICT_CACHE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING)) {
+        uint64_t size = storage_file_size(file);
+        corrupted = size >= sizeof(entry) &&
+                    storage_file_seek(file, size - sizeof(entry), true) &&
+                    storage_file_write(file, &entry, sizeof(entry)) == sizeof(entry);
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+    return corrupted;
+}
+
+MU_TEST(mf_classic_dict_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_DICT_CACHE_PATH);
+
+    // Unsorted keys with one duplicate
+    Stream* file_stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(file_stream, NFC_TEST_DICT_PATH, FSAM_WRITE, FSOM_OPEN_ALWAYS),
+        "file_stream_open == true assert failed\r\n");
+    const char* dict_str = "# Comment\nFFFFFFFFFFFF\nA0A1A2A3A4A5\nd3f7d3f7d3f7\n"
+                           "000000000000\nFFFFFFFFFFFF\nB0B1B2B3B4B5\n";
+    mu_assert(
+        stream_write_cstring(file_stream, dict_str) == strlen(dict_str),
+        "write == true assert failed\r\n");
+    mu_assert(file_stream_close(file_stream), "file_stream_close == true assert failed\r\n");
+    stream_free(file_stream);
+
+    uint8_t key_present[6] = {0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7};
+    uint8_t key_absent[6] = {0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF8};
+    uint8_t key_new[6] = {0x21, 0x96, 0xFA, 0xD8, 0x11, 0x5B};
+    uint64_t keys_ref[] = {
+        0xFFFFFFFFFFFF, 0xA0A1A2A3A4A5, 0xD3F7D3F7D3F7, 0x000000000000, 0xB0B1B2B3B4B5};
+
+    // Cache entries are key << 16 | position, largest key is FFFFFFFFFFFF at position 4.
+    // Position out of range, position 5 listed twice: both must be rejected and rebuilt.
+    const uint64_t cache_corrupt[] = {0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFF0005};
+
+    // First pass compiles cache, second one loads it from file, next ones corrupt it
+    for(size_t pass = 0; pass < 2 + COUNT_OF(cache_corrupt); pass++) {
+        if(pass >= 2) {
+            mu_assert(
+                nfc_test_dict_cache_corrupt(storage, cache_corrupt[pass - 2]),
+                "cache corruption failed\r\n");
+        }
+        const size_t added = pass > 0 ? 1 : 0;
+
+        MfClassicDict* instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+        mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+        mu_assert(
+            mf_classic_dict_get_total_keys(instance) == 5 + added,
+            "mf_classic_dict_get_total_keys assert failed\r\n");
+
+        // Duplicates are skipped on iteration
+        uint64_t key = 0;
+        size_t key_count = 0;
+        while(mf_classic_dict_get_next_key(instance, &key)) {
+            if(key_count < COUNT_OF(keys_ref)) {
+                mu_assert(key == keys_ref[key_count], "invalid key order\r\n");
+            }
+            key_count++;
+        }
+        mu_assert(key_count == 5 + added, "duplicate key not skipped\r\n");
+        // Progress is based on total keys, iteration must reach it exactly
+        mu_assert(
+            key_count == mf_classic_dict_get_total_keys(instance),
+            "total keys don't match iteration\r\n");
+
+        uint32_t index = 0;
+        mu_assert(
+            mf_classic_dict_is_key_present(instance, key_present),
+            "mf_classic_dict_is_key_present == true assert failed\r\n");
+        mu_assert(
+            !mf_classic_dict_is_key_present(instance, key_absent),
+            "mf_classic_dict_is_key_present == false assert failed\r\n");
+        mu_assert(
+            mf_classic_dict_find_index(instance, key_present, &index) && index == 2,
+            "mf_classic_dict_find_index assert failed\r\n");
+
+        // First occurrence of duplicated key
+        FuriString* temp_str = furi_string_alloc_set("FFFFFFFFFFFF");
+        mu_assert(
+            mf_classic_dict_find_index_str(instance, temp_str, &index) && index == 0,
+            "mf_classic_dict_find_index_str assert failed\r\n");
+        furi_string_free(temp_str);
+
+        mu_assert(mf_classic_dict_rewind(instance), "mf_classic_dict_rewind assert failed\r\n");
+        mu_assert(
+            mf_classic_dict_get_key_at_index(instance, &key, 5) && key == 0xB0B1B2B3B4B5,
+            "mf_classic_dict_get_key_at_index assert failed\r\n");
+
+        if(pass == 0) {
+            mu_assert(
+                mf_classic_dict_add_key(instance, key_new),
+                "mf_classic_dict_add_key assert failed\r\n");
+        }
+        mu_assert(
+            mf_classic_dict_is_key_present(instance, key_new),
+            "added key not present assert failed\r\n");
+
+        mf_classic_dict_free(instance);
+    }
+
+    mu_assert(
+        storage_file_exists(storage, NFC_TEST_DICT_CACHE_PATH), "cache file not saved\r\n");
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_DICT_PATH), "remove == true assert failed\r\n");
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_DICT_CACHE_PATH),
+        "remove == true assert failed\r\n");
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(nfca_file_test) {
     NfcDevice* nfc = nfc_device_alloc();
     mu_assert(nfc != NULL, "nfc_device_data != NULL assert failed\r\n");
@@ -682,6 +803,51 @@ static void mf_classic_generator_test(uint8_t uid_len, MfClassicType type) {
     nfc_device_free(nfc_keys);
 }
 
+MU_TEST(crypto1_test) {
+    // Keystream of uid ^ nt and nr words, produced by bit at a time implementation
+    const uint64_t keys[] = {0xFFFFFFFFFFFF, 0xA0A1A2A3A4A5, 0x4D3A99C351DD};
+    const uint32_t ks_nt[] = {0xFFFFF51F, 0x1A81DB8B, 0x6057E863};
+    const uint32_t ks_nr[] = {0xA3E58F22, 0x5CF0E445, 0x5C1DC765};
+    const uint32_t uid_nt = 0x2A234F80 ^ 0x01200145;
+    const uint32_t nr = 0x15459649;
+    const size_t count = COUNT_OF(keys);
+
+    Crypto1 batch[COUNT_OF(keys)];
+    uint32_t out[COUNT_OF(keys)];
+    for(size_t i = 0; i < count; i++) {
+        crypto1_init(&batch[i], keys[i]);
+    }
+    crypto1_word_batch(batch, count, uid_nt, out, 0);
+    for(size_t i = 0; i < count; i++) {
+        mu_assert(out[i] == ks_nt[i], "crypto1_word_batch keystream mismatch\r\n");
+    }
+    crypto1_word_batch(batch, count, nr, out, 0);
+
+    for(size_t i = 0; i < count; i++) {
+        Crypto1 crypto, reference;
+        crypto1_init(&crypto, keys[i]);
+        mu_assert(crypto1_word(&crypto, uid_nt, 0) == ks_nt[i], "crypto1_word mismatch\r\n");
+        mu_assert(crypto1_word(&crypto, nr, 0) == ks_nr[i], "crypto1_word mismatch\r\n");
+        mu_assert(out[i] == ks_nr[i], "crypto1_word_batch keystream mismatch\r\n");
+        mu_assert(
+            (batch[i].odd == crypto.odd) && (batch[i].even == crypto.even),
+            "crypto1_word_batch state mismatch\r\n");
+
+        // Byte stepping, encrypted feedback included, against single bit steps
+        reference = crypto;
+        for(uint32_t in = 0; in < 256; in += 37) {
+            uint8_t expected = 0;
+            for(uint8_t bit = 0; bit < 8; bit++) {
+                expected |= crypto1_bit(&reference, FURI_BIT(in, bit), in & 1) << bit;
+            }
+            mu_assert(crypto1_byte(&crypto, in, in & 1) == expected, "crypto1_byte mismatch\r\n");
+            mu_assert(
+                (reference.odd == crypto.odd) && (reference.even == crypto.even),
+                "crypto1_byte state mismatch\r\n");
+        }
+    }
+}
+
 MU_TEST(mf_mini_file_test) {
     mf_classic_generator_test(4, MfClassicTypeMini);
 }
@@ -715,6 +881,8 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(mf_classic_dict_cache_test);
+    MU_RUN_TEST(crypto1_test);
 
     nfc_test_free();
 }
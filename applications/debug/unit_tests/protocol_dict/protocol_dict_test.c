@@ -212,8 +212,167 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+/*********************** SHARED DEMOD START ***********************/
+
+typedef struct {
+    uint32_t time;
+} TestDemodData;
+
+static size_t test_demod_alloc_count = 0;
+
+static void* test_demod_alloc() {
+    TestDemodData* demod = malloc(sizeof(TestDemodData));
+    demod->time = 0;
+    test_demod_alloc_count++;
+    return demod;
+}
+
+static void test_demod_free(TestDemodData* demod) {
+    test_demod_alloc_count--;
+    free(demod);
+}
+
+// one bit per 100us of period, bit value is high level length
+static void test_demod_feed(
+    TestDemodData* demod,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count) {
+    *count = 0;
+    if(level) {
+        demod->time = duration;
+    } else {
+        *value = demod->time > duration;
+        *count = (demod->time + duration) / 100;
+    }
+}
+
+static const ProtocolDemod test_demod = {
+    .alloc = (ProtocolDemodAlloc)test_demod_alloc,
+    .free = (ProtocolDemodFree)test_demod_free,
+    .feed = (ProtocolDemodFeed)test_demod_feed,
+};
+
+typedef struct {
+    uint8_t bits;
+    uint32_t data;
+} ProtocolBitsData;
+
+static void* protocol_bits_alloc() {
+    void* data = malloc(sizeof(ProtocolBitsData));
+    return data;
+}
+
+static void protocol_bits_free(ProtocolBitsData* data) {
+    free(data);
+}
+
+static uint8_t* protocol_bits_get_data(ProtocolBitsData* data) {
+    return (uint8_t*)&data->data;
+}
+
+static void protocol_bits_decoder_start(ProtocolBitsData* data) {
+    data->bits = 0;
+    data->data = 0;
+}
+
+static bool protocol_bits_push(ProtocolBitsData* data, bool value, uint32_t count, uint8_t match) {
+    for(size_t i = 0; i < count; i++) {
+        data->bits = (data->bits << 1) | value;
+        if(data->bits == match) {
+            data->data = match;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool protocol_2_decoder_feed_bits(ProtocolBitsData* data, bool value, uint32_t count) {
+    return protocol_bits_push(data, value, count, 0xF0);
+}
+
+static bool protocol_3_decoder_feed_bits(ProtocolBitsData* data, bool value, uint32_t count) {
+    return protocol_bits_push(data, value, count, 0xC3);
+}
+
+static const ProtocolBase protocol_2 = {
+    .name = "Protocol 2",
+    .manufacturer = "Manufacturer 2",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_bits_alloc,
+    .free = (ProtocolFree)protocol_bits_free,
+    .get_data = (ProtocolGetData)protocol_bits_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_bits_decoder_start,
+            .demod = &test_demod,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_2_decoder_feed_bits,
+        },
+};
+
+static const ProtocolBase protocol_3 = {
+    .name = "Protocol 3",
+    .manufacturer = "Manufacturer 3",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_bits_alloc,
+    .free = (ProtocolFree)protocol_bits_free,
+    .get_data = (ProtocolGetData)protocol_bits_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_bits_decoder_start,
+            .demod = &test_demod,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_3_decoder_feed_bits,
+        },
+};
+
+static const ProtocolBase* test_protocols_demod_base[] = {
+    &protocol_0,
+    &protocol_2,
+    &protocol_3,
+};
+
+MU_TEST(test_protocol_dict_demod) {
+    ProtocolDict* dict = protocol_dict_alloc(test_protocols_demod_base, 3);
+    mu_assert_int_eq(1, test_demod_alloc_count);
+
+    protocol_dict_decoders_start(dict);
+    ProtocolId protocol_id = PROTOCOL_NO;
+    uint32_t data = 0;
+
+    // four ones, four zeros: protocol 2 match
+    protocol_id = protocol_dict_decoders_feed(dict, true, 300);
+    mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    protocol_id = protocol_dict_decoders_feed(dict, false, 100);
+    mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    protocol_id = protocol_dict_decoders_feed(dict, true, 100);
+    mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    protocol_id = protocol_dict_decoders_feed(dict, false, 300);
+    mu_assert_int_eq(1, protocol_id);
+
+    protocol_dict_get_data(dict, protocol_id, (uint8_t*)&data, sizeof(data));
+    mu_assert_int_eq(0xF0, data);
+
+    // protocol 3 got the same bits, two more ones complete its match
+    protocol_id = protocol_dict_decoders_feed(dict, true, 150);
+    mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    protocol_id = protocol_dict_decoders_feed(dict, false, 50);
+    mu_assert_int_eq(2, protocol_id);
+
+    protocol_dict_get_data(dict, protocol_id, (uint8_t*)&data, sizeof(data));
+    mu_assert_int_eq(0xC3, data);
+
+    // plain decoders are still fed
+    protocol_id = protocol_dict_decoders_feed(dict, true, 666);
+    mu_assert_int_eq(0, protocol_id);
+
+    protocol_dict_free(dict);
+    mu_assert_int_eq(0, test_demod_alloc_count);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_demod);
 }
 
 int run_minunit_test_protocol_dict() {
@@ -44,7 +44,7 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 255
-#define MAX_DATA_SIZE 512u // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE RPC_CHUNK_SIZE_DEFAULT
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
@@ -718,6 +718,7 @@ static void
 static void test_rpc_add_read_to_list_by_reading_real_file(
     MsgList_t msg_list,
     const char* path,
+    size_t chunk_size,
     uint32_t command_id) {
     furi_check(MsgList_empty_p(msg_list));
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
@@ -737,10 +738,10 @@ static void test_rpc_add_read_to_list_by_reading_real_file(
             response->content.storage_read_response.has_file = true;
 
             response->content.storage_read_response.file.data =
-                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, MAX_DATA_SIZE)));
+                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, chunk_size)));
             uint8_t* buffer = response->content.storage_read_response.file.data->bytes;
             uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+            size_t read_size = MIN(size_left, chunk_size);
             *read_size_msg = storage_file_read(file, buffer, read_size);
             size_left -= read_size;
             result = (*read_size_msg == read_size);
@@ -769,7 +770,8 @@ static void test_storage_read_run(const char* path, uint32_t command_id) {
     MsgList_t expected_msg_list;
     MsgList_init(expected_msg_list);
 
-    test_rpc_add_read_to_list_by_reading_real_file(expected_msg_list, path, command_id);
+    test_rpc_add_read_to_list_by_reading_real_file(
+        expected_msg_list, path, rpc_session_get_chunk_size(rpc_session[0].session), command_id);
     test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, command_id);
     test_rpc_encode_and_feed_one(&request, 0);
     test_rpc_decode_and_compare(expected_msg_list, 0);
@@ -924,6 +926,28 @@ MU_TEST(test_storage_read) {
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
 }
 
+MU_TEST(test_storage_read_chunk_size) {
+    const size_t chunk_sizes[] = {1, 1000, 2048};
+
+    for(size_t i = 0; i < COUNT_OF(chunk_sizes); ++i) {
+        size_t chunk_size = chunk_sizes[i];
+        rpc_session_set_chunk_size(rpc_session[0].session, chunk_size);
+
+        test_create_file(TEST_DIR "empty.txt", 0);
+        test_create_file(TEST_DIR "chunk1.txt", chunk_size);
+        test_create_file(TEST_DIR "chunk2.txt", chunk_size * 2);
+        // more chunks than read-ahead keeps in flight
+        test_create_file(TEST_DIR "chunk3.txt", (chunk_size * 5) + 1);
+
+        test_storage_read_run(TEST_DIR "empty.txt", ++command_id);
+        test_storage_read_run(TEST_DIR "chunk1.txt", ++command_id);
+        test_storage_read_run(TEST_DIR "chunk2.txt", ++command_id);
+        test_storage_read_run(TEST_DIR "chunk3.txt", ++command_id);
+    }
+
+    rpc_session_set_chunk_size(rpc_session[0].session, MAX_DATA_SIZE);
+}
+
 static void test_storage_write_run(
     const char* path,
     size_t write_size,
@@ -993,6 +1017,14 @@ MU_TEST(test_storage_write_read) {
     test_storage_write_read_run(TEST_DIR "test1.txt", pattern1, sizeof(pattern1), 1, &command_id);
     test_storage_write_read_run(TEST_DIR "test2.txt", pattern1, 1, 1, &command_id);
     test_storage_write_read_run(TEST_DIR "test3.txt", pattern1, 0, 1, &command_id);
+
+    // Crosses write-behind buffer and read-ahead depth
+    uint8_t* pattern2 = malloc(MAX_DATA_SIZE);
+    for(size_t i = 0; i < MAX_DATA_SIZE; ++i) {
+        pattern2[i] = i * 7;
+    }
+    test_storage_write_read_run(TEST_DIR "test4.txt", pattern2, MAX_DATA_SIZE, 5, &command_id);
+    free(pattern2);
 }
 
 MU_TEST(test_storage_write) {
@@ -1112,6 +1144,102 @@ MU_TEST(test_storage_interrupt_continuous_another_system) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+#define TEST_THROUGHPUT_FILE_SIZE (32 * 1024)
+
+/* Loopback through send bytes callback: host side encodes and decodes the
+ * same way as a transport would, so timing includes protobuf and storage cost.
+ */
+static void test_storage_throughput_run(const char* path, size_t chunk_size) {
+    rpc_session_set_chunk_size(rpc_session[0].session, chunk_size);
+
+    uint8_t* pattern = malloc(chunk_size);
+    for(size_t i = 0; i < chunk_size; ++i) {
+        pattern[i] = '0' + (i % 10);
+    }
+
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+
+    uint32_t write_start = furi_get_tick();
+    uint32_t write_command_id = ++command_id;
+    size_t size_left = TEST_THROUGHPUT_FILE_SIZE;
+    while(size_left) {
+        size_t write_size = MIN(size_left, chunk_size);
+        size_left -= write_size;
+
+        PB_Main request = {
+            .command_id = write_command_id,
+            .command_status = PB_CommandStatus_OK,
+            .which_content = PB_Main_storage_write_request_tag,
+            .has_next = (size_left > 0),
+        };
+        PB_Storage_File* msg_file = &request.content.storage_write_request.file;
+        request.content.storage_write_request.path = strdup(path);
+        request.content.storage_write_request.has_file = true;
+        msg_file->data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(write_size));
+        msg_file->data->size = write_size;
+        memcpy(msg_file->data->bytes, pattern, write_size);
+
+        test_rpc_encode_and_feed_one(&request, 0);
+    }
+    test_rpc_add_empty_to_list(expected_msg_list, PB_CommandStatus_OK, write_command_id);
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+    uint32_t write_time = furi_get_tick() - write_start;
+
+    uint32_t read_start = furi_get_tick();
+    PB_Main request;
+    test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, ++command_id);
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    size_t received = 0;
+    bool has_next = true;
+    while(has_next) {
+        rpc_session[0].timeout = xTaskGetTickCount() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+        PB_Main result = {.cb_content.funcs.decode = NULL};
+        if(!pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+            mu_fail("read response not decoded");
+            break;
+        }
+
+        mu_check(result.command_status == PB_CommandStatus_OK);
+        mu_check(result.which_content == PB_Main_storage_read_response_tag);
+        PB_Storage_File* msg_file = &result.content.storage_read_response.file;
+        if(msg_file->data) {
+            mu_check(msg_file->data->size <= chunk_size);
+            mu_check(!memcmp(msg_file->data->bytes, pattern, msg_file->data->size));
+            received += msg_file->data->size;
+        }
+        has_next = result.has_next;
+        pb_release(&PB_Main_msg, &result);
+    }
+    uint32_t read_time = furi_get_tick() - read_start;
+    mu_assert(received == TEST_THROUGHPUT_FILE_SIZE, "read size mismatch\r\n");
+
+    FURI_LOG_I(
+        TAG,
+        "Chunk %zu: write %lu B/s, read %lu B/s",
+        chunk_size,
+        (uint32_t)(TEST_THROUGHPUT_FILE_SIZE * 1000ULL / MAX(write_time, 1UL)),
+        (uint32_t)(TEST_THROUGHPUT_FILE_SIZE * 1000ULL / MAX(read_time, 1UL)));
+
+    test_rpc_free_msg_list(expected_msg_list);
+    free(pattern);
+}
+
+MU_TEST(test_storage_throughput) {
+    for(size_t chunk_size = MAX_DATA_SIZE; chunk_size <= 2048; chunk_size *= 2) {
+        test_storage_throughput_run(TEST_DIR "throughput.bin", chunk_size);
+    }
+
+    rpc_session_set_chunk_size(rpc_session[0].session, MAX_DATA_SIZE);
+}
+
 static void test_storage_delete_run(
     const char* path,
     size_t command_id,
@@ -1434,8 +1562,10 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_stat);
     MU_RUN_TEST(test_storage_list);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_chunk_size);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
+    MU_RUN_TEST(test_storage_throughput);
     MU_RUN_TEST(test_storage_delete);
     MU_RUN_TEST(test_storage_delete_recursive);
     MU_RUN_TEST(test_storage_mkdir);
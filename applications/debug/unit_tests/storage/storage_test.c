@@ -1,6 +1,7 @@
 #include "../minunit.h"
 #include <furi.h>
 #include <storage/storage.h>
+#include <gui/modules/file_browser_index.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
@@ -12,6 +13,8 @@
 #define STORAGE_LOCKED_DIR STORAGE_INT_PATH_PREFIX
 
 #define STORAGE_TEST_DIR UNIT_TESTS_PATH("test_dir")
+#define STORAGE_BATCH_DIR UNIT_TESTS_PATH("batch_dir")
+#define STORAGE_BATCH_BENCHMARK_FILES 5000
 
 static bool storage_file_create(Storage* storage, const char* path, const char* data) {
     File* file = storage_file_alloc(storage);
@@ -194,10 +197,251 @@ MU_TEST(storage_dir_exists_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_batch_dir_create(Storage* storage, size_t files_count, bool long_names) {
+    FuriString* path = furi_string_alloc();
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    furi_check(storage_simply_mkdir(storage, STORAGE_BATCH_DIR));
+
+    for(size_t i = 0; i < files_count; i++) {
+        furi_string_printf(path, STORAGE_BATCH_DIR "/%04u", (unsigned)i);
+        if(long_names) {
+            // Names up to 200 characters make reading stop on arena space
+            for(size_t j = 0; j < (i * 37) % 200; j++) {
+                furi_string_push_back(path, 'a' + (j % 26));
+            }
+        }
+        furi_check(storage_file_create(storage, furi_string_get_cstr(path), "data"));
+    }
+
+    furi_string_free(path);
+}
+
+typedef struct {
+    uint32_t hash;
+    size_t count;
+} StorageBatchListing;
+
+// Listing digest, 5000 names don't fit in memory as text
+static void
+    storage_batch_listing_add(StorageBatchListing* listing, const char* name, uint64_t size) {
+    uint32_t hash = listing->hash ? listing->hash : 2166136261UL;
+    for(; *name; name++) {
+        hash = (hash ^ (uint8_t)*name) * 16777619UL;
+    }
+    listing->hash = (hash ^ (uint32_t)size) * 16777619UL;
+    listing->count++;
+}
+
+static void storage_batch_dir_list_single(Storage* storage, StorageBatchListing* listing) {
+    File* file = storage_file_alloc(storage);
+    FileInfo fileinfo;
+    char name[STORAGE_DIR_NAME_LENGTH_MAX];
+
+    furi_check(storage_dir_open(file, STORAGE_BATCH_DIR));
+    while(storage_dir_read(file, &fileinfo, name, sizeof(name))) {
+        storage_batch_listing_add(listing, name, fileinfo.size);
+    }
+    storage_dir_close(file);
+    storage_file_free(file);
+}
+
+static void storage_batch_dir_list_many(
+    Storage* storage,
+    StorageBatchListing* listing,
+    size_t entries_count,
+    size_t arena_size) {
+    File* file = storage_file_alloc(storage);
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * entries_count);
+    char* arena = malloc(arena_size);
+
+    furi_check(storage_dir_open(file, STORAGE_BATCH_DIR));
+    size_t entries_read;
+    do {
+        entries_read = storage_dir_read_many(file, entries, entries_count, arena, arena_size);
+        for(size_t i = 0; i < entries_read; i++) {
+            storage_batch_listing_add(listing, entries[i].name, entries[i].fileinfo.size);
+            // SD card keeps modification time
+            mu_check(entries[i].mtime != 0);
+        }
+    } while(entries_read);
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(file));
+    storage_dir_close(file);
+
+    free(arena);
+    free(entries);
+    storage_file_free(file);
+}
+
+static void
+    storage_batch_listing_check(StorageBatchListing* expected, StorageBatchListing* listing) {
+    mu_assert_int_eq(expected->count, listing->count);
+    mu_assert_int_eq(expected->hash, listing->hash);
+    *listing = (StorageBatchListing){0};
+}
+
+MU_TEST(storage_dir_read_many_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    StorageBatchListing expected = {0};
+    StorageBatchListing listing = {0};
+
+    storage_batch_dir_create(storage, 40, true);
+    storage_batch_dir_list_single(storage, &expected);
+    mu_assert_int_eq(40, expected.count);
+
+    storage_batch_dir_list_many(storage, &listing, 1, STORAGE_DIR_NAME_LENGTH_MAX);
+    storage_batch_listing_check(&expected, &listing);
+
+    storage_batch_dir_list_many(storage, &listing, 7, 512);
+    storage_batch_listing_check(&expected, &listing);
+
+    storage_batch_dir_list_many(storage, &listing, 64, 16 * 1024);
+    storage_batch_listing_check(&expected, &listing);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_read_many_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    StorageBatchListing expected = {0};
+    StorageBatchListing listing = {0};
+
+    storage_batch_dir_create(storage, STORAGE_BATCH_BENCHMARK_FILES, false);
+
+    uint32_t start = furi_get_tick();
+    storage_batch_dir_list_single(storage, &expected);
+    uint32_t single_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    storage_batch_dir_list_many(storage, &listing, 16, 1024);
+    uint32_t many_time = furi_get_tick() - start;
+
+    mu_assert_int_eq(STORAGE_BATCH_BENCHMARK_FILES, expected.count);
+    storage_batch_listing_check(&expected, &listing);
+    FURI_LOG_I(
+        "StorageTest",
+        "Listing %u files: storage_dir_read %lums, storage_dir_read_many %lums",
+        STORAGE_BATCH_BENCHMARK_FILES,
+        single_time,
+        many_time);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_dir_index_check_order(BrowserIndex* index, const char* first, uint32_t count) {
+    char previous[STORAGE_DIR_NAME_LENGTH_MAX] = {0};
+    const BrowserIndexEntry* entry;
+
+    mu_assert_int_eq(count, browser_index_get_count(index));
+    mu_check(browser_index_is_sorted(index));
+    mu_check(browser_index_seek(index, 0));
+    for(uint32_t i = 0; i < count; i++) {
+        entry = browser_index_read(index);
+        mu_check(entry != NULL);
+        mu_check(!entry->is_dir);
+        mu_assert_int_eq(4, entry->size);
+        if(i == 0) {
+            mu_assert_string_eq(first, entry->name);
+        } else {
+            mu_check(strcmp(previous, entry->name) < 0);
+        }
+        strlcpy(previous, entry->name, sizeof(previous));
+    }
+    mu_check(browser_index_read(index) == NULL);
+    browser_index_close(index);
+}
+
+MU_TEST(storage_dir_index_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    BrowserIndex* index = browser_index_alloc();
+
+    mu_check(!browser_index_open(index, STORAGE_INT_PATH_PREFIX, NULL, NULL));
+    mu_check(!browser_index_open(index, BROWSER_INDEX_PATH, NULL, NULL));
+
+    storage_batch_dir_create(storage, 40, false);
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    storage_dir_index_check_order(index, "0000", 40);
+
+    // Page start and position inside page
+    mu_check(browser_index_seek(index, BROWSER_INDEX_PAGE_SIZE + 1));
+    const BrowserIndexEntry* entry = browser_index_read(index);
+    mu_check(entry != NULL);
+    mu_assert_string_eq("0033", entry->name);
+    browser_index_close(index);
+
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    storage_dir_index_check_order(index, "0000", 40);
+
+    mu_check(storage_file_create(storage, STORAGE_BATCH_DIR "/0040", "data"));
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    storage_dir_index_check_order(index, "0000", 41);
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_BATCH_DIR "/0000"));
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    storage_dir_index_check_order(index, "0001", 40);
+
+    browser_index_free(index);
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_index_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    BrowserIndex* index = browser_index_alloc();
+    StorageBatchListing listing = {0};
+
+    storage_batch_dir_create(storage, STORAGE_BATCH_BENCHMARK_FILES, false);
+
+    uint32_t start = furi_get_tick();
+    storage_batch_dir_list_many(storage, &listing, 16, 1024);
+    uint32_t list_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    uint32_t build_time = furi_get_tick() - start;
+
+    // Index build modified storage, next open checks directory again
+    furi_delay_ms(1000);
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+
+    start = furi_get_tick();
+    mu_check(browser_index_open(index, STORAGE_BATCH_DIR, NULL, NULL));
+    uint32_t open_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    uint32_t count = 0;
+    mu_check(browser_index_seek(index, 0));
+    while(browser_index_read(index) != NULL) {
+        count++;
+    }
+    browser_index_close(index);
+    uint32_t read_time = furi_get_tick() - start;
+
+    mu_assert_int_eq(STORAGE_BATCH_BENCHMARK_FILES, count);
+    FURI_LOG_I(
+        "StorageTest",
+        "Index %u files: listing %lums, build %lums, open %lums, read %lums",
+        STORAGE_BATCH_BENCHMARK_FILES,
+        list_time,
+        build_time,
+        open_time,
+        read_time);
+    mu_check(open_time + read_time < list_time);
+
+    browser_index_free(index);
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_open_close);
     MU_RUN_TEST(storage_dir_open_lock);
     MU_RUN_TEST(storage_dir_exists_test);
+    MU_RUN_TEST(storage_dir_read_many_test);
+    MU_RUN_TEST(storage_dir_read_many_benchmark);
+    MU_RUN_TEST(storage_dir_index_test);
+    MU_RUN_TEST(storage_dir_index_benchmark);
 }
 
 static const char* const storage_copy_test_paths[] = {
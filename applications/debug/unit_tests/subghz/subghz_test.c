@@ -3,9 +3,13 @@
 #include "../minunit.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
-#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/subghz_keystore_i.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/custom_btn.h>
+#include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format_i.h>
 
 #define TAG "SubGhz TEST"
@@ -15,6 +19,8 @@
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_RANDOM_BINARY_NAME EXT_PATH("unit_tests/subghz/test_random_raw_binary.sub")
+#define TEST_RANDOM_TEXT_NAME EXT_PATH("unit_tests/subghz/test_random_raw_text.sub")
 #define TEST_TIMEOUT 10000
 
 static SubGhzEnvironment* environment_handler;
@@ -143,6 +149,89 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+typedef enum {
+    SubGhzDispatchTestModeLegacy,
+    SubGhzDispatchTestModeTable,
+    SubGhzDispatchTestModeTableTiming,
+} SubGhzDispatchTestMode;
+
+static const char* const subghz_dispatch_test_mode_name[] = {
+    [SubGhzDispatchTestModeLegacy] = "legacy",
+    [SubGhzDispatchTestModeTable] = "table",
+    [SubGhzDispatchTestModeTableTiming] = "table+timing",
+};
+
+static uint16_t subghz_dispatch_test(const char* path, SubGhzDispatchTestMode mode) {
+    subghz_test_decoder_count = 0;
+    subghz_receiver_set_timing_filter(
+        receiver_handler, mode == SubGhzDispatchTestModeTableTiming);
+    subghz_receiver_reset(receiver_handler);
+
+    // Per slot dispatch the way receiver did it before the dispatch table
+    size_t decoders_count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    SubGhzProtocolDecoderBase** decoders = malloc(sizeof(void*) * decoders_count);
+    for(size_t i = 0; i < decoders_count; i++) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i);
+        decoders[i] =
+            subghz_receiver_search_decoder_base_by_name(receiver_handler, protocol->name);
+    }
+
+    uint32_t edges = 0;
+    uint32_t cycles = 0;
+    uint32_t test_start = furi_get_tick();
+
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        LevelDuration level_duration;
+        while(furi_get_tick() - test_start < TEST_TIMEOUT * 10) {
+            level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
+            if(level_duration_is_reset(level_duration)) {
+                break;
+            }
+
+            bool level = level_duration_get_level(level_duration);
+            uint32_t duration = level_duration_get_duration(level_duration);
+            // Yield, to load data inside the worker
+            furi_thread_yield();
+
+            uint32_t cycle_start = DWT->CYCCNT;
+            if(mode == SubGhzDispatchTestModeLegacy) {
+                for(size_t i = 0; i < decoders_count; i++) {
+                    SubGhzProtocolDecoderBase* decoder = decoders[i];
+                    if(decoder && (decoder->protocol->flag & SubGhzProtocolFlag_Decodable) != 0) {
+                        decoder->protocol->decoder->feed(decoder, level, duration);
+                    }
+                }
+            } else {
+                subghz_receiver_decode(receiver_handler, level, duration);
+            }
+            cycles += DWT->CYCCNT - cycle_start;
+            edges++;
+        }
+        furi_delay_ms(10);
+        if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
+            subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+        }
+        subghz_file_encoder_worker_free(file_worker_encoder_handler);
+    }
+    free(decoders);
+    subghz_receiver_set_timing_filter(receiver_handler, false);
+
+    printf(
+        "Dispatch %s: %lu edges, %lu cycles/edge, %u decoded\r\n",
+        subghz_dispatch_test_mode_name[mode],
+        edges,
+        edges ? cycles / edges : 0,
+        subghz_test_decoder_count);
+
+    return subghz_test_decoder_count;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -206,12 +295,343 @@ static bool subghz_encoder_test(const char* path) {
     return subghz_test_decoder_count ? true : false;
 }
 
+static bool subghz_transmitter_key_run(const char* name, uint16_t bits, uint32_t te) {
+    subghz_test_decoder_count = 0;
+    uint32_t test_start = furi_get_tick();
+    const uint64_t keys[] = {0x1, 0x5A5, 0xAAA};
+    bool result = true;
+
+    SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment_handler, name);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver_handler, name);
+
+    // Next key is queued while current one is yielded, decoder must get every key
+    result = subghz_transmitter_set_key(transmitter, keys[0], bits, te, 3) ==
+             SubGhzProtocolStatusOk;
+    for(size_t i = 1; i <= COUNT_OF(keys) && result && decoder; i++) {
+        if(i < COUNT_OF(keys)) {
+            result = subghz_transmitter_queue_key(transmitter, keys[i], bits, te, 3) ==
+                     SubGhzProtocolStatusOk;
+        }
+        while(furi_get_tick() - test_start < TEST_TIMEOUT) {
+            if(i < COUNT_OF(keys) && !subghz_transmitter_is_key_queued(transmitter)) break;
+            LevelDuration level_duration = subghz_transmitter_yield(transmitter);
+            if(level_duration_is_reset(level_duration)) break;
+            bool level = level_duration_get_level(level_duration);
+            uint32_t duration = level_duration_get_duration(level_duration);
+            decoder->protocol->decoder->feed(decoder, level, duration);
+        }
+    }
+    furi_delay_ms(10);
+    subghz_transmitter_free(transmitter);
+
+    FURI_LOG_T(TAG, "\r\n Decoder count parse \033[0;33m%d\033[0m ", subghz_test_decoder_count);
+    if(furi_get_tick() - test_start > TEST_TIMEOUT) {
+        printf("\033[0;31mTest transmitter key %s ERROR TimeOut\033[0m\r\n", name);
+        result = false;
+    }
+
+    return result && decoder && (subghz_test_decoder_count >= COUNT_OF(keys));
+}
+
 MU_TEST(subghz_keystore_test) {
     mu_assert(
         subghz_environment_load_keystore(environment_handler, KEYSTORE_DIR_NAME),
         "Test keystore error");
 }
 
+#define KEELOQ_BATCH_TEST_KEYS 10000
+#define KEELOQ_BATCH_TEST_MATCH 9000
+#define KEELOQ_BATCH_TEST_DATA 0xA3FF1234
+
+static uint64_t subghz_keeloq_batch_test_key(size_t index) {
+    // Deterministic synthetic keystore, splitmix64
+    uint64_t z = (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+MU_TEST(subghz_keeloq_batch_test) {
+    const uint32_t hop = subghz_protocol_keeloq_common_encrypt(
+        KEELOQ_BATCH_TEST_DATA, subghz_keeloq_batch_test_key(KEELOQ_BATCH_TEST_MATCH));
+
+    size_t scalar_match = SIZE_MAX;
+    size_t batch_match = SIZE_MAX;
+    size_t mismatch = 0;
+    uint32_t scalar_cycles = 0;
+    uint32_t batch_cycles = 0;
+
+    uint64_t keys[KEELOQ_BATCH_SIZE];
+    uint32_t decrypt[KEELOQ_BATCH_SIZE];
+    for(size_t base = 0; base < KEELOQ_BATCH_TEST_KEYS; base += KEELOQ_BATCH_SIZE) {
+        size_t count = MIN((size_t)KEELOQ_BATCH_SIZE, KEELOQ_BATCH_TEST_KEYS - base);
+        for(size_t i = 0; i < count; i++) {
+            keys[i] = subghz_keeloq_batch_test_key(base + i);
+        }
+
+        uint32_t cycle_start = DWT->CYCCNT;
+        subghz_protocol_keeloq_common_decrypt_batch(hop, keys, decrypt, count);
+        batch_cycles += DWT->CYCCNT - cycle_start;
+
+        for(size_t i = 0; i < count; i++) {
+            cycle_start = DWT->CYCCNT;
+            uint32_t expected = subghz_protocol_keeloq_common_decrypt(hop, keys[i]);
+            scalar_cycles += DWT->CYCCNT - cycle_start;
+
+            if(expected != decrypt[i]) {
+                mismatch++;
+            }
+            if(expected == KEELOQ_BATCH_TEST_DATA && scalar_match == SIZE_MAX) {
+                scalar_match = base + i;
+            }
+            if(decrypt[i] == KEELOQ_BATCH_TEST_DATA && batch_match == SIZE_MAX) {
+                batch_match = base + i;
+            }
+        }
+    }
+
+    printf(
+        "KeeLoq %d keys: scalar %lu us, batch %lu us\r\n",
+        KEELOQ_BATCH_TEST_KEYS,
+        scalar_cycles / furi_hal_cortex_instructions_per_microsecond(),
+        batch_cycles / furi_hal_cortex_instructions_per_microsecond());
+
+    mu_assert(mismatch == 0, "KeeLoq batch decrypt differs from scalar\r\n");
+    mu_assert(scalar_match == KEELOQ_BATCH_TEST_MATCH, "KeeLoq scalar key not found\r\n");
+    mu_assert(batch_match == KEELOQ_BATCH_TEST_MATCH, "KeeLoq batch key not found\r\n");
+}
+
+#define KEELOQ_SELECTOR_TEST_KEYS (4 * KEELOQ_BATCH_SIZE + 9)
+#define KEELOQ_SELECTOR_TEST_NAMES 5
+#define KEELOQ_SELECTOR_TEST_SEED 0x1A2B3C4D
+
+static const char* const subghz_keeloq_selector_test_name[KEELOQ_SELECTOR_TEST_NAMES] = {
+    "Test_A",
+    "Test_B",
+    "Test_C",
+    "Test_D",
+    "Test_E",
+};
+
+static uint64_t subghz_keeloq_selector_test_mirror(uint64_t key) {
+    uint64_t man_rev = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+    }
+    return man_rev;
+}
+
+/** Man keys of one keystore entry in the order the per key selector tried them */
+static size_t subghz_keeloq_selector_test_man(
+    const SubGhzKey* code,
+    uint32_t fix,
+    uint64_t* man,
+    uint8_t* kl_type) {
+    const uint32_t seed = KEELOQ_SELECTOR_TEST_SEED;
+    const uint64_t key = code->key;
+    const uint64_t rev = subghz_keeloq_selector_test_mirror(key);
+    size_t count = 0;
+
+    switch(code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        man[count++] = key;
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        kl_type[count] = 1;
+        man[count++] = key;
+        kl_type[count] = 1;
+        man[count++] = rev;
+        kl_type[count] = 2;
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        kl_type[count] = 2;
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, rev);
+        kl_type[count] = 3;
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+        kl_type[count] = 3;
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, rev);
+        kl_type[count] = 4;
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        kl_type[count] = 4;
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, rev);
+        break;
+    }
+    if(code->type != KEELOQ_LEARNING_UNKNOWN) {
+        memset(kl_type, 0, count);
+    }
+
+    return count;
+}
+
+/** Reference: per key search the way keeloq selector did it before batching */
+static bool subghz_keeloq_selector_test_reference(
+    SubGhzKeyArray_t* data,
+    const char* mfname,
+    uint32_t fix,
+    uint32_t hop,
+    const char** name,
+    uint16_t* cnt,
+    uint8_t* kl_type) {
+    const uint8_t btn = fix >> 28;
+    const uint8_t end_serial = fix & 0xFF;
+    uint64_t man[8];
+    uint8_t man_kl_type[8];
+
+    for
+        M_EACH(code, *data, SubGhzKeyArray_t) {
+            if(mfname && strcmp(furi_string_get_cstr(code->name), mfname) != 0) continue;
+            size_t count = subghz_keeloq_selector_test_man(code, fix, man, man_kl_type);
+            for(size_t i = 0; i < count; i++) {
+                uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man[i]);
+                uint8_t discriminator = (decrypt >> 16) & 0xFF;
+                if((decrypt >> 28) == btn &&
+                   (discriminator == end_serial || discriminator == 0)) {
+                    *name = furi_string_get_cstr(code->name);
+                    *cnt = decrypt & 0xFFFF;
+                    *kl_type = man_kl_type[i];
+                    return true;
+                }
+            }
+        }
+
+    *name = "Unknown";
+    *cnt = 0;
+    *kl_type = 0;
+    return false;
+}
+
+/** Decode parcel with keeloq decoder and check it against reference */
+static bool subghz_keeloq_selector_test_parcel(
+    SubGhzEnvironment* environment,
+    void* decoder,
+    const char* mfname,
+    uint32_t fix,
+    uint32_t hop) {
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+
+    // AN-Motors and HCS101 are told apart before the keystore search
+    if((hop & 0xFFF) == 0x404 || (hop & 0xFFF) == 0x000) return true;
+
+    const char* name;
+    uint16_t cnt;
+    uint8_t kl_type;
+    subghz_keeloq_selector_test_reference(
+        subghz_keystore_get_data(keystore), mfname, fix, hop, &name, &cnt, &kl_type);
+
+    uint64_t data = subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[i] = data >> (56 - i * 8);
+    }
+    const uint8_t seed_data[sizeof(uint32_t)] = {0x1A, 0x2B, 0x3C, 0x4D};
+    const uint32_t bit = 64;
+
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    flipper_format_write_uint32(flipper_format, "Bit", &bit, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+    flipper_format_write_hex(flipper_format, "Seed", seed_data, sizeof(uint32_t));
+    if(mfname) {
+        flipper_format_write_string_cstr(flipper_format, "Manufacture", mfname);
+    }
+
+    FuriString* output = furi_string_alloc();
+    FuriString* expected = furi_string_alloc();
+    subghz_environment_reset_keeloq(environment);
+    bool result = subghz_protocol_decoder_keeloq_deserialize(decoder, flipper_format) ==
+                  SubGhzProtocolStatusOk;
+    if(result) {
+        subghz_protocol_decoder_keeloq_get_string(decoder, output);
+
+        furi_string_printf(expected, "Cnt:%04X", cnt);
+        result &= furi_string_search(output, expected) != FURI_STRING_FAILURE;
+        furi_string_printf(expected, "MF:%s", name);
+        result &= furi_string_end_with(output, expected);
+        result &= keystore->kl_type == kl_type;
+    }
+
+    if(!result) {
+        FURI_LOG_E(
+            TAG,
+            "KeeLoq selector fix %08lX hop %08lX: expected %s cnt %04X type %u, got %s type %u",
+            fix,
+            hop,
+            name,
+            cnt,
+            kl_type,
+            furi_string_get_cstr(output),
+            keystore->kl_type);
+    }
+
+    furi_string_free(expected);
+    furi_string_free(output);
+    flipper_format_free(flipper_format);
+
+    return result;
+}
+
+MU_TEST(subghz_keeloq_selector_test) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+
+    // Every learning type, keys spanning several batches, some keys shared by two entries
+    for(size_t i = 0; i < KEELOQ_SELECTOR_TEST_KEYS; i++) {
+        SubGhzKey* code = SubGhzKeyArray_push_raw(*subghz_keystore_get_data(keystore));
+        code->name = furi_string_alloc_set(
+            subghz_keeloq_selector_test_name[i % KEELOQ_SELECTOR_TEST_NAMES]);
+        code->key = subghz_keeloq_batch_test_key(i % 11 == 10 ? i - 7 : i);
+        code->type = i % (KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 + 1);
+    }
+
+    void* decoder = subghz_protocol_decoder_keeloq_alloc(environment);
+    size_t failed = 0;
+    uint64_t man[8];
+    uint8_t kl_type[8];
+
+    for(size_t i = 0; i < KEELOQ_SELECTOR_TEST_KEYS; i++) {
+        const SubGhzKey* code = SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), i);
+        const uint32_t fix = (uint32_t)(i % 4 + 1) << 28 |
+                             (subghz_keeloq_batch_test_key(i + 1000) & 0x0FFFFFFF);
+        size_t count = subghz_keeloq_selector_test_man(code, fix, man, kl_type);
+
+        // Parcel for every way to derive man from this key, first match must win
+        for(size_t j = 0; j < count; j++) {
+            uint32_t data = (fix & 0xF0000000) | (fix & 0xFF) << 16 | (i * 8 + j);
+            uint32_t hop = subghz_protocol_keeloq_common_encrypt(data, man[j]);
+            failed += !subghz_keeloq_selector_test_parcel(environment, decoder, NULL, fix, hop);
+            failed += !subghz_keeloq_selector_test_parcel(
+                environment, decoder, furi_string_get_cstr(code->name), fix, hop);
+        }
+
+        // Random parcel, usually no key decrypts it and whole keystore is searched
+        uint32_t hop = subghz_keeloq_batch_test_key(i + 2000);
+        failed += !subghz_keeloq_selector_test_parcel(environment, decoder, NULL, fix, hop);
+    }
+
+    subghz_protocol_decoder_keeloq_free(decoder);
+    subghz_environment_free(environment);
+    subghz_custom_btns_reset();
+
+    mu_assert(failed == 0, "KeeLoq selector differs from per key search\r\n");
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -652,6 +1072,18 @@ MU_TEST(subghz_decoder_kinggates_stylo4k_test) {
 }
 
 //test encoders
+MU_TEST(subghz_transmitter_key_test) {
+    mu_assert(
+        subghz_transmitter_key_run(SUBGHZ_PROTOCOL_CAME_NAME, 12, 0),
+        "Test transmitter key " SUBGHZ_PROTOCOL_CAME_NAME " error\r\n");
+    mu_assert(
+        subghz_transmitter_key_run(SUBGHZ_PROTOCOL_PRINCETON_NAME, 24, 400),
+        "Test transmitter key " SUBGHZ_PROTOCOL_PRINCETON_NAME " error\r\n");
+    mu_assert(
+        subghz_transmitter_key_run(SUBGHZ_PROTOCOL_GATE_TX_NAME, 24, 0),
+        "Test transmitter key " SUBGHZ_PROTOCOL_GATE_TX_NAME " error\r\n");
+}
+
 MU_TEST(subghz_encoder_princeton_test) {
     mu_assert(
         subghz_encoder_test(EXT_PATH("unit_tests/subghz/princeton.sub")),
@@ -806,9 +1238,48 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+MU_TEST(subghz_dispatch_test) {
+    uint16_t legacy_count =
+        subghz_dispatch_test(TEST_RANDOM_DIR_NAME, SubGhzDispatchTestModeLegacy);
+    uint16_t table_count = subghz_dispatch_test(TEST_RANDOM_DIR_NAME, SubGhzDispatchTestModeTable);
+    uint16_t timing_count =
+        subghz_dispatch_test(TEST_RANDOM_DIR_NAME, SubGhzDispatchTestModeTableTiming);
+    mu_assert(legacy_count == table_count, "Dispatch table result differs from legacy\r\n");
+    mu_assert(
+        timing_count == table_count, "Timing pre-screen result differs from dispatch table\r\n");
+}
+
+MU_TEST(subghz_raw_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mu_assert(
+        subghz_protocol_raw_convert_file(
+            storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_NAME, true),
+        "RAW text to binary conversion error\r\n");
+    mu_assert(
+        !subghz_protocol_raw_convert_file(
+            storage, TEST_RANDOM_BINARY_NAME, TEST_RANDOM_TEXT_NAME, true),
+        "RAW binary file converted to binary\r\n");
+    mu_assert(
+        subghz_protocol_raw_convert_file(
+            storage, TEST_RANDOM_BINARY_NAME, TEST_RANDOM_TEXT_NAME, false),
+        "RAW binary to text conversion error\r\n");
+
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_BINARY_NAME), "Random binary test error\r\n");
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_TEXT_NAME), "Random converted test error\r\n");
+
+    storage_simply_remove(storage, TEST_RANDOM_BINARY_NAME);
+    storage_simply_remove(storage, TEST_RANDOM_TEXT_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keeloq_batch_test);
+    MU_RUN_TEST(subghz_keeloq_selector_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -854,6 +1325,7 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_nice_one_test);
     MU_RUN_TEST(subghz_decoder_kinggates_stylo4k_test);
 
+    MU_RUN_TEST(subghz_transmitter_key_test);
     MU_RUN_TEST(subghz_encoder_princeton_test);
     MU_RUN_TEST(subghz_encoder_came_test);
     MU_RUN_TEST(subghz_encoder_came_twee_test);
@@ -881,6 +1353,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dooya_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_raw_binary_test);
+    MU_RUN_TEST(subghz_dispatch_test);
     subghz_test_deinit();
 }
 
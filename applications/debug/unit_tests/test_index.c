@@ -27,6 +27,8 @@ int run_minunit_test_nfc();
 int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
+int run_minunit_test_compress();
+int run_minunit_test_gui();
 
 typedef int (*UnitTestEntry)();
 
@@ -55,6 +57,8 @@ const UnitTest unit_tests[] = {
     {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
     {.name = "float_tools", .entry = run_minunit_test_float_tools},
     {.name = "bt", .entry = run_minunit_test_bt},
+    {.name = "compress", .entry = run_minunit_test_compress},
+    {.name = "gui", .entry = run_minunit_test_gui},
 };
 
 void minunit_print_progress() {
@@ -10,16 +10,23 @@
 
 static_assert(!has_hash_collisions(app_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface applicaton_hashtable_api_interface{
+/* perfect hash is built at compile time, lookup is O(1) */
+static constexpr auto app_api_perfect_hash = create_perfect_hash(app_api_table);
+static_assert(app_api_perfect_hash.valid, "Can't build API perfect hash!");
+
+constexpr PerfectHashApiInterface applicaton_hashtable_api_interface{
     {
         .api_version_major = 0,
         .api_version_minor = 0,
-        /* generic resolver using pre-sorted array */
-        .resolver_callback = &elf_resolve_from_hashtable,
+        /* generic resolver using perfect hash table */
+        .resolver_callback = &elf_resolve_from_perfect_hash,
     },
-    /* pointers to application's API table boundaries */
-    .table_cbegin = app_api_table.cbegin(),
-    .table_cend = app_api_table.cend(),
+    /* pointers to application's API table and bucket seeds */
+    .table_cbegin = app_api_perfect_hash.slots.cbegin(),
+    .table_cend = app_api_perfect_hash.slots.cend(),
+    .bucket_seeds = app_api_perfect_hash.seeds.data(),
+    .bucket_count = app_api_perfect_hash.seeds.size(),
+    .salt = app_api_perfect_hash.salt,
 };
 
 /* Casting to generic resolver to use in Composite API resolver */
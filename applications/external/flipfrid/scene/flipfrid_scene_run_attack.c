@@ -362,7 +362,7 @@ void flipfrid_scene_run_attack_on_tick(FlipFridState* context) {
                         break;
                     }
                     if(end_of_list) break;
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(furi_string_size(context->data_str) != 11) {
                         context->attack_step = 0;
                         counter = 0;
@@ -400,7 +400,7 @@ void flipfrid_scene_run_attack_on_tick(FlipFridState* context) {
                         break;
                     }
                     if(end_of_list) break;
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(furi_string_size(context->data_str) != 9) {
                         context->attack_step = 0;
                         counter = 0;
@@ -438,7 +438,7 @@ void flipfrid_scene_run_attack_on_tick(FlipFridState* context) {
                         break;
                     }
                     if(end_of_list) break;
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(furi_string_size(context->data_str) != 7) {
                         context->attack_step = 0;
                         counter = 0;
@@ -475,7 +475,7 @@ void flipfrid_scene_run_attack_on_tick(FlipFridState* context) {
                         if(furi_string_size(context->data_str) != 13) break;
                         break;
                     }
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(end_of_list) break;
                     if(furi_string_size(context->data_str) != 13) {
                         context->attack_step = 0;
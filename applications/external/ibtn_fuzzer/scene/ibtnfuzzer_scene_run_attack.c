@@ -248,7 +248,7 @@ void ibtnfuzzer_scene_run_attack_on_tick(iBtnFuzzerState* context) {
                         break;
                     }
                     if(end_of_list) break;
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(furi_string_size(context->data_str) != 17) {
                         context->attack_step = 0;
                         counter = 0;
@@ -286,7 +286,7 @@ void ibtnfuzzer_scene_run_attack_on_tick(iBtnFuzzerState* context) {
                         break;
                     }
                     if(end_of_list) break;
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(furi_string_size(context->data_str) != 5) {
                         context->attack_step = 0;
                         counter = 0;
@@ -323,7 +323,7 @@ void ibtnfuzzer_scene_run_attack_on_tick(iBtnFuzzerState* context) {
                         if(furi_string_size(context->data_str) != 9) break;
                         break;
                     }
-                    FURI_LOG_D(TAG, furi_string_get_cstr(context->data_str));
+                    FURI_LOG_D(TAG, "%s", furi_string_get_cstr(context->data_str));
                     if(end_of_list) break;
                     if(furi_string_size(context->data_str) != 9) {
                         context->attack_step = 0;
@@ -0,0 +1,112 @@
+/* Host build of mfkey32 recovery core, used for regression timing.
+ *
+ *   cc -O2 -o mfkey32_host host/mfkey32_host.c mfkey32_core.c
+ *   ./mfkey32_host [--single] [--msb-limit N] .mfkey32.log
+ *
+ * --single recovers every nonce on its own, like firmware did before batching.
+ */
+
+#include "../mfkey32_core.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double host_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    bool single = false;
+    uint32_t msb_limit = 16;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--single") == 0) {
+            single = true;
+        } else if(strcmp(argv[i], "--msb-limit") == 0 && i + 1 < argc) {
+            msb_limit = strtoul(argv[++i], NULL, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+    if(!path || !msb_limit || 256 % msb_limit) {
+        fprintf(stderr, "usage: %s [--single] [--msb-limit N] <.mfkey32.log>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(path, "r");
+    if(!file) {
+        perror(path);
+        return 1;
+    }
+
+    size_t count = 0;
+    size_t capacity = 16;
+    MfClassicNonce* nonces = malloc(sizeof(MfClassicNonce) * capacity);
+    char line[256];
+    while(fgets(line, sizeof(line), file)) {
+        if(count == capacity) {
+            capacity *= 2;
+            nonces = realloc(nonces, sizeof(MfClassicNonce) * capacity);
+        }
+        if(mfkey32_core_parse_nonce(line, &nonces[count])) count++;
+    }
+    fclose(file);
+
+    qsort(nonces, count, sizeof(MfClassicNonce), mfkey32_core_nonce_compare);
+
+    Mfkey32Core* core = mfkey32_core_alloc(msb_limit);
+    Mfkey32KeySet keys;
+    mfkey32_core_keyset_init(&keys);
+    size_t cracked = 0;
+    double start = host_time();
+
+    for(size_t i = 0, group_end = 0; i < count; i = group_end) {
+        group_end = i + 1;
+        while(group_end < count && mfkey32_core_nonce_same_group(&nonces[i], &nonces[group_end])) {
+            group_end++;
+        }
+
+        uint64_t key = 0;
+        double group_start = host_time();
+        bool found = mfkey32_core_keyset_find(&keys, &nonces[i], &key);
+        for(size_t n = i; !found && n < group_end; n++) {
+            size_t group_size = single ? 1 : group_end - n;
+            found = mfkey32_core_recover_group(core, &nonces[n], group_size, &key);
+            if(!single) break;
+        }
+        if(found) {
+            mfkey32_core_keyset_add(&keys, key);
+            for(size_t n = i; n < group_end; n++) {
+                if(mfkey32_core_check_key(key, &nonces[n])) cracked++;
+            }
+        }
+
+        printf(
+            "uid %08" PRIx32 " sec %u key %c: %zu nonces, %s %012" PRIX64 " in %.2f s\n",
+            nonces[i].uid,
+            nonces[i].sector,
+            nonces[i].key_type,
+            group_end - i,
+            found ? "key" : "no key",
+            key,
+            host_time() - group_start);
+    }
+
+    printf(
+        "%zu/%zu nonces cracked, %zu unique keys, %.2f s total\n",
+        cracked,
+        count,
+        keys.count,
+        host_time() - start);
+
+    mfkey32_core_keyset_clear(&keys);
+    mfkey32_core_free(core);
+    free(nonces);
+    return 0;
+}
@@ -0,0 +1,671 @@
+#pragma GCC optimize("O3")
+#pragma GCC optimize("-funroll-all-loops")
+
+#include "mfkey32_core.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LF_POLY_ODD (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+#define CONST_M1_1 (LF_POLY_EVEN << 1 | 1)
+#define CONST_M2_1 (LF_POLY_ODD << 1)
+#define CONST_M1_2 (LF_POLY_ODD)
+#define CONST_M2_2 (LF_POLY_EVEN << 1 | 1)
+#define BIT(x, n) ((x) >> (n)&1)
+#define BEBIT(x, n) BIT(x, (n) ^ 24)
+#define SWAPENDIAN(x) \
+    ((x) = ((x) >> 8 & 0xff00ff) | ((x)&0xff00ff) << 8, (x) = (x) >> 16 | (x) << 16)
+
+#define MFKEY32_STATES_BUFFER_SIZE (2 << 9)
+#define MFKEY32_TEMP_STATES_SIZE (1280)
+#define MFKEY32_MSB_STATES_SIZE (768)
+
+struct Crypto1State {
+    uint32_t odd, even;
+};
+struct Crypto1Params {
+    uint64_t key;
+    uint32_t nr0_enc, uid_xor_nt0, uid_xor_nt1, nr1_enc, p64b, ar1_enc;
+};
+struct Msb {
+    int tail;
+    uint32_t states[MFKEY32_MSB_STATES_SIZE];
+};
+
+struct Mfkey32Core {
+    uint32_t msb_limit;
+    uint32_t* states_buffer;
+    struct Msb* odd_msbs;
+    struct Msb* even_msbs;
+    uint32_t* temp_states_odd;
+    uint32_t* temp_states_even;
+    // Scratch for bucket sort by contribution byte, replaces quicksort/binsearch
+    uint32_t* sort_buffer;
+    uint32_t sort_count[256];
+
+    Mfkey32CoreCallback callback;
+    void* context;
+    uint32_t round;
+    size_t nonce_index;
+    bool aborted;
+};
+
+static const uint8_t table[256] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3,
+    4, 4, 5, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4,
+    4, 5, 4, 5, 5, 6, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2, 3, 3, 4, 3, 4, 4,
+    5, 3, 4, 4, 5, 4, 5, 5, 6, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6, 3, 4, 4, 5,
+    4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5, 2,
+    3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5,
+    5, 6, 3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4,
+    5, 4, 5, 5, 6, 3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7, 3, 4, 4, 5, 4, 5, 5, 6,
+    4, 5, 5, 6, 5, 6, 6, 7, 4, 5, 5, 6, 5, 6, 6, 7, 5, 6, 6, 7, 6, 7, 7, 8};
+static const uint8_t lookup1[256] = {
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24, 8, 8,  24, 24, 8,  24, 8,  8,
+    8, 24, 8,  8,  24, 24, 24, 24, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24};
+static const uint8_t lookup2[256] = {
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4,
+    4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6,
+    2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2,
+    2, 2, 6, 2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4,
+    0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2,
+    2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4,
+    4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2,
+    2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2,
+    2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6};
+
+static uint32_t prng_successor(uint32_t x, uint32_t n) {
+    SWAPENDIAN(x);
+    while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
+    return SWAPENDIAN(x);
+}
+
+static inline int filter(uint32_t const x) {
+    uint32_t f;
+    f = lookup1[x & 0xff] | lookup2[(x >> 8) & 0xff];
+    f |= 0x0d938 >> (x >> 16 & 0xf) & 1;
+    return BIT(0xEC57E80A, f);
+}
+
+static inline uint8_t evenparity32(uint32_t x) {
+    return (table[x & 0xff] + table[(x >> 8) & 0xff] + table[(x >> 16) & 0xff] + table[x >> 24]) &
+           1;
+}
+
+static inline void update_contribution(uint32_t data[], int item, int mask1, int mask2) {
+    int p = data[item] >> 25;
+    p = p << 1 | evenparity32(data[item] & mask1);
+    p = p << 1 | evenparity32(data[item] & mask2);
+    data[item] = p << 24 | (data[item] & 0xffffff);
+}
+
+static void crypto1_get_lfsr(struct Crypto1State* state, uint64_t* lfsr) {
+    int i;
+    for(*lfsr = 0, i = 23; i >= 0; --i) {
+        *lfsr = *lfsr << 1 | BIT(state->odd, i ^ 3);
+        *lfsr = *lfsr << 1 | BIT(state->even, i ^ 3);
+    }
+}
+
+static inline uint32_t crypt_word(struct Crypto1State* s) {
+    // "in" and "x" are always 0 (last iteration)
+    uint32_t res_ret = 0;
+    uint32_t feedin, t;
+    for(int i = 0; i <= 31; i++) {
+        res_ret |= (filter(s->odd) << (24 ^ i)); //-V629
+        feedin = LF_POLY_EVEN & s->even;
+        feedin ^= LF_POLY_ODD & s->odd;
+        s->even = s->even << 1 | (evenparity32(feedin));
+        t = s->odd, s->odd = s->even, s->even = t;
+    }
+    return res_ret;
+}
+
+static inline void crypt_word_noret(struct Crypto1State* s, uint32_t in, int x) {
+    uint8_t ret;
+    uint32_t feedin, t, next_in;
+    for(int i = 0; i <= 31; i++) {
+        next_in = BEBIT(in, i);
+        ret = filter(s->odd);
+        feedin = ret & (!!x);
+        feedin ^= LF_POLY_EVEN & s->even;
+        feedin ^= LF_POLY_ODD & s->odd;
+        feedin ^= !!next_in;
+        s->even = s->even << 1 | (evenparity32(feedin));
+        t = s->odd, s->odd = s->even, s->even = t;
+    }
+}
+
+static inline void rollback_word_noret(struct Crypto1State* s, uint32_t in, int x) {
+    uint8_t ret;
+    uint32_t feedin, t, next_in;
+    for(int i = 31; i >= 0; i--) {
+        next_in = BEBIT(in, i);
+        s->odd &= 0xffffff;
+        t = s->odd, s->odd = s->even, s->even = t;
+        ret = filter(s->odd);
+        feedin = ret & (!!x);
+        feedin ^= s->even & 1;
+        feedin ^= LF_POLY_EVEN & (s->even >>= 1);
+        feedin ^= LF_POLY_ODD & s->odd;
+        feedin ^= !!next_in;
+        s->even |= (evenparity32(feedin)) << 23;
+    }
+}
+
+static int check_state(struct Crypto1State* t, struct Crypto1Params* p) {
+    if(!(t->odd | t->even)) return 0;
+    rollback_word_noret(t, 0, 0);
+    rollback_word_noret(t, p->nr0_enc, 1);
+    rollback_word_noret(t, p->uid_xor_nt0, 0);
+    struct Crypto1State temp = {t->odd, t->even};
+    crypt_word_noret(t, p->uid_xor_nt1, 0);
+    crypt_word_noret(t, p->nr1_enc, 1);
+    if(p->ar1_enc == (crypt_word(t) ^ p->p64b)) {
+        crypto1_get_lfsr(&temp, &(p->key));
+        return 1;
+    }
+    return 0;
+}
+
+static inline int state_loop(uint32_t* states_buffer, int xks, int m1, int m2) {
+    int states_tail = 0;
+    int round = 0, s = 0, xks_bit = 0;
+
+    for(round = 1; round <= 12; round++) {
+        xks_bit = BIT(xks, round);
+
+        for(s = 0; s <= states_tail; s++) {
+            states_buffer[s] <<= 1;
+
+            if((filter(states_buffer[s]) ^ filter(states_buffer[s] | 1)) != 0) {
+                states_buffer[s] |= filter(states_buffer[s]) ^ xks_bit;
+                if(round > 4) {
+                    update_contribution(states_buffer, s, m1, m2);
+                }
+            } else if(filter(states_buffer[s]) == xks_bit) {
+                if(round > 4) {
+                    states_buffer[++states_tail] = states_buffer[s + 1];
+                    states_buffer[s + 1] = states_buffer[s] | 1;
+                    update_contribution(states_buffer, s, m1, m2);
+                    s++;
+                    update_contribution(states_buffer, s, m1, m2);
+                } else {
+                    states_buffer[++states_tail] = states_buffer[++s];
+                    states_buffer[s] = states_buffer[s - 1] | 1;
+                }
+            } else {
+                states_buffer[s--] = states_buffer[states_tail--];
+            }
+        }
+    }
+
+    return states_tail;
+}
+
+static int extend_table(uint32_t data[], int tbl, int end, int bit, int m1, int m2) {
+    for(data[tbl] <<= 1; tbl <= end; data[++tbl] <<= 1) {
+        if((filter(data[tbl]) ^ filter(data[tbl] | 1)) != 0) {
+            data[tbl] |= filter(data[tbl]) ^ bit;
+            update_contribution(data, tbl, m1, m2);
+        } else if(filter(data[tbl]) == bit) {
+            data[++end] = data[tbl + 1];
+            data[tbl + 1] = data[tbl] | 1;
+            update_contribution(data, tbl, m1, m2);
+            tbl++;
+            update_contribution(data, tbl, m1, m2);
+        } else {
+            data[tbl--] = data[end--];
+        }
+    }
+    return end;
+}
+
+/** Stable counting sort of data[head..tail] by contribution byte
+ *
+ * Only grouping by the top byte is needed to pair odd and even states, so
+ * a single pass replaces full quicksort and binsearch for group borders.
+ */
+static void mfkey32_core_sort(Mfkey32Core* core, uint32_t data[], int head, int tail) {
+    if(head >= tail) return;
+
+    uint32_t* count = core->sort_count;
+    memset(count, 0, sizeof(core->sort_count));
+    for(int i = head; i <= tail; i++) {
+        count[data[i] >> 24]++;
+    }
+    uint32_t offset = 0;
+    for(size_t i = 0; i < 256; i++) {
+        uint32_t bucket_size = count[i];
+        count[i] = offset;
+        offset += bucket_size;
+    }
+    for(int i = head; i <= tail; i++) {
+        core->sort_buffer[count[data[i] >> 24]++] = data[i];
+    }
+    memcpy(&data[head], core->sort_buffer, offset * sizeof(uint32_t));
+}
+
+/** Move tail down past all entries sharing contribution byte with data[tail] */
+static inline int mfkey32_core_bucket_head(uint32_t data[], int head, int tail) {
+    uint32_t msb = data[tail] >> 24;
+    while(tail >= head && (data[tail] >> 24) == msb) {
+        tail--;
+    }
+    return tail + 1;
+}
+
+static bool mfkey32_core_recover_tables(
+    Mfkey32Core* core,
+    uint32_t odd[],
+    int o_head,
+    int o_tail,
+    int oks,
+    uint32_t even[],
+    int e_head,
+    int e_tail,
+    int eks,
+    int rem,
+    struct Crypto1Params* p,
+    bool first_run) {
+    int o, e, i;
+    if(rem == -1) {
+        for(e = e_head; e <= e_tail; ++e) {
+            even[e] = (even[e] << 1) ^ evenparity32(even[e] & LF_POLY_EVEN);
+            for(o = o_head; o <= o_tail; ++o) {
+                struct Crypto1State temp = {0, 0};
+                temp.even = odd[o];
+                temp.odd = even[e] ^ evenparity32(odd[o] & LF_POLY_ODD);
+                if(check_state(&temp, p)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    if(!first_run) {
+        for(i = 0; (i < 4) && (rem-- != 0); i++) {
+            oks >>= 1;
+            eks >>= 1;
+            o_tail = extend_table(
+                odd, o_head, o_tail, oks & 1, LF_POLY_EVEN << 1 | 1, LF_POLY_ODD << 1);
+            if(o_head > o_tail) return false;
+            e_tail =
+                extend_table(even, e_head, e_tail, eks & 1, LF_POLY_ODD, LF_POLY_EVEN << 1 | 1);
+            if(e_head > e_tail) return false;
+        }
+    }
+    mfkey32_core_sort(core, odd, o_head, o_tail);
+    mfkey32_core_sort(core, even, e_head, e_tail);
+    // Walk buckets from the top, recursion may only overwrite already visited entries
+    while(o_tail >= o_head && e_tail >= e_head) {
+        uint32_t o_msb = odd[o_tail] >> 24;
+        uint32_t e_msb = even[e_tail] >> 24;
+        if(o_msb == e_msb) {
+            o = o_tail;
+            e = e_tail;
+            o_tail = mfkey32_core_bucket_head(odd, o_head, o_tail);
+            e_tail = mfkey32_core_bucket_head(even, e_head, e_tail);
+            if(mfkey32_core_recover_tables(
+                   core, odd, o_tail--, o, oks, even, e_tail--, e, eks, rem, p, false)) {
+                return true;
+            }
+        } else if(o_msb > e_msb) {
+            o_tail = mfkey32_core_bucket_head(odd, o_head, o_tail) - 1;
+        } else {
+            e_tail = mfkey32_core_bucket_head(even, e_head, e_tail) - 1;
+        }
+    }
+    return false;
+}
+
+static inline bool mfkey32_core_sync(Mfkey32Core* core) {
+    if(core->callback && !core->callback(core->round, core->nonce_index, core->context)) {
+        core->aborted = true;
+    }
+    return !core->aborted;
+}
+
+static bool mfkey32_core_calculate_msb_tables(
+    Mfkey32Core* core,
+    int oks,
+    int eks,
+    uint32_t msb_round,
+    struct Crypto1Params* p) {
+    uint32_t msb_limit = core->msb_limit;
+    uint32_t msb_head = (msb_limit * msb_round);
+    uint32_t msb_tail = (msb_limit * (msb_round + 1));
+    uint32_t* states_buffer = core->states_buffer;
+    struct Msb* odd_msbs = core->odd_msbs;
+    struct Msb* even_msbs = core->even_msbs;
+    int states_tail = 0, tail = 0;
+    int i = 0, j = 0, semi_state = 0, found = 0;
+    uint32_t msb = 0;
+
+    memset(odd_msbs, 0, msb_limit * sizeof(struct Msb));
+    memset(even_msbs, 0, msb_limit * sizeof(struct Msb));
+
+    for(semi_state = 1 << 20; semi_state >= 0; semi_state--) {
+        if(semi_state % 32768 == 0) {
+            if(!mfkey32_core_sync(core)) {
+                return false;
+            }
+        }
+
+        if(filter(semi_state) == (oks & 1)) { //-V547
+            states_buffer[0] = semi_state;
+            states_tail = state_loop(states_buffer, oks, CONST_M1_1, CONST_M2_1);
+
+            for(i = states_tail; i >= 0; i--) {
+                msb = states_buffer[i] >> 24;
+                if((msb >= msb_head) && (msb < msb_tail)) {
+                    found = 0;
+                    for(j = 0; j < odd_msbs[msb - msb_head].tail - 1; j++) {
+                        if(odd_msbs[msb - msb_head].states[j] == states_buffer[i]) {
+                            found = 1;
+                            break;
+                        }
+                    }
+
+                    if(!found) {
+                        tail = odd_msbs[msb - msb_head].tail++;
+                        odd_msbs[msb - msb_head].states[tail] = states_buffer[i];
+                    }
+                }
+            }
+        }
+
+        if(filter(semi_state) == (eks & 1)) { //-V547
+            states_buffer[0] = semi_state;
+            states_tail = state_loop(states_buffer, eks, CONST_M1_2, CONST_M2_2);
+
+            for(i = 0; i <= states_tail; i++) {
+                msb = states_buffer[i] >> 24;
+                if((msb >= msb_head) && (msb < msb_tail)) {
+                    found = 0;
+
+                    for(j = 0; j < even_msbs[msb - msb_head].tail; j++) {
+                        if(even_msbs[msb - msb_head].states[j] == states_buffer[i]) {
+                            found = 1;
+                            break;
+                        }
+                    }
+
+                    if(!found) {
+                        tail = even_msbs[msb - msb_head].tail++;
+                        even_msbs[msb - msb_head].states[tail] = states_buffer[i];
+                    }
+                }
+            }
+        }
+    }
+
+    oks >>= 12;
+    eks >>= 12;
+
+    for(i = 0; i < (int)msb_limit; i++) {
+        if(!mfkey32_core_sync(core)) {
+            return false;
+        }
+        // Tables are searched inclusive of tail, entry past the last state must be zero
+        memset(core->temp_states_even, 0, sizeof(uint32_t) * MFKEY32_TEMP_STATES_SIZE);
+        memset(core->temp_states_odd, 0, sizeof(uint32_t) * MFKEY32_TEMP_STATES_SIZE);
+        memcpy(core->temp_states_odd, odd_msbs[i].states, odd_msbs[i].tail * sizeof(uint32_t));
+        memcpy(
+            core->temp_states_even, even_msbs[i].states, even_msbs[i].tail * sizeof(uint32_t));
+        if(mfkey32_core_recover_tables(
+               core,
+               core->temp_states_odd,
+               0,
+               odd_msbs[i].tail,
+               oks,
+               core->temp_states_even,
+               0,
+               even_msbs[i].tail,
+               eks,
+               3,
+               p,
+               true)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool mfkey32_core_parse_nonce(const char* line, MfClassicNonce* nonce) {
+    if(strncmp(line, "Sec", 3) != 0) return false;
+
+    MfClassicNonce res = {0};
+    const char* next_line_cstr = line;
+    char* endptr;
+    for(int i = 0; i <= 17; i++) {
+        if(i != 0) {
+            next_line_cstr = strchr(next_line_cstr, ' ');
+            if(next_line_cstr) {
+                next_line_cstr++;
+            } else {
+                break;
+            }
+        }
+        if(i == 3) {
+            res.key_type = (uint8_t)*next_line_cstr;
+            continue;
+        }
+        unsigned long value = strtoul(next_line_cstr, &endptr, i == 1 ? 10 : 16);
+        switch(i) {
+        case 1:
+            res.sector = value;
+            break;
+        case 5:
+            res.uid = value;
+            break;
+        case 7:
+            res.nt0 = value;
+            break;
+        case 9:
+            res.nr0_enc = value;
+            break;
+        case 11:
+            res.ar0_enc = value;
+            break;
+        case 13:
+            res.nt1 = value;
+            break;
+        case 15:
+            res.nr1_enc = value;
+            break;
+        case 17:
+            res.ar1_enc = value;
+            break;
+        default:
+            break; // Do nothing
+        }
+        next_line_cstr = endptr;
+    }
+
+    *nonce = res;
+    return true;
+}
+
+Mfkey32Core* mfkey32_core_alloc(uint32_t msb_limit) {
+    Mfkey32Core* core = malloc(sizeof(Mfkey32Core));
+    memset(core, 0, sizeof(Mfkey32Core));
+    core->msb_limit = msb_limit;
+    core->states_buffer = malloc(sizeof(uint32_t) * MFKEY32_STATES_BUFFER_SIZE);
+    core->odd_msbs = malloc(msb_limit * sizeof(struct Msb));
+    core->even_msbs = malloc(msb_limit * sizeof(struct Msb));
+    core->temp_states_odd = malloc(sizeof(uint32_t) * MFKEY32_TEMP_STATES_SIZE);
+    core->temp_states_even = malloc(sizeof(uint32_t) * MFKEY32_TEMP_STATES_SIZE);
+    core->sort_buffer = malloc(sizeof(uint32_t) * MFKEY32_TEMP_STATES_SIZE);
+    return core;
+}
+
+void mfkey32_core_free(Mfkey32Core* core) {
+    free(core->states_buffer);
+    free(core->odd_msbs);
+    free(core->even_msbs);
+    free(core->temp_states_odd);
+    free(core->temp_states_even);
+    free(core->sort_buffer);
+    free(core);
+}
+
+void mfkey32_core_set_callback(Mfkey32Core* core, Mfkey32CoreCallback callback, void* context) {
+    core->callback = callback;
+    core->context = context;
+}
+
+bool mfkey32_core_check_key(uint64_t key, const MfClassicNonce* nonce) {
+    struct Crypto1State temp = {0, 0};
+    for(int i = 0; i < 24; i++) {
+        temp.odd |= (BIT(key, 2 * i + 1) << (i ^ 3));
+        temp.even |= (BIT(key, 2 * i) << (i ^ 3));
+    }
+    crypt_word_noret(&temp, nonce->uid ^ nonce->nt1, 0);
+    crypt_word_noret(&temp, nonce->nr1_enc, 1);
+    return nonce->ar1_enc == (crypt_word(&temp) ^ prng_successor(nonce->nt1, 64));
+}
+
+int mfkey32_core_nonce_compare(const void* a, const void* b) {
+    const MfClassicNonce* nonce_a = a;
+    const MfClassicNonce* nonce_b = b;
+    if(nonce_a->uid != nonce_b->uid) return nonce_a->uid < nonce_b->uid ? -1 : 1;
+    if(nonce_a->sector != nonce_b->sector) return nonce_a->sector < nonce_b->sector ? -1 : 1;
+    return (int)nonce_a->key_type - (int)nonce_b->key_type;
+}
+
+bool mfkey32_core_nonce_same_group(const MfClassicNonce* a, const MfClassicNonce* b) {
+    return mfkey32_core_nonce_compare(a, b) == 0;
+}
+
+static bool mfkey32_core_recover_nonce(
+    Mfkey32Core* core,
+    const MfClassicNonce* nonce,
+    size_t nonce_index,
+    uint64_t* key) {
+    uint32_t p64 = prng_successor(nonce->nt0, 64);
+    uint32_t p64b = prng_successor(nonce->nt1, 64);
+    uint32_t ks2 = nonce->ar0_enc ^ p64;
+    int oks = 0, eks = 0;
+    for(int i = 31; i >= 0; i -= 2) {
+        oks = oks << 1 | BEBIT(ks2, i);
+    }
+    for(int i = 30; i >= 0; i -= 2) {
+        eks = eks << 1 | BEBIT(ks2, i);
+    }
+    struct Crypto1Params p = {
+        0,
+        nonce->nr0_enc,
+        nonce->uid ^ nonce->nt0,
+        nonce->uid ^ nonce->nt1,
+        nonce->nr1_enc,
+        p64b,
+        nonce->ar1_enc};
+
+    core->nonce_index = nonce_index;
+    for(uint32_t msb = 0; msb < 256 / core->msb_limit; msb++) {
+        core->round = msb;
+        if(mfkey32_core_calculate_msb_tables(core, oks, eks, msb, &p)) {
+            *key = p.key;
+            return true;
+        }
+        if(core->aborted) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+bool mfkey32_core_recover_group(
+    Mfkey32Core* core,
+    const MfClassicNonce* nonces,
+    size_t count,
+    uint64_t* key) {
+    core->aborted = false;
+    size_t best_verified = 0;
+
+    for(size_t n = 0; n < count && !core->aborted; n++) {
+        // Nonce solved by the best candidate would give the same key
+        if(best_verified && mfkey32_core_check_key(*key, &nonces[n])) continue;
+
+        uint64_t candidate = 0;
+        if(!mfkey32_core_recover_nonce(core, &nonces[n], n, &candidate)) continue;
+
+        size_t verified = 0;
+        for(size_t v = 0; v < count; v++) {
+            if(v == n || mfkey32_core_check_key(candidate, &nonces[v])) verified++;
+        }
+        if(verified > best_verified) {
+            *key = candidate;
+            best_verified = verified;
+        }
+        if(verified == count) {
+            break;
+        }
+        // Some nonce of the group is damaged or from another key, try the ones left out
+    }
+
+    return best_verified && !core->aborted;
+}
+
+void mfkey32_core_keyset_init(Mfkey32KeySet* set) {
+    set->keys = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+void mfkey32_core_keyset_clear(Mfkey32KeySet* set) {
+    free(set->keys);
+    mfkey32_core_keyset_init(set);
+}
+
+bool mfkey32_core_keyset_add(Mfkey32KeySet* set, uint64_t key) {
+    size_t low = 0;
+    size_t high = set->count;
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(set->keys[middle] < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if(low < set->count && set->keys[low] == key) return false;
+
+    if(set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 8;
+        uint64_t* keys = malloc(sizeof(uint64_t) * capacity);
+        if(set->count) {
+            memcpy(keys, set->keys, sizeof(uint64_t) * set->count);
+        }
+        free(set->keys);
+        set->keys = keys;
+        set->capacity = capacity;
+    }
+    memmove(&set->keys[low + 1], &set->keys[low], sizeof(uint64_t) * (set->count - low));
+    set->keys[low] = key;
+    set->count++;
+    return true;
+}
+
+bool mfkey32_core_keyset_find(const Mfkey32KeySet* set, const MfClassicNonce* nonce, uint64_t* key) {
+    for(size_t i = 0; i < set->count; i++) {
+        if(mfkey32_core_check_key(set->keys[i], nonce)) {
+            if(key) *key = set->keys[i];
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Key recovery core, free of Furi dependencies so that it can be built and
+ * timed on host against recorded .mfkey32.log files (see host/mfkey32_host.c).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t uid; // serial number
+    uint32_t nt0; // tag challenge first
+    uint32_t nt1; // tag challenge second
+    uint32_t nr0_enc; // first encrypted reader challenge
+    uint32_t ar0_enc; // first encrypted reader response
+    uint32_t nr1_enc; // second encrypted reader challenge
+    uint32_t ar1_enc; // second encrypted reader response
+    uint8_t sector; // sector number from log
+    uint8_t key_type; // 'A' or 'B'
+} MfClassicNonce;
+
+/** Progress callback
+ *
+ * @param      round        Current MSB round, 0 .. 256 / msb_limit - 1
+ * @param      nonce_index  Index of nonce in the group being searched
+ * @param      context      Callback context
+ *
+ * @return     false to abort recovery
+ */
+typedef bool (*Mfkey32CoreCallback)(uint32_t round, size_t nonce_index, void* context);
+
+typedef struct Mfkey32Core Mfkey32Core;
+
+typedef struct {
+    uint64_t* keys;
+    size_t count;
+    size_t capacity;
+} Mfkey32KeySet;
+
+/** Parse one line of .mfkey32.log
+ *
+ * @param      line   Null terminated line, "Sec 2 key A cuid ... ar1 ..."
+ * @param[out] nonce  Parsed nonce
+ *
+ * @return     true if line contains nonce
+ */
+bool mfkey32_core_parse_nonce(const char* line, MfClassicNonce* nonce);
+
+/** Allocate recovery workspace, shared by all nonces of a group
+ *
+ * @param      msb_limit  Number of MSB values searched per round, divides 256
+ *
+ * @return     Mfkey32Core instance
+ */
+Mfkey32Core* mfkey32_core_alloc(uint32_t msb_limit);
+
+void mfkey32_core_free(Mfkey32Core* core);
+
+void mfkey32_core_set_callback(Mfkey32Core* core, Mfkey32CoreCallback callback, void* context);
+
+/** Check that key decrypts second authentication of the nonce */
+bool mfkey32_core_check_key(uint64_t key, const MfClassicNonce* nonce);
+
+/** Compare nonces by (uid, sector, key type), qsort compatible */
+int mfkey32_core_nonce_compare(const void* a, const void* b);
+
+/** Check if nonces belong to the same group, i.e. share a key */
+bool mfkey32_core_nonce_same_group(const MfClassicNonce* a, const MfClassicNonce* b);
+
+/** Recover key of a nonce group
+ *
+ * Key is recovered from the first nonce and verified against the rest of the
+ * group. Next nonce is searched only if the candidate doesn't solve it, then
+ * the candidate that solves most nonces is returned if none solves all.
+ *
+ * @param      core    Mfkey32Core instance
+ * @param      nonces  Nonces sharing uid, sector and key type
+ * @param      count   Number of nonces
+ * @param[out] key     Recovered key
+ *
+ * @return     true if key was recovered
+ */
+bool mfkey32_core_recover_group(
+    Mfkey32Core* core,
+    const MfClassicNonce* nonces,
+    size_t count,
+    uint64_t* key);
+
+void mfkey32_core_keyset_init(Mfkey32KeySet* set);
+
+void mfkey32_core_keyset_clear(Mfkey32KeySet* set);
+
+/** Add key to sorted key set
+ *
+ * @return     true if key was not present before
+ */
+bool mfkey32_core_keyset_add(Mfkey32KeySet* set, uint64_t key);
+
+/** Find key in set that solves the nonce
+ *
+ * @return     true if found
+ */
+bool mfkey32_core_keyset_find(const Mfkey32KeySet* set, const MfClassicNonce* nonce, uint64_t* key);
+
+#ifdef __cplusplus
+}
+#endif
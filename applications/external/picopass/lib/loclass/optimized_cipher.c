@@ -226,6 +226,25 @@ void loclass_opt_doReaderMAC_2(
     loclass_opt_output(div_key_p, &_init, mac);
 }
 
+void loclass_opt_doBatchReaderMAC(
+    const uint8_t* cc_nr_p,
+    const uint8_t* div_keys_p,
+    size_t count,
+    uint8_t* macs) {
+    for(size_t i = 0; i < count; i++) {
+        const uint8_t* k = &div_keys_p[i * 8];
+        LoclassState_t _init = {
+            ((k[0] ^ 0x4c) + 0xEC) & 0xFF, // l
+            ((k[0] ^ 0x4c) + 0x21) & 0xFF, // r
+            0x4c, // b
+            0xE012 // t
+        };
+
+        loclass_opt_suc(k, &_init, cc_nr_p, 12, false);
+        loclass_opt_output(k, &_init, &macs[i * 4]);
+    }
+}
+
 void loclass_doMAC_N(uint8_t* in_p, uint8_t in_size, uint8_t* div_key_p, uint8_t mac[4]) {
     uint8_t dest[] = {0, 0, 0, 0, 0, 0, 0, 0};
     loclass_opt_MAC_N(div_key_p, in_p, in_size, dest);
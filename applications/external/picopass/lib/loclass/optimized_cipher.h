@@ -64,6 +64,23 @@ void loclass_opt_doReaderMAC_2(
     uint8_t mac[4],
     const uint8_t* div_key_p);
 
+/**
+ * The reader MAC of one CC * NR for several keys, as dictionary attack needs it
+ * for every candidate key of a card.
+ * Convenience wrapper: cipher state depends on the key from the first bit, so
+ * nothing is shared between keys and the cost is count loclass_opt_doReaderMAC
+ * calls.
+ * @param cc_nr_p - the card challenge and reader nonce, 12 bytes
+ * @param div_keys_p - count diversified keys, 8 bytes each
+ * @param count - number of keys
+ * @param macs - where to store count MACs, 4 bytes each
+ */
+void loclass_opt_doBatchReaderMAC(
+    const uint8_t* cc_nr_p,
+    const uint8_t* div_keys_p,
+    size_t count,
+    uint8_t* macs);
+
 /**
  * The tag MAC is MAC(key, CC * NR * 32x0))
  */
@@ -35,6 +35,7 @@ typedef struct {
     IclassEliteDict* dict;
     IclassEliteDictType type;
     uint8_t current_sector;
+    uint32_t keys_per_second;
 } IclassEliteDictAttackData;
 
 typedef enum {
@@ -458,6 +458,140 @@ ReturnCode picopass_write_block(PicopassBlock* AA1, uint8_t blockNo, uint8_t* ne
     return ERR_NONE;
 }
 
+/* Dictionary attack keys are derived ahead of the RF loop by a producer thread. It reads the
+ * dictionary, diversifies keys for the card CSN and computes reader MACs for the card challenge
+ * in batches, candidates are passed to the worker through a message queue ring. The worker
+ * thread busy waits on the transceiver, producer has the same priority and runs in time slices
+ * of these waits, so RF exchanges do not wait for DES and MAC computation. */
+#define PICOPASS_DICT_PIPELINE_DEPTH (32)
+#define PICOPASS_DICT_PIPELINE_BATCH (8)
+#define PICOPASS_DICT_PIPELINE_TIMEOUT (50)
+
+typedef struct {
+    uint8_t key[PICOPASS_BLOCK_LEN];
+    uint8_t div_key[PICOPASS_BLOCK_LEN];
+    uint8_t cc[PICOPASS_BLOCK_LEN];
+    uint8_t mac[4];
+    bool last;
+} PicopassDictCandidate;
+
+typedef struct {
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    FuriMutex* mutex;
+    IclassEliteDict* dict;
+    uint8_t csn[PICOPASS_BLOCK_LEN];
+    uint8_t cc[PICOPASS_BLOCK_LEN];
+    bool elite;
+    volatile bool running;
+} PicopassDictPipeline;
+
+static bool picopass_dict_pipeline_put(
+    PicopassDictPipeline* pipeline,
+    const PicopassDictCandidate* candidate) {
+    while(pipeline->running) {
+        if(furi_message_queue_put(pipeline->queue, candidate, PICOPASS_DICT_PIPELINE_TIMEOUT) ==
+           FuriStatusOk) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int32_t picopass_dict_pipeline_producer(void* context) {
+    PicopassDictPipeline* pipeline = context;
+    PicopassDictCandidate batch[PICOPASS_DICT_PIPELINE_BATCH] = {0};
+    uint8_t div_keys[PICOPASS_DICT_PIPELINE_BATCH * PICOPASS_BLOCK_LEN];
+    uint8_t macs[PICOPASS_DICT_PIPELINE_BATCH * 4];
+    uint8_t ccnr[12] = {0}; // last 4 bytes left 0
+    bool key_loaded = true;
+
+    while(pipeline->running && key_loaded) {
+        size_t count = 0;
+        while(count < PICOPASS_DICT_PIPELINE_BATCH) {
+            key_loaded = iclass_elite_dict_get_next_key(pipeline->dict, batch[count].key);
+            if(!key_loaded) break;
+            loclass_iclass_calc_div_key(
+                pipeline->csn,
+                batch[count].key,
+                &div_keys[count * PICOPASS_BLOCK_LEN],
+                pipeline->elite);
+            count++;
+        }
+
+        furi_check(furi_mutex_acquire(pipeline->mutex, FuriWaitForever) == FuriStatusOk);
+        memcpy(ccnr, pipeline->cc, sizeof(pipeline->cc));
+        furi_check(furi_mutex_release(pipeline->mutex) == FuriStatusOk);
+
+        loclass_opt_doBatchReaderMAC(ccnr, div_keys, count, macs);
+        for(size_t i = 0; i < count; i++) {
+            memcpy(batch[i].div_key, &div_keys[i * PICOPASS_BLOCK_LEN], PICOPASS_BLOCK_LEN);
+            memcpy(batch[i].cc, ccnr, sizeof(batch[i].cc));
+            memcpy(batch[i].mac, &macs[i * 4], sizeof(batch[i].mac));
+            if(!picopass_dict_pipeline_put(pipeline, &batch[i])) break;
+        }
+    }
+
+    if(!key_loaded) {
+        PicopassDictCandidate last = {.last = true};
+        picopass_dict_pipeline_put(pipeline, &last);
+    }
+
+    return 0;
+}
+
+static PicopassDictPipeline*
+    picopass_dict_pipeline_alloc(IclassEliteDict* dict, uint8_t* csn, uint8_t* cc, bool elite) {
+    PicopassDictPipeline* pipeline = malloc(sizeof(PicopassDictPipeline));
+    pipeline->queue =
+        furi_message_queue_alloc(PICOPASS_DICT_PIPELINE_DEPTH, sizeof(PicopassDictCandidate));
+    pipeline->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    pipeline->dict = dict;
+    memcpy(pipeline->csn, csn, sizeof(pipeline->csn));
+    memcpy(pipeline->cc, cc, sizeof(pipeline->cc));
+    pipeline->elite = elite;
+    pipeline->running = true;
+
+    pipeline->thread = furi_thread_alloc_ex(
+        "PicopassDictProducer", 3 * 1024, picopass_dict_pipeline_producer, pipeline);
+    furi_thread_start(pipeline->thread);
+
+    return pipeline;
+}
+
+static void picopass_dict_pipeline_free(PicopassDictPipeline* pipeline) {
+    pipeline->running = false;
+    furi_thread_join(pipeline->thread);
+    furi_thread_free(pipeline->thread);
+
+    furi_message_queue_free(pipeline->queue);
+    furi_mutex_free(pipeline->mutex);
+    free(pipeline);
+}
+
+// Returns false at the end of dictionary
+static bool picopass_dict_pipeline_get(
+    PicopassDictPipeline* pipeline,
+    PicopassDictCandidate* candidate,
+    uint8_t* cc) {
+    furi_check(
+        furi_message_queue_get(pipeline->queue, candidate, FuriWaitForever) == FuriStatusOk);
+    if(candidate->last) return false;
+
+    // Card challenge changed since MAC was computed
+    if(memcmp(candidate->cc, cc, sizeof(candidate->cc)) != 0) {
+        uint8_t ccnr[12] = {0};
+        memcpy(ccnr, cc, sizeof(candidate->cc));
+        loclass_opt_doReaderMAC(ccnr, candidate->div_key, candidate->mac);
+
+        furi_check(furi_mutex_acquire(pipeline->mutex, FuriWaitForever) == FuriStatusOk);
+        memcpy(pipeline->cc, cc, sizeof(pipeline->cc));
+        furi_check(furi_mutex_release(pipeline->mutex) == FuriStatusOk);
+    }
+
+    return true;
+}
+
 void picopass_worker_elite_dict_attack(PicopassWorker* picopass_worker) {
     furi_assert(picopass_worker);
     furi_assert(picopass_worker->callback);
@@ -475,16 +609,15 @@ void picopass_worker_elite_dict_attack(PicopassWorker* picopass_worker) {
     IclassEliteDictAttackData* dict_attack_data =
         &picopass_worker->dev_data->iclass_elite_dict_attack_data;
     bool elite = (dict_attack_data->type != IclassStandardDictTypeFlipper);
+    dict_attack_data->keys_per_second = 0;
 
     rfalPicoPassReadCheckRes rcRes;
     rfalPicoPassCheckRes chkRes;
 
     ReturnCode err;
-    uint8_t mac[4] = {0};
-    uint8_t ccnr[12] = {0};
 
     size_t index = 0;
-    uint8_t key[PICOPASS_BLOCK_LEN] = {0};
+    PicopassDictCandidate candidate;
 
     // Load dictionary
     IclassEliteDict* dict = dict_attack_data->dict;
@@ -526,30 +659,40 @@ void picopass_worker_elite_dict_attack(PicopassWorker* picopass_worker) {
 
     FURI_LOG_D(
         TAG, "Start Dictionary attack, Key Count %lu", iclass_elite_dict_get_total_keys(dict));
-    while(iclass_elite_dict_get_next_key(dict, key)) {
+
+    // Card challenge for precomputed MACs, it is the same in every READCHECK response unless
+    // e-purse is updated
+    PicopassDictPipeline* pipeline = NULL;
+    err = rfalPicoPassPollerReadCheck(&rcRes);
+    if(err != ERR_NONE) {
+        // Same as failed READCHECK for any key: dictionary is complete
+        FURI_LOG_E(TAG, "rfalPicoPassPollerReadCheck error %d", err);
+    } else {
+        pipeline = picopass_dict_pipeline_alloc(
+            dict, AA1[PICOPASS_CSN_BLOCK_INDEX].data, rcRes.CCNR, elite);
+    }
+    uint32_t start = furi_get_tick();
+
+    while(pipeline && picopass_dict_pipeline_get(pipeline, &candidate, rcRes.CCNR)) {
         FURI_LOG_T(TAG, "Key %zu", index);
         if(++index % PICOPASS_DICT_KEY_BATCH_SIZE == 0) {
+            uint32_t elapsed = furi_get_tick() - start;
+            if(elapsed) {
+                dict_attack_data->keys_per_second =
+                    index * furi_kernel_get_tick_frequency() / elapsed;
+            }
             picopass_worker->callback(
                 PicopassWorkerEventNewDictKeyBatch, picopass_worker->context);
         }
 
-        err = rfalPicoPassPollerReadCheck(&rcRes);
-        if(err != ERR_NONE) {
-            FURI_LOG_E(TAG, "rfalPicoPassPollerReadCheck error %d", err);
-            break;
-        }
-        memcpy(ccnr, rcRes.CCNR, sizeof(rcRes.CCNR)); // last 4 bytes left 0
-
-        uint8_t* csn = AA1[PICOPASS_CSN_BLOCK_INDEX].data;
-        uint8_t* div_key = AA1[PICOPASS_KD_BLOCK_INDEX].data;
-
-        loclass_iclass_calc_div_key(csn, key, div_key, elite);
-        loclass_opt_doReaderMAC(ccnr, div_key, mac);
-
-        err = rfalPicoPassPollerCheck(mac, &chkRes);
+        err = rfalPicoPassPollerCheck(candidate.mac, &chkRes);
         if(err == ERR_NONE) {
             FURI_LOG_I(TAG, "Found key");
-            memcpy(pacs->key, key, PICOPASS_BLOCK_LEN);
+            picopass_dict_pipeline_free(pipeline);
+            pipeline = NULL;
+
+            memcpy(pacs->key, candidate.key, PICOPASS_BLOCK_LEN);
+            memcpy(AA1[PICOPASS_KD_BLOCK_INDEX].data, candidate.div_key, PICOPASS_BLOCK_LEN);
             err = picopass_read_card(AA1);
             if(err != ERR_NONE) {
                 FURI_LOG_E(TAG, "picopass_read_card error %d", err);
@@ -575,8 +718,25 @@ void picopass_worker_elite_dict_attack(PicopassWorker* picopass_worker) {
         }
 
         if(picopass_worker->state != PicopassWorkerStateEliteDictAttack) break;
+
+        // Next CHECK needs a new READCHECK
+        err = rfalPicoPassPollerReadCheck(&rcRes);
+        if(err != ERR_NONE) {
+            FURI_LOG_E(TAG, "rfalPicoPassPollerReadCheck error %d", err);
+            break;
+        }
     }
-    FURI_LOG_D(TAG, "Dictionary complete");
+    if(pipeline) {
+        picopass_dict_pipeline_free(pipeline);
+    }
+
+    uint32_t elapsed = furi_get_tick() - start;
+    FURI_LOG_I(
+        TAG,
+        "Dictionary complete, %zu keys in %lu ms, %lu keys/s",
+        index,
+        elapsed * 1000 / furi_kernel_get_tick_frequency(),
+        elapsed ? index * furi_kernel_get_tick_frequency() / elapsed : 0);
     if(picopass_worker->state == PicopassWorkerStateEliteDictAttack) {
         picopass_worker->callback(PicopassWorkerEventSuccess, picopass_worker->context);
     } else {
@@ -137,6 +137,9 @@ bool picopass_scene_elite_dict_attack_on_event(void* context, SceneManagerEvent
             consumed = true;
         } else if(event.event == PicopassWorkerEventNewDictKeyBatch) {
             dict_attack_inc_current_dict_key(picopass->dict_attack, PICOPASS_DICT_KEY_BATCH_SIZE);
+            dict_attack_set_keys_per_second(
+                picopass->dict_attack,
+                picopass->dev->dev_data.iclass_elite_dict_attack_data.keys_per_second);
             consumed = true;
         } else if(event.event == PicopassCustomEventDictAttackSkip) {
             if(state == DictAttackStateUserDictInProgress) {
@@ -2,6 +2,8 @@
 
 #include <gui/elements.h>
 
+#define DICT_ATTACK_RATE_WIDTH_MAX (44)
+
 typedef enum {
     DictAttackStateRead,
     DictAttackStateCardRemoved,
@@ -24,6 +26,7 @@ typedef struct {
     uint8_t keys_found;
     uint16_t dict_keys_total;
     uint16_t dict_keys_current;
+    uint32_t keys_per_second;
     bool is_key_attack;
     uint8_t key_attack_current_sector;
 } DictAttackViewModel;
@@ -74,6 +77,14 @@ static void dict_attack_draw_callback(Canvas* canvas, void* model) {
         snprintf(
             draw_str, sizeof(draw_str), "Sectors Read: %d/%d", m->sectors_read, m->sectors_total);
         canvas_draw_str_aligned(canvas, 0, 43, AlignLeft, AlignTop, draw_str);
+        if(m->keys_per_second) {
+            // Bottom row, right of the Skip button
+            snprintf(draw_str, sizeof(draw_str), "%lu keys/s", m->keys_per_second);
+            if(canvas_string_width(canvas, draw_str) > DICT_ATTACK_RATE_WIDTH_MAX) {
+                snprintf(draw_str, sizeof(draw_str), "%lu/s", m->keys_per_second);
+            }
+            canvas_draw_str_aligned(canvas, 128, 64, AlignRight, AlignBottom, draw_str);
+        }
     }
     elements_button_center(canvas, "Skip");
 }
@@ -131,6 +142,7 @@ void dict_attack_reset(DictAttack* dict_attack) {
             model->keys_found = 0;
             model->dict_keys_total = 0;
             model->dict_keys_current = 0;
+            model->keys_per_second = 0;
             model->is_key_attack = false;
             furi_string_reset(model->header);
         },
@@ -255,6 +267,15 @@ void dict_attack_inc_current_dict_key(DictAttack* dict_attack, uint16_t keys_tri
         true);
 }
 
+void dict_attack_set_keys_per_second(DictAttack* dict_attack, uint32_t keys_per_second) {
+    furi_assert(dict_attack);
+    with_view_model(
+        dict_attack->view,
+        DictAttackViewModel * model,
+        { model->keys_per_second = keys_per_second; },
+        true);
+}
+
 void dict_attack_set_key_attack(DictAttack* dict_attack, bool is_key_attack, uint8_t sector) {
     furi_assert(dict_attack);
     with_view_model(
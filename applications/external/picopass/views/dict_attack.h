@@ -39,6 +39,8 @@ void dict_attack_set_total_dict_keys(DictAttack* dict_attack, uint16_t dict_keys
 
 void dict_attack_inc_current_dict_key(DictAttack* dict_attack, uint16_t keys_tried);
 
+void dict_attack_set_keys_per_second(DictAttack* dict_attack, uint32_t keys_per_second);
+
 void dict_attack_set_key_attack(DictAttack* dict_attack, bool is_key_attack, uint8_t sector);
 
 void dict_attack_inc_key_attack_current_sector(DictAttack* dict_attack);
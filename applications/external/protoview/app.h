@@ -239,6 +239,15 @@ typedef struct ProtoViewDecoder {
     void (*build_message)(RawSamplesBuffer* samples, ProtoViewFieldSet* fields);
 } ProtoViewDecoder;
 
+/* A sequence of up to 64 bits, like "0110", compiled by
+ * bitmap_pattern_compile() so that it can be searched in a bitmap a
+ * word at a time. */
+typedef struct {
+    uint64_t value; /* Pattern bits, first bit as MSB. */
+    uint64_t mask; /* The first 'len' bits set. */
+    uint32_t len; /* Pattern length in bits. */
+} BitmapPattern;
+
 extern RawSamplesBuffer *RawSamples, *DetectedSamples;
 
 /* app_subghz.c */
@@ -268,7 +277,15 @@ void bitmap_copy(
     uint32_t count);
 void bitmap_set_pattern(uint8_t* b, uint32_t blen, uint32_t off, const char* pat);
 void bitmap_reverse_bytes_bits(uint8_t* p, uint32_t len);
+bool bitmap_pattern_compile(BitmapPattern* p, const char* bits);
+bool bitmap_match_pattern(uint8_t* b, uint32_t blen, uint32_t bitpos, const BitmapPattern* p);
 bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits);
+uint32_t bitmap_seek_pattern(
+    uint8_t* b,
+    uint32_t blen,
+    uint32_t startpos,
+    uint32_t maxbits,
+    const BitmapPattern* p);
 uint32_t bitmap_seek_bits(
     uint8_t* b,
     uint32_t blen,
@@ -399,10 +399,88 @@ void bitmap_reverse_bytes_bits(uint8_t* p, uint32_t len) {
     }
 }
 
+/* Return 64 bits of the bitmap 'b' of 'blen' bytes starting at 'bitpos',
+ * the first bit as MSB. Out of range bits are returned as zero, exactly
+ * like bitmap_get() does, so callers can compare whole words without
+ * caring about the bitmap end. */
+static uint64_t bitmap_get_word(uint8_t* b, uint32_t blen, uint32_t bitpos) {
+    uint32_t byte = bitpos / 8;
+    uint32_t skew = bitpos & 7;
+    uint64_t word = 0;
+    uint8_t next;
+
+    if(byte < blen && blen - byte > 8) {
+        memcpy(&word, b + byte, sizeof(word));
+        word = __builtin_bswap64(word); /* Bitmap is MSB first. */
+        next = b[byte + 8];
+    } else {
+        for(uint32_t j = 0; j < 8; j++) word = word << 8 | (byte + j < blen ? b[byte + j] : 0);
+        next = byte + 8 < blen ? b[byte + 8] : 0;
+    }
+    if(skew) word = word << skew | next >> (8 - skew);
+    return word;
+}
+
+/* Like bitmap_get_word(), but for 8 bits only. Cheaper when comparing
+ * short symbols. */
+static uint8_t bitmap_get_byte(uint8_t* b, uint32_t blen, uint32_t bitpos) {
+    uint32_t byte = bitpos / 8;
+    uint32_t skew = bitpos & 7;
+    uint32_t value = byte < blen ? b[byte] : 0;
+    if(skew) value = value << skew | (byte + 1 < blen ? b[byte + 1] : 0) >> (8 - skew);
+    return value;
+}
+
+/* Store the 'count' most significant bits of 'bits' in the bitmap 'b' of
+ * 'blen' bytes at 'bitpos', like 'count' calls to bitmap_set() would do,
+ * but a byte at a time. Returns the position after the last stored bit,
+ * that never goes past the end of the bitmap. */
+static uint32_t
+    bitmap_set_word(uint8_t* b, uint64_t blen, uint32_t bitpos, uint64_t bits, uint32_t count) {
+    while(count && bitpos / 8 < blen) {
+        uint32_t skew = bitpos & 7;
+        uint32_t n = 8 - skew < count ? 8 - skew : count;
+        uint8_t mask = (0xff >> skew) & (0xff << (8 - skew - n));
+        b[bitpos / 8] = (b[bitpos / 8] & ~mask) | ((bits >> (56 + skew)) & mask);
+        bits <<= n;
+        bitpos += n;
+        count -= n;
+    }
+    return bitpos;
+}
+
+/* Compile the sequence of bits 'bits', provided as a string in the form
+ * "11010110...", into 'p': the bits are stored MSB first in p->value, and
+ * p->mask has the first p->len bits set. This way the pattern can be
+ * compared against 64 bits of a bitmap with a single AND and compare.
+ * Returns false if the pattern is longer than 64 bits. */
+bool bitmap_pattern_compile(BitmapPattern* p, const char* bits) {
+    p->value = 0;
+    p->mask = 0;
+    for(p->len = 0; bits[p->len]; p->len++) {
+        if(p->len == 64) return false;
+        uint64_t bit = 1ULL << (63 - p->len);
+        p->mask |= bit;
+        if(bits[p->len] == '1') p->value |= bit;
+    }
+    return true;
+}
+
+/* Like bitmap_match_bits(), but with a compiled pattern. */
+bool bitmap_match_pattern(uint8_t* b, uint32_t blen, uint32_t bitpos, const BitmapPattern* p) {
+    return (bitmap_get_word(b, blen, bitpos) & p->mask) == p->value;
+}
+
 /* Return true if the specified sequence of bits, provided as a string in the
  * form "11010110..." is found in the 'b' bitmap of 'blen' bits at 'bitpos'
  * position. */
 bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits) {
+    BitmapPattern p;
+    if(bitmap_pattern_compile(&p, bits) && bitpos <= UINT32_MAX - p.len)
+        return bitmap_match_pattern(b, blen, bitpos, &p);
+
+    /* Patterns longer than 64 bits, or wrapping around the bit
+     * offsets range, are checked a bit at a time. */
     for(size_t j = 0; bits[j]; j++) {
         bool expected = (bits[j] == '1') ? true : false;
         if(bitmap_get(b, blen, bitpos + j) != expected) return false;
@@ -410,20 +488,49 @@ bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* b
     return true;
 }
 
+/* Like bitmap_seek_bits(), but with a compiled pattern.
+ *
+ * Every 64 bits word read from the bitmap contains the pattern at
+ * 65 - p->len different offsets, so we test all of them just shifting
+ * the word, and only then read the next word. */
+uint32_t bitmap_seek_pattern(
+    uint8_t* b,
+    uint32_t blen,
+    uint32_t startpos,
+    uint32_t maxbits,
+    const BitmapPattern* p) {
+    uint32_t endpos = startpos + blen * 8;
+    uint32_t end2 = startpos + maxbits;
+    if(end2 < endpos) endpos = end2;
+    uint32_t step = 65 - p->len;
+    for(uint32_t j = startpos; j < endpos; j += step) {
+        uint64_t word = bitmap_get_word(b, blen, j);
+        for(uint32_t k = 0; k < step && j + k < endpos; k++) {
+            if(((word << k) & p->mask) == p->value) return j + k;
+        }
+    }
+    return BITMAP_SEEK_NOT_FOUND;
+}
+
 /* Search for the specified bit sequence (see bitmap_match_bits() for details)
  * in the bitmap 'b' of 'blen' bytes, looking forward at most 'maxbits' ahead.
  * Returns the offset (in bits) of the match, or BITMAP_SEEK_NOT_FOUND if not
  * found.
  *
- * Note: there are better algorithms, such as Boyer-Moore. Here we hope that
- * for the kind of patterns we search we'll have a lot of early stops so
- * we use a vanilla approach. */
+ * The pattern is compiled once and then searched a word at a time, see
+ * bitmap_seek_pattern(). Patterns longer than 64 bits are searched with
+ * the vanilla approach, trying to match at every offset. */
 uint32_t bitmap_seek_bits(
     uint8_t* b,
     uint32_t blen,
     uint32_t startpos,
     uint32_t maxbits,
     const char* bits) {
+    BitmapPattern p;
+    if(bitmap_pattern_compile(&p, bits)) {
+        return bitmap_seek_pattern(b, blen, startpos, maxbits, &p);
+    }
+
     uint32_t endpos = startpos + blen * 8;
     uint32_t end2 = startpos + maxbits;
     if(end2 < endpos) endpos = end2;
@@ -434,7 +541,8 @@ uint32_t bitmap_seek_bits(
 
 /* Compare bitmaps b1 and b2 (possibly overlapping or the same bitmap),
  * at the specified offsets, for cmplen bits. Returns true if the
- * exact same bits are found, otherwise false. */
+ * exact same bits are found, otherwise false. Bits are compared 64
+ * at a time. */
 bool bitmap_match_bitmap(
     uint8_t* b1,
     uint32_t b1len,
@@ -443,10 +551,29 @@ bool bitmap_match_bitmap(
     uint32_t b2len,
     uint32_t b2off,
     uint32_t cmplen) {
-    for(uint32_t j = 0; j < cmplen; j++) {
-        bool bit1 = bitmap_get(b1, b1len, b1off + j);
-        bool bit2 = bitmap_get(b2, b2len, b2off + j);
-        if(bit1 != bit2) return false;
+    /* Callers may pass UINT32_MAX as "unknown" offset, that wraps to the
+     * bitmap start: keep comparing such ranges a bit at a time. */
+    if(b1off > UINT32_MAX - cmplen || b2off > UINT32_MAX - cmplen) {
+        for(uint32_t j = 0; j < cmplen; j++) {
+            bool bit1 = bitmap_get(b1, b1len, b1off + j);
+            bool bit2 = bitmap_get(b2, b2len, b2off + j);
+            if(bit1 != bit2) return false;
+        }
+        return true;
+    }
+
+    if(cmplen <= 8) {
+        uint8_t diff = bitmap_get_byte(b1, b1len, b1off) ^ bitmap_get_byte(b2, b2len, b2off);
+        return (diff >> (8 - cmplen)) == 0;
+    }
+
+    while(cmplen) {
+        uint32_t n = cmplen < 64 ? cmplen : 64;
+        uint64_t diff = bitmap_get_word(b1, b1len, b1off) ^ bitmap_get_word(b2, b2len, b2off);
+        if(diff >> (64 - n)) return false;
+        b1off += n;
+        b2off += n;
+        cmplen -= n;
     }
     return true;
 }
@@ -556,21 +683,62 @@ uint32_t convert_from_line_code(
     const char* zero_pattern,
     const char* one_pattern) {
     uint32_t decoded = 0; /* Number of bits extracted. */
-    len *= 8; /* Convert bytes to bits. */
-    while(off < len) {
-        bool bitval;
-        if(bitmap_match_bits(bits, len, off, zero_pattern)) {
-            bitval = false;
-            off += strlen(zero_pattern);
-        } else if(bitmap_match_bits(bits, len, off, one_pattern)) {
-            bitval = true;
-            off += strlen(one_pattern);
+    uint32_t lenbits = len * 8;
+    BitmapPattern zero, one;
+
+    /* Line codes symbols are short: check them against a word of the
+     * bitmap read once every few symbols, and store the decoded bits
+     * 64 at a time. Unusual patterns are handled a bit at a time. */
+    if(!bitmap_pattern_compile(&zero, zero_pattern) ||
+       !bitmap_pattern_compile(&one, one_pattern) || zero.len == 0 || one.len == 0 ||
+       zero.len > 32 || one.len > 32) {
+        while(off < lenbits) {
+            bool bitval;
+            if(bitmap_match_bits(bits, len, off, zero_pattern)) {
+                bitval = false;
+                off += strlen(zero_pattern);
+            } else if(bitmap_match_bits(bits, len, off, one_pattern)) {
+                bitval = true;
+                off += strlen(one_pattern);
+            } else {
+                break;
+            }
+            bitmap_set(buf, buflen, decoded++, bitval);
+            if(decoded / 8 == buflen) break; /* No space left on target buffer. */
+        }
+        return decoded;
+    }
+
+    uint32_t maxlen = zero.len > one.len ? zero.len : one.len;
+    uint64_t word = 0; /* Bitmap bits at 'off', MSB first. */
+    uint32_t avail = 0; /* Valid bits in 'word'. */
+    uint64_t out = 0; /* Decoded bits not yet stored, LSB last. */
+    uint32_t outlen = 0;
+    while(off < lenbits) {
+        if(avail < maxlen) {
+            word = bitmap_get_word(bits, len, off);
+            avail = 64;
+        }
+        if((word & zero.mask) == zero.value) {
+            out <<= 1;
+            word <<= zero.len;
+            avail -= zero.len;
+            off += zero.len;
+        } else if((word & one.mask) == one.value) {
+            out = out << 1 | 1;
+            word <<= one.len;
+            avail -= one.len;
+            off += one.len;
         } else {
             break;
         }
-        bitmap_set(buf, buflen, decoded++, bitval);
-        if(decoded / 8 == buflen) break; /* No space left on target buffer. */
+        if(++outlen == 64) {
+            decoded = bitmap_set_word(buf, buflen, decoded, out, outlen);
+            outlen = 0;
+            if(decoded / 8 == buflen) return decoded; /* No space left. */
+        }
     }
+    if(outlen) decoded = bitmap_set_word(buf, buflen, decoded, out << (64 - outlen), outlen);
     return decoded;
 }
 
@@ -579,6 +747,10 @@ uint32_t convert_from_line_code(
  * supply the value of the previous symbol before this stream, since
  * in differential codings the next bits depend on the previous one.
  *
+ * The bitmap is processed 32 symbols at a time: every symbol must start
+ * switching value from the second half of the previous one, and it
+ * decodes to 1 if its two halves are the same.
+ *
  * Parameters and return values are like convert_from_line_code(). */
 uint32_t convert_from_diff_manchester(
     uint8_t* buf,
@@ -587,15 +759,29 @@ uint32_t convert_from_diff_manchester(
     uint32_t len,
     uint32_t off,
     bool previous) {
+    const uint64_t first_halves = 0xAAAAAAAAAAAAAAAAULL;
     uint32_t decoded = 0;
-    len *= 8; /* Conver to bits. */
-    for(uint32_t j = off; j < len; j += 2) {
-        bool b0 = bitmap_get(bits, len, j);
-        bool b1 = bitmap_get(bits, len, j + 1);
-        if(b0 == previous) break; /* Each new bit must switch value. */
-        bitmap_set(buf, buflen, decoded++, b0 == b1);
-        previous = b1;
-        if(decoded / 8 == buflen) break; /* No space left on target buffer. */
+    uint32_t lenbits = len * 8;
+    for(uint32_t j = off; j < lenbits; j += 64) {
+        uint64_t word = bitmap_get_word(bits, len, j);
+
+        /* Each new bit must switch value: stop at the first one that
+         * does not. */
+        uint64_t invalid = ~(word ^ (word >> 1 | (uint64_t)previous << 63)) & first_halves;
+        uint32_t count = invalid ? __builtin_clzll(invalid) / 2 : 32;
+        if(count > (lenbits - j + 1) / 2) count = (lenbits - j + 1) / 2;
+
+        /* Gather the symbols values, one per even bit, in the low 32 bits. */
+        uint64_t value = (~(word ^ word << 1) & first_halves) >> 1;
+        value = (value | value >> 1) & 0x3333333333333333ULL;
+        value = (value | value >> 2) & 0x0F0F0F0F0F0F0F0FULL;
+        value = (value | value >> 4) & 0x00FF00FF00FF00FFULL;
+        value = (value | value >> 8) & 0x0000FFFF0000FFFFULL;
+        value = (value | value >> 16) & 0x00000000FFFFFFFFULL;
+
+        decoded = bitmap_set_word(buf, buflen, decoded, value << 32, count);
+        if(count < 32 || decoded / 8 == buflen) break;
+        previous = word & 1;
     }
     return decoded;
 }
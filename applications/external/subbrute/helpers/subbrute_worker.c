@@ -1,8 +1,5 @@
 #include "subbrute_worker_private.h"
 #include <string.h>
-#include <toolbox/stream/stream.h>
-#include <flipper_format.h>
-#include <flipper_format_i.h>
 #include <lib/subghz/protocols/protocol_items.h>
 
 #define TAG "SubBruteWorker"
@@ -74,6 +71,24 @@ bool subbrute_worker_set_step(SubBruteWorker* instance, uint64_t step) {
     return true;
 }
 
+static void subbrute_worker_transmitter_init(SubBruteWorker* instance) {
+    if(instance->transmitter != NULL) {
+        subghz_transmitter_free(instance->transmitter);
+    }
+    instance->protocol_name = subbrute_protocol_file(instance->file);
+    instance->transmitter =
+        subghz_transmitter_alloc_init(instance->environment, instance->protocol_name);
+}
+
+static uint64_t subbrute_worker_key(SubBruteWorker* instance, uint64_t step) {
+    if(instance->attack == SubBruteAttackLoadFile) {
+        return subbrute_protocol_file_key(
+            step, instance->load_index, instance->file_key, instance->two_bytes);
+    } else {
+        return subbrute_protocol_default_key(instance->file, step);
+    }
+}
+
 bool subbrute_worker_init_default_attack(
     SubBruteWorker* instance,
     SubBruteAttacks attack_type,
@@ -102,6 +117,8 @@ bool subbrute_worker_init_default_attack(
     instance->max_value =
         subbrute_protocol_calc_max_value(instance->attack, instance->bits, instance->two_bytes);
 
+    subbrute_worker_transmitter_init(instance);
+
     instance->initiated = true;
     instance->state = SubBruteWorkerStateReady;
     subbrute_worker_send_callback(instance);
@@ -151,6 +168,8 @@ bool subbrute_worker_init_file_attack(
     instance->max_value =
         subbrute_protocol_calc_max_value(instance->attack, instance->bits, instance->two_bytes);
 
+    subbrute_worker_transmitter_init(instance);
+
     instance->initiated = true;
     instance->state = SubBruteWorkerStateReady;
     subbrute_worker_send_callback(instance);
@@ -237,43 +256,10 @@ bool subbrute_worker_transmit_current_key(SubBruteWorker* instance, uint64_t ste
     instance->last_time_tx_data = ticks;
     instance->step = step;
 
-    bool result;
-    instance->protocol_name = subbrute_protocol_file(instance->file);
-    FlipperFormat* flipper_format = flipper_format_string_alloc();
-    Stream* stream = flipper_format_get_raw_stream(flipper_format);
-
-    stream_clean(stream);
-
-    if(instance->attack == SubBruteAttackLoadFile) {
-        subbrute_protocol_file_payload(
-            stream,
-            step,
-            instance->bits,
-            instance->te,
-            instance->repeat,
-            instance->load_index,
-            instance->file_key,
-            instance->two_bytes);
-    } else {
-        subbrute_protocol_default_payload(
-            stream, instance->file, step, instance->bits, instance->te, instance->repeat);
-    }
-
-    //    size_t written = stream_write_string(stream, payload);
-    //    if(written <= 0) {
-    //        FURI_LOG_W(TAG, "Error creating packet! EXIT");
-    //        result = false;
-    //    } else {
-    subbrute_worker_subghz_transmit(instance, flipper_format);
-
-    result = true;
+    bool result = subbrute_worker_subghz_transmit(instance, step);
 #if FURI_DEBUG
     FURI_LOG_D(TAG, "Manual transmit done");
 #endif
-    //    }
-
-    flipper_format_free(flipper_format);
-    //    furi_string_free(payload);
 
     return result;
 }
@@ -305,34 +291,45 @@ void subbrute_worker_set_callback(
     instance->context = context;
 }
 
-void subbrute_worker_subghz_transmit(SubBruteWorker* instance, FlipperFormat* flipper_format) {
-    while(instance->transmit_mode) {
-        furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
-    }
-    instance->transmit_mode = true;
-    if(instance->transmitter != NULL) {
-        subghz_transmitter_free(instance->transmitter);
-        instance->transmitter = NULL;
-    }
-    instance->transmitter =
-        subghz_transmitter_alloc_init(instance->environment, instance->protocol_name);
-    subghz_transmitter_deserialize(instance->transmitter, flipper_format);
+static void subbrute_worker_subghz_start(SubBruteWorker* instance) {
     furi_hal_subghz_reset();
     furi_hal_subghz_load_preset(instance->preset);
     furi_hal_subghz_set_frequency_and_path(instance->frequency);
     furi_hal_subghz_start_async_tx(subghz_transmitter_yield, instance->transmitter);
+}
 
-    while(!furi_hal_subghz_is_async_tx_complete()) {
-        furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
-    }
+static void subbrute_worker_subghz_stop(void) {
     furi_hal_subghz_stop_async_tx();
 
     furi_hal_subghz_set_path(FuriHalSubGhzPathIsolate);
     furi_hal_subghz_sleep();
-    subghz_transmitter_free(instance->transmitter);
-    instance->transmitter = NULL;
+}
+
+bool subbrute_worker_subghz_transmit(SubBruteWorker* instance, uint64_t step) {
+    while(instance->transmit_mode) {
+        furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+    }
+    instance->transmit_mode = true;
+
+    bool result = instance->transmitter &&
+                  subghz_transmitter_set_key(
+                      instance->transmitter,
+                      subbrute_worker_key(instance, step),
+                      instance->bits,
+                      instance->te,
+                      instance->repeat) == SubGhzProtocolStatusOk;
+    if(result) {
+        subbrute_worker_subghz_start(instance);
+        while(!furi_hal_subghz_is_async_tx_complete()) {
+            furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+        }
+        subbrute_worker_subghz_stop();
+    } else {
+        FURI_LOG_W(TAG, "Error creating packet!");
+    }
 
     instance->transmit_mode = false;
+    return result;
 }
 
 void subbrute_worker_send_callback(SubBruteWorker* instance) {
@@ -367,63 +364,73 @@ int32_t subbrute_worker_thread(void* context) {
     SubBruteWorkerState local_state = instance->state = SubBruteWorkerStateTx;
     subbrute_worker_send_callback(instance);
 
-    instance->protocol_name = subbrute_protocol_file(instance->file);
-
-    FlipperFormat* flipper_format = flipper_format_string_alloc();
-    Stream* stream = flipper_format_get_raw_stream(flipper_format);
-
-    while(instance->worker_running) {
-        stream_clean(stream);
-        if(instance->attack == SubBruteAttackLoadFile) {
-            subbrute_protocol_file_payload(
-                stream,
-                instance->step,
-                instance->bits,
-                instance->te,
-                instance->repeat,
-                instance->load_index,
-                instance->file_key,
-                instance->two_bytes);
-        } else {
-            subbrute_protocol_default_payload(
-                stream,
-                instance->file,
-                instance->step,
-                instance->bits,
-                instance->te,
-                instance->repeat);
-        }
-#ifdef FURI_DEBUG
-        //FURI_LOG_I(TAG, "Payload: %s", furi_string_get_cstr(payload));
-        //furi_delay_ms(SUBBRUTE_MANUAL_TRANSMIT_INTERVAL / 4);
-#endif
-
-        //        size_t written = stream_write_stream_write_string(stream, payload);
-        //        if(written <= 0) {
-        //            FURI_LOG_W(TAG, "Error creating packet! BREAK");
-        //            instance->worker_running = false;
-        //            local_state = SubBruteWorkerStateIDLE;
-        //            furi_string_free(payload);
-        //            break;
-        //        }
-
-        subbrute_worker_subghz_transmit(instance, flipper_format);
+    while(instance->transmit_mode) {
+        furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+    }
+    instance->transmit_mode = true;
 
-        if(instance->step + 1 > instance->max_value) {
+    SubGhzTransmitter* transmitter = instance->transmitter;
+    if(!transmitter ||
+       subghz_transmitter_set_key(
+           transmitter,
+           subbrute_worker_key(instance, instance->step),
+           instance->bits,
+           instance->te,
+           instance->repeat) != SubGhzProtocolStatusOk) {
+        FURI_LOG_W(TAG, "Error creating packet! EXIT");
+        local_state = SubBruteWorkerStateIDLE;
+    } else {
+        // Radio stays configured for the whole attack, next key is rendered while current
+        // one is sent and transmitter switches to it without a gap
+        subbrute_worker_subghz_start(instance);
+
+        while(instance->worker_running) {
+            if(instance->step + 1 > instance->max_value) {
+                while(instance->worker_running && !furi_hal_subghz_is_async_tx_complete()) {
+                    furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+                }
+                if(instance->worker_running) {
 #ifdef FURI_DEBUG
-            FURI_LOG_I(TAG, "Worker finished to end");
+                    FURI_LOG_I(TAG, "Worker finished to end");
 #endif
-            local_state = SubBruteWorkerStateFinished;
-            //            furi_string_free(payload);
-            break;
+                    local_state = SubBruteWorkerStateFinished;
+                }
+                break;
+            }
+
+            if(subghz_transmitter_queue_key(
+                   transmitter,
+                   subbrute_worker_key(instance, instance->step + 1),
+                   instance->bits,
+                   instance->te,
+                   instance->repeat) != SubGhzProtocolStatusOk) {
+                FURI_LOG_W(TAG, "Error creating packet! BREAK");
+                local_state = SubBruteWorkerStateIDLE;
+                break;
+            }
+
+            while(instance->worker_running && subghz_transmitter_is_key_queued(transmitter) &&
+                  !furi_hal_subghz_is_async_tx_complete()) {
+                furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+            }
+
+            if(!instance->worker_running) {
+                break;
+            }
+            if(subghz_transmitter_is_key_queued(transmitter)) {
+                // Current key ended before the next one was queued, restart transmission
+                furi_hal_subghz_stop_async_tx();
+                furi_hal_subghz_start_async_tx(subghz_transmitter_yield, transmitter);
+            }
+
+            instance->step++;
         }
-        instance->step++;
 
-        //        furi_string_free(payload);
-        furi_delay_ms(SUBBRUTE_TX_TIMEOUT);
+        subghz_transmitter_stop(transmitter);
+        subbrute_worker_subghz_stop();
     }
 
-    flipper_format_free(flipper_format);
+    instance->transmit_mode = false;
 
     instance->worker_running = false; // Because we have error states
     instance->state = local_state == SubBruteWorkerStateTx ? SubBruteWorkerStateReady :
@@ -44,5 +44,5 @@ struct SubBruteWorker {
 };
 
 int32_t subbrute_worker_thread(void* context);
-void subbrute_worker_subghz_transmit(SubBruteWorker* instance, FlipperFormat* flipper_format);
+bool subbrute_worker_subghz_transmit(SubBruteWorker* instance, uint64_t step);
 void subbrute_worker_send_callback(SubBruteWorker* instance);
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "subbrute_protocols.h"
-#include "math.h"
 #include <string.h>
 
 #define TAG "SubBruteProtocols"
@@ -525,10 +524,8 @@ static const char* subbrute_key_file_start_no_tail =
     "Filetype: Flipper SubGhz Key File\nVersion: 1\nFrequency: %u\nPreset: %s\nProtocol: %s\nBit: %d\nKey: %s\n";
 static const char* subbrute_key_file_start_with_tail =
     "Filetype: Flipper SubGhz Key File\nVersion: 1\nFrequency: %u\nPreset: %s\nProtocol: %s\nBit: %d\nKey: %s\nTE: %d\n";
-static const char* subbrute_key_small_no_tail = "Bit: %d\nKey: %s\nRepeat: %d\n";
 //static const char* subbrute_key_small_raw =
 //    "Filetype: Flipper SubGhz Key File\nVersion: 1\nFrequency: %u\nPreset: %s\nProtocol: %s\nBit: %d\n";
-static const char* subbrute_key_small_with_tail = "Bit: %d\nKey: %s\nTE: %d\nRepeat: %d\n";
 
 const char* subbrute_protocol_name(SubBruteAttacks index) {
     return subbrute_protocol_names[index];
@@ -570,81 +567,51 @@ SubBruteFileProtocol subbrute_protocol_file_protocol_name(FuriString* name) {
     return UnknownFileProtocol;
 }
 
-void subbrute_protocol_create_candidate_for_existing_file(
-    FuriString* candidate,
+uint64_t subbrute_protocol_file_key(
     uint64_t step,
     uint8_t bit_index,
     uint64_t file_key,
     bool two_bytes) {
-    uint8_t p[8];
-    for(int i = 0; i < 8; i++) {
-        p[i] = (uint8_t)(file_key >> 8 * (7 - i)) & 0xFF;
+    uint64_t low_byte = step & (0xff);
+    uint64_t high_byte = (step >> 8) & 0xff;
+
+    // Bytes are numbered from the most significant one, as they are written in the file
+    uint64_t key = file_key & ~(0xFFULL << 8 * (7 - bit_index));
+    key |= low_byte << 8 * (7 - bit_index);
+    if(two_bytes && bit_index > 0) {
+        key &= ~(0xFFULL << 8 * (8 - bit_index));
+        key |= high_byte << 8 * (8 - bit_index);
     }
-    uint8_t low_byte = step & (0xff);
-    uint8_t high_byte = (step >> 8) & 0xff;
 
-    size_t size = sizeof(uint64_t);
-    for(uint8_t i = 0; i < size; i++) {
-        if(i == bit_index - 1 && two_bytes) {
-            furi_string_cat_printf(candidate, "%02X %02X", high_byte, low_byte);
-            i++;
-        } else if(i == bit_index) {
-            furi_string_cat_printf(candidate, "%02X", low_byte);
-        } else if(p[i] != 0) {
-            furi_string_cat_printf(candidate, "%02X", p[i]);
-        } else {
-            furi_string_cat_printf(candidate, "%s", "00");
-        }
-
-        if(i < size - 1) {
-            furi_string_push_back(candidate, ' ');
-        }
-    }
-
-#ifdef FURI_DEBUG
-    FURI_LOG_D(TAG, "file candidate: %s, step: %lld", furi_string_get_cstr(candidate), step);
-#endif
+    return key;
 }
 
-void subbrute_protocol_create_candidate_for_default(
-    FuriString* candidate,
-    SubBruteFileProtocol file,
-    uint64_t step) {
-    uint8_t p[8];
+uint64_t subbrute_protocol_default_key(SubBruteFileProtocol file, uint64_t step) {
+    uint64_t total;
     if(file == SMC5326FileProtocol) {
         const uint8_t lut[] = {0x00, 0x02, 0x03}; // 00, 10, 11
         const uint64_t gate1 = 0x01D5; // 111010101
         //const uint8_t gate2 = 0x0175; // 101110101
 
-        uint64_t total = 0;
+        total = 0;
         for(size_t j = 0; j < 8; j++) {
             total |= lut[step % 3] << (2 * j);
-            double sub_step = step / 3;
-            step = (uint64_t)floor(sub_step);
+            step /= 3;
         }
         total <<= 9;
         total |= gate1;
-
-        for(int i = 0; i < 8; i++) {
-            p[i] = (uint8_t)(total >> 8 * (7 - i)) & 0xFF;
-        }
     } else if(file == UNILARMFileProtocol) {
         const uint8_t lut[] = {0x00, 0x02, 0x03}; // 00, 10, 11
         const uint64_t gate1 = 3 << 7;
         //const uint8_t gate2 = 3 << 5;
 
-        uint64_t total = 0;
+        total = 0;
         for(size_t j = 0; j < 8; j++) {
             total |= lut[step % 3] << (2 * j);
-            double sub_step = step / 3;
-            step = (uint64_t)floor(sub_step);
+            step /= 3;
         }
         total <<= 9;
         total |= gate1;
-
-        for(int i = 0; i < 8; i++) {
-            p[i] = (uint8_t)(total >> 8 * (7 - i)) & 0xFF;
-        }
     } else if(file == PT2260FileProtocol) {
         const uint8_t lut[] = {0x00, 0x01, 0x03}; // 00, 01, 11
         const uint64_t button_open = 0x03; // 11
@@ -652,31 +619,24 @@ void subbrute_protocol_create_candidate_for_default(
         //const uint8_t button_stop = 0x30; // 110000
         //const uint8_t button_close = 0xC0; // 11000000
 
-        uint64_t total = 0;
+        total = 0;
         for(size_t j = 0; j < 8; j++) {
             total |= lut[step % 3] << (2 * j);
-            double sub_step = step / 3;
-            step = (uint64_t)floor(sub_step);
+            step /= 3;
         }
         total <<= 8;
         total |= button_open;
-
-        for(int i = 0; i < 8; i++) {
-            p[i] = (uint8_t)(total >> 8 * (7 - i)) & 0xFF;
-        }
     } else {
-        for(int i = 0; i < 8; i++) {
-            p[i] = (uint8_t)(step >> 8 * (7 - i)) & 0xFF;
-        }
+        total = step;
     }
 
+    return total;
+}
+
+static void subbrute_protocol_create_candidate(FuriString* candidate, uint64_t key) {
     size_t size = sizeof(uint64_t);
     for(uint8_t i = 0; i < size; i++) {
-        if(p[i] != 0) {
-            furi_string_cat_printf(candidate, "%02X", p[i]);
-        } else {
-            furi_string_cat_printf(candidate, "%s", "00");
-        }
+        furi_string_cat_printf(candidate, "%02X", (uint8_t)(key >> 8 * (7 - i)));
 
         if(i < size - 1) {
             furi_string_push_back(candidate, ' ');
@@ -684,84 +644,8 @@ void subbrute_protocol_create_candidate_for_default(
     }
 
 #ifdef FURI_DEBUG
-    FURI_LOG_D(TAG, "candidate: %s, step: %lld", furi_string_get_cstr(candidate), step);
-#endif
-}
-
-void subbrute_protocol_default_payload(
-    Stream* stream,
-    SubBruteFileProtocol file,
-    uint64_t step,
-    uint8_t bits,
-    uint32_t te,
-    uint8_t repeat) {
-    FuriString* candidate = furi_string_alloc();
-    subbrute_protocol_create_candidate_for_default(candidate, file, step);
-
-#ifdef FURI_DEBUG
-    FURI_LOG_D(
-        TAG,
-        "candidate: %s, step: %lld, repeat: %d, te: %s",
-        furi_string_get_cstr(candidate),
-        step,
-        repeat,
-        te ? "true" : "false");
-#endif
-    stream_clean(stream);
-    if(te) {
-        stream_write_format(
-            stream,
-            subbrute_key_small_with_tail,
-            bits,
-            furi_string_get_cstr(candidate),
-            te,
-            repeat);
-    } else {
-        stream_write_format(
-            stream, subbrute_key_small_no_tail, bits, furi_string_get_cstr(candidate), repeat);
-    }
-
-    furi_string_free(candidate);
-}
-
-void subbrute_protocol_file_payload(
-    Stream* stream,
-    uint64_t step,
-    uint8_t bits,
-    uint32_t te,
-    uint8_t repeat,
-    uint8_t bit_index,
-    uint64_t file_key,
-    bool two_bytes) {
-    FuriString* candidate = furi_string_alloc();
-    subbrute_protocol_create_candidate_for_existing_file(
-        candidate, step, bit_index, file_key, two_bytes);
-
-#ifdef FURI_DEBUG
-    FURI_LOG_D(
-        TAG,
-        "candidate: %s, step: %lld, repeat: %d, te: %s",
-        furi_string_get_cstr(candidate),
-        step,
-        repeat,
-        te ? "true" : "false");
+    FURI_LOG_D(TAG, "candidate: %s", furi_string_get_cstr(candidate));
 #endif
-    stream_clean(stream);
-
-    if(te) {
-        stream_write_format(
-            stream,
-            subbrute_key_small_with_tail,
-            bits,
-            furi_string_get_cstr(candidate),
-            te,
-            repeat);
-    } else {
-        stream_write_format(
-            stream, subbrute_key_small_no_tail, bits, furi_string_get_cstr(candidate), repeat);
-    }
-
-    furi_string_free(candidate);
 }
 
 void subbrute_protocol_default_generate_file(
@@ -773,7 +657,7 @@ void subbrute_protocol_default_generate_file(
     uint8_t bits,
     uint32_t te) {
     FuriString* candidate = furi_string_alloc();
-    subbrute_protocol_create_candidate_for_default(candidate, file, step);
+    subbrute_protocol_create_candidate(candidate, subbrute_protocol_default_key(file, step));
 
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "candidate: %s, step: %lld", furi_string_get_cstr(candidate), step);
@@ -818,8 +702,8 @@ void subbrute_protocol_file_generate_file(
     FuriString* candidate = furi_string_alloc();
     // char subbrute_payload_byte[8];
     //furi_string_set_str(candidate, file_key);
-    subbrute_protocol_create_candidate_for_existing_file(
-        candidate, step, bit_index, file_key, two_bytes);
+    subbrute_protocol_create_candidate(
+        candidate, subbrute_protocol_file_key(step, bit_index, file_key, two_bytes));
 
     stream_clean(stream);
 
@@ -87,19 +87,9 @@ SubBruteFileProtocol subbrute_protocol_file_protocol_name(FuriString* name);
 uint8_t subbrute_protocol_repeats_count(SubBruteAttacks index);
 const char* subbrute_protocol_name(SubBruteAttacks index);
 
-void subbrute_protocol_default_payload(
-    Stream* stream,
-    SubBruteFileProtocol file,
-    uint64_t step,
-    uint8_t bits,
-    uint32_t te,
-    uint8_t repeat);
-void subbrute_protocol_file_payload(
-    Stream* stream,
+uint64_t subbrute_protocol_default_key(SubBruteFileProtocol file, uint64_t step);
+uint64_t subbrute_protocol_file_key(
     uint64_t step,
-    uint8_t bits,
-    uint32_t te,
-    uint8_t repeat,
     uint8_t bit_index,
     uint64_t file_key,
     bool two_bytes);
@@ -3,6 +3,7 @@
 #include <gui/gui.h>
 #include <input/input.h>
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/path.h>
 #include <furi_hal_usb_hid.h>
 #include <storage/storage.h>
 #include "ducky_script.h"
@@ -12,6 +13,8 @@
 #define TAG "BadUSB"
 #define WORKER_TAG TAG "Worker"
 
+#define BYTECODE_COMPILE_BUFFER_LEN 256
+
 #define BADUSB_ASCII_TO_KEY(script, x) \
     (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
 
@@ -46,10 +49,6 @@ uint32_t ducky_get_command_len(const char* line) {
     return 0;
 }
 
-bool ducky_is_line_end(const char chr) {
-    return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
-}
-
 uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars) {
     uint16_t keycode = ducky_get_keycode_by_name(param);
     if(keycode != HID_KEYBOARD_NONE) {
@@ -154,6 +153,10 @@ bool ducky_string(BadUsbScript* bad_usb, const char* param) {
 }
 
 static bool ducky_string_next(BadUsbScript* bad_usb) {
+    if(bad_usb->bytecode) {
+        return ducky_runner_string_next(bad_usb->runner);
+    }
+
     if(bad_usb->string_print_pos >= furi_string_size(bad_usb->string_print)) {
         return true;
     }
@@ -236,9 +239,14 @@ static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
     uint32_t line_len = 0;
 
     furi_string_reset(bad_usb->line);
+    bad_usb->script_size = 0;
+    bad_usb->script_hash = DUCKY_BYTECODE_HASH_INIT;
 
     do {
         ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
+        bad_usb->script_size += ret;
+        bad_usb->script_hash =
+            ducky_bytecode_hash(bad_usb->script_hash, bad_usb->file_buf, ret);
         for(uint16_t i = 0; i < ret; i++) {
             if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
                 bad_usb->st.line_nb++;
@@ -345,6 +353,111 @@ static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_fil
     return 0;
 }
 
+static bool ducky_script_bytecode_write(void* context, const void* data, size_t size) {
+    return storage_file_write(context, data, size) == size;
+}
+
+static size_t ducky_script_bytecode_read(void* context, void* data, size_t size) {
+    return storage_file_read(context, data, size);
+}
+
+static bool ducky_script_bytecode_seek(void* context, uint32_t offset) {
+    return storage_file_seek(context, sizeof(DuckyBytecodeHeader) + offset, true);
+}
+
+static bool
+    ducky_script_bytecode_compile(BadUsbScript* bad_usb, File* script_file, File* bytecode_file) {
+    // Header is written last, so interrupted compilation leaves invalid file
+    DuckyBytecodeHeader header = {0};
+    if(storage_file_write(bytecode_file, &header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    DuckyCompiler* compiler =
+        ducky_compiler_alloc(bad_usb->layout, ducky_script_bytecode_write, bytecode_file);
+    char* buffer = malloc(BYTECODE_COMPILE_BUFFER_LEN);
+    bool state = storage_file_seek(script_file, 0, true);
+    uint16_t ret = 0;
+    do {
+        ret = storage_file_read(script_file, buffer, BYTECODE_COMPILE_BUFFER_LEN);
+        state = state && ducky_compiler_feed(compiler, buffer, ret);
+    } while(state && (ret > 0));
+    state = state && ducky_compiler_finish(compiler, &header);
+    free(buffer);
+    ducky_compiler_free(compiler);
+    storage_file_seek(script_file, 0, true);
+
+    return state && storage_file_seek(bytecode_file, 0, true) &&
+           (storage_file_write(bytecode_file, &header, sizeof(header)) == sizeof(header));
+}
+
+/** Open compiled script next to the script, compile it if script or layout was changed */
+static bool ducky_script_bytecode_prepare(BadUsbScript* bad_usb, File* script_file) {
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    path_extract_dirname(furi_string_get_cstr(bad_usb->file_path), path);
+    path_extract_filename(bad_usb->file_path, name, false);
+    furi_string_cat_printf(path, "/.%s%s", furi_string_get_cstr(name), DUCKY_BYTECODE_EXTENSION);
+    furi_string_free(name);
+
+    File* bytecode_file = bad_usb->bytecode_file;
+    storage_file_close(bytecode_file);
+
+    bool valid = false;
+    if(storage_file_open(
+           bytecode_file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        DuckyBytecodeHeader header;
+        valid = (storage_file_read(bytecode_file, &header, sizeof(header)) == sizeof(header)) &&
+                ducky_bytecode_header_is_valid(
+                    &header, bad_usb->script_size, bad_usb->script_hash, bad_usb->layout) &&
+                (storage_file_size(bytecode_file) == sizeof(header) + header.code_size);
+        if(!valid) {
+            storage_file_close(bytecode_file);
+        }
+    }
+
+    if(!valid) {
+        FURI_LOG_I(WORKER_TAG, "Compiling %s", furi_string_get_cstr(path));
+        if(storage_file_open(
+               bytecode_file, furi_string_get_cstr(path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            valid = ducky_script_bytecode_compile(bad_usb, script_file, bytecode_file);
+            if(!valid) {
+                storage_file_close(bytecode_file);
+                Storage* storage = furi_record_open(RECORD_STORAGE);
+                storage_simply_remove(storage, furi_string_get_cstr(path));
+                furi_record_close(RECORD_STORAGE);
+            }
+        }
+    }
+
+    valid = valid && ducky_runner_reset(bad_usb->runner);
+    if(!valid) {
+        FURI_LOG_W(WORKER_TAG, "No compiled script, using line interpreter");
+    }
+    furi_string_free(path);
+    return valid;
+}
+
+static int32_t ducky_script_bytecode_execute_next(BadUsbScript* bad_usb) {
+    int32_t result = ducky_runner_execute_next(bad_usb->runner);
+    bad_usb->st.line_cur = ducky_runner_get_line(bad_usb->runner);
+
+    if(result == DUCKY_BYTECODE_RESULT_END) {
+        return SCRIPT_STATE_END;
+    } else if(result == DUCKY_BYTECODE_RESULT_STRING_START) {
+        bad_usb->stringdelay = ducky_runner_get_string_delay(bad_usb->runner);
+        return SCRIPT_STATE_STRING_START;
+    } else if(result == DUCKY_BYTECODE_RESULT_WAIT_FOR_BTN) {
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    } else if(result == DUCKY_BYTECODE_RESULT_ERROR) {
+        const char* error = ducky_runner_get_error(bad_usb->runner, &bad_usb->st.error_line);
+        strlcpy(bad_usb->st.error, error, sizeof(bad_usb->st.error));
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %u", bad_usb->st.error_line);
+        return SCRIPT_STATE_ERROR;
+    }
+    return result;
+}
+
 static void bad_usb_hid_state_callback(bool state, void* context) {
     furi_assert(context);
     BadUsbScript* bad_usb = context;
@@ -381,6 +494,9 @@ static int32_t bad_usb_worker(void* context) {
     bad_usb->line = furi_string_alloc();
     bad_usb->line_prev = furi_string_alloc();
     bad_usb->string_print = furi_string_alloc();
+    bad_usb->bytecode_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
+    bad_usb->runner = ducky_runner_alloc(
+        ducky_script_bytecode_read, ducky_script_bytecode_seek, bad_usb->bytecode_file);
 
     furi_hal_hid_set_state_callback(bad_usb_hid_state_callback, bad_usb);
 
@@ -436,6 +552,7 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->key_hold_nb = 0;
                 bad_usb->file_end = false;
                 storage_file_seek(script_file, 0, true);
+                bad_usb->bytecode = ducky_script_bytecode_prepare(bad_usb, script_file);
                 worker_state = BadUsbStateRunning;
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
@@ -458,6 +575,7 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->repeat_cnt = 0;
                 bad_usb->file_end = false;
                 storage_file_seek(script_file, 0, true);
+                bad_usb->bytecode = ducky_script_bytecode_prepare(bad_usb, script_file);
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -506,7 +624,11 @@ static int32_t bad_usb_worker(void* context) {
                     continue;
                 }
                 bad_usb->st.state = BadUsbStateRunning;
-                delay_val = ducky_script_execute_next(bad_usb, script_file);
+                if(bad_usb->bytecode) {
+                    delay_val = ducky_script_bytecode_execute_next(bad_usb);
+                } else {
+                    delay_val = ducky_script_execute_next(bad_usb, script_file);
+                }
                 if(delay_val == SCRIPT_STATE_ERROR) { // Script error
                     delay_val = 0;
                     worker_state = BadUsbStateScriptError;
@@ -519,7 +641,8 @@ static int32_t bad_usb_worker(void* context) {
                     furi_hal_hid_kb_release_all();
                     continue;
                 } else if(delay_val == SCRIPT_STATE_STRING_START) { // Start printing string with delays
-                    delay_val = bad_usb->defdelay;
+                    // Compiled script has delay after string as separate instruction
+                    delay_val = bad_usb->bytecode ? 0 : bad_usb->defdelay;
                     bad_usb->string_print_pos = 0;
                     worker_state = BadUsbStateStringDelay;
                 } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // set state to wait for user input
@@ -628,6 +751,9 @@ static int32_t bad_usb_worker(void* context) {
 
     storage_file_close(script_file);
     storage_file_free(script_file);
+    ducky_runner_free(bad_usb->runner);
+    storage_file_close(bad_usb->bytecode_file);
+    storage_file_free(bad_usb->bytecode_file);
     furi_string_free(bad_usb->line);
     furi_string_free(bad_usb->line_prev);
     furi_string_free(bad_usb->string_print);
@@ -0,0 +1,799 @@
+#include "ducky_script_bytecode.h"
+#include <core/core_defines.h>
+#include <furi_hal_usb_hid.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DUCKY_COMPILER_OUTPUT_SIZE (256U)
+#define DUCKY_COMPILER_LINE_SIZE (64U)
+#define DUCKY_COMPILER_STRING_MAX (UINT16_MAX)
+#define DUCKY_RUNNER_BUFFER_SIZE (128U)
+
+/* Same results as SCRIPT_STATE_* of line interpreter */
+#define DUCKY_COMPILER_ERROR (-1)
+#define DUCKY_COMPILER_NEXT_LINE (-3)
+#define DUCKY_COMPILER_CMD_UNKNOWN (-4)
+#define DUCKY_COMPILER_STRING_START (-5)
+#define DUCKY_COMPILER_WAIT_FOR_BTN (-6)
+
+static const uint8_t ducky_bytecode_numpad_keys[10] = {
+    HID_KEYPAD_0,
+    HID_KEYPAD_1,
+    HID_KEYPAD_2,
+    HID_KEYPAD_3,
+    HID_KEYPAD_4,
+    HID_KEYPAD_5,
+    HID_KEYPAD_6,
+    HID_KEYPAD_7,
+    HID_KEYPAD_8,
+    HID_KEYPAD_9,
+};
+
+uint32_t ducky_bytecode_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+uint32_t ducky_bytecode_layout_hash(const uint16_t* layout) {
+    return ducky_bytecode_hash(
+        DUCKY_BYTECODE_HASH_INIT, layout, DUCKY_BYTECODE_LAYOUT_SIZE * sizeof(uint16_t));
+}
+
+bool ducky_bytecode_header_is_valid(
+    const DuckyBytecodeHeader* header,
+    uint32_t script_size,
+    uint32_t script_hash,
+    const uint16_t* layout) {
+    return (header->magic == DUCKY_BYTECODE_MAGIC) &&
+           (header->version == DUCKY_BYTECODE_VERSION) && (header->script_size == script_size) &&
+           (header->script_hash == script_hash) &&
+           (header->layout_hash == ducky_bytecode_layout_hash(layout));
+}
+
+/* Compiler */
+
+typedef struct {
+    uint32_t defdelay;
+    uint32_t stringdelay;
+    uint8_t key_hold_nb;
+} DuckyCompilerState;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} DuckyCompilerBody;
+
+struct DuckyCompiler {
+    uint16_t layout[DUCKY_BYTECODE_LAYOUT_SIZE];
+    DuckyBytecodeWrite write;
+    void* context;
+
+    uint8_t output[DUCKY_COMPILER_OUTPUT_SIZE];
+    size_t output_len;
+    uint32_t code_size;
+    bool output_error;
+    DuckyCompilerBody* body;
+
+    char* line;
+    size_t line_len;
+    size_t line_size;
+    char* line_prev;
+    size_t line_prev_size;
+
+    uint16_t line_cur;
+    DuckyCompilerState state;
+    bool done;
+
+    uint32_t script_size;
+    uint32_t script_hash;
+};
+
+static void ducky_compiler_flush(DuckyCompiler* compiler) {
+    if(compiler->output_len == 0) return;
+    if(!compiler->output_error) {
+        if(!compiler->write(compiler->context, compiler->output, compiler->output_len)) {
+            compiler->output_error = true;
+        }
+    }
+    compiler->output_len = 0;
+}
+
+static void ducky_compiler_emit(DuckyCompiler* compiler, const uint8_t* data, size_t size) {
+    DuckyCompilerBody* body = compiler->body;
+    if(body) {
+        if(body->size + size > body->capacity) {
+            body->capacity = MAX(body->capacity * 2, body->size + size);
+            body->data = realloc(body->data, body->capacity); //-V701
+        }
+        memcpy(&body->data[body->size], data, size);
+        body->size += size;
+        return;
+    }
+
+    compiler->code_size += size;
+    while(size > 0) {
+        if(compiler->output_len == DUCKY_COMPILER_OUTPUT_SIZE) {
+            ducky_compiler_flush(compiler);
+        }
+        size_t chunk = MIN(size, DUCKY_COMPILER_OUTPUT_SIZE - compiler->output_len);
+        memcpy(&compiler->output[compiler->output_len], data, chunk);
+        compiler->output_len += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static void ducky_compiler_emit_op(DuckyCompiler* compiler, DuckyOp op) {
+    uint8_t data = op;
+    ducky_compiler_emit(compiler, &data, 1);
+}
+
+static void ducky_compiler_emit_u16(DuckyCompiler* compiler, uint16_t value) {
+    uint8_t data[2] = {value & 0xFF, value >> 8};
+    ducky_compiler_emit(compiler, data, sizeof(data));
+}
+
+static void ducky_compiler_emit_u32(DuckyCompiler* compiler, uint32_t value) {
+    uint8_t data[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24};
+    ducky_compiler_emit(compiler, data, sizeof(data));
+}
+
+static void ducky_compiler_emit_key(DuckyCompiler* compiler, DuckyOp op, uint16_t keycode) {
+    ducky_compiler_emit_op(compiler, op);
+    ducky_compiler_emit_u16(compiler, keycode);
+}
+
+static void ducky_compiler_emit_delay(DuckyCompiler* compiler, uint32_t delay) {
+    if(delay == 0) return;
+    ducky_compiler_emit_op(compiler, DuckyOpDelay);
+    ducky_compiler_emit_u32(compiler, delay);
+}
+
+static int32_t ducky_compiler_error(
+    DuckyCompiler* compiler,
+    uint16_t error_line,
+    const char* text,
+    const char* param) {
+    char error[DUCKY_BYTECODE_ERROR_SIZE_MAX + 1];
+    int len = snprintf(error, sizeof(error), text, param);
+    len = CLAMP(len, (int)DUCKY_BYTECODE_ERROR_SIZE_MAX, 0);
+
+    ducky_compiler_emit_op(compiler, DuckyOpError);
+    ducky_compiler_emit_u16(compiler, error_line);
+    uint8_t size = len;
+    ducky_compiler_emit(compiler, &size, 1);
+    ducky_compiler_emit(compiler, (const uint8_t*)error, size);
+    return DUCKY_COMPILER_ERROR;
+}
+
+static uint32_t ducky_compiler_command_len(const char* line) {
+    const char* space = strchr(line, ' ');
+    return space ? (space - line) : 0;
+}
+
+/* Parameter as line interpreter takes it, right after command word and space */
+static const char* ducky_compiler_param(const char* line) {
+    return &line[ducky_compiler_command_len(line) + 1];
+}
+
+static bool ducky_compiler_get_number(const char* param, uint32_t* val) {
+    char* end = NULL;
+    unsigned long value = strtoul(param, &end, 10);
+    if(end == param) return false;
+    *val = value;
+    return true;
+}
+
+static uint16_t ducky_compiler_ascii_to_key(DuckyCompiler* compiler, char chr) {
+    return ((uint8_t)chr < DUCKY_BYTECODE_LAYOUT_SIZE) ? compiler->layout[(uint8_t)chr] :
+                                                          HID_KEYBOARD_NONE;
+}
+
+static uint16_t
+    ducky_compiler_get_keycode(DuckyCompiler* compiler, const char* param, bool accept_chars) {
+    uint16_t keycode = ducky_get_keycode_by_name(param);
+    if(keycode != HID_KEYBOARD_NONE) {
+        return keycode;
+    }
+
+    if((accept_chars) && (strlen(param) > 0)) {
+        return (ducky_compiler_ascii_to_key(compiler, param[0]) & 0xFF);
+    }
+    return 0;
+}
+
+static uint16_t ducky_compiler_string_key(DuckyCompiler* compiler, char chr) {
+    return (chr == '\n') ? HID_KEYBOARD_RETURN : ducky_compiler_ascii_to_key(compiler, chr);
+}
+
+/* String keys are one byte for plain and shifted keys, bit 7 is left shift */
+static void ducky_compiler_emit_string_key(DuckyCompiler* compiler, uint16_t keycode) {
+    uint16_t mods = keycode & 0xFF00;
+    if(((keycode & 0xFF) < 0x7F) && ((mods == 0) || (mods == KEY_MOD_LEFT_SHIFT))) {
+        uint8_t data = (keycode & 0x7F) | (mods ? 0x80 : 0);
+        ducky_compiler_emit(compiler, &data, 1);
+    } else {
+        uint8_t data = DUCKY_BYTECODE_STRING_KEY_ESCAPE;
+        ducky_compiler_emit(compiler, &data, 1);
+        ducky_compiler_emit_u16(compiler, keycode);
+    }
+}
+
+static void ducky_compiler_string(DuckyCompiler* compiler, const char* param, bool newline) {
+    size_t len = strlen(param);
+    size_t pos = 0;
+    do {
+        size_t end = pos;
+        uint16_t count = 0;
+        for(; (end < len) && (count < DUCKY_COMPILER_STRING_MAX); end++) {
+            if(ducky_compiler_string_key(compiler, param[end]) != HID_KEYBOARD_NONE) count++;
+        }
+        bool last = (end == len);
+        if(last && newline && (count < DUCKY_COMPILER_STRING_MAX)) {
+            count++;
+        } else if(last && newline) {
+            last = false;
+        }
+
+        if(compiler->state.stringdelay == 0) {
+            if(count == 0) break;
+            ducky_compiler_emit_op(compiler, DuckyOpString);
+        } else {
+            ducky_compiler_emit_op(compiler, DuckyOpStringDelay);
+            ducky_compiler_emit_u32(compiler, compiler->state.stringdelay);
+        }
+        ducky_compiler_emit_u16(compiler, count);
+        for(; pos < end; pos++) {
+            uint16_t keycode = ducky_compiler_string_key(compiler, param[pos]);
+            if(keycode != HID_KEYBOARD_NONE) ducky_compiler_emit_string_key(compiler, keycode);
+        }
+        if(last && newline) {
+            ducky_compiler_emit_string_key(compiler, HID_KEYBOARD_RETURN);
+            newline = false;
+        }
+    } while((pos < len) || newline);
+}
+
+static bool ducky_compiler_altchar(DuckyCompiler* compiler, const char* charcode) {
+    bool state = false;
+
+    ducky_compiler_emit_key(compiler, DuckyOpPress, KEY_MOD_LEFT_ALT);
+    for(size_t i = 0; !ducky_is_line_end(charcode[i]); i++) {
+        state = (charcode[i] >= '0') && (charcode[i] <= '9');
+        if(!state) break;
+        ducky_compiler_emit_key(
+            compiler, DuckyOpKey, ducky_bytecode_numpad_keys[charcode[i] - '0']);
+    }
+    ducky_compiler_emit_key(compiler, DuckyOpRelease, KEY_MOD_LEFT_ALT);
+    return state;
+}
+
+static bool ducky_compiler_altstring(DuckyCompiler* compiler, const char* param) {
+    bool state = false;
+
+    for(size_t i = 0; param[i] != '\0'; i++) {
+        if(((uint8_t)param[i] < ' ') || ((uint8_t)param[i] > '~')) {
+            continue; // Skip non-printable chars
+        }
+        char temp_str[4];
+        snprintf(temp_str, sizeof(temp_str), "%u", (uint8_t)param[i]);
+        state = ducky_compiler_altchar(compiler, temp_str);
+        if(!state) break;
+    }
+    return state;
+}
+
+static bool ducky_compiler_is_cmd(const char* line, const char* name) {
+    size_t cmd_len = strcspn(line, " ");
+    return (cmd_len == strlen(name)) && (strncmp(line, name, cmd_len) == 0);
+}
+
+/** Compile one trimmed line, same results as ducky_parse_line */
+static int32_t
+    ducky_compiler_parse_line(DuckyCompiler* compiler, const char* line, uint16_t error_line) {
+    if(line[0] == '\0') {
+        return DUCKY_COMPILER_NEXT_LINE;
+    }
+
+    const char* param = ducky_compiler_param(line);
+    if(ducky_compiler_is_cmd(line, "REM") || ducky_compiler_is_cmd(line, "ID")) {
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "DELAY")) {
+        uint32_t delay_val = 0;
+        if(ducky_compiler_get_number(param, &delay_val) && (delay_val > 0) &&
+           (delay_val <= INT32_MAX)) {
+            return delay_val;
+        }
+        return ducky_compiler_error(compiler, error_line, "Invalid number %s", param);
+    } else if(ducky_compiler_is_cmd(line, "STRING") || ducky_compiler_is_cmd(line, "STRINGLN")) {
+        ducky_compiler_string(compiler, param, ducky_compiler_is_cmd(line, "STRINGLN"));
+        if(compiler->state.stringdelay != 0) {
+            compiler->state.stringdelay = 0;
+            return DUCKY_COMPILER_STRING_START;
+        }
+        return 0;
+    } else if(
+        ducky_compiler_is_cmd(line, "DEFAULT_DELAY") ||
+        ducky_compiler_is_cmd(line, "DEFAULTDELAY")) {
+        if(!ducky_compiler_get_number(param, &compiler->state.defdelay)) {
+            return ducky_compiler_error(compiler, error_line, "Invalid number %s", param);
+        }
+        return 0;
+    } else if(
+        ducky_compiler_is_cmd(line, "STRINGDELAY") ||
+        ducky_compiler_is_cmd(line, "STRING_DELAY")) {
+        if(!ducky_compiler_get_number(param, &compiler->state.stringdelay)) {
+            return ducky_compiler_error(compiler, error_line, "Invalid number %s", param);
+        }
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "SYSRQ")) {
+        uint16_t key = ducky_compiler_get_keycode(compiler, param, true);
+        ducky_compiler_emit_key(
+            compiler, DuckyOpPress, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        ducky_compiler_emit_key(compiler, DuckyOpPress, key);
+        ducky_compiler_emit_op(compiler, DuckyOpReleaseAll);
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "ALTCHAR")) {
+        ducky_compiler_emit_op(compiler, DuckyOpNumlockOn);
+        if(!ducky_compiler_altchar(compiler, param)) {
+            return ducky_compiler_error(compiler, error_line, "Invalid altchar %s", param);
+        }
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "ALTSTRING") || ducky_compiler_is_cmd(line, "ALTCODE")) {
+        ducky_compiler_emit_op(compiler, DuckyOpNumlockOn);
+        if(!ducky_compiler_altstring(compiler, param)) {
+            return ducky_compiler_error(compiler, error_line, "Invalid altstring %s", param);
+        }
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "HOLD")) {
+        uint16_t key = ducky_compiler_get_keycode(compiler, param, true);
+        if(key == HID_KEYBOARD_NONE) {
+            return ducky_compiler_error(compiler, error_line, "No keycode defined for %s", param);
+        }
+        compiler->state.key_hold_nb++;
+        if(compiler->state.key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+            return ducky_compiler_error(compiler, error_line, "Too many keys are hold", NULL);
+        }
+        ducky_compiler_emit_key(compiler, DuckyOpPress, key);
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "RELEASE")) {
+        uint16_t key = ducky_compiler_get_keycode(compiler, param, true);
+        if(key == HID_KEYBOARD_NONE) {
+            return ducky_compiler_error(compiler, error_line, "No keycode defined for %s", param);
+        }
+        if(compiler->state.key_hold_nb == 0) {
+            return ducky_compiler_error(compiler, error_line, "No keys are hold", NULL);
+        }
+        compiler->state.key_hold_nb--;
+        ducky_compiler_emit_key(compiler, DuckyOpRelease, key);
+        return 0;
+    } else if(ducky_compiler_is_cmd(line, "WAIT_FOR_BUTTON_PRESS")) {
+        return DUCKY_COMPILER_WAIT_FOR_BTN;
+    } else if(ducky_compiler_is_cmd(line, "REPEAT")) {
+        // Only handled at top level by ducky_compiler_repeat
+        return DUCKY_COMPILER_CMD_UNKNOWN;
+    }
+
+    // Special keys + modifiers
+    uint16_t key = ducky_compiler_get_keycode(compiler, line, false);
+    if(key == HID_KEYBOARD_NONE) {
+        return ducky_compiler_error(compiler, error_line, "No keycode defined for %s", line);
+    }
+    if((key & 0xFF00) != 0) {
+        // It's a modifier key
+        key |= ducky_compiler_get_keycode(compiler, param, true);
+    }
+    ducky_compiler_emit_key(compiler, DuckyOpKey, key);
+    return 0;
+}
+
+/** Compile line and delay after it, as ducky_script_execute_next returns it
+ *
+ * @return     false on script error
+ */
+static bool
+    ducky_compiler_compile_line(DuckyCompiler* compiler, const char* line, uint16_t error_line) {
+    int32_t result = ducky_compiler_parse_line(compiler, line, error_line);
+    if(result == DUCKY_COMPILER_ERROR) {
+        return false;
+    } else if(result == DUCKY_COMPILER_WAIT_FOR_BTN) {
+        ducky_compiler_emit_op(compiler, DuckyOpWaitButton);
+    } else if(result == DUCKY_COMPILER_STRING_START) {
+        ducky_compiler_emit_delay(compiler, compiler->state.defdelay);
+    } else if(result >= 0) {
+        uint64_t delay = (uint64_t)result + compiler->state.defdelay;
+        ducky_compiler_emit_delay(compiler, MIN(delay, (uint64_t)INT32_MAX));
+    }
+    return true;
+}
+
+static bool ducky_compiler_state_equal(const DuckyCompilerState* a, const DuckyCompilerState* b) {
+    return (a->defdelay == b->defdelay) && (a->stringdelay == b->stringdelay) &&
+           (a->key_hold_nb == b->key_hold_nb);
+}
+
+/** REPEAT executes previous line again, with state left by previous run.
+ * Iterations that change state (HOLD, STRINGDELAY) are unrolled, rest is
+ * a single repeat instruction.
+ */
+static bool ducky_compiler_repeat(DuckyCompiler* compiler, const char* line) {
+    const char* param = ducky_compiler_param(line);
+    uint32_t repeat_cnt = 0;
+    if(!ducky_compiler_get_number(param, &repeat_cnt) || (repeat_cnt == 0)) {
+        ducky_compiler_error(compiler, compiler->line_cur, "Invalid number %s", param);
+        return false;
+    }
+    ducky_compiler_emit_delay(compiler, compiler->state.defdelay);
+
+    const char* prev = compiler->line_prev ? compiler->line_prev : "";
+    if(ducky_compiler_is_cmd(prev, "REPEAT")) {
+        // Interpreter would repeat it forever
+        ducky_compiler_error(compiler, compiler->line_cur, "Nested REPEAT %s", param);
+        return false;
+    }
+
+    DuckyCompilerBody body = {0};
+    bool state = true;
+    while(repeat_cnt > 0) {
+        DuckyCompilerState state_prev = compiler->state;
+        body.size = 0;
+        compiler->body = &body;
+        state = ducky_compiler_compile_line(compiler, prev, compiler->line_cur - 1);
+        compiler->body = NULL;
+        if(body.size == 0) break;
+
+        if(state && (repeat_cnt > 1) &&
+           ducky_compiler_state_equal(&state_prev, &compiler->state)) {
+            ducky_compiler_emit_op(compiler, DuckyOpRepeat);
+            ducky_compiler_emit_u32(compiler, repeat_cnt);
+            ducky_compiler_emit_u32(compiler, body.size);
+            repeat_cnt = 1;
+        }
+        ducky_compiler_emit(compiler, body.data, body.size);
+        if(!state) break;
+        repeat_cnt--;
+    }
+    free(body.data);
+    return state;
+}
+
+static void ducky_compiler_line_end(DuckyCompiler* compiler) {
+    compiler->line_cur++;
+
+    // Trim as furi_string_trim does
+    char* line = compiler->line;
+    size_t len = compiler->line_len;
+    while((len > 0) && strchr(" \r\n\t", line[len - 1]) && (line[len - 1] != '\0')) len--;
+    line[len] = '\0';
+    size_t start = strspn(line, " \r\n\t");
+    memmove(line, &line[start], len - start + 1);
+
+    ducky_compiler_emit_key(compiler, DuckyOpLine, compiler->line_cur);
+
+    bool state = true;
+    if(ducky_compiler_is_cmd(line, "REPEAT")) {
+        state = ducky_compiler_repeat(compiler, line);
+    } else {
+        state = ducky_compiler_compile_line(compiler, line, compiler->line_cur);
+    }
+    if(!state) {
+        compiler->done = true;
+    }
+
+    // Current line is previous one for REPEAT
+    char* line_prev = compiler->line_prev;
+    size_t line_prev_size = compiler->line_prev_size;
+    compiler->line_prev = compiler->line;
+    compiler->line_prev_size = compiler->line_size;
+    compiler->line = line_prev;
+    compiler->line_size = line_prev_size;
+    compiler->line_len = 0;
+}
+
+static void ducky_compiler_push_back(DuckyCompiler* compiler, char chr) {
+    if(compiler->line_len + 2 > compiler->line_size) {
+        compiler->line_size = MAX(compiler->line_size * 2, DUCKY_COMPILER_LINE_SIZE);
+        compiler->line = realloc(compiler->line, compiler->line_size); //-V701
+    }
+    compiler->line[compiler->line_len++] = chr;
+    compiler->line[compiler->line_len] = '\0';
+}
+
+DuckyCompiler*
+    ducky_compiler_alloc(const uint16_t* layout, DuckyBytecodeWrite write, void* context) {
+    DuckyCompiler* compiler = malloc(sizeof(DuckyCompiler));
+    memset(compiler, 0, sizeof(DuckyCompiler));
+    memcpy(compiler->layout, layout, sizeof(compiler->layout));
+    compiler->write = write;
+    compiler->context = context;
+    compiler->script_hash = DUCKY_BYTECODE_HASH_INIT;
+    return compiler;
+}
+
+void ducky_compiler_free(DuckyCompiler* compiler) {
+    free(compiler->line);
+    free(compiler->line_prev);
+    free(compiler);
+}
+
+bool ducky_compiler_feed(DuckyCompiler* compiler, const char* data, size_t size) {
+    compiler->script_size += size;
+    compiler->script_hash = ducky_bytecode_hash(compiler->script_hash, data, size);
+
+    for(size_t i = 0; (i < size) && !compiler->done; i++) {
+        // Empty lines are glued to the next one, as ducky_script_execute_next does
+        if((data[i] == '\n') && (compiler->line_len > 0)) {
+            ducky_compiler_line_end(compiler);
+        } else {
+            ducky_compiler_push_back(compiler, data[i]);
+        }
+    }
+    return !compiler->output_error;
+}
+
+bool ducky_compiler_finish(DuckyCompiler* compiler, DuckyBytecodeHeader* header) {
+    // Interpreter adds line end to the last line
+    if(!compiler->done && (compiler->line_len > 0)) {
+        ducky_compiler_line_end(compiler);
+    }
+    ducky_compiler_emit_op(compiler, DuckyOpEnd);
+    ducky_compiler_flush(compiler);
+
+    memset(header, 0, sizeof(DuckyBytecodeHeader));
+    header->magic = DUCKY_BYTECODE_MAGIC;
+    header->version = DUCKY_BYTECODE_VERSION;
+    header->line_nb = compiler->line_cur;
+    header->script_size = compiler->script_size;
+    header->script_hash = compiler->script_hash;
+    header->layout_hash = ducky_bytecode_layout_hash(compiler->layout);
+    header->code_size = compiler->code_size;
+    return !compiler->output_error;
+}
+
+/* Runner */
+
+struct DuckyRunner {
+    DuckyBytecodeRead read;
+    DuckyBytecodeSeek seek;
+    void* context;
+
+    uint8_t buffer[DUCKY_RUNNER_BUFFER_SIZE];
+    size_t buffer_pos;
+    size_t buffer_len;
+    uint32_t buffer_offset;
+
+    uint16_t line;
+    uint32_t repeat_cnt;
+    uint32_t repeat_start;
+    uint32_t repeat_end;
+    uint16_t string_left;
+    uint32_t string_delay;
+
+    uint16_t error_line;
+    char error[DUCKY_BYTECODE_ERROR_SIZE_MAX + 1];
+};
+
+static const uint8_t ducky_runner_operand_size[] = {
+    [DuckyOpLine] = 2,
+    [DuckyOpKey] = 2,
+    [DuckyOpPress] = 2,
+    [DuckyOpRelease] = 2,
+    [DuckyOpReleaseAll] = 0,
+    [DuckyOpNumlockOn] = 0,
+    [DuckyOpDelay] = 4,
+    [DuckyOpString] = 2,
+    [DuckyOpStringDelay] = 6,
+    [DuckyOpWaitButton] = 0,
+    [DuckyOpRepeat] = 8,
+    [DuckyOpError] = 3,
+    [DuckyOpEnd] = 0,
+};
+
+static bool ducky_runner_fill(DuckyRunner* runner, size_t size) {
+    if(runner->buffer_len - runner->buffer_pos >= size) return true;
+
+    runner->buffer_len -= runner->buffer_pos;
+    memmove(runner->buffer, &runner->buffer[runner->buffer_pos], runner->buffer_len);
+    runner->buffer_offset += runner->buffer_pos;
+    runner->buffer_pos = 0;
+
+    while(runner->buffer_len < size) {
+        size_t ret = runner->read(
+            runner->context,
+            &runner->buffer[runner->buffer_len],
+            DUCKY_RUNNER_BUFFER_SIZE - runner->buffer_len);
+        if(ret == 0) return false;
+        runner->buffer_len += ret;
+    }
+    return true;
+}
+
+static uint32_t ducky_runner_get_offset(DuckyRunner* runner) {
+    return runner->buffer_offset + runner->buffer_pos;
+}
+
+static bool ducky_runner_set_offset(DuckyRunner* runner, uint32_t offset) {
+    if((offset >= runner->buffer_offset) &&
+       (offset <= runner->buffer_offset + runner->buffer_len)) {
+        runner->buffer_pos = offset - runner->buffer_offset;
+        return true;
+    }
+    runner->buffer_offset = offset;
+    runner->buffer_pos = 0;
+    runner->buffer_len = 0;
+    return runner->seek(runner->context, offset);
+}
+
+static uint16_t ducky_runner_read_u16(DuckyRunner* runner) {
+    const uint8_t* data = &runner->buffer[runner->buffer_pos];
+    runner->buffer_pos += 2;
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t ducky_runner_read_u32(DuckyRunner* runner) {
+    const uint8_t* data = &runner->buffer[runner->buffer_pos];
+    runner->buffer_pos += 4;
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static int32_t ducky_runner_error(DuckyRunner* runner, const char* text) {
+    runner->error_line = runner->line;
+    snprintf(runner->error, sizeof(runner->error), "%s", text);
+    return DUCKY_BYTECODE_RESULT_ERROR;
+}
+
+static bool ducky_runner_string_key(DuckyRunner* runner, uint16_t* keycode) {
+    if(!ducky_runner_fill(runner, 1)) return false;
+    uint8_t data = runner->buffer[runner->buffer_pos++];
+    if(data != DUCKY_BYTECODE_STRING_KEY_ESCAPE) {
+        *keycode = (data & 0x7F) | ((data & 0x80) ? KEY_MOD_LEFT_SHIFT : 0);
+        return true;
+    }
+    if(!ducky_runner_fill(runner, 2)) return false;
+    *keycode = ducky_runner_read_u16(runner);
+    return true;
+}
+
+DuckyRunner* ducky_runner_alloc(DuckyBytecodeRead read, DuckyBytecodeSeek seek, void* context) {
+    DuckyRunner* runner = malloc(sizeof(DuckyRunner));
+    memset(runner, 0, sizeof(DuckyRunner));
+    runner->read = read;
+    runner->seek = seek;
+    runner->context = context;
+    return runner;
+}
+
+void ducky_runner_free(DuckyRunner* runner) {
+    free(runner);
+}
+
+bool ducky_runner_reset(DuckyRunner* runner) {
+    runner->line = 0;
+    runner->repeat_cnt = 0;
+    runner->string_left = 0;
+    runner->string_delay = 0;
+    runner->error[0] = '\0';
+    runner->buffer_offset = 0;
+    runner->buffer_pos = 0;
+    runner->buffer_len = 0;
+    return runner->seek(runner->context, 0);
+}
+
+int32_t ducky_runner_execute_next(DuckyRunner* runner) {
+    bool executed = false;
+
+    while(1) {
+        if(runner->repeat_cnt && (ducky_runner_get_offset(runner) == runner->repeat_end)) {
+            runner->repeat_cnt--;
+            if(runner->repeat_cnt > 0) {
+                if(!ducky_runner_set_offset(runner, runner->repeat_start)) {
+                    return ducky_runner_error(runner, "Bytecode read error");
+                }
+                if(executed) return 0; // One iteration per call, as interpreter does
+            }
+        }
+
+        if(!ducky_runner_fill(runner, 1)) {
+            return ducky_runner_error(runner, "Bytecode read error");
+        }
+        uint8_t op = runner->buffer[runner->buffer_pos];
+        if((op < DuckyOpLine) || (op > DuckyOpEnd)) {
+            return ducky_runner_error(runner, "Bytecode is corrupted");
+        }
+        if((op == DuckyOpLine) && executed) {
+            return 0; // Next line on next call
+        }
+        if(!ducky_runner_fill(runner, 1 + ducky_runner_operand_size[op])) {
+            return ducky_runner_error(runner, "Bytecode read error");
+        }
+        runner->buffer_pos++;
+        executed = true;
+
+        if(op == DuckyOpLine) {
+            runner->line = ducky_runner_read_u16(runner);
+        } else if(op == DuckyOpKey) {
+            uint16_t key = ducky_runner_read_u16(runner);
+            furi_hal_hid_kb_press(key);
+            furi_hal_hid_kb_release(key);
+        } else if(op == DuckyOpPress) {
+            furi_hal_hid_kb_press(ducky_runner_read_u16(runner));
+        } else if(op == DuckyOpRelease) {
+            furi_hal_hid_kb_release(ducky_runner_read_u16(runner));
+        } else if(op == DuckyOpReleaseAll) {
+            furi_hal_hid_kb_release_all();
+        } else if(op == DuckyOpNumlockOn) {
+            if((furi_hal_hid_get_led_state() & HID_KB_LED_NUM) == 0) {
+                furi_hal_hid_kb_press(HID_KEYBOARD_LOCK_NUM_LOCK);
+                furi_hal_hid_kb_release(HID_KEYBOARD_LOCK_NUM_LOCK);
+            }
+        } else if(op == DuckyOpDelay) {
+            return MIN(ducky_runner_read_u32(runner), (uint32_t)INT32_MAX);
+        } else if(op == DuckyOpString) {
+            uint16_t count = ducky_runner_read_u16(runner);
+            for(uint16_t i = 0; i < count; i++) {
+                uint16_t key = 0;
+                if(!ducky_runner_string_key(runner, &key)) {
+                    return ducky_runner_error(runner, "Bytecode read error");
+                }
+                furi_hal_hid_kb_press(key);
+                furi_hal_hid_kb_release(key);
+            }
+        } else if(op == DuckyOpStringDelay) {
+            runner->string_delay = ducky_runner_read_u32(runner);
+            runner->string_left = ducky_runner_read_u16(runner);
+            return DUCKY_BYTECODE_RESULT_STRING_START;
+        } else if(op == DuckyOpWaitButton) {
+            return DUCKY_BYTECODE_RESULT_WAIT_FOR_BTN;
+        } else if(op == DuckyOpRepeat) {
+            uint32_t count = ducky_runner_read_u32(runner);
+            uint32_t size = ducky_runner_read_u32(runner);
+            runner->repeat_start = ducky_runner_get_offset(runner);
+            runner->repeat_end = runner->repeat_start + size;
+            runner->repeat_cnt = (size > 0) ? count : 0;
+        } else if(op == DuckyOpError) {
+            runner->error_line = ducky_runner_read_u16(runner);
+            uint8_t size = runner->buffer[runner->buffer_pos++];
+            if(!ducky_runner_fill(runner, size)) {
+                return ducky_runner_error(runner, "Bytecode read error");
+            }
+            memcpy(runner->error, &runner->buffer[runner->buffer_pos], size);
+            runner->error[size] = '\0';
+            runner->buffer_pos += size;
+            return DUCKY_BYTECODE_RESULT_ERROR;
+        } else if(op == DuckyOpEnd) {
+            runner->buffer_pos--; // Stay at the end
+            return DUCKY_BYTECODE_RESULT_END;
+        }
+    }
+}
+
+bool ducky_runner_string_next(DuckyRunner* runner) {
+    uint16_t key = 0;
+    if((runner->string_left == 0) || !ducky_runner_string_key(runner, &key)) {
+        return true;
+    }
+    runner->string_left--;
+
+    furi_hal_hid_kb_press(key);
+    furi_hal_hid_kb_release(key);
+    return false;
+}
+
+uint32_t ducky_runner_get_string_delay(DuckyRunner* runner) {
+    return runner->string_delay;
+}
+
+uint16_t ducky_runner_get_line(DuckyRunner* runner) {
+    return runner->line;
+}
+
+const char* ducky_runner_get_error(DuckyRunner* runner, uint16_t* line) {
+    if(line) *line = runner->error_line;
+    return runner->error;
+}
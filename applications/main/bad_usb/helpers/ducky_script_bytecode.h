@@ -0,0 +1,263 @@
+/**
+ * @file ducky_script_bytecode.h
+ * Bad USB: precompiled script bytecode
+ *
+ * Script is compiled once per content and keyboard layout into a stream of
+ * resolved keycodes, delays and string spans, so worker doesn't parse text
+ * while typing. Compiler follows line interpreter in ducky_script.c
+ * command by command, including error messages, and resolves everything
+ * that interpreter keeps as state (default and string delays, held keys)
+ * at compile time. Script errors become error instructions at the line
+ * where interpreter would stop.
+ *
+ * Artifact is DuckyBytecodeHeader followed by code_size bytes of
+ * instructions, little endian operands:
+ *
+ *   Line      u16 line              start of script line
+ *   Key       u16 keycode           press and release
+ *   Press     u16 keycode
+ *   Release   u16 keycode
+ *   ReleaseAll
+ *   NumlockOn                       press NumLock if it is off
+ *   Delay     u32 ms
+ *   String    u16 count, count * key
+ *   StringDelay u32 ms, u16 count, count * key
+ *   WaitButton
+ *   Repeat    u32 count, u32 size   run next size bytes count times
+ *   Error     u16 line, u8 size, size chars
+ *   End
+ *
+ * String key is one byte: keycode in bits 0-6 and left shift in bit 7,
+ * other keycodes are DUCKY_BYTECODE_STRING_KEY_ESCAPE followed by u16.
+ *
+ * Compiler and runner only use libc and HID keyboard API, host builds
+ * provide HID functions.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DUCKY_BYTECODE_MAGIC (0x31434442UL) /**< "BDC1" */
+#define DUCKY_BYTECODE_VERSION (1U)
+#define DUCKY_BYTECODE_EXTENSION ".bdc"
+
+#define DUCKY_BYTECODE_LAYOUT_SIZE (128U)
+#define DUCKY_BYTECODE_ERROR_SIZE_MAX (63U)
+#define DUCKY_BYTECODE_STRING_KEY_ESCAPE (0xFFU)
+
+typedef enum {
+    DuckyOpLine = 0x01,
+    DuckyOpKey,
+    DuckyOpPress,
+    DuckyOpRelease,
+    DuckyOpReleaseAll,
+    DuckyOpNumlockOn,
+    DuckyOpDelay,
+    DuckyOpString,
+    DuckyOpStringDelay,
+    DuckyOpWaitButton,
+    DuckyOpRepeat,
+    DuckyOpError,
+    DuckyOpEnd,
+} DuckyOp;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t line_nb;
+    uint32_t script_size;
+    uint32_t script_hash;
+    uint32_t layout_hash;
+    uint32_t code_size;
+} __attribute__((packed)) DuckyBytecodeHeader;
+
+#define DUCKY_BYTECODE_HASH_INIT (2166136261UL)
+
+/** FNV-1a hash, start with DUCKY_BYTECODE_HASH_INIT
+ *
+ * @param      hash  Hash of previous data
+ * @param      data  Data
+ * @param      size  Data size
+ *
+ * @return     hash of previous data and data
+ */
+uint32_t ducky_bytecode_hash(uint32_t hash, const void* data, size_t size);
+
+/** Hash of keyboard layout table
+ *
+ * @param      layout  ASCII to keycode table, DUCKY_BYTECODE_LAYOUT_SIZE entries
+ *
+ * @return     hash
+ */
+uint32_t ducky_bytecode_layout_hash(const uint16_t* layout);
+
+/** Check artifact header against script and layout
+ *
+ * @param      header       Header read from artifact
+ * @param      script_size  Script size
+ * @param      script_hash  Script hash
+ * @param      layout       Current keyboard layout
+ *
+ * @return     true if artifact can be used
+ */
+bool ducky_bytecode_header_is_valid(
+    const DuckyBytecodeHeader* header,
+    uint32_t script_size,
+    uint32_t script_hash,
+    const uint16_t* layout);
+
+/** Check for end of command word or parameter
+ *
+ * @param      chr   Character
+ *
+ * @return     true for space, line end or string end
+ */
+bool ducky_is_line_end(const char chr);
+
+/** Find named key or modifier, shared with line interpreter
+ *
+ * @param      param  Text starting with key name
+ *
+ * @return     keycode with modifiers, HID_KEYBOARD_NONE if not found
+ */
+uint16_t ducky_get_keycode_by_name(const char* param);
+
+/** Compiled code output
+ *
+ * @return     true if all data is written
+ */
+typedef bool (*DuckyBytecodeWrite)(void* context, const void* data, size_t size);
+
+typedef struct DuckyCompiler DuckyCompiler;
+
+/** Allocate compiler
+ *
+ * @param      layout   ASCII to keycode table, copied
+ * @param      write    Output for instructions, header is not written
+ * @param      context  Output context
+ *
+ * @return     DuckyCompiler instance
+ */
+DuckyCompiler*
+    ducky_compiler_alloc(const uint16_t* layout, DuckyBytecodeWrite write, void* context);
+
+/** Free compiler
+ *
+ * @param      compiler  DuckyCompiler instance
+ */
+void ducky_compiler_free(DuckyCompiler* compiler);
+
+/** Compile next part of script text, lines may span calls
+ *
+ * @param      compiler  DuckyCompiler instance
+ * @param      data      Script text
+ * @param      size      Text size
+ *
+ * @return     false on output error
+ */
+bool ducky_compiler_feed(DuckyCompiler* compiler, const char* data, size_t size);
+
+/** Compile last line and fill header
+ *
+ * @param      compiler  DuckyCompiler instance
+ * @param      header    Header for artifact
+ *
+ * @return     false on output error
+ */
+bool ducky_compiler_finish(DuckyCompiler* compiler, DuckyBytecodeHeader* header);
+
+/** Runner results, non negative results are delays in ms */
+#define DUCKY_BYTECODE_RESULT_END (-1)
+#define DUCKY_BYTECODE_RESULT_ERROR (-2)
+#define DUCKY_BYTECODE_RESULT_STRING_START (-3)
+#define DUCKY_BYTECODE_RESULT_WAIT_FOR_BTN (-4)
+
+/** Compiled code input
+ *
+ * @return     bytes read
+ */
+typedef size_t (*DuckyBytecodeRead)(void* context, void* data, size_t size);
+
+/** Compiled code seek, offset is relative to code start
+ *
+ * @return     true on success
+ */
+typedef bool (*DuckyBytecodeSeek)(void* context, uint32_t offset);
+
+typedef struct DuckyRunner DuckyRunner;
+
+/** Allocate runner
+ *
+ * @param      read     Code input, positioned at code start
+ * @param      seek     Code seek
+ * @param      context  Input context
+ *
+ * @return     DuckyRunner instance
+ */
+DuckyRunner* ducky_runner_alloc(DuckyBytecodeRead read, DuckyBytecodeSeek seek, void* context);
+
+/** Free runner
+ *
+ * @param      runner  DuckyRunner instance
+ */
+void ducky_runner_free(DuckyRunner* runner);
+
+/** Rewind to code start
+ *
+ * @param      runner  DuckyRunner instance
+ *
+ * @return     false on input error
+ */
+bool ducky_runner_reset(DuckyRunner* runner);
+
+/** Execute instructions up to next delay, string with delays, button wait
+ * or start of next line
+ *
+ * @param      runner  DuckyRunner instance
+ *
+ * @return     delay in ms or DUCKY_BYTECODE_RESULT_*
+ */
+int32_t ducky_runner_execute_next(DuckyRunner* runner);
+
+/** Type next character of string started with DUCKY_BYTECODE_RESULT_STRING_START
+ *
+ * @param      runner  DuckyRunner instance
+ *
+ * @return     true if string is done
+ */
+bool ducky_runner_string_next(DuckyRunner* runner);
+
+/** Get delay between characters of current string
+ *
+ * @param      runner  DuckyRunner instance
+ *
+ * @return     delay in ms
+ */
+uint32_t ducky_runner_get_string_delay(DuckyRunner* runner);
+
+/** Get current script line
+ *
+ * @param      runner  DuckyRunner instance
+ *
+ * @return     line number, starting with 1
+ */
+uint16_t ducky_runner_get_line(DuckyRunner* runner);
+
+/** Get error after DUCKY_BYTECODE_RESULT_ERROR
+ *
+ * @param      runner  DuckyRunner instance
+ * @param      line    Error line
+ *
+ * @return     error text
+ */
+const char* ducky_runner_get_error(DuckyRunner* runner, uint16_t* line);
+
+#ifdef __cplusplus
+}
+#endif
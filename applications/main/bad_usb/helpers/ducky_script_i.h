@@ -6,7 +6,9 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <storage/storage.h>
 #include "ducky_script.h"
+#include "ducky_script_bytecode.h"
 
 #define SCRIPT_STATE_ERROR (-1)
 #define SCRIPT_STATE_END (-2)
@@ -39,16 +41,18 @@ struct BadUsbScript {
 
     FuriString* string_print;
     size_t string_print_pos;
+
+    uint32_t script_size;
+    uint32_t script_hash;
+    File* bytecode_file;
+    DuckyRunner* runner;
+    bool bytecode;
 };
 
 uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars);
 
 uint32_t ducky_get_command_len(const char* line);
 
-bool ducky_is_line_end(const char chr);
-
-uint16_t ducky_get_keycode_by_name(const char* param);
-
 bool ducky_get_number(const char* param, uint32_t* val);
 
 void ducky_numlock_on(void);
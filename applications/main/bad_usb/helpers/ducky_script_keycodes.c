@@ -1,6 +1,7 @@
-#include <furi_hal.h>
+#include "ducky_script_bytecode.h"
+#include <core/core_defines.h>
 #include <furi_hal_usb_hid.h>
-#include "ducky_script_i.h"
+#include <string.h>
 
 typedef struct {
     char* name;
@@ -66,6 +67,10 @@ static const DuckyKey ducky_keys[] = {
     {"F12", HID_KEYBOARD_F12},
 };
 
+bool ducky_is_line_end(const char chr) {
+    return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
+}
+
 uint16_t ducky_get_keycode_by_name(const char* param) {
     for(size_t i = 0; i < COUNT_OF(ducky_keys); i++) {
         size_t key_cmd_len = strlen(ducky_keys[i].name);
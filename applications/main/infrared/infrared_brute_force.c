@@ -3,8 +3,20 @@
 #include <stdlib.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <infrared_worker.h>
+#include <storage/storage.h>
+#include <toolbox/path.h>
 
 #include "infrared_signal.h"
+#include "infrared_library.h"
+
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_COMPILE_BUFFER_SIZE (512U)
+
+_Static_assert(
+    INFRARED_LIBRARY_TIMINGS_MAX == MAX_TIMINGS_AMOUNT,
+    "Compiled library has to accept same raw signals as infrared_signal_read()");
 
 typedef struct {
     uint32_t index;
@@ -25,6 +37,15 @@ struct InfraredBruteForce {
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
     bool is_started;
+
+    File* library_file;
+    InfraredLibrary* library;
+    InfraredLibrarySweep* sweep;
+    InfraredWorker* worker;
+    uint32_t* timings;
+    uint32_t repeats_left;
+    bool signal_pending;
+    volatile uint32_t progress;
 };
 
 InfraredBruteForce* infrared_brute_force_alloc() {
@@ -38,8 +59,21 @@ InfraredBruteForce* infrared_brute_force_alloc() {
     return brute_force;
 }
 
+static void infrared_brute_force_close_library(InfraredBruteForce* brute_force) {
+    if(brute_force->library) {
+        infrared_library_free(brute_force->library);
+        brute_force->library = NULL;
+    }
+    if(brute_force->library_file) {
+        storage_file_free(brute_force->library_file);
+        brute_force->library_file = NULL;
+        furi_record_close(RECORD_STORAGE);
+    }
+}
+
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_close_library(brute_force);
     InfraredBruteForceRecordDict_clear(brute_force->records);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
@@ -50,33 +84,212 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
+static bool infrared_brute_force_library_write(void* context, const void* data, size_t size) {
+    return storage_file_write(context, data, size) == size;
+}
+
+static size_t infrared_brute_force_library_read(void* context, void* data, size_t size) {
+    return storage_file_read(context, data, size);
+}
+
+static bool infrared_brute_force_library_seek(void* context, uint32_t offset) {
+    return storage_file_seek(context, offset, true);
+}
+
+static bool infrared_brute_force_compile(File* db_file, File* library_file) {
+    // Header is written last, so interrupted compilation leaves invalid file
+    InfraredLibraryHeader header = {0};
+    if(storage_file_write(library_file, &header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    InfraredLibraryCompiler* compiler =
+        infrared_library_compiler_alloc(infrared_brute_force_library_write, library_file);
+    char* buffer = malloc(INFRARED_BRUTE_FORCE_COMPILE_BUFFER_SIZE);
+    bool state = storage_file_seek(db_file, 0, true);
+    size_t ret = 0;
+    do {
+        ret = storage_file_read(db_file, buffer, INFRARED_BRUTE_FORCE_COMPILE_BUFFER_SIZE);
+        state = state && infrared_library_compiler_feed(compiler, buffer, ret);
+    } while(state && (ret > 0));
+    state = state && infrared_library_compiler_finish(compiler, &header);
+    free(buffer);
+    infrared_library_compiler_free(compiler);
+
+    return state && storage_file_seek(library_file, 0, true) &&
+           (storage_file_write(library_file, &header, sizeof(header)) == sizeof(header));
+}
+
+/** Open compiled library next to the database, compile it if database was changed */
+static bool infrared_brute_force_open_library(InfraredBruteForce* brute_force) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* db_file = storage_file_alloc(storage);
+    File* library_file = storage_file_alloc(storage);
+    brute_force->library_file = library_file;
+
+    uint32_t source_size = 0;
+    uint32_t source_hash = INFRARED_LIBRARY_HASH_INIT;
+    bool success =
+        storage_file_open(db_file, brute_force->db_filename, FSAM_READ, FSOM_OPEN_EXISTING);
+    if(success) {
+        char* buffer = malloc(INFRARED_BRUTE_FORCE_COMPILE_BUFFER_SIZE);
+        size_t ret = 0;
+        do {
+            ret = storage_file_read(db_file, buffer, INFRARED_BRUTE_FORCE_COMPILE_BUFFER_SIZE);
+            source_size += ret;
+            source_hash = infrared_library_hash(source_hash, buffer, ret);
+        } while(ret > 0);
+        free(buffer);
+    }
+
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    path_extract_dirname(brute_force->db_filename, path);
+    path_extract_filename_no_ext(brute_force->db_filename, name);
+    furi_string_cat_printf(
+        path, "/.%s.ir%s", furi_string_get_cstr(name), INFRARED_LIBRARY_EXTENSION);
+    furi_string_free(name);
+
+    InfraredLibraryHeader header;
+    bool valid = false;
+    if(success && storage_file_open(
+                      library_file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        valid = (storage_file_read(library_file, &header, sizeof(header)) == sizeof(header)) &&
+                infrared_library_header_is_valid(&header, source_size, source_hash) &&
+                (storage_file_size(library_file) == header.index_offset + header.index_size);
+        if(!valid) {
+            storage_file_close(library_file);
+        }
+    }
+
+    if(success && !valid) {
+        FURI_LOG_I(TAG, "Compiling %s", furi_string_get_cstr(path));
+        if(storage_file_open(
+               library_file, furi_string_get_cstr(path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            valid = infrared_brute_force_compile(db_file, library_file) &&
+                    storage_file_seek(library_file, 0, true) &&
+                    (storage_file_read(library_file, &header, sizeof(header)) ==
+                     sizeof(header)) &&
+                    infrared_library_header_is_valid(&header, source_size, source_hash);
+            if(!valid) {
+                storage_file_close(library_file);
+                storage_simply_remove(storage, furi_string_get_cstr(path));
+            }
+        }
+    }
+
+    furi_string_free(path);
+    storage_file_free(db_file);
+
+    if(valid) {
+        brute_force->library = infrared_library_alloc(
+            infrared_brute_force_library_read, infrared_brute_force_library_seek, library_file);
+        valid = infrared_library_load(brute_force->library, &header);
+    }
+    if(!valid) {
+        FURI_LOG_W(TAG, "No compiled library, using text database");
+        infrared_brute_force_close_library(brute_force);
+    }
+    return valid;
+}
+
 bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     furi_assert(brute_force->db_filename);
     bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    infrared_brute_force_close_library(brute_force);
+    if(infrared_brute_force_open_library(brute_force)) {
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+            !InfraredBruteForceRecordDict_end_p(it);
+            InfraredBruteForceRecordDict_next(it)) {
+            InfraredBruteForceRecordDict_itref_t* record = InfraredBruteForceRecordDict_ref(it);
+            uint16_t name = 0;
+            if(infrared_library_find_name(
+                   brute_force->library, furi_string_get_cstr(record->key), &name)) {
+                record->value.count =
+                    infrared_library_get_signal_count(brute_force->library, name);
+            }
+        }
+        success = true;
+    } else {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
 
-    success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
-    if(success) {
-        FuriString* signal_name;
-        signal_name = furi_string_alloc();
-        while(flipper_format_read_string(ff, "name", signal_name)) {
-            InfraredBruteForceRecord* record =
-                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
-            if(record) { //-V547
-                ++(record->count);
+        success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
+        if(success) {
+            FuriString* signal_name;
+            signal_name = furi_string_alloc();
+            while(flipper_format_read_string(ff, "name", signal_name)) {
+                InfraredBruteForceRecord* record =
+                    InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
+                if(record) { //-V547
+                    ++(record->count);
+                }
             }
+            furi_string_free(signal_name);
         }
-        furi_string_free(signal_name);
-    }
 
-    flipper_format_free(ff);
-    furi_record_close(RECORD_STORAGE);
+        flipper_format_free(ff);
+        furi_record_close(RECORD_STORAGE);
+    }
     return success;
 }
 
+/** Put next signal of sweep to worker, false at the end or at signal that can't be sent */
+static bool infrared_brute_force_load_next(InfraredBruteForce* brute_force) {
+    InfraredLibraryRecord record;
+    if(!infrared_library_sweep_next(brute_force->sweep, &record, brute_force->timings)) {
+        return false;
+    }
+
+    if(record.type == InfraredLibrarySignalTypeParsed) {
+        const InfraredMessage message = {
+            .protocol = record.protocol,
+            .address = record.parsed.address,
+            .command = record.parsed.command,
+            .repeat = false,
+        };
+        infrared_worker_set_decoded_signal(brute_force->worker, &message);
+        // Same number of repeats as infrared_send(message, 1)
+        const uint32_t repeats = infrared_get_protocol_min_repeat_count(record.protocol);
+        brute_force->repeats_left = repeats ? repeats - 1 : 0;
+    } else if(record.type == InfraredLibrarySignalTypeRaw) {
+        infrared_worker_set_raw_signal(
+            brute_force->worker,
+            brute_force->timings,
+            record.raw.timings_count,
+            record.raw.frequency,
+            record.raw.duty_cycle);
+        brute_force->repeats_left = 0;
+    } else {
+        // Text database stops at invalid signal too
+        return false;
+    }
+
+    brute_force->progress++;
+    return true;
+}
+
+static InfraredWorkerGetSignalResponse
+    infrared_brute_force_get_signal_callback(void* context, InfraredWorker* instance) {
+    UNUSED(instance);
+    InfraredBruteForce* brute_force = context;
+
+    if(brute_force->signal_pending) {
+        brute_force->signal_pending = false;
+        return InfraredWorkerGetSignalResponseNew;
+    } else if(brute_force->repeats_left) {
+        brute_force->repeats_left--;
+        return InfraredWorkerGetSignalResponseSame;
+    } else if(infrared_brute_force_load_next(brute_force)) {
+        return InfraredWorkerGetSignalResponseNew;
+    } else {
+        return InfraredWorkerGetSignalResponseStop;
+    }
+}
+
 bool infrared_brute_force_start(
     InfraredBruteForce* brute_force,
     uint32_t index,
@@ -99,7 +312,25 @@ bool infrared_brute_force_start(
         }
     }
 
-    if(*record_count) {
+    brute_force->progress = 0;
+    if(*record_count && brute_force->library) {
+        uint16_t name = 0;
+        success = infrared_library_find_name(
+            brute_force->library, furi_string_get_cstr(brute_force->current_record_name), &name);
+        if(success) {
+            brute_force->sweep = infrared_library_sweep_alloc(brute_force->library, name);
+            success = (brute_force->sweep != NULL);
+        }
+        if(success) {
+            brute_force->worker = infrared_worker_alloc();
+            brute_force->timings = malloc(sizeof(uint32_t) * INFRARED_LIBRARY_TIMINGS_MAX);
+            brute_force->signal_pending = false;
+            brute_force->repeats_left = 0;
+            infrared_worker_tx_set_get_signal_callback(
+                brute_force->worker, infrared_brute_force_get_signal_callback, brute_force);
+            brute_force->is_started = true;
+        }
+    } else if(*record_count) {
         Storage* storage = furi_record_open(RECORD_STORAGE);
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
         brute_force->current_signal = infrared_signal_alloc();
@@ -118,24 +349,52 @@ bool infrared_brute_force_is_started(InfraredBruteForce* brute_force) {
 void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
     furi_string_reset(brute_force->current_record_name);
-    infrared_signal_free(brute_force->current_signal);
-    flipper_format_free(brute_force->ff);
-    brute_force->current_signal = NULL;
-    brute_force->ff = NULL;
+    if(brute_force->sweep) {
+        if(brute_force->progress) {
+            infrared_worker_tx_stop(brute_force->worker);
+        }
+        infrared_worker_free(brute_force->worker);
+        infrared_library_sweep_free(brute_force->sweep);
+        free(brute_force->timings);
+        brute_force->worker = NULL;
+        brute_force->sweep = NULL;
+        brute_force->timings = NULL;
+    } else {
+        infrared_signal_free(brute_force->current_signal);
+        flipper_format_free(brute_force->ff);
+        brute_force->current_signal = NULL;
+        brute_force->ff = NULL;
+        furi_record_close(RECORD_STORAGE);
+    }
     brute_force->is_started = false;
-    furi_record_close(RECORD_STORAGE);
 }
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
+
+    if(brute_force->sweep) {
+        // Worker sends whole sweep back to back, it only needs a first signal to start
+        if(!brute_force->progress) {
+            if(!infrared_brute_force_load_next(brute_force)) return false;
+            brute_force->signal_pending = true;
+            infrared_worker_tx_start(brute_force->worker);
+        }
+        return !infrared_worker_tx_is_done(brute_force->worker);
+    }
+
     const bool success = infrared_signal_search_and_read(
         brute_force->current_signal, brute_force->ff, brute_force->current_record_name);
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
+        brute_force->progress++;
     }
     return success;
 }
 
+uint32_t infrared_brute_force_get_progress(InfraredBruteForce* brute_force) {
+    return brute_force->progress;
+}
+
 void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
@@ -149,5 +408,6 @@ void infrared_brute_force_add_record(
 
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_close_library(brute_force);
     InfraredBruteForceRecordDict_reset(brute_force->records);
 }
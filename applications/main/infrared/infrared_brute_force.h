@@ -16,6 +16,7 @@ bool infrared_brute_force_start(
 bool infrared_brute_force_is_started(InfraredBruteForce* brute_force);
 void infrared_brute_force_stop(InfraredBruteForce* brute_force);
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force);
+uint32_t infrared_brute_force_get_progress(InfraredBruteForce* brute_force);
 void infrared_brute_force_reset(InfraredBruteForce* brute_force);
 void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
@@ -0,0 +1,858 @@
+#include "infrared_library.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <furi_hal_infrared.h>
+
+#define INFRARED_LIBRARY_KEY_SIZE_MAX (15U)
+#define INFRARED_LIBRARY_TOKEN_SIZE_MAX (23U)
+#define INFRARED_LIBRARY_TIMING_SIZE_MAX (5U)
+#define INFRARED_LIBRARY_TEXT_SIZE (64U)
+
+static const char* const infrared_library_filetype = "IR library file";
+static const uint32_t infrared_library_file_version = 1;
+
+typedef enum {
+    InfraredLibraryKeyUnknown,
+    InfraredLibraryKeyName,
+    InfraredLibraryKeyType,
+    InfraredLibraryKeyProtocol,
+    InfraredLibraryKeyAddress,
+    InfraredLibraryKeyCommand,
+    InfraredLibraryKeyFrequency,
+    InfraredLibraryKeyDutyCycle,
+    InfraredLibraryKeyData,
+    InfraredLibraryKeyMAX,
+} InfraredLibraryKey;
+
+static const char* const infrared_library_keys[InfraredLibraryKeyMAX] = {
+    [InfraredLibraryKeyName] = "name",
+    [InfraredLibraryKeyType] = "type",
+    [InfraredLibraryKeyProtocol] = "protocol",
+    [InfraredLibraryKeyAddress] = "address",
+    [InfraredLibraryKeyCommand] = "command",
+    [InfraredLibraryKeyFrequency] = "frequency",
+    [InfraredLibraryKeyDutyCycle] = "duty_cycle",
+    [InfraredLibraryKeyData] = "data",
+};
+
+/* Keys in the order infrared_signal_save() writes them, after name */
+#define INFRARED_LIBRARY_SIGNAL_KEYS (4U)
+
+static const InfraredLibraryKey infrared_library_parsed_keys[INFRARED_LIBRARY_SIGNAL_KEYS] = {
+    InfraredLibraryKeyType,
+    InfraredLibraryKeyProtocol,
+    InfraredLibraryKeyAddress,
+    InfraredLibraryKeyCommand,
+};
+
+static const InfraredLibraryKey infrared_library_raw_keys[INFRARED_LIBRARY_SIGNAL_KEYS] = {
+    InfraredLibraryKeyType,
+    InfraredLibraryKeyFrequency,
+    InfraredLibraryKeyDutyCycle,
+    InfraredLibraryKeyData,
+};
+
+typedef enum {
+    InfraredLibraryLineStart,
+    InfraredLibraryLineKey,
+    InfraredLibraryLineValueStart,
+    InfraredLibraryLineValue,
+    InfraredLibraryLineSkip,
+} InfraredLibraryLineState;
+
+struct InfraredLibraryCompiler {
+    InfraredLibraryWrite write;
+    void* context;
+    bool write_error;
+    uint32_t source_size;
+    uint32_t source_hash;
+    uint32_t offset;
+
+    InfraredLibraryLineState line_state;
+    InfraredLibraryKey key;
+    char key_text[INFRARED_LIBRARY_KEY_SIZE_MAX + 1];
+    size_t key_size;
+    char value[INFRARED_LIBRARY_NAME_SIZE_MAX + 1];
+    size_t value_size;
+    char token[INFRARED_LIBRARY_TOKEN_SIZE_MAX + 1];
+    size_t token_size;
+    size_t value_count;
+    bool value_error;
+
+    bool signal;
+    bool signal_error;
+    size_t signal_step;
+    InfraredLibrarySignalType signal_type;
+    InfraredLibraryRecord record;
+    uint8_t hex[4];
+    uint32_t* timings;
+    uint8_t* packed;
+
+    char* strings;
+    size_t strings_size;
+    size_t strings_capacity;
+    uint32_t* name_strings;
+    size_t name_count;
+    size_t name_capacity;
+    uint16_t* signal_names;
+    uint32_t* signal_offsets;
+    size_t signal_count;
+    size_t signal_capacity;
+};
+
+struct InfraredLibrary {
+    InfraredLibraryRead read;
+    InfraredLibrarySeek seek;
+    void* context;
+    InfraredLibraryHeader header;
+    uint8_t* index;
+    const InfraredLibraryName* names;
+    const uint32_t* offsets;
+    const char* strings;
+    size_t strings_size;
+};
+
+struct InfraredLibrarySweep {
+    uint8_t* data;
+    size_t size;
+    size_t position;
+    uint32_t count;
+};
+
+uint32_t infrared_library_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+bool infrared_library_header_is_valid(
+    const InfraredLibraryHeader* header,
+    uint32_t source_size,
+    uint32_t source_hash) {
+    return (header->magic == INFRARED_LIBRARY_MAGIC) &&
+           (header->version == INFRARED_LIBRARY_VERSION) &&
+           (header->source_size == source_size) && (header->source_hash == source_hash) &&
+           (header->index_offset >= sizeof(InfraredLibraryHeader));
+}
+
+static size_t infrared_library_pack_timing(uint32_t timing, uint8_t* data) {
+    size_t size = 0;
+    while(timing > 0x7F) {
+        data[size++] = (timing & 0x7F) | 0x80;
+        timing >>= 7;
+    }
+    data[size++] = timing;
+    return size;
+}
+
+/** Unpack timings, false if data doesn't hold exactly count timings */
+static bool infrared_library_unpack_timings(
+    const uint8_t* data,
+    size_t size,
+    uint32_t* timings,
+    size_t count) {
+    size_t position = 0;
+    for(size_t i = 0; i < count; i++) {
+        uint32_t timing = 0;
+        size_t shift = 0;
+        uint8_t byte;
+        do {
+            if(position == size || shift > 28) return false;
+            byte = data[position++];
+            timing |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while(byte & 0x80);
+        timings[i] = timing;
+    }
+    return position == size;
+}
+
+static bool infrared_library_is_parsed_valid(const InfraredLibraryRecord* record) {
+    const InfraredProtocol protocol = record->protocol;
+    if(!infrared_is_protocol_valid(protocol)) return false;
+
+    uint32_t address_mask = (1UL << infrared_get_protocol_address_length(protocol)) - 1;
+    uint32_t command_mask = (1UL << infrared_get_protocol_command_length(protocol)) - 1;
+    return (record->parsed.address == (record->parsed.address & address_mask)) &&
+           (record->parsed.command == (record->parsed.command & command_mask));
+}
+
+/* Worker checks, stricter than infrared_signal_is_valid() on duty cycle */
+static bool infrared_library_is_raw_valid(const InfraredLibraryRecord* record) {
+    return (record->raw.frequency <= INFRARED_MAX_FREQUENCY) &&
+           (record->raw.frequency >= INFRARED_MIN_FREQUENCY) &&
+           (record->raw.duty_cycle > 0.0f) && (record->raw.duty_cycle < 1.0f) &&
+           (record->raw.timings_count > 0);
+}
+
+InfraredLibraryCompiler*
+    infrared_library_compiler_alloc(InfraredLibraryWrite write, void* context) {
+    InfraredLibraryCompiler* compiler = malloc(sizeof(InfraredLibraryCompiler));
+    memset(compiler, 0, sizeof(InfraredLibraryCompiler));
+    compiler->write = write;
+    compiler->context = context;
+    compiler->source_hash = INFRARED_LIBRARY_HASH_INIT;
+    compiler->offset = sizeof(InfraredLibraryHeader);
+    compiler->timings = malloc(sizeof(uint32_t) * INFRARED_LIBRARY_TIMINGS_MAX);
+    compiler->packed = malloc(INFRARED_LIBRARY_TIMING_SIZE_MAX * INFRARED_LIBRARY_TIMINGS_MAX);
+    return compiler;
+}
+
+void infrared_library_compiler_free(InfraredLibraryCompiler* compiler) {
+    free(compiler->signal_offsets);
+    free(compiler->signal_names);
+    free(compiler->name_strings);
+    free(compiler->strings);
+    free(compiler->packed);
+    free(compiler->timings);
+    free(compiler);
+}
+
+static void infrared_library_compiler_write(
+    InfraredLibraryCompiler* compiler,
+    const void* data,
+    size_t size) {
+    if(compiler->write_error) return;
+    if(!compiler->write(compiler->context, data, size)) {
+        compiler->write_error = true;
+    }
+    compiler->offset += size;
+}
+
+static bool infrared_library_compiler_add_name(InfraredLibraryCompiler* compiler, uint16_t* name) {
+    for(size_t i = 0; i < compiler->name_count; i++) {
+        if(!strcmp(&compiler->strings[compiler->name_strings[i]], compiler->value)) {
+            *name = i;
+            return true;
+        }
+    }
+    if(compiler->name_count == UINT16_MAX) return false;
+
+    if(compiler->name_count == compiler->name_capacity) {
+        compiler->name_capacity = compiler->name_capacity ? compiler->name_capacity * 2 : 16;
+        compiler->name_strings =
+            realloc(compiler->name_strings, compiler->name_capacity * sizeof(uint32_t)); //-V701
+    }
+    const size_t size = compiler->value_size + 1;
+    while(compiler->strings_size + size > compiler->strings_capacity) {
+        compiler->strings_capacity = compiler->strings_capacity ? compiler->strings_capacity * 2 :
+                                                                  256;
+        compiler->strings = realloc(compiler->strings, compiler->strings_capacity); //-V701
+    }
+    memcpy(&compiler->strings[compiler->strings_size], compiler->value, size);
+    compiler->name_strings[compiler->name_count] = compiler->strings_size;
+    compiler->strings_size += size;
+    *name = compiler->name_count++;
+    return true;
+}
+
+static void infrared_library_compiler_end_signal(InfraredLibraryCompiler* compiler) {
+    if(!compiler->signal) return;
+    compiler->signal = false;
+
+    InfraredLibraryRecord* record = &compiler->record;
+    size_t packed_size = 0;
+    bool valid = !compiler->signal_error &&
+                 (compiler->signal_step == INFRARED_LIBRARY_SIGNAL_KEYS);
+    if(valid && (compiler->signal_type == InfraredLibrarySignalTypeParsed)) {
+        valid = infrared_library_is_parsed_valid(record);
+    } else if(valid) {
+        valid = infrared_library_is_raw_valid(record);
+        for(size_t i = 0; valid && (i < record->raw.timings_count); i++) {
+            packed_size +=
+                infrared_library_pack_timing(compiler->timings[i], &compiler->packed[packed_size]);
+        }
+        record->raw.timings_size = packed_size;
+    }
+    if(!valid) {
+        const uint16_t name = record->name;
+        memset(record, 0, sizeof(InfraredLibraryRecord));
+        record->name = name;
+        record->type = InfraredLibrarySignalTypeInvalid;
+        packed_size = 0;
+    } else {
+        record->type = compiler->signal_type;
+    }
+
+    if(compiler->signal_count == compiler->signal_capacity) {
+        compiler->signal_capacity = compiler->signal_capacity ? compiler->signal_capacity * 2 :
+                                                                64;
+        compiler->signal_names =
+            realloc(compiler->signal_names, compiler->signal_capacity * sizeof(uint16_t)); //-V701
+        compiler->signal_offsets = realloc(
+            compiler->signal_offsets, compiler->signal_capacity * sizeof(uint32_t)); //-V701
+    }
+    compiler->signal_names[compiler->signal_count] = record->name;
+    compiler->signal_offsets[compiler->signal_count] = compiler->offset;
+    compiler->signal_count++;
+
+    infrared_library_compiler_write(compiler, record, sizeof(InfraredLibraryRecord));
+    if(packed_size) infrared_library_compiler_write(compiler, compiler->packed, packed_size);
+}
+
+static void infrared_library_compiler_start_signal(InfraredLibraryCompiler* compiler) {
+    infrared_library_compiler_end_signal(compiler);
+
+    memset(&compiler->record, 0, sizeof(InfraredLibraryRecord));
+    compiler->signal = true;
+    compiler->signal_step = 0;
+    compiler->signal_type = InfraredLibrarySignalTypeParsed;
+    // Same as failed name read, signal can't be found by name
+    compiler->signal_error = (compiler->value_size == 0) || compiler->value_error;
+    uint16_t name = 0;
+    if(!infrared_library_compiler_add_name(compiler, &name)) {
+        compiler->write_error = true;
+    }
+    compiler->record.name = name;
+}
+
+static InfraredLibraryKey infrared_library_expected_key(InfraredLibraryCompiler* compiler) {
+    const InfraredLibraryKey* keys = compiler->signal_type == InfraredLibrarySignalTypeRaw ?
+                                         infrared_library_raw_keys :
+                                         infrared_library_parsed_keys;
+    return keys[compiler->signal_step];
+}
+
+/** Key is complete, check if its value is needed */
+static void infrared_library_compiler_key(InfraredLibraryCompiler* compiler) {
+    compiler->key_text[compiler->key_size] = '\0';
+    compiler->key = InfraredLibraryKeyUnknown;
+    for(size_t i = InfraredLibraryKeyName; i < InfraredLibraryKeyMAX; i++) {
+        if(!strcmp(compiler->key_text, infrared_library_keys[i])) {
+            compiler->key = i;
+            break;
+        }
+    }
+
+    if(compiler->key == InfraredLibraryKeyName) {
+        // Value is needed
+    } else if(
+        (compiler->key == InfraredLibraryKeyUnknown) || !compiler->signal ||
+        compiler->signal_error || (compiler->signal_step == INFRARED_LIBRARY_SIGNAL_KEYS)) {
+        compiler->key = InfraredLibraryKeyUnknown;
+    } else if(compiler->key != infrared_library_expected_key(compiler)) {
+        compiler->signal_error = true;
+        compiler->key = InfraredLibraryKeyUnknown;
+    }
+
+    compiler->value_size = 0;
+    compiler->token_size = 0;
+    compiler->value_count = 0;
+    compiler->value_error = false;
+    compiler->line_state = compiler->key == InfraredLibraryKeyUnknown ?
+                               InfraredLibraryLineSkip :
+                               InfraredLibraryLineValueStart;
+}
+
+static bool infrared_library_is_string_key(InfraredLibraryKey key) {
+    return (key == InfraredLibraryKeyName) || (key == InfraredLibraryKeyType) ||
+           (key == InfraredLibraryKeyProtocol);
+}
+
+static bool infrared_library_hex_to_uint8(const char* text, uint8_t* value) {
+    uint8_t result = 0;
+    for(size_t i = 0; i < 2; i++) {
+        const char c = text[i];
+        result <<= 4;
+        if(c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if(c >= 'A' && c <= 'F') {
+            result |= c - 'A' + 10;
+        } else if(c >= 'a' && c <= 'f') {
+            result |= c - 'a' + 10;
+        } else {
+            return false;
+        }
+    }
+    *value = result;
+    return true;
+}
+
+/** Value of number key is complete, same conversions as FlipperFormat reads */
+static void infrared_library_compiler_token(InfraredLibraryCompiler* compiler) {
+    if(compiler->token_size == 0) return;
+    compiler->token[compiler->token_size] = '\0';
+    compiler->token_size = 0;
+
+    const size_t i = compiler->value_count++;
+    const char* token = compiler->token;
+    uint32_t value;
+    char* end;
+
+    switch(compiler->key) {
+    case InfraredLibraryKeyAddress:
+    case InfraredLibraryKeyCommand:
+        if(i < sizeof(compiler->hex)) {
+            if(strlen(token) < 2 || !infrared_library_hex_to_uint8(token, &compiler->hex[i])) {
+                compiler->value_error = true;
+            }
+        }
+        break;
+    case InfraredLibraryKeyFrequency:
+        if(i == 0) {
+            if(sscanf(token, "%" SCNu32, &value) == 1) {
+                compiler->record.raw.frequency = value;
+            } else {
+                compiler->value_error = true;
+            }
+        }
+        break;
+    case InfraredLibraryKeyDutyCycle:
+        if(i == 0) {
+            compiler->record.raw.duty_cycle = strtof(token, &end);
+            if(*end != '\0') compiler->value_error = true;
+        }
+        break;
+    case InfraredLibraryKeyData:
+        if(i < INFRARED_LIBRARY_TIMINGS_MAX) {
+            if(sscanf(token, "%" SCNu32, &compiler->timings[i]) != 1) {
+                compiler->value_error = true;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/** Line of needed key is complete */
+static void infrared_library_compiler_value(InfraredLibraryCompiler* compiler) {
+    InfraredLibraryRecord* record = &compiler->record;
+    compiler->value[compiler->value_size] = '\0';
+    infrared_library_compiler_token(compiler);
+
+    bool valid = !compiler->value_error;
+    switch(compiler->key) {
+    case InfraredLibraryKeyName:
+        infrared_library_compiler_start_signal(compiler);
+        return;
+    case InfraredLibraryKeyType:
+        if(!strcmp(compiler->value, "parsed")) {
+            compiler->signal_type = InfraredLibrarySignalTypeParsed;
+        } else if(!strcmp(compiler->value, "raw")) {
+            compiler->signal_type = InfraredLibrarySignalTypeRaw;
+        } else {
+            valid = false;
+        }
+        break;
+    case InfraredLibraryKeyProtocol: {
+        InfraredProtocol protocol = infrared_get_protocol_by_name(compiler->value);
+        valid = valid && (protocol > InfraredProtocolUnknown) && (protocol < UINT8_MAX);
+        record->protocol = protocol;
+    } break;
+    case InfraredLibraryKeyAddress:
+    case InfraredLibraryKeyCommand: {
+        uint32_t value = 0;
+        memcpy(&value, compiler->hex, sizeof(value));
+        valid = valid && (compiler->value_count >= sizeof(compiler->hex));
+        if(compiler->key == InfraredLibraryKeyAddress) {
+            record->parsed.address = value;
+        } else {
+            record->parsed.command = value;
+        }
+    } break;
+    case InfraredLibraryKeyFrequency:
+    case InfraredLibraryKeyDutyCycle:
+        valid = valid && (compiler->value_count > 0);
+        break;
+    case InfraredLibraryKeyData:
+        valid = valid && (compiler->value_count <= INFRARED_LIBRARY_TIMINGS_MAX);
+        record->raw.timings_count = compiler->value_count;
+        break;
+    default:
+        return;
+    }
+
+    if(valid) {
+        compiler->signal_step++;
+    } else {
+        compiler->signal_error = true;
+    }
+}
+
+/* Line rules of FlipperFormat: '#' or ':' at line start skip the line,
+ * value starts one character after ':', '\r' is ignored */
+static void infrared_library_compiler_char(InfraredLibraryCompiler* compiler, char c) {
+    if(c == '\r' && compiler->line_state != InfraredLibraryLineValueStart) return;
+
+    if(c == '\n') {
+        if(compiler->line_state == InfraredLibraryLineValueStart ||
+           compiler->line_state == InfraredLibraryLineValue) {
+            infrared_library_compiler_value(compiler);
+        }
+        compiler->line_state = InfraredLibraryLineStart;
+        compiler->key_size = 0;
+        return;
+    }
+
+    switch(compiler->line_state) {
+    case InfraredLibraryLineStart:
+        if(c == '#' || c == ':') {
+            compiler->line_state = InfraredLibraryLineSkip;
+            break;
+        }
+        compiler->line_state = InfraredLibraryLineKey;
+        /* fall through */
+    case InfraredLibraryLineKey:
+        if(c == ':') {
+            infrared_library_compiler_key(compiler);
+        } else if(compiler->key_size < INFRARED_LIBRARY_KEY_SIZE_MAX) {
+            compiler->key_text[compiler->key_size++] = c;
+        } else {
+            compiler->line_state = InfraredLibraryLineSkip;
+        }
+        break;
+    case InfraredLibraryLineValueStart:
+        compiler->line_state = InfraredLibraryLineValue;
+        break;
+    case InfraredLibraryLineValue:
+        if(infrared_library_is_string_key(compiler->key)) {
+            if(compiler->value_size < INFRARED_LIBRARY_NAME_SIZE_MAX) {
+                compiler->value[compiler->value_size++] = c;
+            } else {
+                compiler->value_error = true;
+            }
+        } else if(c == ' ' || c == '\t') {
+            infrared_library_compiler_token(compiler);
+        } else if(compiler->token_size < INFRARED_LIBRARY_TOKEN_SIZE_MAX) {
+            compiler->token[compiler->token_size++] = c;
+        } else {
+            compiler->value_error = true;
+        }
+        break;
+    case InfraredLibraryLineSkip:
+        break;
+    }
+}
+
+bool infrared_library_compiler_feed(
+    InfraredLibraryCompiler* compiler,
+    const char* data,
+    size_t size) {
+    compiler->source_size += size;
+    compiler->source_hash = infrared_library_hash(compiler->source_hash, data, size);
+
+    for(size_t i = 0; i < size; i++) {
+        infrared_library_compiler_char(compiler, data[i]);
+    }
+
+    return !compiler->write_error;
+}
+
+bool infrared_library_compiler_finish(
+    InfraredLibraryCompiler* compiler,
+    InfraredLibraryHeader* header) {
+    infrared_library_compiler_char(compiler, '\n');
+    infrared_library_compiler_end_signal(compiler);
+    if(compiler->write_error) return false;
+
+    const size_t name_count = compiler->name_count;
+    const size_t signal_count = compiler->signal_count;
+    InfraredLibraryName* names = malloc(sizeof(InfraredLibraryName) * (name_count + 1));
+    uint32_t* offsets = malloc(sizeof(uint32_t) * (signal_count + 1));
+    memset(names, 0, sizeof(InfraredLibraryName) * (name_count + 1));
+
+    // Group record offsets by name, keeping library order
+    for(size_t i = 0; i < signal_count; i++) {
+        names[compiler->signal_names[i]].count++;
+    }
+    uint32_t first = 0;
+    for(size_t i = 0; i < name_count; i++) {
+        names[i].first = first;
+        names[i].string = compiler->name_strings[i];
+        first += names[i].count;
+        names[i].count = 0;
+    }
+    for(size_t i = 0; i < signal_count; i++) {
+        InfraredLibraryName* name = &names[compiler->signal_names[i]];
+        offsets[name->first + name->count++] = compiler->signal_offsets[i];
+        // Records are contiguous, next one (or index) starts where this one ends
+        const uint32_t end =
+            i + 1 < signal_count ? compiler->signal_offsets[i + 1] : compiler->offset;
+        name->size += end - compiler->signal_offsets[i];
+    }
+
+    const uint32_t index_offset = compiler->offset;
+    infrared_library_compiler_write(compiler, names, sizeof(InfraredLibraryName) * name_count);
+    infrared_library_compiler_write(compiler, offsets, sizeof(uint32_t) * signal_count);
+    infrared_library_compiler_write(compiler, compiler->strings, compiler->strings_size);
+    free(offsets);
+    free(names);
+
+    memset(header, 0, sizeof(InfraredLibraryHeader));
+    header->magic = INFRARED_LIBRARY_MAGIC;
+    header->version = INFRARED_LIBRARY_VERSION;
+    header->name_count = name_count;
+    header->source_size = compiler->source_size;
+    header->source_hash = compiler->source_hash;
+    header->signal_count = signal_count;
+    header->index_offset = index_offset;
+    header->index_size = compiler->offset - index_offset;
+
+    return !compiler->write_error;
+}
+
+InfraredLibrary*
+    infrared_library_alloc(InfraredLibraryRead read, InfraredLibrarySeek seek, void* context) {
+    InfraredLibrary* library = malloc(sizeof(InfraredLibrary));
+    memset(library, 0, sizeof(InfraredLibrary));
+    library->read = read;
+    library->seek = seek;
+    library->context = context;
+    return library;
+}
+
+void infrared_library_free(InfraredLibrary* library) {
+    free(library->index);
+    free(library);
+}
+
+static bool infrared_library_read(InfraredLibrary* library, void* data, size_t size) {
+    return library->read(library->context, data, size) == size;
+}
+
+bool infrared_library_load(InfraredLibrary* library, const InfraredLibraryHeader* header) {
+    free(library->index);
+    library->index = NULL;
+    library->header = *header;
+
+    const size_t names_size = sizeof(InfraredLibraryName) * header->name_count;
+    const size_t offsets_size = sizeof(uint32_t) * header->signal_count;
+    if((header->signal_count > header->index_size / sizeof(uint32_t)) ||
+       (names_size + offsets_size > header->index_size)) {
+        return false;
+    }
+
+    library->index = malloc(header->index_size + 1);
+    if(!library->seek(library->context, header->index_offset) ||
+       !infrared_library_read(library, library->index, header->index_size)) {
+        return false;
+    }
+    library->index[header->index_size] = '\0';
+
+    library->names = (const InfraredLibraryName*)library->index;
+    library->offsets = (const uint32_t*)&library->index[names_size];
+    library->strings = (const char*)&library->index[names_size + offsets_size];
+    library->strings_size = header->index_size - names_size - offsets_size;
+
+    for(size_t i = 0; i < header->name_count; i++) {
+        const InfraredLibraryName* name = &library->names[i];
+        if((name->string >= library->strings_size) || (name->first > header->signal_count) ||
+           (name->count > header->signal_count - name->first) ||
+           (name->size > header->index_offset)) {
+            return false;
+        }
+    }
+    for(size_t i = 0; i < header->signal_count; i++) {
+        if((library->offsets[i] < sizeof(InfraredLibraryHeader)) ||
+           (library->offsets[i] > header->index_offset - sizeof(InfraredLibraryRecord))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool infrared_library_find_name(InfraredLibrary* library, const char* name, uint16_t* index) {
+    for(size_t i = 0; i < library->header.name_count; i++) {
+        if(!strcmp(&library->strings[library->names[i].string], name)) {
+            *index = i;
+            return library->names[i].count > 0;
+        }
+    }
+    return false;
+}
+
+uint32_t infrared_library_get_signal_count(InfraredLibrary* library, uint16_t index) {
+    return index < library->header.name_count ? library->names[index].count : 0;
+}
+
+static bool infrared_library_write_cstr(
+    InfraredLibraryWrite write,
+    void* context,
+    const char* text) {
+    return write(context, text, strlen(text));
+}
+
+static bool infrared_library_write_record(
+    InfraredLibrary* library,
+    const InfraredLibraryRecord* record,
+    const uint32_t* timings,
+    InfraredLibraryWrite write,
+    void* context) {
+    char text[INFRARED_LIBRARY_TEXT_SIZE];
+    const char* name = record->name < library->header.name_count ?
+                           &library->strings[library->names[record->name].string] :
+                           "";
+    bool success = infrared_library_write_cstr(write, context, "# \nname: ") &&
+                   infrared_library_write_cstr(write, context, name) &&
+                   infrared_library_write_cstr(write, context, "\n");
+
+    if(record->type == InfraredLibrarySignalTypeParsed) {
+        const uint32_t address_value = record->parsed.address;
+        const uint32_t command_value = record->parsed.command;
+        const uint8_t* address = (const uint8_t*)&address_value;
+        const uint8_t* command = (const uint8_t*)&command_value;
+        snprintf(
+            text,
+            sizeof(text),
+            "type: parsed\nprotocol: %s\n",
+            infrared_get_protocol_name(record->protocol));
+        success = success && infrared_library_write_cstr(write, context, text);
+        snprintf(
+            text,
+            sizeof(text),
+            "address: %02X %02X %02X %02X\ncommand: %02X %02X %02X %02X\n",
+            address[0],
+            address[1],
+            address[2],
+            address[3],
+            command[0],
+            command[1],
+            command[2],
+            command[3]);
+        success = success && infrared_library_write_cstr(write, context, text);
+    } else if(record->type == InfraredLibrarySignalTypeRaw) {
+        snprintf(
+            text,
+            sizeof(text),
+            "type: raw\nfrequency: %" PRIu32 "\nduty_cycle: %f\ndata:",
+            record->raw.frequency,
+            (double)record->raw.duty_cycle);
+        success = success && infrared_library_write_cstr(write, context, text);
+        for(size_t i = 0; success && (i < record->raw.timings_count); i++) {
+            snprintf(text, sizeof(text), " %" PRIu32, timings[i]);
+            success = infrared_library_write_cstr(write, context, text);
+        }
+        success = success && infrared_library_write_cstr(write, context, "\n");
+    } else {
+        success = success && infrared_library_write_cstr(write, context, "type: invalid\n");
+    }
+
+    return success;
+}
+
+/** Read record at current position, false on input error or broken record */
+static bool infrared_library_read_record(
+    InfraredLibrary* library,
+    InfraredLibraryRecord* record,
+    uint8_t* packed,
+    uint32_t* timings) {
+    if(!infrared_library_read(library, record, sizeof(InfraredLibraryRecord))) return false;
+    if(record->type != InfraredLibrarySignalTypeRaw) return true;
+
+    return (record->raw.timings_count <= INFRARED_LIBRARY_TIMINGS_MAX) &&
+           (record->raw.timings_size <=
+            INFRARED_LIBRARY_TIMING_SIZE_MAX * INFRARED_LIBRARY_TIMINGS_MAX) &&
+           infrared_library_read(library, packed, record->raw.timings_size) &&
+           infrared_library_unpack_timings(
+               packed, record->raw.timings_size, timings, record->raw.timings_count);
+}
+
+bool infrared_library_write_text(
+    InfraredLibrary* library,
+    InfraredLibraryWrite write,
+    void* context) {
+    char text[INFRARED_LIBRARY_TEXT_SIZE];
+    snprintf(
+        text,
+        sizeof(text),
+        "Filetype: %s\nVersion: %" PRIu32 "\n",
+        infrared_library_filetype,
+        infrared_library_file_version);
+    bool success = infrared_library_write_cstr(write, context, text) &&
+                   library->seek(library->context, sizeof(InfraredLibraryHeader));
+
+    InfraredLibraryRecord record;
+    uint8_t* packed = malloc(INFRARED_LIBRARY_TIMING_SIZE_MAX * INFRARED_LIBRARY_TIMINGS_MAX);
+    uint32_t* timings = malloc(sizeof(uint32_t) * INFRARED_LIBRARY_TIMINGS_MAX);
+    for(size_t i = 0; success && (i < library->header.signal_count); i++) {
+        success = infrared_library_read_record(library, &record, packed, timings) &&
+                  infrared_library_write_record(library, &record, timings, write, context);
+    }
+    free(timings);
+    free(packed);
+
+    return success;
+}
+
+InfraredLibrarySweep* infrared_library_sweep_alloc(InfraredLibrary* library, uint16_t index) {
+    const uint32_t count = infrared_library_get_signal_count(library, index);
+    InfraredLibrarySweep* sweep = malloc(sizeof(InfraredLibrarySweep));
+    memset(sweep, 0, sizeof(InfraredLibrarySweep));
+    sweep->count = count;
+
+    // Index knows total size, allocate once
+    const size_t capacity = count ? library->names[index].size : 0;
+    if(capacity) sweep->data = malloc(capacity);
+
+    bool success = true;
+    for(size_t i = 0; success && (i < count); i++) {
+        InfraredLibraryRecord record;
+        const uint32_t offset = library->offsets[library->names[index].first + i];
+        success = library->seek(library->context, offset) &&
+                  infrared_library_read(library, &record, sizeof(record)) &&
+                  (record.name == index);
+        if(!success) break;
+
+        const size_t packed_size =
+            record.type == InfraredLibrarySignalTypeRaw ? record.raw.timings_size : 0;
+        const size_t size = sizeof(record) + packed_size;
+        if(sweep->size + size > capacity) {
+            success = false;
+            break;
+        }
+        memcpy(&sweep->data[sweep->size], &record, sizeof(record));
+        success = !packed_size || infrared_library_read(
+                                      library, &sweep->data[sweep->size + sizeof(record)],
+                                      packed_size);
+        sweep->size += size;
+    }
+    success = success && (sweep->size == capacity);
+
+    if(!success) {
+        infrared_library_sweep_free(sweep);
+        sweep = NULL;
+    }
+    return sweep;
+}
+
+void infrared_library_sweep_free(InfraredLibrarySweep* sweep) {
+    free(sweep->data);
+    free(sweep);
+}
+
+uint32_t infrared_library_sweep_get_count(InfraredLibrarySweep* sweep) {
+    return sweep->count;
+}
+
+void infrared_library_sweep_reset(InfraredLibrarySweep* sweep) {
+    sweep->position = 0;
+}
+
+bool infrared_library_sweep_next(
+    InfraredLibrarySweep* sweep,
+    InfraredLibraryRecord* record,
+    uint32_t* timings) {
+    if(sweep->position + sizeof(InfraredLibraryRecord) > sweep->size) return false;
+
+    memcpy(record, &sweep->data[sweep->position], sizeof(InfraredLibraryRecord));
+    sweep->position += sizeof(InfraredLibraryRecord);
+    if(record->type == InfraredLibrarySignalTypeRaw) {
+        const size_t packed_size = record->raw.timings_size;
+        if((packed_size > sweep->size - sweep->position) ||
+           (record->raw.timings_count > INFRARED_LIBRARY_TIMINGS_MAX) ||
+           !infrared_library_unpack_timings(
+               &sweep->data[sweep->position], packed_size, timings, record->raw.timings_count)) {
+            record->type = InfraredLibrarySignalTypeInvalid;
+        }
+        sweep->position += packed_size;
+    }
+
+    return true;
+}
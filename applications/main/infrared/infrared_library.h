@@ -0,0 +1,284 @@
+/**
+ * @file infrared_library.h
+ * Infrared: compiled universal remote library
+ *
+ * Library text (.ir) is compiled once into a binary file with every signal
+ * already parsed and checked, so brute force reads fixed records instead of
+ * parsing text, and can hand signals to the worker back to back.
+ *
+ * Compiled library is InfraredLibraryHeader followed by signal records in
+ * library order and name index at index_offset:
+ *
+ *   Signal    InfraredLibraryRecord, raw record is followed by timings_size
+ *             bytes of timings, 7 bits per byte starting from low bits,
+ *             bit 7 is set in all bytes of timing except the last one
+ *   Index     name_count * InfraredLibraryName,
+ *             signal_count * u32 record offset, grouped by name,
+ *             names as zero terminated strings
+ *
+ * There is no category index: every universal library file is one category
+ * (tv, ac, audio, projectors) and .ir text has no category key, so the file
+ * path already selects category and name index covers the rest.
+ *
+ * Signals that infrared_signal_read() rejects are kept as invalid records,
+ * so sending stops at the same signal as with text library. Keys of signal
+ * are expected in the order infrared_signal_save() writes them.
+ *
+ * Compiler and reader only use libc and protocol info from infrared.h,
+ * host builds provide protocol functions.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <infrared.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INFRARED_LIBRARY_MAGIC (0x314C5249UL) /**< "IRL1" */
+#define INFRARED_LIBRARY_VERSION (2U)
+#define INFRARED_LIBRARY_EXTENSION ".irl"
+
+#define INFRARED_LIBRARY_TIMINGS_MAX (1024U) /**< Same as MAX_TIMINGS_AMOUNT */
+#define INFRARED_LIBRARY_NAME_SIZE_MAX (63U)
+
+typedef enum {
+    InfraredLibrarySignalTypeInvalid,
+    InfraredLibrarySignalTypeParsed,
+    InfraredLibrarySignalTypeRaw,
+} InfraredLibrarySignalType;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t name_count;
+    uint32_t source_size;
+    uint32_t source_hash;
+    uint32_t signal_count;
+    uint32_t index_offset;
+    uint32_t index_size;
+} __attribute__((packed)) InfraredLibraryHeader;
+
+typedef struct {
+    uint16_t name; /**< Name number in index */
+    uint8_t type; /**< InfraredLibrarySignalType */
+    uint8_t protocol; /**< InfraredProtocol of parsed signal */
+    union {
+        struct {
+            uint32_t address;
+            uint32_t command;
+        } parsed;
+        struct {
+            uint32_t frequency;
+            float duty_cycle;
+            uint16_t timings_count;
+            uint16_t timings_size; /**< Packed timings size in bytes */
+        } raw;
+    };
+} __attribute__((packed)) InfraredLibraryRecord;
+
+typedef struct {
+    uint32_t first; /**< First record offset of name in offset list */
+    uint32_t count; /**< Signals with this name */
+    uint32_t size; /**< Total size of records with this name, with timings */
+    uint32_t string; /**< Name offset in strings */
+} __attribute__((packed)) InfraredLibraryName;
+
+#define INFRARED_LIBRARY_HASH_INIT (2166136261UL)
+
+/** FNV-1a hash, start with INFRARED_LIBRARY_HASH_INIT
+ *
+ * @param      hash  Hash of previous data
+ * @param      data  Data
+ * @param      size  Data size
+ *
+ * @return     hash of previous data and data
+ */
+uint32_t infrared_library_hash(uint32_t hash, const void* data, size_t size);
+
+/** Check compiled library header against library text
+ *
+ * @param      header       Header read from compiled library
+ * @param      source_size  Library text size
+ * @param      source_hash  Library text hash
+ *
+ * @return     true if compiled library can be used
+ */
+bool infrared_library_header_is_valid(
+    const InfraredLibraryHeader* header,
+    uint32_t source_size,
+    uint32_t source_hash);
+
+/** Compiled library output
+ *
+ * @return     true if all data is written
+ */
+typedef bool (*InfraredLibraryWrite)(void* context, const void* data, size_t size);
+
+typedef struct InfraredLibraryCompiler InfraredLibraryCompiler;
+
+/** Allocate compiler
+ *
+ * @param      write    Output for data after header, header is not written
+ * @param      context  Output context
+ *
+ * @return     InfraredLibraryCompiler instance
+ */
+InfraredLibraryCompiler*
+    infrared_library_compiler_alloc(InfraredLibraryWrite write, void* context);
+
+/** Free compiler
+ *
+ * @param      compiler  InfraredLibraryCompiler instance
+ */
+void infrared_library_compiler_free(InfraredLibraryCompiler* compiler);
+
+/** Compile next part of library text, lines may span calls
+ *
+ * @param      compiler  InfraredLibraryCompiler instance
+ * @param      data      Library text
+ * @param      size      Text size
+ *
+ * @return     false on output error
+ */
+bool infrared_library_compiler_feed(
+    InfraredLibraryCompiler* compiler,
+    const char* data,
+    size_t size);
+
+/** Compile last signal, write index and fill header
+ *
+ * @param      compiler  InfraredLibraryCompiler instance
+ * @param      header    Header for compiled library
+ *
+ * @return     false on output error or if library is too big
+ */
+bool infrared_library_compiler_finish(
+    InfraredLibraryCompiler* compiler,
+    InfraredLibraryHeader* header);
+
+/** Compiled library input
+ *
+ * @return     bytes read
+ */
+typedef size_t (*InfraredLibraryRead)(void* context, void* data, size_t size);
+
+/** Compiled library seek, offset is relative to file start
+ *
+ * @return     true on success
+ */
+typedef bool (*InfraredLibrarySeek)(void* context, uint32_t offset);
+
+typedef struct InfraredLibrary InfraredLibrary;
+
+/** Allocate compiled library reader
+ *
+ * @param      read     Input
+ * @param      seek     Input seek
+ * @param      context  Input context
+ *
+ * @return     InfraredLibrary instance
+ */
+InfraredLibrary*
+    infrared_library_alloc(InfraredLibraryRead read, InfraredLibrarySeek seek, void* context);
+
+/** Free compiled library reader
+ *
+ * @param      library  InfraredLibrary instance
+ */
+void infrared_library_free(InfraredLibrary* library);
+
+/** Load name index into memory
+ *
+ * @param      library  InfraredLibrary instance
+ * @param      header   Checked header of compiled library
+ *
+ * @return     false on input error or broken index
+ */
+bool infrared_library_load(InfraredLibrary* library, const InfraredLibraryHeader* header);
+
+/** Find signal name
+ *
+ * @param      library  InfraredLibrary instance
+ * @param      name     Signal name
+ * @param      index    Name number
+ *
+ * @return     true if there are signals with this name
+ */
+bool infrared_library_find_name(InfraredLibrary* library, const char* name, uint16_t* index);
+
+/** Get number of signals with name
+ *
+ * @param      library  InfraredLibrary instance
+ * @param      index    Name number
+ *
+ * @return     signal count
+ */
+uint32_t infrared_library_get_signal_count(InfraredLibrary* library, uint16_t index);
+
+/** Write library text back from compiled library, in the format
+ * infrared_signal_save() uses
+ *
+ * @param      library  InfraredLibrary instance
+ * @param      write    Text output
+ * @param      context  Output context
+ *
+ * @return     false on input or output error
+ */
+bool infrared_library_write_text(
+    InfraredLibrary* library,
+    InfraredLibraryWrite write,
+    void* context);
+
+typedef struct InfraredLibrarySweep InfraredLibrarySweep;
+
+/** Read all signals with name into memory, so they can be sent without
+ * storage access
+ *
+ * @param      library  InfraredLibrary instance
+ * @param      index    Name number
+ *
+ * @return     InfraredLibrarySweep instance, NULL on input error
+ */
+InfraredLibrarySweep* infrared_library_sweep_alloc(InfraredLibrary* library, uint16_t index);
+
+/** Free signals
+ *
+ * @param      sweep  InfraredLibrarySweep instance
+ */
+void infrared_library_sweep_free(InfraredLibrarySweep* sweep);
+
+/** Get number of signals
+ *
+ * @param      sweep  InfraredLibrarySweep instance
+ *
+ * @return     signal count
+ */
+uint32_t infrared_library_sweep_get_count(InfraredLibrarySweep* sweep);
+
+/** Rewind to first signal
+ *
+ * @param      sweep  InfraredLibrarySweep instance
+ */
+void infrared_library_sweep_reset(InfraredLibrarySweep* sweep);
+
+/** Get next signal
+ *
+ * @param      sweep    InfraredLibrarySweep instance
+ * @param      record   Signal record
+ * @param      timings  Raw signal timings, INFRARED_LIBRARY_TIMINGS_MAX entries
+ *
+ * @return     false after last signal
+ */
+bool infrared_library_sweep_next(
+    InfraredLibrarySweep* sweep,
+    InfraredLibraryRecord* record,
+    uint32_t* timings);
+
+#ifdef __cplusplus
+}
+#endif
@@ -44,10 +44,10 @@ bool infrared_scene_universal_common_on_event(void* context, SceneManagerEvent e
 
     if(infrared_brute_force_is_started(brute_force)) {
         if(event.type == SceneManagerEventTypeTick) {
+            // Compiled library is sent by worker, progress catches up on ticks
             bool success = infrared_brute_force_send_next(brute_force);
-            if(success) {
-                success = infrared_progress_view_increase_progress(infrared->progress);
-            }
+            infrared_progress_view_set_progress(
+                infrared->progress, infrared_brute_force_get_progress(brute_force));
             if(!success) {
                 infrared_brute_force_stop(brute_force);
                 infrared_scene_universal_common_hide_popup(infrared);
@@ -37,6 +37,14 @@ bool infrared_progress_view_increase_progress(InfraredProgressView* progress) {
     return result;
 }
 
+void infrared_progress_view_set_progress(InfraredProgressView* progress, uint16_t value) {
+    furi_assert(progress);
+
+    InfraredProgressViewModel* model = view_get_model(progress->view);
+    model->progress = MIN(value, model->progress_total);
+    view_commit_model(progress->view, true);
+}
+
 static void infrared_progress_view_draw_callback(Canvas* canvas, void* _model) {
     InfraredProgressViewModel* model = (InfraredProgressViewModel*)_model;
 
@@ -43,6 +43,13 @@ View* infrared_progress_view_get_view(InfraredProgressView* instance);
  */
 bool infrared_progress_view_increase_progress(InfraredProgressView* instance);
 
+/** Set progress on progress view module
+ *
+ * @param instance - view module
+ * @param progress - progress value, limited by maximum
+ */
+void infrared_progress_view_set_progress(InfraredProgressView* instance, uint16_t progress);
+
 /** Set maximum progress value
  *
  * @param instance - view module
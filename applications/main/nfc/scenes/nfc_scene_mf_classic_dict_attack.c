@@ -73,6 +73,10 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
     }
     // Free previous dictionary
     if(dict_attack_data->dict) {
+        // Keys from user dictionary were already tried, don't try them again
+        if(dict) {
+            mf_classic_dict_exclude_keys(dict, dict_attack_data->dict);
+        }
         mf_classic_dict_free(dict_attack_data->dict);
     }
     dict_attack_data->dict = dict;
@@ -37,6 +37,8 @@ SubGhzTxRx* subghz_txrx_alloc() {
     subghz_environment_set_protocol_registry(
         instance->environment, (void*)&subghz_protocol_registry);
     instance->receiver = subghz_receiver_alloc_init(instance->environment);
+    // Don't feed decoders with pulses shorter than their timing allows, cuts noise cost in RX
+    subghz_receiver_set_timing_filter(instance->receiver, true);
 
     subghz_worker_set_overrun_callback(
         instance->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
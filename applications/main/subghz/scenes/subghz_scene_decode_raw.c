@@ -44,30 +44,19 @@ static void subghz_scene_add_to_history_callback(
     void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-    uint16_t idx = subghz_history_get_item(subghz->history);
     SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
 
-    if(subghz_history_add_to_history(subghz->history, decoder_base, &preset)) {
-        furi_string_reset(item_name);
-        furi_string_reset(item_time);
-
+    if(subghz_history_add_to_history(subghz->history, decoder_base, &preset, 0)) {
         subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-        subghz_history_get_text_item_menu(subghz->history, item_name, idx);
-        subghz_history_get_time_item_menu(subghz->history, item_time, idx);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(item_name),
-            furi_string_get_cstr(item_time),
-            subghz_history_get_type_protocol(subghz->history, idx));
+        subghz_view_receiver_set_item_count(
+            subghz->subghz_receiver, subghz_history_get_item(subghz->history));
 
         subghz_scene_receiver_update_statusbar(subghz);
     }
+    // RAW file is decoded on GUI thread, SD card writes are fine here
+    subghz_history_flush(subghz->history);
     subghz_receiver_reset(receiver);
-    furi_string_free(item_name);
-    furi_string_free(item_time);
 }
 
 bool subghz_scene_decode_raw_start(SubGhz* subghz) {
@@ -145,9 +134,6 @@ bool subghz_scene_decode_raw_next(SubGhz* subghz) {
 void subghz_scene_decode_raw_on_enter(void* context) {
     SubGhz* subghz = context;
 
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-
     subghz_view_receiver_set_mode(subghz->subghz_receiver, SubGhzViewReceiverModeFile);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_decode_raw_callback, subghz);
@@ -168,23 +154,11 @@ void subghz_scene_decode_raw_on_enter(void* context) {
     } else {
         //Load history to receiver
         subghz_view_receiver_exit(subghz->subghz_receiver);
-        for(uint8_t i = 0; i < subghz_history_get_item(subghz->history); i++) {
-            furi_string_reset(item_name);
-            furi_string_reset(item_time);
-            subghz_history_get_text_item_menu(subghz->history, item_name, i);
-            subghz_history_get_time_item_menu(subghz->history, item_time, i);
-            subghz_view_receiver_add_item_to_menu(
-                subghz->subghz_receiver,
-                furi_string_get_cstr(item_name),
-                furi_string_get_cstr(item_time),
-                subghz_history_get_type_protocol(subghz->history, i));
-        }
+        subghz_view_receiver_set_item_count(
+            subghz->subghz_receiver, subghz_history_get_item(subghz->history));
         subghz_view_receiver_set_idx_menu(subghz->subghz_receiver, subghz->idx_menu_chosen);
     }
 
-    furi_string_free(item_name);
-    furi_string_free(item_time);
-
     subghz_scene_receiver_update_statusbar(subghz);
 
     view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdReceiver);
@@ -25,6 +25,17 @@ void subghz_tick_event_callback(void* context) {
     scene_manager_handle_tick_event(subghz->scene_manager);
 }
 
+static void subghz_history_item_callback(
+    void* context,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time,
+    uint8_t* type) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    *type = subghz_history_get_menu_item(subghz->history, idx, name, time);
+}
+
 static void subghz_rpc_command_callback(RpcAppSystemEvent event, void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
@@ -256,6 +267,8 @@ SubGhz* subghz_alloc(bool alloc_for_tx_only) {
 
     if(!alloc_for_tx_only) {
         subghz->history = subghz_history_alloc();
+        subghz_view_receiver_set_item_callback(
+            subghz->subghz_receiver, subghz_history_item_callback, subghz);
     }
 
     subghz->secure_data = malloc(sizeof(SecureData));
@@ -1,114 +1,459 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <lib/flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
+#include <storage/storage.h>
 
 #include <furi.h>
 
-#define SUBGHZ_HISTORY_MAX 55
+#define SUBGHZ_HISTORY_MAX 60000
+#define SUBGHZ_HISTORY_RAM_MAX 55
+#define SUBGHZ_HISTORY_RAM_ITEMS 16
 #define SUBGHZ_HISTORY_FREE_HEAP 20480
+#define SUBGHZ_HISTORY_CACHE_ITEMS 8
+#define SUBGHZ_HISTORY_PROTOCOLS_MAX 128
+#define SUBGHZ_HISTORY_PRESETS_MAX 255
+#define SUBGHZ_HISTORY_LABEL_SIZE 20
+#define SUBGHZ_HISTORY_ID_UNKNOWN 0xFF
+
+#define SUBGHZ_HISTORY_FOLDER EXT_PATH("subghz/.history")
+#define SUBGHZ_HISTORY_RECORDS_PATH SUBGHZ_HISTORY_FOLDER "/history.rec"
+#define SUBGHZ_HISTORY_BLOBS_PATH SUBGHZ_HISTORY_FOLDER "/history.dat"
+
 #define TAG "SubGhzHistory"
 
+/** Fixed size history record, everything needed to draw menu item and
+ * to find full FlipperFormat data of item */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
+    uint64_t key;
+    uint32_t timestamp;
+    uint32_t frequency;
+    uint32_t blob_offset;
+    uint16_t blob_size;
+    uint16_t bit_count;
+    uint8_t protocol_id;
+    uint8_t preset_id;
+    int8_t rssi; /**< dBm, 0 if unknown */
     uint8_t type;
-    SubGhzRadioPreset* preset;
-    FuriHalRtcDateTime datetime;
+    char label[SUBGHZ_HISTORY_LABEL_SIZE];
+} __attribute__((packed)) SubGhzHistoryRecord;
+
+typedef struct {
+    SubGhzHistoryRecord record;
+    FlipperFormat* flipper_string;
 } SubGhzHistoryItem;
 
-ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
 
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
 
-typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
+ARRAY_DEF(SubGhzHistoryIndexArray, uint16_t, M_DEFAULT_OPLIST)
 
+/* Items are numbered from oldest one. First items live in records file on SD
+ * card, their FlipperFormat data is appended to blobs file. Newest items stay
+ * in RAM and are moved to SD card by subghz_history_flush, outside of radio
+ * decode thread. Without SD card history is limited to RAM window.
+ *
+ * Deleted SD card records stay in file as tombstones until reset, `deleted`
+ * holds their sorted positions and item index skips them.
+ *
+ * Flush runs on scene thread, getters also on GUI thread from view draw.
+ * file_mutex guards files and record cache, mutex guards RAM window that
+ * decoder appends to. When both are needed file_mutex is taken first, so
+ * flush writes to SD card holding file_mutex only and decoder isn't blocked. */
 struct SubGhzHistory {
+    FuriMutex* file_mutex;
+    FuriMutex* mutex;
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
     uint8_t code_last_hash_data;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
+
+    SubGhzHistoryItem items[SUBGHZ_HISTORY_RAM_MAX];
+    uint16_t items_count;
+
+    Storage* storage;
+    Stream* records;
+    Stream* blobs;
+    uint16_t spilled; /**< Records in file, tombstones included */
+    SubGhzHistoryIndexArray_t deleted;
+    bool spill_disabled;
+
+    SubGhzHistoryRecord cache[SUBGHZ_HISTORY_CACHE_ITEMS];
+    uint16_t cache_start;
+    uint16_t cache_count;
+
+    const SubGhzProtocol* protocols[SUBGHZ_HISTORY_PROTOCOLS_MAX];
+    uint8_t protocols_count;
+    SubGhzHistoryPresetArray_t presets;
+
+    FlipperFormat* raw_data;
+    SubGhzRadioPreset preset;
 };
 
+static void subghz_history_lock(SubGhzHistory* instance) {
+    furi_check(furi_mutex_acquire(instance->file_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+static void subghz_history_unlock(SubGhzHistory* instance) {
+    furi_mutex_release(instance->mutex);
+    furi_mutex_release(instance->file_mutex);
+}
+
+static void subghz_history_close_files(SubGhzHistory* instance) {
+    if(instance->records) {
+        file_stream_close(instance->records);
+        stream_free(instance->records);
+        instance->records = NULL;
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_RECORDS_PATH);
+    }
+    if(instance->blobs) {
+        file_stream_close(instance->blobs);
+        stream_free(instance->blobs);
+        instance->blobs = NULL;
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_BLOBS_PATH);
+    }
+}
+
+static bool subghz_history_open_files(SubGhzHistory* instance) {
+    if(instance->records) return true;
+
+    bool result = false;
+    do {
+        if(storage_sd_status(instance->storage) != FSE_OK) break;
+        if(!storage_simply_mkdir(instance->storage, EXT_PATH("subghz"))) break;
+        if(!storage_simply_mkdir(instance->storage, SUBGHZ_HISTORY_FOLDER)) break;
+
+        instance->records = file_stream_alloc(instance->storage);
+        instance->blobs = file_stream_alloc(instance->storage);
+        if(!file_stream_open(
+               instance->records,
+               SUBGHZ_HISTORY_RECORDS_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(!file_stream_open(
+               instance->blobs, SUBGHZ_HISTORY_BLOBS_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        result = true;
+    } while(false);
+
+    if(!result) {
+        FURI_LOG_W(TAG, "SD card history is not available");
+        subghz_history_close_files(instance);
+        instance->spill_disabled = true;
+    }
+    return result;
+}
+
+static void subghz_history_clear(SubGhzHistory* instance) {
+    for(uint16_t i = 0; i < instance->items_count; i++) {
+        flipper_format_free(instance->items[i].flipper_string);
+    }
+    instance->items_count = 0;
+
+    subghz_history_close_files(instance);
+    instance->spilled = 0;
+    SubGhzHistoryIndexArray_reset(instance->deleted);
+    instance->spill_disabled = false;
+    instance->cache_count = 0;
+
+    instance->protocols_count = 0;
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->presets);
+}
+
+/** Items on SD card, tombstones excluded */
+static uint16_t subghz_history_spilled_count(SubGhzHistory* instance) {
+    return instance->spilled - SubGhzHistoryIndexArray_size(instance->deleted);
+}
+
+/** Position in records file of SD card item */
+static uint16_t subghz_history_record_position(SubGhzHistory* instance, uint16_t idx) {
+    uint16_t position = idx;
+    for
+        M_EACH(deleted, instance->deleted, SubGhzHistoryIndexArray_t) {
+            if(*deleted > position) break;
+            position++;
+        }
+    return position;
+}
+
+/** Move oldest RAM item to SD card, file_mutex must be taken
+ *
+ * File I/O runs without mutex, so decoder can keep adding items meanwhile.
+ * Items are only removed from RAM window by the same thread. */
+static bool subghz_history_spill(SubGhzHistory* instance) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    bool ready = !instance->spill_disabled && instance->items_count > 0 &&
+                 instance->spilled < UINT16_MAX;
+    SubGhzHistoryRecord record = {0};
+    FlipperFormat* flipper_string = NULL;
+    if(ready) {
+        record = instance->items[0].record;
+        flipper_string = instance->items[0].flipper_string;
+    }
+    furi_mutex_release(instance->mutex);
+    if(!ready || !subghz_history_open_files(instance)) return false;
+
+    Stream* src = flipper_format_get_raw_stream(flipper_string);
+    size_t size = stream_size(src);
+    bool result = false;
+
+    do {
+        if(size > UINT16_MAX) break;
+        if(!stream_seek(instance->blobs, 0, StreamOffsetFromEnd)) break;
+        record.blob_offset = stream_tell(instance->blobs);
+        record.blob_size = size;
+        if(!stream_rewind(src)) break;
+        if(stream_copy(src, instance->blobs, size) != size) break;
+
+        size_t offset = instance->spilled * sizeof(SubGhzHistoryRecord);
+        if(!stream_seek(instance->records, offset, StreamOffsetFromStart)) break;
+        if(stream_write(instance->records, (uint8_t*)&record, sizeof(SubGhzHistoryRecord)) !=
+           sizeof(SubGhzHistoryRecord))
+            break;
+        result = true;
+    } while(false);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "SD card write error");
+        instance->spill_disabled = true;
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    flipper_format_free(flipper_string);
+    instance->items_count--;
+    memmove(
+        &instance->items[0],
+        &instance->items[1],
+        instance->items_count * sizeof(SubGhzHistoryItem));
+    instance->spilled++;
+    furi_mutex_release(instance->mutex);
+    return true;
+}
+
+/** Get record of item, NULL on SD card read error. Both mutexes must be taken. */
+static const SubGhzHistoryRecord*
+    subghz_history_get_record(SubGhzHistory* instance, uint16_t idx) {
+    uint16_t spilled = subghz_history_spilled_count(instance);
+    if(idx >= instance->last_index_write) return NULL;
+    if(idx >= spilled) return &instance->items[idx - spilled].record;
+
+    uint16_t position = subghz_history_record_position(instance, idx);
+    if(position < instance->cache_start ||
+       position >= instance->cache_start + instance->cache_count) {
+        // Read records around requested one, menu draws neighbours too
+        uint16_t start = 0;
+        if(position > SUBGHZ_HISTORY_CACHE_ITEMS / 2) {
+            start = position - SUBGHZ_HISTORY_CACHE_ITEMS / 2;
+        }
+        uint16_t count = MIN(instance->spilled - start, SUBGHZ_HISTORY_CACHE_ITEMS);
+        size_t size = count * sizeof(SubGhzHistoryRecord);
+        instance->cache_count = 0;
+        if(!stream_seek(
+               instance->records, start * sizeof(SubGhzHistoryRecord), StreamOffsetFromStart))
+            return NULL;
+        if(stream_read(instance->records, (uint8_t*)instance->cache, size) != size) {
+            FURI_LOG_E(TAG, "SD card read error");
+            return NULL;
+        }
+        instance->cache_start = start;
+        instance->cache_count = count;
+    }
+    return &instance->cache[position - instance->cache_start];
+}
+
+static uint8_t subghz_history_get_protocol_id(
+    SubGhzHistory* instance,
+    const SubGhzProtocol* protocol) {
+    for(uint8_t i = 0; i < instance->protocols_count; i++) {
+        if(instance->protocols[i] == protocol) return i;
+    }
+    if(instance->protocols_count == SUBGHZ_HISTORY_PROTOCOLS_MAX) return SUBGHZ_HISTORY_ID_UNKNOWN;
+    instance->protocols[instance->protocols_count] = protocol;
+    return instance->protocols_count++;
+}
+
+static uint8_t
+    subghz_history_get_preset_id(SubGhzHistory* instance, const SubGhzRadioPreset* preset) {
+    uint8_t id = 0;
+    for
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            if(item->data == preset->data && item->data_size == preset->data_size &&
+               furi_string_equal(item->name, preset->name)) {
+                return id;
+            }
+            id++;
+        }
+    if(id == SUBGHZ_HISTORY_PRESETS_MAX) return SUBGHZ_HISTORY_ID_UNKNOWN;
+
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return id;
+}
+
+static const SubGhzHistoryPreset*
+    subghz_history_get_preset_by_id(SubGhzHistory* instance, uint8_t id) {
+    if(id >= SubGhzHistoryPresetArray_size(instance->presets)) return NULL;
+    return SubGhzHistoryPresetArray_cget(instance->presets, id);
+}
+
+static void
+    subghz_history_get_record_text(const SubGhzHistoryRecord* record, FuriString* output) {
+    uint64_t data = record->key;
+    if(data != 0) {
+        if(!(uint32_t)(data >> 32)) {
+            furi_string_printf(output, "%s %lX", record->label, (uint32_t)(data & 0xFFFFFFFF));
+        } else {
+            furi_string_printf(
+                output,
+                "%s %lX%08lX",
+                record->label,
+                (uint32_t)(data >> 32),
+                (uint32_t)(data & 0xFFFFFFFF));
+        }
+    } else {
+        furi_string_printf(output, "%s", record->label);
+    }
+}
+
+static void
+    subghz_history_get_record_time(const SubGhzHistoryRecord* record, FuriString* output) {
+    uint32_t time = record->timestamp % (60 * 60 * 24);
+    furi_string_printf(
+        output, "%.2lu:%.2lu:%.2lu ", time / (60 * 60), (time / 60) % 60, time % 60);
+    if(record->rssi != 0) {
+        furi_string_cat_printf(output, "%ddBm", record->rssi);
+    }
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
+    instance->file_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    SubGhzHistoryIndexArray_init(instance->deleted);
+    instance->raw_data = flipper_format_string_alloc();
+    instance->preset.name = furi_string_alloc();
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_clear(instance);
+    flipper_format_free(instance->raw_data);
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    SubGhzHistoryIndexArray_clear(instance->deleted);
+    furi_string_free(instance->preset.name);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(instance->mutex);
+    furi_mutex_free(instance->file_mutex);
     free(instance);
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    subghz_history_lock(instance);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    uint32_t frequency = record ? record->frequency : 0;
+    subghz_history_unlock(instance);
+    return frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    subghz_history_lock(instance);
+    SubGhzRadioPreset* preset = &instance->preset;
+    furi_string_reset(preset->name);
+    preset->frequency = 0;
+    preset->data = NULL;
+    preset->data_size = 0;
+
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        preset->frequency = record->frequency;
+        const SubGhzHistoryPreset* item =
+            subghz_history_get_preset_by_id(instance, record->preset_id);
+        if(item) {
+            furi_string_set(preset->name, item->name);
+            preset->data = item->data;
+            preset->data_size = item->data_size;
+        }
+    }
+    subghz_history_unlock(instance);
+    return preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    subghz_history_lock(instance);
+    const char* name = "";
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        const SubGhzHistoryPreset* item =
+            subghz_history_get_preset_by_id(instance, record->preset_id);
+        if(item) name = furi_string_get_cstr(item->name);
+    }
+    subghz_history_unlock(instance);
+    return name;
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_lock(instance);
     furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
+    subghz_history_clear(instance);
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
+    subghz_history_unlock(instance);
 }
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t item_id) {
     furi_assert(instance);
+    subghz_history_lock(instance);
 
-    SubGhzHistoryItemArray_it_t it;
-    //SubGhzHistoryItem* target_item = SubGhzHistoryItemArray_get(instance->history->data, item_id);
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_ref(it);
-
-        if(it->index == (size_t)(item_id)) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-            SubGhzHistoryItemArray_remove(instance->history->data, it);
-        }
-        SubGhzHistoryItemArray_previous(it);
+    uint16_t spilled = subghz_history_spilled_count(instance);
+    if(item_id >= instance->last_index_write) {
+        FURI_LOG_E(TAG, "Missing Item");
+    } else if(item_id >= spilled) {
+        uint16_t pos = item_id - spilled;
+        flipper_format_free(instance->items[pos].flipper_string);
+        instance->items_count--;
+        memmove(
+            &instance->items[pos],
+            &instance->items[pos + 1],
+            (instance->items_count - pos) * sizeof(SubGhzHistoryItem));
+        instance->last_index_write--;
+    } else {
+        // Record and blob stay in files as tombstone until reset
+        uint16_t position = subghz_history_record_position(instance, item_id);
+        size_t insert = 0;
+        for
+            M_EACH(deleted, instance->deleted, SubGhzHistoryIndexArray_t) {
+                if(*deleted > position) break;
+                insert++;
+            }
+        SubGhzHistoryIndexArray_push_at(instance->deleted, insert, position);
+        instance->last_index_write--;
     }
-    instance->last_index_write--;
+    subghz_history_unlock(instance);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
@@ -118,72 +463,170 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    subghz_history_lock(instance);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    uint8_t type = record ? record->type : 0;
+    subghz_history_unlock(instance);
+    return type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
+    subghz_history_lock(instance);
+    const char* name = "";
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(!record || record->protocol_id >= instance->protocols_count) {
         FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
-    }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
+    } else {
+        name = instance->protocols[record->protocol_id]->name;
     }
-    return furi_string_get_cstr(instance->tmp_string);
+    subghz_history_unlock(instance);
+    return name;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+    subghz_history_lock(instance);
+    Stream* dst = flipper_format_get_raw_stream(instance->raw_data);
+    stream_clean(dst);
+
+    uint16_t spilled = subghz_history_spilled_count(instance);
+    if(idx >= instance->last_index_write) {
+        FURI_LOG_E(TAG, "Missing Item");
+    } else if(idx >= spilled) {
+        SubGhzHistoryItem* item = &instance->items[idx - spilled];
+        stream_copy_full(flipper_format_get_raw_stream(item->flipper_string), dst);
     } else {
-        return NULL;
+        const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+        if(!record || !stream_seek(instance->blobs, record->blob_offset, StreamOffsetFromStart) ||
+           stream_copy(instance->blobs, dst, record->blob_size) != record->blob_size) {
+            FURI_LOG_E(TAG, "SD card read error");
+            stream_clean(dst);
+        }
     }
+    flipper_format_rewind(instance->raw_data);
+    subghz_history_unlock(instance);
+    return instance->raw_data;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
+    bool spill_disabled = instance->spill_disabled;
+    uint16_t max = spill_disabled ? SUBGHZ_HISTORY_RAM_MAX : SUBGHZ_HISTORY_MAX;
+    if(spill_disabled && memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(instance->last_index_write >= max) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) {
+        if(spill_disabled) {
+            furi_string_printf(output, "%02u/%02u", instance->last_index_write, max);
+        } else {
+            furi_string_printf(output, "%02u", instance->last_index_write);
+        }
+    }
     return false;
 }
 
 uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
+
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_assert(instance);
+    subghz_history_lock(instance);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        subghz_history_get_record_text(record, output);
+    } else {
+        furi_string_reset(output);
+    }
+    subghz_history_unlock(instance);
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    FuriHalRtcDateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    furi_assert(instance);
+    subghz_history_lock(instance);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        subghz_history_get_record_time(record, output);
+    } else {
+        furi_string_reset(output);
+    }
+    subghz_history_unlock(instance);
+}
+
+uint8_t subghz_history_get_menu_item(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time) {
+    furi_assert(instance);
+    subghz_history_lock(instance);
+    uint8_t type = 0;
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        subghz_history_get_record_text(record, name);
+        subghz_history_get_record_time(record, time);
+        type = record->type;
+    }
+    subghz_history_unlock(instance);
+    return type;
+}
+
+static void subghz_history_fill_record(
+    SubGhzHistory* instance,
+    SubGhzHistoryItem* item,
+    SubGhzProtocolDecoderBase* decoder_base) {
+    SubGhzHistoryRecord* record = &item->record;
+    const char* protocol_name = decoder_base->protocol->name;
+
+    furi_string_set(instance->tmp_string, protocol_name);
+    do {
+        if(!strcmp(protocol_name, "KeeLoq")) {
+            furi_string_set(instance->tmp_string, "KL ");
+        } else if(!strcmp(protocol_name, "Star Line")) {
+            furi_string_set(instance->tmp_string, "SL ");
+        } else {
+            break;
+        }
+        FuriString* text = furi_string_alloc();
+        if(!flipper_format_rewind(item->flipper_string) ||
+           !flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+        }
+        furi_string_cat(instance->tmp_string, text);
+        furi_string_free(text);
+    } while(false);
+    strlcpy(record->label, furi_string_get_cstr(instance->tmp_string), sizeof(record->label));
+
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    if(!flipper_format_rewind(item->flipper_string) ||
+       !flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        FURI_LOG_D(TAG, "No Key");
+    }
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        record->key = (record->key << 8) | key_data[i];
+    }
+
+    uint32_t bit_count = 0;
+    if(flipper_format_rewind(item->flipper_string) &&
+       flipper_format_read_uint32(item->flipper_string, "Bit", &bit_count, 1)) {
+        record->bit_count = bit_count;
+    }
 }
 
 bool subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset) {
+    SubGhzRadioPreset* preset,
+    float rssi) {
     furi_assert(instance);
     furi_assert(context);
 
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
     if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
@@ -194,82 +637,44 @@ bool subghz_history_add_to_history(
         return false;
     }
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // No SD card I/O here, decoder thread calls it. RAM window is emptied by flush.
+    if(instance->items_count >= SUBGHZ_HISTORY_RAM_MAX ||
+       memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
+        furi_mutex_release(instance->mutex);
+        return false;
+    }
+
     instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
     instance->last_update_timestamp = furi_get_tick();
 
-    FuriString* text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
-
-    item->item_str = furi_string_alloc();
+    SubGhzHistoryItem* item = &instance->items[instance->items_count];
+    memset(item, 0, sizeof(SubGhzHistoryItem));
     item->flipper_string = flipper_format_string_alloc();
     subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
 
-    do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_D(TAG, "No Key");
-        }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(data != 0) {
-            if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data >> 32),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            }
-        } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
-        }
-
-    } while(false);
+    SubGhzHistoryRecord* record = &item->record;
+    record->timestamp = furi_hal_rtc_get_timestamp();
+    record->frequency = preset->frequency;
+    record->protocol_id = subghz_history_get_protocol_id(instance, decoder_base->protocol);
+    record->preset_id = subghz_history_get_preset_id(instance, preset);
+    record->rssi = (int8_t)CLAMP(rssi, 0.0f, -127.0f);
+    record->type = decoder_base->protocol->type;
+    subghz_history_fill_record(instance, item, decoder_base);
 
-    furi_string_free(text);
+    instance->items_count++;
     instance->last_index_write++;
+    furi_mutex_release(instance->mutex);
     return true;
 }
+
+void subghz_history_flush(SubGhzHistory* instance) {
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->file_mutex, FuriWaitForever) == FuriStatusOk);
+    while(instance->items_count > SUBGHZ_HISTORY_RAM_ITEMS ||
+          (instance->items_count > 0 && memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP)) {
+        if(!subghz_history_spill(instance)) break;
+    }
+    furi_mutex_release(instance->file_mutex);
+}
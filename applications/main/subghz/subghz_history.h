@@ -7,6 +7,15 @@
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/subghz/types.h>
 
+/** Receive history
+ *
+ * Every item is a fixed size binary record (key, bit count, frequency, preset,
+ * RSSI, time and menu label) with protocol FlipperFormat data kept aside, so
+ * menu is drawn without parsing. Newest items stay in RAM, older ones are
+ * moved to append only files on SD card by subghz_history_flush, history size
+ * is only limited by SD card. Without SD card history keeps last RAM window
+ * size limit.
+ */
 typedef struct SubGhzHistory SubGhzHistory;
 
 /** Allocate SubGhzHistory
@@ -37,6 +46,12 @@ void subghz_history_delete_item(SubGhzHistory* instance, uint16_t item_id);
  */
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx);
 
+/** Get radio preset to history[idx]
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @return preset   - SubGhzRadioPreset*, valid until next call
+ */
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx);
 
 /** Get preset to history[idx]
@@ -86,6 +101,20 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* outp
  */
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx);
 
+/** Get string, time and type of menu item history[idx]
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @param name      - FuriString* output for item string
+ * @param time      - FuriString* output for item time
+ * @return type     - type protocol, 0 if item is missing
+ */
+uint8_t subghz_history_get_menu_item(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time);
+
 /** Get string the remaining number of records to history
  * 
  * @param instance  - SubGhzHistory instance
@@ -106,14 +135,27 @@ uint16_t subghz_history_get_last_index(SubGhzHistory* instance);
  * @param instance  - SubGhzHistory instance
  * @param context    - SubGhzProtocolCommon context
  * @param preset    - SubGhzRadioPreset preset
+ * @param rssi      - RSSI of signal in dBm, 0 if unknown
  * @return bool;
  */
 bool subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset);
+    SubGhzRadioPreset* preset,
+    float rssi);
+
+/** Move older items from RAM to SD card
+ *
+ * Does SD card I/O, call it from GUI thread, not from decoder callback.
+ * Items are not added while RAM window is full.
+ * 
+ * @param instance  - SubGhzHistory instance
+ */
+void subghz_history_flush(SubGhzHistory* instance);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * 
+ * Data is a copy, valid until next call
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
@@ -20,6 +20,7 @@
 #define SUBGHZ_LAST_SETTING_FIELD_EXTERNAL_MODULE_ENABLED "External"
 #define SUBGHZ_LAST_SETTING_FIELD_EXTERNAL_MODULE_POWER "ExtPower"
 #define SUBGHZ_LAST_SETTING_FIELD_TIMESTAMP_FILE_NAMES "TimestampNames"
+#define SUBGHZ_LAST_SETTING_FIELD_BINARY_RAW "BinaryRaw"
 
 SubGhzLastSettings* subghz_last_settings_alloc(void) {
     SubGhzLastSettings* instance = malloc(sizeof(SubGhzLastSettings));
@@ -47,6 +48,7 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
     bool temp_external_module_enabled = false;
     bool temp_external_module_power_5v_disable = false;
     bool temp_timestamp_file_names = false;
+    bool temp_binary_raw = false;
     //int32_t temp_preset = 0;
     bool frequency_analyzer_feedback_level_was_read = false;
     bool frequency_analyzer_trigger_was_read = false;
@@ -83,6 +85,8 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
             SUBGHZ_LAST_SETTING_FIELD_TIMESTAMP_FILE_NAMES,
             (bool*)&temp_timestamp_file_names,
             1);
+        flipper_format_read_bool(
+            fff_data_file, SUBGHZ_LAST_SETTING_FIELD_BINARY_RAW, (bool*)&temp_binary_raw, 1);
 
     } else {
         FURI_LOG_E(TAG, "Error open file %s", SUBGHZ_LAST_SETTINGS_PATH);
@@ -97,6 +101,7 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
         instance->frequency_analyzer_trigger = SUBGHZ_LAST_SETTING_FREQUENCY_ANALYZER_TRIGGER;
         instance->external_module_enabled = false;
         instance->timestamp_file_names = false;
+        instance->binary_raw = false;
 
     } else {
         instance->frequency = temp_frequency;
@@ -119,6 +124,8 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
 
         instance->timestamp_file_names = temp_timestamp_file_names;
 
+        instance->binary_raw = temp_binary_raw;
+
         // Set globally
         furi_hal_subghz_set_timestamp_file_names(instance->timestamp_file_names);
 
@@ -210,6 +217,10 @@ bool subghz_last_settings_save(SubGhzLastSettings* instance) {
                1)) {
             break;
         }
+        if(!flipper_format_insert_or_update_bool(
+               file, SUBGHZ_LAST_SETTING_FIELD_BINARY_RAW, &instance->binary_raw, 1)) {
+            break;
+        }
         saved = true;
     } while(0);
 
@@ -13,6 +13,7 @@ typedef struct {
     bool external_module_enabled;
     bool external_module_power_5v_disable;
     bool timestamp_file_names;
+    bool binary_raw;
 } SubGhzLastSettings;
 
 SubGhzLastSettings* subghz_last_settings_alloc(void);
@@ -5,7 +5,6 @@
 #include <input/input.h>
 #include <gui/elements.h>
 #include <assets_icons.h>
-#include <m-array.h>
 
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX 111
@@ -17,23 +16,6 @@
 #define SCROLL_INTERVAL (606)
 #define SCROLL_DELAY (2)
 
-typedef struct {
-    FuriString* item_str;
-    FuriString* time;
-    uint8_t type;
-} SubGhzReceiverMenuItem;
-
-ARRAY_DEF(SubGhzReceiverMenuItemArray, SubGhzReceiverMenuItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzReceiverMenuItemArray_t() \
-    ARRAY_OPLIST(SubGhzReceiverMenuItemArray, M_POD_OPLIST)
-
-struct SubGhzReceiverHistory {
-    SubGhzReceiverMenuItemArray_t data;
-};
-
-typedef struct SubGhzReceiverHistory SubGhzReceiverHistory;
-
 static const Icon* ReceiverItemIcons[] = {
     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
     [SubGhzProtocolTypeStatic] = &I_Static_9x7,
@@ -63,7 +45,8 @@ typedef struct {
     FuriString* preset_str;
     FuriString* history_stat_str;
     FuriString* progress_str;
-    SubGhzReceiverHistory* history;
+    SubGhzViewReceiverItemCallback item_callback;
+    void* item_context;
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -148,27 +131,34 @@ static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiv
         true);
 }
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_item_callback(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type) {
+    SubGhzViewReceiverItemCallback callback,
+    void* context) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItem* item_menu =
-                SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->time = furi_string_alloc_set(time);
-            item_menu->item_str = furi_string_alloc_set(name);
-            item_menu->type = type;
-            if((model->idx == model->history_item - 1)) {
-                model->history_item++;
-                model->idx++;
-            } else {
-                model->history_item++;
+            model->item_callback = callback;
+            model->item_context = context;
+        },
+        false);
+}
+
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count) {
+    furi_assert(subghz_receiver);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            // Keep selection on last item when new items arrive
+            if(model->history_item != 0 && count > model->history_item &&
+               model->idx == model->history_item - 1) {
+                model->idx = count - 1;
             }
+            model->history_item = count;
+            if(model->idx >= count) model->idx = count ? count - 1 : 0;
         },
         true);
     subghz_view_receiver_update_offset(subghz_receiver);
@@ -241,26 +231,22 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
 
     bool scrollbar = model->history_item > 4;
     FuriString* str_buff = furi_string_alloc();
+    FuriString* time_buff = furi_string_alloc();
 
-    if(!model->nodraw) {
-        SubGhzReceiverMenuItem* item_menu;
-
+    if(!model->nodraw && model->item_callback) {
         for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
             size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-            item_menu = SubGhzReceiverMenuItemArray_get(model->history->data, idx);
-            if(item_menu == NULL) {
+            uint8_t type = 0;
+            model->item_callback(model->item_context, idx, str_buff, time_buff, &type);
+            if(type == 0) {
                 break;
             }
-            if(item_menu->type == 0) {
-                break;
-            }
-            furi_string_set(str_buff, item_menu->item_str);
             size_t scroll_counter = model->scroll_counter;
             if(model->idx == idx) {
                 subghz_view_receiver_draw_frame(canvas, i, scrollbar);
                 if(scroll_counter < SCROLL_DELAY) {
                     // Show time of signal one moment
-                    furi_string_set(str_buff, item_menu->time);
+                    furi_string_set(str_buff, time_buff);
                     scroll_counter = 0;
                 } else {
                     scroll_counter -= SCROLL_DELAY;
@@ -269,7 +255,7 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
                 canvas_set_color(canvas, ColorBlack);
                 scroll_counter = 0;
             }
-            canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
+            canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[type]);
             elements_scrollable_text_line(
                 canvas,
                 15,
@@ -280,12 +266,14 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
                 (model->idx != idx),
                 false);
             furi_string_reset(str_buff);
+            furi_string_reset(time_buff);
         }
         if(scrollbar) {
             elements_scrollbar_pos(canvas, 128, 0, 49, model->idx, model->history_item);
         }
     }
     furi_string_free(str_buff);
+    furi_string_free(time_buff);
 
     canvas_set_color(canvas, ColorBlack);
 
@@ -520,17 +508,10 @@ void subghz_view_receiver_exit(void* context) {
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
 
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
-                model->nodraw = false;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
+            model->nodraw = false;
         },
         false);
     furi_timer_stop(subghz_receiver->timer);
@@ -566,8 +547,6 @@ SubGhzViewReceiver* subghz_view_receiver_alloc() {
             model->progress_str = furi_string_alloc();
             model->bar_show = SubGhzViewReceiverBarShowDefault;
             model->nodraw = false;
-            model->history = malloc(sizeof(SubGhzReceiverHistory));
-            SubGhzReceiverMenuItemArray_init(model->history->data);
         },
         true);
     subghz_receiver->timer =
@@ -588,14 +567,6 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
             furi_string_free(model->progress_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
         },
         false);
     furi_timer_free(subghz_receiver->timer);
@@ -623,23 +594,6 @@ void subghz_view_receiver_delete_element_callback(SubGhzViewReceiver* subghz_rec
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItemArray_it_t it;
-            // SubGhzReceiverMenuItem* target_item =
-            //     SubGhzReceiverMenuItemArray_get(model->history->data, model->idx);
-            SubGhzReceiverMenuItemArray_it_last(it, model->history->data);
-            while(!SubGhzReceiverMenuItemArray_end_p(it)) {
-                SubGhzReceiverMenuItem* item = SubGhzReceiverMenuItemArray_ref(it);
-
-                if(it->index == (size_t)(model->idx)) {
-                    furi_string_free(item->item_str);
-                    furi_string_free(item->time);
-                    item->type = 0;
-                    SubGhzReceiverMenuItemArray_remove(model->history->data, it);
-                }
-
-                SubGhzReceiverMenuItemArray_previous(it);
-            }
-
             if(model->history_item == 5) {
                 if(model->idx >= 2) {
                     model->idx = model->history_item - 1;
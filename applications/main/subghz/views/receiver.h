@@ -8,6 +8,21 @@ typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
 typedef void (*SubGhzViewReceiverCallback)(SubGhzCustomEvent event, void* context);
 
+/** Menu item source, called from draw callback for visible items only
+ *
+ * @param context  callback context
+ * @param idx      item index
+ * @param name     item string output
+ * @param time     item time output
+ * @param type     protocol type output, 0 stops drawing
+ */
+typedef void (*SubGhzViewReceiverItemCallback)(
+    void* context,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time,
+    uint8_t* type);
+
 void subghz_view_receiver_set_mode(
     SubGhzViewReceiver* subghz_receiver,
     SubGhzViewReceiverMode mode);
@@ -37,11 +52,12 @@ void subghz_view_receiver_add_data_progress(
     SubGhzViewReceiver* subghz_receiver,
     const char* progress_str);
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_item_callback(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type);
+    SubGhzViewReceiverItemCallback callback,
+    void* context);
+
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
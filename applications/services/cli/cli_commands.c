@@ -261,6 +261,20 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     }
 }
 
+void cli_command_sysctl_log_async(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    if(!furi_string_cmp(args, "0")) {
+        furi_log_set_async(false);
+        printf("Async log disabled.");
+    } else if(!furi_string_cmp(args, "1")) {
+        furi_log_set_async(true);
+        printf("Async log enabled.");
+    } else {
+        cli_print_usage("sysctl log_async", "<1|0>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_sysctl_print_usage() {
     printf("Usage:\r\n");
     printf("sysctl <cmd> <args>\r\n");
@@ -272,6 +286,7 @@ void cli_command_sysctl_print_usage() {
 #else
     printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
 #endif
+    printf("\tlog_async <0|1>\t - Format log records in background thread\r\n");
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -294,6 +309,11 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "log_async") == 0) {
+            cli_command_sysctl_log_async(cli, args, context);
+            break;
+        }
+
         cli_command_sysctl_print_usage();
     } while(false);
 
@@ -413,6 +433,54 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    size_t free_heap = memmgr_get_free_heap();
+    size_t max_block = memmgr_heap_get_max_free_block();
+    printf("Heap fragmentation: %zu%%\r\n", free_heap ? 100 - max_block * 100 / free_heap : 0);
+
+    MemmgrHeapLatency slab_latency, heap_latency;
+    memmgr_heap_get_latency(&slab_latency, &heap_latency);
+    const MemmgrHeapLatency* latencies[] = {&slab_latency, &heap_latency};
+    const char* latency_names[] = {"Slab", "Heap"};
+    for(size_t i = 0; i < COUNT_OF(latencies); i++) {
+        printf(
+            "%s malloc: %lu calls, avg %lu, max %lu cycles\r\n",
+            latency_names[i],
+            latencies[i]->count,
+            latencies[i]->count ? (uint32_t)(latencies[i]->cycles_total / latencies[i]->count) :
+                                  0,
+            latencies[i]->cycles_max);
+    }
+
+    MemmgrSlabStats slab_stats;
+    if(memmgr_heap_get_slab_stats(&slab_stats)) {
+        printf(
+            "Slab pages: %zu free of %zu, %u bytes each\r\n",
+            slab_stats.pages_free,
+            slab_stats.pages_total,
+            MEMMGR_SLAB_PAGE_SIZE);
+        printf(
+            "%-6s %-6s %-8s %-10s %-10s %s\r\n",
+            "Size",
+            "Pages",
+            "Used",
+            "Allocs",
+            "Waste",
+            "Fallbacks");
+        for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+            MemmgrSlabClassStats* size_class = &slab_stats.classes[i];
+            uint32_t waste =
+                size_class->allocations * size_class->object_size - size_class->requested;
+            printf(
+                "%-6u %-6u %-8lu %-10lu %-10lu %lu\r\n",
+                size_class->object_size,
+                size_class->pages,
+                size_class->objects_used,
+                size_class->allocations,
+                waste,
+                size_class->fallbacks);
+        }
+    }
 }
 
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
@@ -423,6 +491,41 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+void cli_command_free_threads(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(args);
+    UNUSED(context);
+
+    const uint8_t threads_num_max = 32;
+    FuriThreadId threads_ids[threads_num_max];
+    uint8_t thread_num = furi_thread_enumerate(threads_ids, threads_num_max);
+
+    printf("%-20s %-8s %-8s %-8s", "Name", "Live", "Peak", "Allocs");
+    for(size_t i = 0; i < MEMMGR_HEAP_HISTOGRAM_SIZE - 1; i++) {
+        printf(" <=%-5u", 16U << i);
+    }
+    printf(" >%-6u\r\n", 16U << (MEMMGR_HEAP_HISTOGRAM_SIZE - 2));
+
+    uint8_t traced_num = 0;
+    for(uint8_t i = 0; i < thread_num; i++) {
+        MemmgrHeapThreadStats stats;
+        if(!memmgr_heap_get_thread_stats(threads_ids[i], &stats)) continue;
+        traced_num++;
+
+        printf(
+            "%-20s %-8zu %-8zu %-8zu",
+            furi_thread_get_name(threads_ids[i]),
+            stats.live,
+            stats.peak,
+            stats.allocations);
+        for(size_t j = 0; j < MEMMGR_HEAP_HISTOGRAM_SIZE; j++) {
+            printf(" %-7lu", stats.histogram[j]);
+        }
+        printf("\r\n");
+    }
+    printf("\r\nTraced: %d of %d", traced_num, thread_num);
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -462,6 +565,8 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(
+        cli, "free_threads", CliCommandFlagParallelSafe, cli_command_free_threads, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
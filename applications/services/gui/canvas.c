@@ -9,6 +9,8 @@
 #include <u8g2_glue.h>
 #include <cfw.h>
 
+#define CANVAS_DISPLAY_BUFFER_SIZE (128 * 64 / 8)
+
 const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontPrimary] = {.leading_default = 12, .leading_min = 11, .height = 8, .descender = 2},
     [FontSecondary] = {.leading_default = 11, .leading_min = 9, .height = 7, .descender = 2},
@@ -20,6 +22,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    canvas->display_shadow = malloc(CANVAS_DISPLAY_BUFFER_SIZE);
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
@@ -39,6 +42,7 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    free(canvas->display_shadow);
     free(canvas);
 }
 
@@ -54,7 +58,50 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    const uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    const uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+    const size_t page_size = tile_width * 8;
+    furi_assert(page_size * tile_height == CANVAS_DISPLAY_BUFFER_SIZE);
+
+    // Send only changed tile span of every page
+    for(uint8_t ty = 0; ty < tile_height; ty++) {
+        const uint8_t* page = &buffer[ty * page_size];
+        uint8_t* shadow = &canvas->display_shadow[ty * page_size];
+        uint8_t first = 0;
+        uint8_t last = tile_width;
+        if(canvas->display_shadow_valid) {
+            while(first < tile_width && !memcmp(&page[first * 8], &shadow[first * 8], 8)) {
+                first++;
+            }
+            if(first == tile_width) continue;
+            while(!memcmp(&page[(last - 1) * 8], &shadow[(last - 1) * 8], 8)) {
+                last--;
+            }
+        }
+
+        u8g2_UpdateDisplayArea(&canvas->fb, first, ty, last - first, 1);
+        memcpy(&shadow[first * 8], &page[first * 8], (last - first) * 8);
+        canvas->bytes_committed += (last - first) * 8;
+    }
+    canvas->display_shadow_valid = true;
+}
+
+void canvas_commit_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->display_shadow_valid = false;
+}
+
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(canvas);
+    u8g2_SetClipWindow(&canvas->fb, x, y, x + width, y + height);
+    canvas->clipped = true;
+}
+
+void canvas_clip_reset(Canvas* canvas) {
+    furi_assert(canvas);
+    u8g2_SetMaxClipWindow(&canvas->fb);
+    canvas->clipped = false;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -114,7 +161,18 @@ const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font fo
 
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
-    if(CFW_SETTINGS()->dark_mode) {
+    if(canvas->clipped) {
+        // Buffer clear ignores clip window, box is clipped
+        uint8_t color = u8g2_GetDrawColor(&canvas->fb);
+        u8g2_SetDrawColor(&canvas->fb, CFW_SETTINGS()->dark_mode ? 1 : 0);
+        u8g2_DrawBox(
+            &canvas->fb,
+            canvas->fb.clip_x0,
+            canvas->fb.clip_y0,
+            canvas->fb.clip_x1 - canvas->fb.clip_x0,
+            canvas->fb.clip_y1 - canvas->fb.clip_y0);
+        u8g2_SetDrawColor(&canvas->fb, color);
+    } else if(CFW_SETTINGS()->dark_mode) {
         u8g2_FillBuffer(&canvas->fb);
     } else {
         u8g2_ClearBuffer(&canvas->fb);
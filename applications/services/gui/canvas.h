@@ -138,6 +138,8 @@ uint8_t canvas_current_font_width(const Canvas* canvas);
 const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font font);
 
 /** Clear canvas
+ *
+ * When GUI redraws only part of the screen, only that part is cleared.
  *
  * @param      canvas  Canvas instance
  */
@@ -23,6 +23,10 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    uint8_t* display_shadow; /**< buffer content as sent to display */
+    bool display_shadow_valid;
+    bool clipped; /**< clip window set, canvas_clear is limited to it */
+    uint32_t bytes_committed; /**< bytes sent to display since init */
 };
 
 /** Allocate memory and initialize canvas
@@ -53,6 +57,34 @@ uint8_t* canvas_get_buffer(Canvas* canvas);
  */
 size_t canvas_get_buffer_size(const Canvas* canvas);
 
+/** Force next commit to send whole buffer
+ *
+ * Use when display memory may differ from last committed buffer, for example
+ * after controller is initialized again with u8x8_d_st756x_init
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_commit_invalidate(Canvas* canvas);
+
+/** Limit drawing to area of real screen buffer
+ *
+ * Everything drawn outside of area is discarded, canvas_clear clears only
+ * the area.
+ *
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate
+ * @param      y       y coordinate
+ * @param      width   width
+ * @param      height  height
+ */
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/** Remove drawing area limit
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_clip_reset(Canvas* canvas);
+
 /** Set drawing region relative to real screen buffer
  *
  * @param      canvas    Canvas instance
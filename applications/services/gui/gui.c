@@ -3,6 +3,7 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include <furi_hal_rtc.h>
+#include <cfw.h>
 //#include <storage/storage.h>
 //#include <storage/storage_i.h>
 
@@ -39,8 +40,68 @@ uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer) {
     return ret;
 }
 
+static bool gui_layer_is_status_bar(GuiLayer layer) {
+    return layer >= GuiLayerStatusBarTop && layer <= GuiLayerStatusBarRightSlim;
+}
+
+static void gui_mark_dirty(Gui* gui, uint8_t dirty) {
+    FURI_CRITICAL_ENTER();
+    gui->dirty |= dirty;
+    FURI_CRITICAL_EXIT();
+    if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+}
+
 void gui_update(Gui* gui) {
     furi_assert(gui);
+    gui_mark_dirty(gui, GuiDirtyFull | GuiDirtyStatusBar);
+}
+
+void gui_update_view_port(Gui* gui, ViewPort* view_port) {
+    furi_assert(gui);
+    furi_assert(view_port);
+    gui_mark_dirty(
+        gui, gui_layer_is_status_bar(view_port->layer) ? GuiDirtyStatusBar : GuiDirtyFull);
+}
+
+void gui_update_view_port_rect(
+    Gui* gui,
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(gui);
+    furi_assert(view_port);
+
+    if(gui_layer_is_status_bar(view_port->layer)) {
+        gui_update_view_port(gui, view_port);
+        return;
+    }
+    if(!width || !height || x >= GUI_DISPLAY_WIDTH || y >= GUI_DISPLAY_HEIGHT) {
+        return;
+    }
+
+    const GuiRect rect = {
+        .x0 = x,
+        .y0 = y,
+        .x1 = MIN(x + width, GUI_DISPLAY_WIDTH),
+        .y1 = MIN(y + height, GUI_DISPLAY_HEIGHT),
+    };
+
+    FURI_CRITICAL_ENTER();
+    if(!(gui->dirty & GuiDirtyRect)) {
+        gui->dirty_view_port = view_port;
+        gui->dirty_rect = rect;
+        gui->dirty |= GuiDirtyRect;
+    } else if(gui->dirty_view_port == view_port) {
+        gui->dirty_rect.x0 = MIN(gui->dirty_rect.x0, rect.x0);
+        gui->dirty_rect.y0 = MIN(gui->dirty_rect.y0, rect.y0);
+        gui->dirty_rect.x1 = MAX(gui->dirty_rect.x1, rect.x1);
+        gui->dirty_rect.y1 = MAX(gui->dirty_rect.y1, rect.y1);
+    } else {
+        gui->dirty |= GuiDirtyFull;
+    }
+    FURI_CRITICAL_EXIT();
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
 
@@ -54,13 +115,18 @@ void gui_input_events_callback(const void* value, void* ctx) {
     furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_INPUT);
 }
 
+static void gui_view_port_draw(Gui* gui, ViewPort* view_port) {
+    gui->stats.callbacks++;
+    view_port_draw(view_port, gui->canvas);
+}
+
 // Only Fullscreen supports vertical display for now
 static bool gui_redraw_fs(Gui* gui) {
     canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
     canvas_frame_set(gui->canvas, 0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT);
     ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]);
     if(view_port) {
-        view_port_draw(view_port, gui->canvas);
+        gui_view_port_draw(gui, view_port);
         return true;
     } else {
         return false;
@@ -125,7 +191,7 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
             // ViewPort draw
             canvas_frame_set(
                 gui->canvas, GUI_STATUS_BAR_X, GUI_STATUS_BAR_Y, width, GUI_STATUS_BAR_HEIGHT);
-            view_port_draw(view_port, gui->canvas);
+            gui_view_port_draw(gui, view_port);
         }
         ViewPortArray_next(it);
     }
@@ -151,7 +217,7 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
             // ViewPort draw
             canvas_frame_set(
                 gui->canvas, x + 1, GUI_STATUS_BAR_Y + 1, width, GUI_STATUS_BAR_WORKAREA_HEIGHT);
-            view_port_draw(view_port, gui->canvas);
+            gui_view_port_draw(gui, view_port);
         }
         ViewPortArray_next(it);
     }
@@ -181,7 +247,7 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
             // ViewPort draw
             canvas_frame_set(
                 gui->canvas, x, GUI_STATUS_BAR_Y + 2, width, GUI_STATUS_BAR_WORKAREA_HEIGHT);
-            view_port_draw(view_port, gui->canvas);
+            gui_view_port_draw(gui, view_port);
         }
         ViewPortArray_next(it);
     }
@@ -229,7 +295,7 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
             // ViewPort draw
             canvas_frame_set(
                 gui->canvas, x + 1, GUI_STATUS_BAR_Y + 1, width, GUI_STATUS_BAR_WORKAREA_HEIGHT);
-            view_port_draw(view_port, gui->canvas);
+            gui_view_port_draw(gui, view_port);
             // Recalculate next position
             left_slim_used += (width + 2);
             x += (width + 2);
@@ -259,7 +325,7 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
             // ViewPort draw
             canvas_frame_set(
                 gui->canvas, x, GUI_STATUS_BAR_Y + 2, width, GUI_STATUS_BAR_WORKAREA_HEIGHT);
-            view_port_draw(view_port, gui->canvas);
+            gui_view_port_draw(gui, view_port);
             // Recalculate next position
             left_used += (width + 2);
             x += (width + 2);
@@ -314,7 +380,7 @@ static bool gui_redraw_window(Gui* gui) {
     canvas_frame_set(gui->canvas, GUI_WINDOW_X, GUI_WINDOW_Y, GUI_WINDOW_WIDTH, GUI_WINDOW_HEIGHT);
     ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerWindow]);
     if(view_port) {
-        view_port_draw(view_port, gui->canvas);
+        gui_view_port_draw(gui, view_port);
         return true;
     }
     return false;
@@ -325,13 +391,158 @@ static bool gui_redraw_desktop(Gui* gui) {
     canvas_frame_set(gui->canvas, 0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT);
     ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerDesktop]);
     if(view_port) {
-        view_port_draw(view_port, gui->canvas);
+        gui_view_port_draw(gui, view_port);
         return true;
     }
 
     return false;
 }
 
+static bool gui_status_bar_cache_usable(Gui* gui) {
+    // Cache keeps unrotated status bar pages drawn over blank background
+    return !furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient) &&
+           gui->status_bar_cache_dark_mode == CFW_SETTINGS()->dark_mode;
+}
+
+static void gui_status_bar_cache_store(Gui* gui) {
+    memcpy(gui->status_bar_cache, canvas_get_buffer(gui->canvas), GUI_STATUS_BAR_CACHE_SIZE);
+    gui->status_bar_cache_dark_mode = CFW_SETTINGS()->dark_mode;
+    gui->status_bar_cache_valid = !furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient);
+}
+
+static void gui_status_bar_cache_restore(Gui* gui) {
+    uint8_t* buffer = canvas_get_buffer(gui->canvas);
+    memcpy(buffer, gui->status_bar_cache, GUI_DISPLAY_WIDTH);
+    // Lower rows of second page belong to window
+    for(size_t i = GUI_DISPLAY_WIDTH; i < GUI_STATUS_BAR_CACHE_SIZE; i++) {
+        buffer[i] = (buffer[i] & ~GUI_STATUS_BAR_CACHE_PAGE1_MASK) |
+                    (gui->status_bar_cache[i] & GUI_STATUS_BAR_CACHE_PAGE1_MASK);
+    }
+}
+
+/** Status bar over window, window never draws in status bar area */
+static void gui_redraw_status_bar_over_window(Gui* gui) {
+    if(gui->status_bar_cache_valid && gui_status_bar_cache_usable(gui)) {
+        gui_status_bar_cache_restore(gui);
+        gui->stats.status_bar_cached++;
+    } else {
+        gui_redraw_status_bar(gui, false);
+        gui_status_bar_cache_store(gui);
+    }
+}
+
+/** Clear area in display coordinates and restore canvas defaults */
+static void gui_clear_area(Gui* gui, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
+    canvas_frame_set(gui->canvas, 0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT);
+    canvas_set_color(gui->canvas, ColorWhite);
+    canvas_draw_box(gui->canvas, x, y, width, height);
+    canvas_set_color(gui->canvas, ColorBlack);
+    canvas_set_font(gui->canvas, FontSecondary);
+    canvas_set_font_direction(gui->canvas, CanvasDirectionLeftToRight);
+}
+
+static ViewPort* gui_main_view_port(Gui* gui, GuiLayer* layer) {
+    ViewPort* view_port = NULL;
+    *layer = GuiLayerDesktop;
+    if(!gui->lockdown) {
+        *layer = GuiLayerFullscreen;
+        view_port = gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]);
+        if(!view_port) {
+            *layer = GuiLayerWindow;
+            view_port = gui_view_port_find_enabled(gui->layers[GuiLayerWindow]);
+        }
+        if(!view_port) *layer = GuiLayerDesktop;
+    }
+    if(!view_port) {
+        view_port = gui_view_port_find_enabled(gui->layers[GuiLayerDesktop]);
+    }
+    return view_port;
+}
+
+typedef enum {
+    GuiRedrawNone,
+    GuiRedrawPartial,
+    GuiRedrawFull,
+} GuiRedrawType;
+
+/** Redraw only what changed on top of previous frame
+ *
+ * @return     GuiRedrawFull if previous frame can't be reused
+ */
+static GuiRedrawType gui_redraw_partial(
+    Gui* gui,
+    uint8_t dirty,
+    ViewPort* dirty_view_port,
+    const GuiRect* dirty_rect) {
+    GuiLayer layer;
+    ViewPort* view_port = gui_main_view_port(gui, &layer);
+
+    if((dirty & GuiDirtyFull) || gui->lockdown || gui->drawn_lockdown ||
+       view_port != gui->drawn_view_port || !view_port ||
+       view_port->orientation != gui->drawn_orientation ||
+       furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient)) {
+        return GuiRedrawFull;
+    }
+
+    // Desktop is overlapped by status bar
+    bool status_bar_dirty = (dirty & GuiDirtyStatusBar) && layer != GuiLayerFullscreen;
+    if(status_bar_dirty && layer == GuiLayerDesktop) {
+        return GuiRedrawFull;
+    }
+
+    bool rect_dirty = (dirty & GuiDirtyRect) && dirty_view_port == view_port;
+    if(rect_dirty) {
+        if(view_port->orientation != ViewPortOrientationHorizontal) {
+            return GuiRedrawFull;
+        }
+
+        uint8_t frame_y = layer == GuiLayerWindow ? GUI_WINDOW_Y : 0;
+        uint8_t x0 = dirty_rect->x0;
+        uint8_t x1 = dirty_rect->x1;
+        uint8_t y0 = MIN(dirty_rect->y0 + frame_y, GUI_DISPLAY_HEIGHT);
+        uint8_t y1 = MIN(dirty_rect->y1 + frame_y, GUI_DISPLAY_HEIGHT);
+        if(layer == GuiLayerDesktop && y0 < GUI_STATUS_BAR_HEIGHT) {
+            return GuiRedrawFull;
+        }
+
+        canvas_clip_set(gui->canvas, x0, y0, x1 - x0, y1 - y0);
+        gui_clear_area(gui, x0, y0, x1 - x0, y1 - y0);
+        canvas_frame_set(
+            gui->canvas, 0, frame_y, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT - frame_y);
+        gui_view_port_draw(gui, view_port);
+        canvas_clip_reset(gui->canvas);
+    }
+
+    if(status_bar_dirty) {
+        gui_clear_area(gui, 0, 0, GUI_STATUS_BAR_WIDTH, GUI_STATUS_BAR_HEIGHT);
+        gui_redraw_status_bar_over_window(gui);
+    }
+
+    return (rect_dirty || status_bar_dirty) ? GuiRedrawPartial : GuiRedrawNone;
+}
+
+static void gui_redraw_full(Gui* gui) {
+    canvas_reset(gui->canvas);
+
+    if(gui->lockdown) {
+        gui_redraw_desktop(gui);
+        bool need_attention =
+            (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
+             gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
+        gui_redraw_status_bar(gui, need_attention);
+    } else {
+        if(!gui_redraw_fs(gui)) {
+            if(gui_redraw_window(gui)) {
+                gui_redraw_status_bar_over_window(gui);
+            } else {
+                gui_redraw_desktop(gui);
+                gui_redraw_status_bar(gui, false);
+            }
+        }
+    }
+}
+
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
@@ -339,23 +550,32 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
-        canvas_reset(gui->canvas);
+        uint32_t cycles_start = DWT->CYCCNT;
+        uint32_t bytes_start = gui->canvas->bytes_committed;
 
-        if(gui->lockdown) {
-            gui_redraw_desktop(gui);
-            bool need_attention =
-                (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
-                 gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
-            gui_redraw_status_bar(gui, need_attention);
+        FURI_CRITICAL_ENTER();
+        uint8_t dirty = gui->dirty;
+        ViewPort* dirty_view_port = gui->dirty_view_port;
+        GuiRect dirty_rect = gui->dirty_rect;
+        gui->dirty = 0;
+        FURI_CRITICAL_EXIT();
+
+        if(dirty & GuiDirtyStatusBar) gui->status_bar_cache_valid = false;
+
+        GuiRedrawType type = gui_redraw_partial(gui, dirty, dirty_view_port, &dirty_rect);
+        if(type == GuiRedrawNone) break;
+        if(type == GuiRedrawFull) {
+            gui_redraw_full(gui);
         } else {
-            if(!gui_redraw_fs(gui)) {
-                if(!gui_redraw_window(gui)) {
-                    gui_redraw_desktop(gui);
-                }
-                gui_redraw_status_bar(gui, false);
-            }
+            gui->stats.partial_frames++;
         }
 
+        GuiLayer layer;
+        gui->drawn_view_port = gui_main_view_port(gui, &layer);
+        gui->drawn_orientation = gui->drawn_view_port ? gui->drawn_view_port->orientation :
+                                                        ViewPortOrientationHorizontal;
+        gui->drawn_lockdown = gui->lockdown;
+
         canvas_commit(gui->canvas);
         for
             M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
@@ -365,6 +585,10 @@ static void gui_redraw(Gui* gui) {
                     canvas_get_orientation(gui->canvas),
                     p->context);
             }
+
+        gui->stats.frames++;
+        gui->stats.bytes_pushed += gui->canvas->bytes_committed - bytes_start;
+        gui->stats_cycles += DWT->CYCCNT - cycles_start;
     } while(false);
 
     gui_unlock(gui);
@@ -489,6 +713,7 @@ void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
     }
     // Add view port and link with gui
     ViewPortArray_push_back(gui->layers[layer], view_port);
+    view_port->layer = layer;
     view_port_gui_set(view_port, gui);
     gui_unlock(gui);
 
@@ -625,6 +850,40 @@ void gui_set_hide_statusbar(Gui* gui, bool hidden) {
     gui_update(gui);
 }
 
+void gui_get_redraw_stats(Gui* gui, GuiRedrawStats* stats) {
+    furi_assert(gui);
+    furi_assert(stats);
+
+    gui_lock(gui);
+    *stats = gui->stats;
+    stats->time_us = gui->stats_cycles / furi_hal_cortex_instructions_per_microsecond();
+    CompressIconCacheStats icon_cache;
+    compress_icon_cache_get_stats(gui->canvas->compress_icon, &icon_cache);
+    stats->icon_cache_hits = icon_cache.hits;
+    stats->icon_cache_misses = icon_cache.misses;
+    stats->icon_cache_size = icon_cache.size;
+    gui_unlock(gui);
+}
+
+void gui_reset_redraw_stats(Gui* gui) {
+    furi_assert(gui);
+
+    gui_lock(gui);
+    memset(&gui->stats, 0, sizeof(GuiRedrawStats));
+    gui->stats_cycles = 0;
+    compress_icon_cache_reset_stats(gui->canvas->compress_icon);
+    gui_unlock(gui);
+}
+
+void gui_invalidate_display(Gui* gui) {
+    furi_assert(gui);
+
+    gui_lock(gui);
+    canvas_commit_invalidate(gui->canvas);
+    gui_unlock(gui);
+    gui_update(gui);
+}
+
 void gui_set_lockdown(Gui* gui, bool lockdown) {
     furi_assert(gui);
 
@@ -675,6 +934,7 @@ Gui* gui_alloc() {
     // Drawing canvas
     gui->canvas = canvas_init();
     CanvasCallbackPairArray_init(gui->canvas_callback_pair);
+    gui->status_bar_cache = malloc(GUI_STATUS_BAR_CACHE_SIZE);
 
     // Input
     gui->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
@@ -36,6 +36,19 @@ typedef void (*GuiCanvasCommitCallback)(
     CanvasOrientation orientation,
     void* context);
 
+/** Gui redraw cost counters */
+typedef struct {
+    uint32_t frames; /**< Redraws done */
+    uint32_t partial_frames; /**< Redraws limited to dirty area or status bar */
+    uint32_t callbacks; /**< ViewPort draw callbacks invoked */
+    uint32_t status_bar_cached; /**< Redraws that reused cached status bar */
+    uint32_t bytes_pushed; /**< Bytes sent to display */
+    uint32_t time_us; /**< Time spent in redraw and commit */
+    uint32_t icon_cache_hits; /**< Icon frames taken from decoded icon cache */
+    uint32_t icon_cache_misses; /**< Icon frames decompressed */
+    uint32_t icon_cache_size; /**< Bytes held by decoded icon cache */
+} GuiRedrawStats;
+
 #define RECORD_GUI "gui"
 
 typedef struct Gui Gui;
@@ -112,6 +125,28 @@ size_t gui_get_framebuffer_size(const Gui* gui);
  */
 void gui_set_hide_statusbar(Gui* gui, bool hidden);
 
+/** Get redraw cost counters
+ *
+ * @param      gui    Gui instance
+ * @param      stats  GuiRedrawStats to fill
+ */
+void gui_get_redraw_stats(Gui* gui, GuiRedrawStats* stats);
+
+/** Reset redraw cost counters
+ *
+ * @param      gui   Gui instance
+ */
+void gui_reset_redraw_stats(Gui* gui);
+
+/** Redraw and send whole frame to display
+ *
+ * GUI sends only what changed since previous frame. Call when display memory
+ * no longer matches it, for example after display controller re-init.
+ *
+ * @param      gui   Gui instance
+ */
+void gui_invalidate_display(Gui* gui);
+
 /** Set lockdown mode
  *
  * When lockdown mode is enabled, only GuiLayerDesktop is shown.
@@ -0,0 +1,77 @@
+#include <furi.h>
+#include <cli/cli.h>
+#include <lib/toolbox/args.h>
+#include "gui.h"
+
+static void gui_cli_print_usage() {
+    printf("Usage:\r\n");
+    printf("gui <cmd>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tstats\t - Show redraw cost counters\r\n");
+    printf("\treset\t - Reset redraw cost counters\r\n");
+}
+
+static void gui_cli_stats(Gui* gui) {
+    GuiRedrawStats stats;
+    gui_get_redraw_stats(gui, &stats);
+
+    printf("Frames: %lu\r\n", stats.frames);
+    printf("Partial frames: %lu\r\n", stats.partial_frames);
+    printf("Cached status bar: %lu\r\n", stats.status_bar_cached);
+    printf("Draw callbacks: %lu\r\n", stats.callbacks);
+    printf("Bytes pushed: %lu\r\n", stats.bytes_pushed);
+    printf("Time: %lu us\r\n", stats.time_us);
+    printf(
+        "Icon cache: %lu hits, %lu misses, %lu bytes\r\n",
+        stats.icon_cache_hits,
+        stats.icon_cache_misses,
+        stats.icon_cache_size);
+    if(stats.frames) {
+        printf(
+            "Per frame: %lu callbacks, %lu bytes, %lu us\r\n",
+            stats.callbacks / stats.frames,
+            stats.bytes_pushed / stats.frames,
+            stats.time_us / stats.frames);
+    }
+}
+
+static void gui_cli(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    Gui* gui = furi_record_open(RECORD_GUI);
+
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            gui_cli_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            gui_cli_stats(gui);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "reset") == 0) {
+            gui_reset_redraw_stats(gui);
+            break;
+        }
+
+        gui_cli_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+    furi_record_close(RECORD_GUI);
+}
+
+void gui_on_system_start() {
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, RECORD_GUI, CliCommandFlagParallelSafe, gui_cli, NULL);
+    furi_record_close(RECORD_CLI);
+#else
+    UNUSED(gui_cli);
+#endif
+}
@@ -38,6 +38,10 @@
 #define GUI_WINDOW_WIDTH GUI_DISPLAY_WIDTH
 #define GUI_WINDOW_HEIGHT (GUI_DISPLAY_HEIGHT - GUI_WINDOW_Y)
 
+/* status bar rows as stored in two display pages */
+#define GUI_STATUS_BAR_CACHE_SIZE (GUI_DISPLAY_WIDTH * 2)
+#define GUI_STATUS_BAR_CACHE_PAGE1_MASK ((1 << (GUI_STATUS_BAR_HEIGHT - 8)) - 1)
+
 #define GUI_THREAD_FLAG_DRAW (1 << 0)
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ALL (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
@@ -55,6 +59,19 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+typedef enum {
+    GuiDirtyFull = (1 << 0), /**< everything except status bar */
+    GuiDirtyStatusBar = (1 << 1),
+    GuiDirtyRect = (1 << 2), /**< only dirty_rect of dirty_view_port */
+} GuiDirty;
+
+typedef struct {
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+} GuiRect;
+
 /** Gui structure */
 struct Gui {
     // Thread and lock
@@ -69,6 +86,19 @@ struct Gui {
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
+    // Damage tracking, dirty_* are updated from any thread in critical section
+    uint8_t dirty;
+    ViewPort* dirty_view_port;
+    GuiRect dirty_rect;
+    ViewPort* drawn_view_port;
+    ViewPortOrientation drawn_orientation;
+    bool drawn_lockdown;
+    uint8_t* status_bar_cache;
+    bool status_bar_cache_valid;
+    bool status_bar_cache_dark_mode;
+    GuiRedrawStats stats;
+    uint64_t stats_cycles;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
@@ -84,6 +114,32 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
  */
 void gui_update(Gui* gui);
 
+/** Update GUI, request redraw of ViewPort
+ *
+ * Status bar ViewPorts don't cause main layer redraw
+ *
+ * @param      gui        Gui instance
+ * @param      view_port  ViewPort instance
+ */
+void gui_update_view_port(Gui* gui, ViewPort* view_port);
+
+/** Update GUI, request redraw of ViewPort area
+ *
+ * @param      gui        Gui instance
+ * @param      view_port  ViewPort instance
+ * @param      x          area x in ViewPort coordinates
+ * @param      y          area y in ViewPort coordinates
+ * @param      width      area width
+ * @param      height     area height
+ */
+void gui_update_view_port_rect(
+    Gui* gui,
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 void gui_input_events_callback(const void* value, void* ctx);
 
 void gui_lock(Gui* gui);
@@ -0,0 +1,696 @@
+#include "file_browser_index.h"
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <core/common_defines.h>
+#include <core/memmgr_heap.h>
+#include <cfw.h>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "BrowserIndex"
+
+#define BROWSER_INDEX_MAGIC (0x31494442UL) /* "BDI1" */
+#define BROWSER_INDEX_VERSION (1U)
+
+#define BROWSER_INDEX_FLAG_SORTED (1U << 0)
+#define BROWSER_INDEX_FLAG_DIRS_FIRST (1U << 1)
+
+#define BROWSER_INDEX_ENTRY_DIR (1U << 0)
+#define BROWSER_INDEX_ENTRY_HEADER_SIZE (6U)
+
+#define BROWSER_INDEX_BUFFER_SIZE (512U)
+#define BROWSER_INDEX_DIR_BATCH_SIZE (16U)
+#define BROWSER_INDEX_DIR_ARENA_SIZE (1024U)
+#define BROWSER_INDEX_LONG_LOAD_THRESHOLD (100U)
+
+// Bigger directories are indexed in directory order
+#define BROWSER_INDEX_SORT_ENTRIES_MAX (1024U)
+#define BROWSER_INDEX_SORT_NAMES_MAX (24U * 1024U)
+#define BROWSER_INDEX_HEAP_RESERVE (8U * 1024U)
+
+#define BROWSER_INDEX_FRESH_COUNT (8U)
+#define BROWSER_INDEX_HASH_INIT (2166136261UL)
+
+/* Index file layout, little endian:
+ *
+ *   BrowserIndexHeader
+ *   path_size chars     directory path
+ *   count entries       u8 flags, u8 name_len, u32 size, name_len chars
+ *   page table          u32 file offset of every BROWSER_INDEX_PAGE_SIZE-th entry
+ *
+ * Header is written last, interrupted build leaves invalid magic.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t count;
+    uint32_t signature;
+    uint32_t table_offset;
+    uint16_t path_size;
+} __attribute__((packed)) BrowserIndexHeader;
+
+typedef struct {
+    const char* name;
+    uint32_t name_offset;
+    uint32_t size;
+    uint8_t name_len;
+    uint8_t flags;
+    uint8_t rank;
+} BrowserIndexRecord;
+
+typedef struct {
+    BrowserIndexRecord* records;
+    size_t records_count;
+    size_t records_capacity;
+    char* names;
+    size_t names_size;
+    size_t names_capacity;
+    bool overflow;
+    uint32_t count;
+    uint32_t signature;
+} BrowserIndexBuild;
+
+// Directories checked since last storage modification, shared by all browsers
+typedef struct {
+    uint32_t path_hash;
+    uint32_t timestamp;
+} BrowserIndexFresh;
+
+static BrowserIndexFresh browser_index_fresh[BROWSER_INDEX_FRESH_COUNT];
+static size_t browser_index_fresh_next;
+
+struct BrowserIndex {
+    Storage* storage;
+    File* file;
+    FuriString* path;
+    FuriString* index_path;
+    BrowserIndexHeader header;
+    uint32_t* table;
+    bool is_open;
+
+    uint8_t buffer[BROWSER_INDEX_BUFFER_SIZE];
+    size_t buffer_size;
+    size_t buffer_position;
+    uint32_t write_offset;
+    uint32_t position;
+    char name[STORAGE_DIR_NAME_LENGTH_MAX];
+    BrowserIndexEntry entry;
+
+    StorageDirEntry dir_entries[BROWSER_INDEX_DIR_BATCH_SIZE];
+    char dir_arena[BROWSER_INDEX_DIR_ARENA_SIZE];
+};
+
+static uint32_t browser_index_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static bool browser_index_fresh_check(uint32_t path_hash, uint32_t timestamp) {
+    bool fresh = false;
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < COUNT_OF(browser_index_fresh); i++) {
+        if(browser_index_fresh[i].path_hash == path_hash &&
+           browser_index_fresh[i].timestamp == timestamp) {
+            fresh = true;
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+    return fresh;
+}
+
+static void browser_index_fresh_set(uint32_t path_hash, uint32_t timestamp) {
+    FURI_CRITICAL_ENTER();
+    size_t slot = COUNT_OF(browser_index_fresh);
+    for(size_t i = 0; i < COUNT_OF(browser_index_fresh); i++) {
+        if(browser_index_fresh[i].path_hash == path_hash) {
+            slot = i;
+            break;
+        }
+    }
+    if(slot == COUNT_OF(browser_index_fresh)) {
+        slot = browser_index_fresh_next;
+        browser_index_fresh_next = (browser_index_fresh_next + 1) % COUNT_OF(browser_index_fresh);
+    }
+    browser_index_fresh[slot].path_hash = path_hash;
+    browser_index_fresh[slot].timestamp = timestamp;
+    FURI_CRITICAL_EXIT();
+}
+
+static bool browser_index_path_is_indexed(const char* path) {
+    const size_t ext_size = strlen(STORAGE_EXT_PATH_PREFIX);
+    const size_t index_size = strlen(BROWSER_INDEX_PATH);
+    if(strncmp(path, STORAGE_EXT_PATH_PREFIX, ext_size) != 0 ||
+       (path[ext_size] != '\0' && path[ext_size] != '/')) {
+        return false;
+    }
+    // Writing index would change index folder itself
+    if(strncmp(path, BROWSER_INDEX_PATH, index_size) == 0 &&
+       (path[index_size] == '\0' || path[index_size] == '/')) {
+        return false;
+    }
+    return strlen(path) <= UINT16_MAX;
+}
+
+// Same order as furi_string_cmpi, names that differ only by case are ordered by case
+static int browser_index_record_cmp(const void* a, const void* b) {
+    const BrowserIndexRecord* record_a = a;
+    const BrowserIndexRecord* record_b = b;
+    if(record_a->rank != record_b->rank) {
+        return (int)record_a->rank - (int)record_b->rank;
+    }
+    const unsigned char* name_a = (const unsigned char*)record_a->name;
+    const unsigned char* name_b = (const unsigned char*)record_b->name;
+    for(size_t i = 0;; i++) {
+        int diff = toupper(name_a[i]) - toupper(name_b[i]);
+        if(diff != 0 || name_a[i] == '\0') {
+            return diff ? diff : strcmp(record_a->name, record_b->name);
+        }
+    }
+}
+
+static void browser_index_file_close(BrowserIndex* index) {
+    if(index->file) {
+        storage_file_close(index->file);
+        storage_file_free(index->file);
+        index->file = NULL;
+    }
+}
+
+static void browser_index_reset(BrowserIndex* index) {
+    browser_index_file_close(index);
+    free(index->table);
+    index->table = NULL;
+    index->is_open = false;
+    index->position = 0;
+}
+
+static bool browser_index_read_data(BrowserIndex* index, void* data, size_t size) {
+    uint8_t* out = data;
+    while(size) {
+        if(index->buffer_position == index->buffer_size) {
+            index->buffer_size =
+                storage_file_read(index->file, index->buffer, sizeof(index->buffer));
+            index->buffer_position = 0;
+            if(!index->buffer_size) return false;
+        }
+        size_t chunk = MIN(size, index->buffer_size - index->buffer_position);
+        memcpy(out, &index->buffer[index->buffer_position], chunk);
+        index->buffer_position += chunk;
+        out += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+static bool browser_index_write_flush(BrowserIndex* index) {
+    size_t size = index->buffer_size;
+    index->buffer_size = 0;
+    return storage_file_write(index->file, index->buffer, size) == size;
+}
+
+static bool browser_index_write_data(BrowserIndex* index, const void* data, size_t size) {
+    const uint8_t* in = data;
+    index->write_offset += size;
+    while(size) {
+        if(index->buffer_size == sizeof(index->buffer)) {
+            if(!browser_index_write_flush(index)) return false;
+        }
+        size_t chunk = MIN(size, sizeof(index->buffer) - index->buffer_size);
+        memcpy(&index->buffer[index->buffer_size], in, chunk);
+        index->buffer_size += chunk;
+        in += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+// Open index file, check header and directory path
+static bool browser_index_file_open(BrowserIndex* index, BrowserIndexHeader* header) {
+    bool result = false;
+    index->file = storage_file_alloc(index->storage);
+    index->buffer_size = 0;
+    index->buffer_position = 0;
+
+    do {
+        if(!storage_file_open(
+               index->file,
+               furi_string_get_cstr(index->index_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(!browser_index_read_data(index, header, sizeof(BrowserIndexHeader))) break;
+        if(header->magic != BROWSER_INDEX_MAGIC || header->version != BROWSER_INDEX_VERSION) {
+            break;
+        }
+        if(header->path_size != furi_string_size(index->path)) break;
+
+        const char* path = furi_string_get_cstr(index->path);
+        size_t checked = 0;
+        while(checked < header->path_size) {
+            size_t chunk = MIN(header->path_size - checked, sizeof(index->name));
+            if(!browser_index_read_data(index, index->name, chunk)) break;
+            if(memcmp(index->name, &path[checked], chunk) != 0) break;
+            checked += chunk;
+        }
+        result = (checked == header->path_size);
+    } while(false);
+
+    if(!result) {
+        browser_index_file_close(index);
+    }
+    return result;
+}
+
+// Load page table of opened index file
+static bool browser_index_table_load(BrowserIndex* index) {
+    size_t pages = (index->header.count + BROWSER_INDEX_PAGE_SIZE - 1) / BROWSER_INDEX_PAGE_SIZE;
+    index->table = malloc(MAX(pages, 1U) * sizeof(uint32_t));
+    index->table[0] = sizeof(BrowserIndexHeader) + index->header.path_size;
+
+    bool result = storage_file_seek(index->file, index->header.table_offset, true);
+    index->buffer_size = 0;
+    index->buffer_position = 0;
+    if(result && pages) {
+        result = browser_index_read_data(index, index->table, pages * sizeof(uint32_t));
+    }
+    index->position = index->header.count;
+    index->is_open = result;
+    return result;
+}
+
+static bool browser_index_build_reserve(
+    void** data,
+    size_t* capacity,
+    size_t item_size,
+    size_t needed,
+    size_t limit) {
+    if(needed <= *capacity) return true;
+
+    size_t new_capacity = MAX(*capacity * 2, 64U);
+    while(new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    new_capacity = MIN(new_capacity, limit);
+    if(new_capacity < needed ||
+       new_capacity * item_size + BROWSER_INDEX_HEAP_RESERVE > memmgr_heap_get_max_free_block()) {
+        return false;
+    }
+
+    *data = realloc(*data, new_capacity * item_size); //-V701
+    *capacity = new_capacity;
+    return true;
+}
+
+static void browser_index_build_add(
+    BrowserIndexBuild* build,
+    const char* name,
+    size_t name_len,
+    uint8_t flags,
+    uint32_t size) {
+    if(build->overflow) return;
+
+    if(!browser_index_build_reserve(
+           (void**)&build->records,
+           &build->records_capacity,
+           sizeof(BrowserIndexRecord),
+           build->records_count + 1,
+           BROWSER_INDEX_SORT_ENTRIES_MAX) ||
+       !browser_index_build_reserve(
+           (void**)&build->names,
+           &build->names_capacity,
+           sizeof(char),
+           build->names_size + name_len + 1,
+           BROWSER_INDEX_SORT_NAMES_MAX)) {
+        build->overflow = true;
+        return;
+    }
+
+    BrowserIndexRecord* record = &build->records[build->records_count++];
+    record->name_offset = build->names_size;
+    record->name_len = name_len;
+    record->flags = flags;
+    record->size = size;
+    memcpy(&build->names[build->names_size], name, name_len + 1);
+    build->names_size += name_len + 1;
+}
+
+typedef bool (*BrowserIndexEntryCallback)(
+    BrowserIndex* index,
+    const char* name,
+    size_t name_len,
+    uint8_t flags,
+    uint32_t size,
+    void* context);
+
+// Read directory, counts entries and computes listing signature
+static bool browser_index_dir_read(
+    BrowserIndex* index,
+    BrowserIndexBuild* build,
+    BrowserIndexEntryCallback entry_callback,
+    void* entry_context,
+    BrowserIndexLongLoadCallback callback,
+    void* context) {
+    File* directory = storage_file_alloc(index->storage);
+    bool result = false;
+
+    build->count = 0;
+    build->signature = BROWSER_INDEX_HASH_INIT;
+
+    if(storage_dir_open(directory, furi_string_get_cstr(index->path))) {
+        size_t read_count;
+        do {
+            read_count = storage_dir_read_many(
+                directory,
+                index->dir_entries,
+                COUNT_OF(index->dir_entries),
+                index->dir_arena,
+                sizeof(index->dir_arena));
+            for(size_t i = 0; i < read_count; i++) {
+                const StorageDirEntry* entry = &index->dir_entries[i];
+                size_t name_len = strlen(entry->name);
+                if(name_len == 0 || name_len > UINT8_MAX) continue;
+
+                uint8_t flags = file_info_is_dir(&entry->fileinfo) ? BROWSER_INDEX_ENTRY_DIR : 0;
+                uint32_t size = (uint32_t)entry->fileinfo.size;
+                build->signature =
+                    browser_index_hash(build->signature, entry->name, name_len + 1);
+                build->signature = browser_index_hash(build->signature, &flags, sizeof(flags));
+                build->signature = browser_index_hash(build->signature, &size, sizeof(size));
+                build->signature =
+                    browser_index_hash(build->signature, &entry->mtime, sizeof(entry->mtime));
+                build->count++;
+
+                if(build->count == BROWSER_INDEX_LONG_LOAD_THRESHOLD && callback) {
+                    callback(context);
+                }
+                if(entry_callback &&
+                   !entry_callback(index, entry->name, name_len, flags, size, entry_context)) {
+                    read_count = 0;
+                    break;
+                }
+            }
+        } while(read_count);
+
+        FS_Error error = storage_file_get_error(directory);
+        result = (error == FSE_OK || error == FSE_NOT_EXIST);
+    }
+
+    storage_dir_close(directory);
+    storage_file_free(directory);
+    return result;
+}
+
+static bool browser_index_build_entry(
+    BrowserIndex* index,
+    const char* name,
+    size_t name_len,
+    uint8_t flags,
+    uint32_t size,
+    void* context) {
+    UNUSED(index);
+    browser_index_build_add(context, name, name_len, flags, size);
+    return true;
+}
+
+static bool browser_index_write_begin(BrowserIndex* index) {
+    storage_simply_mkdir(index->storage, BROWSER_INDEX_PATH);
+
+    index->file = storage_file_alloc(index->storage);
+    index->buffer_size = 0;
+    index->write_offset = 0;
+
+    if(!storage_file_open(
+           index->file,
+           furi_string_get_cstr(index->index_path),
+           FSAM_WRITE,
+           FSOM_CREATE_ALWAYS)) {
+        return false;
+    }
+
+    BrowserIndexHeader header = {0};
+    return browser_index_write_data(index, &header, sizeof(header)) &&
+           browser_index_write_data(
+               index, furi_string_get_cstr(index->path), furi_string_size(index->path));
+}
+
+static bool browser_index_write_entry(
+    BrowserIndex* index,
+    const char* name,
+    size_t name_len,
+    uint8_t flags,
+    uint32_t size,
+    void* context) {
+    UNUSED(context);
+    // Directory can grow between signature and write passes
+    if(index->position == index->header.count) return false;
+
+    if(index->position % BROWSER_INDEX_PAGE_SIZE == 0) {
+        index->table[index->position / BROWSER_INDEX_PAGE_SIZE] = index->write_offset;
+    }
+    index->position++;
+
+    uint8_t entry[BROWSER_INDEX_ENTRY_HEADER_SIZE] = {flags, name_len};
+    memcpy(&entry[2], &size, sizeof(size));
+    return browser_index_write_data(index, entry, sizeof(entry)) &&
+           browser_index_write_data(index, name, name_len);
+}
+
+static bool browser_index_write_end(BrowserIndex* index) {
+    // Entries removed between passes
+    index->header.count = index->position;
+    index->header.table_offset = index->write_offset;
+    index->header.magic = BROWSER_INDEX_MAGIC;
+    index->header.version = BROWSER_INDEX_VERSION;
+    index->header.path_size = furi_string_size(index->path);
+
+    size_t pages = (index->header.count + BROWSER_INDEX_PAGE_SIZE - 1) / BROWSER_INDEX_PAGE_SIZE;
+    return browser_index_write_data(index, index->table, pages * sizeof(uint32_t)) &&
+           browser_index_write_flush(index) && storage_file_seek(index->file, 0, true) &&
+           storage_file_write(index->file, &index->header, sizeof(index->header)) ==
+               sizeof(index->header);
+}
+
+static bool browser_index_write(BrowserIndex* index, BrowserIndexBuild* build, bool dirs_first) {
+    bool sorted = !build->overflow;
+
+    index->header.flags = (sorted ? BROWSER_INDEX_FLAG_SORTED : 0) |
+                          (dirs_first ? BROWSER_INDEX_FLAG_DIRS_FIRST : 0);
+    index->header.count = build->count;
+    index->header.signature = build->signature;
+    index->position = 0;
+    size_t pages = (build->count + BROWSER_INDEX_PAGE_SIZE - 1) / BROWSER_INDEX_PAGE_SIZE;
+    index->table = malloc(MAX(pages, 1U) * sizeof(uint32_t));
+    index->table[0] = sizeof(BrowserIndexHeader) + furi_string_size(index->path);
+
+    bool result = false;
+    do {
+        if(!browser_index_write_begin(index)) break;
+
+        if(sorted) {
+            for(size_t i = 0; i < build->records_count; i++) {
+                BrowserIndexRecord* record = &build->records[i];
+                record->name = &build->names[record->name_offset];
+                record->rank = (dirs_first && (record->flags & BROWSER_INDEX_ENTRY_DIR)) ? 0 : 1;
+            }
+            qsort(
+                build->records,
+                build->records_count,
+                sizeof(BrowserIndexRecord),
+                browser_index_record_cmp);
+
+            size_t i = 0;
+            for(; i < build->records_count; i++) {
+                const BrowserIndexRecord* record = &build->records[i];
+                if(!browser_index_write_entry(
+                       index, record->name, record->name_len, record->flags, record->size, NULL)) {
+                    break;
+                }
+            }
+            if(i != build->records_count) break;
+        } else {
+            // Second pass, entries go to index in directory order
+            BrowserIndexBuild stream = {0};
+            if(!browser_index_dir_read(
+                   index, &stream, browser_index_write_entry, NULL, NULL, NULL)) {
+                break;
+            }
+        }
+
+        result = browser_index_write_end(index);
+    } while(false);
+
+    browser_index_file_close(index);
+    if(result) {
+        index->position = index->header.count;
+        index->is_open = true;
+    } else {
+        FURI_LOG_W(TAG, "Write failed: %s", furi_string_get_cstr(index->path));
+        storage_simply_remove(index->storage, furi_string_get_cstr(index->index_path));
+        browser_index_reset(index);
+    }
+    return result;
+}
+
+BrowserIndex* browser_index_alloc(void) {
+    BrowserIndex* index = malloc(sizeof(BrowserIndex));
+    index->storage = furi_record_open(RECORD_STORAGE);
+    index->path = furi_string_alloc();
+    index->index_path = furi_string_alloc();
+    return index;
+}
+
+void browser_index_free(BrowserIndex* index) {
+    furi_assert(index);
+    browser_index_reset(index);
+    furi_string_free(index->index_path);
+    furi_string_free(index->path);
+    furi_record_close(RECORD_STORAGE);
+    free(index);
+}
+
+bool browser_index_open(
+    BrowserIndex* index,
+    const char* path,
+    BrowserIndexLongLoadCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(path);
+
+    browser_index_reset(index);
+    if(!browser_index_path_is_indexed(path)) return false;
+
+    furi_string_set(index->path, path);
+    uint32_t path_hash = browser_index_hash(BROWSER_INDEX_HASH_INIT, path, strlen(path));
+    furi_string_printf(index->index_path, BROWSER_INDEX_PATH "/%08lX.idx", path_hash);
+    bool dirs_first = CFW_SETTINGS()->sort_dirs_first;
+
+    // Storage timestamp has seconds resolution, so listing read in the same
+    // second as last modification can miss it and is not remembered as fresh
+    uint32_t start = furi_hal_rtc_get_timestamp();
+    uint32_t timestamp = 0;
+    bool can_be_fresh =
+        (storage_common_timestamp(index->storage, path, &timestamp) == FSE_OK) &&
+        (timestamp < start);
+
+    bool loaded = browser_index_file_open(index, &index->header);
+    if(loaded && (index->header.flags & BROWSER_INDEX_FLAG_SORTED) &&
+       (!!(index->header.flags & BROWSER_INDEX_FLAG_DIRS_FIRST) != dirs_first)) {
+        loaded = false;
+    }
+
+    if(loaded && can_be_fresh && browser_index_fresh_check(path_hash, timestamp)) {
+        if(browser_index_table_load(index)) {
+            browser_index_file_close(index);
+            return true;
+        }
+        browser_index_reset(index);
+        loaded = false;
+    }
+    BrowserIndexHeader header = index->header;
+    browser_index_file_close(index);
+
+    BrowserIndexBuild build = {0};
+    bool result = false;
+    do {
+        if(!browser_index_dir_read(
+               index, &build, browser_index_build_entry, &build, callback, context)) {
+            break;
+        }
+
+        if(loaded && header.count == build.count && header.signature == build.signature) {
+            result = browser_index_file_open(index, &index->header) &&
+                     (memcmp(&header, &index->header, sizeof(header)) == 0) &&
+                     browser_index_table_load(index);
+            browser_index_file_close(index);
+            if(result) break;
+            browser_index_reset(index);
+        }
+
+        FURI_LOG_D(
+            TAG,
+            "Build %s: %lu entries%s",
+            path,
+            build.count,
+            build.overflow ? ", unsorted" : "");
+        result = browser_index_write(index, &build, dirs_first);
+    } while(false);
+
+    free(build.records);
+    free(build.names);
+
+    if(result && can_be_fresh) {
+        browser_index_fresh_set(path_hash, timestamp);
+    }
+    return result;
+}
+
+void browser_index_close(BrowserIndex* index) {
+    furi_assert(index);
+    browser_index_file_close(index);
+}
+
+uint32_t browser_index_get_count(BrowserIndex* index) {
+    furi_assert(index);
+    return index->is_open ? index->header.count : 0;
+}
+
+bool browser_index_is_sorted(BrowserIndex* index) {
+    furi_assert(index);
+    return index->is_open && (index->header.flags & BROWSER_INDEX_FLAG_SORTED);
+}
+
+bool browser_index_seek(BrowserIndex* index, uint32_t position) {
+    furi_assert(index);
+    if(!index->is_open || position > index->header.count) return false;
+
+    if(!index->file) {
+        // Index can be rebuilt by other browser while this one was closed
+        BrowserIndexHeader header;
+        if(!browser_index_file_open(index, &header)) return false;
+        if(memcmp(&header, &index->header, sizeof(header)) != 0) {
+            browser_index_file_close(index);
+            return false;
+        }
+    }
+
+    if(position == index->header.count) {
+        index->position = position;
+        return true;
+    }
+
+    uint32_t page = position / BROWSER_INDEX_PAGE_SIZE;
+    if(!storage_file_seek(index->file, index->table[page], true)) return false;
+    index->buffer_size = 0;
+    index->buffer_position = 0;
+    index->position = page * BROWSER_INDEX_PAGE_SIZE;
+
+    while(index->position < position) {
+        if(!browser_index_read(index)) return false;
+    }
+    return true;
+}
+
+const BrowserIndexEntry* browser_index_read(BrowserIndex* index) {
+    furi_assert(index);
+    if(!index->file || index->position >= index->header.count) return NULL;
+
+    uint8_t entry[BROWSER_INDEX_ENTRY_HEADER_SIZE];
+    if(!browser_index_read_data(index, entry, sizeof(entry))) return NULL;
+    if(!browser_index_read_data(index, index->name, entry[1])) return NULL;
+
+    index->name[entry[1]] = '\0';
+    index->entry.name = index->name;
+    index->entry.is_dir = entry[0] & BROWSER_INDEX_ENTRY_DIR;
+    memcpy(&index->entry.size, &entry[2], sizeof(uint32_t));
+    index->position++;
+    return &index->entry;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file file_browser_index.h
+ * GUI: persistent directory index for file browser worker
+ *
+ * Index keeps names, types and sizes of all directory entries in one file
+ * under BROWSER_INDEX_PATH, so folder counting and paging read a compact
+ * file instead of enumerating directory again. Entries are stored in
+ * browser sort order (folders first if enabled, then case insensitive
+ * name) unless directory is too big to sort in memory, then they keep
+ * directory order.
+ *
+ * Index is checked against directory listing signature (entry count,
+ * names, types, sizes and modification times) and rebuilt when listing
+ * changed. Listing is not read again while storage wasn't modified since
+ * last check.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BROWSER_INDEX_PATH EXT_PATH(".dirindex")
+#define BROWSER_INDEX_PAGE_SIZE (32U)
+
+typedef struct BrowserIndex BrowserIndex;
+
+typedef struct {
+    const char* name;
+    uint32_t size;
+    bool is_dir;
+} BrowserIndexEntry;
+
+typedef void (*BrowserIndexLongLoadCallback)(void* context);
+
+/** Allocate BrowserIndex
+ *
+ * @return     BrowserIndex instance
+ */
+BrowserIndex* browser_index_alloc(void);
+
+/** Free BrowserIndex
+ *
+ * @param      index  BrowserIndex instance
+ */
+void browser_index_free(BrowserIndex* index);
+
+/** Open index of directory, building or updating it if needed
+ *
+ * Only external storage directories are indexed.
+ *
+ * @param      index    BrowserIndex instance
+ * @param      path     Directory path
+ * @param      callback Called once when directory listing gets long, can be NULL
+ * @param      context  Callback context
+ *
+ * @return     true if index is ready, false if directory should be read directly
+ */
+bool browser_index_open(
+    BrowserIndex* index,
+    const char* path,
+    BrowserIndexLongLoadCallback callback,
+    void* context);
+
+/** Close index file, index stays open and is reopened by next seek
+ *
+ * @param      index  BrowserIndex instance
+ */
+void browser_index_close(BrowserIndex* index);
+
+/** Get number of directory entries
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     entries count
+ */
+uint32_t browser_index_get_count(BrowserIndex* index);
+
+/** Check if entries are in browser sort order
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     true if sorted
+ */
+bool browser_index_is_sorted(BrowserIndex* index);
+
+/** Move to entry
+ *
+ * @param      index     BrowserIndex instance
+ * @param      position  Entry position, starting with 0
+ *
+ * @return     false on read error or if index file changed
+ */
+bool browser_index_seek(BrowserIndex* index, uint32_t position);
+
+/** Read entry and move to next one
+ *
+ * @param      index  BrowserIndex instance
+ *
+ * @return     entry, valid until next call, NULL at the end or on error
+ */
+const BrowserIndexEntry* browser_index_read(BrowserIndex* index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "file_browser_worker.h"
+#include "file_browser_index.h"
 
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
@@ -16,8 +17,9 @@
 
 #define ASSETS_DIR "assets"
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
-#define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
+#define DIR_BATCH_SIZE 16
+#define DIR_BATCH_ARENA_SIZE 1024
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -33,6 +35,7 @@ typedef enum {
      WorkerEvtFolderRefresh | WorkerEvtConfigChange)
 
 ARRAY_DEF(idx_last_array, int32_t)
+ARRAY_DEF(idx_page_array, uint32_t)
 
 struct BrowserWorker {
     FuriThread* thread;
@@ -48,6 +51,11 @@ struct BrowserWorker {
     bool hide_dot_files;
     idx_last_array_t idx_last;
 
+    BrowserIndex* index;
+    bool index_ready;
+    // Index position of every BROWSER_INDEX_PAGE_SIZE-th filtered item
+    idx_page_array_t idx_page;
+
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
     BrowserWorkerListLoadCallback list_load_cb;
@@ -55,6 +63,35 @@ struct BrowserWorker {
     BrowserWorkerLongLoadCallback long_load_cb;
 };
 
+typedef struct {
+    File* directory;
+    size_t count;
+    size_t position;
+    StorageDirEntry entries[DIR_BATCH_SIZE];
+    char arena[DIR_BATCH_ARENA_SIZE];
+} BrowserDirReader;
+
+static BrowserDirReader* browser_dir_reader_alloc(File* directory) {
+    BrowserDirReader* reader = malloc(sizeof(BrowserDirReader));
+    reader->directory = directory;
+    return reader;
+}
+
+// Entries are fetched from storage thread in batches, NULL on end of directory or error
+static StorageDirEntry* browser_dir_reader_next(BrowserDirReader* reader) {
+    if(reader->position == reader->count) {
+        reader->count = storage_dir_read_many(
+            reader->directory,
+            reader->entries,
+            COUNT_OF(reader->entries),
+            reader->arena,
+            sizeof(reader->arena));
+        reader->position = 0;
+    }
+
+    return (reader->position < reader->count) ? &reader->entries[reader->position++] : NULL;
+}
+
 static bool browser_path_is_file(FuriString* path) {
     bool state = false;
     FileInfo file_info;
@@ -132,6 +169,42 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static bool browser_folder_init_indexed(
+    BrowserWorker* browser,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    BrowserIndex* index = browser->index;
+    const BrowserIndexEntry* entry;
+    uint32_t position = 0;
+
+    FuriString* name_str;
+    name_str = furi_string_alloc();
+
+    idx_page_array_reset(browser->idx_page);
+    bool state = browser_index_seek(index, 0);
+    while(state && (entry = browser_index_read(index)) != NULL) {
+        furi_string_set(name_str, entry->name);
+        if(browser_filter_by_name(browser, name_str, entry->is_dir)) {
+            if(*item_cnt % BROWSER_INDEX_PAGE_SIZE == 0) {
+                idx_page_array_push_back(browser->idx_page, position);
+            }
+            if(!furi_string_empty(filename)) {
+                if(furi_string_cmp(name_str, filename) == 0) {
+                    *file_idx = *item_cnt;
+                }
+            }
+            (*item_cnt)++;
+        }
+        position++;
+    }
+
+    furi_string_free(name_str);
+    browser_index_close(index);
+
+    return state && (position == browser_index_get_count(index));
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -139,13 +212,24 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
     uint32_t total_files_cnt = 0;
 
+    *item_cnt = 0;
+    *file_idx = -1;
+
+    // Directory index has entries in sort order and serves pages without reading directory
+    browser->index_ready =
+        browser_index_open(
+            browser->index, furi_string_get_cstr(path), browser->long_load_cb, browser->cb_ctx) &&
+        browser_folder_init_indexed(browser, filename, item_cnt, file_idx);
+    if(browser->index_ready) {
+        return true;
+    }
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -154,14 +238,13 @@ static bool browser_folder_init(
 
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+        StorageDirEntry* entry;
+        while((entry = browser_dir_reader_next(reader)) != NULL) {
+            if(entry->name[0] != '\0') {
                 total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                furi_string_set(name_str, entry->name);
+                if(browser_filter_by_name(
+                       browser, name_str, file_info_is_dir(&entry->fileinfo))) {
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
@@ -180,6 +263,7 @@ static bool browser_folder_init(
     }
 
     furi_string_free(name_str);
+    free(reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -189,18 +273,71 @@ static bool browser_folder_init(
     return state;
 }
 
+// Load files list from directory index, false if index can't be used anymore
+static bool browser_folder_load_indexed(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    BrowserIndex* index = browser->index;
+    const BrowserIndexEntry* entry = NULL;
+
+    uint32_t page = offset / BROWSER_INDEX_PAGE_SIZE;
+    uint32_t position = (page < idx_page_array_size(browser->idx_page)) ?
+                            *idx_page_array_get(browser->idx_page, page) :
+                            browser_index_get_count(index);
+    if(!browser_index_seek(index, position)) {
+        browser_index_close(index);
+        return false;
+    }
+
+    FuriString* name_str;
+    name_str = furi_string_alloc();
+
+    uint32_t items_cnt = page * BROWSER_INDEX_PAGE_SIZE;
+    while(items_cnt < offset && (entry = browser_index_read(index)) != NULL) {
+        furi_string_set(name_str, entry->name);
+        if(browser_filter_by_name(browser, name_str, entry->is_dir)) {
+            items_cnt++;
+        }
+    }
+
+    if(browser->list_load_cb) {
+        browser->list_load_cb(browser->cb_ctx, offset);
+    }
+
+    items_cnt = 0;
+    while(items_cnt < count && (entry = browser_index_read(index)) != NULL) {
+        furi_string_set(name_str, entry->name);
+        if(browser_filter_by_name(browser, name_str, entry->is_dir)) {
+            furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+            if(browser->list_item_cb) {
+                browser->list_item_cb(browser->cb_ctx, name_str, items_cnt, entry->is_dir, false);
+            }
+            items_cnt++;
+        }
+    }
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, NULL, 0, false, true);
+    }
+
+    furi_string_free(name_str);
+    browser_index_close(index);
+
+    return true;
+}
+
 // Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
+    StorageDirEntry* entry;
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -213,16 +350,12 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if((entry = browser_dir_reader_next(reader)) == NULL) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -235,25 +368,21 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if((entry = browser_dir_reader_next(reader)) == NULL) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx,
-                            name_str,
-                            items_cnt,
-                            file_info_is_dir(&file_info),
-                            false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx,
+                        name_str,
+                        items_cnt,
+                        file_info_is_dir(&entry->fileinfo),
+                        false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -262,6 +391,7 @@ static bool browser_folder_load_chunked(
     } while(0);
 
     furi_string_free(name_str);
+    free(reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -273,12 +403,11 @@ static bool browser_folder_load_chunked(
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(directory);
+    StorageDirEntry* entry;
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -292,14 +421,17 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
-            furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+        while((entry = browser_dir_reader_next(reader)) != NULL) {
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
                 if(browser->list_item_cb) {
                     browser->list_item_cb(
-                        browser->cb_ctx, name_str, items_cnt, file_info_is_dir(&file_info), false);
+                        browser->cb_ctx,
+                        name_str,
+                        items_cnt,
+                        file_info_is_dir(&entry->fileinfo),
+                        false);
                 }
                 items_cnt++;
             }
@@ -311,6 +443,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     } while(0);
 
     furi_string_free(name_str);
+    free(reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -414,11 +547,22 @@ static int32_t browser_worker(void* context) {
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
-            if(items_cnt > BROWSER_SORT_THRESHOLD) {
-                browser_folder_load_chunked(
-                    browser, path, browser->load_offset, browser->load_count);
-            } else {
-                browser_folder_load_full(browser, path);
+            if(browser->index_ready) {
+                if(items_cnt > BROWSER_SORT_THRESHOLD) {
+                    browser->index_ready = browser_folder_load_indexed(
+                        browser, path, browser->load_offset, browser->load_count);
+                } else {
+                    browser->index_ready =
+                        browser_folder_load_indexed(browser, path, 0, items_cnt);
+                }
+            }
+            if(!browser->index_ready) {
+                if(items_cnt > BROWSER_SORT_THRESHOLD) {
+                    browser_folder_load_chunked(
+                        browser, path, browser->load_offset, browser->load_count);
+                } else {
+                    browser_folder_load_full(browser, path);
+                }
             }
         }
 
@@ -443,6 +587,8 @@ BrowserWorker* file_browser_worker_alloc(
     BrowserWorker* browser = malloc(sizeof(BrowserWorker));
 
     idx_last_array_init(browser->idx_last);
+    idx_page_array_init(browser->idx_page);
+    browser->index = browser_index_alloc();
 
     browser->filter_extension = furi_string_alloc_set(filter_ext);
     browser->skip_assets = skip_assets;
@@ -476,6 +622,8 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_start);
 
     idx_last_array_clear(browser->idx_last);
+    idx_page_array_clear(browser->idx_page);
+    browser_index_free(browser->index);
 
     free(browser);
 }
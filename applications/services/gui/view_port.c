@@ -154,7 +154,19 @@ void view_port_input_callback_set(
 
 void view_port_update(ViewPort* view_port) {
     furi_assert(view_port);
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    if(view_port->gui && view_port->is_enabled) gui_update_view_port(view_port->gui, view_port);
+}
+
+void view_port_update_rect(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(view_port);
+    if(view_port->gui && view_port->is_enabled) {
+        gui_update_view_port_rect(view_port->gui, view_port, x, y, width, height);
+    }
 }
 
 void view_port_gui_set(ViewPort* view_port, Gui* gui) {
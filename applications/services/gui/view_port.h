@@ -97,6 +97,27 @@ void view_port_input_callback_set(
  */
 void view_port_update(ViewPort* view_port);
 
+/** Emit update signal for part of ViewPort to GUI system.
+ *
+ * Only given area is cleared and redrawn, draw callback is still called
+ * but its output, canvas_clear included, is clipped to the area. Draw
+ * callback must produce the same picture outside of the area as on previous
+ * draw. Falls back to full redraw when anything else changed since last
+ * draw.
+ *
+ * @param      view_port  ViewPort instance
+ * @param      x          area x in ViewPort coordinates
+ * @param      y          area y in ViewPort coordinates
+ * @param      width      area width
+ * @param      height     area height
+ */
+void view_port_update_rect(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 /** Set ViewPort orientation.
  *
  * @param      view_port    ViewPort instance
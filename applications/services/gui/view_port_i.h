@@ -10,6 +10,7 @@
 
 struct ViewPort {
     Gui* gui;
+    GuiLayer layer;
     bool is_enabled;
     ViewPortOrientation orientation;
 
@@ -1,23 +1,25 @@
 #include "firmware_api.h"
 
 #include <flipper_application/api_hashtable/api_hashtable.h>
-#include <flipper_application/api_hashtable/compilesort.hpp>
 
 /* Generated table */
 #include <firmware_api_table.h>
 
 #include <furi_hal_info.h>
 
-static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
+static_assert(check_perfect_hash(elf_api_perfect_hash), "Invalid API perfect hash!");
 
-constexpr HashtableApiInterface elf_api_interface{
+constexpr PerfectHashApiInterface elf_api_interface{
     {
         .api_version_major = (elf_api_version >> 16),
         .api_version_minor = (elf_api_version & 0xFFFF),
-        .resolver_callback = &elf_resolve_from_hashtable,
+        .resolver_callback = &elf_resolve_from_perfect_hash,
     },
-    .table_cbegin = elf_api_table.cbegin(),
-    .table_cend = elf_api_table.cend(),
+    .table_cbegin = elf_api_perfect_hash.slots.cbegin(),
+    .table_cend = elf_api_perfect_hash.slots.cend(),
+    .bucket_seeds = elf_api_perfect_hash.seeds.data(),
+    .bucket_count = elf_api_perfect_hash.seeds.size(),
+    .salt = elf_api_perfect_hash.salt,
 };
 
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
@@ -81,6 +81,8 @@ struct RpcSession {
     RpcSessionClosedCallback closed_callback;
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
+    size_t chunk_size;
+    bool screen_stream_delta;
     bool status;
     void* context;
 };
@@ -154,6 +156,28 @@ void rpc_session_set_terminated_callback(
     furi_mutex_release(session->callbacks_mutex);
 }
 
+void rpc_session_set_chunk_size(RpcSession* session, size_t chunk_size) {
+    furi_assert(session);
+    furi_check(chunk_size && (chunk_size <= RPC_CHUNK_SIZE_MAX));
+
+    session->chunk_size = chunk_size;
+}
+
+size_t rpc_session_get_chunk_size(RpcSession* session) {
+    furi_assert(session);
+    return session->chunk_size;
+}
+
+void rpc_session_set_screen_stream_delta(RpcSession* session, bool enable) {
+    furi_assert(session);
+    session->screen_stream_delta = enable;
+}
+
+bool rpc_session_get_screen_stream_delta(RpcSession* session) {
+    furi_assert(session);
+    return session->screen_stream_delta;
+}
+
 /* Doesn't forbid using rpc_feed_bytes() after session close - it's safe.
  * Because any bytes received in buffer will be flushed before next session.
  * If bytes get into stream buffer before it's get emptied and this
@@ -373,6 +397,8 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->chunk_size = RPC_CHUNK_SIZE_DEFAULT;
+    session->screen_stream_delta = false;
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
@@ -430,6 +456,18 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+static void rpc_send_bytes(RpcSession* session, uint8_t* buffer, size_t size) {
+#if SRV_RPC_DEBUG
+    rpc_debug_print_data("OUTPUT", buffer, size);
+#endif
+
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
+    if(session->send_bytes_callback) {
+        session->send_bytes_callback(session->context, buffer, size);
+    }
+    furi_mutex_release(session->callbacks_mutex);
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
@@ -449,17 +487,31 @@ void rpc_send(RpcSession* session, PB_Main* message) {
 
     pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
 
+    rpc_send_bytes(session, buffer, ostream.bytes_written);
+
+    free(buffer);
+}
+
+void rpc_send_with_buffer(
+    RpcSession* session,
+    PB_Main* message,
+    uint8_t* buffer,
+    size_t buffer_size) {
+    furi_assert(session);
+    furi_assert(message);
+    furi_assert(buffer);
+
+    pb_ostream_t ostream = pb_ostream_from_buffer(buffer, buffer_size);
+    if(pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED)) {
 #if SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+        FURI_LOG_I(TAG, "OUTPUT:");
+        rpc_debug_print_message(message);
 #endif
-
-    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        rpc_send_bytes(session, buffer, ostream.bytes_written);
+    } else {
+        // Doesn't fit, fall back to sizing pass and allocation
+        rpc_send(session, message);
     }
-    furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -10,6 +10,10 @@ extern "C" {
 #endif
 
 #define RPC_BUFFER_SIZE (1024)
+/** Default size of data chunk in continuous storage responses */
+#define RPC_CHUNK_SIZE_DEFAULT (512)
+/** Upper limit for data chunk size, bounded by storage and protobuf size fields */
+#define RPC_CHUNK_SIZE_MAX (4096)
 
 #define RECORD_RPC "rpc"
 
@@ -115,6 +119,42 @@ void rpc_session_set_terminated_callback(
     RpcSession* session,
     RpcSessionTerminatedCallback callback);
 
+/** Set size of data chunk used in continuous storage responses
+ *
+ * Transport layers with wide links may raise it to cut per-message overhead.
+ * Size of chunks sent by client in write requests is not limited by it.
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   chunk_size  chunk size, 1 .. RPC_CHUNK_SIZE_MAX
+ */
+void rpc_session_set_chunk_size(RpcSession* session, size_t chunk_size);
+
+/** Get size of data chunk used in continuous storage responses
+ *
+ * @param   session     pointer to RpcSession descriptor
+ *
+ * @return              chunk size
+ */
+size_t rpc_session_get_chunk_size(RpcSession* session);
+
+/** Enable delta compressed screen stream for the session
+ *
+ * Protobuf schema has no field to request it, so transport layer enables it
+ * when client asked for it while opening the session. Disabled by default.
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   enable      true to send screen frames as delta stream
+ */
+void rpc_session_set_screen_stream_delta(RpcSession* session, bool enable);
+
+/** Get delta compressed screen stream state
+ *
+ * @param   session     pointer to RpcSession descriptor
+ *
+ * @return              true if screen frames are sent as delta stream
+ */
+bool rpc_session_get_screen_stream_delta(RpcSession* session);
+
 /** Give bytes to RPC service to decode them and perform command
  *
  * @param   session     pointer to RpcSession descriptor
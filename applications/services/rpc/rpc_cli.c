@@ -13,6 +13,10 @@ typedef struct {
 } CliRpc;
 
 #define CLI_READ_BUFFER_SIZE 64
+// USB CDC keeps up with bigger storage chunks than BLE
+#define CLI_RPC_CHUNK_SIZE 2048
+// "start_rpc_session screen_delta" asks for delta compressed screen stream
+#define CLI_RPC_ARG_SCREEN_DELTA "screen_delta"
 
 static void rpc_cli_send_bytes_callback(void* context, uint8_t* bytes, size_t bytes_len) {
     furi_assert(context);
@@ -38,7 +42,6 @@ static void rpc_cli_session_terminated_callback(void* context) {
 }
 
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
-    UNUSED(args);
     furi_assert(cli);
     furi_assert(context);
     Rpc* rpc = context;
@@ -57,6 +60,10 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
     CliRpc cli_rpc = {.cli = cli, .session_close_request = false};
     cli_rpc.terminate_semaphore = furi_semaphore_alloc(1, 0);
     rpc_session_set_context(rpc_session, &cli_rpc);
+    rpc_session_set_chunk_size(rpc_session, CLI_RPC_CHUNK_SIZE);
+    furi_string_trim(args);
+    rpc_session_set_screen_stream_delta(
+        rpc_session, furi_string_equal(args, CLI_RPC_ARG_SCREEN_DELTA));
     rpc_session_set_send_bytes_callback(rpc_session, rpc_cli_send_bytes_callback);
     rpc_session_set_close_callback(rpc_session, rpc_cli_session_close_callback);
     rpc_session_set_terminated_callback(rpc_session, rpc_cli_session_terminated_callback);
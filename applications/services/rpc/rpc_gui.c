@@ -4,6 +4,7 @@
 #include <gui/gui_i.h>
 #include <desktop/desktop_settings.h>
 #include <assets_icons.h>
+#include <toolbox/delta_rle.h>
 
 #define TAG "RpcGui"
 
@@ -16,6 +17,22 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+/* Delta screen stream
+ *
+ * Enabled per session by transport, see rpc_session_set_screen_stream_delta:
+ * USB CLI transport does it for "start_rpc_session screen_delta". Every
+ * ScreenFrame data then starts with RpcGuiStreamFrame type byte followed
+ * by delta_rle encoded frame: keyframes against nothing, delta frames
+ * against previous frame of the stream. Transport is reliable and
+ * ordered, so previous sent frame is the one client holds. */
+typedef enum {
+    RpcGuiStreamFrameKey = 0x00,
+    RpcGuiStreamFrameDelta = 0x01,
+} RpcGuiStreamFrame;
+
+/** Frames between keyframes */
+#define RPC_GUI_STREAM_KEYFRAME_INTERVAL (64u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -31,6 +48,17 @@ typedef struct {
     bool virtual_display_not_empty;
     bool is_streaming;
 
+    // Delta stream
+    bool stream_delta;
+    FuriMutex* stream_mutex;
+    uint8_t* stream_pending; /**< last frame from gui, guarded by stream_mutex */
+    CanvasOrientation stream_pending_orientation;
+    uint8_t* stream_frame; /**< frame being encoded */
+    uint8_t* stream_reference; /**< last frame sent */
+    CanvasOrientation stream_reference_orientation;
+    size_t stream_frame_size;
+    uint32_t stream_keyframe_countdown;
+
     uint32_t input_key_counter[InputKeyMAX];
     uint32_t input_counter;
 
@@ -56,17 +84,76 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    if(rpc_gui->stream_delta) {
+        furi_assert(size == rpc_gui->stream_frame_size);
+        // Encoding is done by transmit thread
+        furi_check(furi_mutex_acquire(rpc_gui->stream_mutex, FuriWaitForever) == FuriStatusOk);
+        memcpy(rpc_gui->stream_pending, data, size);
+        rpc_gui->stream_pending_orientation = orientation;
+        furi_check(furi_mutex_release(rpc_gui->stream_mutex) == FuriStatusOk);
+    } else {
+        uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
+
+        furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+        memcpy(buffer, data, size);
+        rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
+            rpc_system_gui_screen_orientation_map[orientation];
+    }
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+static void rpc_system_gui_screen_stream_delta_encode(RpcGuiSystem* rpc_gui) {
+    const size_t size = rpc_gui->stream_frame_size;
+
+    furi_check(furi_mutex_acquire(rpc_gui->stream_mutex, FuriWaitForever) == FuriStatusOk);
+    memcpy(rpc_gui->stream_frame, rpc_gui->stream_pending, size);
+    CanvasOrientation orientation = rpc_gui->stream_pending_orientation;
+    furi_check(furi_mutex_release(rpc_gui->stream_mutex) == FuriStatusOk);
+
+    PB_Gui_ScreenFrame* screen_frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    uint8_t* output = screen_frame->data->bytes;
+    size_t encoded = 0;
+
+    bool keyframe = (rpc_gui->stream_keyframe_countdown == 0) ||
+                    (orientation != rpc_gui->stream_reference_orientation);
+    if(!keyframe) {
+        // Small delta is the usual case, otherwise send whatever is smaller
+        encoded = delta_rle_encode(
+            rpc_gui->stream_frame, rpc_gui->stream_reference, size, &output[1], size / 4);
+        if(!encoded) {
+            size_t keyframe_size = delta_rle_encode(
+                rpc_gui->stream_frame, NULL, size, &output[1], DELTA_RLE_ENCODED_SIZE_MAX(size));
+            encoded = delta_rle_encode(
+                rpc_gui->stream_frame,
+                rpc_gui->stream_reference,
+                size,
+                &output[1],
+                keyframe_size - 1);
+        }
+        keyframe = (encoded == 0);
+    }
+
+    if(keyframe) {
+        encoded = delta_rle_encode(
+            rpc_gui->stream_frame, NULL, size, &output[1], DELTA_RLE_ENCODED_SIZE_MAX(size));
+        furi_check(encoded);
+        output[0] = RpcGuiStreamFrameKey;
+        rpc_gui->stream_keyframe_countdown = RPC_GUI_STREAM_KEYFRAME_INTERVAL;
+    } else {
+        output[0] = RpcGuiStreamFrameDelta;
+        rpc_gui->stream_keyframe_countdown--;
+    }
+
+    screen_frame->data->size = encoded + 1;
+    screen_frame->orientation = rpc_system_gui_screen_orientation_map[orientation];
+
+    memcpy(rpc_gui->stream_reference, rpc_gui->stream_frame, size);
+    rpc_gui->stream_reference_orientation = orientation;
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
@@ -79,6 +166,9 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
 
         if(flags & RpcGuiWorkerFlagTransmit) {
             transmit_time = furi_get_tick();
+            if(rpc_gui->stream_delta) {
+                rpc_system_gui_screen_stream_delta_encode(rpc_gui);
+            }
             rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
             transmit_time = furi_get_tick() - transmit_time;
 
@@ -96,6 +186,29 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
     return 0;
 }
 
+static void rpc_system_gui_screen_stream_stop(RpcGuiSystem* rpc_gui) {
+    rpc_gui->is_streaming = false;
+    // Remove GUI framebuffer callback
+    gui_remove_framebuffer_callback(
+        rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, rpc_gui);
+    // Stop and release worker thread
+    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
+    furi_thread_join(rpc_gui->transmit_thread);
+    furi_thread_free(rpc_gui->transmit_thread);
+    // Release frame
+    pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
+    free(rpc_gui->transmit_frame);
+    rpc_gui->transmit_frame = NULL;
+    // Release delta stream state
+    if(rpc_gui->stream_delta) {
+        rpc_gui->stream_delta = false;
+        furi_mutex_free(rpc_gui->stream_mutex);
+        free(rpc_gui->stream_pending);
+        free(rpc_gui->stream_frame);
+        free(rpc_gui->stream_reference);
+    }
+}
+
 static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -114,12 +227,24 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
 
         rpc_gui->is_streaming = true;
         size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
+        size_t data_size = framebuffer_size;
+        // Delta frames requested
+        rpc_gui->stream_delta = rpc_session_get_screen_stream_delta(session);
+        if(rpc_gui->stream_delta) {
+            data_size = 1 + DELTA_RLE_ENCODED_SIZE_MAX(framebuffer_size);
+            rpc_gui->stream_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+            rpc_gui->stream_pending = malloc(framebuffer_size);
+            rpc_gui->stream_frame = malloc(framebuffer_size);
+            rpc_gui->stream_reference = malloc(framebuffer_size);
+            rpc_gui->stream_frame_size = framebuffer_size;
+            rpc_gui->stream_keyframe_countdown = 0;
+        }
         // Reusable Frame
         rpc_gui->transmit_frame = malloc(sizeof(PB_Main));
         rpc_gui->transmit_frame->which_content = PB_Main_gui_screen_frame_tag;
         rpc_gui->transmit_frame->command_status = PB_CommandStatus_OK;
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
-            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(data_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
@@ -142,18 +267,7 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
     furi_assert(session);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -484,18 +598,7 @@ void rpc_system_gui_free(void* context) {
     view_port_free(rpc_gui->rpc_session_active_viewport_slim);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
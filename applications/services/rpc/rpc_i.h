@@ -19,6 +19,17 @@ typedef struct {
 
 void rpc_send(RpcSession* session, PB_Main* main_message);
 
+/** Encode message into caller owned buffer and send it without allocation
+ *
+ * Falls back to rpc_send() if encoded message doesn't fit into buffer.
+ * Message is not released.
+ */
+void rpc_send_with_buffer(
+    RpcSession* session,
+    PB_Main* main_message,
+    uint8_t* buffer,
+    size_t buffer_size);
+
 void rpc_send_and_release(RpcSession* session, PB_Main* main_message);
 
 void rpc_send_and_release_empty(RpcSession* session, uint32_t command_id, PB_CommandStatus status);
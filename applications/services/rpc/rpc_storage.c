@@ -17,7 +17,12 @@
 
 #define MAX_NAME_LENGTH 255
 
-static const size_t MAX_DATA_SIZE = 512;
+/* Chunks kept in flight by read-ahead, also sizes write-behind buffer */
+#define RPC_STORAGE_PIPELINE_DEPTH 3
+/* Delimited PB_Main around file data: length prefixes, tags, command id and flags */
+#define RPC_STORAGE_RESPONSE_OVERHEAD 64
+#define RPC_STORAGE_LIST_BATCH_SIZE 16
+#define RPC_STORAGE_LIST_ARENA_SIZE 1024
 
 typedef enum {
     RpcStorageStateIdle = 0,
@@ -30,8 +35,54 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    uint8_t* write_buffer;
+    size_t write_buffer_size;
+    size_t write_buffer_used;
 } RpcStorageSystem;
 
+typedef struct {
+    File* file;
+    size_t chunk_size;
+    size_t size_left;
+    pb_bytes_array_t* slots[RPC_STORAGE_PIPELINE_DEPTH];
+    FuriMessageQueue* free_queue;
+    FuriMessageQueue* ready_queue;
+} RpcStorageReadAhead;
+
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    bool success = true;
+
+    if(rpc_storage->write_buffer_used) {
+        size_t written_size = storage_file_write(
+            rpc_storage->file, rpc_storage->write_buffer, rpc_storage->write_buffer_used);
+        success = (written_size == rpc_storage->write_buffer_used);
+        rpc_storage->write_buffer_used = 0;
+    }
+
+    return success;
+}
+
+static bool
+    rpc_system_storage_write_buffered(RpcStorageSystem* rpc_storage, uint8_t* data, size_t size) {
+    bool success = true;
+
+    if(rpc_storage->write_buffer_used + size > rpc_storage->write_buffer_size) {
+        success = rpc_system_storage_write_flush(rpc_storage);
+    }
+
+    if(success) {
+        if(size >= rpc_storage->write_buffer_size) {
+            // Big enough to go straight to storage
+            success = (storage_file_write(rpc_storage->file, data, size) == size);
+        } else {
+            memcpy(rpc_storage->write_buffer + rpc_storage->write_buffer_used, data, size);
+            rpc_storage->write_buffer_used += size;
+        }
+    }
+
+    return success;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -48,6 +99,10 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            // Keep data received before interruption, as unbuffered writes did
+            rpc_system_storage_write_flush(rpc_storage);
+            free(rpc_storage->write_buffer);
+            rpc_storage->write_buffer = NULL;
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
@@ -272,7 +327,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     PB_Storage_ListResponse* list = &response.content.storage_list_response;
 
     bool finish = false;
-    int i = 0;
+    size_t i = 0;
 
     if(!storage_dir_open(dir, request->content.storage_list_request.path)) {
         response.command_status = rpc_system_storage_get_file_error(dir);
@@ -280,35 +335,49 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         finish = true;
     }
 
+    /* entries are read in batches, names are copied into response owned slots
+     * because batch arena is reused before response is full */
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * RPC_STORAGE_LIST_BATCH_SIZE);
+    char* arena = malloc(RPC_STORAGE_LIST_ARENA_SIZE);
+    char* names = malloc(COUNT_OF(list->file) * (MAX_NAME_LENGTH + 1));
+
     while(!finish) {
-        FileInfo fileinfo;
-        char* name = malloc(MAX_NAME_LENGTH + 1);
-        if(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(path_contains_only_ascii(name)) {
-                if(i == COUNT_OF(list->file)) {
-                    list->file_count = i;
-                    response.has_next = true;
-                    rpc_send_and_release(session, &response);
-                    i = 0;
-                }
-                list->file[i].type = file_info_is_dir(&fileinfo) ? PB_Storage_File_FileType_DIR :
-                                                                   PB_Storage_File_FileType_FILE;
-                list->file[i].size = fileinfo.size;
-                list->file[i].data = NULL;
-                list->file[i].name = name;
-                ++i;
-            } else {
-                free(name);
+        size_t entries_read = storage_dir_read_many(
+            dir, entries, RPC_STORAGE_LIST_BATCH_SIZE, arena, RPC_STORAGE_LIST_ARENA_SIZE);
+        finish = (entries_read == 0);
+
+        for(size_t entry_index = 0; entry_index < entries_read; ++entry_index) {
+            StorageDirEntry* entry = &entries[entry_index];
+            if(!path_contains_only_ascii(entry->name)) {
+                continue;
             }
-        } else {
-            list->file_count = i;
-            finish = true;
-            free(name);
+
+            if(i == COUNT_OF(list->file)) {
+                list->file_count = i;
+                response.has_next = true;
+                /* names are not heap allocated, don't release */
+                rpc_send(session, &response);
+                i = 0;
+            }
+            char* name = names + i * (MAX_NAME_LENGTH + 1);
+            strlcpy(name, entry->name, MAX_NAME_LENGTH + 1);
+            list->file[i].type = file_info_is_dir(&entry->fileinfo) ?
+                                     PB_Storage_File_FileType_DIR :
+                                     PB_Storage_File_FileType_FILE;
+            list->file[i].size = entry->fileinfo.size;
+            list->file[i].data = NULL;
+            list->file[i].name = name;
+            ++i;
         }
     }
+    list->file_count = i;
 
     response.has_next = false;
-    rpc_send_and_release(session, &response);
+    rpc_send(session, &response);
+
+    free(names);
+    free(arena);
+    free(entries);
 
     storage_dir_close(dir);
     storage_file_free(dir);
@@ -316,6 +385,29 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_record_close(RECORD_STORAGE);
 }
 
+static int32_t rpc_system_storage_read_ahead_worker(void* context) {
+    RpcStorageReadAhead* read_ahead = context;
+    uint8_t slot;
+
+    while(read_ahead->size_left) {
+        furi_check(
+            furi_message_queue_get(read_ahead->free_queue, &slot, FuriWaitForever) ==
+            FuriStatusOk);
+
+        size_t read_size = MIN(read_ahead->size_left, read_ahead->chunk_size);
+        pb_bytes_array_t* data = read_ahead->slots[slot];
+        data->size = storage_file_read(read_ahead->file, data->bytes, read_size);
+        // Short read ends the stream, consumer reports the error
+        read_ahead->size_left = (data->size == read_size) ? read_ahead->size_left - read_size : 0;
+
+        furi_check(
+            furi_message_queue_put(read_ahead->ready_queue, &slot, FuriWaitForever) ==
+            FuriStatusOk);
+    }
+
+    return 0;
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -338,37 +430,79 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
+
+        RpcStorageReadAhead read_ahead = {
+            .file = file,
+            .chunk_size = rpc_session_get_chunk_size(session),
+            .size_left = size_left,
+        };
+        size_t depth = CLAMP(
+            (size_left + read_ahead.chunk_size - 1) / read_ahead.chunk_size,
+            RPC_STORAGE_PIPELINE_DEPTH,
+            1);
+        size_t tx_buffer_size = read_ahead.chunk_size + RPC_STORAGE_RESPONSE_OVERHEAD;
+        uint8_t* tx_buffer = malloc(tx_buffer_size);
+
+        read_ahead.free_queue = furi_message_queue_alloc(depth, sizeof(uint8_t));
+        read_ahead.ready_queue = furi_message_queue_alloc(depth, sizeof(uint8_t));
+        for(uint8_t i = 0; i < depth; ++i) {
+            read_ahead.slots[i] = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_ahead.chunk_size));
+            furi_message_queue_put(read_ahead.free_queue, &i, 0);
+        }
+
+        // Storage reads overlap with transport sends only when there is more than one chunk
+        FuriThread* thread = NULL;
+        if(depth > 1) {
+            thread = furi_thread_alloc_ex(
+                "RpcStorageReadAhead", 1024, rpc_system_storage_read_ahead_worker, &read_ahead);
+            furi_thread_start(thread);
+        }
+
         do {
             response->command_id = request->command_id;
             response->which_content = PB_Main_storage_read_response_tag;
             response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
+            response->content.storage_read_response.has_file = true;
+
+            uint8_t slot = 0;
+            size_t read_size = MIN(size_left, read_ahead.chunk_size);
+            if(thread) {
+                furi_check(
+                    furi_message_queue_get(read_ahead.ready_queue, &slot, FuriWaitForever) ==
+                    FuriStatusOk);
             } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
+                read_ahead.slots[slot]->size =
+                    read_size ? storage_file_read(file, read_ahead.slots[slot]->bytes, read_size) :
+                                0;
             }
 
+            pb_bytes_array_t* data = read_ahead.slots[slot];
+            fs_operation_success = (data->size == read_size);
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                size_left -= read_size;
+                response->has_next = (size_left > 0);
+                /* data is owned by read-ahead slot, don't release response */
+                response->content.storage_read_response.file.data = data;
+                rpc_send_with_buffer(session, response, tx_buffer, tx_buffer_size);
+                response->content.storage_read_response.file.data = NULL;
+            }
+
+            if(thread) {
+                furi_message_queue_put(read_ahead.free_queue, &slot, FuriWaitForever);
             }
         } while((size_left != 0) && fs_operation_success);
+
+        if(thread) {
+            furi_thread_join(thread);
+            furi_thread_free(thread);
+        }
+
+        for(size_t i = 0; i < depth; ++i) {
+            free(read_ahead.slots[i]);
+        }
+        furi_message_queue_free(read_ahead.free_queue);
+        furi_message_queue_free(read_ahead.ready_queue);
+        free(tx_buffer);
     }
 
     if(!fs_operation_success) {
@@ -414,6 +548,10 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
+        rpc_storage->write_buffer_size =
+            rpc_session_get_chunk_size(session) * RPC_STORAGE_PIPELINE_DEPTH;
+        rpc_storage->write_buffer = malloc(rpc_storage->write_buffer_size);
+        rpc_storage->write_buffer_used = 0;
         const char* path = request->content.storage_write_request.path;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
@@ -428,8 +566,12 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            uint16_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            fs_operation_success =
+                rpc_system_storage_write_buffered(rpc_storage, buffer, buffer_size);
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -50,6 +50,16 @@ typedef struct {
     uint64_t size; /**< file size */
 } FileInfo;
 
+/** Longest object name returned by directory read, including terminator */
+#define STORAGE_DIR_NAME_LENGTH_MAX 256
+
+/** Structure that hold directory entry, filled by storage_dir_read_many */
+typedef struct {
+    FileInfo fileinfo; /**< size and flags */
+    uint32_t mtime; /**< modification time as UNIX timestamp, 0 if not known */
+    const char* name; /**< null terminated name, stored in caller arena */
+} StorageDirEntry;
+
 /** Gets the error text from FS_Error
  * @param error_id error id
  * @return const char* error text
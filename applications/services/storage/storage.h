@@ -186,6 +186,26 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/** Reads several objects in the directory with one request to storage thread
+ *
+ * Names are packed one after another into arena. Reading stops when entries
+ * are full, at the end of the directory, on error, or when less than
+ * STORAGE_DIR_NAME_LENGTH_MAX bytes are left in arena.
+ *
+ * @param file pointer to file object.
+ * @param entries pointer to entries array
+ * @param entries_count entries array length
+ * @param arena buffer for names, at least STORAGE_DIR_NAME_LENGTH_MAX bytes
+ * @param arena_size arena size
+ * @return number of entries read. Less than entries_count and file error id FSE_NOT_EXIST mean the end of directory
+ */
+size_t storage_dir_read_many(
+    File* file,
+    StorageDirEntry* entries,
+    size_t entries_count,
+    char* arena,
+    size_t arena_size);
+
 /** Rewinds the read pointer to first item in the directory
  * @param file pointer to file object.
  * @return bool success flag
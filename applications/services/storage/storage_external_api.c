@@ -43,6 +43,7 @@
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -357,6 +358,32 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_many(
+    File* file,
+    StorageDirEntry* entries,
+    size_t entries_count,
+    char* arena,
+    size_t arena_size) {
+    furi_assert(entries);
+    furi_assert(arena);
+    furi_check(arena_size >= STORAGE_DIR_NAME_LENGTH_MAX);
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadmany = {
+            .file = file,
+            .entries = entries,
+            .entries_count = entries_count,
+            .arena = arena,
+            .arena_size = arena_size,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadMany);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
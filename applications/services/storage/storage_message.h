@@ -45,6 +45,14 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    StorageDirEntry* entries;
+    size_t entries_count;
+    char* arena;
+    size_t arena_size;
+} SADataDReadMany;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -94,6 +102,7 @@ typedef union {
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadMany dreadmany;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
@@ -112,6 +121,7 @@ typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -130,6 +140,7 @@ typedef enum {
     StorageCommandDirOpen,
     StorageCommandDirClose,
     StorageCommandDirRead,
+    StorageCommandDirReadMany,
     StorageCommandDirRewind,
     StorageCommandCommonTimestamp,
     StorageCommandCommonStat,
@@ -308,12 +308,51 @@ bool storage_process_dir_read(
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length));
+        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length, NULL));
     }
 
     return ret;
 }
 
+size_t storage_process_dir_read_many(
+    Storage* app,
+    File* file,
+    StorageDirEntry* entries,
+    size_t entries_count,
+    char* arena,
+    size_t arena_size) {
+    size_t entries_read = 0;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        // Only read when longest name fits: entry can't be put back once read
+        while((entries_read < entries_count) && (arena_size >= STORAGE_DIR_NAME_LENGTH_MAX)) {
+            StorageDirEntry* entry = &entries[entries_read];
+            bool ret = false;
+            FS_CALL(
+                storage,
+                dir.read(
+                    storage,
+                    file,
+                    &entry->fileinfo,
+                    arena,
+                    STORAGE_DIR_NAME_LENGTH_MAX,
+                    &entry->mtime));
+            if(!ret) break;
+
+            size_t name_size = strlen(arena) + 1;
+            entry->name = arena;
+            arena += name_size;
+            arena_size -= name_size;
+            entries_read++;
+        }
+    }
+
+    return entries_read;
+}
+
 bool storage_process_dir_rewind(Storage* app, File* file) {
     bool ret = false;
     StorageData* storage = get_storage_by_file(file, app->storage);
@@ -591,6 +630,15 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->dread.name,
             message->data->dread.name_length);
         break;
+    case StorageCommandDirReadMany:
+        message->return_data->size_value = storage_process_dir_read_many(
+            app,
+            message->data->dreadmany.file,
+            message->data->dreadmany.entries,
+            message->data->dreadmany.entries_count,
+            message->data->dreadmany.arena,
+            message->data->dreadmany.arena_size);
+        break;
     case StorageCommandDirRewind:
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
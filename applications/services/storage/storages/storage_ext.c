@@ -448,6 +448,19 @@ static bool storage_ext_file_eof(void* ctx, File* file) {
 
 /******************* Dir Functions *******************/
 
+static uint32_t storage_ext_fat_time_to_timestamp(uint16_t fdate, uint16_t ftime) {
+    FuriHalRtcDateTime datetime = {
+        .year = (fdate >> 9) + 1980,
+        .month = (fdate >> 5) & 0x0F,
+        .day = fdate & 0x1F,
+        .hour = ftime >> 11,
+        .minute = (ftime >> 5) & 0x3F,
+        .second = (ftime & 0x1F) * 2,
+    };
+
+    return furi_hal_rtc_datetime_to_timestamp(&datetime);
+}
+
 static bool storage_ext_dir_open(void* ctx, File* file, const char* path) {
     StorageData* storage = ctx;
 
@@ -473,7 +486,8 @@ static bool storage_ext_dir_read(
     File* file,
     FileInfo* fileinfo,
     char* name,
-    const uint16_t name_length) {
+    const uint16_t name_length,
+    uint32_t* mtime) {
     StorageData* storage = ctx;
     SDDir* file_data = storage_get_storage_file_data(file, storage);
 
@@ -492,6 +506,13 @@ static bool storage_ext_dir_read(
         snprintf(name, name_length, "%s", _fileinfo.fname);
     }
 
+    if(mtime != NULL) {
+        // Zero date is left by end of directory and by entries without timestamp
+        *mtime = _fileinfo.fdate ?
+                     storage_ext_fat_time_to_timestamp(_fileinfo.fdate, _fileinfo.ftime) :
+                     0;
+    }
+
     if(_fileinfo.fname[0] == 0) {
         file->error_id = FSE_NOT_EXIST;
     }
@@ -631,11 +631,17 @@ static bool storage_int_dir_read(
     File* file,
     FileInfo* fileinfo,
     char* name,
-    const uint16_t name_length) {
+    const uint16_t name_length,
+    uint32_t* mtime) {
     StorageData* storage = ctx;
     lfs_t* lfs = lfs_get_from_storage(storage);
     LFSHandle* handle = storage_get_storage_file_data(file, storage);
 
+    // LFS doesn't keep modification time
+    if(mtime != NULL) {
+        *mtime = 0;
+    }
+
     if(lfs_handle_is_open(handle)) {
         struct lfs_info _fileinfo;
 
@@ -1,15 +1,75 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_TAG_FILTERS_MAX 8
+#define FURI_LOG_TAG_SIZE 32
+
+#define FURI_LOG_ASYNC_BUFFER_SIZE 4096
+#define FURI_LOG_ASYNC_ARGS_MAX 128
+#define FURI_LOG_ASYNC_STRING_MAX 64
+#define FURI_LOG_ASYNC_FORMAT_MAX 128
+#define FURI_LOG_ASYNC_SPEC_MAX 24
+#define FURI_LOG_ASYNC_THREAD_STACK 2048
+#define FURI_LOG_ASYNC_FLAG_DATA (1 << 0)
+
+#define FURI_LOG_RECORD_COMMITTED (1UL << 31)
+#define FURI_LOG_RECORD_PADDING (1UL << 30)
+#define FURI_LOG_RECORD_SIZE_MASK (0xFFFFUL)
+
+typedef struct {
+    char tag[FURI_LOG_TAG_SIZE];
+    FuriLogLevel level;
+} FuriLogTagFilter;
+
+/* Binary log record, formatted later by drain thread
+ * Arguments are stored in format order, strings are copied inline.
+ * Tag and format living in firmware flash are referenced, anything else
+ * (application literals, dynamic strings) is copied after arguments.
+ */
+typedef struct {
+    uint32_t header; /**< size and flags, written last to commit record */
+    uint32_t timestamp;
+    const char* tag; /**< NULL for raw records */
+    const char* format;
+    uint8_t level;
+    bool truncated;
+    uint16_t args_size;
+    uint8_t args[];
+} FuriLogRecord;
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t reserve; /**< bytes reserved by producers, monotonic */
+    uint32_t read; /**< bytes released by drain thread, monotonic */
+    uint32_t dropped;
+    FuriThread* thread;
+} FuriLogRing;
+
+typedef enum {
+    FuriLogArgTypeNone,
+    FuriLogArgTypeInt,
+    FuriLogArgTypeLongLong,
+    FuriLogArgTypePointer,
+    FuriLogArgTypeDouble,
+    FuriLogArgTypeString,
+} FuriLogArgType;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPuts puts;
     FuriLogTimestamp timestamp;
     FuriMutex* mutex;
+    FuriLogTagFilter tag_filters[FURI_LOG_TAG_FILTERS_MAX];
+    size_t tag_filters_count;
+    bool async;
+    FuriLogRing ring;
 } FuriLogParams;
 
 static FuriLogParams furi_log;
@@ -22,49 +82,465 @@ void furi_log_init() {
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
+static bool furi_log_is_enabled(FuriLogLevel level, const char* tag) {
+    FuriLogLevel max_level = furi_log.log_level;
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
-            break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
-            break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
-            break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
-            break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
-            break;
-        default:
+    if(tag) {
+        size_t count = __atomic_load_n(&furi_log.tag_filters_count, __ATOMIC_ACQUIRE);
+        for(size_t i = 0; i < count; i++) {
+            FuriLogTagFilter* filter = &furi_log.tag_filters[i];
+            if(strcmp(filter->tag, tag) == 0) {
+                if(filter->level != FuriLogLevelDefault) {
+                    max_level = filter->level;
+                }
+                break;
+            }
+        }
+    }
+
+    return level <= max_level;
+}
+
+static void furi_log_get_level_style(FuriLogLevel level, const char** color, const char** letter) {
+    *color = _FURI_LOG_CLR_RESET;
+    *letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        *color = _FURI_LOG_CLR_E;
+        *letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        *color = _FURI_LOG_CLR_W;
+        *letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        *color = _FURI_LOG_CLR_I;
+        *letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        *color = _FURI_LOG_CLR_D;
+        *letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        *color = _FURI_LOG_CLR_T;
+        *letter = "T";
+        break;
+    default:
+        break;
+    }
+}
+
+static void furi_log_puts_header(
+    FuriString* string,
+    FuriLogLevel level,
+    const char* tag,
+    uint32_t timestamp) {
+    const char* color;
+    const char* log_letter;
+    furi_log_get_level_style(level, &color, &log_letter);
+
+    furi_string_printf(
+        string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, timestamp, color, log_letter, tag);
+    furi_log.puts(furi_string_get_cstr(string));
+    furi_string_reset(string);
+}
+
+/******************* Async *******************/
+
+/* Parse conversion specification
+ * format points after '%', returns pointer after conversion character
+ */
+static const char*
+    furi_log_spec_parse(const char* format, FuriLogArgType* type, uint8_t* stars) {
+    uint8_t longs = 0;
+    *type = FuriLogArgTypeNone;
+    *stars = 0;
+
+    for(; *format; format++) {
+        char c = *format;
+        if(c == '*') {
+            (*stars)++;
+        } else if(c == 'l') {
+            longs++;
+        } else if(c == 'j' || c == 'L' || c == 'q') {
+            longs = 2;
+        } else if(strchr("-+ #.0123456789hzt", c)) {
+            // flags, width, precision and 32 bit length modifiers
+        } else {
+            if(strchr("diouxXc", c)) {
+                *type = (longs >= 2 && sizeof(long long) > sizeof(int)) ? FuriLogArgTypeLongLong :
+                                                                          FuriLogArgTypeInt;
+            } else if(c == 'p') {
+                *type = FuriLogArgTypePointer;
+            } else if(c == 's') {
+                *type = FuriLogArgTypeString;
+            } else if(strchr("fFeEgGaA", c)) {
+                *type = FuriLogArgTypeDouble;
+            }
+            return format + 1;
+        }
+    }
+
+    return format;
+}
+
+static bool furi_log_args_put(uint8_t* args, size_t* size, const void* value, size_t value_size) {
+    if(*size + value_size > FURI_LOG_ASYNC_ARGS_MAX) {
+        return false;
+    }
+    memcpy(&args[*size], value, value_size);
+    *size += value_size;
+    return true;
+}
+
+// Capture arguments in binary form, returns false if they were truncated
+static bool furi_log_args_capture(uint8_t* args, size_t* size, const char* format, va_list ap) {
+    *size = 0;
+
+    while((format = strchr(format, '%')) != NULL) {
+        FuriLogArgType type;
+        uint8_t stars;
+        format = furi_log_spec_parse(format + 1, &type, &stars);
+
+        for(uint8_t i = 0; i < stars; i++) {
+            int value = va_arg(ap, int);
+            if(!furi_log_args_put(args, size, &value, sizeof(value))) return false;
+        }
+
+        bool fits = true;
+        if(type == FuriLogArgTypeInt) {
+            int value = va_arg(ap, int);
+            fits = furi_log_args_put(args, size, &value, sizeof(value));
+        } else if(type == FuriLogArgTypeLongLong) {
+            long long value = va_arg(ap, long long);
+            fits = furi_log_args_put(args, size, &value, sizeof(value));
+        } else if(type == FuriLogArgTypePointer) {
+            void* value = va_arg(ap, void*);
+            fits = furi_log_args_put(args, size, &value, sizeof(value));
+        } else if(type == FuriLogArgTypeDouble) {
+            double value = va_arg(ap, double);
+            fits = furi_log_args_put(args, size, &value, sizeof(value));
+        } else if(type == FuriLogArgTypeString) {
+            // Strings may not outlive the call, copy them
+            const char* value = va_arg(ap, const char*);
+            if(!value) value = "(null)";
+            size_t space = FURI_LOG_ASYNC_ARGS_MAX - *size;
+            fits = space > 0;
+            if(fits) {
+                size_t length = MIN(strlen(value), (size_t)FURI_LOG_ASYNC_STRING_MAX - 1);
+                length = MIN(length, space - 1);
+                memcpy(&args[*size], value, length);
+                args[*size + length] = '\0';
+                *size += length + 1;
+            }
+        }
+        if(!fits) return false;
+    }
+
+    return true;
+}
+
+static FuriLogRecord* furi_log_ring_reserve(FuriLogRing* ring, uint32_t size) {
+    uint32_t reserve = __atomic_load_n(&ring->reserve, __ATOMIC_RELAXED);
+    uint32_t offset;
+    uint32_t padding;
+
+    do {
+        offset = reserve % FURI_LOG_ASYNC_BUFFER_SIZE;
+        // Records are contiguous, skip tail of buffer if record doesn't fit there
+        padding = 0;
+        if(offset + size > FURI_LOG_ASYNC_BUFFER_SIZE) {
+            padding = FURI_LOG_ASYNC_BUFFER_SIZE - offset;
+        }
+        uint32_t read = __atomic_load_n(&ring->read, __ATOMIC_ACQUIRE);
+        if(reserve + padding + size - read > FURI_LOG_ASYNC_BUFFER_SIZE) {
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &ring->reserve,
+        &reserve,
+        reserve + padding + size,
+        true,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_RELAXED));
+
+    if(padding) {
+        __atomic_store_n(
+            (uint32_t*)&ring->buffer[offset],
+            padding | FURI_LOG_RECORD_PADDING | FURI_LOG_RECORD_COMMITTED,
+            __ATOMIC_RELEASE);
+        offset = 0;
+    }
+
+    return (FuriLogRecord*)&ring->buffer[offset];
+}
+
+// Firmware flash content outlives any record, unlike RAM or loaded applications
+static bool furi_log_is_static(const char* string) {
+    size_t address = (size_t)string;
+    return address >= furi_hal_flash_get_base() &&
+           address < (size_t)furi_hal_flash_get_free_start_address();
+}
+
+static size_t furi_log_copy_size(const char* string, size_t max) {
+    if(!string || furi_log_is_static(string)) {
+        return 0;
+    }
+    return MIN(strlen(string), max - 1) + 1;
+}
+
+static const char* furi_log_copy(uint8_t* destination, const char* string, size_t size) {
+    if(!size) {
+        return string;
+    }
+    memcpy(destination, string, size - 1);
+    destination[size - 1] = '\0';
+    return (const char*)destination;
+}
+
+static void furi_log_async_write(
+    FuriLogLevel level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    FuriLogRing* ring = &furi_log.ring;
+    uint8_t args_buffer[FURI_LOG_ASYNC_ARGS_MAX];
+    size_t args_size;
+    bool truncated = !furi_log_args_capture(args_buffer, &args_size, format, args);
+    size_t tag_size = furi_log_copy_size(tag, FURI_LOG_TAG_SIZE);
+    size_t format_size = furi_log_copy_size(format, FURI_LOG_ASYNC_FORMAT_MAX);
+    truncated |= format_size && format[format_size - 1] != '\0';
+
+    uint32_t size = (sizeof(FuriLogRecord) + args_size + tag_size + format_size + 3) & ~3UL;
+    FuriLogRecord* record = furi_log_ring_reserve(ring, size);
+    if(!record) {
+        __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    record->timestamp = furi_log.timestamp();
+    record->level = level;
+    record->truncated = truncated;
+    record->args_size = args_size;
+    memcpy(record->args, args_buffer, args_size);
+    record->tag = furi_log_copy(&record->args[args_size], tag, tag_size);
+    record->format = furi_log_copy(&record->args[args_size + tag_size], format, format_size);
+    __atomic_store_n(&record->header, size | FURI_LOG_RECORD_COMMITTED, __ATOMIC_RELEASE);
+
+    furi_thread_flags_set(furi_thread_get_id(ring->thread), FURI_LOG_ASYNC_FLAG_DATA);
+}
+
+static bool furi_log_args_get(
+    const FuriLogRecord* record,
+    size_t* position,
+    void* value,
+    size_t value_size) {
+    if(*position + value_size > record->args_size) {
+        return false;
+    }
+    memcpy(value, &record->args[*position], value_size);
+    *position += value_size;
+    return true;
+}
+
+static void furi_log_record_format(const FuriLogRecord* record, FuriString* string) {
+    const char* format = record->format;
+    size_t position = 0;
+    char spec[FURI_LOG_ASYNC_SPEC_MAX];
+
+    while(*format) {
+        const char* percent = strchr(format, '%');
+        if(!percent) {
+            furi_string_cat_str(string, format);
             break;
         }
+        furi_string_cat_printf(string, "%.*s", (int)(percent - format), format);
+
+        FuriLogArgType type;
+        uint8_t stars;
+        const char* spec_end = furi_log_spec_parse(percent + 1, &type, &stars);
+
+        // Rebuild single conversion, '*' replaced with captured values
+        size_t spec_length = 0;
+        bool complete = true;
+        for(const char* c = percent; c < spec_end && complete; c++) {
+            if(*c == '*') {
+                int value = 0;
+                complete = furi_log_args_get(record, &position, &value, sizeof(value));
+                int length =
+                    snprintf(&spec[spec_length], sizeof(spec) - spec_length, "%d", value);
+                spec_length = MIN(spec_length + length, sizeof(spec) - 1);
+            } else if(spec_length < sizeof(spec) - 1) {
+                spec[spec_length++] = *c;
+            }
+            complete = complete && (spec_length < sizeof(spec) - 1);
+        }
+        spec[spec_length] = '\0';
+        format = spec_end;
+
+        if(complete) {
+            if(type == FuriLogArgTypeNone) {
+                if(spec_end[-1] == '%') furi_string_push_back(string, '%');
+            } else if(type == FuriLogArgTypeInt) {
+                int value;
+                complete = furi_log_args_get(record, &position, &value, sizeof(value));
+                if(complete) furi_string_cat_printf(string, spec, value);
+            } else if(type == FuriLogArgTypeLongLong) {
+                long long value;
+                complete = furi_log_args_get(record, &position, &value, sizeof(value));
+                if(complete) furi_string_cat_printf(string, spec, value);
+            } else if(type == FuriLogArgTypePointer) {
+                void* value;
+                complete = furi_log_args_get(record, &position, &value, sizeof(value));
+                if(complete) furi_string_cat_printf(string, spec, value);
+            } else if(type == FuriLogArgTypeDouble) {
+                double value;
+                complete = furi_log_args_get(record, &position, &value, sizeof(value));
+                if(complete) furi_string_cat_printf(string, spec, value);
+            } else if(type == FuriLogArgTypeString) {
+                const char* value = (const char*)&record->args[position];
+                complete = position < record->args_size;
+                if(complete) {
+                    furi_string_cat_printf(string, spec, value);
+                    position += strlen(value) + 1;
+                }
+            }
+        }
+
+        if(!complete) {
+            // Arguments were truncated by producer
+            furi_string_cat_str(string, "...");
+            return;
+        }
+    }
+
+    if(record->truncated) {
+        furi_string_cat_str(string, "...");
+    }
+}
+
+static void furi_log_record_emit(const FuriLogRecord* record, FuriString* string) {
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(record->tag) {
+        furi_log_puts_header(string, record->level, record->tag, record->timestamp);
+    }
+
+    furi_log_record_format(record, string);
+    furi_log.puts(furi_string_get_cstr(string));
+    furi_string_reset(string);
+
+    if(record->tag) {
+        furi_log.puts("\r\n");
+    }
+
+    furi_mutex_release(furi_log.mutex);
+}
+
+static int32_t furi_log_async_worker(void* context) {
+    FuriLogRing* ring = context;
+    FuriString* string = furi_string_alloc();
+    uint32_t dropped_reported = 0;
+
+    while(true) {
+        uint32_t read = ring->read;
+        if(read == __atomic_load_n(&ring->reserve, __ATOMIC_ACQUIRE)) {
+            furi_thread_flags_wait(FURI_LOG_ASYNC_FLAG_DATA, FuriFlagWaitAny, FuriWaitForever);
+            continue;
+        }
+
+        uint8_t* data = &ring->buffer[read % FURI_LOG_ASYNC_BUFFER_SIZE];
+        uint32_t header = __atomic_load_n((uint32_t*)data, __ATOMIC_ACQUIRE);
+        if(!(header & FURI_LOG_RECORD_COMMITTED)) {
+            // Reserved but still being written, producer can't be blocked by us
+            furi_delay_tick(1);
+            continue;
+        }
+
+        uint32_t size = header & FURI_LOG_RECORD_SIZE_MASK;
+        if(!(header & FURI_LOG_RECORD_PADDING)) {
+            uint32_t dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+            if(dropped != dropped_reported) {
+                furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+                furi_log_puts_header(string, FuriLogLevelWarn, "Log", furi_log.timestamp());
+                furi_string_printf(string, "%lu records dropped", dropped - dropped_reported);
+                furi_log.puts(furi_string_get_cstr(string));
+                furi_string_reset(string);
+                furi_log.puts("\r\n");
+                furi_mutex_release(furi_log.mutex);
+                dropped_reported = dropped;
+            }
+
+            furi_log_record_emit((const FuriLogRecord*)data, string);
+        }
+
+        // Stale bytes must not look like committed header on next lap
+        memset(data, 0, size);
+        __atomic_store_n(&ring->read, read + size, __ATOMIC_RELEASE);
+    }
+
+    furi_string_free(string);
+    return 0;
+}
+
+void furi_log_set_async(bool async) {
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(async && !furi_log.ring.thread) {
+        // Ring and drain thread stay allocated: producers may still hold them
+        furi_log.ring.buffer = malloc(FURI_LOG_ASYNC_BUFFER_SIZE);
+        furi_log.ring.thread = furi_thread_alloc_ex(
+            "LogDrain", FURI_LOG_ASYNC_THREAD_STACK, furi_log_async_worker, &furi_log.ring);
+        furi_thread_set_priority(furi_log.ring.thread, FuriThreadPriorityLowest);
+        furi_thread_start(furi_log.ring.thread);
+    }
+    __atomic_store_n(&furi_log.async, async, __ATOMIC_RELEASE);
+
+    furi_mutex_release(furi_log.mutex);
+
+    if(!async) {
+        furi_log_flush();
+    }
+}
+
+bool furi_log_is_async(void) {
+    return furi_log.async;
+}
+
+void furi_log_flush(void) {
+    FuriLogRing* ring = &furi_log.ring;
+    if(!ring->thread || furi_thread_get_current_id() == furi_thread_get_id(ring->thread)) {
+        return;
+    }
+
+    while(__atomic_load_n(&ring->read, __ATOMIC_ACQUIRE) !=
+          __atomic_load_n(&ring->reserve, __ATOMIC_ACQUIRE)) {
+        furi_delay_tick(1);
+    }
+}
+
+uint32_t furi_log_get_dropped(void) {
+    return __atomic_load_n(&furi_log.ring.dropped, __ATOMIC_RELAXED);
+}
+
+/******************* Public *******************/
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(!furi_log_is_enabled(level, tag)) {
+        return;
+    }
+
+    if(__atomic_load_n(&furi_log.async, __ATOMIC_ACQUIRE)) {
+        va_list args;
+        va_start(args, format);
+        furi_log_async_write(level, tag, format, args);
+        va_end(args);
+    } else if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+        FuriString* string;
+        string = furi_string_alloc();
 
         // Timestamp
-        furi_string_printf(
-            string,
-            "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET,
-            furi_log.timestamp(),
-            color,
-            log_letter,
-            tag);
-        furi_log.puts(furi_string_get_cstr(string));
-        furi_string_reset(string);
+        furi_log_puts_header(string, level, tag, furi_log.timestamp());
 
         va_list args;
         va_start(args, format);
@@ -81,8 +557,16 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 }
 
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+    if(!furi_log_is_enabled(level, NULL)) {
+        return;
+    }
+
+    if(__atomic_load_n(&furi_log.async, __ATOMIC_ACQUIRE)) {
+        va_list args;
+        va_start(args, format);
+        furi_log_async_write(level, NULL, format, args);
+        va_end(args);
+    } else if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         FuriString* string;
         string = furi_string_alloc();
         va_list args;
@@ -108,6 +592,39 @@ FuriLogLevel furi_log_get_level(void) {
     return furi_log.log_level;
 }
 
+bool furi_log_set_tag_level(const char* tag, FuriLogLevel level) {
+    furi_assert(tag);
+    if(strlen(tag) >= FURI_LOG_TAG_SIZE) {
+        return false;
+    }
+    bool success = true;
+
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Filters are never removed, so lock-free readers always see a valid entry
+    size_t i;
+    for(i = 0; i < furi_log.tag_filters_count; i++) {
+        if(strcmp(furi_log.tag_filters[i].tag, tag) == 0) {
+            furi_log.tag_filters[i].level = level;
+            break;
+        }
+    }
+
+    if(i == furi_log.tag_filters_count) {
+        if(i < FURI_LOG_TAG_FILTERS_MAX) {
+            // Copied: tag may belong to application that will be unloaded
+            strlcpy(furi_log.tag_filters[i].tag, tag, FURI_LOG_TAG_SIZE);
+            furi_log.tag_filters[i].level = level;
+            __atomic_store_n(&furi_log.tag_filters_count, i + 1, __ATOMIC_RELEASE);
+        } else {
+            success = false;
+        }
+    }
+
+    furi_mutex_release(furi_log.mutex);
+    return success;
+}
+
 void furi_log_set_puts(FuriLogPuts puts) {
     furi_assert(puts);
     furi_log.puts = puts;
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 
 #ifdef __cplusplus
@@ -87,6 +88,45 @@ void furi_log_set_puts(FuriLogPuts puts);
  */
 void furi_log_set_timestamp(FuriLogTimestamp timestamp);
 
+/** Set log level for specific tag
+ *
+ * Checked before formatting, so filtered records cost nothing. Tag filters
+ * are kept for the lifetime of the system, their number is limited.
+ *
+ * @param[in]  tag    The tag, copied, up to 31 characters
+ * @param[in]  level  The level, FuriLogLevelDefault to follow global level
+ *
+ * @return     false if tag is too long or there is no room for new tag filter
+ */
+bool furi_log_set_tag_level(const char* tag, FuriLogLevel level);
+
+/** Enable or disable asynchronous logging
+ *
+ * In async mode callers only capture arguments into a lock-free ring buffer,
+ * formatting and output are done by a low priority drain thread. String
+ * arguments are copied and truncated, records are dropped when ring is full.
+ * Tag and format are referenced only when they are in firmware flash,
+ * otherwise they are copied into the record too.
+ *
+ * @param[in]  async  true to enable async mode
+ */
+void furi_log_set_async(bool async);
+
+/** Check if async logging is enabled
+ *
+ * @return     true if enabled
+ */
+bool furi_log_is_async(void);
+
+/** Wait until all pending async records are printed */
+void furi_log_flush(void);
+
+/** Get number of async records dropped because ring was full
+ *
+ * @return     dropped records count
+ */
+uint32_t furi_log_get_dropped(void);
+
 /** Log methods
  *
  * @param      tag     The application tag
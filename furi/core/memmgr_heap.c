@@ -35,6 +35,7 @@
  */
 
 #include "memmgr_heap.h"
+#include "memmgr_slab.h"
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -112,111 +113,213 @@ space. */
 static size_t xBlockAllocatedBit = 0;
 
 /* Furi heap extension */
-#include <m-dict.h>
-
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t)
-DICT_DEF2(
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
-
-/* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
-
-/* Initialize tracing storage on start */
-void memmgr_heap_init() {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+
+/* Allocated blocks carry trace tag in xBlockSize bits below allocated bit:
+trace slot index + 1 (0 - not traced) and slot generation. Generation lets
+free() ignore blocks allocated by previous owner of reused slot. Heap is far
+smaller than 16MB, so these bits are never part of the size. */
+#define MEMMGR_HEAP_TRACE_SHIFT (24U)
+#define MEMMGR_HEAP_TRACE_MASK ((size_t)0x7F << MEMMGR_HEAP_TRACE_SHIFT)
+#define MEMMGR_HEAP_TRACE_SLOT_BITS (4U)
+#define MEMMGR_HEAP_TRACE_SLOT_MASK ((1U << MEMMGR_HEAP_TRACE_SLOT_BITS) - 1)
+#define MEMMGR_HEAP_TRACE_GENERATION_MASK (0x7U)
+#define MEMMGR_HEAP_TRACE_SLOTS (MEMMGR_HEAP_TRACE_SLOT_MASK)
+
+/* Thread allocation tracing storage, reserved statically so tracing itself
+never touches the heap */
+typedef struct {
+    FuriThreadId thread_id;
+    uint8_t generation;
+    MemmgrHeapThreadStats stats;
+} MemmgrHeapTraceSlot;
+
+static MemmgrHeapTraceSlot memmgr_heap_trace_slots[MEMMGR_HEAP_TRACE_SLOTS] = {0};
+static size_t memmgr_heap_trace_slots_used = 0;
+
+/* Must be called with scheduler suspended */
+static MemmgrHeapTraceSlot* memmgr_heap_trace_find(FuriThreadId thread_id) {
+    for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SLOTS; i++) {
+        if(memmgr_heap_trace_slots[i].thread_id == thread_id) {
+            return &memmgr_heap_trace_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static inline size_t memmgr_heap_trace_block_size(const BlockLink_t* pxLink) {
+    return pxLink->xBlockSize & ~(xBlockAllocatedBit | MEMMGR_HEAP_TRACE_MASK);
 }
 
 void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
+        furi_check(memmgr_heap_trace_find(thread_id) == NULL);
+        // Threads beyond table capacity stay untraced
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(NULL);
+        if(slot) {
+            slot->generation = (slot->generation + 1) & MEMMGR_HEAP_TRACE_GENERATION_MASK;
+            memset(&slot->stats, 0, sizeof(MemmgrHeapThreadStats));
+            slot->thread_id = thread_id;
+            memmgr_heap_trace_slots_used++;
+        }
     }
     (void)xTaskResumeAll();
 }
 
 void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
-        memmgr_heap_thread_trace_depth--;
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            slot->thread_id = NULL;
+            memmgr_heap_trace_slots_used--;
+        }
     }
     (void)xTaskResumeAll();
 }
 
-size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
-    size_t leftovers = MEMMGR_HEAP_UNKNOWN;
+bool memmgr_heap_get_thread_stats(FuriThreadId thread_id, MemmgrHeapThreadStats* stats) {
+    furi_assert(stats);
+    bool traced = false;
+    if(!thread_id) return traced;
+
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            leftovers = 0;
-            MemmgrHeapAllocDict_it_t alloc_dict_it;
-            for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-                !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-                MemmgrHeapAllocDict_next(alloc_dict_it)) {
-                MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-                if(data->key != 0) {
-                    uint8_t* puc = (uint8_t*)data->key;
-                    puc -= xHeapStructSize;
-                    BlockLink_t* pxLink = (void*)puc;
-
-                    if((pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
-                       pxLink->pxNextFreeBlock == NULL) {
-                        leftovers += data->value;
-                    }
-                }
-            }
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            *stats = slot->stats;
+            traced = true;
         }
-        memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
-    return leftovers;
+    return traced;
 }
 
-#undef traceMALLOC
-static inline void traceMALLOC(void* pointer, size_t size) {
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
-        }
-        memmgr_heap_thread_trace_depth--;
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    MemmgrHeapThreadStats stats;
+    if(memmgr_heap_get_thread_stats(thread_id, &stats)) {
+        return stats.live;
     }
+    return MEMMGR_HEAP_UNKNOWN;
 }
 
-#undef traceFREE
-static inline void traceFREE(void* pointer, size_t size) {
-    UNUSED(size);
+/* Account freshly allocated block, called with scheduler suspended */
+static inline void memmgr_heap_trace_malloc(BlockLink_t* pxLink) {
+    if(memmgr_heap_trace_slots_used == 0) return;
+
     FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            // In some cases thread may want to release memory that was not allocated by it
-            const bool res = MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-            UNUSED(res);
+    if(!thread_id) return;
+
+    MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+    if(!slot) return;
+
+    size_t size = memmgr_heap_trace_block_size(pxLink);
+    size_t index = slot - memmgr_heap_trace_slots;
+    size_t tag = (slot->generation << MEMMGR_HEAP_TRACE_SLOT_BITS) | (index + 1);
+    pxLink->xBlockSize |= tag << MEMMGR_HEAP_TRACE_SHIFT;
+
+    MemmgrHeapThreadStats* stats = &slot->stats;
+    stats->live += size;
+    stats->peak = MAX(stats->peak, stats->live);
+    stats->allocations++;
+
+    // Bucket i holds blocks up to 16 << i bytes
+    size_t bucket = 0;
+    while(bucket < MEMMGR_HEAP_HISTOGRAM_SIZE - 1 && size > (16U << bucket)) {
+        bucket++;
+    }
+    stats->histogram[bucket]++;
+}
+
+/* Release block from owner accounting, called with scheduler suspended */
+static inline void memmgr_heap_trace_free(BlockLink_t* pxLink) {
+    size_t tag = (pxLink->xBlockSize & MEMMGR_HEAP_TRACE_MASK) >> MEMMGR_HEAP_TRACE_SHIFT;
+    if(tag == 0) return;
+    pxLink->xBlockSize &= ~MEMMGR_HEAP_TRACE_MASK;
+
+    // Owner, not freeing thread, is credited: memory may be released by other thread
+    size_t index = (tag & MEMMGR_HEAP_TRACE_SLOT_MASK) - 1;
+    MemmgrHeapTraceSlot* slot = &memmgr_heap_trace_slots[index];
+    if(slot->thread_id && slot->generation == (tag >> MEMMGR_HEAP_TRACE_SLOT_BITS)) {
+        slot->stats.live -= pxLink->xBlockSize;
+    }
+}
+
+/* Small allocations are served by slab arena carved from the heap on init,
+heap is used when arena is full. Heap trace stores owner in block header, so
+traced threads always use the heap. Slab is opt-in: build with
+--extra-define=MEMMGR_HEAP_SLAB to enable it. */
+#ifndef MEMMGR_HEAP_SLAB_ARENA_SIZE
+#if defined(MEMMGR_HEAP_SLAB) && !defined(HEAP_PRINT_DEBUG)
+#define MEMMGR_HEAP_SLAB_ARENA_SIZE (MEMMGR_SLAB_PAGES_MAX * MEMMGR_SLAB_PAGE_SIZE)
+#else
+#define MEMMGR_HEAP_SLAB_ARENA_SIZE (0U)
+#endif
+#endif
+
+static MemmgrSlab memmgr_heap_slab = {0};
+/* Arena bytes not held by live objects, reported as free heap so slab leaks stay visible */
+static size_t memmgr_heap_slab_free_bytes = 0U;
+static MemmgrHeapLatency memmgr_heap_latency_slab = {0};
+static MemmgrHeapLatency memmgr_heap_latency_heap = {0};
+
+/* Called once with scheduler suspended, right after heap init */
+static void memmgr_heap_slab_init() {
+    if(MEMMGR_HEAP_SLAB_ARENA_SIZE) {
+        void* arena = pvPortMalloc(MEMMGR_HEAP_SLAB_ARENA_SIZE);
+        memmgr_slab_init(&memmgr_heap_slab, arena, MEMMGR_HEAP_SLAB_ARENA_SIZE);
+        memmgr_heap_slab_free_bytes = memmgr_heap_slab.pages_count * MEMMGR_SLAB_PAGE_SIZE;
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining + memmgr_heap_slab_free_bytes;
+    }
+}
+
+/* Free heap as seen by users: heap free blocks plus unused slab arena */
+static inline size_t memmgr_heap_free_bytes() {
+    return xFreeBytesRemaining + memmgr_heap_slab_free_bytes;
+}
+
+/* Called with scheduler suspended */
+static inline void* memmgr_heap_slab_malloc(size_t size) {
+    if(!memmgr_heap_slab.pages_count || size > MEMMGR_SLAB_OBJECT_SIZE_MAX) {
+        return NULL;
+    }
+    if(memmgr_heap_trace_slots_used &&
+       memmgr_heap_trace_find(furi_thread_get_current_id()) != NULL) {
+        return NULL;
+    }
+    void* ptr = memmgr_slab_alloc(&memmgr_heap_slab, size);
+    if(ptr) {
+        memmgr_heap_slab_free_bytes -= memmgr_slab_get_size(&memmgr_heap_slab, ptr);
+        if(memmgr_heap_free_bytes() < xMinimumEverFreeBytesRemaining) {
+            xMinimumEverFreeBytesRemaining = memmgr_heap_free_bytes();
         }
-        memmgr_heap_thread_trace_depth--;
     }
+    return ptr;
+}
+
+static inline void memmgr_heap_latency_update(MemmgrHeapLatency* latency, uint32_t cycles) {
+    latency->count++;
+    latency->cycles_total += cycles;
+    latency->cycles_max = MAX(latency->cycles_max, cycles);
+}
+
+bool memmgr_heap_get_slab_stats(MemmgrSlabStats* stats) {
+    furi_assert(stats);
+    if(!memmgr_heap_slab.pages_count) return false;
+
+    vTaskSuspendAll();
+    memmgr_slab_get_stats(&memmgr_heap_slab, stats);
+    (void)xTaskResumeAll();
+    return true;
+}
+
+void memmgr_heap_get_latency(MemmgrHeapLatency* slab, MemmgrHeapLatency* heap) {
+    vTaskSuspendAll();
+    if(slab) *slab = memmgr_heap_latency_slab;
+    if(heap) *heap = memmgr_heap_latency_heap;
+    (void)xTaskResumeAll();
 }
 
 size_t memmgr_heap_get_max_free_block() {
@@ -359,20 +462,26 @@ void* pvPortMalloc(size_t xWantedSize) {
         vTaskSuspendAll();
         {
             prvHeapInit();
-            memmgr_heap_init();
+            memmgr_heap_slab_init();
         }
         (void)xTaskResumeAll();
     } else {
         mtCOVERAGE_TEST_MARKER();
     }
 
+    uint32_t cycles_start = DWT->CYCCNT;
     vTaskSuspendAll();
     {
+        pvReturn = memmgr_heap_slab_malloc(xWantedSize);
+        if(pvReturn) {
+            memmgr_heap_latency_update(&memmgr_heap_latency_slab, DWT->CYCCNT - cycles_start);
+        }
+
         /* Check the requested block size is not so large that the top bit is
         set.  The top bit of the block size member of the BlockLink_t structure
         is used to determine who owns the block - the application or the
         kernel, so it must be free. */
-        if((xWantedSize & xBlockAllocatedBit) == 0) {
+        if(!pvReturn && (xWantedSize & xBlockAllocatedBit) == 0) {
             /* The wanted size is increased so it can contain a BlockLink_t
             structure in addition to the requested amount of bytes. */
             if(xWantedSize > 0) {
@@ -436,8 +545,8 @@ void* pvPortMalloc(size_t xWantedSize) {
 
                     xFreeBytesRemaining -= pxBlock->xBlockSize;
 
-                    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    if(memmgr_heap_free_bytes() < xMinimumEverFreeBytesRemaining) {
+                        xMinimumEverFreeBytesRemaining = memmgr_heap_free_bytes();
                     } else {
                         mtCOVERAGE_TEST_MARKER();
                     }
@@ -460,12 +569,15 @@ void* pvPortMalloc(size_t xWantedSize) {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceMALLOC(pvReturn, xWantedSize);
+        if(pvReturn && !memmgr_slab_contains(&memmgr_heap_slab, pvReturn)) {
+            memmgr_heap_trace_malloc((BlockLink_t*)((uint8_t*)pvReturn - xHeapStructSize));
+            memmgr_heap_latency_update(&memmgr_heap_latency_heap, DWT->CYCCNT - cycles_start);
+        }
     }
     (void)xTaskResumeAll();
 
 #ifdef HEAP_PRINT_DEBUG
-    print_heap_malloc(print_heap_block, print_heap_block->xBlockSize & ~xBlockAllocatedBit);
+    print_heap_malloc(print_heap_block, memmgr_heap_trace_block_size(print_heap_block));
 #endif
 
 #if(configUSE_MALLOC_FAILED_HOOK == 1)
@@ -495,6 +607,14 @@ void vPortFree(void* pv) {
         furi_crash("memmgt in ISR");
     }
 
+    if(memmgr_slab_contains(&memmgr_heap_slab, pv)) {
+        vTaskSuspendAll();
+        memmgr_heap_slab_free_bytes += memmgr_slab_get_size(&memmgr_heap_slab, pv);
+        memmgr_slab_free(&memmgr_heap_slab, pv);
+        (void)xTaskResumeAll();
+        return;
+    }
+
     if(pv != NULL) {
         /* The memory being freed will have an BlockLink_t structure immediately
         before it. */
@@ -519,6 +639,8 @@ void vPortFree(void* pv) {
 
                 vTaskSuspendAll();
                 {
+                    memmgr_heap_trace_free(pxLink);
+
                     furi_assert((size_t)pv >= SRAM_BASE);
                     furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
                     furi_assert(pxLink->xBlockSize >= xHeapStructSize);
@@ -526,7 +648,6 @@ void vPortFree(void* pv) {
 
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE(pv, pxLink->xBlockSize);
                     memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
                     prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
                 }
@@ -551,7 +672,7 @@ size_t xPortGetTotalHeapSize(void) {
 /*-----------------------------------------------------------*/
 
 size_t xPortGetFreeHeapSize(void) {
-    return xFreeBytesRemaining;
+    return memmgr_heap_free_bytes();
 }
 /*-----------------------------------------------------------*/
 
@@ -6,7 +6,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <core/thread.h>
+#include <core/memmgr_slab.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,7 +16,29 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Number of allocation size histogram buckets, bucket N counts blocks up to
+ * 16 << N bytes, last one counts everything bigger
+ */
+#define MEMMGR_HEAP_HISTOGRAM_SIZE 8
+
+/** Thread heap usage, sizes include block headers */
+typedef struct {
+    size_t live; /**< bytes allocated right now */
+    size_t peak; /**< max live bytes since trace start */
+    size_t allocations; /**< allocations since trace start */
+    uint32_t histogram[MEMMGR_HEAP_HISTOGRAM_SIZE]; /**< allocations by block size */
+} MemmgrHeapThreadStats;
+
+/** Allocation latency, in CPU cycles */
+typedef struct {
+    uint32_t count;
+    uint32_t cycles_max;
+    uint64_t cycles_total;
+} MemmgrHeapLatency;
+
 /** Memmgr heap enable thread allocation tracking
+ *
+ * Tracking table is preallocated, threads above its capacity are not tracked.
  *
  * @param      thread_id  - thread id to track
  */
@@ -34,12 +58,40 @@ void memmgr_heap_disable_thread_trace(FuriThreadId taks_handle);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
 
+/** Memmgr heap get thread allocation statistics
+ *
+ * Memory freed by other threads is credited to the allocating thread.
+ *
+ * @param      thread_id  - thread id to query
+ * @param      stats      - statistics output
+ *
+ * @return     true if thread is tracked
+ */
+bool memmgr_heap_get_thread_stats(FuriThreadId thread_id, MemmgrHeapThreadStats* stats);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
  */
 size_t memmgr_heap_get_max_free_block();
 
+/** Memmgr heap get small allocation slab statistics
+ *
+ * @param      stats  - statistics output
+ *
+ * @return     false if slab is disabled, it is enabled by MEMMGR_HEAP_SLAB define
+ */
+bool memmgr_heap_get_slab_stats(MemmgrSlabStats* stats);
+
+/** Memmgr heap get malloc latency of slab and heap paths
+ *
+ * Heap path includes failed slab attempt, if any.
+ *
+ * @param      slab  - slab latency output, may be NULL
+ * @param      heap  - heap latency output, may be NULL
+ */
+void memmgr_heap_get_latency(MemmgrHeapLatency* slab, MemmgrHeapLatency* heap);
+
 /** Print the address and size of all free blocks to stdout
  */
 void memmgr_heap_printf_free_blocks();
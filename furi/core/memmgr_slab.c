@@ -0,0 +1,181 @@
+#include "memmgr_slab.h"
+#include <string.h>
+
+#ifdef MEMMGR_SLAB_HOST
+#include <assert.h>
+#define memmgr_slab_check(x) assert(x)
+#else
+#include "check.h"
+#define memmgr_slab_check(x) furi_check(x)
+#endif
+
+#define MEMMGR_SLAB_PAGE_NONE (0xFFU)
+
+static const uint16_t memmgr_slab_class_size[MEMMGR_SLAB_CLASS_COUNT] = {
+    16,
+    24,
+    32,
+    48,
+    64,
+    96,
+    128,
+};
+
+_Static_assert(
+    MEMMGR_SLAB_PAGE_SIZE / 16U <= 32U,
+    "Objects of smallest class must fit MemmgrSlabPage allocated bitmap");
+
+static inline uint8_t* memmgr_slab_page_data(const MemmgrSlab* slab, uint8_t page) {
+    return slab->arena + (size_t)page * MEMMGR_SLAB_PAGE_SIZE;
+}
+
+static void memmgr_slab_list_push(MemmgrSlab* slab, uint8_t* head, uint8_t page) {
+    slab->pages[page].prev = MEMMGR_SLAB_PAGE_NONE;
+    slab->pages[page].next = *head;
+    if(*head != MEMMGR_SLAB_PAGE_NONE) {
+        slab->pages[*head].prev = page;
+    }
+    *head = page;
+}
+
+static void memmgr_slab_list_remove(MemmgrSlab* slab, uint8_t* head, uint8_t page) {
+    MemmgrSlabPage* descriptor = &slab->pages[page];
+    if(descriptor->prev != MEMMGR_SLAB_PAGE_NONE) {
+        slab->pages[descriptor->prev].next = descriptor->next;
+    } else {
+        *head = descriptor->next;
+    }
+    if(descriptor->next != MEMMGR_SLAB_PAGE_NONE) {
+        slab->pages[descriptor->next].prev = descriptor->prev;
+    }
+}
+
+void memmgr_slab_init(MemmgrSlab* slab, void* arena, size_t arena_size) {
+    memmgr_slab_check(slab);
+    memmgr_slab_check(((size_t)arena & 7) == 0);
+    memset(slab, 0, sizeof(MemmgrSlab));
+
+    slab->arena = arena;
+    slab->pages_count = arena_size / MEMMGR_SLAB_PAGE_SIZE;
+    if(slab->pages_count > MEMMGR_SLAB_PAGES_MAX) {
+        slab->pages_count = MEMMGR_SLAB_PAGES_MAX;
+    }
+
+    slab->pages_free = MEMMGR_SLAB_PAGE_NONE;
+    for(uint8_t page = slab->pages_count; page > 0; page--) {
+        memmgr_slab_list_push(slab, &slab->pages_free, page - 1);
+    }
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+        slab->partial[i] = MEMMGR_SLAB_PAGE_NONE;
+        slab->stats[i].object_size = memmgr_slab_class_size[i];
+    }
+}
+
+void* memmgr_slab_alloc(MemmgrSlab* slab, size_t size) {
+    if(size == 0 || size > MEMMGR_SLAB_OBJECT_SIZE_MAX) {
+        return NULL;
+    }
+
+    uint8_t class_index = 0;
+    while(memmgr_slab_class_size[class_index] < size) {
+        class_index++;
+    }
+    MemmgrSlabClassStats* stats = &slab->stats[class_index];
+    const uint16_t object_size = memmgr_slab_class_size[class_index];
+    const uint8_t capacity = MEMMGR_SLAB_PAGE_SIZE / object_size;
+
+    uint8_t page = slab->partial[class_index];
+    if(page == MEMMGR_SLAB_PAGE_NONE) {
+        page = slab->pages_free;
+        if(page == MEMMGR_SLAB_PAGE_NONE) {
+            stats->fallbacks++;
+            return NULL;
+        }
+        memmgr_slab_list_remove(slab, &slab->pages_free, page);
+        MemmgrSlabPage* descriptor = &slab->pages[page];
+        descriptor->class_index = class_index;
+        descriptor->used = 0;
+        descriptor->carved = 0;
+        descriptor->free_head = 0;
+        descriptor->allocated = 0;
+        memmgr_slab_list_push(slab, &slab->partial[class_index], page);
+        stats->pages++;
+    }
+
+    MemmgrSlabPage* descriptor = &slab->pages[page];
+    uint8_t* data = memmgr_slab_page_data(slab, page);
+    uint8_t* object;
+    if(descriptor->free_head) {
+        object = data + descriptor->free_head - 1;
+        memcpy(&descriptor->free_head, object, sizeof(uint16_t));
+    } else {
+        // Untouched tail of the page, no need to build free list upfront
+        object = data + descriptor->carved * object_size;
+        descriptor->carved++;
+    }
+
+    descriptor->allocated |= 1UL << ((object - data) / object_size);
+    descriptor->used++;
+    if(descriptor->used == capacity) {
+        memmgr_slab_list_remove(slab, &slab->partial[class_index], page);
+    }
+
+    stats->objects_used++;
+    stats->allocations++;
+    stats->requested += size;
+
+    return object;
+}
+
+void memmgr_slab_free(MemmgrSlab* slab, void* ptr) {
+    memmgr_slab_check(memmgr_slab_contains(slab, ptr));
+
+    size_t offset = (uint8_t*)ptr - slab->arena;
+    uint8_t page = offset / MEMMGR_SLAB_PAGE_SIZE;
+    uint16_t page_offset = offset % MEMMGR_SLAB_PAGE_SIZE;
+    MemmgrSlabPage* descriptor = &slab->pages[page];
+    const uint8_t class_index = descriptor->class_index;
+    const uint16_t object_size = memmgr_slab_class_size[class_index];
+    const uint8_t capacity = MEMMGR_SLAB_PAGE_SIZE / object_size;
+
+    // Catch pointers that are not object starts, frees of free pages and double frees
+    memmgr_slab_check(descriptor->used > 0);
+    memmgr_slab_check(page_offset % object_size == 0);
+    memmgr_slab_check(page_offset / object_size < descriptor->carved);
+    const uint32_t object_bit = 1UL << (page_offset / object_size);
+    memmgr_slab_check(descriptor->allocated & object_bit);
+    descriptor->allocated &= ~object_bit;
+
+    if(descriptor->used == capacity) {
+        memmgr_slab_list_push(slab, &slab->partial[class_index], page);
+    }
+
+    memcpy(ptr, &descriptor->free_head, sizeof(uint16_t));
+    descriptor->free_head = page_offset + 1;
+    descriptor->used--;
+    slab->stats[class_index].objects_used--;
+
+    if(descriptor->used == 0) {
+        // Give page back, so it can serve another size class
+        memmgr_slab_list_remove(slab, &slab->partial[class_index], page);
+        memmgr_slab_list_push(slab, &slab->pages_free, page);
+        slab->stats[class_index].pages--;
+    }
+}
+
+size_t memmgr_slab_get_size(const MemmgrSlab* slab, const void* ptr) {
+    memmgr_slab_check(memmgr_slab_contains(slab, ptr));
+    size_t page = ((const uint8_t*)ptr - slab->arena) / MEMMGR_SLAB_PAGE_SIZE;
+    return memmgr_slab_class_size[slab->pages[page].class_index];
+}
+
+void memmgr_slab_get_stats(const MemmgrSlab* slab, MemmgrSlabStats* stats) {
+    memmgr_slab_check(stats);
+    stats->pages_total = slab->pages_count;
+    stats->pages_free = 0;
+    for(uint8_t page = slab->pages_free; page != MEMMGR_SLAB_PAGE_NONE;
+        page = slab->pages[page].next) {
+        stats->pages_free++;
+    }
+    memcpy(stats->classes, slab->stats, sizeof(stats->classes));
+}
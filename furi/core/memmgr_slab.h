@@ -0,0 +1,119 @@
+/**
+ * @file memmgr_slab.h
+ * Furi: size class slab allocator for small heap allocations
+ *
+ * Arena is split into pages, each page serves objects of one size class.
+ * Empty pages return to the arena and can be reused by any class. Allocator
+ * does no locking and has no platform dependencies, so the same code is
+ * replayed on host by scripts/memmgr_bench.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMMGR_SLAB_PAGE_SIZE (512U)
+#define MEMMGR_SLAB_PAGES_MAX (16U)
+#define MEMMGR_SLAB_CLASS_COUNT (7U)
+#define MEMMGR_SLAB_OBJECT_SIZE_MAX (128U)
+
+/** Size class statistics */
+typedef struct {
+    uint16_t object_size; /**< class object size */
+    uint16_t pages; /**< pages owned right now */
+    uint32_t objects_used; /**< objects allocated right now */
+    uint32_t allocations; /**< allocations since start */
+    uint32_t requested; /**< requested bytes since start, for internal fragmentation */
+    uint32_t fallbacks; /**< allocations passed to heap because arena was full */
+} MemmgrSlabClassStats;
+
+/** Slab statistics */
+typedef struct {
+    size_t pages_total;
+    size_t pages_free;
+    MemmgrSlabClassStats classes[MEMMGR_SLAB_CLASS_COUNT];
+} MemmgrSlabStats;
+
+/** Page descriptor, kept outside of the page so objects need no header */
+typedef struct {
+    uint8_t class_index;
+    uint8_t used; /**< objects allocated from page */
+    uint8_t carved; /**< objects ever handed out, rest is untouched */
+    uint8_t next; /**< next page in class partial list or arena free list */
+    uint8_t prev;
+    uint16_t free_head; /**< offset of first free object + 1, 0 if none */
+    uint32_t allocated; /**< bit per object, set while object is allocated */
+} MemmgrSlabPage;
+
+/** Slab allocator instance, fields are private */
+typedef struct {
+    uint8_t* arena;
+    uint8_t pages_count;
+    uint8_t pages_free;
+    uint8_t partial[MEMMGR_SLAB_CLASS_COUNT];
+    MemmgrSlabPage pages[MEMMGR_SLAB_PAGES_MAX];
+    MemmgrSlabClassStats stats[MEMMGR_SLAB_CLASS_COUNT];
+} MemmgrSlab;
+
+/** Initialize slab on top of arena
+ *
+ * @param      slab        MemmgrSlab instance
+ * @param      arena       Arena memory, 8 byte aligned
+ * @param      arena_size  Arena size, only whole pages are used
+ */
+void memmgr_slab_init(MemmgrSlab* slab, void* arena, size_t arena_size);
+
+/** Allocate object
+ *
+ * Memory is not cleared.
+ *
+ * @param      slab  MemmgrSlab instance
+ * @param      size  Requested size
+ *
+ * @return     pointer or NULL if size is too big or arena is full
+ */
+void* memmgr_slab_alloc(MemmgrSlab* slab, size_t size);
+
+/** Check if pointer belongs to slab arena
+ *
+ * @param      slab  MemmgrSlab instance
+ * @param      ptr   Pointer
+ *
+ * @return     true if pointer was allocated by slab
+ */
+static inline bool memmgr_slab_contains(const MemmgrSlab* slab, const void* ptr) {
+    return (const uint8_t*)ptr >= slab->arena &&
+           (const uint8_t*)ptr < slab->arena + slab->pages_count * MEMMGR_SLAB_PAGE_SIZE;
+}
+
+/** Free object
+ *
+ * @param      slab  MemmgrSlab instance
+ * @param      ptr   Pointer, must belong to slab
+ */
+void memmgr_slab_free(MemmgrSlab* slab, void* ptr);
+
+/** Get object size of pointer allocated by slab
+ *
+ * @param      slab  MemmgrSlab instance
+ * @param      ptr   Pointer, must belong to slab
+ *
+ * @return     usable size
+ */
+size_t memmgr_slab_get_size(const MemmgrSlab* slab, const void* ptr);
+
+/** Get slab statistics
+ *
+ * @param      slab   MemmgrSlab instance
+ * @param      stats  Statistics output
+ */
+void memmgr_slab_get_stats(const MemmgrSlab* slab, MemmgrSlabStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
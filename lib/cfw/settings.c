@@ -25,6 +25,7 @@ void CFW_SETTINGS_LOAD() {
     CfwSettings* x = &cfw_settings;
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, true);
     if(flipper_format_file_open_existing(file, CFW_SETTINGS_PATH)) {
         flipper_format_rewind(file);
         flipper_format_read_bool(file, "wii_menu", &x->wii_menu, 1);
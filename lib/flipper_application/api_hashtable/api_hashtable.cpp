@@ -36,3 +36,32 @@ bool elf_resolve_from_hashtable(
 
     return result;
 }
+
+bool elf_resolve_from_perfect_hash(
+    const ElfApiInterface* interface,
+    const char* name,
+    Elf32_Addr* address) {
+    const PerfectHashApiInterface* hash_interface =
+        static_cast<const PerfectHashApiInterface*>(interface);
+    const uint32_t gnu_sym_hash = elf_gnu_hash(name);
+    const uint32_t slot_count = hash_interface->table_cend - hash_interface->table_cbegin;
+
+    const uint16_t seed = hash_interface->bucket_seeds[elf_perfect_hash_bucket(
+        gnu_sym_hash, hash_interface->bucket_count)];
+    const sym_entry* entry =
+        hash_interface->table_cbegin +
+        elf_perfect_hash_slot(gnu_sym_hash, hash_interface->salt, seed, slot_count);
+
+    if(entry->hash != gnu_sym_hash) {
+        FURI_LOG_W(
+            TAG,
+            "Can't find symbol '%s' (hash %lx) @ %p!",
+            name,
+            gnu_sym_hash,
+            hash_interface->table_cbegin);
+        return false;
+    }
+
+    *address = entry->address;
+    return true;
+}
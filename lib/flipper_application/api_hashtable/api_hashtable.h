@@ -28,6 +28,18 @@ bool elf_resolve_from_hashtable(
     const char* name,
     Elf32_Addr* address);
 
+/**
+ * @brief Resolver for API entries using a compile-time minimal perfect hash
+ * @param interface pointer to PerfectHashApiInterface
+ * @param name function name
+ * @param address output for function address
+ * @return true if the table contains a function
+ */
+bool elf_resolve_from_perfect_hash(
+    const ElfApiInterface* interface,
+    const char* name,
+    Elf32_Addr* address);
+
 #ifdef __cplusplus
 }
 
@@ -43,6 +55,21 @@ struct HashtableApiInterface : public ElfApiInterface {
     const sym_entry *table_cbegin, *table_cend;
 };
 
+/**
+ * @brief  PerfectHashApiInterface is an implementation of ElfApiInterface
+ * that resolves function addresses with a minimal perfect hash.
+ * table_cbegin and table_cend must point to PerfectHashTable::slots,
+ * bucket_seeds and salt to PerfectHashTable fields of the same name.
+ * Use create_perfect_hash to build them, or check_perfect_hash for
+ * tables generated by fbt.
+ */
+struct PerfectHashApiInterface : public ElfApiInterface {
+    const sym_entry *table_cbegin, *table_cend;
+    const uint16_t* bucket_seeds;
+    uint32_t bucket_count;
+    uint16_t salt;
+};
+
 #define API_METHOD(x, ret_type, args_type)                                                     \
     sym_entry {                                                                                \
         .hash = elf_gnu_hash(#x), .address = (uint32_t)(static_cast<ret_type(*) args_type>(x)) \
@@ -82,4 +109,182 @@ constexpr bool has_hash_collisions(const std::array<sym_entry, N>& api_methods)
     return false;
 }
 
-#endif
\ No newline at end of file
+/**
+ * @brief Minimal perfect hash over symbol hashes
+ *
+ * Entries are split into buckets, each bucket has a seed that places all of
+ * its entries into distinct free slots. Lookup is one seed read and one slot
+ * read, followed by hash comparison to reject unknown symbols.
+ */
+template <std::size_t N, std::size_t B>
+struct PerfectHashTable {
+    std::array<uint16_t, B> seeds;
+    std::array<sym_entry, N> slots;
+    uint16_t salt;
+    bool valid;
+};
+
+#define ELF_PERFECT_HASH_BUCKET_SIZE_MAX 32
+#define ELF_PERFECT_HASH_SALT_MAX 64
+
+constexpr uint32_t elf_perfect_hash_mix(uint32_t h) {
+    // GNU hash has weak low bits for short names, spread them before modulo
+    h ^= h >> 16;
+    h *= 0x7FEB352DU;
+    h ^= h >> 15;
+    h *= 0x846CA68BU;
+    h ^= h >> 16;
+    return h;
+}
+
+constexpr uint32_t elf_perfect_hash_bucket(uint32_t hash, uint32_t bucket_count) {
+    return elf_perfect_hash_mix(hash) % bucket_count;
+}
+
+constexpr uint32_t elf_perfect_hash_base(uint32_t hash, uint16_t salt) {
+    return elf_perfect_hash_mix(hash ^ (0x9E3779B9U + salt));
+}
+
+constexpr uint32_t elf_perfect_hash_step(uint32_t base) {
+    return elf_perfect_hash_mix(base);
+}
+
+/* Seed is split into step multiplier and offset. Offset alone can reach
+ * every slot, so single entry buckets always find a free one.
+ */
+constexpr uint32_t
+    elf_perfect_hash_displace(uint32_t base, uint32_t step, uint32_t seed, uint32_t slot_count) {
+    return (base + (seed / slot_count) * step + seed % slot_count) % slot_count;
+}
+
+constexpr uint32_t
+    elf_perfect_hash_slot(uint32_t hash, uint16_t salt, uint16_t seed, uint32_t slot_count) {
+    const uint32_t base = elf_perfect_hash_base(hash, salt);
+    return elf_perfect_hash_displace(
+        base % slot_count, elf_perfect_hash_step(base) % slot_count, seed, slot_count);
+}
+
+constexpr std::size_t elf_perfect_hash_bucket_count(std::size_t entry_count) {
+    // ~3 entries per bucket keeps seed search short and seed table small
+    return entry_count / 3 + 1;
+}
+
+/* Compile-time perfect hash construction.
+ * Construction cost grows faster than table size, compiler evaluation limits
+ * allow it for small tables only, like private application API. Firmware API
+ * table is built by scripts/fbt/sdk/perfect_hash.py and verified with
+ * check_perfect_hash.
+ * Usage:
+ *   static constexpr auto api_hash = create_perfect_hash(api_methods);
+ *   static_assert(api_hash.valid, "Can't build perfect hash");
+ */
+template <std::size_t N>
+constexpr auto create_perfect_hash(const std::array<sym_entry, N>& entries) {
+    static_assert(N > 0, "Empty API table");
+    static_assert(N <= UINT16_MAX, "API table is too big for 16 bit seeds");
+    constexpr std::size_t B = elf_perfect_hash_bucket_count(N);
+    // Seeds beyond N * N repeat the same displacements
+    constexpr uint32_t seed_count = (N * N < UINT16_MAX) ? N * N : UINT16_MAX + 1;
+    PerfectHashTable<N, B> table{};
+
+    // Group entries by bucket
+    std::array<uint32_t, B + 1> bucket_start{};
+    std::array<uint32_t, N> bucket_entries{};
+    std::size_t bucket_size_max = 0;
+    for(std::size_t i = 0; i < N; ++i) {
+        bucket_start[elf_perfect_hash_bucket(entries[i].hash, B) + 1]++;
+    }
+    for(std::size_t b = 0; b < B; ++b) {
+        if(bucket_start[b + 1] > bucket_size_max) {
+            bucket_size_max = bucket_start[b + 1];
+        }
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    if(bucket_size_max > ELF_PERFECT_HASH_BUCKET_SIZE_MAX) {
+        table.valid = false;
+        return table;
+    }
+    std::array<uint32_t, B> bucket_fill{};
+    for(std::size_t i = 0; i < N; ++i) {
+        const uint32_t b = elf_perfect_hash_bucket(entries[i].hash, B);
+        bucket_entries[bucket_start[b] + bucket_fill[b]++] = i;
+    }
+
+    // Salt changes slot parameters when some bucket can't be placed
+    for(uint16_t salt = 0; salt < ELF_PERFECT_HASH_SALT_MAX; ++salt) {
+        std::array<uint32_t, N> base{};
+        std::array<uint32_t, N> step{};
+        for(std::size_t i = 0; i < N; ++i) {
+            const uint32_t entry_base = elf_perfect_hash_base(entries[i].hash, salt);
+            base[i] = entry_base % N;
+            step[i] = elf_perfect_hash_step(entry_base) % N;
+        }
+
+        // Place biggest buckets first, while table is still mostly empty
+        std::array<bool, N> slot_used{};
+        bool placed = true;
+        for(std::size_t size = bucket_size_max; placed && size > 0; --size) {
+            for(std::size_t b = 0; placed && b < B; ++b) {
+                if(bucket_start[b + 1] - bucket_start[b] != size) continue;
+                const uint32_t* bucket = &bucket_entries[bucket_start[b]];
+
+                std::array<uint32_t, ELF_PERFECT_HASH_BUCKET_SIZE_MAX> slots{};
+                uint32_t seed = 0;
+                for(; seed < seed_count; ++seed) {
+                    placed = true;
+                    for(std::size_t i = 0; placed && i < size; ++i) {
+                        slots[i] =
+                            elf_perfect_hash_displace(base[bucket[i]], step[bucket[i]], seed, N);
+                        placed = !slot_used[slots[i]];
+                        for(std::size_t j = 0; placed && j < i; ++j) {
+                            placed = slots[i] != slots[j];
+                        }
+                    }
+                    if(placed) break;
+                }
+
+                if(placed) {
+                    table.seeds[b] = seed;
+                    for(std::size_t i = 0; i < size; ++i) {
+                        slot_used[slots[i]] = true;
+                        table.slots[slots[i]] = entries[bucket[i]];
+                    }
+                }
+            }
+        }
+
+        if(placed) {
+            table.salt = salt;
+            table.valid = true;
+            return table;
+        }
+    }
+
+    // Duplicate hashes, table is unusable
+    table.valid = false;
+    return table;
+}
+
+/* Compile-time check of a perfect hash built outside of compiler: every
+ * entry must be in the slot that lookup computes for its hash. Duplicate
+ * hashes can't pass, since both entries would need the same slot.
+ * Usage: static_assert(check_perfect_hash(api_hash), "Invalid perfect hash");
+ */
+template <std::size_t N, std::size_t B>
+constexpr bool check_perfect_hash(const PerfectHashTable<N, B>& table) {
+    if(!table.valid || B != elf_perfect_hash_bucket_count(N)) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < N; ++i) {
+        const uint32_t hash = table.slots[i].hash;
+        const uint16_t seed = table.seeds[elf_perfect_hash_bucket(hash, B)];
+        if(elf_perfect_hash_slot(hash, table.salt, seed, N) != i) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -9,6 +9,9 @@
 #define SECTION_OFFSET(e, n) ((e)->section_table + (n) * sizeof(Elf32_Shdr))
 #define IS_FLAGS_SET(v, m) (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
+#define SYMBOL_READ_CHUNK 16
+#define RELOCATION_READ_CHUNK 32
+#define SYMBOL_NAME_WINDOW_SIZE 512
 
 // #define ELF_DEBUG_LOG 1
 
@@ -153,6 +156,18 @@ static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* nam
     return success;
 }
 
+static int elf_import_compare(const void* a, const void* b) {
+    const ELFImport* import_a = a;
+    const ELFImport* import_b = b;
+    return (import_a->name > import_b->name) - (import_a->name < import_b->name);
+}
+
+static int elf_import_index_compare(const void* a, const void* b) {
+    const ELFImport* import_a = a;
+    const ELFImport* import_b = b;
+    return (import_a->index > import_b->index) - (import_a->index < import_b->index);
+}
+
 static ELFSection* elf_section_of(ELFFile* elf, int index) {
     ELFSectionDict_it_t it;
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
@@ -165,20 +180,155 @@ static ELFSection* elf_section_of(ELFFile* elf, int index) {
     return NULL;
 }
 
-static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, const char* sName) {
-    if(sym->st_shndx == SHN_UNDEF) {
+static bool elf_read_imports(ELFFile* elf) {
+    bool result = storage_file_seek(elf->fd, elf->symbol_table, true);
+    Elf32_Sym* symbols = malloc(sizeof(Elf32_Sym) * SYMBOL_READ_CHUNK);
+
+    for(size_t index = 0; result && index < elf->symbol_count; index += SYMBOL_READ_CHUNK) {
+        size_t count = MIN((size_t)SYMBOL_READ_CHUNK, elf->symbol_count - index);
+        if(storage_file_read(elf->fd, symbols, sizeof(Elf32_Sym) * count) !=
+           sizeof(Elf32_Sym) * count) {
+            FURI_LOG_E(TAG, "  symbol read fail");
+            result = false;
+            break;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            if(symbols[i].st_shndx == SHN_UNDEF && symbols[i].st_name) {
+                ELFImport* import = ELFImportArray_push_new(elf->imports);
+                import->name = symbols[i].st_name;
+                import->index = index + i;
+                import->address = ELF_INVALID_ADDRESS;
+            }
+        }
+    }
+
+    free(symbols);
+    return result;
+}
+
+static const char* elf_symbol_name_from_window(
+    const char* window,
+    off_t window_offset,
+    size_t window_size,
+    off_t offset) {
+    if(offset < window_offset || offset >= (off_t)(window_offset + window_size)) {
+        return NULL;
+    }
+
+    const char* name = window + (offset - window_offset);
+    return memchr(name, '\0', window_size - (offset - window_offset)) ? name : NULL;
+}
+
+static bool elf_resolve_imports(ELFFile* elf) {
+    size_t imports_count = ELFImportArray_size(elf->imports);
+    if(imports_count == 0) {
+        return true;
+    }
+
+    // Walk names in string table order, so window only slides forward
+    ELFImport* imports = ELFImportArray_get(elf->imports, 0);
+    qsort(imports, imports_count, sizeof(ELFImport), elf_import_compare);
+
+    bool result = true;
+    char* window = malloc(SYMBOL_NAME_WINDOW_SIZE);
+    off_t window_offset = 0;
+    size_t window_size = 0;
+    FuriString* long_name = furi_string_alloc();
+
+    for(size_t i = 0; i < imports_count; i++) {
+        ELFImport* import = &imports[i];
+        off_t offset = elf->symbol_table_strings + import->name;
+        const char* name = elf_symbol_name_from_window(window, window_offset, window_size, offset);
+
+        if(!name) {
+            window_size = 0;
+            if(storage_file_seek(elf->fd, offset, true)) {
+                window_size = storage_file_read(elf->fd, window, SYMBOL_NAME_WINDOW_SIZE);
+            }
+            window_offset = offset;
+            name = elf_symbol_name_from_window(window, window_offset, window_size, offset);
+        }
+
+        if(!name) {
+            // Name is longer than window
+            furi_string_reset(long_name);
+            if(!elf_read_symbol_name(elf, import->name, long_name)) {
+                FURI_LOG_E(TAG, "  symbol name read fail");
+                result = false;
+                break;
+            }
+            name = furi_string_get_cstr(long_name);
+        }
+
         Elf32_Addr addr = 0;
-        if(elf->api_interface->resolver_callback(elf->api_interface, sName, &addr)) {
-            return addr;
+        if(elf->api_interface->resolver_callback(elf->api_interface, name, &addr)) {
+            import->address = addr;
+        } else {
+            FURI_LOG_D(TAG, "  Can not find address for symbol %s", name);
         }
-    } else {
-        ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
-        if(symSec) {
-            return ((Elf32_Addr)symSec->data) + sym->st_value;
+    }
+
+    furi_string_free(long_name);
+    free(window);
+
+    // Relocation looks imports up by symbol index
+    qsort(imports, imports_count, sizeof(ELFImport), elf_import_index_compare);
+    return result;
+}
+
+/* Resolve every import once before relocation. Symbol table is read front to
+ * back in chunks, and import names are read in string table order, so loader
+ * does no per relocation seeks for imports. Only imports are kept, addresses
+ * of symbols defined in the file are read on first use.
+ */
+static bool elf_resolve_symbols(ELFFile* elf) {
+    bool result = elf_read_imports(elf) && elf_resolve_imports(elf);
+    FURI_LOG_D(
+        TAG,
+        "Resolved %u imports of %u symbols",
+        ELFImportArray_size(elf->imports),
+        elf->symbol_count);
+    return result;
+}
+
+static Elf32_Addr elf_symbol_address(ELFFile* elf, size_t index) {
+    Elf32_Addr address = ELF_INVALID_ADDRESS;
+    if(index >= elf->symbol_count) {
+        return address;
+    }
+
+    size_t imports_count = ELFImportArray_size(elf->imports);
+    if(imports_count) {
+        ELFImport key = {.index = index};
+        const ELFImport* import = bsearch(
+            &key,
+            ELFImportArray_get(elf->imports, 0),
+            imports_count,
+            sizeof(ELFImport),
+            elf_import_index_compare);
+        if(import) {
+            return import->address;
+        }
+    }
+
+    if(address_cache_get(elf->relocation_cache, index, &address)) {
+        return address;
+    }
+
+    Elf32_Sym sym;
+    off_t old = storage_file_tell(elf->fd);
+    if(storage_file_seek(elf->fd, elf->symbol_table + index * sizeof(Elf32_Sym), true) &&
+       storage_file_read(elf->fd, &sym, sizeof(Elf32_Sym)) == sizeof(Elf32_Sym)) {
+        ELFSection* section = elf_section_of(elf, sym.st_shndx);
+        if(sym.st_shndx != SHN_UNDEF && section) {
+            address = ((Elf32_Addr)section->data) + sym.st_value;
         }
     }
-    FURI_LOG_D(TAG, "  Can not find address for symbol %s", sName);
-    return ELF_INVALID_ADDRESS;
+    storage_file_seek(elf->fd, old, true);
+
+    address_cache_put(elf->relocation_cache, index, address);
+    return address;
 }
 
 __attribute__((unused)) static const char* elf_reloc_type_to_str(int symt) {
@@ -340,15 +490,13 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
 
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
-        Elf32_Rel rel;
         size_t relEntries = s->rel_count;
         size_t relCount;
         (void)storage_file_seek(elf->fd, s->rel_offset, true);
         FURI_LOG_D(TAG, " Offset   Info     Type             Name");
 
         int relocate_result = true;
-        FuriString* symbol_name;
-        symbol_name = furi_string_alloc();
+        Elf32_Rel* rels = malloc(sizeof(Elf32_Rel) * RELOCATION_READ_CHUNK);
 
         for(relCount = 0; relCount < relEntries; relCount++) {
             if(relCount % RESOLVER_THREAD_YIELD_STEP == 0) {
@@ -356,38 +504,30 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
-            }
-
-            Elf32_Addr symAddr;
-
-            int symEntry = ELF32_R_SYM(rel.r_info);
-            int relType = ELF32_R_TYPE(rel.r_info);
-            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
-
-            if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
-                Elf32_Sym sym;
-                furi_string_reset(symbol_name);
-                if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
-                    FURI_LOG_E(TAG, "  symbol read fail");
-                    furi_string_free(symbol_name);
+            size_t chunk_index = relCount % RELOCATION_READ_CHUNK;
+            if(chunk_index == 0) {
+                size_t chunk_size = MIN((size_t)RELOCATION_READ_CHUNK, relEntries - relCount);
+                if(storage_file_read(elf->fd, rels, sizeof(Elf32_Rel) * chunk_size) !=
+                   sizeof(Elf32_Rel) * chunk_size) {
+                    FURI_LOG_E(TAG, "  reloc read fail");
+                    free(rels);
                     return false;
                 }
-
-                FURI_LOG_D(
-                    TAG,
-                    " %08X %08X %-16s %s",
-                    (unsigned int)rel.r_offset,
-                    (unsigned int)rel.r_info,
-                    elf_reloc_type_to_str(relType),
-                    furi_string_get_cstr(symbol_name));
-
-                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
-                address_cache_put(elf->relocation_cache, symEntry, symAddr);
             }
+            const Elf32_Rel* rel = &rels[chunk_index];
+
+            size_t symEntry = ELF32_R_SYM(rel->r_info);
+            int relType = ELF32_R_TYPE(rel->r_info);
+            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel->r_offset;
+            Elf32_Addr symAddr = elf_symbol_address(elf, symEntry);
+
+            FURI_LOG_D(
+                TAG,
+                " %08X %08X %-16s #%u",
+                (unsigned int)rel->r_offset,
+                (unsigned int)rel->r_info,
+                elf_reloc_type_to_str(relType),
+                symEntry);
 
             if(symAddr != ELF_INVALID_ADDRESS) {
                 FURI_LOG_D(
@@ -399,11 +539,16 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     relocate_result = false;
                 }
             } else {
+                // Error path only, name is needed just for the log
+                Elf32_Sym sym;
+                FuriString* symbol_name = furi_string_alloc();
+                elf_read_symbol(elf, symEntry, &sym, symbol_name);
                 FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
+                furi_string_free(symbol_name);
                 relocate_result = false;
             }
         }
-        furi_string_free(symbol_name);
+        free(rels);
 
         return relocate_result;
     } else {
@@ -609,6 +754,8 @@ ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface)
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
+    ELFImportArray_init(elf->imports);
+    AddressCache_init(elf->relocation_cache);
     AddressCache_init(elf->trampoline_cache);
     elf->init_array_called = false;
     return elf;
@@ -746,15 +893,19 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
     ELFSectionDict_it_t it;
 
-    AddressCache_init(elf->relocation_cache);
-
-    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
-        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
-        FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
-        if(!elf_relocate_section(elf, &itref->value)) {
-            FURI_LOG_E(TAG, "Error relocating section '%s'", itref->key);
-            status = ELFFileLoadStatusMissingImports;
+    if(elf_resolve_symbols(elf)) {
+        for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it);
+            ELFSectionDict_next(it)) {
+            ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+            FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
+            if(!elf_relocate_section(elf, &itref->value)) {
+                FURI_LOG_E(TAG, "Error relocating section '%s'", itref->key);
+                status = ELFFileLoadStatusMissingImports;
+            }
         }
+    } else {
+        FURI_LOG_E(TAG, "Error reading symbol table");
+        status = ELFFileLoadStatusUnspecifiedError;
     }
 
     /* Fixing up entry point */
@@ -769,8 +920,9 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         }
     }
 
-    FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
+    FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
+    ELFImportArray_clear(elf->imports);
     AddressCache_clear(elf->relocation_cache);
 
     {
@@ -1,6 +1,7 @@
 #pragma once
 #include "elf_file.h"
 #include <m-dict.h>
+#include <m-array.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +25,17 @@ typedef struct {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Undefined symbol waiting for resolution
+ */
+typedef struct {
+    Elf32_Word name;
+    size_t index;
+    Elf32_Addr address;
+} ELFImport;
+
+ARRAY_DEF(ELFImportArray, ELFImport, M_POD_OPLIST)
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
@@ -35,6 +47,7 @@ struct ELFFile {
     off_t entry;
     ELFSectionDict_t sections;
 
+    ELFImportArray_t imports;
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
 
@@ -7,12 +7,19 @@
 
 #define TAG "Fap"
 
+typedef struct {
+    uint32_t section_table;
+    uint32_t relocation;
+    uint32_t init;
+} FlipperApplicationLoadTimings;
+
 struct FlipperApplication {
     ELFDebugInfo state;
     FlipperApplicationManifest manifest;
     ELFFile* elf;
     FuriThread* thread;
     void* ep_thread_args;
+    FlipperApplicationLoadTimings timings;
 };
 
 /********************** Debugger access to loader state **********************/
@@ -144,9 +151,11 @@ static FlipperApplicationPreloadStatus
     // if we are loading full file
     if(load_full) {
         // load section table
+        uint32_t start = furi_get_tick();
         if(!elf_file_load_section_table(app->elf)) {
             return FlipperApplicationPreloadStatusInvalidFile;
         }
+        app->timings.section_table = furi_get_tick() - start;
 
         // load assets section
         FlipperApplicationPreloadAssetsContext preload_context = {.path = path};
@@ -186,7 +195,9 @@ const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplic
 }
 
 FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app) {
+    uint32_t start = furi_get_tick();
     ELFFileLoadStatus status = elf_file_load_sections(app->elf);
+    app->timings.relocation = furi_get_tick() - start;
 
     switch(status) {
     case ELFFileLoadStatusSuccess:
@@ -202,11 +213,25 @@ FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplicatio
     }
 }
 
+static void flipper_application_call_init(FlipperApplication* app) {
+    uint32_t start = furi_get_tick();
+    elf_file_call_init(app->elf);
+    app->timings.init = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "%s load phases: section table %lums, relocation %lums, init %lums",
+        app->manifest.name,
+        app->timings.section_table,
+        app->timings.relocation,
+        app->timings.init);
+}
+
 static int32_t flipper_application_thread(void* context) {
     furi_assert(context);
     FlipperApplication* app = (FlipperApplication*)context;
 
-    elf_file_call_init(app->elf);
+    flipper_application_call_init(app);
 
     FlipperApplicationEntryPoint entry_point = elf_file_get_entry_point(app->elf);
     int32_t ret_code = entry_point(app->ep_thread_args);
@@ -273,7 +298,7 @@ const FlipperAppPluginDescriptor*
     }
 
     if(!elf_file_is_init_complete(app->elf)) {
-        elf_file_call_init(app->elf);
+        flipper_application_call_init(app);
     }
 
     typedef const FlipperAppPluginDescriptor* (*get_lib_descriptor_t)(void);
@@ -203,6 +203,17 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/**
+ * Enable key index. Positions of passed keys are remembered, so reading keys
+ * out of file order or after rewind seeks directly instead of scanning the
+ * file again. Index is built during normal reads and is dropped by any write,
+ * open, close or raw stream access. Used only when strict mode is off.
+ * Disabled by default.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param enable True to enable key index
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool enable);
+
 /**
  * Rewind the RW pointer.
  * @param flipper_format Pointer to a FlipperFormat instance
@@ -0,0 +1,293 @@
+#include <core/check.h>
+#include <string.h>
+#include "flipper_format_key_index_i.h"
+#include "flipper_format_stream_i.h"
+
+#define FLIPPER_FORMAT_KEY_INDEX_MAX_KEYS (1024U)
+#define FLIPPER_FORMAT_KEY_INDEX_KEY_SIZE (64U)
+#define FLIPPER_FORMAT_KEY_INDEX_UNKNOWN (UINT16_MAX)
+#define FLIPPER_FORMAT_KEY_INDEX_HASH_INIT (2166136261UL)
+#define FLIPPER_FORMAT_KEY_INDEX_BUFFER_SIZE (64U)
+
+typedef struct {
+    uint32_t hash; /**< FNV-1a of key as seen by scanner */
+    uint32_t start; /**< Key line start */
+    uint16_t delimiter; /**< Delimiter offset from line start */
+    uint16_t end; /**< EOL offset from line start or UNKNOWN */
+} FlipperFormatKeyIndexEntry;
+
+struct FlipperFormatKeyIndex {
+    FlipperFormatKeyIndexEntry* entries;
+    size_t count;
+    size_t capacity;
+    size_t covered; /**< Every key line starting before this line boundary is indexed */
+    bool complete; /**< Covered part reaches end of stream */
+    bool full; /**< Too many keys, covered part is not extended anymore */
+};
+
+static inline uint32_t flipper_format_key_index_hash(uint32_t hash, char c) {
+    return (hash ^ (uint8_t)c) * 16777619UL;
+}
+
+FlipperFormatKeyIndex* flipper_format_key_index_alloc(void) {
+    FlipperFormatKeyIndex* index = malloc(sizeof(FlipperFormatKeyIndex));
+    return index;
+}
+
+void flipper_format_key_index_free(FlipperFormatKeyIndex* index) {
+    furi_assert(index);
+    free(index->entries);
+    free(index);
+}
+
+void flipper_format_key_index_reset(FlipperFormatKeyIndex* index) {
+    furi_assert(index);
+    free(index->entries);
+    index->entries = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->covered = 0;
+    index->complete = false;
+    index->full = false;
+}
+
+/** First entry with start >= position */
+static size_t flipper_format_key_index_lower_bound(FlipperFormatKeyIndex* index, size_t position) {
+    size_t low = 0;
+    size_t high = index->count;
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(index->entries[middle].start < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void flipper_format_key_index_add(
+    FlipperFormatKeyIndex* index,
+    uint32_t hash,
+    size_t start,
+    size_t delimiter) {
+    // Line where previous scan stopped is already there
+    if(index->count && index->entries[index->count - 1].start == start) return;
+
+    if(index->count == FLIPPER_FORMAT_KEY_INDEX_MAX_KEYS ||
+       delimiter - start >= FLIPPER_FORMAT_KEY_INDEX_UNKNOWN) {
+        index->full = true;
+        return;
+    }
+    if(index->count == index->capacity) {
+        index->capacity = index->capacity ? index->capacity * 2 : 32;
+        index->entries =
+            realloc(index->entries, index->capacity * sizeof(FlipperFormatKeyIndexEntry)); //-V701
+    }
+
+    FlipperFormatKeyIndexEntry* entry = &index->entries[index->count++];
+    entry->hash = hash;
+    entry->start = start;
+    entry->delimiter = delimiter - start;
+    entry->end = FLIPPER_FORMAT_KEY_INDEX_UNKNOWN;
+}
+
+static void
+    flipper_format_key_index_set_end(FlipperFormatKeyIndex* index, size_t start, size_t end) {
+    if(!index->count) return;
+    FlipperFormatKeyIndexEntry* entry = &index->entries[index->count - 1];
+    if(entry->start == start && end - start < FLIPPER_FORMAT_KEY_INDEX_UNKNOWN) {
+        entry->end = end - start;
+    }
+}
+
+/** Find EOL position after position, 0 if there is no EOL */
+static size_t flipper_format_key_index_find_eol(Stream* stream, size_t position) {
+    uint8_t buffer[FLIPPER_FORMAT_KEY_INDEX_BUFFER_SIZE];
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) return 0;
+
+    while(true) {
+        size_t was_read = stream_read(stream, buffer, sizeof(buffer));
+        if(was_read == 0) break;
+
+        uint8_t* eol = memchr(buffer, flipper_format_eoln, was_read);
+        if(eol) return position + (eol - buffer);
+        position += was_read;
+    }
+    return 0;
+}
+
+/**
+ * Scan lines starting from line boundary, same way as flipper_format_stream_seek_to_key()
+ * does in non strict mode, and add key lines to index if scan continues covered part.
+ */
+static bool flipper_format_key_index_scan(
+    FlipperFormatKeyIndex* index,
+    Stream* stream,
+    const char* key,
+    size_t position) {
+    bool record = !index->full && position == index->covered;
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) return false;
+
+    const size_t key_size = strlen(key);
+    uint8_t buffer[FLIPPER_FORMAT_KEY_INDEX_BUFFER_SIZE];
+    size_t line_start = position;
+    uint32_t hash = FLIPPER_FORMAT_KEY_INDEX_HASH_INIT;
+    size_t size = 0;
+    bool match = true;
+    bool accumulate = true;
+    bool new_line = true;
+    bool found = false;
+    size_t value = 0;
+    uint8_t* eol = NULL;
+    size_t eol_position = 0;
+
+    while(!found) {
+        size_t was_read = stream_read(stream, buffer, sizeof(buffer));
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read; i++) {
+            const char data = buffer[i];
+            if(data == flipper_format_eoln) {
+                if(record) flipper_format_key_index_set_end(index, line_start, position + i);
+                line_start = position + i + 1;
+                hash = FLIPPER_FORMAT_KEY_INDEX_HASH_INIT;
+                size = 0;
+                match = true;
+                accumulate = true;
+                new_line = true;
+            } else if(data == flipper_format_eolr) {
+                // ignore
+            } else if(data == flipper_format_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(data == flipper_format_delimiter) {
+                if(new_line) {
+                    accumulate = false;
+                    new_line = false;
+                } else if(accumulate) {
+                    // key found, rest of the line is skipped like after failed comparison
+                    accumulate = false;
+                    if(record) {
+                        flipper_format_key_index_add(index, hash, line_start, position + i);
+                        record = !index->full;
+                    }
+                    if(match && size == key_size) {
+                        found = true;
+                        value = position + i + 2;
+                        eol = memchr(&buffer[i], flipper_format_eoln, was_read - i);
+                        if(eol) eol_position = position + (eol - buffer);
+                        break;
+                    }
+                }
+            } else {
+                new_line = false;
+                if(accumulate) {
+                    hash = flipper_format_key_index_hash(hash, data);
+                    match = match && size < key_size && key[size] == data;
+                    size++;
+                }
+            }
+        }
+        position += was_read;
+    }
+
+    if(record && found) {
+        // Index the rest of key line, so next scan continues from its EOL
+        if(!eol) eol_position = flipper_format_key_index_find_eol(stream, position);
+        if(eol_position) {
+            flipper_format_key_index_set_end(index, line_start, eol_position);
+            line_start = eol_position;
+        }
+    }
+    if(record) {
+        index->covered = line_start;
+        index->complete = !found;
+    }
+
+    return found && stream_seek(stream, value, StreamOffsetFromStart);
+}
+
+/** Check if position is at line start or at EOL, where scan and index give same result */
+static bool flipper_format_key_index_is_line_boundary(
+    FlipperFormatKeyIndex* index,
+    Stream* stream,
+    size_t position) {
+    if(position == 0 || position == index->covered) return true;
+
+    size_t i = flipper_format_key_index_lower_bound(index, position);
+    if(i < index->count && index->entries[i].start == position) return true;
+    if(i > 0) {
+        const FlipperFormatKeyIndexEntry* entry = &index->entries[i - 1];
+        if(entry->end != FLIPPER_FORMAT_KEY_INDEX_UNKNOWN &&
+           entry->start + entry->end == position)
+            return true;
+    }
+
+    // Look at the data
+    char data[2] = {0};
+    bool result = stream_seek(stream, position - 1, StreamOffsetFromStart) &&
+                  stream_read(stream, (uint8_t*)data, sizeof(data)) > 0 &&
+                  (data[0] == flipper_format_eoln || data[1] == flipper_format_eoln);
+    stream_seek(stream, position, StreamOffsetFromStart);
+    return result;
+}
+
+/** Compare indexed key with key, 1 if equal, 0 if not, -1 if key cannot be compared */
+static int flipper_format_key_index_compare(
+    const FlipperFormatKeyIndexEntry* entry,
+    Stream* stream,
+    const char* key) {
+    char data[FLIPPER_FORMAT_KEY_INDEX_KEY_SIZE];
+    if(entry->delimiter > sizeof(data)) return -1;
+    if(!stream_seek(stream, entry->start, StreamOffsetFromStart)) return -1;
+    if(stream_read(stream, (uint8_t*)data, entry->delimiter) != entry->delimiter) return -1;
+
+    size_t size = 0;
+    for(size_t i = 0; i < entry->delimiter; i++) {
+        if(data[i] == flipper_format_eolr) continue;
+        if(key[size] != data[i]) return 0;
+        size++;
+    }
+    return key[size] == '\0' ? 1 : 0;
+}
+
+bool flipper_format_key_index_seek_to_key(
+    FlipperFormatKeyIndex* index,
+    Stream* stream,
+    const char* key) {
+    furi_assert(index);
+    size_t position = stream_tell(stream);
+
+    if(!flipper_format_key_index_is_line_boundary(index, stream, position)) {
+        return flipper_format_stream_seek_to_key(stream, key, false);
+    }
+    if(position > index->covered) {
+        return flipper_format_key_index_scan(index, stream, key, position);
+    }
+
+    uint32_t hash = FLIPPER_FORMAT_KEY_INDEX_HASH_INIT;
+    for(const char* c = key; *c; c++) {
+        hash = flipper_format_key_index_hash(hash, *c);
+    }
+
+    for(size_t i = flipper_format_key_index_lower_bound(index, position); i < index->count; i++) {
+        const FlipperFormatKeyIndexEntry* entry = &index->entries[i];
+        if(entry->hash != hash) continue;
+
+        int result = flipper_format_key_index_compare(entry, stream, key);
+        if(result == 1) {
+            return stream_seek(
+                stream, entry->start + entry->delimiter + 2, StreamOffsetFromStart);
+        } else if(result < 0) {
+            stream_seek(stream, position, StreamOffsetFromStart);
+            return flipper_format_stream_seek_to_key(stream, key, false);
+        }
+    }
+
+    if(index->complete) {
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+        return false;
+    }
+    return flipper_format_key_index_scan(index, stream, key, index->covered);
+}
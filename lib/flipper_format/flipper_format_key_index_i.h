@@ -0,0 +1,52 @@
+#pragma once
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key index maps key lines to their positions in the stream, so keys that are
+ * already passed are found with a direct seek instead of a line by line scan.
+ *
+ * Index is built lazily: every scan continues from the end of indexed part
+ * and adds key lines it passes, so first pass over the file costs the same as
+ * without index. Index must be reset when stream content changes.
+ */
+typedef struct FlipperFormatKeyIndex FlipperFormatKeyIndex;
+
+/**
+ * Allocate key index
+ * @return FlipperFormatKeyIndex*
+ */
+FlipperFormatKeyIndex* flipper_format_key_index_alloc(void);
+
+/**
+ * Free key index
+ * @param index
+ */
+void flipper_format_key_index_free(FlipperFormatKeyIndex* index);
+
+/**
+ * Forget indexed keys, call when stream is changed or reopened
+ * @param index
+ */
+void flipper_format_key_index_reset(FlipperFormatKeyIndex* index);
+
+/**
+ * Seek to the key from the current position of the stream.
+ * Same as flipper_format_stream_seek_to_key() in non strict mode.
+ * @param index
+ * @param stream
+ * @param key
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_key_index_seek_to_key(
+    FlipperFormatKeyIndex* index,
+    Stream* stream,
+    const char* key);
+
+#ifdef __cplusplus
+}
+#endif
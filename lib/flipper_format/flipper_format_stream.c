@@ -342,11 +342,18 @@ bool flipper_format_stream_read_value_line(
     void* _data,
     size_t data_size,
     bool strict_mode) {
+    return flipper_format_stream_seek_to_key(stream, key, strict_mode) &&
+           flipper_format_stream_read_value_data(stream, type, _data, data_size);
+}
+
+bool flipper_format_stream_read_value_data(
+    Stream* stream,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size) {
     bool result = false;
 
     do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
-
         if(type == FlipperStreamValueStr) {
             FuriString* data = (FuriString*)_data;
             if(flipper_format_stream_read_line(stream, data)) {
@@ -442,33 +449,38 @@ bool flipper_format_stream_get_value_count(
     uint32_t* count,
     bool strict_mode) {
     bool result = false;
-    bool last = false;
-
-    FuriString* value;
-    value = furi_string_alloc();
 
     uint32_t position = stream_tell(stream);
     do {
         if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
-        *count = 0;
-
-        result = true;
-        while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
-                result = false;
-                break;
-            }
-
-            *count = *count + 1;
-            if(last) break;
-        }
-
+        result = flipper_format_stream_count_values(stream, count);
     } while(false);
 
     if(!stream_seek(stream, position, StreamOffsetFromStart)) {
         result = false;
     }
 
+    return result;
+}
+
+bool flipper_format_stream_count_values(Stream* stream, uint32_t* count) {
+    bool result = true;
+    bool last = false;
+
+    FuriString* value;
+    value = furi_string_alloc();
+
+    *count = 0;
+    while(true) {
+        if(!flipper_format_stream_read_value(stream, value, &last)) {
+            result = false;
+            break;
+        }
+
+        *count = *count + 1;
+        if(last) break;
+    }
+
     furi_string_free(value);
     return result;
 }
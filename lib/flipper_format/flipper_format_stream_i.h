@@ -29,6 +29,31 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Read value from the current position of the stream, which should be right after the key.
+ * @param stream 
+ * @param type 
+ * @param _data 
+ * @param data_size 
+ * @return true value is read
+ * @return false value cannot be parsed
+ */
+bool flipper_format_stream_read_value_data(
+    Stream* stream,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size);
+
+/**
+ * Count values from the current position of the stream, which should be right after the key.
+ * Position is not restored.
+ * @param stream 
+ * @param count 
+ * @return true values are counted
+ * @return false value cannot be parsed
+ */
+bool flipper_format_stream_count_values(Stream* stream, uint32_t* count);
+
 #ifdef __cplusplus
 }
 #endif
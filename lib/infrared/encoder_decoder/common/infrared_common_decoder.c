@@ -49,12 +49,8 @@ static bool infrared_check_preamble(InfraredCommonDecoder* decoder) {
     }
 
     while((!result) && (decoder->timings_cnt >= 2)) {
-        float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-        uint16_t preamble_mark = decoder->protocol->timings.preamble_mark;
-        uint16_t preamble_space = decoder->protocol->timings.preamble_space;
-
-        if((MATCH_TIMING(decoder->timings[0], preamble_mark, preamble_tolerance)) &&
-           (MATCH_TIMING(decoder->timings[1], preamble_space, preamble_tolerance))) {
+        if(infrared_common_match_preamble(
+               &decoder->protocol->timings, decoder->timings[0], decoder->timings[1])) {
             result = true;
         }
 
@@ -275,6 +271,36 @@ InfraredMessage*
     return message;
 }
 
+/**
+ * Waiting for preamble, decoder keeps only last mark. Until space after it
+ * matches preamble (or level doesn't alternate), edge only replaces last
+ * mark, so decoder can skip edges and be resumed with the last one.
+ */
+const InfraredTimings* infrared_common_decoder_wait_preamble(InfraredCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    const InfraredTimings* timings = &decoder->protocol->timings;
+
+    if((decoder->state != InfraredCommonDecoderStateWaitPreamble) ||
+       (timings->preamble_mark == 0) || (decoder->timings_cnt != (decoder->level ? 1 : 0))) {
+        timings = NULL;
+    }
+
+    return timings;
+}
+
+void infrared_common_decoder_resume(
+    InfraredCommonDecoder* decoder,
+    bool level,
+    uint32_t duration) {
+    furi_assert(decoder);
+    furi_assert(decoder->state == InfraredCommonDecoderStateWaitPreamble);
+
+    decoder->level = level;
+    decoder->timings[0] = duration;
+    decoder->timings_cnt = level ? 1 : 0;
+}
+
 void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol) {
     furi_assert(protocol);
 
@@ -288,6 +314,7 @@ void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol)
     InfraredCommonDecoder* decoder = malloc(alloc_size);
     decoder->protocol = protocol;
     decoder->level = true;
+    decoder->timings_cnt = 0;
     return decoder;
 }
 
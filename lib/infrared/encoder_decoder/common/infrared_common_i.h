@@ -6,6 +6,13 @@
 
 #define MATCH_TIMING(x, v, delta) (((x) < ((v) + (delta))) && ((x) > ((v) - (delta))))
 
+static inline bool
+    infrared_common_match_preamble(const InfraredTimings* timings, uint32_t mark, uint32_t space) {
+    float preamble_tolerance = timings->preamble_tolerance;
+    return MATCH_TIMING(mark, timings->preamble_mark, preamble_tolerance) &&
+           MATCH_TIMING(space, timings->preamble_space, preamble_tolerance);
+}
+
 typedef struct InfraredCommonDecoder InfraredCommonDecoder;
 typedef struct InfraredCommonEncoder InfraredCommonEncoder;
 
@@ -75,6 +82,11 @@ void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol);
 void infrared_common_decoder_free(InfraredCommonDecoder* decoder);
 void infrared_common_decoder_reset(InfraredCommonDecoder* decoder);
 InfraredMessage* infrared_common_decoder_check_ready(InfraredCommonDecoder* decoder);
+const InfraredTimings* infrared_common_decoder_wait_preamble(InfraredCommonDecoder* decoder);
+void infrared_common_decoder_resume(
+    InfraredCommonDecoder* decoder,
+    bool level,
+    uint32_t duration);
 
 InfraredStatus
     infrared_common_encode(InfraredCommonEncoder* encoder, uint32_t* duration, bool* polarity);
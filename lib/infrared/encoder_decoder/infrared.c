@@ -11,6 +11,7 @@
 #include "rc6/infrared_protocol_rc6.h"
 #include "sirc/infrared_protocol_sirc.h"
 #include "kaseikyo/infrared_protocol_kaseikyo.h"
+#include "common/infrared_common_i.h"
 
 typedef struct {
     InfraredAlloc alloc;
@@ -18,6 +19,8 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderWaitPreamble wait_preamble;
+    InfraredDecoderResume resume;
 } InfraredDecoders;
 
 typedef struct {
@@ -29,6 +32,11 @@ typedef struct {
 
 struct InfraredDecoderHandler {
     void** ctx;
+    /* Preamble timings of decoders which skip timings till preamble can start */
+    const InfraredTimings** preamble;
+    InfraredDecoderStats* stats;
+    bool level;
+    uint32_t duration;
 };
 
 struct InfraredEncoderHandler {
@@ -49,6 +57,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .wait_preamble = infrared_decoder_nec_wait_preamble,
+             .resume = infrared_decoder_nec_resume,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -63,6 +73,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .wait_preamble = infrared_decoder_samsung32_wait_preamble,
+             .resume = infrared_decoder_samsung32_resume,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -91,6 +103,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .wait_preamble = infrared_decoder_rc6_wait_preamble,
+             .resume = infrared_decoder_rc6_resume,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -105,6 +119,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .wait_preamble = infrared_decoder_sirc_wait_preamble,
+             .resume = infrared_decoder_sirc_resume,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -119,6 +135,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .wait_preamble = infrared_decoder_kaseikyo_wait_preamble,
+             .resume = infrared_decoder_kaseikyo_resume,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -132,6 +150,34 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+/* All decoders see the same timings, but decoder waiting for preamble can only
+ * leave this state on space which completes preamble, or on level error */
+static bool infrared_skip_timing(
+    const InfraredDecoderHandler* handler,
+    size_t index,
+    bool level,
+    uint32_t duration) {
+    const InfraredTimings* preamble = handler->preamble[index];
+
+    return preamble && (level != handler->level) &&
+           (level || !infrared_common_match_preamble(preamble, handler->duration, duration));
+}
+
+static void infrared_resume_decoder(InfraredDecoderHandler* handler, size_t index) {
+    if(handler->preamble[index]) {
+        infrared_encoder_decoder[index].decoder.resume(
+            handler->ctx[index], handler->level, handler->duration);
+        handler->preamble[index] = NULL;
+    }
+}
+
+static void infrared_park_decoder(InfraredDecoderHandler* handler, size_t index) {
+    const InfraredDecoders* decoder = &infrared_encoder_decoder[index].decoder;
+    if(decoder->wait_preamble) {
+        handler->preamble[index] = decoder->wait_preamble(handler->ctx[index]);
+    }
+}
+
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_assert(handler);
@@ -141,19 +187,41 @@ const InfraredMessage*
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.decode) {
+            InfraredDecoderStats* stats = &handler->stats[i];
+            if(infrared_skip_timing(handler, i, level, duration)) {
+                ++stats->skipped_edges;
+                continue;
+            }
+
+            infrared_resume_decoder(handler, i);
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
+            infrared_park_decoder(handler, i);
+
+            ++stats->edges;
+            if(message) {
+                ++stats->messages;
+                stats->latency_sum += duration;
+                stats->latency_max = MAX(stats->latency_max, duration);
+            }
             if(!result && message) {
                 result = message;
             }
         }
     }
 
+    handler->level = level;
+    handler->duration = duration;
+
     return result;
 }
 
 InfraredDecoderHandler* infrared_alloc_decoder(void) {
     InfraredDecoderHandler* handler = malloc(sizeof(InfraredDecoderHandler));
     handler->ctx = malloc(sizeof(void*) * COUNT_OF(infrared_encoder_decoder));
+    handler->preamble = malloc(sizeof(InfraredTimings*) * COUNT_OF(infrared_encoder_decoder));
+    handler->stats = malloc(sizeof(InfraredDecoderStats) * COUNT_OF(infrared_encoder_decoder));
+    handler->level = true;
+    handler->duration = 0;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         handler->ctx[i] = 0;
@@ -162,6 +230,7 @@ InfraredDecoderHandler* infrared_alloc_decoder(void) {
     }
 
     infrared_reset_decoder(handler);
+    infrared_reset_decoder_stats(handler);
     return handler;
 }
 
@@ -175,11 +244,14 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
     }
 
     free(handler->ctx);
+    free(handler->preamble);
+    free(handler->stats);
     free(handler);
 }
 
 void infrared_reset_decoder(InfraredDecoderHandler* handler) {
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        handler->preamble[i] = NULL;
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
@@ -193,7 +265,12 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.check_ready) {
+            infrared_resume_decoder(handler, i);
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
+            infrared_park_decoder(handler, i);
+            if(message) {
+                ++handler->stats[i].timeout_messages;
+            }
             if(!result && message) {
                 result = message;
             }
@@ -203,6 +280,26 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     return result;
 }
 
+bool infrared_get_decoder_stats(
+    const InfraredDecoderHandler* handler,
+    InfraredProtocol protocol,
+    InfraredDecoderStats* stats) {
+    furi_assert(handler);
+    furi_assert(stats);
+
+    int index = infrared_find_index_by_protocol(protocol);
+    if(index >= 0) {
+        *stats = handler->stats[index];
+    }
+
+    return index >= 0;
+}
+
+void infrared_reset_decoder_stats(InfraredDecoderHandler* handler) {
+    furi_assert(handler);
+    memset(handler->stats, 0, sizeof(InfraredDecoderStats) * COUNT_OF(infrared_encoder_decoder));
+}
+
 InfraredEncoderHandler* infrared_alloc_encoder(void) {
     InfraredEncoderHandler* handler = malloc(sizeof(InfraredEncoderHandler));
     handler->handler = NULL;
@@ -43,6 +43,16 @@ typedef struct {
     bool repeat;
 } InfraredMessage;
 
+/** Decoder statistics, protocols of one decoder share them */
+typedef struct {
+    uint32_t edges; /**< Timings decoder processed */
+    uint32_t skipped_edges; /**< Timings skipped while decoder waited for preamble */
+    uint32_t messages; /**< Messages decoded on timing */
+    uint32_t timeout_messages; /**< Messages decoded on infrared_check_decoder_ready() */
+    uint32_t latency_max; /**< Longest time from message end to decode, us */
+    uint64_t latency_sum; /**< Sum of time from message end to decode, us */
+} InfraredDecoderStats;
+
 typedef enum {
     InfraredStatusError,
     InfraredStatusOk,
@@ -103,6 +113,29 @@ void infrared_free_decoder(InfraredDecoderHandler* handler);
  */
 void infrared_reset_decoder(InfraredDecoderHandler* handler);
 
+/**
+ * Get statistics of decoder for protocol.
+ * Decoders that wait for preamble skip timings that can't start it, so
+ * edges + skipped_edges is amount of timings provided since last reset of statistics.
+ * Latency of message is duration of timing which completed it.
+ *
+ * \param[in]   handler     - handler to INFRARED decoders. Should be acquired with \c infrared_alloc_decoder().
+ * \param[in]   protocol    - protocol identifier.
+ * \param[out]  stats       - decoder statistics.
+ * \return      true if protocol is valid, false otherwise.
+ */
+bool infrared_get_decoder_stats(
+    const InfraredDecoderHandler* handler,
+    InfraredProtocol protocol,
+    InfraredDecoderStats* stats);
+
+/**
+ * Reset statistics of all decoders.
+ *
+ * \param[in]   handler     - handler to INFRARED decoders. Should be acquired with \c infrared_alloc_decoder().
+ */
+void infrared_reset_decoder_stats(InfraredDecoderHandler* handler);
+
 /**
  * Get protocol name by protocol enum.
  *
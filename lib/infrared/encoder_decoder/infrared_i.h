@@ -33,6 +33,10 @@ typedef void (*InfraredFree)(void*);
 typedef void (*InfraredDecoderReset)(void*);
 typedef InfraredMessage* (*InfraredDecode)(void* ctx, bool level, uint32_t duration);
 typedef InfraredMessage* (*InfraredDecoderCheckReady)(void*);
+/* Preamble timings if decoder state can only change on preamble space, otherwise NULL */
+typedef const InfraredTimings* (*InfraredDecoderWaitPreamble)(void* ctx);
+/* Restore state of decoder that waits for preamble, after edges it hasn't seen */
+typedef void (*InfraredDecoderResume)(void* ctx, bool level, uint32_t duration);
 
 typedef void (*InfraredEncoderReset)(void* encoder, const InfraredMessage* message);
 typedef InfraredStatus (*InfraredEncode)(void* encoder, uint32_t* out, bool* polarity);
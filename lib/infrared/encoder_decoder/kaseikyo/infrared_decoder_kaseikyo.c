@@ -48,3 +48,11 @@ void infrared_decoder_kaseikyo_free(void* decoder) {
 void infrared_decoder_kaseikyo_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+const InfraredTimings* infrared_decoder_kaseikyo_wait_preamble(void* decoder) {
+    return infrared_common_decoder_wait_preamble(decoder);
+}
+
+void infrared_decoder_kaseikyo_resume(void* decoder, bool level, uint32_t duration) {
+    infrared_common_decoder_resume(decoder, level, duration);
+}
@@ -21,6 +21,8 @@ void infrared_decoder_kaseikyo_reset(void* decoder);
 void infrared_decoder_kaseikyo_free(void* decoder);
 InfraredMessage* infrared_decoder_kaseikyo_check_ready(void* decoder);
 InfraredMessage* infrared_decoder_kaseikyo_decode(void* decoder, bool level, uint32_t duration);
+const InfraredTimings* infrared_decoder_kaseikyo_wait_preamble(void* decoder);
+void infrared_decoder_kaseikyo_resume(void* decoder, bool level, uint32_t duration);
 
 void* infrared_encoder_kaseikyo_alloc(void);
 InfraredStatus
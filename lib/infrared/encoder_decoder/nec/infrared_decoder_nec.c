@@ -95,3 +95,11 @@ void infrared_decoder_nec_free(void* decoder) {
 void infrared_decoder_nec_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+const InfraredTimings* infrared_decoder_nec_wait_preamble(void* decoder) {
+    return infrared_common_decoder_wait_preamble(decoder);
+}
+
+void infrared_decoder_nec_resume(void* decoder, bool level, uint32_t duration) {
+    infrared_common_decoder_resume(decoder, level, duration);
+}
@@ -110,3 +110,13 @@ void infrared_decoder_rc6_reset(void* decoder) {
     InfraredRc6Decoder* decoder_rc6 = decoder;
     infrared_common_decoder_reset(decoder_rc6->common_decoder);
 }
+
+const InfraredTimings* infrared_decoder_rc6_wait_preamble(void* decoder) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    return infrared_common_decoder_wait_preamble(decoder_rc6->common_decoder);
+}
+
+void infrared_decoder_rc6_resume(void* decoder, bool level, uint32_t duration) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    infrared_common_decoder_resume(decoder_rc6->common_decoder, level, duration);
+}
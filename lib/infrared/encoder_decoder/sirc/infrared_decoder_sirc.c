@@ -53,3 +53,11 @@ void infrared_decoder_sirc_free(void* decoder) {
 void infrared_decoder_sirc_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+const InfraredTimings* infrared_decoder_sirc_wait_preamble(void* decoder) {
+    return infrared_common_decoder_wait_preamble(decoder);
+}
+
+void infrared_decoder_sirc_resume(void* decoder, bool level, uint32_t duration) {
+    infrared_common_decoder_resume(decoder, level, duration);
+}
@@ -28,6 +28,8 @@ void infrared_decoder_sirc_reset(void* decoder);
 InfraredMessage* infrared_decoder_sirc_check_ready(void* decoder);
 void infrared_decoder_sirc_free(void* decoder);
 InfraredMessage* infrared_decoder_sirc_decode(void* decoder, bool level, uint32_t duration);
+const InfraredTimings* infrared_decoder_sirc_wait_preamble(void* decoder);
+void infrared_decoder_sirc_resume(void* decoder, bool level, uint32_t duration);
 
 void* infrared_encoder_sirc_alloc(void);
 void infrared_encoder_sirc_reset(void* encoder_ptr, const InfraredMessage* message);
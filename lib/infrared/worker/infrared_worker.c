@@ -33,6 +33,8 @@ typedef enum {
     InfraredWorkerStateWaitTxEnd,
     InfraredWorkerStateStopTx,
     InfraredWorkerStateStartTx,
+    InfraredWorkerStateWaitTxDone,
+    InfraredWorkerStateTxDone,
 } InfraredWorkerState;
 
 struct InfraredWorkerSignal {
@@ -492,7 +494,7 @@ static int32_t infrared_worker_tx_thread(void* thread_context) {
             furi_hal_infrared_async_tx_start(instance->tx.frequency, instance->tx.duty_cycle);
 
             if(!new_data_available) {
-                instance->state = InfraredWorkerStateStopTx;
+                instance->state = InfraredWorkerStateWaitTxDone;
             } else if(instance->tx.need_reinitialization) {
                 instance->state = InfraredWorkerStateWaitTxEnd;
             } else {
@@ -525,9 +527,11 @@ static int32_t infrared_worker_tx_thread(void* thread_context) {
             }
 
             if(events & INFRARED_WORKER_TX_FILL_BUFFER) {
-                infrared_worker_tx_fill_buffer(instance);
+                const bool new_data_available = infrared_worker_tx_fill_buffer(instance);
 
-                if(instance->tx.need_reinitialization) {
+                if(!new_data_available) {
+                    instance->state = InfraredWorkerStateWaitTxDone;
+                } else if(instance->tx.need_reinitialization) {
                     instance->state = InfraredWorkerStateWaitTxEnd;
                 }
             }
@@ -546,6 +550,15 @@ static int32_t infrared_worker_tx_thread(void* thread_context) {
                 instance->state = InfraredWorkerStateStopTx;
             }
 
+            break;
+        case InfraredWorkerStateWaitTxDone:
+            /* Get signal callback returned Stop, last signal is already in the buffer */
+            furi_hal_infrared_async_tx_wait_termination();
+            instance->state = InfraredWorkerStateTxDone;
+            break;
+        case InfraredWorkerStateTxDone:
+            furi_thread_flags_wait(INFRARED_WORKER_EXIT, FuriFlagWaitAny, FuriWaitForever);
+            running = false;
             break;
         default:
             furi_assert(0);
@@ -574,6 +587,11 @@ void infrared_worker_tx_set_signal_sent_callback(
     instance->tx.message_sent_context = context;
 }
 
+bool infrared_worker_tx_is_done(InfraredWorker* instance) {
+    furi_assert(instance);
+    return instance->state == InfraredWorkerStateTxDone;
+}
+
 void infrared_worker_tx_stop(InfraredWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state != InfraredWorkerStateRunRx);
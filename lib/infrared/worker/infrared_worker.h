@@ -99,6 +99,14 @@ bool infrared_worker_signal_is_decoded(const InfraredWorkerSignal* signal);
  */
 void infrared_worker_tx_start(InfraredWorker* instance);
 
+/** Check if transmission is over: get signal callback returned Stop and all signals
+ * before it are sent. Worker still has to be stopped with infrared_worker_tx_stop().
+ *
+ * @param[in]   instance - InfraredWorker instance
+ * @return      true if transmission is over
+ */
+bool infrared_worker_tx_is_done(InfraredWorker* instance);
+
 /** Stop transmitting signal. Waits for end of current signal and stops transmission.
  *
  * @param[in]   instance - InfraredWorker instance
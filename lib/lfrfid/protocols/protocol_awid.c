@@ -5,27 +5,18 @@
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define AWID_DECODED_DATA_SIZE (9)
 
 #define AWID_ENCODED_BIT_SIZE (96)
 #define AWID_ENCODED_DATA_SIZE (((AWID_ENCODED_BIT_SIZE) / 8) + 1)
 #define AWID_ENCODED_DATA_LAST (AWID_ENCODED_DATA_SIZE - 1)
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolAwidDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
 } ProtocolAwidEncoder;
 
 typedef struct {
-    ProtocolAwidDecoder decoder;
     ProtocolAwidEncoder encoder;
     uint8_t encoded_data[AWID_ENCODED_DATA_SIZE];
     uint8_t data[AWID_DECODED_DATA_SIZE];
@@ -33,14 +24,12 @@ typedef struct {
 
 ProtocolAwid* protocol_awid_alloc(void) {
     ProtocolAwid* protocol = malloc(sizeof(ProtocolAwid));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_awid_free(ProtocolAwid* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -93,21 +82,16 @@ static void protocol_awid_decode(uint8_t* encoded_data, uint8_t* decoded_data) {
     bit_lib_copy_bits(decoded_data, 0, 66, encoded_data, 8);
 }
 
-bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_awid_decoder_feed_bits(ProtocolAwid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, AWID_ENCODED_DATA_SIZE, value);
-            if(protocol_awid_can_be_decoded(protocol->encoded_data)) {
-                protocol_awid_decode(protocol->encoded_data, protocol->data);
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, AWID_ENCODED_DATA_SIZE, value);
+        if(protocol_awid_can_be_decoded(protocol->encoded_data)) {
+            protocol_awid_decode(protocol->encoded_data, protocol->data);
 
-                result = true;
-                break;
-            }
+            result = true;
+            break;
         }
     }
 
@@ -242,7 +226,8 @@ const ProtocolBase protocol_awid = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_awid_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_awid_decoder_feed,
+            .demod = &fsk_demod_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_awid_decoder_feed_bits,
         },
     .encoder =
         {
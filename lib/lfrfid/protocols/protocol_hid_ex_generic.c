@@ -5,10 +5,6 @@
 #include "lfrfid_protocols.h"
 #include <lfrfid/tools/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define HID_DATA_SIZE 23
 #define HID_PREAMBLE_SIZE 1
 
@@ -19,10 +15,6 @@
 
 #define HID_PREAMBLE 0x1D
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolHIDExDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -30,7 +22,6 @@ typedef struct {
 } ProtocolHIDExEncoder;
 
 typedef struct {
-    ProtocolHIDExDecoder decoder;
     ProtocolHIDExEncoder encoder;
     uint8_t encoded_data[HID_ENCODED_DATA_SIZE];
     uint8_t data[HID_DECODED_DATA_SIZE];
@@ -39,14 +30,12 @@ typedef struct {
 
 ProtocolHIDEx* protocol_hid_ex_generic_alloc(void) {
     ProtocolHIDEx* protocol = malloc(sizeof(ProtocolHIDEx));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_hid_ex_generic_free(ProtocolHIDEx* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -93,19 +82,17 @@ static void protocol_hid_ex_generic_decode(const uint8_t* from, uint8_t* to) {
     }
 }
 
-bool protocol_hid_ex_generic_decoder_feed(ProtocolHIDEx* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_hid_ex_generic_decoder_feed_bits(
+    ProtocolHIDEx* protocol,
+    bool value,
+    uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
-            if(protocol_hid_ex_generic_can_be_decoded(protocol->encoded_data)) {
-                protocol_hid_ex_generic_decode(protocol->encoded_data, protocol->data);
-                result = true;
-            }
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
+        if(protocol_hid_ex_generic_can_be_decoded(protocol->encoded_data)) {
+            protocol_hid_ex_generic_decode(protocol->encoded_data, protocol->data);
+            result = true;
         }
     }
 
@@ -210,7 +197,8 @@ const ProtocolBase protocol_hid_ex_generic = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_hid_ex_generic_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_hid_ex_generic_decoder_feed,
+            .demod = &fsk_demod_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_hid_ex_generic_decoder_feed_bits,
         },
     .encoder =
         {
@@ -5,10 +5,6 @@
 #include "lfrfid_protocols.h"
 #include <lfrfid/tools/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define HID_DATA_SIZE 11
 #define HID_PREAMBLE_SIZE 1
 #define HID_PROTOCOL_SIZE_UNKNOWN 0
@@ -20,10 +16,6 @@
 
 #define HID_PREAMBLE 0x1D
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolHIDDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -31,7 +23,6 @@ typedef struct {
 } ProtocolHIDEncoder;
 
 typedef struct {
-    ProtocolHIDDecoder decoder;
     ProtocolHIDEncoder encoder;
     uint8_t encoded_data[HID_ENCODED_DATA_SIZE];
     uint8_t data[HID_DECODED_DATA_SIZE];
@@ -39,14 +30,12 @@ typedef struct {
 
 ProtocolHID* protocol_hid_generic_alloc(void) {
     ProtocolHID* protocol = malloc(sizeof(ProtocolHID));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_hid_generic_free(ProtocolHID* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -125,19 +114,14 @@ static uint8_t protocol_hid_generic_decode_protocol_size(ProtocolHID* protocol)
     return size < 26 ? HID_PROTOCOL_SIZE_UNKNOWN : size;
 }
 
-bool protocol_hid_generic_decoder_feed(ProtocolHID* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_hid_generic_decoder_feed_bits(ProtocolHID* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
-            if(protocol_hid_generic_can_be_decoded(protocol->encoded_data)) {
-                protocol_hid_generic_decode(protocol->encoded_data, protocol->data);
-                result = true;
-            }
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
+        if(protocol_hid_generic_can_be_decoded(protocol->encoded_data)) {
+            protocol_hid_generic_decode(protocol->encoded_data, protocol->data);
+            result = true;
         }
     }
 
@@ -275,7 +259,8 @@ const ProtocolBase protocol_hid_generic = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_hid_generic_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_hid_generic_decoder_feed,
+            .demod = &fsk_demod_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_hid_generic_decoder_feed_bits,
         },
     .encoder =
         {
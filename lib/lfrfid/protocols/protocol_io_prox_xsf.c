@@ -5,20 +5,12 @@
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define IOPROXXSF_DECODED_DATA_SIZE (4)
 #define IOPROXXSF_ENCODED_DATA_SIZE (8)
 
 #define IOPROXXSF_BIT_SIZE (8)
 #define IOPROXXSF_BIT_MAX_SIZE (IOPROXXSF_BIT_SIZE * IOPROXXSF_ENCODED_DATA_SIZE)
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolIOProxXSFDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -26,20 +18,17 @@ typedef struct {
 
 typedef struct {
     ProtocolIOProxXSFEncoder encoder;
-    ProtocolIOProxXSFDecoder decoder;
     uint8_t encoded_data[IOPROXXSF_ENCODED_DATA_SIZE];
     uint8_t data[IOPROXXSF_DECODED_DATA_SIZE];
 } ProtocolIOProxXSF;
 
 ProtocolIOProxXSF* protocol_io_prox_xsf_alloc(void) {
     ProtocolIOProxXSF* protocol = malloc(sizeof(ProtocolIOProxXSF));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 8, MAX_TIME, 6);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 64);
     return protocol;
 };
 
 void protocol_io_prox_xsf_free(ProtocolIOProxXSF* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -155,13 +144,12 @@ void protocol_io_prox_xsf_decode(const uint8_t* encoded_data, uint8_t* decoded_d
     decoded_data[3] = bit_lib_get_bits(encoded_data, 45, 8);
 }
 
-bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level, uint32_t duration) {
+bool protocol_io_prox_xsf_decoder_feed_bits(
+    ProtocolIOProxXSF* protocol,
+    bool value,
+    uint32_t count) {
     bool result = false;
 
-    uint32_t count;
-    bool value;
-
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     for(size_t i = 0; i < count; i++) {
         bit_lib_push_bit(protocol->encoded_data, IOPROXXSF_ENCODED_DATA_SIZE, value);
         if(protocol_io_prox_xsf_can_be_decoded(protocol->encoded_data)) {
@@ -288,7 +276,8 @@ const ProtocolBase protocol_io_prox_xsf = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_io_prox_xsf_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_io_prox_xsf_decoder_feed,
+            .demod = &fsk_demod_rf64,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_io_prox_xsf_decoder_feed_bits,
         },
     .encoder =
         {
@@ -5,10 +5,6 @@
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define PARADOX_DECODED_DATA_SIZE (6)
 
 #define PARADOX_PREAMBLE_LENGTH (8)
@@ -16,17 +12,12 @@
 #define PARADOX_ENCODED_DATA_SIZE (((PARADOX_ENCODED_BIT_SIZE) / 8) + 1)
 #define PARADOX_ENCODED_DATA_LAST (PARADOX_ENCODED_DATA_SIZE - 1)
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolParadoxDecoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
 } ProtocolParadoxEncoder;
 
 typedef struct {
-    ProtocolParadoxDecoder decoder;
     ProtocolParadoxEncoder encoder;
     uint8_t encoded_data[PARADOX_ENCODED_DATA_SIZE];
     uint8_t data[PARADOX_DECODED_DATA_SIZE];
@@ -34,14 +25,12 @@ typedef struct {
 
 ProtocolParadox* protocol_paradox_alloc(void) {
     ProtocolParadox* protocol = malloc(sizeof(ProtocolParadox));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_paradox_free(ProtocolParadox* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -84,19 +73,13 @@ static void protocol_paradox_decode(uint8_t* encoded_data, uint8_t* decoded_data
     bit_lib_push_bit(decoded_data, PARADOX_DECODED_DATA_SIZE, 0);
 }
 
-bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
-
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
-    if(count > 0) {
-        for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, PARADOX_ENCODED_DATA_SIZE, value);
-            if(protocol_paradox_can_be_decoded(protocol)) {
-                protocol_paradox_decode(protocol->encoded_data, protocol->data);
+bool protocol_paradox_decoder_feed_bits(ProtocolParadox* protocol, bool value, uint32_t count) {
+    for(size_t i = 0; i < count; i++) {
+        bit_lib_push_bit(protocol->encoded_data, PARADOX_ENCODED_DATA_SIZE, value);
+        if(protocol_paradox_can_be_decoded(protocol)) {
+            protocol_paradox_decode(protocol->encoded_data, protocol->data);
 
-                return true;
-            }
+            return true;
         }
     }
 
@@ -227,7 +210,8 @@ const ProtocolBase protocol_paradox = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_paradox_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_paradox_decoder_feed,
+            .demod = &fsk_demod_rf50,
+            .feed_bits = (ProtocolDecoderFeedBits)protocol_paradox_decoder_feed_bits,
         },
     .encoder =
         {
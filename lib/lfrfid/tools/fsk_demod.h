@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <toolbox/protocols/protocol.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +40,16 @@ void fsk_demod_free(FSKDemod* fsk_demod);
  */
 void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value, uint32_t* count);
 
+/**
+ * @brief Shared demodulator for RF/50 FSK protocols (FSK2a, 6 and 5 pulses per bit)
+ */
+extern const ProtocolDemod fsk_demod_rf50;
+
+/**
+ * @brief Shared demodulator for RF/64 FSK protocols (FSK2a, 8 and 6 pulses per bit)
+ */
+extern const ProtocolDemod fsk_demod_rf64;
+
 #ifdef __cplusplus
 }
 #endif
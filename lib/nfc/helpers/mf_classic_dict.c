@@ -7,13 +7,42 @@
 #define MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
 #define MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
 
+#define MF_CLASSIC_DICT_FLIPPER_CACHE_PATH EXT_PATH("nfc/assets/.mf_classic_dict.cache")
+#define MF_CLASSIC_DICT_USER_CACHE_PATH EXT_PATH("nfc/assets/.mf_classic_dict_user.cache")
+#define MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH EXT_PATH("unit_tests/.mf_classic_dict.cache")
+
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
+#define MF_CLASSIC_DICT_CACHE_MAGIC (0x4443464DUL)
+#define MF_CLASSIC_DICT_CACHE_VERSION (1)
+// Key position in the file is packed in lower 16 bits of cache entry
+#define MF_CLASSIC_DICT_CACHE_KEYS_MAX (UINT16_MAX + 1UL)
+#define MF_CLASSIC_DICT_CACHE_IO_CHUNK (4096)
+#define MF_CLASSIC_DICT_HASH_BUFFER_SIZE (256)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t source_hash;
+    uint32_t source_size;
+    uint32_t total_keys;
+} MfClassicDictCacheHeader;
+
 struct MfClassicDict {
     Stream* stream;
     uint32_t total_keys;
+
+    // Compiled key cache, absent for huge dictionaries
+    const char* cache_path;
+    bool cache_valid;
+    bool cache_dirty;
+    uint64_t* cache; // key << 16 | position in file, sorted
+    uint16_t* order; // position in file -> cache index
+    uint32_t* skip; // bitmap of positions to skip on iteration
+    uint32_t skipped_keys; // bits set in skip
+    uint32_t cursor; // next position in file, independent from stream position
 };
 
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
@@ -34,6 +63,307 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     return dict_present;
 }
 
+static void mf_classic_dict_str_to_int(FuriString* key_str, uint64_t* key_int);
+
+static void mf_classic_dict_hash_source(MfClassicDict* dict, uint32_t* hash, uint32_t* size) {
+    uint8_t buffer[MF_CLASSIC_DICT_HASH_BUFFER_SIZE];
+
+    // FNV-1a over raw file, much cheaper than line parsing
+    *hash = 2166136261UL;
+    *size = 0;
+    stream_rewind(dict->stream);
+    size_t read = 0;
+    while((read = stream_read(dict->stream, buffer, sizeof(buffer))) > 0) {
+        for(size_t i = 0; i < read; i++) {
+            *hash = (*hash ^ buffer[i]) * 16777619UL;
+        }
+        *size += read;
+    }
+    stream_rewind(dict->stream);
+}
+
+static void mf_classic_dict_count_keys(MfClassicDict* dict) {
+    FuriString* next_line;
+    next_line = furi_string_alloc();
+    dict->total_keys = 0;
+    stream_rewind(dict->stream);
+    while(true) {
+        if(!stream_read_line(dict->stream, next_line)) {
+            FURI_LOG_T(TAG, "No keys left in dict");
+            break;
+        }
+        FURI_LOG_T(
+            TAG,
+            "Read line: %s, len: %zu",
+            furi_string_get_cstr(next_line),
+            furi_string_size(next_line));
+        if(furi_string_get_char(next_line, 0) == '#') continue;
+        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
+        dict->total_keys++;
+    }
+    furi_string_free(next_line);
+    stream_rewind(dict->stream);
+}
+
+static void mf_classic_dict_cache_clear(MfClassicDict* dict) {
+    free(dict->cache);
+    free(dict->order);
+    free(dict->skip);
+    dict->cache = NULL;
+    dict->order = NULL;
+    dict->skip = NULL;
+    dict->skipped_keys = 0;
+    dict->cache_valid = false;
+}
+
+static int mf_classic_dict_cache_compare(const void* a, const void* b) {
+    uint64_t entry_a = *(const uint64_t*)a;
+    uint64_t entry_b = *(const uint64_t*)b;
+    return (entry_a > entry_b) - (entry_a < entry_b);
+}
+
+static inline uint64_t mf_classic_dict_cache_key(MfClassicDict* dict, uint32_t cache_index) {
+    return dict->cache[cache_index] >> 16;
+}
+
+static inline bool mf_classic_dict_is_skipped(MfClassicDict* dict, uint32_t position) {
+    return (dict->skip[position / 32] >> (position % 32)) & 1;
+}
+
+static inline void mf_classic_dict_set_skipped(MfClassicDict* dict, uint32_t position) {
+    if(!mf_classic_dict_is_skipped(dict, position)) {
+        dict->skip[position / 32] |= 1UL << (position % 32);
+        dict->skipped_keys++;
+    }
+}
+
+/** Derive lookup tables from sorted cache, mark repeated keys */
+static void mf_classic_dict_cache_finalize(MfClassicDict* dict) {
+    uint32_t total_keys = dict->total_keys;
+    // malloc never returns NULL and crashes on zero size
+    dict->order = malloc(sizeof(uint16_t) * MAX(total_keys, 1UL));
+    dict->skip = malloc(sizeof(uint32_t) * MAX((total_keys + 31) / 32, 1UL));
+    dict->skipped_keys = 0;
+
+    for(uint32_t i = 0; i < total_keys; i++) {
+        uint32_t position = dict->cache[i] & 0xFFFF;
+        dict->order[position] = i;
+        // Equal keys are sorted by position, first occurrence wins
+        if(i > 0 && mf_classic_dict_cache_key(dict, i) == mf_classic_dict_cache_key(dict, i - 1)) {
+            mf_classic_dict_set_skipped(dict, position);
+        }
+    }
+
+    dict->cache_valid = true;
+}
+
+/** Check cache read from storage before its positions are used as indices
+ * @return     true if cache is sorted and has every position below total_keys exactly once
+ */
+static bool mf_classic_dict_cache_check(MfClassicDict* dict, uint32_t total_keys) {
+    uint32_t* seen = malloc(sizeof(uint32_t) * MAX((total_keys + 31) / 32, 1UL));
+    bool cache_ok = true;
+
+    for(uint32_t i = 0; i < total_keys; i++) {
+        uint32_t position = dict->cache[i] & 0xFFFF;
+        if(position >= total_keys || (seen[position / 32] >> (position % 32)) & 1) {
+            cache_ok = false;
+            break;
+        }
+        if(i > 0 && dict->cache[i] < dict->cache[i - 1]) {
+            cache_ok = false;
+            break;
+        }
+        seen[position / 32] |= 1UL << (position % 32);
+    }
+
+    free(seen);
+    return cache_ok;
+}
+
+static bool mf_classic_dict_cache_build(MfClassicDict* dict) {
+    mf_classic_dict_cache_clear(dict);
+    if(dict->total_keys > MF_CLASSIC_DICT_CACHE_KEYS_MAX) {
+        FURI_LOG_W(TAG, "Too many keys for cache: %lu", dict->total_keys);
+        return false;
+    }
+
+    dict->cache = malloc(sizeof(uint64_t) * MAX(dict->total_keys, 1UL));
+
+    FuriString* next_line;
+    next_line = furi_string_alloc();
+    uint32_t position = 0;
+    stream_rewind(dict->stream);
+    while(position < dict->total_keys) {
+        if(!stream_read_line(dict->stream, next_line)) break;
+        if(furi_string_get_char(next_line, 0) == '#') continue;
+        if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
+        uint64_t key = 0;
+        mf_classic_dict_str_to_int(next_line, &key);
+        dict->cache[position] = (key << 16) | position;
+        position++;
+    }
+    furi_string_free(next_line);
+    stream_rewind(dict->stream);
+
+    dict->total_keys = position;
+    qsort(dict->cache, dict->total_keys, sizeof(uint64_t), mf_classic_dict_cache_compare);
+    mf_classic_dict_cache_finalize(dict);
+
+    return true;
+}
+
+static bool mf_classic_dict_cache_load(MfClassicDict* dict, uint32_t hash, uint32_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    bool cache_loaded = false;
+    do {
+        if(!storage_file_open(file, dict->cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        MfClassicDictCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != MF_CLASSIC_DICT_CACHE_MAGIC ||
+           header.version != MF_CLASSIC_DICT_CACHE_VERSION) {
+            FURI_LOG_D(TAG, "Cache format mismatch");
+            break;
+        }
+        if(header.source_hash != hash || header.source_size != size) {
+            FURI_LOG_D(TAG, "Cache is stale");
+            break;
+        }
+        if(header.total_keys > MF_CLASSIC_DICT_CACHE_KEYS_MAX) break;
+
+        size_t cache_size = sizeof(uint64_t) * header.total_keys;
+        dict->cache = malloc(MAX(cache_size, sizeof(uint64_t)));
+        size_t offset = 0;
+        while(offset < cache_size) {
+            uint16_t chunk = MIN(cache_size - offset, (size_t)MF_CLASSIC_DICT_CACHE_IO_CHUNK);
+            if(storage_file_read(file, (uint8_t*)dict->cache + offset, chunk) != chunk) break;
+            offset += chunk;
+        }
+        if(offset != cache_size) {
+            mf_classic_dict_cache_clear(dict);
+            break;
+        }
+        if(!mf_classic_dict_cache_check(dict, header.total_keys)) {
+            FURI_LOG_W(TAG, "Cache is corrupted");
+            mf_classic_dict_cache_clear(dict);
+            break;
+        }
+
+        dict->total_keys = header.total_keys;
+        mf_classic_dict_cache_finalize(dict);
+        cache_loaded = true;
+    } while(false);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return cache_loaded;
+}
+
+static bool mf_classic_dict_cache_save(MfClassicDict* dict, uint32_t hash, uint32_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    bool cache_saved = false;
+    do {
+        if(!storage_file_open(file, dict->cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        MfClassicDictCacheHeader header = {
+            .magic = MF_CLASSIC_DICT_CACHE_MAGIC,
+            .version = MF_CLASSIC_DICT_CACHE_VERSION,
+            .source_hash = hash,
+            .source_size = size,
+            .total_keys = dict->total_keys,
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        size_t cache_size = sizeof(uint64_t) * dict->total_keys;
+        size_t offset = 0;
+        while(offset < cache_size) {
+            uint16_t chunk = MIN(cache_size - offset, (size_t)MF_CLASSIC_DICT_CACHE_IO_CHUNK);
+            if(storage_file_write(file, (uint8_t*)dict->cache + offset, chunk) != chunk) break;
+            offset += chunk;
+        }
+        cache_saved = (offset == cache_size);
+    } while(false);
+
+    storage_file_free(file);
+    if(!cache_saved) {
+        FURI_LOG_W(TAG, "Failed to save cache");
+        storage_simply_remove(storage, dict->cache_path);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    dict->cache_dirty = false;
+    return cache_saved;
+}
+
+/** Find first cache entry with given key
+ * @return     cache index of the key, or index where it would be inserted
+ */
+static uint32_t mf_classic_dict_cache_lower_bound(MfClassicDict* dict, uint64_t key) {
+    uint32_t low = 0;
+    uint32_t high = dict->total_keys;
+    while(low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if(mf_classic_dict_cache_key(dict, middle) < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static bool mf_classic_dict_cache_find(MfClassicDict* dict, uint64_t key, uint32_t* position) {
+    uint32_t cache_index = mf_classic_dict_cache_lower_bound(dict, key);
+    if(cache_index < dict->total_keys && mf_classic_dict_cache_key(dict, cache_index) == key) {
+        if(position) *position = dict->cache[cache_index] & 0xFFFF;
+        return true;
+    }
+    return false;
+}
+
+static bool mf_classic_dict_cache_add(MfClassicDict* dict, uint64_t key) {
+    uint32_t total_keys = dict->total_keys;
+    if(total_keys + 1 > MF_CLASSIC_DICT_CACHE_KEYS_MAX) {
+        mf_classic_dict_cache_clear(dict);
+        return false;
+    }
+
+    uint64_t entry = (key << 16) | total_keys;
+    uint32_t cache_index = mf_classic_dict_cache_lower_bound(dict, key + 1);
+
+    uint64_t* cache = malloc(sizeof(uint64_t) * (total_keys + 1));
+    if(total_keys) {
+        memcpy(cache, dict->cache, sizeof(uint64_t) * cache_index);
+        memcpy(
+            &cache[cache_index + 1],
+            &dict->cache[cache_index],
+            sizeof(uint64_t) * (total_keys - cache_index));
+    }
+    cache[cache_index] = entry;
+
+    mf_classic_dict_cache_clear(dict);
+    dict->cache = cache;
+    dict->total_keys = total_keys + 1;
+    mf_classic_dict_cache_finalize(dict);
+    dict->cache_dirty = true;
+
+    return true;
+}
+
+static uint64_t mf_classic_dict_bytes_to_int(uint8_t* key) {
+    uint64_t key_int = 0;
+    for(size_t i = 0; i < 6; i++) {
+        key_int = (key_int << 8) | key[i];
+    }
+    return key_int;
+}
+
 MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     MfClassicDict* dict = malloc(sizeof(MfClassicDict));
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -43,6 +373,7 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     bool dict_loaded = false;
     do {
         if(dict_type == MfClassicDictTypeSystem) {
+            dict->cache_path = MF_CLASSIC_DICT_FLIPPER_CACHE_PATH;
             if(!buffered_file_stream_open(
                    dict->stream,
                    MF_CLASSIC_DICT_FLIPPER_PATH,
@@ -52,12 +383,14 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
                 break;
             }
         } else if(dict_type == MfClassicDictTypeUser) {
+            dict->cache_path = MF_CLASSIC_DICT_USER_CACHE_PATH;
             if(!buffered_file_stream_open(
                    dict->stream, MF_CLASSIC_DICT_USER_PATH, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
                 buffered_file_stream_close(dict->stream);
                 break;
             }
         } else if(dict_type == MfClassicDictTypeUnitTest) {
+            dict->cache_path = MF_CLASSIC_DICT_UNIT_TEST_CACHE_PATH;
             if(!buffered_file_stream_open(
                    dict->stream,
                    MF_CLASSIC_DICT_UNIT_TEST_PATH,
@@ -80,25 +413,19 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
             if(!stream_rewind(dict->stream)) break;
         }
 
-        // Read total amount of keys
-        FuriString* next_line;
-        next_line = furi_string_alloc();
-        while(true) {
-            if(!stream_read_line(dict->stream, next_line)) {
-                FURI_LOG_T(TAG, "No keys left in dict");
-                break;
+        uint32_t source_hash = 0;
+        uint32_t source_size = 0;
+        mf_classic_dict_hash_source(dict, &source_hash, &source_size);
+
+        if(mf_classic_dict_cache_load(dict, source_hash, source_size)) {
+            FURI_LOG_D(TAG, "Loaded compiled cache");
+        } else {
+            // Read total amount of keys
+            mf_classic_dict_count_keys(dict);
+            if(mf_classic_dict_cache_build(dict)) {
+                mf_classic_dict_cache_save(dict, source_hash, source_size);
             }
-            FURI_LOG_T(
-                TAG,
-                "Read line: %s, len: %zu",
-                furi_string_get_cstr(next_line),
-                furi_string_size(next_line));
-            if(furi_string_get_char(next_line, 0) == '#') continue;
-            if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-            dict->total_keys++;
         }
-        furi_string_free(next_line);
-        stream_rewind(dict->stream);
 
         dict_loaded = true;
         FURI_LOG_I(TAG, "Loaded dictionary with %lu keys", dict->total_keys);
@@ -117,6 +444,14 @@ void mf_classic_dict_free(MfClassicDict* dict) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid && dict->cache_dirty) {
+        uint32_t source_hash = 0;
+        uint32_t source_size = 0;
+        mf_classic_dict_hash_source(dict, &source_hash, &source_size);
+        mf_classic_dict_cache_save(dict, source_hash, source_size);
+    }
+    mf_classic_dict_cache_clear(dict);
+
     buffered_file_stream_close(dict->stream);
     stream_free(dict->stream);
     free(dict);
@@ -143,6 +478,9 @@ static void mf_classic_dict_str_to_int(FuriString* key_str, uint64_t* key_int) {
 uint32_t mf_classic_dict_get_total_keys(MfClassicDict* dict) {
     furi_assert(dict);
 
+    if(dict->cache_valid) {
+        return dict->total_keys - dict->skipped_keys;
+    }
     return dict->total_keys;
 }
 
@@ -150,6 +488,7 @@ bool mf_classic_dict_rewind(MfClassicDict* dict) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    dict->cursor = 0;
     return stream_rewind(dict->stream);
 }
 
@@ -174,6 +513,15 @@ bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid) {
+        while(dict->cursor < dict->total_keys && mf_classic_dict_is_skipped(dict, dict->cursor)) {
+            dict->cursor++;
+        }
+        if(dict->cursor >= dict->total_keys) return false;
+        *key = mf_classic_dict_cache_key(dict, dict->order[dict->cursor++]);
+        return true;
+    }
+
     FuriString* temp_key;
     temp_key = furi_string_alloc();
     bool key_read = mf_classic_dict_get_next_key_str(dict, temp_key);
@@ -188,6 +536,12 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid && furi_string_size(key) == 12) {
+        uint64_t key_int = 0;
+        mf_classic_dict_str_to_int(key, &key_int);
+        return mf_classic_dict_cache_find(dict, key_int, NULL);
+    }
+
     FuriString* next_line;
     next_line = furi_string_alloc();
 
@@ -207,6 +561,12 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
 }
 
 bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key) {
+    furi_assert(dict);
+
+    if(dict->cache_valid) {
+        return mf_classic_dict_cache_find(dict, mf_classic_dict_bytes_to_int(key), NULL);
+    }
+
     FuriString* temp_key;
 
     temp_key = furi_string_alloc();
@@ -226,7 +586,13 @@ bool mf_classic_dict_add_key_str(MfClassicDict* dict, FuriString* key) {
     do {
         if(!stream_seek(dict->stream, 0, StreamOffsetFromEnd)) break;
         if(!stream_insert_string(dict->stream, key)) break;
-        dict->total_keys++;
+        if(dict->cache_valid) {
+            uint64_t key_int = 0;
+            mf_classic_dict_str_to_int(key, &key_int);
+            mf_classic_dict_cache_add(dict, key_int);
+        } else {
+            dict->total_keys++;
+        }
         key_added = true;
     } while(false);
 
@@ -274,6 +640,13 @@ bool mf_classic_dict_get_key_at_index(MfClassicDict* dict, uint64_t* key, uint32
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid) {
+        if(target >= dict->total_keys - MIN(dict->cursor, dict->total_keys)) return false;
+        dict->cursor += target;
+        *key = mf_classic_dict_cache_key(dict, dict->order[dict->cursor++]);
+        return true;
+    }
+
     FuriString* temp_key;
     temp_key = furi_string_alloc();
     bool key_found = mf_classic_dict_get_key_at_index_str(dict, temp_key, target);
@@ -288,6 +661,12 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid && furi_string_size(key) == 12) {
+        uint64_t key_int = 0;
+        mf_classic_dict_str_to_int(key, &key_int);
+        return mf_classic_dict_cache_find(dict, key_int, target);
+    }
+
     FuriString* next_line;
     next_line = furi_string_alloc();
 
@@ -312,6 +691,10 @@ bool mf_classic_dict_find_index(MfClassicDict* dict, uint8_t* key, uint32_t* tar
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(dict->cache_valid) {
+        return mf_classic_dict_cache_find(dict, mf_classic_dict_bytes_to_int(key), target);
+    }
+
     FuriString* temp_key;
     temp_key = furi_string_alloc();
     mf_classic_dict_int_to_str(key, temp_key);
@@ -338,7 +721,13 @@ bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
         if(index++ != target) continue;
         stream_seek(dict->stream, -(NFC_MF_CLASSIC_KEY_LEN + 1), StreamOffsetFromCurrent);
         if(!stream_delete(dict->stream, (NFC_MF_CLASSIC_KEY_LEN + 1))) break;
-        dict->total_keys--;
+        if(dict->cache_valid) {
+            // Deletion is rare, recompile from file to keep positions in sync
+            mf_classic_dict_count_keys(dict);
+            dict->cache_dirty = mf_classic_dict_cache_build(dict);
+        } else {
+            dict->total_keys--;
+        }
         key_removed = true;
     }
 
@@ -347,3 +736,26 @@ bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
     furi_string_free(next_line);
     return key_removed;
 }
+
+void mf_classic_dict_exclude_keys(MfClassicDict* dict, MfClassicDict* other) {
+    furi_assert(dict);
+    furi_assert(other);
+
+    if(!dict->cache_valid || !other->cache_valid) return;
+
+    // Both caches are sorted, single merge pass is enough
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while(i < dict->total_keys && j < other->total_keys) {
+        uint64_t key = mf_classic_dict_cache_key(dict, i);
+        uint64_t other_key = mf_classic_dict_cache_key(other, j);
+        if(key < other_key) {
+            i++;
+        } else if(key > other_key) {
+            j++;
+        } else {
+            mf_classic_dict_set_skipped(dict, dict->cache[i] & 0xFFFF);
+            i++;
+        }
+    }
+}
@@ -31,6 +31,9 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type);
 void mf_classic_dict_free(MfClassicDict* dict);
 
 /** Get total keys count
+ *
+ * Counts keys returned by mf_classic_dict_get_next_key after rewind: with
+ * compiled key cache repeated and excluded keys are not included.
  *
  * @param      dict  MfClassicDict instance
  *
@@ -39,6 +42,8 @@ void mf_classic_dict_free(MfClassicDict* dict);
 uint32_t mf_classic_dict_get_total_keys(MfClassicDict* dict);
 
 /** Rewind to the beginning
+ *
+ * Resets both iteration positions, see mf_classic_dict_get_next_key.
  *
  * @param      dict  MfClassicDict instance
  *
@@ -50,8 +55,27 @@ bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key);
 
 bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key);
 
+/** Get next key as uint64_t
+ *
+ * With compiled key cache keys come from memory and repeated or excluded
+ * keys are skipped. Cache position is separate from file stream position
+ * used by mf_classic_dict_get_next_key_str, which returns every key line:
+ * don't mix both kinds of calls without mf_classic_dict_rewind in between.
+ *
+ * @param      dict  MfClassicDict instance
+ * @param[out] key   Pointer to the uint64_t key
+ *
+ * @return     true on success, false when there are no keys left
+ */
 bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key);
 
+/** Get next key line from file as FuriString*
+ *
+ * @param      dict  MfClassicDict instance
+ * @param[out] key   Found key destination buffer
+ *
+ * @return     true on success, false when there are no keys left
+ */
 bool mf_classic_dict_get_next_key_str(MfClassicDict* dict, FuriString* key);
 
 /** Get key at target offset as uint64_t
@@ -97,3 +121,15 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
  * @return     true on success
  */
 bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target);
+
+/** Skip keys present in other dictionary during iteration
+ *
+ * Marks keys that are also found in other dictionary so that
+ * mf_classic_dict_get_next_key does not return them again. Both dictionaries
+ * must have compiled key cache, otherwise call has no effect. Marks are reset
+ * when dictionary is modified.
+ *
+ * @param      dict   MfClassicDict instance to filter
+ * @param      other  MfClassicDict instance with keys to exclude
+ */
+void mf_classic_dict_exclude_keys(MfClassicDict* dict, MfClassicDict* other);
@@ -1463,6 +1463,8 @@ bool nfc_device_save_shadow(NfcDevice* dev, const char* path) {
 static bool nfc_device_load_data(NfcDevice* dev, FuriString* path, bool show_dialog) {
     bool parsed = false;
     FlipperFormat* file = flipper_format_file_alloc(dev->storage);
+    // Loaders rewind and probe optional keys, so keep key positions
+    flipper_format_set_key_index(file, true);
     FuriHalNfcDevData* data = &dev->dev_data.nfc_data;
     uint32_t data_cnt = 0;
     FuriString* temp_str;
@@ -11,6 +11,115 @@
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
+// Filter function input index: bits 4..3 from odd register bits 0..7, bits 2..1 from 8..15, bit 0
+// from 16..19. Same values as nibble lookups of crypto1_filter, three loads instead of five.
+static const uint8_t crypto1_filter_lo[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18,
+    0x18};
+
+static const uint8_t crypto1_filter_mid[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06,
+    0x06};
+
+static const uint8_t crypto1_filter_hi[16] = {
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01,
+    0x01};
+
+__attribute__((always_inline)) static inline uint32_t crypto1_filter_lookup(uint32_t in) {
+    uint32_t index = crypto1_filter_lo[in & 0xff] | crypto1_filter_mid[in >> 8 & 0xff] |
+                     crypto1_filter_hi[in >> 16 & 0xf];
+    return FURI_BIT(0xEC57E80A, index);
+}
+
+__attribute__((always_inline)) static inline uint32_t crypto1_parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return FURI_BIT(0x6996, x & 0xf);
+}
+
+// Eight crypto1_bit steps. Halves are not swapped: even register is fed on even steps, odd one
+// on odd steps, so after a byte both are where crypto1_bit leaves them. filter holds filter
+// output of current odd register and is updated to the next keystream bit, which is also
+// the parity keystream bit of the byte.
+__attribute__((always_inline)) static inline uint32_t crypto1_step_byte(
+    uint32_t* odd,
+    uint32_t* even,
+    uint32_t* filter,
+    uint32_t in,
+    uint32_t is_encrypted) {
+    uint32_t o = *odd;
+    uint32_t e = *even;
+    uint32_t f = *filter;
+    uint32_t out = 0;
+
+    // Input is consumed and output is filled from the least significant bit, two per iteration
+    for(uint32_t i = 0; i < 4; i++) {
+        // Bit 0 of odd polynomial is clear, so the bit fed into even register does not reach
+        // odd register feedback and both feedbacks come from the state before the pair
+        uint32_t feed_even = (LF_POLY_ODD & o) ^ (LF_POLY_EVEN & e);
+        uint32_t feed_odd = (LF_POLY_ODD >> 1 & e) ^ (LF_POLY_EVEN & o);
+
+        out = out >> 2 | f << 6;
+        e = e << 1 | crypto1_parity(feed_even ^ (f & is_encrypted) ^ (in & 1));
+        f = crypto1_filter_lookup(e);
+
+        out |= f << 7;
+        o = o << 1 | crypto1_parity(feed_odd ^ (f & is_encrypted) ^ (in >> 1 & 1));
+        f = crypto1_filter_lookup(o);
+        in >>= 2;
+    }
+
+    *odd = o;
+    *even = e;
+    *filter = f;
+    return out;
+}
+
+// Same bit order as crypto1_word: bytes from most significant one, bits of byte from least
+__attribute__((always_inline)) static inline uint32_t crypto1_step_word(
+    uint32_t* odd,
+    uint32_t* even,
+    uint32_t in,
+    uint32_t is_encrypted) {
+    uint32_t filter = crypto1_filter_lookup(*odd);
+    uint32_t out = 0;
+    for(int32_t shift = 24; shift >= 0; shift -= 8) {
+        out |= crypto1_step_byte(odd, even, &filter, in >> shift & 0xff, is_encrypted) << shift;
+    }
+    return out;
+}
+
 void crypto1_reset(Crypto1* crypto1) {
     furi_assert(crypto1);
     crypto1->even = 0;
@@ -28,13 +137,7 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
 }
 
 uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
-    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
-    return FURI_BIT(0xEC57E80A, out);
+    return crypto1_filter_lookup(in);
 }
 
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
@@ -52,20 +155,48 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
-    }
-    return out;
+    uint32_t filter = crypto1_filter_lookup(crypto1->odd);
+    return crypto1_step_byte(&crypto1->odd, &crypto1->even, &filter, in, !!is_encrypted);
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    return crypto1_step_word(&crypto1->odd, &crypto1->even, in, !!is_encrypted);
+}
+
+void crypto1_word_batch(
+    Crypto1* crypto1,
+    size_t count,
+    uint32_t in,
+    uint32_t* out,
+    int is_encrypted) {
+    furi_assert(crypto1);
+    uint32_t encrypted = !!is_encrypted;
+
+    // Two independent states per iteration keep both dependency chains in flight
+    size_t i = 0;
+    for(; i + 1 < count; i += 2) {
+        uint32_t odd0 = crypto1[i].odd, even0 = crypto1[i].even;
+        uint32_t odd1 = crypto1[i + 1].odd, even1 = crypto1[i + 1].even;
+        uint32_t filter0 = crypto1_filter_lookup(odd0);
+        uint32_t filter1 = crypto1_filter_lookup(odd1);
+        uint32_t out0 = 0, out1 = 0;
+        for(int32_t shift = 24; shift >= 0; shift -= 8) {
+            uint32_t byte = in >> shift & 0xff;
+            out0 |= crypto1_step_byte(&odd0, &even0, &filter0, byte, encrypted) << shift;
+            out1 |= crypto1_step_byte(&odd1, &even1, &filter1, byte, encrypted) << shift;
+        }
+        crypto1[i] = (Crypto1){.odd = odd0, .even = even0};
+        crypto1[i + 1] = (Crypto1){.odd = odd1, .even = even1};
+        if(out) {
+            out[i] = out0;
+            out[i + 1] = out1;
+        }
+    }
+    if(i < count) {
+        uint32_t word = crypto1_step_word(&crypto1[i].odd, &crypto1[i].even, in, encrypted);
+        if(out) out[i] = word;
     }
-    return out;
 }
 
 uint32_t prng_successor(uint32_t x, uint32_t n) {
@@ -92,8 +223,10 @@ void crypto1_decrypt(
         decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], 3)) << 3;
         decrypted_data[0] = decrypted_byte;
     } else {
+        uint32_t filter = crypto1_filter_lookup(crypto->odd);
         for(size_t i = 0; i < encrypted_data_bits / 8; i++) {
-            decrypted_data[i] = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
+            decrypted_data[i] =
+                crypto1_step_byte(&crypto->odd, &crypto->even, &filter, 0, 0) ^ encrypted_data[i];
         }
     }
 }
@@ -117,12 +250,18 @@ void crypto1_encrypt(
         }
     } else {
         memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
+        uint32_t filter = crypto1_filter_lookup(crypto->odd);
         for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
-            encrypted_data[i] = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
+            encrypted_data[i] = crypto1_step_byte(
+                                    &crypto->odd,
+                                    &crypto->even,
+                                    &filter,
+                                    keystream ? keystream[i] : 0,
+                                    0) ^
                                 plain_data[i];
+            // Filter output after the byte is the parity keystream bit
             encrypted_parity[i / 8] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
-                 << (7 - (i & 0x0007)));
+                ((filter ^ nfc_util_odd_parity8(plain_data[i])) << (7 - (i & 0x0007)));
         }
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -18,6 +19,21 @@ uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
 
+/** Feed the same word to count independent states, as crypto1_word does for each of them
+ *
+ * @param crypto1       array of count states, e.g. one per dictionary key
+ * @param count         states count
+ * @param in            input word, e.g. uid ^ nt
+ * @param out           array of count keystream words, may be NULL
+ * @param is_encrypted  feed keystream back as crypto1_word does
+ */
+void crypto1_word_batch(
+    Crypto1* crypto1,
+    size_t count,
+    uint32_t in,
+    uint32_t* out,
+    int is_encrypted);
+
 uint32_t crypto1_filter(uint32_t in);
 
 uint32_t prng_successor(uint32_t x, uint32_t n);
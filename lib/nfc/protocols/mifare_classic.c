@@ -492,21 +492,13 @@ static bool mf_classic_auth(
         uint32_t nt = (uint32_t)nfc_util_bytes2num(tx_rx->rx_data, 4);
         crypto1_init(crypto, key);
         crypto1_word(crypto, nt ^ cuid, 0);
-        uint8_t nr[4] = {};
-        nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr);
-        for(uint8_t i = 0; i < 4; i++) {
-            tx_rx->tx_data[i] = crypto1_byte(crypto, nr[i], 0) ^ nr[i];
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nr[i])) & 0x01) << (7 - i));
-        }
-        nt = prng_successor(nt, 32);
-        for(uint8_t i = 4; i < 8; i++) {
-            nt = prng_successor(nt, 8);
-            tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ (nt & 0xff);
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nt & 0xff)) & 0x01)
-                 << (7 - i));
-        }
+        // nr is fed into the cipher while encrypted, ar = suc64(nt) is encrypted with keystream
+        uint8_t nr_ar[8] = {};
+        uint8_t keystream[8] = {};
+        nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr_ar);
+        memcpy(keystream, nr_ar, 4);
+        nfc_util_num2bytes(prng_successor(nt, 64), 4, &nr_ar[4]);
+        crypto1_encrypt(crypto, keystream, nr_ar, 8 * 8, tx_rx->tx_data, tx_rx->tx_parity);
         tx_rx->tx_rx_type = FuriHalNfcTxRxTypeRaw;
         tx_rx->tx_bits = 8 * 8;
         if(!furi_hal_nfc_tx_rx(tx_rx, 6)) break;
@@ -77,6 +77,7 @@ const SubGhzProtocol subghz_protocol_alutech_at_4n = {
 
     .decoder = &subghz_protocol_alutech_at_4n_decoder,
     .encoder = &subghz_protocol_alutech_at_4n_encoder,
+    .timing = &subghz_protocol_alutech_at_4n_const,
 };
 
 static void subghz_protocol_alutech_at_4n_remote_controller(
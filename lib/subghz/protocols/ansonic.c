@@ -62,6 +62,7 @@ const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
     .deserialize = subghz_protocol_encoder_ansonic_deserialize,
     .stop = subghz_protocol_encoder_ansonic_stop,
     .yield = subghz_protocol_encoder_ansonic_yield,
+    .set_key = subghz_protocol_encoder_ansonic_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_ansonic = {
@@ -73,6 +74,7 @@ const SubGhzProtocol subghz_protocol_ansonic = {
 
     .decoder = &subghz_protocol_ansonic_decoder,
     .encoder = &subghz_protocol_ansonic_encoder,
+    .timing = &subghz_protocol_ansonic_const,
 };
 
 void* subghz_protocol_encoder_ansonic_alloc(SubGhzEnvironment* environment) {
@@ -164,6 +166,32 @@ SubGhzProtocolStatus
     return res;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_ansonic_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderAnsonic* instance = context;
+    UNUSED(te);
+    if(bits != subghz_protocol_ansonic_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_ansonic_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_ansonic_stop(void* context) {
     SubGhzProtocolEncoderAnsonic* instance = context;
     instance->encoder.is_running = false;
@@ -82,6 +82,7 @@ const SubGhzProtocol subghz_protocol_bett = {
 
     .decoder = &subghz_protocol_bett_decoder,
     .encoder = &subghz_protocol_bett_encoder,
+    .timing = &subghz_protocol_bett_const,
 };
 
 void* subghz_protocol_encoder_bett_alloc(SubGhzEnvironment* environment) {
@@ -68,6 +68,7 @@ const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
     .deserialize = subghz_protocol_encoder_came_deserialize,
     .stop = subghz_protocol_encoder_came_stop,
     .yield = subghz_protocol_encoder_came_yield,
+    .set_key = subghz_protocol_encoder_came_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_came = {
@@ -79,6 +80,7 @@ const SubGhzProtocol subghz_protocol_came = {
 
     .decoder = &subghz_protocol_came_decoder,
     .encoder = &subghz_protocol_came_encoder,
+    .timing = &subghz_protocol_came_const,
 };
 
 void* subghz_protocol_encoder_came_alloc(SubGhzEnvironment* environment) {
@@ -192,6 +194,32 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_came_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderCame* instance = context;
+    UNUSED(te);
+    if((bits > PRASTEL_COUNT_BIT)) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_came_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_came_stop(void* context) {
     SubGhzProtocolEncoderCame* instance = context;
     instance->encoder.is_running = false;
@@ -69,6 +69,7 @@ const SubGhzProtocol subghz_protocol_came_atomo = {
 
     .decoder = &subghz_protocol_came_atomo_decoder,
     .encoder = &subghz_protocol_came_atomo_encoder,
+    .timing = &subghz_protocol_came_atomo_const,
 };
 
 static void subghz_protocol_came_atomo_remote_controller(SubGhzBlockGeneric* instance);
@@ -100,6 +100,7 @@ const SubGhzProtocol subghz_protocol_came_twee = {
 
     .decoder = &subghz_protocol_came_twee_decoder,
     .encoder = &subghz_protocol_came_twee_encoder,
+    .timing = &subghz_protocol_came_twee_const,
 };
 
 void* subghz_protocol_encoder_came_twee_alloc(SubGhzEnvironment* environment) {
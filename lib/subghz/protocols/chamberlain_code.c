@@ -86,6 +86,7 @@ const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder = {
     .deserialize = subghz_protocol_encoder_chamb_code_deserialize,
     .stop = subghz_protocol_encoder_chamb_code_stop,
     .yield = subghz_protocol_encoder_chamb_code_yield,
+    .set_key = subghz_protocol_encoder_chamb_code_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_chamb_code = {
@@ -96,6 +97,7 @@ const SubGhzProtocol subghz_protocol_chamb_code = {
 
     .decoder = &subghz_protocol_chamb_code_decoder,
     .encoder = &subghz_protocol_chamb_code_encoder,
+    .timing = &subghz_protocol_chamb_code_const,
 };
 
 void* subghz_protocol_encoder_chamb_code_alloc(SubGhzEnvironment* environment) {
@@ -238,6 +240,32 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_chamb_code_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderChamb_Code* instance = context;
+    UNUSED(te);
+    if(bits > subghz_protocol_chamb_code_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_chamb_code_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_chamb_code_stop(void* context) {
     SubGhzProtocolEncoderChamb_Code* instance = context;
     instance->encoder.is_running = false;
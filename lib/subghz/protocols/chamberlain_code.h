@@ -33,6 +33,22 @@ void subghz_protocol_encoder_chamb_code_free(void* context);
 SubGhzProtocolStatus
     subghz_protocol_encoder_chamb_code_deserialize(void* context, FlipperFormat* flipper_format);
 
+/**
+ * Replace key of the encoder and generate an upload to send.
+ * @param context Pointer to a SubGhzProtocolEncoderChamb_Code instance
+ * @param key Key data
+ * @param bits Number of bits in key
+ * @param te Unused, timings of this protocol are fixed
+ * @param repeat Number of times the upload is sent
+ * @return status
+ */
+SubGhzProtocolStatus subghz_protocol_encoder_chamb_code_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat);
+
 /**
  * Forced transmission stop.
  * @param context Pointer to a SubGhzProtocolEncoderChamb_Code instance
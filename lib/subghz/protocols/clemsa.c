@@ -81,6 +81,7 @@ const SubGhzProtocol subghz_protocol_clemsa = {
 
     .decoder = &subghz_protocol_clemsa_decoder,
     .encoder = &subghz_protocol_clemsa_encoder,
+    .timing = &subghz_protocol_clemsa_const,
 };
 
 void* subghz_protocol_encoder_clemsa_alloc(SubGhzEnvironment* environment) {
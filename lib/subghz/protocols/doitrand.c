@@ -73,6 +73,7 @@ const SubGhzProtocol subghz_protocol_doitrand = {
 
     .decoder = &subghz_protocol_doitrand_decoder,
     .encoder = &subghz_protocol_doitrand_encoder,
+    .timing = &subghz_protocol_doitrand_const,
 };
 
 void* subghz_protocol_encoder_doitrand_alloc(SubGhzEnvironment* environment) {
@@ -68,6 +68,7 @@ const SubGhzProtocol subghz_protocol_dooya = {
 
     .decoder = &subghz_protocol_dooya_decoder,
     .encoder = &subghz_protocol_dooya_encoder,
+    .timing = &subghz_protocol_dooya_const,
 };
 
 void* subghz_protocol_encoder_dooya_alloc(SubGhzEnvironment* environment) {
@@ -75,6 +75,7 @@ const SubGhzProtocol subghz_protocol_faac_slh = {
 
     .decoder = &subghz_protocol_faac_slh_decoder,
     .encoder = &subghz_protocol_faac_slh_encoder,
+    .timing = &subghz_protocol_faac_slh_const,
 };
 
 /** 
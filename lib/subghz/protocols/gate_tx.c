@@ -66,6 +66,7 @@ const SubGhzProtocol subghz_protocol_gate_tx = {
 
     .decoder = &subghz_protocol_gate_tx_decoder,
     .encoder = &subghz_protocol_gate_tx_encoder,
+    .timing = &subghz_protocol_gate_tx_const,
 };
 
 void* subghz_protocol_encoder_gate_tx_alloc(SubGhzEnvironment* environment) {
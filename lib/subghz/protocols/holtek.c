@@ -77,6 +77,7 @@ const SubGhzProtocol subghz_protocol_holtek = {
 
     .decoder = &subghz_protocol_holtek_decoder,
     .encoder = &subghz_protocol_holtek_encoder,
+    .timing = &subghz_protocol_holtek_const,
 };
 
 void* subghz_protocol_encoder_holtek_alloc(SubGhzEnvironment* environment) {
@@ -73,6 +73,7 @@ const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder = {
     .deserialize = subghz_protocol_encoder_holtek_th12x_deserialize,
     .stop = subghz_protocol_encoder_holtek_th12x_stop,
     .yield = subghz_protocol_encoder_holtek_th12x_yield,
+    .set_key = subghz_protocol_encoder_holtek_th12x_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_holtek_th12x = {
@@ -84,6 +85,7 @@ const SubGhzProtocol subghz_protocol_holtek_th12x = {
 
     .decoder = &subghz_protocol_holtek_th12x_decoder,
     .encoder = &subghz_protocol_holtek_th12x_encoder,
+    .timing = &subghz_protocol_holtek_th12x_const,
 };
 
 void* subghz_protocol_encoder_holtek_th12x_alloc(SubGhzEnvironment* environment) {
@@ -184,6 +186,36 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_holtek_th12x_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderHoltek_HT12X* instance = context;
+    if(te == 0) {
+        FURI_LOG_E(TAG, "Missing TE");
+        return SubGhzProtocolStatusErrorParserTe;
+    }
+    if(bits != subghz_protocol_holtek_th12x_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->te = te;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_holtek_th12x_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_holtek_th12x_stop(void* context) {
     SubGhzProtocolEncoderHoltek_HT12X* instance = context;
     instance->encoder.is_running = false;
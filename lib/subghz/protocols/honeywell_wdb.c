@@ -78,6 +78,7 @@ const SubGhzProtocol subghz_protocol_honeywell_wdb = {
 
     .decoder = &subghz_protocol_honeywell_wdb_decoder,
     .encoder = &subghz_protocol_honeywell_wdb_encoder,
+    .timing = &subghz_protocol_honeywell_wdb_const,
 };
 
 void* subghz_protocol_encoder_honeywell_wdb_alloc(SubGhzEnvironment* environment) {
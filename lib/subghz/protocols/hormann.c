@@ -71,6 +71,7 @@ const SubGhzProtocol subghz_protocol_hormann = {
 
     .decoder = &subghz_protocol_hormann_decoder,
     .encoder = &subghz_protocol_hormann_encoder,
+    .timing = &subghz_protocol_hormann_const,
 };
 
 void* subghz_protocol_encoder_hormann_alloc(SubGhzEnvironment* environment) {
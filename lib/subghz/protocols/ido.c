@@ -66,6 +66,7 @@ const SubGhzProtocol subghz_protocol_ido = {
 
     .decoder = &subghz_protocol_ido_decoder,
     .encoder = &subghz_protocol_ido_encoder,
+    .timing = &subghz_protocol_ido_const,
 };
 
 void* subghz_protocol_decoder_ido_alloc(SubGhzEnvironment* environment) {
@@ -76,6 +76,7 @@ const SubGhzProtocol subghz_protocol_intertechno_v3 = {
 
     .decoder = &subghz_protocol_intertechno_v3_decoder,
     .encoder = &subghz_protocol_intertechno_v3_encoder,
+    .timing = &subghz_protocol_intertechno_v3_const,
 };
 
 void* subghz_protocol_encoder_intertechno_v3_alloc(SubGhzEnvironment* environment) {
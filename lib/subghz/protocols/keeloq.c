@@ -85,6 +85,7 @@ const SubGhzProtocol subghz_protocol_keeloq = {
 
     .decoder = &subghz_protocol_keeloq_decoder,
     .encoder = &subghz_protocol_keeloq_encoder,
+    .timing = &subghz_protocol_keeloq_const,
 };
 
 /** 
@@ -697,6 +698,218 @@ static inline bool subghz_protocol_keeloq_check_decrypt(
     return false;
 }
 
+/** Working set of the manufacture key search, keys and candidates go in batches */
+typedef struct {
+    SubGhzBlockGeneric* instance;
+    uint32_t hop;
+    uint8_t btn;
+    uint16_t end_serial;
+
+    // Keys of the current chunk and keys derived from them
+    size_t chunk_size;
+    size_t chunk_index[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_key[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_key_rev[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_normal[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_normal_rev[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_secure[KEELOQ_BATCH_SIZE];
+    uint64_t chunk_secure_rev[KEELOQ_BATCH_SIZE];
+
+    // Man keys waiting to decrypt hop, in the order they must be tried
+    size_t candidate_count;
+    uint64_t candidate_man[KEELOQ_BATCH_SIZE];
+    size_t candidate_key_index[KEELOQ_BATCH_SIZE];
+    uint8_t candidate_kl_type[KEELOQ_BATCH_SIZE];
+
+    // Result
+    size_t match_key_index;
+    uint8_t match_kl_type;
+} SubGhzKeeloqSelector;
+
+/** 
+ * Decrypt hop with all pending candidates and check them in order
+ * @param selector Pointer to a SubGhzKeeloqSelector instance
+ * @return true if one of the candidates matches
+ */
+static bool subghz_protocol_keeloq_selector_flush(SubGhzKeeloqSelector* selector) {
+    uint32_t decrypt[KEELOQ_BATCH_SIZE];
+    subghz_protocol_keeloq_common_decrypt_batch(
+        selector->hop, selector->candidate_man, decrypt, selector->candidate_count);
+
+    bool found = false;
+    for(size_t i = 0; i < selector->candidate_count; i++) {
+        if(subghz_protocol_keeloq_check_decrypt(
+               selector->instance, decrypt[i], selector->btn, selector->end_serial)) {
+            selector->match_key_index = selector->candidate_key_index[i];
+            selector->match_kl_type = selector->candidate_kl_type[i];
+            found = true;
+            break;
+        }
+    }
+    selector->candidate_count = 0;
+
+    return found;
+}
+
+/** 
+ * Queue man key for check
+ * @param selector Pointer to a SubGhzKeeloqSelector instance
+ * @param man Man key to decrypt hop with
+ * @param chunk_pos Position of source key in the current chunk
+ * @param kl_type Learning type to remember in keystore on match, 0 to keep
+ * @return true if queued candidates were checked and one of them matches
+ */
+static bool subghz_protocol_keeloq_selector_add(
+    SubGhzKeeloqSelector* selector,
+    uint64_t man,
+    size_t chunk_pos,
+    uint8_t kl_type) {
+    size_t candidate = selector->candidate_count++;
+    selector->candidate_man[candidate] = man;
+    selector->candidate_key_index[candidate] = selector->chunk_index[chunk_pos];
+    selector->candidate_kl_type[candidate] = kl_type;
+
+    if(selector->candidate_count == KEELOQ_BATCH_SIZE) {
+        return subghz_protocol_keeloq_selector_flush(selector);
+    }
+    return false;
+}
+
+static uint64_t subghz_protocol_keeloq_mirror_key(uint64_t key) {
+    uint64_t man_rev = 0;
+    uint64_t man_rev_byte = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev_byte = (uint8_t)(key >> i);
+        man_rev = man_rev | man_rev_byte << (56 - i);
+    }
+    return man_rev;
+}
+
+/** 
+ * Queue man keys for every key of the current chunk
+ * Order of keys and learning types is the same as in one by one search
+ * @param selector Pointer to a SubGhzKeeloqSelector instance
+ * @param index Keystore index
+ * @param fix Fix part of the parcel
+ * @return true on successful search
+ */
+static bool subghz_protocol_keeloq_selector_process_chunk(
+    SubGhzKeeloqSelector* selector,
+    const SubGhzKeystoreIndex* index,
+    uint32_t fix) {
+    bool need_normal = false;
+    bool need_secure = false;
+    bool need_rev = false;
+
+    for(size_t i = 0; i < selector->chunk_size; i++) {
+        uint8_t type = index->type[selector->chunk_index[i]];
+        need_normal |= (type == KEELOQ_LEARNING_NORMAL) || (type == KEELOQ_LEARNING_UNKNOWN);
+        need_secure |= (type == KEELOQ_LEARNING_SECURE) || (type == KEELOQ_LEARNING_UNKNOWN);
+        need_rev |= (type == KEELOQ_LEARNING_UNKNOWN);
+        if(type == KEELOQ_LEARNING_UNKNOWN) {
+            selector->chunk_key_rev[i] = subghz_protocol_keeloq_mirror_key(selector->chunk_key[i]);
+        } else {
+            selector->chunk_key_rev[i] = 0;
+        }
+    }
+
+    // Derive learning keys for the whole chunk at once
+    if(need_normal) {
+        subghz_protocol_keeloq_common_normal_learning_batch(
+            fix, selector->chunk_key, selector->chunk_normal, selector->chunk_size);
+    }
+    if(need_secure) {
+        subghz_protocol_keeloq_common_secure_learning_batch(
+            fix,
+            selector->instance->seed,
+            selector->chunk_key,
+            selector->chunk_secure,
+            selector->chunk_size);
+    }
+    if(need_rev) {
+        subghz_protocol_keeloq_common_normal_learning_batch(
+            fix, selector->chunk_key_rev, selector->chunk_normal_rev, selector->chunk_size);
+        subghz_protocol_keeloq_common_secure_learning_batch(
+            fix,
+            selector->instance->seed,
+            selector->chunk_key_rev,
+            selector->chunk_secure_rev,
+            selector->chunk_size);
+    }
+
+    for(size_t i = 0; i < selector->chunk_size; i++) {
+        uint64_t key = selector->chunk_key[i];
+        uint64_t key_rev = selector->chunk_key_rev[i];
+        bool found = false;
+
+        switch(index->type[selector->chunk_index[i]]) {
+        case KEELOQ_LEARNING_SIMPLE:
+            found = subghz_protocol_keeloq_selector_add(selector, key, i, 0);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+            found = subghz_protocol_keeloq_selector_add(selector, selector->chunk_normal[i], i, 0);
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            found = subghz_protocol_keeloq_selector_add(selector, selector->chunk_secure[i], i, 0);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            found = subghz_protocol_keeloq_selector_add(
+                selector, subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key), i, 0);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+            found = subghz_protocol_keeloq_selector_add(
+                selector,
+                subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key),
+                i,
+                0);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+            found = subghz_protocol_keeloq_selector_add(
+                selector,
+                subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key),
+                i,
+                0);
+            break;
+        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+            found = subghz_protocol_keeloq_selector_add(
+                selector,
+                subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key),
+                i,
+                0);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            // Simple Learning, then each learning with mirrored man
+            found =
+                subghz_protocol_keeloq_selector_add(selector, key, i, 1) ||
+                subghz_protocol_keeloq_selector_add(selector, key_rev, i, 1) ||
+                subghz_protocol_keeloq_selector_add(selector, selector->chunk_normal[i], i, 2) ||
+                subghz_protocol_keeloq_selector_add(
+                    selector, selector->chunk_normal_rev[i], i, 2) ||
+                subghz_protocol_keeloq_selector_add(selector, selector->chunk_secure[i], i, 3) ||
+                subghz_protocol_keeloq_selector_add(
+                    selector, selector->chunk_secure_rev[i], i, 3) ||
+                subghz_protocol_keeloq_selector_add(
+                    selector,
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key),
+                    i,
+                    4) ||
+                subghz_protocol_keeloq_selector_add(
+                    selector,
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key_rev),
+                    i,
+                    4);
+            break;
+        }
+
+        if(found) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -712,204 +925,71 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t hop,
     SubGhzKeystore* keystore,
     const char** manufacture_name) {
-    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
-    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
-    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
-
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
-    bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
     //     mfname = "";
     // }
 
     const char* mfname = keystore->mfname;
+    bool mf_not_set = false;
+    uint16_t mf_name_id = 0;
 
     if(strcmp(mfname, "Unknown") == 0) {
         return 1;
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
 
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    const SubGhzKeystoreIndex* index = subghz_keystore_get_index(keystore);
+    bool found = false;
+
+    if(mf_not_set || subghz_keystore_find_name_id(keystore, mfname, &mf_name_id)) {
+        SubGhzKeeloqSelector* selector = malloc(sizeof(SubGhzKeeloqSelector));
+        selector->instance = instance;
+        selector->hop = hop;
+        // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
+        // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
+        // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
+        selector->end_serial = (uint16_t)(fix & 0xFF);
+        selector->btn = (uint8_t)(fix >> 28);
+        selector->candidate_count = 0;
+
+        size_t key_index = 0;
+        while(!found && key_index < index->count) {
+            selector->chunk_size = 0;
+            while(selector->chunk_size < KEELOQ_BATCH_SIZE && key_index < index->count) {
+                if(mf_not_set || index->name_id[key_index] == mf_name_id) {
+                    selector->chunk_index[selector->chunk_size] = key_index;
+                    selector->chunk_key[selector->chunk_size] = index->key[key_index];
+                    selector->chunk_size++;
+                }
+                key_index++;
+            }
+            found = subghz_protocol_keeloq_selector_process_chunk(selector, index, fix);
+        }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+        if(!found && selector->candidate_count > 0) {
+            found = subghz_protocol_keeloq_selector_flush(selector);
+        }
 
-                    break;
-                }
+        if(found) {
+            *manufacture_name = index->name[index->name_id[selector->match_key_index]];
+            keystore->mfname = *manufacture_name;
+            if(selector->match_kl_type) {
+                keystore->kl_type = selector->match_kl_type;
             }
         }
 
-    *manufacture_name = "Unknown";
-    keystore->mfname = "Unknown";
-    instance->cnt = 0;
+        free(selector);
+    }
+
+    if(!found) {
+        *manufacture_name = "Unknown";
+        keystore->mfname = "Unknown";
+        instance->cnt = 0;
+    }
 
-    return 0;
+    return found;
 }
 
 static void subghz_protocol_keeloq_check_remote_controller(
@@ -35,6 +35,75 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+/** In place transpose of 32x32 bit matrix: bit j of word i goes to bit i of word j
+ * @param matrix - 32 words
+ */
+static void subghz_protocol_keeloq_common_transpose(uint32_t* matrix) {
+    uint32_t mask = 0x0000FFFF;
+    for(size_t width = 16; width != 0; width >>= 1, mask ^= mask << width) {
+        for(size_t i = 0; i < 32; i = (i + width + 1) & ~width) {
+            uint32_t swap = ((matrix[i] >> width) ^ matrix[i + width]) & mask;
+            matrix[i + width] ^= swap;
+            matrix[i] ^= swap << width;
+        }
+    }
+}
+
+/** Simple Learning Decrypt of the same data with up to 32 keys at once
+ * Each state bit is a 32-bit word holding that bit for all keys,
+ * so one round of the cipher advances every key.
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - 0xBSSSCCCC for each key, count items
+ * @param count - number of keys, up to KEELOQ_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count) {
+    furi_assert(count <= KEELOQ_BATCH_SIZE);
+
+    // Key bit n of every lane, 0-31 and 32-63
+    uint32_t key_bits[2][32] = {0};
+    for(size_t lane = 0; lane < count; lane++) {
+        key_bits[0][lane] = (uint32_t)keys[lane];
+        key_bits[1][lane] = (uint32_t)(keys[lane] >> 32);
+    }
+    subghz_protocol_keeloq_common_transpose(key_bits[0]);
+    subghz_protocol_keeloq_common_transpose(key_bits[1]);
+
+    // Ring of state bits, bit n lives in state[(head + n) & 31]
+    uint32_t state[32];
+    for(size_t i = 0; i < 32; i++) {
+        state[i] = bit(data, i) ? 0xFFFFFFFF : 0;
+    }
+
+    size_t head = 0;
+    for(size_t r = 0; r < 528; r++) {
+        uint32_t key_bit = key_bits[((15 - r) >> 5) & 1][(15 - r) & 31];
+        uint32_t a = state[head];
+        uint32_t b = state[(head + 8) & 31];
+        uint32_t c = state[(head + 19) & 31];
+        uint32_t d = state[(head + 25) & 31];
+        uint32_t e = state[(head + 30) & 31];
+        // KEELOQ_NLF in algebraic normal form
+        uint32_t nlf = a ^ b ^ (a & b) ^ (b & c) ^ (a & d) ^ (c & d) ^ (a & e) ^ (a & b & e) ^
+                       (c & e) ^ (a & c & e) ^ (b & d & e) ^ (c & d & e);
+        uint32_t feedback = state[(head + 31) & 31] ^ state[(head + 15) & 31] ^ key_bit ^ nlf;
+        // Shift left: old bit 31 slot becomes new bit 0
+        head = (head - 1) & 31;
+        state[head] = feedback;
+    }
+
+    uint32_t output[32];
+    for(size_t i = 0; i < 32; i++) {
+        output[i] = state[(head + i) & 31];
+    }
+    subghz_protocol_keeloq_common_transpose(output);
+    memcpy(result, output, sizeof(uint32_t) * count);
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -54,6 +123,23 @@ inline uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, con
     return ((uint64_t)k2 << 32) | k1; // key - shifrovanoya
 }
 
+void subghz_protocol_keeloq_common_normal_learning_batch(
+    uint32_t data,
+    const uint64_t* keys,
+    uint64_t* result,
+    size_t count) {
+    uint32_t k1[KEELOQ_BATCH_SIZE];
+    uint32_t k2[KEELOQ_BATCH_SIZE];
+
+    data &= 0x0FFFFFFF;
+    subghz_protocol_keeloq_common_decrypt_batch(data | 0x20000000, keys, k1, count);
+    subghz_protocol_keeloq_common_decrypt_batch(data | 0x60000000, keys, k2, count);
+
+    for(size_t i = 0; i < count; i++) {
+        result[i] = ((uint64_t)k2[i] << 32) | k1[i];
+    }
+}
+
 /** Secure Learning
  * @param data - serial number (28bit)
  * @param seed - seed number (32bit)
@@ -74,6 +160,23 @@ inline uint64_t subghz_protocol_keeloq_common_secure_learning(
     return ((uint64_t)k1 << 32) | k2;
 }
 
+void subghz_protocol_keeloq_common_secure_learning_batch(
+    uint32_t data,
+    uint32_t seed,
+    const uint64_t* keys,
+    uint64_t* result,
+    size_t count) {
+    uint32_t k1[KEELOQ_BATCH_SIZE];
+    uint32_t k2[KEELOQ_BATCH_SIZE];
+
+    subghz_protocol_keeloq_common_decrypt_batch(data & 0x0FFFFFFF, keys, k1, count);
+    subghz_protocol_keeloq_common_decrypt_batch(seed, keys, k2, count);
+
+    for(size_t i = 0; i < count; i++) {
+        result[i] = ((uint64_t)k1[i] << 32) | k2[i];
+    }
+}
+
 /** Magic_xor_type1 Learning
  * @param data - serial number (28bit)
  * @param xor - magic xor (64bit)
@@ -12,6 +12,11 @@
  */
 #define KEELOQ_NLF 0x3A5C742E
 
+/*
+ * Number of keys processed by batch functions in one pass, one bit of 32-bit word per key
+ */
+#define KEELOQ_BATCH_SIZE 32u
+
 /*
  * KeeLoq learning types
  * https://phreakerclub.com/forum/showthread.php?t=67
@@ -42,6 +47,19 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/** 
+ * Simple Learning Decrypt of the same data with up to KEELOQ_BATCH_SIZE keys at once, bitsliced
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - 0xBSSSCCCC for each key, count items
+ * @param count - number of keys, up to KEELOQ_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* result,
+    size_t count);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
@@ -50,6 +68,19 @@ uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64
  */
 uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, const uint64_t key);
 
+/** 
+ * Normal Learning for up to KEELOQ_BATCH_SIZE keys at once
+ * @param data - serial number (28bit)
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - manufacture for this serial number (64bit) for each key, count items
+ * @param count - number of keys, up to KEELOQ_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_normal_learning_batch(
+    uint32_t data,
+    const uint64_t* keys,
+    uint64_t* result,
+    size_t count);
+
 /** 
  * Secure Learning
  * @param data - serial number (28bit)
@@ -60,6 +91,21 @@ uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, const uint
 uint64_t
     subghz_protocol_keeloq_common_secure_learning(uint32_t data, uint32_t seed, const uint64_t key);
 
+/** 
+ * Secure Learning for up to KEELOQ_BATCH_SIZE keys at once
+ * @param data - serial number (28bit)
+ * @param seed - seed number (32bit)
+ * @param keys - manufacture keys (64bit), count items
+ * @param result - manufacture for this serial number (64bit) for each key, count items
+ * @param count - number of keys, up to KEELOQ_BATCH_SIZE
+ */
+void subghz_protocol_keeloq_common_secure_learning_batch(
+    uint32_t data,
+    uint32_t seed,
+    const uint64_t* keys,
+    uint64_t* result,
+    size_t count);
+
 /** 
  * Magic_xor_type1 Learning
  * @param data - serial number (28bit)
@@ -67,6 +67,7 @@ const SubGhzProtocol subghz_protocol_kia = {
 
     .decoder = &subghz_protocol_kia_decoder,
     .encoder = &subghz_protocol_kia_encoder,
+    .timing = &subghz_protocol_kia_const,
 };
 
 void* subghz_protocol_decoder_kia_alloc(SubGhzEnvironment* environment) {
@@ -73,6 +73,7 @@ const SubGhzProtocol subghz_protocol_kinggates_stylo_4k = {
 
     .decoder = &subghz_protocol_kinggates_stylo_4k_decoder,
     .encoder = &subghz_protocol_kinggates_stylo_4k_encoder,
+    .timing = &subghz_protocol_kinggates_stylo_4k_const,
 };
 
 //
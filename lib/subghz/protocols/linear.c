@@ -62,6 +62,7 @@ const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
     .deserialize = subghz_protocol_encoder_linear_deserialize,
     .stop = subghz_protocol_encoder_linear_stop,
     .yield = subghz_protocol_encoder_linear_yield,
+    .set_key = subghz_protocol_encoder_linear_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_linear = {
@@ -72,6 +73,7 @@ const SubGhzProtocol subghz_protocol_linear = {
 
     .decoder = &subghz_protocol_linear_decoder,
     .encoder = &subghz_protocol_linear_encoder,
+    .timing = &subghz_protocol_linear_const,
 };
 
 void* subghz_protocol_encoder_linear_alloc(SubGhzEnvironment* environment) {
@@ -174,6 +176,32 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_linear_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderLinear* instance = context;
+    UNUSED(te);
+    if(bits != subghz_protocol_linear_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_linear_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_linear_stop(void* context) {
     SubGhzProtocolEncoderLinear* instance = context;
     instance->encoder.is_running = false;
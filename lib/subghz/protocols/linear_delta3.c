@@ -63,6 +63,7 @@ const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder = {
     .deserialize = subghz_protocol_encoder_linear_delta3_deserialize,
     .stop = subghz_protocol_encoder_linear_delta3_stop,
     .yield = subghz_protocol_encoder_linear_delta3_yield,
+    .set_key = subghz_protocol_encoder_linear_delta3_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_linear_delta3 = {
@@ -73,6 +74,7 @@ const SubGhzProtocol subghz_protocol_linear_delta3 = {
 
     .decoder = &subghz_protocol_linear_delta3_decoder,
     .encoder = &subghz_protocol_linear_delta3_encoder,
+    .timing = &subghz_protocol_linear_delta3_const,
 };
 
 void* subghz_protocol_encoder_linear_delta3_alloc(SubGhzEnvironment* environment) {
@@ -178,6 +180,32 @@ SubGhzProtocolStatus subghz_protocol_encoder_linear_delta3_deserialize(
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_linear_delta3_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderLinearDelta3* instance = context;
+    UNUSED(te);
+    if(bits != subghz_protocol_linear_delta3_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_linear_delta3_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_linear_delta3_stop(void* context) {
     SubGhzProtocolEncoderLinearDelta3* instance = context;
     instance->encoder.is_running = false;
@@ -68,6 +68,7 @@ const SubGhzProtocol subghz_protocol_magellan = {
 
     .decoder = &subghz_protocol_magellan_decoder,
     .encoder = &subghz_protocol_magellan_encoder,
+    .timing = &subghz_protocol_magellan_const,
 };
 
 void* subghz_protocol_encoder_magellan_alloc(SubGhzEnvironment* environment) {
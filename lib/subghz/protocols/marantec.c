@@ -68,6 +68,7 @@ const SubGhzProtocol subghz_protocol_marantec = {
 
     .decoder = &subghz_protocol_marantec_decoder,
     .encoder = &subghz_protocol_marantec_encoder,
+    .timing = &subghz_protocol_marantec_const,
 };
 
 void* subghz_protocol_encoder_marantec_alloc(SubGhzEnvironment* environment) {
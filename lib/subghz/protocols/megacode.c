@@ -78,6 +78,7 @@ const SubGhzProtocol subghz_protocol_megacode = {
 
     .decoder = &subghz_protocol_megacode_decoder,
     .encoder = &subghz_protocol_megacode_encoder,
+    .timing = &subghz_protocol_megacode_const,
 };
 
 void* subghz_protocol_encoder_megacode_alloc(SubGhzEnvironment* environment) {
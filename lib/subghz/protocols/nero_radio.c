@@ -68,6 +68,7 @@ const SubGhzProtocol subghz_protocol_nero_radio = {
 
     .decoder = &subghz_protocol_nero_radio_decoder,
     .encoder = &subghz_protocol_nero_radio_encoder,
+    .timing = &subghz_protocol_nero_radio_const,
 };
 
 void* subghz_protocol_encoder_nero_radio_alloc(SubGhzEnvironment* environment) {
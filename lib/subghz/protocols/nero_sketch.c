@@ -67,6 +67,7 @@ const SubGhzProtocol subghz_protocol_nero_sketch = {
 
     .decoder = &subghz_protocol_nero_sketch_decoder,
     .encoder = &subghz_protocol_nero_sketch_encoder,
+    .timing = &subghz_protocol_nero_sketch_const,
 };
 
 void* subghz_protocol_encoder_nero_sketch_alloc(SubGhzEnvironment* environment) {
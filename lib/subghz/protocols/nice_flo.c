@@ -55,6 +55,7 @@ const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
     .deserialize = subghz_protocol_encoder_nice_flo_deserialize,
     .stop = subghz_protocol_encoder_nice_flo_stop,
     .yield = subghz_protocol_encoder_nice_flo_yield,
+    .set_key = subghz_protocol_encoder_nice_flo_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_nice_flo = {
@@ -66,6 +67,7 @@ const SubGhzProtocol subghz_protocol_nice_flo = {
 
     .decoder = &subghz_protocol_nice_flo_decoder,
     .encoder = &subghz_protocol_nice_flo_encoder,
+    .timing = &subghz_protocol_nice_flo_const,
 };
 
 void* subghz_protocol_encoder_nice_flo_alloc(SubGhzEnvironment* environment) {
@@ -161,6 +163,33 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_nice_flo_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderNiceFlo* instance = context;
+    UNUSED(te);
+    if((bits < subghz_protocol_nice_flo_const.min_count_bit_for_found) ||
+       (bits > 2 * subghz_protocol_nice_flo_const.min_count_bit_for_found)) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_nice_flo_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_nice_flo_stop(void* context) {
     SubGhzProtocolEncoderNiceFlo* instance = context;
     instance->encoder.is_running = false;
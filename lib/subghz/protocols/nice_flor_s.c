@@ -84,6 +84,7 @@ const SubGhzProtocol subghz_protocol_nice_flor_s = {
 
     .decoder = &subghz_protocol_nice_flor_s_decoder,
     .encoder = &subghz_protocol_nice_flor_s_encoder,
+    .timing = &subghz_protocol_nice_flor_s_const,
 };
 
 static void subghz_protocol_nice_flor_s_remote_controller(
@@ -68,6 +68,7 @@ const SubGhzProtocol subghz_protocol_phoenix_v2 = {
 
     .decoder = &subghz_protocol_phoenix_v2_decoder,
     .encoder = &subghz_protocol_phoenix_v2_encoder,
+    .timing = &subghz_protocol_phoenix_v2_const,
 };
 
 void* subghz_protocol_encoder_phoenix_v2_alloc(SubGhzEnvironment* environment) {
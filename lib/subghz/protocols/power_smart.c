@@ -75,6 +75,7 @@ const SubGhzProtocol subghz_protocol_power_smart = {
 
     .decoder = &subghz_protocol_power_smart_decoder,
     .encoder = &subghz_protocol_power_smart_encoder,
+    .timing = &subghz_protocol_power_smart_const,
 };
 
 void* subghz_protocol_encoder_power_smart_alloc(SubGhzEnvironment* environment) {
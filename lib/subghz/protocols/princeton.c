@@ -66,6 +66,7 @@ const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
     .deserialize = subghz_protocol_encoder_princeton_deserialize,
     .stop = subghz_protocol_encoder_princeton_stop,
     .yield = subghz_protocol_encoder_princeton_yield,
+    .set_key = subghz_protocol_encoder_princeton_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_princeton = {
@@ -77,6 +78,7 @@ const SubGhzProtocol subghz_protocol_princeton = {
 
     .decoder = &subghz_protocol_princeton_decoder,
     .encoder = &subghz_protocol_princeton_encoder,
+    .timing = &subghz_protocol_princeton_const,
 };
 
 void* subghz_protocol_encoder_princeton_alloc(SubGhzEnvironment* environment) {
@@ -178,6 +180,36 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_princeton_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderPrinceton* instance = context;
+    if(te == 0) {
+        FURI_LOG_E(TAG, "Missing TE");
+        return SubGhzProtocolStatusErrorParserTe;
+    }
+    if(bits != subghz_protocol_princeton_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->te = te;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_princeton_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_princeton_stop(void* context) {
     SubGhzProtocolEncoderPrinceton* instance = context;
     instance->encoder.is_running = false;
@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_binary.h"
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
@@ -10,6 +11,7 @@
 
 #include <flipper_format/flipper_format_i.h>
 #include <lib/toolbox/stream/stream.h>
+#include <lib/toolbox/stream/file_stream.h>
 
 #define TAG "SubGhzProtocolRAW"
 #define SUBGHZ_DOWNLOAD_MAX_SIZE 512
@@ -33,6 +35,10 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+
+    bool binary;
+    uint8_t* binary_block;
+    SubGhzRawBinaryEnd binary_end;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -156,6 +162,19 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->binary) {
+            if(!flipper_format_write_string_cstr(
+                   instance->flipper_file,
+                   SUBGHZ_RAW_BINARY_FORMAT_KEY,
+                   SUBGHZ_RAW_BINARY_FORMAT_VALUE)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_FORMAT_KEY);
+                break;
+            }
+            instance->binary_block =
+                malloc(sizeof(SubGhzRawBinaryBlockHeader) + SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX);
+            subghz_raw_binary_end_reset(&instance->binary_end);
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -169,13 +188,44 @@ bool subghz_protocol_raw_save_to_file_init(
     return init;
 }
 
+static bool subghz_protocol_raw_write_binary_block(
+    Stream* stream,
+    SubGhzRawBinaryEnd* end,
+    uint8_t* block,
+    const int32_t* samples,
+    size_t count) {
+    size_t size = subghz_raw_binary_block_encode(samples, count, block);
+    if(stream_write(stream, block, size) != size) {
+        return false;
+    }
+    subghz_raw_binary_end_add(end, count);
+    return true;
+}
+
+static bool subghz_protocol_raw_write_binary_end(Stream* stream, const SubGhzRawBinaryEnd* end) {
+    return stream_write(stream, (const uint8_t*)end, sizeof(SubGhzRawBinaryEnd)) ==
+           sizeof(SubGhzRawBinaryEnd);
+}
+
 static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* instance) {
     furi_assert(instance);
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        bool written = false;
+        if(instance->binary) {
+            written = subghz_protocol_raw_write_binary_block(
+                flipper_format_get_raw_stream(instance->flipper_file),
+                &instance->binary_end,
+                instance->binary_block,
+                instance->upload_raw,
+                instance->ind_write);
+        } else {
+            written = flipper_format_write_int32(
+                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write);
+        }
+
+        if(!written) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -191,6 +241,16 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
 
     if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
         subghz_protocol_raw_save_to_file_write(instance);
+    if(instance->file_is_open == RAWFileIsOpenWrite && instance->binary) {
+        if(!subghz_protocol_raw_write_binary_end(
+               flipper_format_get_raw_stream(instance->flipper_file), &instance->binary_end)) {
+            FURI_LOG_E(TAG, "Unable to add end record");
+        }
+    }
+    if(instance->binary_block) {
+        free(instance->binary_block);
+        instance->binary_block = NULL;
+    }
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
@@ -210,6 +270,11 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary) {
+    furi_assert(instance);
+    instance->binary = binary;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     return instance->sample_write + instance->ind_write;
 }
@@ -380,3 +445,166 @@ LevelDuration subghz_protocol_encoder_raw_yield(void* context) {
     if(!instance->is_running) return level_duration_reset();
     return subghz_file_encoder_worker_get_level_duration(instance->file_worker_encoder);
 }
+
+static bool subghz_protocol_raw_convert_to_binary(Stream* src, Stream* dst, FuriString* line) {
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX * sizeof(int32_t));
+    uint8_t* block =
+        malloc(sizeof(SubGhzRawBinaryBlockHeader) + SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX);
+    SubGhzRawBinaryEnd binary_end;
+    subghz_raw_binary_end_reset(&binary_end);
+
+    bool result = stream_write_format(
+                      dst,
+                      "%s: %s\n",
+                      SUBGHZ_RAW_BINARY_FORMAT_KEY,
+                      SUBGHZ_RAW_BINARY_FORMAT_VALUE) > 0;
+
+    // Current line is the first RAW_Data line, one block per line keeps layout on way back
+    while(result) {
+        const char* data = furi_string_get_cstr(line);
+        if(strncmp(data, "RAW_Data:", 9) != 0) break;
+        data += 9;
+
+        size_t count = 0;
+        while(result) {
+            char* end = NULL;
+            long value = strtol(data, &end, 10);
+            if(end == data) break;
+            data = end;
+            // Out of zigzag varint range, never produced by recorder
+            if(value > SUBGHZ_RAW_BINARY_SAMPLE_ABS_MAX ||
+               value < -SUBGHZ_RAW_BINARY_SAMPLE_ABS_MAX) {
+                FURI_LOG_E(TAG, "Sample out of range: %ld", value);
+                result = false;
+                break;
+            }
+            samples[count++] = value;
+            if(count == SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX) {
+                result = subghz_protocol_raw_write_binary_block(
+                    dst, &binary_end, block, samples, count);
+                count = 0;
+            }
+        }
+        if(result && count) {
+            result = subghz_protocol_raw_write_binary_block(
+                dst, &binary_end, block, samples, count);
+        }
+
+        if(!stream_read_line(src, line)) break;
+    }
+
+    if(result) {
+        result = subghz_protocol_raw_write_binary_end(dst, &binary_end);
+    }
+
+    free(block);
+    free(samples);
+    return result;
+}
+
+static bool subghz_protocol_raw_convert_to_text(Stream* src, Stream* dst) {
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX * sizeof(int32_t));
+    uint8_t* payload = malloc(SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX);
+    FuriString* line = furi_string_alloc();
+
+    bool result = true;
+    uint32_t sample_count = 0;
+    while(result) {
+        SubGhzRawBinaryBlockHeader header;
+        size_t size = stream_read(src, (uint8_t*)&header, sizeof(header));
+        // Recording without end record ends right after last block
+        if(size == 0) break;
+        if(size == sizeof(header) && header.magic == SUBGHZ_RAW_BINARY_END_MAGIC) {
+            SubGhzRawBinaryEnd end;
+            stream_seek(src, -(int32_t)sizeof(header), StreamOffsetFromCurrent);
+            result = stream_read(src, (uint8_t*)&end, sizeof(end)) == sizeof(end) &&
+                     end.sample_count == sample_count;
+            break;
+        }
+
+        result = size == sizeof(header) && subghz_raw_binary_block_header_is_valid(&header) &&
+                 stream_read(src, payload, header.payload_size) == header.payload_size &&
+                 subghz_raw_binary_block_decode(&header, payload, samples);
+        if(!result || !header.sample_count) continue;
+
+        furi_string_set(line, "RAW_Data:");
+        for(size_t i = 0; i < header.sample_count; i++) {
+            furi_string_cat_printf(line, " %ld", samples[i]);
+        }
+        furi_string_push_back(line, '\n');
+        result = stream_write_string(dst, line) == furi_string_size(line);
+        sample_count += header.sample_count;
+    }
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Broken binary data at sample %lu", sample_count);
+    }
+
+    furi_string_free(line);
+    free(payload);
+    free(samples);
+    return result;
+}
+
+bool subghz_protocol_raw_convert_file(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    bool binary) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(dst_path);
+
+    Stream* src = file_stream_alloc(storage);
+    Stream* dst = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    bool result = false;
+    bool dst_created = false;
+
+    do {
+        if(!strcmp(src_path, dst_path)) {
+            FURI_LOG_E(TAG, "Can't convert file in place");
+            break;
+        }
+        if(!file_stream_open(src, src_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Unable to open %s", src_path);
+            break;
+        }
+        if(!file_stream_open(dst, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open %s", dst_path);
+            break;
+        }
+        dst_created = true;
+
+        // Header lines are copied as is, up to the first data line
+        bool is_text = false;
+        bool is_binary = false;
+        while(stream_read_line(src, line)) {
+            is_text = furi_string_start_with_str(line, "RAW_Data:");
+            is_binary = furi_string_start_with_str(line, SUBGHZ_RAW_BINARY_FORMAT_KEY ":");
+            if(is_text || is_binary) break;
+            if(stream_write_string(dst, line) != furi_string_size(line)) break;
+        }
+
+        if(binary && is_text) {
+            result = subghz_protocol_raw_convert_to_binary(src, dst, line);
+        } else if(!binary && is_binary) {
+            result = subghz_protocol_raw_convert_to_text(src, dst);
+        } else {
+            FURI_LOG_E(TAG, "Nothing to convert");
+        }
+    } while(false);
+
+    furi_string_free(line);
+    file_stream_close(dst);
+    file_stream_close(src);
+    stream_free(dst);
+    stream_free(src);
+
+    // Partial output is not a valid recording
+    if(!result && dst_created) {
+        storage_simply_remove(storage, dst_path);
+    }
+
+    return result;
+}
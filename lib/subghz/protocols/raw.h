@@ -35,6 +35,28 @@ bool subghz_protocol_raw_save_to_file_init(
  */
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Write samples as binary RAW_Format blocks, applied on next save_to_file_init
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary true for binary, false for text RAW_Data lines
+ */
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary);
+
+/**
+ * Convert RAW file between text and binary data format, header is kept as is
+ * @param storage Pointer to a Storage instance
+ * @param src_path Source file path
+ * @param dst_path Destination file path, overwritten, removed on failure, must differ from
+ * src_path
+ * @param binary true to convert text to binary, false for binary to text
+ * @return true On success
+ */
+bool subghz_protocol_raw_convert_file(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    bool binary);
+
 /**
  * Get the number of samples received SubGhzProtocolDecoderRAW.
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
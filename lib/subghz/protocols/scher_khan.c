@@ -74,6 +74,7 @@ const SubGhzProtocol subghz_protocol_scher_khan = {
 
     .decoder = &subghz_protocol_scher_khan_decoder,
     .encoder = &subghz_protocol_scher_khan_encoder,
+    .timing = &subghz_protocol_scher_khan_const,
 };
 
 void* subghz_protocol_decoder_scher_khan_alloc(SubGhzEnvironment* environment) {
@@ -89,6 +89,7 @@ const SubGhzProtocol subghz_protocol_secplus_v1 = {
 
     .decoder = &subghz_protocol_secplus_v1_decoder,
     .encoder = &subghz_protocol_secplus_v1_encoder,
+    .timing = &subghz_protocol_secplus_v1_const,
 };
 
 void* subghz_protocol_encoder_secplus_v1_alloc(SubGhzEnvironment* environment) {
@@ -83,6 +83,7 @@ const SubGhzProtocol subghz_protocol_secplus_v2 = {
 
     .decoder = &subghz_protocol_secplus_v2_decoder,
     .encoder = &subghz_protocol_secplus_v2_encoder,
+    .timing = &subghz_protocol_secplus_v2_const,
 };
 
 void* subghz_protocol_encoder_secplus_v2_alloc(SubGhzEnvironment* environment) {
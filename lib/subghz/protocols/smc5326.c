@@ -81,6 +81,7 @@ const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder = {
     .deserialize = subghz_protocol_encoder_smc5326_deserialize,
     .stop = subghz_protocol_encoder_smc5326_stop,
     .yield = subghz_protocol_encoder_smc5326_yield,
+    .set_key = subghz_protocol_encoder_smc5326_set_key,
 };
 
 const SubGhzProtocol subghz_protocol_smc5326 = {
@@ -92,6 +93,7 @@ const SubGhzProtocol subghz_protocol_smc5326 = {
 
     .decoder = &subghz_protocol_smc5326_decoder,
     .encoder = &subghz_protocol_smc5326_encoder,
+    .timing = &subghz_protocol_smc5326_const,
 };
 
 void* subghz_protocol_encoder_smc5326_alloc(SubGhzEnvironment* environment) {
@@ -192,6 +194,36 @@ SubGhzProtocolStatus
     return ret;
 }
 
+SubGhzProtocolStatus subghz_protocol_encoder_smc5326_set_key(
+    void* context,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(context);
+    SubGhzProtocolEncoderSMC5326* instance = context;
+    if(te == 0) {
+        FURI_LOG_E(TAG, "Missing TE");
+        return SubGhzProtocolStatusErrorParserTe;
+    }
+    if(bits != subghz_protocol_smc5326_const.min_count_bit_for_found) {
+        FURI_LOG_E(TAG, "Wrong number of bits in key");
+        return SubGhzProtocolStatusErrorValueBitCount;
+    }
+
+    instance->generic.data = key;
+    instance->generic.data_count_bit = bits;
+    instance->te = te;
+    instance->encoder.repeat = repeat;
+    instance->encoder.front = 0;
+    if(!subghz_protocol_encoder_smc5326_get_upload(instance)) {
+        return SubGhzProtocolStatusErrorEncoderGetUpload;
+    }
+    instance->encoder.is_running = true;
+
+    return SubGhzProtocolStatusOk;
+}
+
 void subghz_protocol_encoder_smc5326_stop(void* context) {
     SubGhzProtocolEncoderSMC5326* instance = context;
     instance->encoder.is_running = false;
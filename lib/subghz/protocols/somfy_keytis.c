@@ -63,6 +63,7 @@ const SubGhzProtocol subghz_protocol_somfy_keytis = {
 
     .decoder = &subghz_protocol_somfy_keytis_decoder,
     .encoder = &subghz_protocol_somfy_keytis_encoder,
+    .timing = &subghz_protocol_somfy_keytis_const,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_somfy_keytis_encoder = {
@@ -73,6 +73,7 @@ const SubGhzProtocol subghz_protocol_somfy_telis = {
 
     .decoder = &subghz_protocol_somfy_telis_decoder,
     .encoder = &subghz_protocol_somfy_telis_encoder,
+    .timing = &subghz_protocol_somfy_telis_const,
 };
 
 void* subghz_protocol_encoder_somfy_telis_alloc(SubGhzEnvironment* environment) {
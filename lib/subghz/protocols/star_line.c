@@ -83,6 +83,7 @@ const SubGhzProtocol subghz_protocol_star_line = {
 
     .decoder = &subghz_protocol_star_line_decoder,
     .encoder = &subghz_protocol_star_line_encoder,
+    .timing = &subghz_protocol_star_line_const,
 };
 
 /** 
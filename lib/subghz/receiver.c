@@ -12,9 +12,29 @@ typedef struct {
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
+/** Decoder that passed the filter, ready to be fed without further checks */
+typedef struct {
+    SubGhzProtocolDecoderBase* base;
+    SubGhzDecoderFeed feed;
+    uint32_t duration_min;
+} SubGhzReceiverActive;
+
+typedef struct {
+    size_t count;
+    SubGhzReceiverActive active[];
+} SubGhzReceiverTable;
+
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
+    bool timing_filter;
+
+    // Dispatch tables, rebuilt on filter change. Setters run on another thread than decode, so
+    // the spare table is built and then published. Decode marks table it walks as in use, so
+    // spare is not rebuilt under it.
+    SubGhzReceiverTable* tables[2];
+    SubGhzReceiverTable* table; /**< published table */
+    SubGhzReceiverTable* table_in_use; /**< table walked by decode, NULL if none */
 
     SubGhzReceiverCallback callback;
     void* context;
@@ -36,6 +56,17 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         }
     }
 
+    instance->filter = 0;
+    instance->timing_filter = false;
+    size_t slots_count = SubGhzReceiverSlotArray_size(instance->slots);
+    size_t table_size = sizeof(SubGhzReceiverTable) + sizeof(SubGhzReceiverActive) * slots_count;
+    for(size_t i = 0; i < COUNT_OF(instance->tables); i++) {
+        instance->tables[i] = malloc(table_size);
+        instance->tables[i]->count = 0;
+    }
+    instance->table = instance->tables[0];
+    instance->table_in_use = NULL;
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -54,20 +85,80 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
             slot->base = NULL;
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    for(size_t i = 0; i < COUNT_OF(instance->tables); i++) {
+        free(instance->tables[i]);
+    }
 
     free(instance);
 }
 
-void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
-    furi_assert(instance);
-    furi_assert(instance->slots);
+static uint32_t subghz_receiver_get_duration_min(const SubGhzProtocol* protocol) {
+    const SubGhzBlockConst* timing = protocol->timing;
+    // Decoders accept up to te_delta * 2 of jitter, anything shorter is a glitch for them
+    if(timing && timing->te_short > timing->te_delta * 2) {
+        return timing->te_short - timing->te_delta * 2;
+    } else {
+        return 0;
+    }
+}
+
+static void subghz_receiver_update_active(SubGhzReceiver* instance) {
+    SubGhzReceiverTable* table = instance->table == instance->tables[0] ? instance->tables[1] :
+                                                                          instance->tables[0];
+    // Decode that loaded spare table before it was replaced may still walk it
+    while(__atomic_load_n(&instance->table_in_use, __ATOMIC_SEQ_CST) == table) {
+        furi_thread_yield();
+    }
+    table->count = 0;
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
+            const SubGhzProtocol* protocol = slot->base->protocol;
+            if((protocol->flag & instance->filter) == 0) {
+                continue;
             }
+
+            SubGhzReceiverActive item = {
+                .base = (SubGhzProtocolDecoderBase*)slot->base,
+                .feed = protocol->decoder->feed,
+                .duration_min =
+                    instance->timing_filter ? subghz_receiver_get_duration_min(protocol) : 0,
+            };
+
+            // Keep table sorted by minimal duration, so every pulse is fed to a prefix of it
+            size_t position = table->count;
+            while(position > 0 && table->active[position - 1].duration_min > item.duration_min) {
+                table->active[position] = table->active[position - 1];
+                position--;
+            }
+            table->active[position] = item;
+            table->count++;
         }
+
+    __atomic_store_n(&instance->table, table, __ATOMIC_SEQ_CST);
+}
+
+void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    furi_assert(instance);
+
+    // Setter reuses a table only after it was replaced, recheck makes mark visible before that
+    SubGhzReceiverTable* table;
+    do {
+        table = __atomic_load_n(&instance->table, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&instance->table_in_use, table, __ATOMIC_SEQ_CST);
+    } while(table != __atomic_load_n(&instance->table, __ATOMIC_SEQ_CST));
+
+    const SubGhzReceiverActive* active = table->active;
+    const size_t active_count = table->count;
+
+    for(size_t i = 0; i < active_count; i++) {
+        if(active[i].duration_min > duration) {
+            break;
+        }
+        active[i].feed(active[i].base, level, duration);
+    }
+
+    __atomic_store_n(&instance->table_in_use, NULL, __ATOMIC_RELEASE);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -106,6 +197,13 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_assert(instance);
     instance->filter = filter;
+    subghz_receiver_update_active(instance);
+}
+
+void subghz_receiver_set_timing_filter(SubGhzReceiver* instance, bool enable) {
+    furi_assert(instance);
+    instance->timing_filter = enable;
+    subghz_receiver_update_active(instance);
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -54,11 +54,22 @@ void subghz_receiver_set_rx_callback(
 
 /**
  * Set the filter of receivers that will work at the moment.
+ * Can be called while another thread decodes, but not concurrently with other setters.
  * @param instance Pointer to a SubGhzReceiver instance
  * @param filter Filter, SubGhzProtocolFlag
  */
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Enable pulse pre-screening by protocol timing.
+ * Pulses shorter than the minimal duration declared by protocol timing are not fed to its decoder.
+ * Disabled by default, every pulse goes to every decoder that passed the filter.
+ * Can be called while another thread decodes, but not concurrently with other setters.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param enable true to skip pulses that can't match protocol timing
+ */
+void subghz_receiver_set_timing_filter(SubGhzReceiver* instance, bool enable);
+
 /**
  * Search for a cattery by his name.
  * @param instance Pointer to a SubGhzReceiver instance
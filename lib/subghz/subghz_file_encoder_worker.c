@@ -1,4 +1,5 @@
 #include "subghz_file_encoder_worker.h"
+#include "subghz_raw_binary.h"
 
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
@@ -22,6 +23,10 @@ struct SubGhzFileEncoderWorker {
     FuriString* str_data;
     FuriString* file_path;
 
+    bool binary;
+    uint8_t* binary_payload;
+    int32_t* binary_samples;
+
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
     void* context_end;
 };
@@ -54,6 +59,20 @@ void subghz_file_encoder_worker_add_level_duration(
     }
 }
 
+static void
+    subghz_file_encoder_worker_add_sample(SubGhzFileEncoderWorker* instance, int32_t duration) {
+    if((duration < -1000000) || (duration > 1000000)) {
+        if(duration > 0) {
+            subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
+        } else {
+            subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
+        }
+        //FURI_LOG_I("PARSE", "Number overflow - %d", duration);
+    } else {
+        subghz_file_encoder_worker_add_level_duration(instance, duration);
+    }
+}
+
 bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
     char* str1;
     int32_t temp_ds = 0;
@@ -75,22 +94,42 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
             str1 += 1;
             //
             temp_ds = atoi(str1);
-            if((temp_ds < -1000000) || (temp_ds > 1000000)) {
-                if(temp_ds > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
-                }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", atoi(str1));
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, temp_ds);
-            }
+            subghz_file_encoder_worker_add_sample(instance, temp_ds);
         }
         res = true;
     }
     return res;
 }
 
+/** Read next binary block
+ *
+ * @param instance SubGhzFileEncoderWorker instance
+ * @param stream file stream positioned at block start
+ * @return false on end of data or broken block
+ */
+static bool
+    subghz_file_encoder_worker_block_parse(SubGhzFileEncoderWorker* instance, Stream* stream) {
+    SubGhzRawBinaryBlockHeader header;
+    if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    if(header.magic == SUBGHZ_RAW_BINARY_END_MAGIC) {
+        return false;
+    }
+    uint8_t* payload = instance->binary_payload;
+    if(!subghz_raw_binary_block_header_is_valid(&header) ||
+       stream_read(stream, payload, header.payload_size) != header.payload_size ||
+       !subghz_raw_binary_block_decode(&header, payload, instance->binary_samples)) {
+        FURI_LOG_E(TAG, "Broken block");
+        return false;
+    }
+
+    for(size_t i = 0; i < header.sample_count; i++) {
+        subghz_file_encoder_worker_add_sample(instance, instance->binary_samples[i]);
+    }
+    return true;
+}
+
 void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
@@ -153,6 +192,17 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        // Optional format line, text RAW_Data otherwise
+        size_t data_start = stream_tell(stream);
+        instance->binary =
+            stream_read_line(stream, instance->str_data) &&
+            furi_string_start_with_str(
+                instance->str_data,
+                SUBGHZ_RAW_BINARY_FORMAT_KEY ": " SUBGHZ_RAW_BINARY_FORMAT_VALUE);
+        if(!instance->binary) {
+            stream_seek(stream, data_start, StreamOffsetFromStart);
+        }
         res = true;
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -161,7 +211,12 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
+            if(instance->binary) {
+                if(!subghz_file_encoder_worker_block_parse(instance, stream)) {
+                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                    break;
+                }
+            } else if(stream_read_line(stream, instance->str_data)) {
                 furi_string_trim(instance->str_data);
                 if(!subghz_file_encoder_worker_data_parse(
                        instance, furi_string_get_cstr(instance->str_data))) {
@@ -209,6 +264,8 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
+    instance->binary_payload = malloc(SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX);
+    instance->binary_samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX * sizeof(int32_t));
     instance->level = false;
     instance->worker_stopping = true;
 
@@ -223,6 +280,8 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
 
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
+    free(instance->binary_payload);
+    free(instance->binary_samples);
 
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
@@ -10,6 +10,8 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 
+#include <m-dict.h>
+
 #define TAG "SubGhzKeystore"
 
 #define FILE_BUFFER_SIZE 64
@@ -22,6 +24,8 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+DICT_DEF2(SubGhzKeystoreNameDict, const char*, M_CSTR_OPLIST, uint16_t, M_DEFAULT_OPLIST)
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
@@ -31,6 +35,7 @@ SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    memset(&instance->index, 0, sizeof(SubGhzKeystoreIndex));
 
     subghz_keystore_reset_kl(instance);
 
@@ -44,9 +49,85 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
     instance->kl_type = 0;
 }
 
+static void subghz_keystore_index_clear(SubGhzKeystoreIndex* index) {
+    free(index->key);
+    free(index->type);
+    free(index->name_id);
+    free(index->name);
+    memset(index, 0, sizeof(SubGhzKeystoreIndex));
+}
+
+static void subghz_keystore_index_build(SubGhzKeystore* instance) {
+    SubGhzKeystoreIndex* index = &instance->index;
+    subghz_keystore_index_clear(index);
+
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(count == 0) {
+        return;
+    }
+
+    index->key = malloc(sizeof(uint64_t) * count);
+    index->type = malloc(sizeof(uint8_t) * count);
+    index->name_id = malloc(sizeof(uint16_t) * count);
+    // Worst case every key has its own name, shrunk below
+    index->name = malloc(sizeof(const char*) * count);
+
+    SubGhzKeystoreNameDict_t name_dict;
+    SubGhzKeystoreNameDict_init(name_dict);
+
+    for
+        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
+            const char* name = furi_string_get_cstr(manufacture_code->name);
+            uint16_t* name_id = SubGhzKeystoreNameDict_get(name_dict, name);
+            if(!name_id) {
+                furi_check(index->name_count <= UINT16_MAX);
+                index->name[index->name_count] = name;
+                SubGhzKeystoreNameDict_set_at(name_dict, name, index->name_count);
+                name_id = SubGhzKeystoreNameDict_get(name_dict, name);
+                index->name_count++;
+            }
+
+            index->key[index->count] = manufacture_code->key;
+            index->type[index->count] = manufacture_code->type;
+            index->name_id[index->count] = *name_id;
+            index->count++;
+        }
+
+    SubGhzKeystoreNameDict_clear(name_dict);
+
+    index->name = realloc(index->name, sizeof(const char*) * index->name_count); //-V701
+
+    FURI_LOG_D(TAG, "Indexed %zu keys, %zu names", index->count, index->name_count);
+}
+
+const SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    if(instance->index.count != SubGhzKeyArray_size(instance->data)) {
+        subghz_keystore_index_build(instance);
+    }
+    return &instance->index;
+}
+
+bool subghz_keystore_find_name_id(SubGhzKeystore* instance, const char* name, uint16_t* name_id) {
+    furi_assert(instance);
+    furi_assert(name);
+    const SubGhzKeystoreIndex* index = subghz_keystore_get_index(instance);
+
+    for(size_t i = 0; i < index->name_count; i++) {
+        // Mfname usually points to a name from this very table
+        if(index->name[i] == name || strcmp(index->name[i], name) == 0) {
+            *name_id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
+    subghz_keystore_index_clear(&instance->index);
+
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
             furi_string_free(manufacture_code->name);
@@ -240,6 +321,8 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
             break;
         }
     } while(0);
+    // Pack keys now, so receiver thread doesn't have to
+    subghz_keystore_get_index(instance);
     flipper_format_free(flipper_format);
 
     furi_record_close(RECORD_STORAGE);
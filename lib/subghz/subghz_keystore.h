@@ -20,6 +20,17 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+/** Packed view of the keystore, one entry per key in load order */
+typedef struct {
+    uint64_t* key; ///< Manufacture keys
+    uint8_t* type; ///< Learning types, KEELOQ_LEARNING_*
+    uint16_t* name_id; ///< Index in name table
+    size_t count;
+
+    const char** name; ///< Interned manufacture names
+    size_t name_count;
+} SubGhzKeystoreIndex;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -54,6 +65,22 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Get packed struct-of-arrays view of the keystore, rebuilt if keys were added since last call
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return const SubGhzKeystoreIndex*
+ */
+const SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance);
+
+/** 
+ * Find interned id of manufacture name
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @param name_id Found id
+ * @return true if name is present in keystore
+ */
+bool subghz_keystore_find_name_id(SubGhzKeystore* instance, const char* name, uint16_t* name_id);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "subghz_keystore.h"
 #include <m-array.h>
 
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    SubGhzKeystoreIndex index;
     const char* mfname;
     uint8_t kl_type;
 };
@@ -0,0 +1,84 @@
+#include "subghz_raw_binary.h"
+#include <toolbox/varint.h>
+#include <string.h>
+
+uint16_t subghz_raw_binary_checksum(const uint8_t* data, size_t size) {
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    while(size) {
+        // Postpone modulo while sums can't overflow
+        size_t chunk = size > 5802 ? 5802 : size;
+        size -= chunk;
+        while(chunk--) {
+            sum1 += *data++;
+            sum2 += sum1;
+        }
+        sum1 %= 255;
+        sum2 %= 255;
+    }
+
+    return (sum2 << 8) | sum1;
+}
+
+size_t subghz_raw_binary_block_encode(const int32_t* samples, size_t count, uint8_t* output) {
+    if(count > SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX) {
+        count = SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX;
+    }
+
+    uint8_t* payload = output + sizeof(SubGhzRawBinaryBlockHeader);
+    size_t payload_size = 0;
+    for(size_t i = 0; i < count; i++) {
+        payload_size += varint_int32_pack(samples[i], &payload[payload_size]);
+    }
+
+    SubGhzRawBinaryBlockHeader header = {
+        .magic = SUBGHZ_RAW_BINARY_BLOCK_MAGIC,
+        .sample_count = count,
+        .payload_size = payload_size,
+        .checksum = subghz_raw_binary_checksum(payload, payload_size),
+    };
+    memcpy(output, &header, sizeof(SubGhzRawBinaryBlockHeader));
+
+    return sizeof(SubGhzRawBinaryBlockHeader) + payload_size;
+}
+
+bool subghz_raw_binary_block_header_is_valid(const SubGhzRawBinaryBlockHeader* header) {
+    return header->magic == SUBGHZ_RAW_BINARY_BLOCK_MAGIC &&
+           header->sample_count <= SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX &&
+           header->payload_size <= SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX &&
+           header->payload_size >= header->sample_count;
+}
+
+bool subghz_raw_binary_block_decode(
+    const SubGhzRawBinaryBlockHeader* header,
+    const uint8_t* payload,
+    int32_t* samples) {
+    if(subghz_raw_binary_checksum(payload, header->payload_size) != header->checksum) {
+        return false;
+    }
+
+    size_t offset = 0;
+    for(size_t i = 0; i < header->sample_count; i++) {
+        size_t left = header->payload_size - offset;
+        if(left == 0) return false;
+        if(left > SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX) left = SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX;
+
+        size_t size = varint_int32_unpack(&samples[i], &payload[offset], left);
+        // Unpack reports one byte more than available on unterminated varint
+        if(size > left) return false;
+        offset += size;
+    }
+
+    return offset == header->payload_size;
+}
+
+void subghz_raw_binary_end_reset(SubGhzRawBinaryEnd* end) {
+    memset(end, 0, sizeof(SubGhzRawBinaryEnd));
+    end->magic = SUBGHZ_RAW_BINARY_END_MAGIC;
+}
+
+void subghz_raw_binary_end_add(SubGhzRawBinaryEnd* end, size_t sample_count) {
+    end->block_count++;
+    end->sample_count += sample_count;
+}
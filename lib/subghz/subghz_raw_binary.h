@@ -0,0 +1,114 @@
+/**
+ * @file subghz_raw_binary.h
+ * SubGhz: compact binary container for RAW recordings
+ *
+ * Binary RAW file keeps usual text header, followed by
+ * "RAW_Format: Binary" line and binary data:
+ *
+ *   block*, end record
+ *
+ * Block is a header with checksum and zigzag varint durations, same signed
+ * durations as in text RAW_Data lines. End record holds block and sample
+ * totals to check that nothing was lost. Files without end record
+ * (interrupted recording) are still readable block by block. Playback is
+ * sequential, so there is no block index. Codec has no platform dependencies
+ * and is used by host benchmark.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_RAW_BINARY_FORMAT_KEY "RAW_Format"
+#define SUBGHZ_RAW_BINARY_FORMAT_VALUE "Binary"
+
+#define SUBGHZ_RAW_BINARY_BLOCK_MAGIC (0x4252U) /**< "RB" */
+#define SUBGHZ_RAW_BINARY_END_MAGIC (0x4552U) /**< "RE" */
+
+#define SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX (512U)
+#define SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX (5U)
+#define SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX \
+    (SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX * SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX)
+/** Largest duration magnitude representable by zigzag varint */
+#define SUBGHZ_RAW_BINARY_SAMPLE_ABS_MAX (0x3FFFFFFFL)
+
+/** Block header, followed by payload_size bytes of varints */
+typedef struct {
+    uint16_t magic;
+    uint16_t sample_count;
+    uint16_t payload_size;
+    uint16_t checksum; /**< Fletcher-16 of payload */
+} __attribute__((packed)) SubGhzRawBinaryBlockHeader;
+
+/** End record, last bytes of binary data */
+typedef struct {
+    uint16_t magic;
+    uint16_t reserved;
+    uint32_t block_count;
+    uint32_t sample_count;
+} __attribute__((packed)) SubGhzRawBinaryEnd;
+
+/** Fletcher-16 checksum
+ *
+ * @param      data  Data
+ * @param      size  Data size
+ *
+ * @return     checksum
+ */
+uint16_t subghz_raw_binary_checksum(const uint8_t* data, size_t size);
+
+/** Encode block
+ *
+ * @param      samples  Signed durations, positive for high level, magnitude up
+ *                      to SUBGHZ_RAW_BINARY_SAMPLE_ABS_MAX
+ * @param      count    Sample count, up to SUBGHZ_RAW_BINARY_BLOCK_SAMPLES_MAX
+ * @param      output   Header and payload output, at least
+ *                      sizeof(SubGhzRawBinaryBlockHeader) +
+ *                      SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX bytes
+ *
+ * @return     block size in bytes
+ */
+size_t subghz_raw_binary_block_encode(const int32_t* samples, size_t count, uint8_t* output);
+
+/** Check block header
+ *
+ * @param      header  Block header
+ *
+ * @return     true if header is a valid block header
+ */
+bool subghz_raw_binary_block_header_is_valid(const SubGhzRawBinaryBlockHeader* header);
+
+/** Decode block payload
+ *
+ * @param      header   Valid block header
+ * @param      payload  Payload, header->payload_size bytes
+ * @param      samples  Output, header->sample_count durations
+ *
+ * @return     true if checksum and varint stream match header
+ */
+bool subghz_raw_binary_block_decode(
+    const SubGhzRawBinaryBlockHeader* header,
+    const uint8_t* payload,
+    int32_t* samples);
+
+/** Reset end record totals
+ *
+ * @param      end   SubGhzRawBinaryEnd instance
+ */
+void subghz_raw_binary_end_reset(SubGhzRawBinaryEnd* end);
+
+/** Account written block in end record totals
+ *
+ * @param      end           SubGhzRawBinaryEnd instance
+ * @param      sample_count  Samples in block
+ */
+void subghz_raw_binary_end_add(SubGhzRawBinaryEnd* end, size_t sample_count);
+
+#ifdef __cplusplus
+}
+#endif
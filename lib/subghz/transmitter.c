@@ -4,9 +4,19 @@
 #include "registry.h"
 #include "protocols/protocol_items.h"
 
+#include <lib/flipper_format/flipper_format_i.h>
+
 struct SubGhzTransmitter {
+    SubGhzEnvironment* environment;
     const SubGhzProtocol* protocol;
     SubGhzProtocolEncoderBase* protocol_instance;
+
+    // Second encoder, upload of the next key is rendered here while current one is sent
+    SubGhzProtocolEncoderBase* next_instance;
+    bool next_queued;
+
+    // Used by protocols without set_key
+    FlipperFormat* key_format;
 };
 
 SubGhzTransmitter*
@@ -20,8 +30,12 @@ SubGhzTransmitter*
 
     if(protocol && protocol->encoder && protocol->encoder->alloc) {
         instance = malloc(sizeof(SubGhzTransmitter));
+        instance->environment = environment;
         instance->protocol = protocol;
         instance->protocol_instance = instance->protocol->encoder->alloc(environment);
+        instance->next_instance = NULL;
+        instance->next_queued = false;
+        instance->key_format = NULL;
     }
     return instance;
 }
@@ -29,6 +43,12 @@ SubGhzTransmitter*
 void subghz_transmitter_free(SubGhzTransmitter* instance) {
     furi_assert(instance);
     instance->protocol->encoder->free(instance->protocol_instance);
+    if(instance->next_instance) {
+        instance->protocol->encoder->free(instance->next_instance);
+    }
+    if(instance->key_format) {
+        flipper_format_free(instance->key_format);
+    }
     free(instance);
 }
 
@@ -40,6 +60,7 @@ SubGhzProtocolEncoderBase* subghz_transmitter_get_protocol_instance(SubGhzTransm
 bool subghz_transmitter_stop(SubGhzTransmitter* instance) {
     furi_assert(instance);
     bool ret = false;
+    __atomic_store_n(&instance->next_queued, false, __ATOMIC_RELEASE);
     if(instance->protocol && instance->protocol->encoder && instance->protocol->encoder->stop) {
         instance->protocol->encoder->stop(instance->protocol_instance);
         ret = true;
@@ -59,7 +80,95 @@ SubGhzProtocolStatus
     return ret;
 }
 
+static SubGhzProtocolStatus subghz_transmitter_set_key_to(
+    SubGhzTransmitter* instance,
+    SubGhzProtocolEncoderBase* protocol_instance,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    const SubGhzProtocolEncoder* encoder = instance->protocol->encoder;
+    if(encoder->set_key) {
+        return encoder->set_key(protocol_instance, key, bits, te, repeat);
+    }
+    if(!encoder->deserialize) {
+        return SubGhzProtocolStatusError;
+    }
+
+    if(!instance->key_format) {
+        instance->key_format = flipper_format_string_alloc();
+    }
+    FlipperFormat* flipper_format = instance->key_format;
+    stream_clean(flipper_format_get_raw_stream(flipper_format));
+
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[sizeof(uint64_t) - i - 1] = (key >> (i * 8)) & 0xFF;
+    }
+    uint32_t bits_value = bits;
+    flipper_format_write_uint32(flipper_format, "Bit", &bits_value, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+    if(te) {
+        flipper_format_write_uint32(flipper_format, "TE", &te, 1);
+    }
+    flipper_format_write_uint32(flipper_format, "Repeat", &repeat, 1);
+    flipper_format_rewind(flipper_format);
+
+    return encoder->deserialize(protocol_instance, flipper_format);
+}
+
+SubGhzProtocolStatus subghz_transmitter_set_key(
+    SubGhzTransmitter* instance,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(instance);
+    __atomic_store_n(&instance->next_queued, false, __ATOMIC_RELEASE);
+    return subghz_transmitter_set_key_to(
+        instance, instance->protocol_instance, key, bits, te, repeat);
+}
+
+SubGhzProtocolStatus subghz_transmitter_queue_key(
+    SubGhzTransmitter* instance,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat) {
+    furi_assert(instance);
+    furi_check(!subghz_transmitter_is_key_queued(instance));
+
+    if(!instance->next_instance) {
+        instance->next_instance = instance->protocol->encoder->alloc(instance->environment);
+    }
+
+    SubGhzProtocolStatus ret =
+        subghz_transmitter_set_key_to(instance, instance->next_instance, key, bits, te, repeat);
+    if(ret == SubGhzProtocolStatusOk) {
+        __atomic_store_n(&instance->next_queued, true, __ATOMIC_RELEASE);
+    }
+    return ret;
+}
+
+bool subghz_transmitter_is_key_queued(SubGhzTransmitter* instance) {
+    furi_assert(instance);
+    return __atomic_load_n(&instance->next_queued, __ATOMIC_ACQUIRE);
+}
+
 LevelDuration subghz_transmitter_yield(void* context) {
     SubGhzTransmitter* instance = context;
-    return instance->protocol->encoder->yield(instance->protocol_instance);
+    LevelDuration ret = instance->protocol->encoder->yield(instance->protocol_instance);
+
+    if(level_duration_is_reset(ret) &&
+       __atomic_load_n(&instance->next_queued, __ATOMIC_ACQUIRE)) {
+        // Current key is done, continue with the queued one without a gap
+        SubGhzProtocolEncoderBase* protocol_instance = instance->protocol_instance;
+        instance->protocol_instance = instance->next_instance;
+        instance->next_instance = protocol_instance;
+        __atomic_store_n(&instance->next_queued, false, __ATOMIC_RELEASE);
+
+        ret = instance->protocol->encoder->yield(instance->protocol_instance);
+    }
+
+    return ret;
 }
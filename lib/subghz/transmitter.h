@@ -44,6 +44,48 @@ bool subghz_transmitter_stop(SubGhzTransmitter* instance);
 SubGhzProtocolStatus
     subghz_transmitter_deserialize(SubGhzTransmitter* instance, FlipperFormat* flipper_format);
 
+/**
+ * Replace key of the protocol and generate an upload to send, FlipperFormat is not involved
+ * for protocols implementing set_key. Must not be called while transmission is in progress.
+ * @param instance Pointer to a SubGhzTransmitter instance
+ * @param key Key data
+ * @param bits Number of bits in key
+ * @param te Bit duration in us for protocols that have it, 0 otherwise
+ * @param repeat Number of times the upload is sent
+ * @return status
+ */
+SubGhzProtocolStatus subghz_transmitter_set_key(
+    SubGhzTransmitter* instance,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat);
+
+/**
+ * Generate an upload for the next key while the current one is being sent. Once the current
+ * upload ends, subghz_transmitter_yield continues with the queued one without a gap.
+ * Only one key can be queued, check subghz_transmitter_is_key_queued before queueing.
+ * @param instance Pointer to a SubGhzTransmitter instance
+ * @param key Key data
+ * @param bits Number of bits in key
+ * @param te Bit duration in us for protocols that have it, 0 otherwise
+ * @param repeat Number of times the upload is sent
+ * @return status
+ */
+SubGhzProtocolStatus subghz_transmitter_queue_key(
+    SubGhzTransmitter* instance,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat);
+
+/**
+ * Check if queued key is not taken by subghz_transmitter_yield yet.
+ * @param instance Pointer to a SubGhzTransmitter instance
+ * @return true if key is queued
+ */
+bool subghz_transmitter_is_key_queued(SubGhzTransmitter* instance);
+
 /**
  * Getting the level and duration of the upload to be loaded into DMA.
  * @param context Pointer to a SubGhzTransmitter instance
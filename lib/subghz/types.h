@@ -8,6 +8,7 @@
 #include <lib/toolbox/level_duration.h>
 
 #include "environment.h"
+#include "blocks/const.h"
 #include <furi.h>
 #include <furi_hal.h>
 
@@ -69,6 +70,12 @@ typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 // Encoder specific
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
+typedef SubGhzProtocolStatus (*SubGhzEncoderSetKey)(
+    void* encoder,
+    uint64_t key,
+    uint16_t bits,
+    uint32_t te,
+    uint32_t repeat);
 
 typedef struct {
     SubGhzAlloc alloc;
@@ -90,6 +97,9 @@ typedef struct {
     SubGhzDeserialize deserialize;
     SubGhzEncoderStop stop;
     SubGhzEncoderYield yield;
+
+    // Optional, replaces key of a static protocol without FlipperFormat round-trip
+    SubGhzEncoderSetKey set_key;
 } SubGhzProtocolEncoder;
 
 typedef enum {
@@ -123,4 +133,7 @@ typedef struct {
 
     const SubGhzProtocolEncoder* encoder;
     const SubGhzProtocolDecoder* decoder;
+
+    // Optional, used by the receiver to skip pulses too short for this protocol
+    const SubGhzBlockConst* timing;
 } SubGhzProtocol;
@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal_flash.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -22,9 +23,38 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+/** Decoded icon cache hash table size, power of 2 */
+#define COMPRESS_ICON_CACHE_BUCKETS (32u)
+
+/** Decodes since last use after which entry may be replaced */
+#define COMPRESS_ICON_CACHE_STALE_DECODES (128u)
+
+/** Free heap below which cache is flushed and not filled */
+#define COMPRESS_ICON_CACHE_HEAP_RESERVE (16384u)
+
+typedef struct CompressIconCacheEntry CompressIconCacheEntry;
+
+struct CompressIconCacheEntry {
+    const uint8_t* icon_data;
+    CompressIconCacheEntry* bucket_next;
+    CompressIconCacheEntry* prev; /**< more recently used */
+    CompressIconCacheEntry* next; /**< less recently used */
+    uint32_t last_used;
+    uint32_t fingerprint; /**< compressed data hash, 0 for data in flash */
+    uint16_t compressed_size;
+    uint16_t size;
+    uint8_t data[];
+};
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+
+    CompressIconCacheEntry* buckets[COMPRESS_ICON_CACHE_BUCKETS];
+    CompressIconCacheEntry* lru_head;
+    CompressIconCacheEntry* lru_tail;
+    uint32_t clock;
+    CompressIconCacheStats stats;
 };
 
 CompressIcon* compress_icon_alloc() {
@@ -35,16 +65,137 @@ CompressIcon* compress_icon_alloc() {
         COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
     heatshrink_decoder_reset(instance->decoder);
     memset(instance->decoded_buff, 0, sizeof(instance->decoded_buff));
+    instance->stats.budget = COMPRESS_ICON_CACHE_BUDGET_DEFAULT;
 
     return instance;
 }
 
 void compress_icon_free(CompressIcon* instance) {
     furi_assert(instance);
+    compress_icon_cache_flush(instance);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
 }
 
+static inline size_t compress_icon_cache_bucket(const uint8_t* icon_data) {
+    uintptr_t key = (uintptr_t)icon_data;
+    return (key ^ (key >> 9)) & (COMPRESS_ICON_CACHE_BUCKETS - 1);
+}
+
+/* Firmware assets never move, anything in RAM (FAP icons, animations
+ * loaded from SD) may be freed and its address reused by other data */
+static uint32_t compress_icon_cache_fingerprint(const uint8_t* icon_data, uint16_t size) {
+    if(icon_data >= (const uint8_t*)furi_hal_flash_get_base() &&
+       icon_data < (const uint8_t*)furi_hal_flash_get_free_start_address()) {
+        return 0;
+    }
+
+    // FNV-1a, 0 is reserved for data in flash
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ icon_data[i]) * 16777619UL;
+    }
+    return hash ? hash : 1;
+}
+
+static void compress_icon_cache_unlink(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    if(entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        instance->lru_head = entry->next;
+    }
+    if(entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        instance->lru_tail = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void compress_icon_cache_push(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    entry->next = instance->lru_head;
+    if(instance->lru_head) {
+        instance->lru_head->prev = entry;
+    } else {
+        instance->lru_tail = entry;
+    }
+    instance->lru_head = entry;
+}
+
+static void compress_icon_cache_remove(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    const size_t bucket = compress_icon_cache_bucket(entry->icon_data);
+    CompressIconCacheEntry** link = &instance->buckets[bucket];
+    while(*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    compress_icon_cache_unlink(instance, entry);
+    instance->stats.size -= sizeof(CompressIconCacheEntry) + entry->size;
+    free(entry);
+}
+
+static CompressIconCacheEntry* compress_icon_cache_find(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    const CompressHeader* header) {
+    CompressIconCacheEntry* entry = instance->buckets[compress_icon_cache_bucket(icon_data)];
+    while(entry && entry->icon_data != icon_data) {
+        entry = entry->bucket_next;
+    }
+
+    if(entry && (entry->compressed_size != header->compressed_buff_size ||
+                 (entry->fingerprint &&
+                  entry->fingerprint != compress_icon_cache_fingerprint(
+                                            &icon_data[sizeof(CompressHeader)],
+                                            header->compressed_buff_size)))) {
+        // Address reused by other data
+        compress_icon_cache_remove(instance, entry);
+        entry = NULL;
+    }
+
+    return entry;
+}
+
+static void compress_icon_cache_insert(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    const CompressHeader* header,
+    size_t size) {
+    const size_t entry_size = sizeof(CompressIconCacheEntry) + size;
+    if(entry_size > instance->stats.budget) {
+        instance->stats.bypassed++;
+        return;
+    }
+
+    // Make room from entries that were not drawn recently, keep the rest
+    while(instance->stats.size + entry_size > instance->stats.budget) {
+        CompressIconCacheEntry* victim = instance->lru_tail;
+        if(instance->clock - victim->last_used < COMPRESS_ICON_CACHE_STALE_DECODES) {
+            instance->stats.bypassed++;
+            return;
+        }
+        compress_icon_cache_remove(instance, victim);
+        instance->stats.evictions++;
+    }
+
+    CompressIconCacheEntry* entry = malloc(entry_size);
+    entry->icon_data = icon_data;
+    entry->last_used = instance->clock;
+    entry->fingerprint = compress_icon_cache_fingerprint(
+        &icon_data[sizeof(CompressHeader)], header->compressed_buff_size);
+    entry->compressed_size = header->compressed_buff_size;
+    entry->size = size;
+    memcpy(entry->data, instance->decoded_buff, size);
+
+    const size_t bucket = compress_icon_cache_bucket(icon_data);
+    entry->bucket_next = instance->buckets[bucket];
+    instance->buckets[bucket] = entry;
+    compress_icon_cache_push(instance, entry);
+    instance->stats.size += entry_size;
+}
+
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_assert(instance);
     furi_assert(icon_data);
@@ -52,30 +203,92 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
     CompressHeader* header = (CompressHeader*)icon_data;
     if(header->is_compressed) {
+        bool use_cache = instance->stats.budget > 0;
+        if(use_cache && memmgr_get_free_heap() < COMPRESS_ICON_CACHE_HEAP_RESERVE) {
+            if(instance->lru_head) {
+                compress_icon_cache_flush(instance);
+                instance->stats.flushes++;
+            }
+            use_cache = false;
+        }
+
+        if(use_cache) {
+            instance->clock++;
+            CompressIconCacheEntry* entry = compress_icon_cache_find(instance, icon_data, header);
+            if(entry) {
+                entry->last_used = instance->clock;
+                if(entry != instance->lru_head) {
+                    compress_icon_cache_unlink(instance, entry);
+                    compress_icon_cache_push(instance, entry);
+                }
+                instance->stats.hits++;
+                *decoded_buff = entry->data;
+                return;
+            }
+            instance->stats.misses++;
+        }
+
         size_t data_processed = 0;
+        size_t decoded_size = 0;
         heatshrink_decoder_sink(
             instance->decoder,
             (uint8_t*)&icon_data[sizeof(CompressHeader)],
             header->compressed_buff_size,
             &data_processed);
-        while(1) {
+        while(decoded_size < sizeof(instance->decoded_buff)) {
             HSD_poll_res res = heatshrink_decoder_poll(
                 instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
+                &instance->decoded_buff[decoded_size],
+                sizeof(instance->decoded_buff) - decoded_size,
                 &data_processed);
             furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
+            decoded_size += data_processed;
             if(res != HSDR_POLL_MORE) {
                 break;
             }
         }
         heatshrink_decoder_reset(instance->decoder);
         *decoded_buff = instance->decoded_buff;
+
+        if(use_cache) {
+            compress_icon_cache_insert(instance, icon_data, header, decoded_size);
+        }
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
     }
 }
 
+void compress_icon_cache_set_budget(CompressIcon* instance, size_t budget) {
+    furi_assert(instance);
+    instance->stats.budget = budget;
+    while(instance->stats.size > budget) {
+        compress_icon_cache_remove(instance, instance->lru_tail);
+        instance->stats.evictions++;
+    }
+}
+
+void compress_icon_cache_flush(CompressIcon* instance) {
+    furi_assert(instance);
+    while(instance->lru_tail) {
+        compress_icon_cache_remove(instance, instance->lru_tail);
+    }
+}
+
+void compress_icon_cache_get_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->stats;
+}
+
+void compress_icon_cache_reset_stats(CompressIcon* instance) {
+    furi_assert(instance);
+    instance->stats.hits = 0;
+    instance->stats.misses = 0;
+    instance->stats.evictions = 0;
+    instance->stats.bypassed = 0;
+    instance->stats.flushes = 0;
+}
+
 struct Compress {
     heatshrink_encoder* encoder;
     heatshrink_decoder* decoder;
@@ -38,6 +38,53 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Default decoded icon cache budget in bytes, entry overhead included */
+#define COMPRESS_ICON_CACHE_BUDGET_DEFAULT (8192u)
+
+/** Decoded icon cache counters */
+typedef struct {
+    uint32_t hits; /**< Decodes served from cache */
+    uint32_t misses; /**< Decodes done with cache enabled */
+    uint32_t evictions; /**< Entries dropped to make room */
+    uint32_t bypassed; /**< Misses not cached: cache full or entry too large */
+    uint32_t flushes; /**< Cache flushes due to low memory */
+    size_t size; /**< Bytes held by cache */
+    size_t budget; /**< Cache size limit */
+} CompressIconCacheStats;
+
+/** Set decoded icon cache budget
+ *
+ * Cache keeps decoded frames of compressed icons keyed by icon data
+ * pointer, least recently used frames are replaced once they are not
+ * drawn for a while. Frames that don't fit are decoded to shared buffer
+ * as without cache. Cache is flushed when free heap runs low.
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      budget    Cache size limit in bytes, 0 disables cache
+ */
+void compress_icon_cache_set_budget(CompressIcon* instance, size_t budget);
+
+/** Drop all cached frames
+ *
+ * @warning    invalidates pointer returned by last `compress_icon_decode`
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_cache_flush(CompressIcon* instance);
+
+/** Get decoded icon cache counters
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      stats     CompressIconCacheStats to fill
+ */
+void compress_icon_cache_get_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
+/** Reset decoded icon cache counters
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_cache_reset_stats(CompressIcon* instance);
+
 /** Compress control structure */
 typedef struct Compress Compress;
 
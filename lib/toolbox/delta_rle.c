@@ -0,0 +1,90 @@
+#include "delta_rle.h"
+
+#define DELTA_RLE_LITERAL_MAX (128U)
+#define DELTA_RLE_RUN_MIN (3U)
+#define DELTA_RLE_RUN_MAX (DELTA_RLE_RUN_MIN + 0x7FU)
+
+static inline uint8_t delta_rle_get(const uint8_t* frame, const uint8_t* reference, size_t i) {
+    return reference ? frame[i] ^ reference[i] : frame[i];
+}
+
+size_t delta_rle_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* output,
+    size_t output_size) {
+    size_t written = 0;
+    size_t literal_start = 0;
+    size_t i = 0;
+
+    while(i <= size) {
+        size_t run = 0;
+        uint8_t value = 0;
+        if(i < size) {
+            value = delta_rle_get(frame, reference, i);
+            run = 1;
+            while(i + run < size && run < DELTA_RLE_RUN_MAX &&
+                  delta_rle_get(frame, reference, i + run) == value) {
+                run++;
+            }
+        }
+
+        // Flush pending literals before run, at the end or when full
+        size_t literal_count = i - literal_start;
+        if(literal_count &&
+           (run >= DELTA_RLE_RUN_MIN || i == size || literal_count == DELTA_RLE_LITERAL_MAX)) {
+            if(written + 1 + literal_count > output_size) return 0;
+            output[written++] = literal_count - 1;
+            for(size_t j = literal_start; j < i; j++) {
+                output[written++] = delta_rle_get(frame, reference, j);
+            }
+            literal_start = i;
+        }
+
+        if(i == size) break;
+
+        if(run >= DELTA_RLE_RUN_MIN) {
+            if(written + 2 > output_size) return 0;
+            output[written++] = 0x80 | (run - DELTA_RLE_RUN_MIN);
+            output[written++] = value;
+            i += run;
+            literal_start = i;
+        } else {
+            i++;
+        }
+    }
+
+    return written;
+}
+
+bool delta_rle_decode(
+    const uint8_t* input,
+    size_t input_size,
+    const uint8_t* reference,
+    uint8_t* frame,
+    size_t size) {
+    size_t offset = 0;
+    size_t i = 0;
+
+    while(offset < input_size) {
+        uint8_t control = input[offset++];
+        if(control & 0x80) {
+            size_t run = (control & 0x7F) + DELTA_RLE_RUN_MIN;
+            if(offset == input_size || i + run > size) return false;
+            uint8_t value = input[offset++];
+            for(size_t end = i + run; i < end; i++) {
+                frame[i] = reference ? value ^ reference[i] : value;
+            }
+        } else {
+            size_t count = control + 1;
+            if(offset + count > input_size || i + count > size) return false;
+            for(size_t end = i + count; i < end; i++) {
+                uint8_t value = input[offset++];
+                frame[i] = reference ? value ^ reference[i] : value;
+            }
+        }
+    }
+
+    return i == size;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file delta_rle.h
+ * XOR delta with run length encoding, for frames that change little
+ *
+ * Input is XOR of frame and reference, so unchanged bytes become zero
+ * runs. Encoded stream is a sequence of control bytes:
+ *
+ *   0x00-0x7F  literal, followed by (control + 1) bytes
+ *   0x80-0xFF  run, followed by one byte repeated (control - 0x80 + 3) times
+ *
+ * Without reference frame is encoded as is (keyframe). Codec has no
+ * platform dependencies and is used by host benchmark.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Worst case encoded size, all literals */
+#define DELTA_RLE_ENCODED_SIZE_MAX(size) ((size) + ((size) + 127) / 128)
+
+/** Encode frame against reference
+ *
+ * @param      frame        Frame
+ * @param      reference    Reference frame of same size, NULL for keyframe
+ * @param      size         Frame size
+ * @param      output       Output buffer
+ * @param      output_size  Output buffer size
+ *
+ * @return     encoded size, 0 if output buffer is too small
+ */
+size_t delta_rle_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* output,
+    size_t output_size);
+
+/** Decode frame
+ *
+ * @param      input       Encoded data
+ * @param      input_size  Encoded data size
+ * @param      reference   Reference frame used for encoding, NULL for keyframe,
+ *                         may be the same buffer as frame
+ * @param      frame       Output frame
+ * @param      size        Frame size
+ *
+ * @return     true if encoded data is well formed and covers whole frame
+ */
+bool delta_rle_decode(
+    const uint8_t* input,
+    size_t input_size,
+    const uint8_t* reference,
+    uint8_t* frame,
+    size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,6 +3,9 @@
 
 LIST_DEF(DirIndexList, uint32_t);
 
+#define DIR_WALK_BATCH_SIZE 16
+#define DIR_WALK_ARENA_SIZE 1024
+
 struct DirWalk {
     File* file;
     FuriString* path;
@@ -11,6 +14,12 @@ struct DirWalk {
     bool recursive;
     DirWalkFilterCb filter_cb;
     void* filter_context;
+
+    // Entries fetched ahead by storage_dir_read_many
+    StorageDirEntry* batch;
+    char* batch_arena;
+    size_t batch_count;
+    size_t batch_position;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -20,10 +29,14 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
+    dir_walk->batch = malloc(sizeof(StorageDirEntry) * DIR_WALK_BATCH_SIZE);
+    dir_walk->batch_arena = malloc(DIR_WALK_ARENA_SIZE);
     return dir_walk;
 }
 
 void dir_walk_free(DirWalk* dir_walk) {
+    free(dir_walk->batch);
+    free(dir_walk->batch_arena);
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
@@ -39,10 +52,35 @@ void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context
     dir_walk->filter_context = context;
 }
 
+static bool dir_walk_dir_open(DirWalk* dir_walk) {
+    dir_walk->batch_count = 0;
+    dir_walk->batch_position = 0;
+    return storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+}
+
+// Returns NULL on end of directory or error, see storage_file_get_error
+static StorageDirEntry* dir_walk_dir_read(DirWalk* dir_walk) {
+    if(dir_walk->batch_position == dir_walk->batch_count) {
+        dir_walk->batch_count = storage_dir_read_many(
+            dir_walk->file,
+            dir_walk->batch,
+            DIR_WALK_BATCH_SIZE,
+            dir_walk->batch_arena,
+            DIR_WALK_ARENA_SIZE);
+        dir_walk->batch_position = 0;
+    }
+
+    StorageDirEntry* entry = NULL;
+    if(dir_walk->batch_position < dir_walk->batch_count) {
+        entry = &dir_walk->batch[dir_walk->batch_position++];
+    }
+    return entry;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    return dir_walk_dir_open(dir_walk);
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -56,41 +94,39 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
-    FileInfo info;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
+        StorageDirEntry* entry = dir_walk_dir_read(dir_walk);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(entry) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
-            if(dir_walk_filter(dir_walk, name, &info)) {
+            if(dir_walk_filter(dir_walk, entry->name, &entry->fileinfo)) {
                 if(return_path != NULL) {
                     furi_string_printf( //-V576
                         return_path,
                         "%s/%s",
                         furi_string_get_cstr(dir_walk->path),
-                        name);
+                        entry->name);
                 }
 
                 if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
+                    memcpy(fileinfo, &entry->fileinfo, sizeof(FileInfo));
                 }
 
                 end = true;
             }
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
+            if(file_info_is_dir(&entry->fileinfo) && dir_walk->recursive) {
                 // step into
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
                 storage_dir_close(dir_walk->file);
 
-                furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                furi_string_cat_printf(dir_walk->path, "/%s", entry->name);
+                dir_walk_dir_open(dir_walk);
             }
         } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
@@ -110,7 +146,7 @@ static DirWalkResult
                     furi_string_left(dir_walk->path, last_char);
                 }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk_dir_open(dir_walk);
 
                 // rewind
                 while(true) {
@@ -119,7 +155,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
+                    if(!dir_walk_dir_read(dir_walk)) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -134,7 +170,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
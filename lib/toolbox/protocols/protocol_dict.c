@@ -1,20 +1,63 @@
 #include <furi.h>
 #include "protocol_dict.h"
 
+typedef struct {
+    const ProtocolDemod* base;
+    uint32_t features;
+    void* data;
+    bool value;
+    uint32_t count;
+} ProtocolDictDemod;
+
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
     void** data;
+
+    // Decoders with the same demodulator and features get the same bits
+    ProtocolDictDemod* demods;
+    size_t demod_count;
+    ProtocolDictDemod** decoder_demod;
 };
 
+static ProtocolDictDemod* protocol_dict_demod_add(ProtocolDict* dict, size_t protocol_index) {
+    const ProtocolDemod* base = dict->base[protocol_index]->decoder.demod;
+    uint32_t features = dict->base[protocol_index]->features;
+
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        if(dict->demods[i].base == base && dict->demods[i].features == features) {
+            return &dict->demods[i];
+        }
+    }
+
+    ProtocolDictDemod* demod = &dict->demods[dict->demod_count];
+    demod->base = base;
+    demod->features = features;
+    demod->data = base->alloc();
+    demod->value = false;
+    demod->count = 0;
+
+    dict->demod_count++;
+    return demod;
+}
+
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
     ProtocolDict* dict = malloc(sizeof(ProtocolDict));
     dict->base = protocols;
     dict->count = count;
     dict->data = malloc(sizeof(void*) * dict->count);
+    dict->demods = malloc(sizeof(ProtocolDictDemod) * dict->count);
+    dict->demod_count = 0;
+    dict->decoder_demod = malloc(sizeof(ProtocolDictDemod*) * dict->count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
+
+        dict->decoder_demod[i] = NULL;
+        if(dict->base[i]->decoder.demod) {
+            furi_assert(dict->base[i]->decoder.feed_bits);
+            dict->decoder_demod[i] = protocol_dict_demod_add(dict, i);
+        }
     }
 
     return dict;
@@ -25,6 +68,12 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        dict->demods[i].base->free(dict->demods[i].data);
+    }
+
+    free(dict->decoder_demod);
+    free(dict->demods);
     free(dict->data);
     free(dict);
 }
@@ -97,19 +146,43 @@ uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
     return dict->base[protocol_index]->features;
 }
 
+static void protocol_dict_demod_feed(ProtocolDictDemod* demod, bool level, uint32_t duration) {
+    demod->base->feed(demod->data, level, duration, &demod->value, &demod->count);
+}
+
+static bool protocol_dict_decoder_feed(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    bool level,
+    uint32_t duration) {
+    const ProtocolDecoder* decoder = &dict->base[protocol_index]->decoder;
+    const ProtocolDictDemod* demod = dict->decoder_demod[protocol_index];
+    bool result = false;
+
+    if(demod) {
+        if(demod->count > 0) {
+            result = decoder->feed_bits(dict->data[protocol_index], demod->value, demod->count);
+        }
+    } else if(decoder->feed) {
+        result = decoder->feed(dict->data[protocol_index], level, duration);
+    }
+
+    return result;
+}
+
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration) {
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
-    for(size_t i = 0; i < dict->count; i++) {
-        ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        protocol_dict_demod_feed(&dict->demods[i], level, duration);
+    }
 
-        if(fn) {
-            if(fn(dict->data[i], level, duration)) {
-                if(!done) {
-                    ready_protocol_id = i;
-                    done = true;
-                }
+    for(size_t i = 0; i < dict->count; i++) {
+        if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+            if(!done) {
+                ready_protocol_id = i;
+                done = true;
             }
         }
     }
@@ -125,17 +198,19 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        if(dict->demods[i].features & feature) {
+            protocol_dict_demod_feed(&dict->demods[i], level, duration);
+        }
+    }
+
     for(size_t i = 0; i < dict->count; i++) {
         uint32_t features = dict->base[i]->features;
         if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
+            if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+                if(!done) {
+                    ready_protocol_id = i;
+                    done = true;
                 }
             }
         }
@@ -152,12 +227,13 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     furi_assert(protocol_index < dict->count);
 
     ProtocolId ready_protocol_id = PROTOCOL_NO;
-    ProtocolDecoderFeed fn = dict->base[protocol_index]->decoder.feed;
 
-    if(fn) {
-        if(fn(dict->data[protocol_index], level, duration)) {
-            ready_protocol_id = protocol_index;
-        }
+    if(dict->decoder_demod[protocol_index]) {
+        protocol_dict_demod_feed(dict->decoder_demod[protocol_index], level, duration);
+    }
+
+    if(protocol_dict_decoder_feed(dict, protocol_index, level, duration)) {
+        ready_protocol_id = protocol_index;
     }
 
     return ready_protocol_id;
@@ -0,0 +1,340 @@
+/* Host benchmark of Bad USB script execution, line interpreter vs bytecode.
+ *
+ *   cc -O2 -I ../../applications/main/bad_usb/helpers -I ../../furi \
+ *       -I ../../firmware/targets/furi_hal_include -I ../../lib/libusb_stm32/inc \
+ *       -o badusb_bytecode_bench badusb_bytecode_bench.c \
+ *       ../../applications/main/bad_usb/helpers/ducky_script_bytecode.c \
+ *       ../../applications/main/bad_usb/helpers/ducky_script_keycodes.c
+ *   ./badusb_bytecode_bench [LINES] [SEED]
+ *
+ * Synthetic script mixes STRING/STRINGLN lines, named keys, modifier combos,
+ * comments and REPEAT. Interpreter is the hot path of ducky_script.c: script
+ * is read in 16 byte chunks and collected into a line, line is trimmed and
+ * matched against command table, keys are looked up by name or layout.
+ * HID calls only count keystrokes, so result is CPU cost per keystroke
+ * without USB report pacing.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <furi_hal_usb_hid.h>
+#include "ducky_script_bytecode.h"
+
+#define LINES_DEFAULT (20000U)
+#define ROUNDS (8U)
+#define FILE_BUFFER_LEN (16U)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    size_t pos;
+} Memory;
+
+static uint64_t keystrokes;
+static uint16_t layout[DUCKY_BYTECODE_LAYOUT_SIZE];
+
+bool furi_hal_hid_kb_press(uint16_t button) {
+    keystrokes++;
+    return button != 0xFFFF;
+}
+
+bool furi_hal_hid_kb_release(uint16_t button) {
+    return button != 0xFFFF;
+}
+
+bool furi_hal_hid_kb_release_all() {
+    return true;
+}
+
+uint8_t furi_hal_hid_get_led_state() {
+    return HID_KB_LED_NUM;
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char* bench_generate(size_t lines, unsigned seed, size_t* size) {
+    static const char* keys[] = {"ENTER", "TAB", "GUI r", "CTRL-ALT DELETE", "ALT F4", "DOWN"};
+    static const char* words[] = {"powershell", "-NoP", "-W", "Hidden", "Invoke-WebRequest",
+                                  "$env:TEMP", "echo", "hello", "world", "https://example.com"};
+    srand(seed);
+    char* text = malloc(lines * 96 + 1);
+    size_t offset = 0;
+    int kind = 0;
+    for(size_t i = 0; i < lines; i++) {
+        // REPEAT of REPEAT never ends in interpreter
+        kind = (kind == 15) ? rand() % 15 : rand() % 16;
+        if(kind < 9) {
+            offset += sprintf(&text[offset], kind < 6 ? "STRING" : "STRINGLN");
+            for(int j = 0, n = 3 + rand() % 5; j < n; j++) {
+                offset += sprintf(&text[offset], " %s", words[rand() % 10]);
+            }
+            offset += sprintf(&text[offset], "\r\n");
+        } else if(kind < 13) {
+            offset += sprintf(&text[offset], "%s\r\n", keys[rand() % 6]);
+        } else if(kind < 15) {
+            offset += sprintf(&text[offset], "REM step %zu\r\n", i);
+        } else {
+            offset += sprintf(&text[offset], "REPEAT %d\r\n", 1 + rand() % 4);
+        }
+    }
+    text[offset] = '\0';
+    *size = offset;
+    return text;
+}
+
+/* Line interpreter, as ducky_script_execute_next and ducky_parse_line */
+
+typedef struct {
+    const char* text;
+    size_t size;
+    size_t read_pos;
+    uint8_t file_buf[FILE_BUFFER_LEN + 1];
+    uint8_t buf_start;
+    uint8_t buf_len;
+    bool file_end;
+    char line[256];
+    size_t line_len;
+    char line_prev[256];
+    uint32_t repeat_cnt;
+} Interpreter;
+
+static uint32_t interpreter_command_len(const char* line) {
+    uint32_t len = strlen(line);
+    for(uint32_t i = 0; i < len; i++) {
+        if(line[i] == ' ') return i;
+    }
+    return 0;
+}
+
+static uint16_t interpreter_get_keycode(const char* param, bool accept_chars) {
+    uint16_t keycode = ducky_get_keycode_by_name(param);
+    if(keycode != HID_KEYBOARD_NONE) return keycode;
+    if(accept_chars && (strlen(param) > 0)) {
+        return ((uint8_t)param[0] < 128 ? layout[(uint8_t)param[0]] : 0) & 0xFF;
+    }
+    return 0;
+}
+
+static void interpreter_string(const char* param) {
+    for(size_t i = 0; param[i] != '\0'; i++) {
+        uint16_t keycode = (param[i] == '\n') ? HID_KEYBOARD_RETURN :
+                           ((uint8_t)param[i] < 128) ? layout[(uint8_t)param[i]] :
+                                                        HID_KEYBOARD_NONE;
+        if(keycode != HID_KEYBOARD_NONE) {
+            furi_hal_hid_kb_press(keycode);
+            furi_hal_hid_kb_release(keycode);
+        }
+    }
+}
+
+static int32_t interpreter_parse_line(Interpreter* interpreter, const char* line) {
+    static const char* commands[] = {
+        "REM",          "ID",          "DELAY",    "STRING",  "STRINGLN",  "DEFAULT_DELAY",
+        "DEFAULTDELAY", "STRINGDELAY", "STRING_DELAY", "REPEAT", "SYSRQ", "ALTCHAR",
+        "ALTSTRING",    "ALTCODE",     "HOLD",     "RELEASE", "WAIT_FOR_BUTTON_PRESS"};
+    if(line[0] == '\0') return 0;
+
+    size_t cmd_word_len = strcspn(line, " ");
+    for(size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if((strlen(commands[i]) != cmd_word_len) ||
+           (strncmp(line, commands[i], cmd_word_len) != 0)) {
+            continue;
+        }
+        const char* param = &line[interpreter_command_len(line) + 1];
+        if(i == 3 || i == 4) {
+            char string[260];
+            snprintf(string, sizeof(string), "%s%s", param, i == 4 ? "\n" : "");
+            interpreter_string(string);
+        } else if(i == 9) {
+            sscanf(param, "%u", &interpreter->repeat_cnt);
+        }
+        return 0;
+    }
+
+    uint16_t key = interpreter_get_keycode(line, false);
+    if(key == HID_KEYBOARD_NONE) return -1;
+    if((key & 0xFF00) != 0) {
+        key |= interpreter_get_keycode(&line[interpreter_command_len(line) + 1], true);
+    }
+    furi_hal_hid_kb_press(key);
+    furi_hal_hid_kb_release(key);
+    return 0;
+}
+
+static void interpreter_trim(char* line) {
+    size_t len = strlen(line);
+    while(len > 0 && strchr(" \r\n\t", line[len - 1])) line[--len] = '\0';
+    size_t start = strspn(line, " \r\n\t");
+    memmove(line, &line[start], len - start + 1);
+}
+
+static bool interpreter_execute_next(Interpreter* interpreter) {
+    if(interpreter->repeat_cnt > 0) {
+        interpreter->repeat_cnt--;
+        interpreter_parse_line(interpreter, interpreter->line_prev);
+        return true;
+    }
+
+    memcpy(interpreter->line_prev, interpreter->line, sizeof(interpreter->line));
+    interpreter->line_len = 0;
+    interpreter->line[0] = '\0';
+
+    while(1) {
+        if(interpreter->buf_len == 0) {
+            size_t ret = interpreter->size - interpreter->read_pos;
+            if(ret > FILE_BUFFER_LEN) ret = FILE_BUFFER_LEN;
+            memcpy(interpreter->file_buf, &interpreter->text[interpreter->read_pos], ret);
+            interpreter->read_pos += ret;
+            interpreter->buf_len = ret;
+            if(interpreter->read_pos == interpreter->size) {
+                if((interpreter->buf_len < FILE_BUFFER_LEN) && !interpreter->file_end) {
+                    interpreter->file_buf[interpreter->buf_len++] = '\n';
+                    interpreter->file_end = true;
+                }
+            }
+            interpreter->buf_start = 0;
+            if(interpreter->buf_len == 0) return false;
+        }
+        for(uint8_t i = interpreter->buf_start;
+            i < (interpreter->buf_start + interpreter->buf_len);
+            i++) {
+            if(interpreter->file_buf[i] == '\n' && interpreter->line_len > 0) {
+                interpreter->buf_len = interpreter->buf_len + interpreter->buf_start - (i + 1);
+                interpreter->buf_start = i + 1;
+                interpreter_trim(interpreter->line);
+                return interpreter_parse_line(interpreter, interpreter->line) == 0;
+            } else if(interpreter->line_len < sizeof(interpreter->line) - 1) {
+                interpreter->line[interpreter->line_len++] = interpreter->file_buf[i];
+                interpreter->line[interpreter->line_len] = '\0';
+            }
+        }
+        interpreter->buf_len = 0;
+        if(interpreter->file_end) return false;
+    }
+}
+
+static void interpreter_run(const char* text, size_t size) {
+    Interpreter* interpreter = calloc(1, sizeof(Interpreter));
+    interpreter->text = text;
+    interpreter->size = size;
+    while(interpreter_execute_next(interpreter))
+        ;
+    free(interpreter);
+}
+
+/* Bytecode */
+
+static bool memory_write(void* context, const void* data, size_t size) {
+    Memory* memory = context;
+    if(memory->size + size > memory->capacity) {
+        memory->capacity = (memory->size + size) * 2;
+        memory->data = realloc(memory->data, memory->capacity);
+    }
+    memcpy(&memory->data[memory->size], data, size);
+    memory->size += size;
+    return true;
+}
+
+static size_t memory_read(void* context, void* data, size_t size) {
+    Memory* memory = context;
+    if(size > memory->size - memory->pos) size = memory->size - memory->pos;
+    memcpy(data, &memory->data[memory->pos], size);
+    memory->pos += size;
+    return size;
+}
+
+static bool memory_seek(void* context, uint32_t offset) {
+    Memory* memory = context;
+    memory->pos = offset;
+    return offset <= memory->size;
+}
+
+static void bytecode_compile(const char* text, size_t size, Memory* code) {
+    DuckyBytecodeHeader header;
+    code->size = 0;
+    DuckyCompiler* compiler = ducky_compiler_alloc(layout, memory_write, code);
+    for(size_t pos = 0; pos < size; pos += 64) {
+        ducky_compiler_feed(compiler, &text[pos], (size - pos < 64) ? (size - pos) : 64);
+    }
+    ducky_compiler_finish(compiler, &header);
+    ducky_compiler_free(compiler);
+}
+
+static void bytecode_run(Memory* code) {
+    DuckyRunner* runner = ducky_runner_alloc(memory_read, memory_seek, code);
+    ducky_runner_reset(runner);
+    int32_t result = 0;
+    while((result != DUCKY_BYTECODE_RESULT_END) && (result != DUCKY_BYTECODE_RESULT_ERROR)) {
+        result = ducky_runner_execute_next(runner);
+        if(result == DUCKY_BYTECODE_RESULT_STRING_START) {
+            while(!ducky_runner_string_next(runner))
+                ;
+        }
+    }
+    ducky_runner_free(runner);
+}
+
+static void bench_report(const char* name, double elapsed, uint64_t count, uint64_t reference) {
+    printf(
+        "%-22s %8.3f ms/run %8.2f Mkeys/s %s\n",
+        name,
+        elapsed * 1e3 / ROUNDS,
+        count / elapsed / 1e6,
+        count == reference ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    size_t lines = argc > 1 ? strtoul(argv[1], NULL, 0) : LINES_DEFAULT;
+    unsigned seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    if(lines == 0) {
+        fprintf(stderr, "Usage: %s [LINES] [SEED]\n", argv[0]);
+        return 1;
+    }
+    memcpy(layout, hid_asciimap, sizeof(layout));
+
+    size_t size = 0;
+    char* text = bench_generate(lines, seed, &size);
+    Memory code = {0};
+
+    keystrokes = 0;
+    double start = bench_now();
+    for(size_t i = 0; i < ROUNDS; i++) interpreter_run(text, size);
+    double elapsed = bench_now() - start;
+    uint64_t reference = keystrokes;
+    bench_report("interpreter", elapsed, keystrokes, reference);
+
+    keystrokes = 0;
+    start = bench_now();
+    for(size_t i = 0; i < ROUNDS; i++) {
+        bytecode_compile(text, size, &code);
+        bytecode_run(&code);
+    }
+    bench_report("compile + bytecode", bench_now() - start, keystrokes, reference);
+
+    keystrokes = 0;
+    start = bench_now();
+    for(size_t i = 0; i < ROUNDS; i++) bytecode_run(&code);
+    double elapsed_bytecode = bench_now() - start;
+    bench_report("cached bytecode", elapsed_bytecode, keystrokes, reference);
+
+    printf(
+        "script %zu bytes, bytecode %zu bytes, %llu keystrokes/run, speedup %.1fx\n",
+        size,
+        code.size + sizeof(DuckyBytecodeHeader),
+        (unsigned long long)(reference / ROUNDS),
+        elapsed / elapsed_bytecode);
+
+    free(code.data);
+    free(text);
+    return 0;
+}
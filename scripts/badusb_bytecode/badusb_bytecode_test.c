@@ -0,0 +1,375 @@
+/* Host tests of Bad USB script compiler and bytecode runner.
+ *
+ *   cc -O2 -I ../../applications/main/bad_usb/helpers -I ../../furi \
+ *       -I ../../firmware/targets/furi_hal_include -I ../../lib/libusb_stm32/inc \
+ *       -o badusb_bytecode_test badusb_bytecode_test.c \
+ *       ../../applications/main/bad_usb/helpers/ducky_script_bytecode.c \
+ *       ../../applications/main/bad_usb/helpers/ducky_script_keycodes.c
+ *   ./badusb_bytecode_test
+ *
+ * Expected HID traces follow line interpreter in ducky_script.c:
+ * "+XXXX" press, "-XXXX" release, "!" release all, "[ms]" delay,
+ * "{ms}" string with delays, "W" button wait, "E<line>:<text>" error.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <furi_hal_usb_hid.h>
+#include "ducky_script_bytecode.h"
+
+#define TRACE_SIZE (64 * 1024)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    size_t pos;
+    size_t read_chunk;
+} Memory;
+
+static char trace[TRACE_SIZE];
+static size_t trace_len;
+static uint8_t led_state;
+static unsigned failed;
+static unsigned passed;
+
+static void trace_printf(const char* format, unsigned value) {
+    trace_len += snprintf(&trace[trace_len], TRACE_SIZE - trace_len, format, value);
+}
+
+bool furi_hal_hid_kb_press(uint16_t button) {
+    trace_printf("+%04X", button);
+    return true;
+}
+
+bool furi_hal_hid_kb_release(uint16_t button) {
+    trace_printf("-%04X", button);
+    return true;
+}
+
+bool furi_hal_hid_kb_release_all() {
+    trace_printf("!", 0);
+    return true;
+}
+
+uint8_t furi_hal_hid_get_led_state() {
+    return led_state;
+}
+
+static bool memory_write(void* context, const void* data, size_t size) {
+    Memory* memory = context;
+    if(memory->size + size > memory->capacity) {
+        memory->capacity = (memory->size + size) * 2;
+        memory->data = realloc(memory->data, memory->capacity);
+    }
+    memcpy(&memory->data[memory->size], data, size);
+    memory->size += size;
+    return true;
+}
+
+static size_t memory_read(void* context, void* data, size_t size) {
+    Memory* memory = context;
+    if(memory->read_chunk && (size > memory->read_chunk)) size = memory->read_chunk;
+    if(size > memory->size - memory->pos) size = memory->size - memory->pos;
+    memcpy(data, &memory->data[memory->pos], size);
+    memory->pos += size;
+    return size;
+}
+
+static bool memory_seek(void* context, uint32_t offset) {
+    Memory* memory = context;
+    if(offset > memory->size) return false;
+    memory->pos = offset;
+    return true;
+}
+
+static const uint16_t* default_layout(void) {
+    static uint16_t layout[DUCKY_BYTECODE_LAYOUT_SIZE];
+    memcpy(layout, hid_asciimap, sizeof(layout));
+    return layout;
+}
+
+static void compile(
+    const char* script,
+    const uint16_t* layout,
+    size_t feed_chunk,
+    Memory* code,
+    DuckyBytecodeHeader* header) {
+    memset(code, 0, sizeof(Memory));
+    DuckyCompiler* compiler = ducky_compiler_alloc(layout, memory_write, code);
+    size_t len = strlen(script);
+    for(size_t pos = 0; pos < len; pos += feed_chunk) {
+        size_t chunk = (len - pos < feed_chunk) ? (len - pos) : feed_chunk;
+        ducky_compiler_feed(compiler, &script[pos], chunk);
+    }
+    ducky_compiler_finish(compiler, header);
+    ducky_compiler_free(compiler);
+}
+
+/* Run as worker does, string characters are typed by ducky_runner_string_next */
+static void run(Memory* code, size_t read_chunk) {
+    code->read_chunk = read_chunk;
+    trace_len = 0;
+    trace[0] = '\0';
+
+    DuckyRunner* runner = ducky_runner_alloc(memory_read, memory_seek, code);
+    ducky_runner_reset(runner);
+    for(size_t steps = 0; steps < 100000; steps++) {
+        int32_t result = ducky_runner_execute_next(runner);
+        if(result == DUCKY_BYTECODE_RESULT_END) {
+            break;
+        } else if(result == DUCKY_BYTECODE_RESULT_ERROR) {
+            uint16_t line = 0;
+            const char* error = ducky_runner_get_error(runner, &line);
+            trace_printf("E%u:", line);
+            trace_len += snprintf(&trace[trace_len], TRACE_SIZE - trace_len, "%s", error);
+            break;
+        } else if(result == DUCKY_BYTECODE_RESULT_STRING_START) {
+            trace_printf("{%u}", ducky_runner_get_string_delay(runner));
+            while(!ducky_runner_string_next(runner))
+                ;
+        } else if(result == DUCKY_BYTECODE_RESULT_WAIT_FOR_BTN) {
+            trace_printf("W", 0);
+        } else if(result > 0) {
+            trace_printf("[%u]", result);
+        }
+    }
+    ducky_runner_free(runner);
+}
+
+static void check_trace(const char* name, const char* script, const char* expected) {
+    Memory code;
+    DuckyBytecodeHeader header;
+    compile(script, default_layout(), strlen(script) + 1, &code, &header);
+    run(&code, 0);
+    if(strcmp(trace, expected) != 0) {
+        printf("FAIL %s\n  expected: %s\n  actual:   %s\n", name, expected, trace);
+        failed++;
+    } else {
+        passed++;
+    }
+    free(code.data);
+}
+
+static void check(const char* name, bool condition) {
+    if(!condition) {
+        printf("FAIL %s\n", name);
+        failed++;
+    } else {
+        passed++;
+    }
+}
+
+static void test_commands(void) {
+    check_trace("string", "STRING ab", "+0004-0004+0005-0005");
+    check_trace("stringln", "STRINGLN a", "+0004-0004+0028-0028");
+    check_trace("string shift", "STRING A!", "+0204-0204+021E-021E");
+    check_trace("string no param", "STRING", "+0217-0217+0215-0215+020C-020C+0211-0211+020A-020A");
+    check_trace("rem id", "REM test\nID 1234:5678\nSTRING a", "+0004-0004");
+    check_trace("delay", "DELAY 100\nSTRING a", "[100]+0004-0004");
+    check_trace("delay spaces", "DELAY   250", "[250]");
+    check_trace("delay zero", "DELAY 0", "E1:Invalid number 0");
+    check_trace("delay invalid", "DELAY x", "E1:Invalid number x");
+    check_trace("delay no param", "DELAY", "E1:Invalid number ELAY");
+    check_trace(
+        "default delay",
+        "DEFAULT_DELAY 10\nSTRING a\nREM x\nDELAY 5",
+        "[10]+0004-0004[10][10][15]");
+    check_trace("default delay alias", "DEFAULTDELAY 7\nENTER", "[7]+0028-0028[7]");
+    check_trace("special key", "ENTER\nDOWNARROW\nF12", "+0028-0028+0051-0051+0045-0045");
+    check_trace("combo", "CTRL-ALT DELETE", "+054C-054C");
+    check_trace("combo char", "GUI r", "+0815-0815");
+    check_trace("combo name quirk", "CTRL", "+0117-0117");
+    check_trace("unknown key", "STRING a\nFOO bar", "+0004-0004E2:No keycode defined for FOO bar");
+    check_trace("sysrq", "SYSRQ h", "+0446+000B!");
+    check_trace(
+        "altchar",
+        "ALTCHAR 65",
+        "+0083-0083+0400+005E-005E+005D-005D-0400");
+    check_trace("altchar invalid", "ALTCHAR x", "+0083-0083+0400-0400E1:Invalid altchar x");
+    check_trace(
+        "altstring",
+        "ALTSTRING a",
+        "+0083-0083+0400+0061-0061+005F-005F-0400");
+    check_trace("hold release", "HOLD SHIFT\nRELEASE SHIFT", "+0200-0200");
+    check_trace("release not held", "RELEASE a", "E1:No keys are hold");
+    check_trace("hold no param", "HOLD", "+0012");
+    check_trace("hold invalid", "HOLD \xC3", "E1:No keycode defined for \xC3");
+    check_trace(
+        "hold too many",
+        "HOLD a\nHOLD b\nHOLD c\nHOLD d\nHOLD e\nHOLD f",
+        "+0004+0005+0006+0007+0008E6:Too many keys are hold");
+    check_trace("wait button", "WAIT_FOR_BUTTON_PRESS\nSTRING a", "W+0004-0004");
+    check_trace(
+        "wait button no default delay",
+        "DEFAULT_DELAY 10\nWAIT_FOR_BUTTON_PRESS",
+        "[10]W");
+}
+
+static void test_string_delay(void) {
+    check_trace(
+        "string delay one shot",
+        "STRINGDELAY 20\nSTRING ab\nSTRING c",
+        "{20}+0004-0004+0005-0005+0006-0006");
+    check_trace(
+        "string delay with default delay",
+        "DEFAULT_DELAY 3\nSTRING_DELAY 20\nSTRINGLN a",
+        "[3][3]{20}+0004-0004+0028-0028[3]");
+    check_trace("string delay empty", "STRINGDELAY 5\nSTRING \x01", "{5}");
+}
+
+static void test_lines(void) {
+    check_trace(
+        "empty lines", "\n\nSTRING a\n\n\n\nFOO", "+0004-0004E4:No keycode defined for FOO");
+    check_trace("crlf", "STRING a\r\n  ENTER  \r\n", "+0004-0004+0028-0028");
+    check_trace(
+        "whitespace line", "STRING a\n \t \nFOO", "+0004-0004E3:No keycode defined for FOO");
+    check_trace("empty script", "", "");
+
+    Memory code;
+    DuckyBytecodeHeader header;
+    compile("STRING a\n\n\nSTRING b\n", default_layout(), 64, &code, &header);
+    check("line count", header.line_nb == 3);
+    free(code.data);
+}
+
+static void test_repeat(void) {
+    check_trace("repeat", "STRING a\nREPEAT 3", "+0004-0004+0004-0004+0004-0004+0004-0004");
+    check_trace(
+        "repeat default delay",
+        "DEFAULT_DELAY 5\nSTRING a\nREPEAT 2",
+        "[5]+0004-0004[5][5]+0004-0004[5]+0004-0004[5]");
+    check_trace("repeat delay", "DELAY 10\nREPEAT 2", "[10][10][10]");
+    check_trace("repeat invalid", "STRING a\nREPEAT 0", "+0004-0004E2:Invalid number 0");
+    check_trace("repeat first line", "REPEAT 3\nSTRING a", "+0004-0004");
+    check_trace("repeat empty line", "STRING a\n\n\nREPEAT 3", "+0004-0004");
+    check_trace(
+        "repeat hold",
+        "HOLD a\nREPEAT 10",
+        "+0004+0004+0004+0004+0004E1:Too many keys are hold");
+    check_trace("repeat release", "HOLD a\nRELEASE a\nREPEAT 2", "+0004-0004E2:No keys are hold");
+    check_trace(
+        "repeat string delay",
+        "STRINGDELAY 5\nSTRING a\nREPEAT 2",
+        "{5}+0004-0004+0004-0004+0004-0004");
+    check_trace(
+        "repeat error line",
+        "FOO\nREPEAT 2",
+        "E1:No keycode defined for FOO");
+    check_trace(
+        "repeat nested",
+        "DELAY 1\nSTRING a\nREPEAT 1\nREPEAT 2",
+        "[1]+0004-0004+0004-0004E4:Nested REPEAT 2");
+
+    // Repeat body longer than runner buffer
+    char script[512];
+    static char expected[16384];
+    strcpy(script, "STRING ");
+    for(size_t i = 0; i < 300; i++) strcat(script, "b");
+    strcat(script, "\nREPEAT 2\nENTER");
+    for(size_t i = 0; i < 900; i++) strcat(expected, "+0005-0005");
+    strcat(expected, "+0028-0028");
+    check_trace("repeat long body", script, expected);
+}
+
+static void test_stream(void) {
+    const char* script = "DEFAULT_DELAY 2\nSTRINGLN Hello, World!\nGUI r\n"
+                         "STRINGDELAY 7\nSTRING slow\nHOLD ALT\nSTRING x\n"
+                         "RELEASE ALT\nSTRING abc\nREPEAT 20\nALTSTRING Hi\nDELAY 300\n";
+    Memory reference;
+    DuckyBytecodeHeader reference_header;
+    compile(script, default_layout(), strlen(script), &reference, &reference_header);
+    run(&reference, 0);
+    char* reference_trace = strdup(trace);
+
+    for(size_t feed_chunk = 1; feed_chunk < 20; feed_chunk += 3) {
+        Memory code;
+        DuckyBytecodeHeader header;
+        compile(script, default_layout(), feed_chunk, &code, &header);
+        check(
+            "feed chunks",
+            (code.size == reference.size) && (memcmp(code.data, reference.data, code.size) == 0) &&
+                (memcmp(&header, &reference_header, sizeof(header)) == 0));
+        free(code.data);
+    }
+
+    for(size_t read_chunk = 1; read_chunk < 40; read_chunk += 5) {
+        run(&reference, read_chunk);
+        check("read chunks", strcmp(trace, reference_trace) == 0);
+    }
+
+    check("code size", reference_header.code_size == reference.size);
+    free(reference_trace);
+    free(reference.data);
+}
+
+static void test_header(void) {
+    const char* script = "STRING a\n";
+    Memory code;
+    DuckyBytecodeHeader header;
+    uint16_t layout[DUCKY_BYTECODE_LAYOUT_SIZE];
+    memcpy(layout, default_layout(), sizeof(layout));
+
+    compile(script, layout, 4, &code, &header);
+    uint32_t hash = ducky_bytecode_hash(DUCKY_BYTECODE_HASH_INIT, script, strlen(script));
+    check("header valid", ducky_bytecode_header_is_valid(&header, strlen(script), hash, layout));
+    check(
+        "header script changed",
+        !ducky_bytecode_header_is_valid(&header, strlen(script), hash + 1, layout));
+    check(
+        "header size changed",
+        !ducky_bytecode_header_is_valid(&header, strlen(script) + 1, hash, layout));
+    layout['a'] = HID_KEYBOARD_Q;
+    check("header layout changed", !ducky_bytecode_header_is_valid(&header, 9, hash, layout));
+    free(code.data);
+
+    compile(script, layout, 4, &code, &header);
+    run(&code, 0);
+    check("layout used", strcmp(trace, "+0014-0014") == 0);
+    free(code.data);
+
+    // Keys with other modifiers don't fit in one byte
+    layout['b'] = KEY_MOD_RIGHT_ALT | HID_KEYBOARD_Q;
+    layout['c'] = KEY_MOD_LEFT_SHIFT | 0x7F;
+    compile("STRING abc", layout, 4, &code, &header);
+    run(&code, 0);
+    check("layout escaped keys", strcmp(trace, "+0014-0014+4014-4014+027F-027F") == 0);
+    free(code.data);
+}
+
+static void test_numlock(void) {
+    led_state = HID_KB_LED_NUM;
+    check_trace("numlock on", "ALTCHAR 1", "+0400+0059-0059-0400");
+    led_state = 0;
+}
+
+static void test_corrupted(void) {
+    Memory code;
+    DuckyBytecodeHeader header;
+    compile("STRING abc\nENTER", default_layout(), 64, &code, &header);
+    code.size -= 4;
+    run(&code, 0);
+    check("truncated", strstr(trace, "Bytecode read error") != NULL);
+    code.data[0] = 0xFF;
+    run(&code, 0);
+    check("corrupted", strcmp(trace, "E0:Bytecode is corrupted") == 0);
+    free(code.data);
+}
+
+int main(void) {
+    test_commands();
+    test_string_delay();
+    test_lines();
+    test_repeat();
+    test_stream();
+    test_header();
+    test_numlock();
+    test_corrupted();
+
+    printf("%u passed, %u failed\n", passed, failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,356 @@
+/* Host test vectors and throughput benchmark of Crypto1.
+ *
+ *   cc -O2 -I stub -I ../../furi -I ../../lib/nfc/protocols -o crypto1_bench crypto1_bench.c \
+ *       ../../lib/nfc/protocols/crypto1.c ../../lib/nfc/protocols/nfc_util.c
+ *   ./crypto1_bench [COUNT]
+ *
+ * Reference is the bit at a time implementation crypto1.c had before table driven stepping,
+ * kept here under bench_ref_ names with encrypt and decrypt reduced to whole bytes. Fixed
+ * vectors were produced by it. Then COUNT random states are stepped by both implementations
+ * through byte, word, encrypt, decrypt and batch calls, keystream, parity and final odd/even
+ * halves must be the same.
+ * Throughput is measured for MIFARE Classic frame sizes and for dictionary key setup.
+ * stub/ provides host versions of furi headers.
+ */
+
+#include <furi.h>
+#include <crypto1.h>
+#include <nfc_util.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define COUNT_DEFAULT (100000U)
+#define ROUNDS (8U)
+#define FRAME_BYTES (18U)
+#define BATCH_KEYS (1024U)
+
+#define LF_POLY_ODD (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+#define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+
+typedef struct {
+    uint64_t key;
+    uint32_t ks_nt;
+    uint32_t ks_nr;
+    uint32_t ks_zero;
+    uint8_t ks_encrypted;
+    uint32_t encrypted;
+    uint8_t parity;
+    uint32_t odd;
+    uint32_t even;
+} BenchVector;
+
+/* uid ^ nt, then nr, then zero word, then 0x5A encrypted, then 30 04 26 EE encrypted */
+static const uint32_t bench_vector_uid = 0x2A234F80;
+static const uint32_t bench_vector_nt = 0x01200145;
+static const uint32_t bench_vector_nr = 0x15459649;
+static const uint8_t bench_vector_plain[4] = {0x30, 0x04, 0x26, 0xEE};
+
+static const BenchVector bench_vectors[] = {
+    {0xFFFFFFFFFFFF,
+     0xFFFFF51F, 0xA3E58F22, 0xA7BA52FA, 0x14,
+     0x66E5E2B9, 0x20, 0xBDBC687E, 0xA8FE8302},
+    {0xA0A1A2A3A4A5,
+     0x1A81DB8B, 0x5CF0E445, 0x279747A6, 0xFB,
+     0xEF27D433, 0x20, 0x984758B9, 0x5880EF65},
+    {0x000000000000,
+     0x180D1818, 0xFDEAB975, 0x4F2E0E39, 0xA6,
+     0xA54B5205, 0x30, 0x369E9B0C, 0xB66AD64C},
+    {0x4D3A99C351DD,
+     0x6057E863, 0x5C1DC765, 0x4BF64C3D, 0xF0,
+     0x3C95BC68, 0x00, 0xF31BED80, 0xD4FE8E89},
+};
+
+static uint32_t bench_ref_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t bench_ref_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    furi_assert(crypto1);
+    uint8_t out = bench_ref_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= LF_POLY_ODD & crypto1->odd;
+    feed ^= LF_POLY_EVEN & crypto1->even;
+    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+
+    FURI_SWAP(crypto1->odd, crypto1->even);
+    return out;
+}
+
+static uint8_t bench_ref_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    furi_assert(crypto1);
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= bench_ref_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t bench_ref_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    furi_assert(crypto1);
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)bench_ref_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+static void bench_ref_decrypt(
+    Crypto1* crypto,
+    uint8_t* encrypted_data,
+    uint16_t encrypted_data_bits,
+    uint8_t* decrypted_data) {
+    for(size_t i = 0; i < encrypted_data_bits / 8; i++) {
+        decrypted_data[i] = bench_ref_byte(crypto, 0, 0) ^ encrypted_data[i];
+    }
+}
+
+static void bench_ref_encrypt(
+    Crypto1* crypto,
+    uint8_t* keystream,
+    uint8_t* plain_data,
+    uint16_t plain_data_bits,
+    uint8_t* encrypted_data,
+    uint8_t* encrypted_parity) {
+    memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
+    for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
+        encrypted_data[i] = bench_ref_byte(crypto, keystream ? keystream[i] : 0, 0) ^
+                            plain_data[i];
+        encrypted_parity[i / 8] |=
+            (((bench_ref_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
+             << (7 - (i & 0x0007)));
+    }
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t bench_random(void) {
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 7;
+    bench_random_state ^= bench_random_state << 17;
+    return bench_random_state >> 32;
+}
+
+static bool bench_state_equal(const Crypto1* a, const Crypto1* b) {
+    return a->odd == b->odd && a->even == b->even;
+}
+
+static bool bench_check_vectors(void) {
+    bool result = true;
+
+    for(size_t i = 0; i < sizeof(bench_vectors) / sizeof(bench_vectors[0]); i++) {
+        const BenchVector* vector = &bench_vectors[i];
+        for(size_t implementation = 0; implementation < 2; implementation++) {
+            /* Encrypt clears one parity byte per data byte */
+            uint8_t plain[4], encrypted[4], parity[4 + 1];
+            memcpy(plain, bench_vector_plain, sizeof(plain));
+
+            Crypto1 crypto;
+            crypto1_init(&crypto, vector->key);
+            uint32_t ks_nt, ks_nr, ks_zero;
+            uint8_t ks_encrypted;
+            if(implementation) {
+                ks_nt = crypto1_word(&crypto, bench_vector_uid ^ bench_vector_nt, 0);
+                ks_nr = crypto1_word(&crypto, bench_vector_nr, 0);
+                ks_zero = crypto1_word(&crypto, 0, 0);
+                ks_encrypted = crypto1_byte(&crypto, 0x5A, 1);
+                crypto1_encrypt(&crypto, NULL, plain, 32, encrypted, parity);
+            } else {
+                ks_nt = bench_ref_word(&crypto, bench_vector_uid ^ bench_vector_nt, 0);
+                ks_nr = bench_ref_word(&crypto, bench_vector_nr, 0);
+                ks_zero = bench_ref_word(&crypto, 0, 0);
+                ks_encrypted = bench_ref_byte(&crypto, 0x5A, 1);
+                bench_ref_encrypt(&crypto, NULL, plain, 32, encrypted, parity);
+            }
+
+            bool match = ks_nt == vector->ks_nt && ks_nr == vector->ks_nr &&
+                         ks_zero == vector->ks_zero && ks_encrypted == vector->ks_encrypted &&
+                         nfc_util_bytes2num(encrypted, 4) == vector->encrypted &&
+                         parity[0] == vector->parity && crypto.odd == vector->odd &&
+                         crypto.even == vector->even;
+            if(!match) {
+                printf(
+                    "vector %012" PRIX64 " %s MISMATCH\n",
+                    vector->key,
+                    implementation ? "table" : "reference");
+                result = false;
+            }
+        }
+    }
+
+    return result;
+}
+
+static bool bench_check_random(size_t count) {
+    bool result = true;
+
+    for(size_t i = 0; i < count && result; i++) {
+        Crypto1 ref = {.odd = bench_random(), .even = bench_random()};
+        Crypto1 crypto = ref;
+        int is_encrypted = bench_random() & 1;
+        uint32_t in = bench_random();
+
+        result = bench_ref_byte(&ref, in, is_encrypted) ==
+                 crypto1_byte(&crypto, in, is_encrypted);
+        result = result && bench_state_equal(&ref, &crypto);
+        result = result && bench_ref_word(&ref, in, is_encrypted) ==
+                               crypto1_word(&crypto, in, is_encrypted);
+        result = result && bench_state_equal(&ref, &crypto);
+
+        uint8_t plain[FRAME_BYTES], keystream[FRAME_BYTES];
+        uint8_t ref_data[FRAME_BYTES], data[FRAME_BYTES];
+        uint8_t ref_parity[FRAME_BYTES + 1], parity[FRAME_BYTES + 1];
+        size_t bytes = 1 + bench_random() % FRAME_BYTES;
+        for(size_t j = 0; j < FRAME_BYTES; j++) {
+            plain[j] = bench_random();
+            keystream[j] = bench_random();
+        }
+        uint8_t* keystream_in = (i & 1) ? keystream : NULL;
+        bench_ref_encrypt(&ref, keystream_in, plain, bytes * 8, ref_data, ref_parity);
+        crypto1_encrypt(&crypto, keystream_in, plain, bytes * 8, data, parity);
+        result = result && !memcmp(ref_data, data, bytes) &&
+                 !memcmp(ref_parity, parity, bytes / 8 + 1) && bench_state_equal(&ref, &crypto);
+
+        bench_ref_decrypt(&ref, plain, bytes * 8, ref_data);
+        crypto1_decrypt(&crypto, plain, bytes * 8, data);
+        result = result && !memcmp(ref_data, data, bytes) && bench_state_equal(&ref, &crypto);
+    }
+
+    /* Odd and even batch sizes, with and without keystream output */
+    for(size_t states = 0; states < 9 && result; states++) {
+        Crypto1 ref[8], crypto[8];
+        uint32_t out[8];
+        uint32_t in = bench_random();
+        int is_encrypted = states & 1;
+        for(size_t i = 0; i < states; i++) {
+            ref[i] = (Crypto1){.odd = bench_random(), .even = bench_random()};
+            crypto[i] = ref[i];
+        }
+        crypto1_word_batch(crypto, states, in, (states & 2) ? out : NULL, is_encrypted);
+        for(size_t i = 0; i < states; i++) {
+            uint32_t word = bench_ref_word(&ref[i], in, is_encrypted);
+            result = result && bench_state_equal(&ref[i], &crypto[i]) &&
+                     (!(states & 2) || out[i] == word);
+        }
+    }
+
+    if(!result) printf("random states MISMATCH\n");
+    return result;
+}
+
+static volatile uint32_t bench_sink;
+
+/* Keystream of FRAME_BYTES frames, as emulator does for every read or write command */
+static double bench_frames(bool reference, size_t count) {
+    uint8_t plain[FRAME_BYTES] = {0}, data[FRAME_BYTES], parity[FRAME_BYTES + 1];
+    Crypto1 crypto;
+    crypto1_init(&crypto, 0xA0A1A2A3A4A5);
+
+    double best = 0;
+    for(size_t round = 0; round < ROUNDS; round++) {
+        double start = bench_now();
+        for(size_t i = 0; i < count; i++) {
+            if(reference) {
+                bench_ref_encrypt(&crypto, NULL, plain, FRAME_BYTES * 8, data, parity);
+            } else {
+                crypto1_encrypt(&crypto, NULL, plain, FRAME_BYTES * 8, data, parity);
+            }
+            plain[0] ^= data[0];
+        }
+        double elapsed = bench_now() - start;
+        if(round == 0 || elapsed < best) best = elapsed;
+    }
+    bench_sink = crypto.odd;
+    return count * FRAME_BYTES / best;
+}
+
+/* Per key setup of dictionary attack: init and uid ^ nt, then nr and ar keystream */
+static double bench_keys(int mode, size_t count) {
+    static Crypto1 crypto[BATCH_KEYS];
+    static uint32_t out[BATCH_KEYS];
+    uint32_t uid_nt = bench_vector_uid ^ bench_vector_nt;
+    size_t batches = (count + BATCH_KEYS - 1) / BATCH_KEYS;
+
+    double best = 0;
+    for(size_t round = 0; round < ROUNDS; round++) {
+        double start = bench_now();
+        uint32_t sink = 0;
+        for(size_t batch = 0; batch < batches; batch++) {
+            for(size_t i = 0; i < BATCH_KEYS; i++) {
+                crypto1_init(&crypto[i], (uint64_t)batch * BATCH_KEYS + i);
+            }
+            if(mode == 2) {
+                crypto1_word_batch(crypto, BATCH_KEYS, uid_nt, NULL, 0);
+                crypto1_word_batch(crypto, BATCH_KEYS, bench_vector_nr, out, 0);
+                sink ^= out[0];
+                crypto1_word_batch(crypto, BATCH_KEYS, 0, out, 0);
+                sink ^= out[BATCH_KEYS - 1];
+            } else {
+                for(size_t i = 0; i < BATCH_KEYS; i++) {
+                    uint32_t (*word)(Crypto1*, uint32_t, int) = mode ? crypto1_word :
+                                                                       bench_ref_word;
+                    word(&crypto[i], uid_nt, 0);
+                    sink ^= word(&crypto[i], bench_vector_nr, 0);
+                    sink ^= word(&crypto[i], 0, 0);
+                }
+            }
+        }
+        double elapsed = bench_now() - start;
+        if(round == 0 || elapsed < best) best = elapsed;
+        bench_sink = sink;
+    }
+    return batches * BATCH_KEYS / best;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 0) : COUNT_DEFAULT;
+    if(count == 0) {
+        fprintf(stderr, "Usage: %s [COUNT]\n", argv[0]);
+        return 1;
+    }
+
+    bool match = bench_check_vectors();
+    match = bench_check_random(count) && match;
+    printf(
+        "%zu vectors, %zu random states %s\n",
+        sizeof(bench_vectors) / sizeof(bench_vectors[0]),
+        count,
+        match ? "ok" : "MISMATCH");
+
+    double frames_ref = bench_frames(true, count);
+    double frames = bench_frames(false, count);
+    printf(
+        "encrypt %u byte frames: reference %.1f MB/s, table %.1f MB/s, x%.1f\n",
+        FRAME_BYTES,
+        frames_ref / 1e6,
+        frames / 1e6,
+        frames / frames_ref);
+
+    double keys_ref = bench_keys(0, count);
+    double keys = bench_keys(1, count);
+    double keys_batch = bench_keys(2, count);
+    printf(
+        "dictionary key setup: reference %.0f keys/s, word %.0f keys/s, batch %.0f keys/s, "
+        "x%.1f\n",
+        keys_ref,
+        keys,
+        keys_batch,
+        keys_batch / keys_ref);
+
+    return match ? 0 : 1;
+}
@@ -0,0 +1,11 @@
+/* Host replacement of furi.h for Crypto1 bench */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/core_defines.h>
+#include <core/check.h>
@@ -0,0 +1,83 @@
+# Minimal perfect hash for firmware API table.
+# Mirrors elf_perfect_hash_* functions in
+# lib/flipper_application/api_hashtable/api_hashtable.h, any change there must be repeated here.
+from typing import List, Optional, Tuple
+
+_MASK = 0xFFFFFFFF
+
+BUCKET_SIZE_MAX = 32
+SALT_MAX = 64
+
+
+def elf_gnu_hash(name: str) -> int:
+    h = 0x1505
+    for c in name.encode():
+        h = (h * 33 + c) & _MASK
+    return h
+
+
+def _mix(h: int) -> int:
+    h ^= h >> 16
+    h = (h * 0x7FEB352D) & _MASK
+    h ^= h >> 15
+    h = (h * 0x846CA68B) & _MASK
+    h ^= h >> 16
+    return h
+
+
+def bucket_count(entry_count: int) -> int:
+    return entry_count // 3 + 1
+
+
+def _place(
+    hashes: List[int], buckets: List[List[int]], salt: int
+) -> Optional[Tuple[List[int], List[int]]]:
+    n = len(hashes)
+    base = [0] * n
+    step = [0] * n
+    for i, h in enumerate(hashes):
+        entry_base = _mix(h ^ ((0x9E3779B9 + salt) & _MASK))
+        base[i] = entry_base % n
+        step[i] = _mix(entry_base) % n
+
+    seeds = [0] * len(buckets)
+    order = [-1] * n
+    # Seeds beyond N * N repeat the same displacements
+    seed_count = min(n * n, 0x10000)
+    # Place biggest buckets first, while table is still mostly empty
+    for b in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+        bucket = buckets[b]
+        if not bucket:
+            break
+        for seed in range(seed_count):
+            multiplier, offset = divmod(seed, n)
+            slots = [(base[i] + multiplier * step[i] + offset) % n for i in bucket]
+            if len(set(slots)) == len(slots) and all(order[s] < 0 for s in slots):
+                break
+        else:
+            return None
+
+        seeds[b] = seed
+        for i, s in zip(bucket, slots):
+            order[s] = i
+    return seeds, order
+
+
+def create_perfect_hash(hashes: List[int]) -> Tuple[int, List[int], List[int]]:
+    """Returns salt, bucket seeds and entry index for every slot"""
+    if len(set(hashes)) != len(hashes):
+        raise ValueError("Duplicate API symbol hashes")
+    if len(hashes) > 0xFFFF:
+        raise ValueError("API table is too big for 16 bit seeds")
+
+    buckets = [[] for _ in range(bucket_count(len(hashes)))]
+    for i, h in enumerate(hashes):
+        buckets[_mix(h) % len(buckets)].append(i)
+    if max(len(bucket) for bucket in buckets) > BUCKET_SIZE_MAX:
+        raise ValueError("API table hash bucket overflow")
+
+    for salt in range(SALT_MAX):
+        placement = _place(hashes, buckets, salt)
+        if placement:
+            return (salt, *placement)
+    raise ValueError("Can't build API perfect hash")
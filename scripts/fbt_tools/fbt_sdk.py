@@ -6,6 +6,7 @@ import shutil
 
 from fbt.sdk.cache import SdkCache
 from fbt.sdk.collector import SdkCollector
+from fbt.sdk.perfect_hash import bucket_count, create_perfect_hash, elf_gnu_hash
 from fbt.util import path_as_posix
 from SCons.Action import Action
 from SCons.Builder import Builder
@@ -201,22 +202,36 @@ def gen_sdk_data(sdk_cache: SdkCache):
 
     api_def.append(f"const int elf_api_version = {sdk_cache.version.as_int()};")
 
-    api_def.append(
-        "static constexpr auto elf_api_table = sort(create_array_t<sym_entry>("
-    )
-
+    api_names = []
     api_lines = []
     for fun_def in sdk_cache.get_functions():
+        api_names.append(fun_def.name)
         api_lines.append(
             f"API_METHOD({fun_def.name}, {fun_def.returns}, ({fun_def.params}))"
         )
 
     for var_def in sdk_cache.get_variables():
+        api_names.append(var_def.name)
         api_lines.append(f"API_VARIABLE({var_def.name}, {var_def.var_type })")
 
-    api_def.append(",\n".join(api_lines))
+    # Perfect hash is too expensive for constexpr evaluation at firmware API size,
+    # it is built here and only verified by the compiler
+    try:
+        salt, seeds, order = create_perfect_hash(list(map(elf_gnu_hash, api_names)))
+    except ValueError as e:
+        raise UserError(f"Failed to build API table: {e}")
 
-    api_def.append("));")
+    api_def.append(
+        "static constexpr PerfectHashTable<"
+        f"{len(api_names)}, {bucket_count(len(api_names))}> elf_api_perfect_hash = {{"
+    )
+    api_def.append(f"    .seeds = {{{{{', '.join(map(str, seeds))}}}}},")
+    api_def.append("    .slots = {{")
+    api_def.append(",\n".join(api_lines[i] for i in order))
+    api_def.append("    }},")
+    api_def.append(f"    .salt = {salt},")
+    api_def.append("    .valid = true,")
+    api_def.append("};")
     return api_def
 
 
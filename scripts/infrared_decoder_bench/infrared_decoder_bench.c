@@ -0,0 +1,285 @@
+/* Host benchmark of infrared decoder set on recorded raw captures.
+ *
+ *   cc -O2 -I stub -I ../../furi -I ../../lib/infrared/encoder_decoder \
+ *       -o infrared_decoder_bench infrared_decoder_bench.c \
+ *       $(find ../../lib/infrared/encoder_decoder -name '*.c')
+ *   ./infrared_decoder_bench ../../assets/unit_tests/infrared/test_*.irtest
+ *
+ * Captures are decoder_inputN raw signals of unit test files, each one is
+ * replayed as infrared unit test does and decoded messages are compared with
+ * decoder_expectedN. Then all captures are replayed back to back through one
+ * decoder set to measure edges per second and per protocol statistics.
+ * stub/ provides host versions of furi headers used by decoders.
+ */
+
+#include <infrared.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS (64U)
+
+typedef struct {
+    const char* path;
+    char name[32];
+    uint32_t* timings;
+    size_t timings_count;
+    InfraredMessage* messages;
+    size_t messages_count;
+} Capture;
+
+typedef struct {
+    Capture* items;
+    size_t count;
+} Captures;
+
+static const InfraredProtocol bench_decoders[] = {
+    InfraredProtocolNEC,
+    InfraredProtocolSamsung32,
+    InfraredProtocolRC5,
+    InfraredProtocolRC6,
+    InfraredProtocolSIRC,
+    InfraredProtocolKaseikyo,
+};
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Capture for decoder_inputN or decoder_expectedN, created on first use */
+static Capture*
+    bench_capture_get(Captures* captures, size_t first, const char* path, const char* index) {
+    for(size_t i = first; i < captures->count; i++) {
+        if(!strcmp(captures->items[i].name, index)) return &captures->items[i];
+    }
+
+    captures->items = realloc(captures->items, (captures->count + 1) * sizeof(Capture));
+    Capture* capture = &captures->items[captures->count++];
+    memset(capture, 0, sizeof(Capture));
+    capture->path = path;
+    snprintf(capture->name, sizeof(capture->name), "%s", index);
+    return capture;
+}
+
+static uint32_t bench_parse_hex(const char* text) {
+    uint32_t value = 0;
+    char* end;
+    for(size_t shift = 0; shift < 32; shift += 8) {
+        unsigned long byte = strtoul(text, &end, 16);
+        if(end == text) break;
+        value |= byte << shift;
+        text = end;
+    }
+    return value;
+}
+
+static bool bench_load(Captures* captures, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    size_t first = captures->count;
+    Capture* capture = NULL;
+    bool raw = false;
+    InfraredMessage message = {.protocol = InfraredProtocolUnknown};
+    char* line = NULL;
+    size_t capacity = 0;
+
+    while(getline(&line, &capacity, file) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char* value = strchr(line, ':');
+        if(!value) continue;
+        *value++ = '\0';
+        value += strspn(value, " ");
+
+        if(!strcmp(line, "name")) {
+            const char* index = NULL;
+            raw = !strncmp(value, "decoder_input", strlen("decoder_input"));
+            if(raw) {
+                index = value + strlen("decoder_input");
+            } else if(!strncmp(value, "decoder_expected", strlen("decoder_expected"))) {
+                index = value + strlen("decoder_expected");
+            }
+            capture = index ? bench_capture_get(captures, first, path, index) : NULL;
+        } else if(!capture) {
+            continue;
+        } else if(raw && !strcmp(line, "data")) {
+            char* end;
+            for(unsigned long timing; (timing = strtoul(value, &end, 10)), end != value;
+                value = end) {
+                capture->timings = realloc(
+                    capture->timings, (capture->timings_count + 1) * sizeof(uint32_t));
+                capture->timings[capture->timings_count++] = timing;
+            }
+        } else if(!strcmp(line, "protocol")) {
+            message.protocol = infrared_get_protocol_by_name(value);
+        } else if(!strcmp(line, "address")) {
+            message.address = bench_parse_hex(value);
+        } else if(!strcmp(line, "command")) {
+            message.command = bench_parse_hex(value);
+        } else if(!strcmp(line, "repeat")) {
+            message.repeat = !strcmp(value, "true");
+            capture->messages = realloc(
+                capture->messages, (capture->messages_count + 1) * sizeof(InfraredMessage));
+            capture->messages[capture->messages_count++] = message;
+        }
+    }
+
+    free(line);
+    fclose(file);
+    return true;
+}
+
+/* Same comparison as infrared unit test */
+static bool
+    bench_message_is_equal(const InfraredMessage* decoded, const InfraredMessage* expected) {
+    bool repeat = decoded->repeat == expected->repeat;
+    if((expected->protocol == InfraredProtocolSIRC) ||
+       (expected->protocol == InfraredProtocolSIRC15) ||
+       (expected->protocol == InfraredProtocolSIRC20)) {
+        repeat = !decoded->repeat;
+    }
+    return (decoded->protocol == expected->protocol) && (decoded->command == expected->command) &&
+           (decoded->address == expected->address) && repeat;
+}
+
+static void bench_report(
+    const Capture* capture,
+    const InfraredMessage* message,
+    size_t* count,
+    bool* match) {
+    if(match && ((*count >= capture->messages_count) ||
+                 !bench_message_is_equal(message, &capture->messages[*count]))) {
+        *match = false;
+    }
+    ++*count;
+}
+
+/* Replays timings as infrared unit test does: check by timeout, then decode
+ * edge. Returns amount of decoded messages, compares them with expected ones
+ * if match is given. */
+static size_t bench_replay(InfraredDecoderHandler* handler, const Capture* capture, bool* match) {
+    size_t count = 0;
+    bool level = false;
+
+    for(size_t i = 0; i < capture->timings_count; i++) {
+        const InfraredMessage* message = NULL;
+        InfraredMessage message_check;
+
+        if(capture->timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+            message = infrared_check_decoder_ready(handler);
+            if(message) {
+                message_check = *message;
+                bench_report(capture, &message_check, &count, match);
+            }
+        }
+
+        message = infrared_decode(handler, level, capture->timings[i]);
+        if(message) {
+            bench_report(capture, message, &count, match);
+        }
+        level = !level;
+    }
+
+    const InfraredMessage* message = infrared_check_decoder_ready(handler);
+    if(message) {
+        bench_report(capture, message, &count, match);
+    }
+
+    return count;
+}
+
+static bool bench_verify(const Captures* captures) {
+    bool result = true;
+
+    for(size_t i = 0; i < captures->count; i++) {
+        const Capture* capture = &captures->items[i];
+        if(!capture->timings_count) continue;
+
+        InfraredDecoderHandler* handler = infrared_alloc_decoder();
+        bool match = true;
+        size_t count = bench_replay(handler, capture, &match);
+        match = match && (count == capture->messages_count);
+        infrared_free_decoder(handler);
+
+        if(!match) {
+            printf(
+                "%s decoder_input%s: %zu of %zu messages MISMATCH\n",
+                capture->path,
+                capture->name,
+                count,
+                capture->messages_count);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+static void bench_run(const Captures* captures) {
+    InfraredDecoderHandler* handler = infrared_alloc_decoder();
+    size_t edges = 0;
+    size_t messages = 0;
+
+    double start = bench_now();
+    for(size_t round = 0; round < ROUNDS; round++) {
+        for(size_t i = 0; i < captures->count; i++) {
+            messages += bench_replay(handler, &captures->items[i], NULL);
+            edges += captures->items[i].timings_count;
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    printf(
+        "%zu edges, %zu messages, %.2f Medges/s, %.1f ns/edge\n",
+        edges,
+        messages,
+        edges / elapsed / 1e6,
+        elapsed * 1e9 / edges);
+    printf("decoder      edges  skipped  messages  timeout  latency avg/max, us\n");
+    for(size_t i = 0; i < sizeof(bench_decoders) / sizeof(bench_decoders[0]); i++) {
+        InfraredDecoderStats stats;
+        if(!infrared_get_decoder_stats(handler, bench_decoders[i], &stats)) continue;
+        printf(
+            "%-10s %8" PRIu32 " %7.1f%% %9" PRIu32 " %8" PRIu32 " %9.0f/%" PRIu32 "\n",
+            infrared_get_protocol_name(bench_decoders[i]),
+            stats.edges,
+            100.0 * stats.skipped_edges / (stats.edges + stats.skipped_edges),
+            stats.messages,
+            stats.timeout_messages,
+            stats.messages ? (double)stats.latency_sum / stats.messages : 0.0,
+            stats.latency_max);
+    }
+
+    infrared_free_decoder(handler);
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        fprintf(stderr, "Usage: %s FILE.irtest...\n", argv[0]);
+        return 1;
+    }
+
+    Captures captures = {0};
+    for(int i = 1; i < argc; i++) {
+        if(!bench_load(&captures, argv[i])) {
+            fprintf(stderr, "Can't read %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    bool match = bench_verify(&captures);
+    printf("%zu captures %s\n", captures.count, match ? "ok" : "MISMATCH");
+    bench_run(&captures);
+
+    for(size_t i = 0; i < captures.count; i++) {
+        free(captures.items[i].timings);
+        free(captures.items[i].messages);
+    }
+    free(captures.items);
+    return match ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+/* Host replacement of furi check.h for infrared decoder bench */
+#pragma once
+
+#include <stdlib.h>
+
+#define furi_check(__e) \
+    do {                \
+        if(!(__e)) {    \
+            abort();    \
+        }               \
+    } while(0)
+
+#define furi_assert(__e) furi_check(__e)
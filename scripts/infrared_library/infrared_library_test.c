@@ -0,0 +1,529 @@
+/* Host tests of compiled infrared library: text to binary and back.
+ *
+ *   cc -O2 -iquote ../../applications/main/infrared -I ../../lib/infrared/encoder_decoder \
+ *       -I ../../firmware/targets/furi_hal_include \
+ *       -o infrared_library_test infrared_library_test.c \
+ *       ../../applications/main/infrared/infrared_library.c
+ *   ./infrared_library_test ../../assets/resources/infrared/assets/tv.ir
+ *
+ * Libraries given as arguments are compiled, written back as text and
+ * compiled again, both binaries and both texts have to match.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "infrared_library.h"
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    size_t pos;
+} Memory;
+
+typedef struct {
+    const char* name;
+    uint8_t address_length;
+    uint8_t command_length;
+} Protocol;
+
+/* Same as protocol variants in lib/infrared */
+static const Protocol protocols[InfraredProtocolMAX] = {
+    [InfraredProtocolNEC] = {"NEC", 8, 8},
+    [InfraredProtocolNECext] = {"NECext", 16, 16},
+    [InfraredProtocolNEC42] = {"NEC42", 13, 8},
+    [InfraredProtocolNEC42ext] = {"NEC42ext", 26, 16},
+    [InfraredProtocolSamsung32] = {"Samsung32", 8, 8},
+    [InfraredProtocolRC6] = {"RC6", 8, 8},
+    [InfraredProtocolRC5] = {"RC5", 5, 6},
+    [InfraredProtocolRC5X] = {"RC5X", 5, 7},
+    [InfraredProtocolSIRC] = {"SIRC", 5, 7},
+    [InfraredProtocolSIRC15] = {"SIRC15", 8, 7},
+    [InfraredProtocolSIRC20] = {"SIRC20", 13, 7},
+    [InfraredProtocolKaseikyo] = {"Kaseikyo", 26, 10},
+};
+
+static unsigned failed;
+static unsigned passed;
+
+bool infrared_is_protocol_valid(InfraredProtocol protocol) {
+    return protocol >= 0 && protocol < InfraredProtocolMAX;
+}
+
+const char* infrared_get_protocol_name(InfraredProtocol protocol) {
+    return protocols[protocol].name;
+}
+
+InfraredProtocol infrared_get_protocol_by_name(const char* protocol_name) {
+    for(InfraredProtocol protocol = 0; protocol < InfraredProtocolMAX; ++protocol) {
+        if(!strcmp(protocols[protocol].name, protocol_name)) return protocol;
+    }
+    return InfraredProtocolUnknown;
+}
+
+uint8_t infrared_get_protocol_address_length(InfraredProtocol protocol) {
+    return protocols[protocol].address_length;
+}
+
+uint8_t infrared_get_protocol_command_length(InfraredProtocol protocol) {
+    return protocols[protocol].command_length;
+}
+
+static bool memory_write(void* context, const void* data, size_t size) {
+    Memory* memory = context;
+    if(memory->size + size > memory->capacity) {
+        memory->capacity = (memory->size + size) * 2;
+        memory->data = realloc(memory->data, memory->capacity);
+    }
+    memcpy(&memory->data[memory->size], data, size);
+    memory->size += size;
+    return true;
+}
+
+static size_t memory_read(void* context, void* data, size_t size) {
+    Memory* memory = context;
+    if(size > memory->size - memory->pos) size = memory->size - memory->pos;
+    memcpy(data, &memory->data[memory->pos], size);
+    memory->pos += size;
+    return size;
+}
+
+static bool memory_seek(void* context, uint32_t offset) {
+    Memory* memory = context;
+    if(offset > memory->size) return false;
+    memory->pos = offset;
+    return true;
+}
+
+static void check(const char* name, bool condition) {
+    if(!condition) {
+        printf("FAIL %s\n", name);
+        failed++;
+    } else {
+        passed++;
+    }
+}
+
+/* Compiled library as written on SD card: header first */
+static void compile(const char* text, size_t size, size_t feed_chunk, Memory* library) {
+    InfraredLibraryHeader header = {0};
+    memset(library, 0, sizeof(Memory));
+    memory_write(library, &header, sizeof(header));
+
+    InfraredLibraryCompiler* compiler = infrared_library_compiler_alloc(memory_write, library);
+    for(size_t pos = 0; pos < size; pos += feed_chunk) {
+        size_t chunk = (size - pos < feed_chunk) ? (size - pos) : feed_chunk;
+        infrared_library_compiler_feed(compiler, &text[pos], chunk);
+    }
+    check("compile", infrared_library_compiler_finish(compiler, &header));
+    infrared_library_compiler_free(compiler);
+    memcpy(library->data, &header, sizeof(header));
+}
+
+static InfraredLibrary* load(Memory* library) {
+    InfraredLibraryHeader header;
+    memcpy(&header, library->data, sizeof(header));
+    InfraredLibrary* reader = infrared_library_alloc(memory_read, memory_seek, library);
+    if(!infrared_library_load(reader, &header)) {
+        infrared_library_free(reader);
+        reader = NULL;
+    }
+    return reader;
+}
+
+static char* decompile(Memory* library) {
+    Memory text = {0};
+    InfraredLibrary* reader = load(library);
+    check("load", reader != NULL);
+    if(reader) {
+        check("write text", infrared_library_write_text(reader, memory_write, &text));
+        infrared_library_free(reader);
+    }
+    memory_write(&text, "", 1);
+    return (char*)text.data;
+}
+
+/* Total records size of name, as stored in index */
+static uint32_t reader_name_size(Memory* library, uint16_t name) {
+    InfraredLibraryHeader header;
+    InfraredLibraryName entry;
+    memcpy(&header, library->data, sizeof(header));
+    memcpy(
+        &entry, &library->data[header.index_offset + name * sizeof(entry)], sizeof(entry));
+    return entry.size;
+}
+
+/* Compiled data without source size and hash */
+static bool same_library(Memory* a, Memory* b) {
+    const size_t skip = sizeof(InfraredLibraryHeader);
+    InfraredLibraryHeader header_a;
+    InfraredLibraryHeader header_b;
+    memcpy(&header_a, a->data, sizeof(header_a));
+    memcpy(&header_b, b->data, sizeof(header_b));
+    header_a.source_size = header_b.source_size = 0;
+    header_a.source_hash = header_b.source_hash = 0;
+    return (a->size == b->size) && !memcmp(&header_a, &header_b, sizeof(header_a)) &&
+           !memcmp(&a->data[skip], &b->data[skip], a->size - skip);
+}
+
+static const char* canonical_text = "Filetype: IR library file\n"
+                                    "Version: 1\n"
+                                    "# \n"
+                                    "name: Power\n"
+                                    "type: parsed\n"
+                                    "protocol: NEC\n"
+                                    "address: 07 00 00 00\n"
+                                    "command: 02 00 00 00\n"
+                                    "# \n"
+                                    "name: Vol_up\n"
+                                    "type: parsed\n"
+                                    "protocol: Kaseikyo\n"
+                                    "address: 41 54 32 00\n"
+                                    "command: 05 02 00 00\n"
+                                    "# \n"
+                                    "name: Power\n"
+                                    "type: raw\n"
+                                    "frequency: 38000\n"
+                                    "duty_cycle: 0.330000\n"
+                                    "data: 9024 4512 564 1692 564 564 127 128 16383 16384 "
+                                    "2097152\n"
+                                    "# \n"
+                                    "name: Mute\n"
+                                    "type: parsed\n"
+                                    "protocol: SIRC20\n"
+                                    "address: FF 1F 00 00\n"
+                                    "command: 7F 00 00 00\n";
+
+static void test_round_trip(void) {
+    Memory library;
+    compile(canonical_text, strlen(canonical_text), 4096, &library);
+    char* text = decompile(&library);
+    check("round trip text", strcmp(text, canonical_text) == 0);
+    free(text);
+
+    InfraredLibrary* reader = load(&library);
+    uint16_t name = 0;
+    check("find Power", infrared_library_find_name(reader, "Power", &name));
+    check("Power count", infrared_library_get_signal_count(reader, name) == 2);
+    check("find Mute", infrared_library_find_name(reader, "Mute", &name));
+    check("Mute count", infrared_library_get_signal_count(reader, name) == 1);
+    check("no Ch_next", !infrared_library_find_name(reader, "Ch_next", &name));
+    check("name is exact", !infrared_library_find_name(reader, "power", &name));
+
+    infrared_library_find_name(reader, "Power", &name);
+    InfraredLibrarySweep* sweep = infrared_library_sweep_alloc(reader, name);
+    InfraredLibraryRecord record;
+    uint32_t timings[INFRARED_LIBRARY_TIMINGS_MAX];
+    check("sweep", sweep && infrared_library_sweep_get_count(sweep) == 2);
+    check("sweep first", infrared_library_sweep_next(sweep, &record, timings));
+    check(
+        "sweep parsed",
+        record.type == InfraredLibrarySignalTypeParsed && record.protocol == InfraredProtocolNEC &&
+            record.parsed.address == 0x07 && record.parsed.command == 0x02);
+    check("sweep second", infrared_library_sweep_next(sweep, &record, timings));
+    check(
+        "sweep raw",
+        record.type == InfraredLibrarySignalTypeRaw && record.raw.frequency == 38000 &&
+            record.raw.duty_cycle == 0.33f && record.raw.timings_count == 11 &&
+            timings[0] == 9024 && timings[9] == 16384 && timings[10] == 2097152);
+    check("sweep end", !infrared_library_sweep_next(sweep, &record, timings));
+    // Sweep buffer is sized from index, parsed record plus raw record with 11 timings
+    check(
+        "sweep size",
+        reader_name_size(&library, name) == 2 * sizeof(InfraredLibraryRecord) + 24);
+    infrared_library_sweep_reset(sweep);
+    check("sweep reset", infrared_library_sweep_next(sweep, &record, timings));
+    check("sweep reset first", record.type == InfraredLibrarySignalTypeParsed);
+    infrared_library_sweep_free(sweep);
+    infrared_library_free(reader);
+    free(library.data);
+}
+
+static void test_text_variants(void) {
+    Memory expected;
+    Memory library;
+    const size_t size = strlen(canonical_text);
+    compile(canonical_text, size, 4096, &expected);
+
+    const size_t chunks[] = {1, 2, 3, 7, 64};
+    for(size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        compile(canonical_text, size, chunks[i], &library);
+        check("feed chunks", same_library(&expected, &library));
+        free(library.data);
+    }
+
+    // Windows line ends, no line end at the end, comments and other keys between signals
+    char* crlf = malloc(size * 2 + 1);
+    size_t crlf_size = 0;
+    for(size_t i = 0; i < size; i++) {
+        if(canonical_text[i] == '\n') crlf[crlf_size++] = '\r';
+        crlf[crlf_size++] = canonical_text[i];
+    }
+    compile(crlf, crlf_size - 2, 4096, &library);
+    check("windows line ends", same_library(&expected, &library));
+    free(library.data);
+    free(crlf);
+
+    const char* loose = "Filetype: IR library file\n"
+                        "Version: 1\n"
+                        "# Power: not a key\n"
+                        "name: Power\n"
+                        "type: parsed\n"
+                        "protocol: NEC\n"
+                        "address:\t07 00 00 00 \n"
+                        "command: 02 00 00 00\n"
+                        "\n"
+                        ": skipped\n"
+                        "name: Vol_up\n"
+                        "type: parsed\n"
+                        "protocol: Kaseikyo\n"
+                        "address: 41 54 32 00 FF\n"
+                        "command: 05 02 00 00\n"
+                        "comment: other key\n"
+                        "name: Power\n"
+                        "type: raw\n"
+                        "frequency: 38000\n"
+                        "duty_cycle: 0.33\n"
+                        "data:  9024 4512 564 1692 564 564 127 128 16383 16384 2097152  \n"
+                        "#\n"
+                        "name: Mute\n"
+                        "type: parsed\n"
+                        "protocol: SIRC20\n"
+                        "address: ff 1f 00 00\n"
+                        "command: 7F 00 00 00";
+    compile(loose, strlen(loose), 5, &library);
+    check("loose text", same_library(&expected, &library));
+    free(library.data);
+    free(expected.data);
+}
+
+static const char* invalid_text = "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: NEC\n"
+                                  "address: 07 01 00 00\n" // out of NEC range
+                                  "command: 02 00 00 00\n"
+                                  "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: Sony\n"
+                                  "address: 07 00 00 00\n"
+                                  "command: 02 00 00 00\n"
+                                  "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: NEC\n"
+                                  "command: 02 00 00 00\n" // out of order
+                                  "address: 07 00 00 00\n"
+                                  "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: NEC\n"
+                                  "address: 07 00 00\n" // too few bytes
+                                  "command: 02 00 00 00\n"
+                                  "name: A\n"
+                                  "type: raw\n"
+                                  "frequency: 5000\n"
+                                  "duty_cycle: 0.33\n"
+                                  "data: 100 200\n"
+                                  "name: A\n"
+                                  "type: raw\n"
+                                  "frequency: 38000\n"
+                                  "duty_cycle: 1.5\n"
+                                  "data: 100 200\n"
+                                  "name: A\n"
+                                  "type: raw\n"
+                                  "frequency: 38000\n"
+                                  "duty_cycle: 0.33\n"
+                                  "data: 100 x\n"
+                                  "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: NEC\n"
+                                  "name: A\n"
+                                  "type: unknown\n"
+                                  "name: A\n"
+                                  "type: parsed\n"
+                                  "protocol: NEC\n"
+                                  "address: 07 00 00 00\n"
+                                  "command: 02 00 00 00\n";
+
+static void test_invalid(void) {
+    Memory library;
+    compile(invalid_text, strlen(invalid_text), 4096, &library);
+    InfraredLibrary* reader = load(&library);
+    uint16_t name = 0;
+    check("invalid find", infrared_library_find_name(reader, "A", &name));
+    InfraredLibrarySweep* sweep = infrared_library_sweep_alloc(reader, name);
+    InfraredLibraryRecord record;
+    uint32_t timings[INFRARED_LIBRARY_TIMINGS_MAX];
+    check("invalid count", infrared_library_sweep_get_count(sweep) == 10);
+    for(size_t i = 0; i < 9; i++) {
+        infrared_library_sweep_next(sweep, &record, timings);
+        check("invalid signal", record.type == InfraredLibrarySignalTypeInvalid);
+    }
+    infrared_library_sweep_next(sweep, &record, timings);
+    check("valid after invalid", record.type == InfraredLibrarySignalTypeParsed);
+    infrared_library_sweep_free(sweep);
+    infrared_library_free(reader);
+
+    // Invalid records survive text round trip
+    char* text = decompile(&library);
+    Memory again;
+    compile(text, strlen(text), 4096, &again);
+    check("invalid round trip", same_library(&library, &again));
+    free(again.data);
+    free(text);
+    free(library.data);
+
+    // Too many timings for worker
+    const char* head = "name: Long\ntype: raw\nfrequency: 38000\nduty_cycle: 0.33\ndata:";
+    Memory long_text = {0};
+    memory_write(&long_text, head, strlen(head));
+    for(size_t i = 0; i < INFRARED_LIBRARY_TIMINGS_MAX + 1; i++) {
+        memory_write(&long_text, " 500", 4);
+    }
+    compile((char*)long_text.data, long_text.size, 4096, &library);
+    reader = load(&library);
+    infrared_library_find_name(reader, "Long", &name);
+    sweep = infrared_library_sweep_alloc(reader, name);
+    infrared_library_sweep_next(sweep, &record, timings);
+    check("too many timings", record.type == InfraredLibrarySignalTypeInvalid);
+    infrared_library_sweep_free(sweep);
+    infrared_library_free(reader);
+    free(library.data);
+
+    // Exactly as many as worker takes
+    long_text.size -= 4;
+    compile((char*)long_text.data, long_text.size, 4096, &library);
+    reader = load(&library);
+    infrared_library_find_name(reader, "Long", &name);
+    sweep = infrared_library_sweep_alloc(reader, name);
+    infrared_library_sweep_next(sweep, &record, timings);
+    check(
+        "max timings",
+        record.type == InfraredLibrarySignalTypeRaw &&
+            record.raw.timings_count == INFRARED_LIBRARY_TIMINGS_MAX &&
+            timings[INFRARED_LIBRARY_TIMINGS_MAX - 1] == 500);
+    infrared_library_sweep_free(sweep);
+    infrared_library_free(reader);
+    free(library.data);
+    free(long_text.data);
+}
+
+static void test_header(void) {
+    Memory library;
+    const size_t size = strlen(canonical_text);
+    compile(canonical_text, size, 4096, &library);
+    InfraredLibraryHeader header;
+    memcpy(&header, library.data, sizeof(header));
+    uint32_t hash = infrared_library_hash(INFRARED_LIBRARY_HASH_INIT, canonical_text, size);
+    check("header valid", infrared_library_header_is_valid(&header, size, hash));
+    check("header text changed", !infrared_library_header_is_valid(&header, size, hash + 1));
+    check("header size changed", !infrared_library_header_is_valid(&header, size + 1, hash));
+    header.magic = 0;
+    check("header magic", !infrared_library_header_is_valid(&header, size, hash));
+
+    // Broken index
+    memcpy(&header, library.data, sizeof(header));
+    header.index_size = sizeof(InfraredLibraryName);
+    memcpy(library.data, &header, sizeof(header));
+    InfraredLibrary* reader = load(&library);
+    check("short index", reader == NULL);
+    library.size -= 2;
+    memcpy(&header, library.data, sizeof(header));
+    header.index_size = library.size - header.index_offset + 2;
+    memcpy(library.data, &header, sizeof(header));
+    reader = load(&library);
+    check("truncated index", reader == NULL);
+    free(library.data);
+}
+
+static char* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = malloc(*size + 1);
+    *size = fread(data, 1, *size, file);
+    data[*size] = '\0';
+    fclose(file);
+    return data;
+}
+
+static void test_library_file(const char* path) {
+    size_t size = 0;
+    char* source = read_file(path, &size);
+    check(path, source != NULL);
+    if(!source) return;
+
+    Memory library;
+    Memory again;
+    compile(source, size, 512, &library);
+    char* text = decompile(&library);
+    compile(text, strlen(text), 512, &again);
+    char* text_again = decompile(&again);
+    check("library binary round trip", same_library(&library, &again));
+    check("library text round trip", strcmp(text, text_again) == 0);
+
+    InfraredLibraryHeader header;
+    memcpy(&header, library.data, sizeof(header));
+    size_t names = 0;
+    size_t raw = 0;
+    for(const char* line = source; line; line = strchr(line, '\n')) {
+        if(*line == '\n') line++;
+        if(!strncmp(line, "name:", 5)) names++;
+        if(!strncmp(line, "type: raw", 9)) raw++;
+    }
+    check("library signal count", header.signal_count == names);
+
+    InfraredLibrary* reader = load(&library);
+    size_t parsed_count = 0;
+    size_t raw_count = 0;
+    size_t invalid_count = 0;
+    size_t sweep_count = 0;
+    uint32_t* timings = malloc(sizeof(uint32_t) * INFRARED_LIBRARY_TIMINGS_MAX);
+    for(uint16_t name = 0; reader && name < header.name_count; name++) {
+        InfraredLibrarySweep* sweep = infrared_library_sweep_alloc(reader, name);
+        InfraredLibraryRecord record;
+        while(infrared_library_sweep_next(sweep, &record, timings)) {
+            sweep_count++;
+            check("sweep name", record.name == name);
+            if(record.type == InfraredLibrarySignalTypeParsed) parsed_count++;
+            if(record.type == InfraredLibrarySignalTypeRaw) raw_count++;
+            if(record.type == InfraredLibrarySignalTypeInvalid) invalid_count++;
+        }
+        infrared_library_sweep_free(sweep);
+    }
+    free(timings);
+    check("library sweeps cover all signals", sweep_count == names);
+    check("library raw signals", raw_count == raw);
+    printf(
+        "%s: %zu bytes text, %zu bytes compiled, %zu parsed, %zu raw, %zu invalid\n",
+        path,
+        size,
+        library.size,
+        parsed_count,
+        raw_count,
+        invalid_count);
+
+    if(reader) infrared_library_free(reader);
+    free(text_again);
+    free(text);
+    free(again.data);
+    free(library.data);
+    free(source);
+}
+
+int main(int argc, char** argv) {
+    test_round_trip();
+    test_text_variants();
+    test_invalid();
+    test_header();
+    for(int i = 1; i < argc; i++) {
+        test_library_file(argv[i]);
+    }
+
+    printf("%u passed, %u failed\n", passed, failed);
+    return failed ? 1 : 0;
+}
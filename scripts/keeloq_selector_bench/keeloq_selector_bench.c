@@ -0,0 +1,270 @@
+/* Host benchmark of KeeLoq manufacture key search on a synthetic keystore.
+ *
+ *   S=../../lib/subghz
+ *   cc -O2 -I ../subghz_dispatch_bench/stub -I ../../furi -I ../.. -I ../../lib \
+ *       -I ../../lib/mlib -I $S -o keeloq_selector_bench keeloq_selector_bench.c \
+ *       ../subghz_dispatch_bench/stub/stub.c $S/protocols/keeloq_common.c $S/blocks/[a-z]*.c -lm
+ *   ./keeloq_selector_bench [KEYS]
+ *
+ * Fills the keystore with KEYS random keys (10000 by default) of every learning type under
+ * 64 manufacture names, some keys listed twice, and searches parcels encrypted with keys from
+ * across the keystore plus random parcels. With this many keys the 8 bit discriminator lets
+ * some key match almost any parcel, so the first match in keystore order is what counts.
+ * Search is done two ways: key by key the way the selector did it before batching, and by
+ * the batched selector of keeloq.c, which this file includes to reach it. Both must find
+ * the same manufacture, counter and learning type for every parcel. Services and headers
+ * come from the Sub-GHz dispatch bench stub.
+ */
+
+#include <subghz/protocols/keeloq.c>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KEYS_DEFAULT (10000U)
+#define NAMES (64U)
+#define HITS (64U)
+#define RANDOMS (8U)
+#define SEED (0x1A2B3C4DU)
+
+typedef struct {
+    uint32_t fix;
+    uint32_t hop;
+    const char* mfname; /* Empty to search every manufacture */
+} Parcel;
+
+typedef struct {
+    uint8_t found;
+    const char* name;
+    uint16_t cnt;
+    uint8_t kl_type;
+} BenchResult;
+
+typedef uint8_t (*BenchSelector)(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    const char** manufacture_name);
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_random(uint64_t index) {
+    /* splitmix64 */
+    uint64_t z = (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Man keys of a keystore entry in the order the key by key search tried them */
+static size_t bench_man(
+    const SubGhzKey* code,
+    uint32_t fix,
+    uint32_t seed,
+    uint64_t* man,
+    uint8_t* kl_type) {
+    const uint64_t key = code->key;
+    const uint64_t rev = subghz_protocol_keeloq_mirror_key(key);
+    size_t count = 0;
+
+    switch(code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        man[count++] = key;
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man[count++] = subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        man[count++] = key;
+        man[count++] = rev;
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        man[count++] = subghz_protocol_keeloq_common_normal_learning(fix, rev);
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+        man[count++] = subghz_protocol_keeloq_common_secure_learning(fix, seed, rev);
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        man[count++] = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, rev);
+        break;
+    }
+    for(size_t i = 0; i < count; i++) {
+        kl_type[i] = code->type == KEELOQ_LEARNING_UNKNOWN ? i / 2 + 1 : 0;
+    }
+
+    return count;
+}
+
+/* Key by key search over the keystore array, as the selector did it before batching */
+static uint8_t bench_legacy_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    const char** manufacture_name) {
+    const uint8_t btn = fix >> 28;
+    const uint16_t end_serial = fix & 0xFF;
+    const char* mfname = keystore->mfname;
+    uint64_t man[8];
+    uint8_t kl_type[8];
+
+    if(strcmp(mfname, "Unknown") == 0) {
+        return 1;
+    }
+    bool mf_not_set = strcmp(mfname, "") == 0;
+
+    for
+        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
+            const char* name = furi_string_get_cstr(manufacture_code->name);
+            if(!mf_not_set && strcmp(name, mfname) != 0) continue;
+            size_t count = bench_man(manufacture_code, fix, instance->seed, man, kl_type);
+            for(size_t i = 0; i < count; i++) {
+                uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man[i]);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = name;
+                    keystore->mfname = name;
+                    if(kl_type[i]) keystore->kl_type = kl_type[i];
+                    return 1;
+                }
+            }
+        }
+
+    *manufacture_name = "Unknown";
+    keystore->mfname = "Unknown";
+    instance->cnt = 0;
+    return 0;
+}
+
+static double bench_run(
+    BenchSelector selector,
+    SubGhzKeystore* keystore,
+    const Parcel* parcels,
+    size_t count,
+    BenchResult* results) {
+    double start = bench_now();
+    for(size_t i = 0; i < count; i++) {
+        SubGhzBlockGeneric instance = {.seed = SEED};
+        keystore->mfname = parcels[i].mfname;
+        keystore->kl_type = 0;
+        results[i].found = selector(
+            &instance, parcels[i].fix, parcels[i].hop, keystore, &results[i].name);
+        results[i].cnt = instance.cnt;
+        results[i].kl_type = keystore->kl_type;
+    }
+    return bench_now() - start;
+}
+
+int main(int argc, char** argv) {
+    size_t keys = argc > 1 ? strtoul(argv[1], NULL, 0) : KEYS_DEFAULT;
+    if(keys == 0) {
+        fprintf(stderr, "Usage: %s [KEYS]\n", argv[0]);
+        return 1;
+    }
+
+    char names[NAMES][16];
+    for(size_t i = 0; i < NAMES; i++) {
+        snprintf(names[i], sizeof(names[i]), "Bench_%02zu", i);
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    for(size_t i = 0; i < keys; i++) {
+        SubGhzKey* code = SubGhzKeyArray_push_raw(*subghz_keystore_get_data(keystore));
+        code->name = furi_string_alloc();
+        furi_string_set_str(code->name, names[bench_random(i ^ 0x5A5A) % NAMES]);
+        /* Some keys are listed twice, first entry in keystore order must win */
+        code->key = bench_random(i % 101 == 100 ? i - 50 : i);
+        code->type = bench_random(i ^ 0xA5A5) % (KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 + 1);
+    }
+    subghz_keystore_get_index(keystore);
+
+    Parcel parcels[HITS + RANDOMS];
+    uint64_t man[8];
+    uint8_t kl_type[8];
+    for(size_t i = 0; i < HITS + RANDOMS; i++) {
+        Parcel* parcel = &parcels[i];
+        parcel->fix = (uint32_t)(i % 4 + 1) << 28 | (bench_random(keys + i) & 0x0FFFFFFF);
+        parcel->mfname = "";
+        if(i >= HITS) {
+            parcel->hop = bench_random(2 * keys + i);
+            continue;
+        }
+
+        size_t target = (i * keys) / HITS;
+        const SubGhzKey* code = NULL;
+        size_t count = 0;
+        for(; count == 0; target = (target + 1) % keys) {
+            code = SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), target);
+            count = bench_man(code, parcel->fix, SEED, man, kl_type);
+        }
+        uint32_t data = (parcel->fix & 0xF0000000) | (parcel->fix & 0xFF) << 16 | i;
+        parcel->hop = subghz_protocol_keeloq_common_encrypt(data, man[i % count]);
+        if(i % 4 == 3) {
+            parcel->mfname = furi_string_get_cstr(code->name);
+        }
+    }
+
+    BenchResult legacy[HITS + RANDOMS];
+    BenchResult batched[HITS + RANDOMS];
+    double legacy_time =
+        bench_run(bench_legacy_selector, keystore, parcels, HITS + RANDOMS, legacy);
+    double batched_time = bench_run(
+        subghz_protocol_keeloq_check_remote_controller_selector,
+        keystore,
+        parcels,
+        HITS + RANDOMS,
+        batched);
+
+    size_t found = 0;
+    size_t mismatch = 0;
+    for(size_t i = 0; i < HITS + RANDOMS; i++) {
+        found += legacy[i].found;
+        if(legacy[i].found != batched[i].found || strcmp(legacy[i].name, batched[i].name) ||
+           legacy[i].cnt != batched[i].cnt || legacy[i].kl_type != batched[i].kl_type) {
+            mismatch++;
+            printf(
+                "parcel %zu: legacy %s cnt %04" PRIx16 " type %" PRIu8
+                ", batched %s cnt %04" PRIx16 " type %" PRIu8 "\n",
+                i,
+                legacy[i].name,
+                legacy[i].cnt,
+                legacy[i].kl_type,
+                batched[i].name,
+                batched[i].cnt,
+                batched[i].kl_type);
+        }
+    }
+
+    printf(
+        "%zu keys, %u names, %u parcels, %zu found\n", keys, NAMES, HITS + RANDOMS, found);
+    printf("legacy  %8.3f ms/parcel\n", legacy_time * 1e3 / (HITS + RANDOMS));
+    printf(
+        "batched %8.3f ms/parcel %5.2fx%s\n",
+        batched_time * 1e3 / (HITS + RANDOMS),
+        legacy_time / batched_time,
+        mismatch ? " MISMATCH" : "");
+
+    subghz_environment_free(environment);
+
+    return mismatch ? 1 : 0;
+}
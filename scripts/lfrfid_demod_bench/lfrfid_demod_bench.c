@@ -0,0 +1,475 @@
+/* Host replay of LF RFID captures through shared and per protocol demodulation.
+ *
+ *   cc -O2 -I stub -I ../../furi -I ../../lib -I ../.. \
+ *       -o lfrfid_demod_bench lfrfid_demod_bench.c \
+ *       $(ls ../../lib/lfrfid/protocols/[lp]*.c | grep -v hitag1) \
+ *       ../../lib/lfrfid/tools/bit_lib.c ../../lib/lfrfid/tools/fsk_demod.c \
+ *       ../../lib/lfrfid/tools/fsk_ocs.c ../../lib/lfrfid/tools/varint_pair.c \
+ *       ../../lib/toolbox/protocols/protocol_dict.c ../../lib/toolbox/varint.c \
+ *       ../../lib/toolbox/manchester_decoder.c ../../lib/toolbox/hex.c \
+ *       ../../lib/toolbox/pulse_protocols/pulse_glue.c -lm
+ *   ./lfrfid_demod_bench [FILE.ask.raw | FILE.psk.raw]...
+ *
+ * Captures are files written by lfrfid_raw_file (rfid raw_read), pairs are fed
+ * as read worker does, with ASK or PSK feature taken from file name. Without
+ * files, captures are synthesized from encoders of ASK protocols.
+ *
+ * Shared pipeline is ProtocolDict, demodulator of each kind runs once per
+ * edge. Per protocol pipeline gives every decoder its own demodulator
+ * instance, as decoders did before demodulators were shared. Both pipelines
+ * must decode the same protocols at the same edges, then edges per second
+ * and cycles per edge are measured.
+ * stub/ provides host versions of furi headers used by protocols.
+ */
+
+#include <furi.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/tools/varint_pair.h>
+
+#include <inttypes.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+#define ROUNDS (16U)
+
+#define RAW_FILE_MAGIC (0x4C464952UL)
+#define RAW_FILE_VERSION (1U)
+
+#define DATA_SIZE_MAX (32U)
+
+#define SYNTH_YIELDS (20000U)
+#define SYNTH_TIMING_MULTIPLIER (8U) /**< Same as LF_RFID_READ_TIMING_MULTIPLIER */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} RawFileHeader;
+
+typedef struct {
+    uint32_t pulse;
+    uint32_t duration;
+} Pair;
+
+typedef struct {
+    char name[64];
+    uint32_t feature;
+    Pair* pairs;
+    size_t pairs_count;
+} Capture;
+
+typedef struct {
+    Capture* items;
+    size_t count;
+} Captures;
+
+typedef struct {
+    size_t edge;
+    ProtocolId protocol;
+    uint8_t data[DATA_SIZE_MAX];
+} Decode;
+
+typedef struct {
+    Decode* items;
+    size_t count;
+} Decodes;
+
+/* Decoder with private demodulator */
+typedef struct {
+    const ProtocolBase* base;
+    void* data;
+    void* demod;
+} PrivateDemodDecoder;
+
+/* Decoder set fed the way ProtocolDict fed decoders before demodulators were
+ * shared: one feed call per decoder and edge, demodulation inside */
+typedef struct {
+    ProtocolDecoderFeed feed[LFRFIDProtocolMax];
+    void* context[LFRFIDProtocolMax];
+    PrivateDemodDecoder decoders[LFRFIDProtocolMax];
+} PerProtocol;
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static Capture* bench_capture_add(Captures* captures, const char* name, uint32_t feature) {
+    captures->items = realloc(captures->items, (captures->count + 1) * sizeof(Capture));
+    Capture* capture = &captures->items[captures->count++];
+    memset(capture, 0, sizeof(Capture));
+    snprintf(capture->name, sizeof(capture->name), "%s", name);
+    capture->feature = feature;
+    return capture;
+}
+
+static void bench_capture_push(Capture* capture, uint32_t pulse, uint32_t duration) {
+    capture->pairs = realloc(capture->pairs, (capture->pairs_count + 1) * sizeof(Pair));
+    capture->pairs[capture->pairs_count++] = (Pair){.pulse = pulse, .duration = duration};
+}
+
+/* Buffer sizes are size_t of firmware, 4 bytes */
+static bool bench_load(Captures* captures, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+
+    RawFileHeader header;
+    bool result = (fread(&header, sizeof(header), 1, file) == 1) &&
+                  (header.magic == RAW_FILE_MAGIC) && (header.version == RAW_FILE_VERSION);
+
+    const char* name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    size_t length = strlen(name);
+    bool psk = (length > strlen(".psk.raw")) &&
+               !strcmp(name + length - strlen(".psk.raw"), ".psk.raw");
+    Capture* capture =
+        result ? bench_capture_add(captures, name, psk ? LFRFIDFeaturePSK : LFRFIDFeatureASK) :
+                 NULL;
+
+    uint8_t* buffer = result ? malloc(header.max_buffer_size) : NULL;
+    uint32_t size;
+    while(result && fread(&size, sizeof(size), 1, file) == 1) {
+        if(size > header.max_buffer_size || fread(buffer, 1, size, file) != size) {
+            result = false;
+            break;
+        }
+
+        for(size_t index = 0; index < size;) {
+            uint32_t pulse, duration;
+            size_t pair_size;
+            if(!varint_pair_unpack(&buffer[index], size - index, &pulse, &duration, &pair_size)) {
+                break;
+            }
+            index += pair_size;
+            bench_capture_push(capture, pulse, duration);
+        }
+    }
+
+    free(buffer);
+    fclose(file);
+    return result;
+}
+
+/* Captures of ASK protocol encoders glued as read timer sees them. PSK
+ * encoders yield emulation timings read side doesn't see, and protocols that
+ * reject test data are skipped */
+static void bench_synthesize(Captures* captures) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    PulseGlue* glue = pulse_glue_alloc();
+    uint8_t data[DATA_SIZE_MAX];
+
+    for(size_t protocol = 0; protocol < LFRFIDProtocolMax; protocol++) {
+        size_t data_size = protocol_dict_get_data_size(dict, protocol);
+        furi_check(data_size <= sizeof(data));
+        for(size_t i = 0; i < data_size; i++) {
+            data[i] = (uint8_t)(0x5A + 37 * i + protocol);
+        }
+        protocol_dict_set_data(dict, protocol, data, data_size);
+        if(!(protocol_dict_get_features(dict, protocol) & LFRFIDFeatureASK)) continue;
+        if(!protocol_dict_encoder_start(dict, protocol)) continue;
+
+        Capture* capture =
+            bench_capture_add(captures, protocol_dict_get_name(dict, protocol), LFRFIDFeatureASK);
+
+        for(size_t i = 0; i < SYNTH_YIELDS; i++) {
+            LevelDuration level_duration = protocol_dict_encoder_yield(dict, protocol);
+            if(pulse_glue_push(
+                   glue,
+                   level_duration_get_level(level_duration),
+                   level_duration_get_duration(level_duration) * SYNTH_TIMING_MULTIPLIER)) {
+                uint32_t length, period;
+                pulse_glue_pop(glue, &length, &period);
+                bench_capture_push(capture, period, length);
+            }
+        }
+    }
+
+    pulse_glue_free(glue);
+    protocol_dict_free(dict);
+}
+
+static bool bench_private_demod_feed(PrivateDemodDecoder* decoder, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+    decoder->base->decoder.demod->feed(decoder->demod, level, duration, &value, &count);
+    return count > 0 && decoder->base->decoder.feed_bits(decoder->data, value, count);
+}
+
+static PerProtocol* bench_per_protocol_alloc(void) {
+    PerProtocol* set = malloc(sizeof(PerProtocol));
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        PrivateDemodDecoder* decoder = &set->decoders[i];
+        decoder->base = lfrfid_protocols[i];
+        decoder->data = decoder->base->alloc();
+        decoder->demod = NULL;
+
+        if(decoder->base->decoder.demod) {
+            decoder->demod = decoder->base->decoder.demod->alloc();
+            set->feed[i] = (ProtocolDecoderFeed)bench_private_demod_feed;
+            set->context[i] = decoder;
+        } else {
+            set->feed[i] = decoder->base->decoder.feed;
+            set->context[i] = decoder->data;
+        }
+    }
+
+    return set;
+}
+
+static void bench_per_protocol_free(PerProtocol* set) {
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        PrivateDemodDecoder* decoder = &set->decoders[i];
+        decoder->base->free(decoder->data);
+        if(decoder->demod) decoder->base->decoder.demod->free(decoder->demod);
+    }
+
+    free(set);
+}
+
+/* Some decoders leave data bits they can't decode as they were, so data is
+ * cleared for both pipelines to start from the same state */
+static void bench_dict_start(ProtocolDict* dict) {
+    const uint8_t zero[DATA_SIZE_MAX] = {0};
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        protocol_dict_set_data(dict, i, zero, protocol_dict_get_data_size(dict, i));
+    }
+    protocol_dict_decoders_start(dict);
+}
+
+static void bench_per_protocol_start(PerProtocol* set) {
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        PrivateDemodDecoder* decoder = &set->decoders[i];
+        memset(decoder->base->get_data(decoder->data), 0, decoder->base->data_size);
+        decoder->base->decoder.start(decoder->data);
+    }
+}
+
+static ProtocolId
+    bench_per_protocol_feed(PerProtocol* set, uint32_t feature, bool level, uint32_t duration) {
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        if(lfrfid_protocols[i]->features & feature) {
+            if(set->feed[i](set->context[i], level, duration)) {
+                if(ready_protocol_id == PROTOCOL_NO) ready_protocol_id = i;
+            }
+        }
+    }
+
+    return ready_protocol_id;
+}
+
+static void bench_decode_push(
+    Decodes* decodes,
+    size_t edge,
+    ProtocolId protocol,
+    const uint8_t* data,
+    size_t data_size) {
+    furi_check(data_size <= DATA_SIZE_MAX);
+    decodes->items = realloc(decodes->items, (decodes->count + 1) * sizeof(Decode));
+    Decode* decode = &decodes->items[decodes->count++];
+    memset(decode, 0, sizeof(Decode));
+    decode->edge = edge;
+    decode->protocol = protocol;
+    memcpy(decode->data, data, data_size);
+}
+
+/* Pairs are fed as read worker does: pulse, then rest of period if pulse
+ * gave nothing */
+static size_t bench_replay_shared(ProtocolDict* dict, const Capture* capture, Decodes* decodes) {
+    size_t count = 0;
+
+    for(size_t i = 0; i < capture->pairs_count; i++) {
+        const Pair* pair = &capture->pairs[i];
+        ProtocolId protocol =
+            protocol_dict_decoders_feed_by_feature(dict, capture->feature, true, pair->pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol = protocol_dict_decoders_feed_by_feature(
+                dict, capture->feature, false, pair->duration - pair->pulse);
+        }
+        if(protocol != PROTOCOL_NO) {
+            if(decodes) {
+                uint8_t data[DATA_SIZE_MAX];
+                size_t data_size = protocol_dict_get_data_size(dict, protocol);
+                protocol_dict_get_data(dict, protocol, data, data_size);
+                bench_decode_push(decodes, i, protocol, data, data_size);
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static size_t
+    bench_replay_per_protocol(PerProtocol* set, const Capture* capture, Decodes* decodes) {
+    size_t count = 0;
+
+    for(size_t i = 0; i < capture->pairs_count; i++) {
+        const Pair* pair = &capture->pairs[i];
+        ProtocolId protocol = bench_per_protocol_feed(set, capture->feature, true, pair->pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol = bench_per_protocol_feed(
+                set, capture->feature, false, pair->duration - pair->pulse);
+        }
+        if(protocol != PROTOCOL_NO) {
+            if(decodes) {
+                const PrivateDemodDecoder* decoder = &set->decoders[protocol];
+                bench_decode_push(
+                    decodes,
+                    i,
+                    protocol,
+                    decoder->base->get_data(decoder->data),
+                    decoder->base->data_size);
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static bool bench_verify(const Captures* captures) {
+    bool result = true;
+
+    for(size_t i = 0; i < captures->count; i++) {
+        const Capture* capture = &captures->items[i];
+        Decodes shared = {0};
+        Decodes per_protocol = {0};
+
+        ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+        bench_dict_start(dict);
+        bench_replay_shared(dict, capture, &shared);
+
+        PerProtocol* set = bench_per_protocol_alloc();
+        bench_per_protocol_start(set);
+        bench_replay_per_protocol(set, capture, &per_protocol);
+
+        /* Decoders see the same bits in both pipelines, so decodes must be
+         * the same up to edge and data */
+        bool match = (shared.count == per_protocol.count) &&
+                     !memcmp(shared.items, per_protocol.items, shared.count * sizeof(Decode));
+
+        printf(
+            "%-24s %s %8zu edges %6zu decodes",
+            capture->name,
+            capture->feature == LFRFIDFeaturePSK ? "PSK" : "ASK",
+            capture->pairs_count,
+            shared.count);
+        if(shared.count) {
+            printf(", first %s", protocol_dict_get_name(dict, shared.items[0].protocol));
+        }
+        printf("%s\n", match ? "" : " MISMATCH");
+        result = result && match;
+
+        bench_per_protocol_free(set);
+        protocol_dict_free(dict);
+        free(shared.items);
+        free(per_protocol.items);
+    }
+
+    return result;
+}
+
+typedef struct {
+    double elapsed;
+    uint64_t cycles;
+} Timing;
+
+static void bench_timing_update(Timing* timing, double start, uint64_t cycles) {
+    double elapsed = bench_now() - start;
+    cycles = BENCH_CYCLES() - cycles;
+    if(timing->elapsed == 0 || elapsed < timing->elapsed) timing->elapsed = elapsed;
+    if(timing->cycles == 0 || cycles < timing->cycles) timing->cycles = cycles;
+}
+
+static void bench_report(const char* name, size_t edges, const Timing* timing) {
+    printf(
+        "%-13s %.2f Medges/s, %6.1f ns/edge, %7.1f cycles/edge\n",
+        name,
+        edges / timing->elapsed / 1e6,
+        timing->elapsed * 1e9 / edges,
+        (double)timing->cycles / edges);
+}
+
+/* Pipelines take turns, so both see the same clock and cache conditions, best
+ * round of each is reported */
+static void bench_run(const Captures* captures) {
+    size_t edges = 0;
+    for(size_t i = 0; i < captures->count; i++) {
+        edges += captures->items[i].pairs_count;
+    }
+    if(!edges) return;
+
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    bench_dict_start(dict);
+    PerProtocol* set = bench_per_protocol_alloc();
+    bench_per_protocol_start(set);
+
+    size_t decodes = 0;
+    size_t per_protocol_decodes = 0;
+    Timing shared = {0};
+    Timing per_protocol = {0};
+
+    for(size_t round = 0; round < ROUNDS; round++) {
+        double start = bench_now();
+        uint64_t cycles = BENCH_CYCLES();
+        for(size_t i = 0; i < captures->count; i++) {
+            decodes += bench_replay_shared(dict, &captures->items[i], NULL);
+        }
+        bench_timing_update(&shared, start, cycles);
+
+        start = bench_now();
+        cycles = BENCH_CYCLES();
+        for(size_t i = 0; i < captures->count; i++) {
+            per_protocol_decodes += bench_replay_per_protocol(set, &captures->items[i], NULL);
+        }
+        bench_timing_update(&per_protocol, start, cycles);
+    }
+
+    bench_report("shared", edges, &shared);
+    bench_report("per protocol", edges, &per_protocol);
+    if(decodes != per_protocol_decodes) {
+        printf("decodes differ: %zu shared, %zu per protocol\n", decodes, per_protocol_decodes);
+    }
+
+    bench_per_protocol_free(set);
+    protocol_dict_free(dict);
+}
+
+int main(int argc, char** argv) {
+    Captures captures = {0};
+
+    for(int i = 1; i < argc; i++) {
+        if(!bench_load(&captures, argv[i])) {
+            fprintf(stderr, "Can't read %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if(argc < 2) {
+        bench_synthesize(&captures);
+    }
+
+    bool match = bench_verify(&captures);
+    printf("%zu captures %s\n", captures.count, match ? "ok" : "MISMATCH");
+    bench_run(&captures);
+
+    for(size_t i = 0; i < captures.count; i++) {
+        free(captures.items[i].pairs);
+    }
+    free(captures.items);
+    return match ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+/* Host replacement of furi.h for LF RFID demodulator bench */
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/core_defines.h>
+#include <core/check.h>
+
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_E(tag, ...)
+
+/* Only render functions use strings, bench never prints them */
+typedef struct {
+    char text[256];
+} FuriString;
+
+static inline void furi_string_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(string->text, sizeof(string->text), format, args);
+    va_end(args);
+}
+
+static inline void furi_string_cat_printf(FuriString* string, const char format[], ...) {
+    size_t length = strlen(string->text);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(string->text + length, sizeof(string->text) - length, format, args);
+    va_end(args);
+}
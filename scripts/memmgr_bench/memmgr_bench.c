@@ -0,0 +1,394 @@
+/* Host replay of firmware heap allocation traces, heap only vs slab + heap.
+ *
+ *   cc -O2 -DMEMMGR_SLAB_HOST -iquote ../../furi/core -o memmgr_bench \
+ *       memmgr_bench.c ../../furi/core/memmgr_slab.c
+ *   ./memmgr_bench [--heap SIZE] trace.log
+ *   ./memmgr_bench [--heap SIZE] --synthetic COUNT [SEED]
+ *
+ * Trace is console output of firmware built with HEAP_PRINT_DEBUG:
+ * "{thread|m|0xADDR|SIZE}" and "{thread|f|0xADDR}" records, other lines are
+ * ignored. SIZE there is heap block size, header is subtracted on replay.
+ *
+ * Heap model follows furi/core/memmgr_heap.c: address ordered first fit free
+ * list with coalescing, 8 byte block header and alignment, as on target.
+ */
+
+#include "memmgr_slab.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEAP_HEADER_SIZE 8U
+#define HEAP_ALIGNMENT 8U
+#define HEAP_MINIMUM_BLOCK_SIZE (HEAP_HEADER_SIZE * 2)
+#define HEAP_NONE UINT32_MAX
+#define HEAP_SIZE_DEFAULT (180U * 1024U)
+#define SLAB_ARENA_SIZE (MEMMGR_SLAB_PAGES_MAX * MEMMGR_SLAB_PAGE_SIZE)
+#define FRAGMENTATION_SAMPLE_PERIOD 64
+
+typedef enum {
+    OpMalloc,
+    OpFree,
+} OpType;
+
+typedef struct {
+    OpType type;
+    uint32_t id; /**< allocation identifier, address in firmware trace */
+    uint32_t size;
+} Op;
+
+typedef struct {
+    Op* ops;
+    size_t count;
+    size_t capacity;
+} Trace;
+
+/* Block header, offsets instead of pointers to keep 32 bit layout on host */
+typedef struct {
+    uint32_t next;
+    uint32_t size;
+} HeapBlock;
+
+typedef struct {
+    uint8_t* memory;
+    uint32_t size;
+    uint32_t free_head;
+    uint32_t free_bytes;
+} Heap;
+
+typedef struct {
+    uint32_t* keys;
+    void** values;
+    size_t capacity;
+} PointerMap;
+
+static double host_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static HeapBlock* heap_block(Heap* heap, uint32_t offset) {
+    return (HeapBlock*)&heap->memory[offset];
+}
+
+static void heap_init(Heap* heap, uint32_t size) {
+    heap->memory = calloc(1, size);
+    heap->size = size;
+    heap->free_head = 0;
+    heap->free_bytes = size;
+    heap_block(heap, 0)->next = HEAP_NONE;
+    heap_block(heap, 0)->size = size;
+}
+
+static void heap_insert(Heap* heap, uint32_t offset) {
+    uint32_t previous = HEAP_NONE;
+    uint32_t next = heap->free_head;
+    while(next != HEAP_NONE && next < offset) {
+        previous = next;
+        next = heap_block(heap, next)->next;
+    }
+
+    HeapBlock* block = heap_block(heap, offset);
+    if(next != HEAP_NONE && offset + block->size == next) {
+        block->size += heap_block(heap, next)->size;
+        block->next = heap_block(heap, next)->next;
+    } else {
+        block->next = next;
+    }
+
+    if(previous == HEAP_NONE) {
+        heap->free_head = offset;
+    } else if(previous + heap_block(heap, previous)->size == offset) {
+        heap_block(heap, previous)->size += block->size;
+        heap_block(heap, previous)->next = block->next;
+    } else {
+        heap_block(heap, previous)->next = offset;
+    }
+}
+
+static void* heap_malloc(Heap* heap, size_t size) {
+    uint32_t wanted = size + HEAP_HEADER_SIZE;
+    wanted = (wanted + HEAP_ALIGNMENT - 1) & ~(HEAP_ALIGNMENT - 1);
+    if(size == 0 || wanted > heap->free_bytes) return NULL;
+
+    uint32_t previous = HEAP_NONE;
+    uint32_t offset = heap->free_head;
+    while(offset != HEAP_NONE && heap_block(heap, offset)->size < wanted) {
+        previous = offset;
+        offset = heap_block(heap, offset)->next;
+    }
+    if(offset == HEAP_NONE) return NULL;
+
+    HeapBlock* block = heap_block(heap, offset);
+    uint32_t next = block->next;
+    if(block->size - wanted > HEAP_MINIMUM_BLOCK_SIZE) {
+        uint32_t split = offset + wanted;
+        heap_block(heap, split)->size = block->size - wanted;
+        heap_block(heap, split)->next = next;
+        next = split;
+        block->size = wanted;
+    }
+    if(previous == HEAP_NONE) {
+        heap->free_head = next;
+    } else {
+        heap_block(heap, previous)->next = next;
+    }
+
+    heap->free_bytes -= block->size;
+    block->next = HEAP_NONE;
+    return &heap->memory[offset + HEAP_HEADER_SIZE];
+}
+
+static void heap_free(Heap* heap, void* ptr) {
+    uint32_t offset = (uint8_t*)ptr - heap->memory - HEAP_HEADER_SIZE;
+    heap->free_bytes += heap_block(heap, offset)->size;
+    heap_insert(heap, offset);
+}
+
+static uint32_t heap_max_free_block(Heap* heap) {
+    uint32_t max_block = 0;
+    for(uint32_t offset = heap->free_head; offset != HEAP_NONE;
+        offset = heap_block(heap, offset)->next) {
+        if(heap_block(heap, offset)->size > max_block) max_block = heap_block(heap, offset)->size;
+    }
+    return max_block;
+}
+
+static void pointer_map_init(PointerMap* map, size_t capacity) {
+    map->capacity = 1;
+    while(map->capacity < capacity * 2) map->capacity <<= 1;
+    map->keys = malloc(sizeof(uint32_t) * map->capacity);
+    map->values = calloc(map->capacity, sizeof(void*));
+}
+
+static void pointer_map_free(PointerMap* map) {
+    free(map->keys);
+    free(map->values);
+}
+
+static size_t pointer_map_slot(PointerMap* map, uint32_t key) {
+    size_t slot = (key * 2654435761U) & (map->capacity - 1);
+    while(map->values[slot] && map->keys[slot] != key) {
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    return slot;
+}
+
+static void pointer_map_put(PointerMap* map, uint32_t key, void* value) {
+    size_t slot = pointer_map_slot(map, key);
+    map->keys[slot] = key;
+    map->values[slot] = value;
+}
+
+static void* pointer_map_take(PointerMap* map, uint32_t key) {
+    size_t slot = pointer_map_slot(map, key);
+    void* value = map->values[slot];
+    if(!value) return NULL;
+
+    // Backward shift deletion keeps probe chains intact
+    map->values[slot] = NULL;
+    size_t next = (slot + 1) & (map->capacity - 1);
+    while(map->values[next]) {
+        uint32_t next_key = map->keys[next];
+        void* next_value = map->values[next];
+        map->values[next] = NULL;
+        pointer_map_put(map, next_key, next_value);
+        next = (next + 1) & (map->capacity - 1);
+    }
+    return value;
+}
+
+static void trace_push(Trace* trace, OpType type, uint32_t id, uint32_t size) {
+    if(trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 1024;
+        trace->ops = realloc(trace->ops, sizeof(Op) * trace->capacity);
+    }
+    trace->ops[trace->count++] = (Op){.type = type, .id = id, .size = size};
+}
+
+static bool trace_load(Trace* trace, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) {
+        perror(path);
+        return false;
+    }
+
+    char line[256];
+    while(fgets(line, sizeof(line), file)) {
+        char* record = strchr(line, '{');
+        if(!record) continue;
+        char* type = strchr(record, '|');
+        if(!type) continue;
+
+        unsigned long address = 0;
+        unsigned long size = 0;
+        if(sscanf(type, "|m|0x%lx|%lu}", &address, &size) == 2) {
+            size = size > HEAP_HEADER_SIZE ? size - HEAP_HEADER_SIZE : 1;
+            trace_push(trace, OpMalloc, address, size);
+        } else if(sscanf(type, "|f|0x%lx}", &address) == 1 && address) {
+            trace_push(trace, OpFree, address, 0);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+/* Mix resembling firmware: many short lived small objects, few big buffers */
+static void trace_synthesize(Trace* trace, size_t count, uint32_t seed) {
+    const size_t live_max = 400;
+    uint32_t* live = malloc(sizeof(uint32_t) * live_max);
+    size_t live_count = 0;
+    uint32_t next_id = 1;
+    srand(seed);
+
+    for(size_t i = 0; i < count; i++) {
+        bool do_free = live_count == live_max || (live_count > 0 && rand() % 100 < 48);
+        if(do_free) {
+            size_t index = rand() % live_count;
+            trace_push(trace, OpFree, live[index], 0);
+            live[index] = live[--live_count];
+        } else {
+            uint32_t size;
+            int kind = rand() % 100;
+            if(kind < 80) {
+                size = 8 + rand() % 121;
+            } else if(kind < 97) {
+                size = 129 + rand() % 896;
+            } else {
+                size = 1024 + rand() % 3073;
+            }
+            trace_push(trace, OpMalloc, next_id, size);
+            live[live_count++] = next_id++;
+        }
+    }
+
+    free(live);
+}
+
+static void replay(const Trace* trace, uint32_t heap_size, bool use_slab) {
+    Heap heap;
+    heap_init(&heap, heap_size);
+    MemmgrSlab slab;
+    memset(&slab, 0, sizeof(slab));
+    // Unused arena counts as free heap, as in firmware
+    uint32_t slab_free = 0;
+    if(use_slab) {
+        void* arena = heap_malloc(&heap, SLAB_ARENA_SIZE);
+        memmgr_slab_init(&slab, arena, SLAB_ARENA_SIZE);
+        slab_free = SLAB_ARENA_SIZE;
+    }
+
+    PointerMap map;
+    pointer_map_init(&map, trace->count);
+
+    size_t failed = 0;
+    uint32_t fragmentation_max = 0;
+    uint32_t free_min = heap.free_bytes + slab_free;
+    double start = host_time();
+
+    for(size_t i = 0; i < trace->count; i++) {
+        const Op* op = &trace->ops[i];
+        if(op->type == OpMalloc) {
+            void* ptr = use_slab ? memmgr_slab_alloc(&slab, op->size) : NULL;
+            if(ptr) {
+                slab_free -= memmgr_slab_get_size(&slab, ptr);
+            } else {
+                ptr = heap_malloc(&heap, op->size);
+            }
+            if(ptr) {
+                pointer_map_put(&map, op->id, ptr);
+            } else {
+                failed++;
+            }
+        } else {
+            void* ptr = pointer_map_take(&map, op->id);
+            if(!ptr) continue;
+            if(use_slab && memmgr_slab_contains(&slab, ptr)) {
+                slab_free += memmgr_slab_get_size(&slab, ptr);
+                memmgr_slab_free(&slab, ptr);
+            } else {
+                heap_free(&heap, ptr);
+            }
+        }
+
+        if(heap.free_bytes + slab_free < free_min) free_min = heap.free_bytes + slab_free;
+        if(i % FRAGMENTATION_SAMPLE_PERIOD == 0 && heap.free_bytes) {
+            uint32_t fragmentation = 100 - heap_max_free_block(&heap) * 100ULL / heap.free_bytes;
+            if(fragmentation > fragmentation_max) fragmentation_max = fragmentation;
+        }
+    }
+
+    double elapsed = host_time() - start;
+    uint32_t max_block = heap_max_free_block(&heap);
+    printf(
+        "%-11s %8zu ops, %.1f ns/op, %zu failed, min free %" PRIu32 ", "
+        "end free %" PRIu32 " max block %" PRIu32 ", fragmentation end %" PRIu32
+        "%% worst %" PRIu32 "%%\n",
+        use_slab ? "slab + heap" : "heap",
+        trace->count,
+        elapsed * 1e9 / (trace->count ? trace->count : 1),
+        failed,
+        free_min,
+        heap.free_bytes + slab_free,
+        max_block,
+        heap.free_bytes ? (uint32_t)(100 - max_block * 100ULL / heap.free_bytes) : 0,
+        fragmentation_max);
+
+    if(use_slab) {
+        MemmgrSlabStats stats;
+        memmgr_slab_get_stats(&slab, &stats);
+        for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+            const MemmgrSlabClassStats* size_class = &stats.classes[i];
+            printf(
+                "  class %3u: %8" PRIu32 " allocs, %6" PRIu32 " fallbacks, %" PRIu32
+                " bytes waste\n",
+                size_class->object_size,
+                size_class->allocations,
+                size_class->fallbacks,
+                size_class->allocations * size_class->object_size - size_class->requested);
+        }
+    }
+
+    pointer_map_free(&map);
+    free(heap.memory);
+}
+
+int main(int argc, char** argv) {
+    uint32_t heap_size = HEAP_SIZE_DEFAULT;
+    const char* path = NULL;
+    size_t synthetic = 0;
+    uint32_t seed = 1;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--heap") == 0 && i + 1 < argc) {
+            heap_size = strtoul(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc) {
+            synthetic = strtoul(argv[++i], NULL, 0);
+            if(i + 1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            path = argv[i];
+        }
+    }
+
+    Trace trace = {0};
+    if(synthetic) {
+        trace_synthesize(&trace, synthetic, seed);
+    } else if(!path || !trace_load(&trace, path)) {
+        fprintf(
+            stderr,
+            "usage: %s [--heap SIZE] <trace.log | --synthetic COUNT [SEED]>\n",
+            argv[0]);
+        return 1;
+    }
+
+    replay(&trace, heap_size, false);
+    replay(&trace, heap_size, true);
+
+    free(trace.ops);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/* Host benchmark of key derivation for Picopass elite dictionary attack.
+ *
+ *   cc -O2 -I stub -I ../../applications/external/picopass/lib/loclass \
+ *       -o picopass_elite_dict_bench picopass_elite_dict_bench.c \
+ *       ../../applications/external/picopass/lib/loclass/optimized_*.c -l:libmbedcrypto.so.7
+ *   ./picopass_elite_dict_bench [KEYS]
+ *
+ * Derives diversified keys and reader MACs for a dictionary of random keys two ways: per key
+ * calc_div_key and doReaderMAC as the attack loop did before, and the producer stage of the
+ * attack pipeline that diversifies a batch of keys and computes their MACs with
+ * loclass_opt_doBatchReaderMAC. Both ways must produce the same MACs. stub/ provides
+ * mbedtls des.h header, DES itself is taken from the system mbedtls library.
+ */
+
+#include <optimized_cipher.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KEYS_DEFAULT (4096U)
+#define ROUNDS (8U)
+#define BATCH (8U)
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void bench_run_single(
+    uint8_t* csn,
+    uint8_t* ccnr,
+    uint8_t* keys,
+    size_t count,
+    bool elite,
+    uint8_t* macs) {
+    uint8_t div_key[8];
+    for(size_t i = 0; i < count; i++) {
+        loclass_iclass_calc_div_key(csn, &keys[i * 8], div_key, elite);
+        loclass_opt_doReaderMAC(ccnr, div_key, &macs[i * 4]);
+    }
+}
+
+static void bench_run_batch(
+    uint8_t* csn,
+    uint8_t* ccnr,
+    uint8_t* keys,
+    size_t count,
+    bool elite,
+    uint8_t* macs) {
+    uint8_t div_keys[BATCH * 8];
+    for(size_t i = 0; i < count; i += BATCH) {
+        size_t batch = count - i < BATCH ? count - i : BATCH;
+        for(size_t j = 0; j < batch; j++) {
+            loclass_iclass_calc_div_key(csn, &keys[(i + j) * 8], &div_keys[j * 8], elite);
+        }
+        loclass_opt_doBatchReaderMAC(ccnr, div_keys, batch, &macs[i * 4]);
+    }
+}
+
+typedef void (*BenchRun)(uint8_t*, uint8_t*, uint8_t*, size_t, bool, uint8_t*);
+
+static double bench_measure(
+    BenchRun run,
+    uint8_t* csn,
+    uint8_t* ccnr,
+    uint8_t* keys,
+    size_t count,
+    bool elite,
+    uint8_t* macs) {
+    double best = 0;
+    for(size_t round = 0; round < ROUNDS; round++) {
+        double start = bench_now();
+        run(csn, ccnr, keys, count, elite, macs);
+        double elapsed = bench_now() - start;
+        if(round == 0 || elapsed < best) best = elapsed;
+    }
+    return count / best;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 0) : KEYS_DEFAULT;
+    if(count == 0) {
+        fprintf(stderr, "Usage: %s [KEYS]\n", argv[0]);
+        return 1;
+    }
+
+    uint8_t csn[8] = {0x8D, 0xC0, 0x4E, 0x03, 0xFE, 0xFF, 0x12, 0xE0};
+    uint8_t ccnr[12] = {0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t* keys = malloc(count * 8);
+    uint8_t* single = malloc(count * 4);
+    uint8_t* batch = malloc(count * 4);
+    uint64_t state = 0x5DEECE66DULL;
+    for(size_t i = 0; i < count * 8; i++) {
+        keys[i] = bench_random(&state);
+    }
+    bool match = true;
+
+    printf("mode      single keys/s  batch keys/s\n");
+    for(size_t mode = 0; mode < 2; mode++) {
+        bool elite = mode == 0;
+        memset(single, 0, count * 4);
+        memset(batch, 0xFF, count * 4);
+        double single_rate =
+            bench_measure(bench_run_single, csn, ccnr, keys, count, elite, single);
+        double batch_rate = bench_measure(bench_run_batch, csn, ccnr, keys, count, elite, batch);
+        bool mode_match = memcmp(single, batch, count * 4) == 0;
+        printf(
+            "%-8s %14.0f %13.0f%s\n",
+            elite ? "elite" : "standard",
+            single_rate,
+            batch_rate,
+            mode_match ? "" : "  MISMATCH");
+        match = match && mode_match;
+    }
+
+    free(keys);
+    free(single);
+    free(batch);
+    printf("%zu keys per mode %s\n", count, match ? "ok" : "MISMATCH");
+    return match ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+/* Host replacement of mbedtls des.h for Picopass elite dictionary bench, matches the layout of
+ * system libmbedcrypto 2.28 */
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t sk[32];
+} mbedtls_des_context;
+
+int mbedtls_des_setkey_enc(mbedtls_des_context* ctx, const unsigned char key[8]);
+
+int mbedtls_des_setkey_dec(mbedtls_des_context* ctx, const unsigned char key[8]);
+
+int mbedtls_des_crypt_ecb(
+    mbedtls_des_context* ctx,
+    const unsigned char input[8],
+    unsigned char output[8]);
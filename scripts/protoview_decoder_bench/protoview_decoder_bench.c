@@ -0,0 +1,418 @@
+/* Host benchmark of ProtoView decoders on recorded and built signals.
+ *
+ *   P=../../applications/external/protoview
+ *   cc -O2 -I stub -I ../../furi -I $P -o protoview_decoder_bench protoview_decoder_bench.c \
+ *       $P/signal.c $P/raw_samples.c $P/fields.c $P/crc.c $P/protocols/[a-z]*.c \
+ *       $P/protocols/tpms/[a-z]*.c
+ *   ./protoview_decoder_bench ../../assets/unit_tests/subghz/[a-z]*_raw.sub
+ *
+ * Corpus is the RAW_Data of the given .sub recordings plus one message built
+ * by every decoder that supports building. Recordings are fed to a samples
+ * buffer as the radio callback does and scanned every half buffer, like
+ * the app does, built messages are scanned once as the build view does.
+ * Every coherent signal found is converted to a bitmap as decode_signal()
+ * does. Bitmap search and line code primitives are checked on every bitmap
+ * against bit at a time reference versions, then every decoder is timed
+ * on all the bitmaps. stub/ provides host versions of furi and gui headers.
+ */
+
+#include <app.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS (16U)
+#define MIN_DURATION (30U) /* Duration filter of the OOK presets */
+#define BITMAP_SIZE (4096U) /* Same as decode_signal() */
+#define BEFORE_SAMPLES (32U)
+#define AFTER_SAMPLES (100U)
+
+typedef struct {
+    uint8_t* data;
+    uint32_t bits;
+    uint32_t short_pulse_dur;
+} Bitmap;
+
+typedef struct {
+    Bitmap* items;
+    size_t count;
+} Bitmaps;
+
+/* Sync patterns of the decoders and line codes they use */
+static const char* bench_patterns[] = {
+    "01010101010101010110",
+    "10101010101010110",
+    "00111100",
+    "001111101",
+    "0101010101010110",
+    "010101010101" "01100101",
+    "1111010101" "01011010",
+    "101010101010101010101010" "0000",
+    "1010101010101010" "1100110011001010",
+    "01100110" "01100110" "10010110" "10010110",
+    "100000000000000000000000000000011101",
+    "1000000000000000000000000000000010001",
+    "1",
+    "0000000000000000000000000000000000000000000000000000000000000000",
+};
+
+static const char* bench_line_codes[][2] = {
+    {"01", "10"},
+    {"10", "01"},
+    {"1001", "0110"},
+    {"1000", "1110"},
+    {"100", "110"},
+    {"10", "1100"},
+};
+
+/* Defined in signal.c, not exported by app.h */
+extern ProtoViewDecoder* Decoders[];
+uint32_t search_coherent_signal(RawSamplesBuffer* s, uint32_t idx, uint32_t min_duration);
+uint32_t convert_signal_to_bits(
+    uint8_t* b,
+    uint32_t blen,
+    RawSamplesBuffer* s,
+    uint32_t idx,
+    uint32_t count,
+    uint32_t rate);
+
+/* Needed by scan_for_signal(), that the bench does not use */
+RawSamplesBuffer *RawSamples, *DetectedSamples;
+
+void adjust_raw_view_scale(ProtoViewApp* app, uint32_t short_pulse_dur) {
+    UNUSED(app);
+    UNUSED(short_pulse_dur);
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Reference implementations: the original bit at a time primitives */
+static bool ref_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits) {
+    for(size_t j = 0; bits[j]; j++) {
+        if(bitmap_get(b, blen, bitpos + j) != (bits[j] == '1')) return false;
+    }
+    return true;
+}
+
+static uint32_t ref_seek_bits(
+    uint8_t* b,
+    uint32_t blen,
+    uint32_t startpos,
+    uint32_t maxbits,
+    const char* bits) {
+    uint32_t endpos = startpos + blen * 8;
+    uint32_t end2 = startpos + maxbits;
+    if(end2 < endpos) endpos = end2;
+    for(uint32_t j = startpos; j < endpos; j++)
+        if(ref_match_bits(b, blen, j, bits)) return j;
+    return BITMAP_SEEK_NOT_FOUND;
+}
+
+static bool
+    ref_match_bitmap(uint8_t* b, uint32_t blen, uint32_t off1, uint32_t off2, uint32_t len) {
+    for(uint32_t j = 0; j < len; j++) {
+        if(bitmap_get(b, blen, off1 + j) != bitmap_get(b, blen, off2 + j)) return false;
+    }
+    return true;
+}
+
+static uint32_t ref_line_code(
+    uint8_t* buf,
+    uint64_t buflen,
+    uint8_t* bits,
+    uint32_t len,
+    uint32_t off,
+    const char* zero,
+    const char* one) {
+    uint32_t decoded = 0;
+    while(off < len * 8) {
+        bool bitval;
+        if(ref_match_bits(bits, len, off, zero)) {
+            bitval = false;
+            off += strlen(zero);
+        } else if(ref_match_bits(bits, len, off, one)) {
+            bitval = true;
+            off += strlen(one);
+        } else {
+            break;
+        }
+        bitmap_set(buf, buflen, decoded++, bitval);
+        if(decoded / 8 == buflen) break;
+    }
+    return decoded;
+}
+
+static uint32_t ref_diff_manchester(
+    uint8_t* buf,
+    uint64_t buflen,
+    uint8_t* bits,
+    uint32_t len,
+    uint32_t off,
+    bool previous) {
+    uint32_t decoded = 0;
+    for(uint32_t j = off; j < len * 8; j += 2) {
+        bool b0 = bitmap_get(bits, len, j);
+        bool b1 = bitmap_get(bits, len, j + 1);
+        if(b0 == previous) break;
+        bitmap_set(buf, buflen, decoded++, b0 == b1);
+        previous = b1;
+        if(decoded / 8 == buflen) break;
+    }
+    return decoded;
+}
+
+/* Scan the samples buffer as scan_for_signal() does, adding the bitmap of
+ * every coherent signal to the corpus as decode_signal() converts it. */
+static void bench_scan(Bitmaps* bitmaps, RawSamplesBuffer* samples, uint32_t min_duration) {
+    uint32_t i = 0;
+    while(i < samples->total - 1) {
+        uint32_t len = search_coherent_signal(samples, i, min_duration);
+        if(len > 18) {
+            uint32_t saved_idx = samples->idx;
+            raw_samples_center(samples, i);
+
+            Bitmap bitmap = {
+                .data = malloc(BITMAP_SIZE),
+                .short_pulse_dur = samples->short_pulse_dur,
+            };
+            bitmap.bits = convert_signal_to_bits(
+                bitmap.data,
+                BITMAP_SIZE,
+                samples,
+                -BEFORE_SAMPLES,
+                len + BEFORE_SAMPLES + AFTER_SAMPLES,
+                samples->short_pulse_dur);
+            samples->idx = saved_idx;
+
+            bitmaps->items = realloc(bitmaps->items, (bitmaps->count + 1) * sizeof(Bitmap));
+            bitmaps->items[bitmaps->count++] = bitmap;
+        }
+        i += len ? len : 1;
+    }
+}
+
+static bool bench_load(Bitmaps* bitmaps, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    RawSamplesBuffer* samples = raw_samples_alloc();
+    size_t count = 0;
+    char* line = NULL;
+    size_t capacity = 0;
+
+    while(getline(&line, &capacity, file) > 0) {
+        if(strncmp(line, "RAW_Data:", strlen("RAW_Data:"))) continue;
+        char* value = line + strlen("RAW_Data:");
+        char* end;
+        for(long duration; (duration = strtol(value, &end, 10)), end != value; value = end) {
+            raw_samples_add(samples, duration > 0, labs(duration));
+            if(++count % (RAW_SAMPLES_NUM / 2) == 0) bench_scan(bitmaps, samples, MIN_DURATION);
+        }
+    }
+    if(count % (RAW_SAMPLES_NUM / 2)) bench_scan(bitmaps, samples, MIN_DURATION);
+
+    raw_samples_free(samples);
+    free(line);
+    fclose(file);
+    return true;
+}
+
+/* One message with default fields for every decoder able to build them,
+ * scanned like the build message view does. */
+static void bench_build(Bitmaps* bitmaps) {
+    for(size_t i = 0; Decoders[i]; i++) {
+        if(!Decoders[i]->build_message) continue;
+        RawSamplesBuffer* samples = raw_samples_alloc();
+        ProtoViewFieldSet* fields = fieldset_new();
+        Decoders[i]->get_fields(fields);
+        Decoders[i]->build_message(samples, fields);
+        bench_scan(bitmaps, samples, 5);
+        fieldset_free(fields);
+        raw_samples_free(samples);
+    }
+}
+
+/* Compare the primitives with the reference ones on the bitmap */
+static bool bench_verify(const Bitmap* bitmap) {
+    uint8_t* b = bitmap->data;
+    uint8_t buf[2][64];
+    bool result = true;
+
+    for(size_t i = 0; i < COUNT_OF(bench_patterns); i++) {
+        const char* pattern = bench_patterns[i];
+        uint32_t start = 0;
+        while(result) {
+            uint32_t found = bitmap_seek_bits(b, BITMAP_SIZE, start, bitmap->bits, pattern);
+            result = found == ref_seek_bits(b, BITMAP_SIZE, start, bitmap->bits, pattern);
+            if(found >= bitmap->bits) break; /* Also matches zeros past the end */
+            start = found + 1;
+        }
+    }
+
+    for(uint32_t off = 0; off < bitmap->bits && result; off += 61) {
+        for(size_t i = 0; i < COUNT_OF(bench_line_codes); i++) {
+            const char** code = bench_line_codes[i];
+            uint32_t buflen = 1 + off % sizeof(buf[0]);
+            memset(buf, 0xA5, sizeof(buf));
+            uint32_t decoded[2] = {
+                convert_from_line_code(buf[0], buflen, b, BITMAP_SIZE, off, code[0], code[1]),
+                ref_line_code(buf[1], buflen, b, BITMAP_SIZE, off, code[0], code[1]),
+            };
+            result = result && decoded[0] == decoded[1];
+            result = result && !memcmp(buf[0], buf[1], sizeof(buf[0]));
+        }
+        for(int previous = 0; previous < 2; previous++) {
+            memset(buf, 0x5A, sizeof(buf));
+            uint32_t decoded[2] = {
+                convert_from_diff_manchester(buf[0], 64, b, BITMAP_SIZE, off, previous),
+                ref_diff_manchester(buf[1], 64, b, BITMAP_SIZE, off, previous),
+            };
+            result = result && decoded[0] == decoded[1];
+            result = result && !memcmp(buf[0], buf[1], sizeof(buf[0]));
+        }
+        uint32_t other = (off * 31) % bitmap->bits;
+        uint32_t len = 1 + off % 150;
+        result = result && bitmap_match_bitmap(b, BITMAP_SIZE, off, b, BITMAP_SIZE, other, len) ==
+                               ref_match_bitmap(b, BITMAP_SIZE, off, other, len);
+    }
+
+    /* Unknown decoder compares with offset UINT32_MAX, that wraps */
+    result = result && bitmap_match_bitmap(b, BITMAP_SIZE, 9, b, BITMAP_SIZE, UINT32_MAX, 4) ==
+                           ref_match_bitmap(b, BITMAP_SIZE, 9, UINT32_MAX, 4);
+
+    /* Reading past the end of the bitmap gives zeros */
+    result = result && convert_from_diff_manchester(buf[0], 8, b, 4, 20, 0) ==
+                           ref_diff_manchester(buf[1], 8, b, 4, 20, 0);
+    result = result && convert_from_line_code(buf[0], 8, b, 3, 18, "00", "01") ==
+                           ref_line_code(buf[1], 8, b, 3, 18, "00", "01");
+    result = result && bitmap_seek_bits(b, 2, 8, 64, "0000") == ref_seek_bits(b, 2, 8, 64, "0000");
+    return result;
+}
+
+/* Time every decoder on every bitmap, same order as decode_signal().
+ * Times are the best of ROUNDS runs on the whole corpus. */
+static void bench_run(const Bitmaps* bitmaps) {
+    size_t decoders = 0;
+    while(Decoders[decoders]) decoders++;
+    double* elapsed = calloc(decoders, sizeof(double));
+    double* best = calloc(decoders, sizeof(double));
+    size_t* decoded = calloc(decoders, sizeof(size_t));
+
+    for(size_t round = 0; round < ROUNDS; round++) {
+        memset(elapsed, 0, decoders * sizeof(double));
+        for(size_t i = 0; i < bitmaps->count; i++) {
+            const Bitmap* bitmap = &bitmaps->items[i];
+            for(size_t j = 0; j < decoders; j++) {
+                ProtoViewMsgInfo* info = malloc(sizeof(ProtoViewMsgInfo));
+                init_msg_info(info, NULL);
+                info->short_pulse_dur = bitmap->short_pulse_dur;
+
+                double start = bench_now();
+                bool result = Decoders[j]->decode(bitmap->data, BITMAP_SIZE, bitmap->bits, info);
+                elapsed[j] += bench_now() - start;
+
+                if(round == 0 && result) decoded[j]++;
+                free_msg_info(info);
+                if(result) break;
+            }
+        }
+        for(size_t j = 0; j < decoders; j++) {
+            if(round == 0 || elapsed[j] < best[j]) best[j] = elapsed[j];
+        }
+    }
+
+    double total = 0;
+    printf("decoder                  decoded  us/signal\n");
+    for(size_t j = 0; j < decoders; j++) {
+        printf(
+            "%-24s %7zu %10.2f\n",
+            Decoders[j]->name,
+            decoded[j],
+            best[j] * 1e6 / bitmaps->count);
+        total += best[j];
+    }
+    printf("all decoders %.1f us/signal\n", total * 1e6 / bitmaps->count);
+
+    free(decoded);
+    free(best);
+    free(elapsed);
+}
+
+/* Primitives alone on the corpus: sync search, then line code conversion
+ * at the match. Best of ROUNDS runs. */
+static double bench_primitives_run(const Bitmaps* bitmaps, bool ref, size_t* found) {
+    uint8_t buf[64];
+    double start = bench_now();
+    for(size_t i = 0; i < bitmaps->count; i++) {
+        uint8_t* b = bitmaps->items[i].data;
+        uint32_t bits = bitmaps->items[i].bits;
+        for(size_t j = 0; j < COUNT_OF(bench_patterns); j++) {
+            const char* pattern = bench_patterns[j];
+            uint32_t off = ref ? ref_seek_bits(b, BITMAP_SIZE, 0, bits, pattern) :
+                                 bitmap_seek_bits(b, BITMAP_SIZE, 0, bits, pattern);
+            if(off == BITMAP_SEEK_NOT_FOUND) off = 0;
+            for(size_t k = 0; k < COUNT_OF(bench_line_codes); k++) {
+                const char** code = bench_line_codes[k];
+                *found += ref ? ref_line_code(
+                                    buf, sizeof(buf), b, BITMAP_SIZE, off, code[0], code[1]) :
+                                convert_from_line_code(
+                                    buf, sizeof(buf), b, BITMAP_SIZE, off, code[0], code[1]);
+            }
+        }
+    }
+    return bench_now() - start;
+}
+
+static void bench_primitives(const Bitmaps* bitmaps) {
+    size_t found[2] = {0};
+    double best[2] = {0};
+
+    for(size_t round = 0; round < ROUNDS; round++) {
+        for(int ref = 0; ref < 2; ref++) {
+            double elapsed = bench_primitives_run(bitmaps, ref, &found[ref]);
+            if(round == 0 || elapsed < best[ref]) best[ref] = elapsed;
+        }
+    }
+
+    printf(
+        "seek + line code: bit at a time %.1f us/signal, word %.1f us/signal, %.1fx%s\n",
+        best[1] * 1e6 / bitmaps->count,
+        best[0] * 1e6 / bitmaps->count,
+        best[1] / best[0],
+        found[0] == found[1] ? "" : "  MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    Bitmaps bitmaps = {0};
+    for(int i = 1; i < argc; i++) {
+        if(!bench_load(&bitmaps, argv[i])) {
+            fprintf(stderr, "Can't read %s\n", argv[i]);
+            return 1;
+        }
+    }
+    bench_build(&bitmaps);
+
+    bool match = true;
+    for(size_t i = 0; i < bitmaps.count; i++) {
+        if(!bench_verify(&bitmaps.items[i])) {
+            printf("signal %zu: primitives MISMATCH\n", i);
+            match = false;
+        }
+    }
+    printf("%zu signals %s\n", bitmaps.count, match ? "ok" : "MISMATCH");
+    if(!bitmaps.count) return 1;
+
+    bench_primitives(&bitmaps);
+    bench_run(&bitmaps);
+
+    for(size_t i = 0; i < bitmaps.count; i++) free(bitmaps.items[i].data);
+    free(bitmaps.items);
+    return match ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/* Host replacement of furi.h for ProtoView decoder bench */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ctype.h>
+
+#include <core/core_defines.h>
+#include <core/check.h>
+
+/* Firmware heap returns zeroed memory and decoders rely on it */
+#define malloc(size) calloc(1, size)
+
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_I(tag, ...)
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    FuriMutexTypeNormal,
+} FuriMutexType;
+
+/* Bench is single threaded, samples buffers don't need locking */
+typedef struct FuriMutex FuriMutex;
+typedef struct FuriMessageQueue FuriMessageQueue;
+
+static inline FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    UNUSED(type);
+    return (FuriMutex*)1;
+}
+
+static inline void furi_mutex_free(FuriMutex* mutex) {
+    UNUSED(mutex);
+}
+
+static inline int furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout) {
+    UNUSED(mutex);
+    UNUSED(timeout);
+    return 0;
+}
+
+static inline int furi_mutex_release(FuriMutex* mutex) {
+    UNUSED(mutex);
+    return 0;
+}
+
+static inline uint32_t furi_get_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
@@ -0,0 +1,11 @@
+/* Host replacement of furi_hal.h for ProtoView decoder bench */
+#pragma once
+
+#include <furi.h>
+
+typedef enum {
+    FuriHalSubGhzPresetIDLE,
+} FuriHalSubGhzPreset;
+
+/* Radio is not used, transmit callback type is only named in app.h */
+typedef void* FuriHalSubGhzAsyncTxCallback;
@@ -0,0 +1,11 @@
+/* Host replacement of gui.h for ProtoView decoder bench, types named in app.h */
+#pragma once
+
+typedef struct Gui Gui;
+typedef struct ViewPort ViewPort;
+typedef struct Canvas Canvas;
+
+typedef enum {
+    ColorWhite,
+    ColorBlack,
+} Color;
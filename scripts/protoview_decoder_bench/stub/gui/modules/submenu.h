@@ -0,0 +1,2 @@
+/* Host replacement for ProtoView decoder bench, nothing from it is used */
+#pragma once
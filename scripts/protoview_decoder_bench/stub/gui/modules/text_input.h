@@ -0,0 +1,4 @@
+/* Host replacement of text_input.h for ProtoView decoder bench */
+#pragma once
+
+typedef struct TextInput TextInput;
@@ -0,0 +1,4 @@
+/* Host replacement of view_dispatcher.h for ProtoView decoder bench */
+#pragma once
+
+typedef struct ViewDispatcher ViewDispatcher;
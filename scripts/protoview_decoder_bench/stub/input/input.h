@@ -0,0 +1,7 @@
+/* Host replacement of input.h for ProtoView decoder bench */
+#pragma once
+
+typedef struct {
+    int key;
+    int type;
+} InputEvent;
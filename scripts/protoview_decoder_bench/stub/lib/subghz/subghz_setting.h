@@ -0,0 +1,4 @@
+/* Host replacement of subghz_setting.h for ProtoView decoder bench */
+#pragma once
+
+typedef struct SubGhzSetting SubGhzSetting;
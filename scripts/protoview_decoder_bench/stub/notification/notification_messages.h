@@ -0,0 +1,20 @@
+/* Host replacement of notification_messages.h for ProtoView decoder bench */
+#pragma once
+
+typedef struct NotificationApp NotificationApp;
+
+typedef struct {
+    int type;
+} NotificationMessage;
+
+typedef const NotificationMessage* NotificationSequence[];
+
+/* Bench never notifies, messages only need an address */
+static const NotificationMessage message_vibro_on, message_vibro_off, message_green_255,
+    message_green_0, message_red_255, message_red_0, message_delay_50;
+
+static inline void
+    notification_message(NotificationApp* app, const NotificationSequence* sequence) {
+    (void)app;
+    (void)sequence;
+}
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Build screen stream recording from animation frames for rpc_screen_delta_bench.
+
+Frames of each animation directory are taken in meta.txt "Frames order" when
+present, sorted by number otherwise, and written as 1024 byte display buffers.
+Only zlib is needed, pixels darker than mid gray are set, transparent are not.
+"""
+
+import argparse
+import os
+import re
+import struct
+import zlib
+
+WIDTH = 128
+HEIGHT = 64
+
+
+def png_read(path):
+    with open(path, "rb") as file:
+        data = file.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG")
+
+    offset = 8
+    idat = b""
+    palette = []
+    transparency = b""
+    while offset < len(data):
+        length, kind = struct.unpack(">I4s", data[offset : offset + 8])
+        chunk = data[offset + 8 : offset + 8 + length]
+        offset += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i : i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            transparency = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+    if interlace:
+        raise ValueError(f"{path}: interlaced PNG is not supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        row = bytearray(raw[y * (stride + 1) + 1 : (y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = row[i - bpp] if i >= bpp else 0
+            b = previous[i]
+            c = previous[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                row[i] = (row[i] + a) & 0xFF
+            elif kind == 2:
+                row[i] = (row[i] + b) & 0xFF
+            elif kind == 3:
+                row[i] = (row[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                predictor = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                row[i] = (row[i] + predictor) & 0xFF
+        rows.append(row)
+        previous = row
+
+    def sample(row, index):
+        if depth == 8:
+            return row[index]
+        bit = index * depth
+        return (row[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+
+    pixels = []
+    for row in rows:
+        line = []
+        for x in range(width):
+            if color == 3:
+                index = sample(row, x)
+                r, g, b = palette[index]
+                alpha = transparency[index] if index < len(transparency) else 255
+            elif color == 0:
+                r = g = b = sample(row, x) * 255 // ((1 << depth) - 1)
+                alpha = 255
+            elif color == 4:
+                r = g = b = row[x * 2]
+                alpha = row[x * 2 + 1]
+            else:
+                r, g, b = row[x * channels : x * channels + 3]
+                alpha = row[x * channels + 3] if channels == 4 else 255
+            line.append(alpha >= 128 and (r * 299 + g * 587 + b * 114) < 128000)
+        pixels.append(line)
+    return width, height, pixels
+
+
+def frame_buffer(path):
+    width, height, pixels = png_read(path)
+    buffer = bytearray(WIDTH * HEIGHT // 8)
+    for y in range(min(height, HEIGHT)):
+        for x in range(min(width, WIDTH)):
+            if pixels[y][x]:
+                buffer[(y // 8) * WIDTH + x] |= 1 << (y % 8)
+    return bytes(buffer)
+
+
+def animation_frames(directory):
+    names = [name for name in os.listdir(directory) if re.match(r"frame_\d+\.png$", name)]
+    names.sort(key=lambda name: int(re.findall(r"\d+", name)[0]))
+    order = None
+    meta = os.path.join(directory, "meta.txt")
+    if os.path.exists(meta):
+        with open(meta) as file:
+            for line in file:
+                if line.startswith("Frames order:"):
+                    order = [int(value) for value in line.split(":")[1].split()]
+    if order is None:
+        return [os.path.join(directory, name) for name in names]
+    return [os.path.join(directory, f"frame_{index}.png") for index in order]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("output", help="recording file")
+    parser.add_argument("directories", nargs="+", help="animation directories")
+    parser.add_argument("--cycles", type=int, default=1, help="times to play each animation")
+    args = parser.parse_args()
+
+    with open(args.output, "wb") as output:
+        for directory in args.directories:
+            frames = [frame_buffer(path) for path in animation_frames(directory)]
+            for _ in range(args.cycles):
+                for frame in frames:
+                    output.write(frame)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+/* Host replay of RPC screen stream frames, full frames vs delta stream.
+ *
+ *   cc -O2 -I ../../lib -o rpc_screen_delta_bench \
+ *       rpc_screen_delta_bench.c ../../lib/toolbox/delta_rle.c
+ *   ./png_frames.py kaiju.bin ../../assets/dolphin/external/L1_Kaiju_128x64
+ *   ./rpc_screen_delta_bench kaiju.bin [MORE.bin ...]
+ *
+ * Recording is a sequence of 1024 byte frames in display buffer layout, as
+ * sent in ScreenFrame data by legacy stream. Encoder follows
+ * rpc_system_gui_screen_stream_delta_encode, every frame is decoded back
+ * as client would do it and compared with original.
+ */
+
+#include <toolbox/delta_rle.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAME_SIZE (128U * 64U / 8U)
+#define KEYFRAME_INTERVAL (64U)
+
+typedef struct {
+    size_t frames;
+    size_t keyframes;
+    size_t raw_bytes;
+    size_t encoded_bytes;
+    size_t largest;
+    size_t mismatches;
+} Stats;
+
+/* Returns encoded size with type byte, same decisions as firmware */
+static size_t bench_encode(
+    const uint8_t* frame,
+    uint8_t* reference,
+    uint32_t* countdown,
+    uint8_t* output,
+    Stats* stats) {
+    size_t encoded = 0;
+    int keyframe = (*countdown == 0);
+    if(!keyframe) {
+        encoded = delta_rle_encode(frame, reference, FRAME_SIZE, &output[1], FRAME_SIZE / 4);
+        if(!encoded) {
+            size_t keyframe_size = delta_rle_encode(
+                frame, NULL, FRAME_SIZE, &output[1], DELTA_RLE_ENCODED_SIZE_MAX(FRAME_SIZE));
+            encoded =
+                delta_rle_encode(frame, reference, FRAME_SIZE, &output[1], keyframe_size - 1);
+        }
+        keyframe = (encoded == 0);
+    }
+    if(keyframe) {
+        encoded = delta_rle_encode(
+            frame, NULL, FRAME_SIZE, &output[1], DELTA_RLE_ENCODED_SIZE_MAX(FRAME_SIZE));
+        output[0] = 0;
+        *countdown = KEYFRAME_INTERVAL;
+        stats->keyframes++;
+    } else {
+        output[0] = 1;
+        (*countdown)--;
+    }
+    memcpy(reference, frame, FRAME_SIZE);
+    return encoded + 1;
+}
+
+static int bench_file(const char* path, Stats* total) {
+    FILE* file = fopen(path, "rb");
+    if(!file) {
+        perror(path);
+        return 1;
+    }
+
+    Stats stats = {0};
+    uint8_t frame[FRAME_SIZE];
+    uint8_t reference[FRAME_SIZE] = {0};
+    uint8_t client[FRAME_SIZE] = {0};
+    uint8_t output[1 + DELTA_RLE_ENCODED_SIZE_MAX(FRAME_SIZE)];
+    uint32_t countdown = 0;
+
+    while(fread(frame, 1, FRAME_SIZE, file) == FRAME_SIZE) {
+        size_t size = bench_encode(frame, reference, &countdown, output, &stats);
+
+        // Client side, delta applied in place
+        bool ok = delta_rle_decode(
+            &output[1], size - 1, output[0] ? client : NULL, client, FRAME_SIZE);
+        if(!ok || memcmp(client, frame, FRAME_SIZE) != 0) {
+            stats.mismatches++;
+        }
+
+        stats.frames++;
+        stats.raw_bytes += FRAME_SIZE;
+        stats.encoded_bytes += size;
+        if(size > stats.largest) stats.largest = size;
+    }
+    fclose(file);
+
+    printf(
+        "%-32s %5zu frames %4zu keys %8zu -> %7zu bytes, ratio %6.2f, largest %4zu %s\n",
+        path,
+        stats.frames,
+        stats.keyframes,
+        stats.raw_bytes,
+        stats.encoded_bytes,
+        stats.encoded_bytes ? (double)stats.raw_bytes / stats.encoded_bytes : 0.0,
+        stats.largest,
+        stats.mismatches ? "MISMATCH" : "ok");
+
+    total->frames += stats.frames;
+    total->keyframes += stats.keyframes;
+    total->raw_bytes += stats.raw_bytes;
+    total->encoded_bytes += stats.encoded_bytes;
+    total->mismatches += stats.mismatches;
+    if(stats.largest > total->largest) total->largest = stats.largest;
+    return stats.mismatches ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        fprintf(stderr, "Usage: %s RECORDING.bin [RECORDING.bin ...]\n", argv[0]);
+        return 1;
+    }
+
+    Stats total = {0};
+    int result = 0;
+    for(int i = 1; i < argc; i++) {
+        result |= bench_file(argv[i], &total);
+    }
+
+    if(argc > 2) {
+        printf(
+            "%-32s %5zu frames %4zu keys %8zu -> %7zu bytes, ratio %6.2f, largest %4zu %s\n",
+            "total",
+            total.frames,
+            total.keyframes,
+            total.raw_bytes,
+            total.encoded_bytes,
+            total.encoded_bytes ? (double)total.raw_bytes / total.encoded_bytes : 0.0,
+            total.largest,
+            total.mismatches ? "MISMATCH" : "ok");
+    }
+
+    return result;
+}
@@ -0,0 +1,15 @@
+/* Host replacement of furi check.h for Sub-GHz dispatch bench */
+#pragma once
+
+#include <stdlib.h>
+
+#define furi_check(__e) \
+    do {                \
+        if(!(__e)) {    \
+            abort();    \
+        }               \
+    } while(0)
+
+#define furi_assert(__e) furi_check(__e)
+
+#define furi_crash(__message) abort()
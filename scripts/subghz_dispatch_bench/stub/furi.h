@@ -0,0 +1,53 @@
+/* Host replacement of furi.h for Sub-GHz dispatch bench */
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <core/core_defines.h>
+#include <core/check.h>
+
+/* Firmware heap returns zeroed memory and decoders rely on it */
+#define malloc(size) calloc(1, size)
+
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+#define EXT_PATH(path) "/ext/" path
+#define ANY_PATH(path) "/any/" path
+
+/* Strings are only used to describe and save decoded keys, stub.c backs them with a buffer */
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+void furi_string_free(FuriString* string);
+const char* furi_string_get_cstr(const FuriString* string);
+size_t furi_string_size(const FuriString* string);
+void furi_string_set_str(FuriString* string, const char* source);
+void furi_string_set_string(FuriString* string, const FuriString* source);
+#define furi_string_set(string, source) \
+    _Generic(                            \
+        (source),                        \
+        char*: furi_string_set_str,      \
+        const char*: furi_string_set_str, \
+        default: furi_string_set_string)(string, source)
+void furi_string_push_back(FuriString* string, char c);
+bool furi_string_start_with_str(const FuriString* string, const char* start);
+int furi_string_printf(FuriString* string, const char format[], ...);
+int furi_string_cat_printf(FuriString* string, const char format[], ...);
+
+uint32_t furi_get_tick(void);
+void furi_delay_ms(uint32_t milliseconds);
+void furi_thread_yield(void);
+
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
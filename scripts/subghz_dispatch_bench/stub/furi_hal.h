@@ -0,0 +1,8 @@
+/* Host replacement of furi_hal.h for Sub-GHz dispatch bench */
+#pragma once
+
+#include <furi.h>
+/* Firmware furi_hal_subghz.h brings it to the file encoder worker header */
+#include <toolbox/level_duration.h>
+
+uint8_t furi_hal_subghz_get_rolling_counter_mult(void);
@@ -0,0 +1,503 @@
+/* Host versions of the firmware services Sub-GHz decoders link against.
+ *
+ * Decoders only reach storage, files and keystore when a key is described,
+ * saved or sent, never from feed(), so those report failure. Environment
+ * holds the protocol registry and a keystore filled by the bench, indexed
+ * the way subghz_keystore.c does it (that file needs ARM for decryption).
+ */
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <sched.h>
+#include <time.h>
+
+#include <flipper_format/flipper_format.h>
+#include <toolbox/stream/file_stream.h>
+#include <subghz/environment.h>
+#include <subghz/registry.h>
+#include <subghz/subghz_keystore_i.h>
+#include <subghz/subghz_file_encoder_worker.h>
+
+struct FuriString {
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = malloc(sizeof(FuriString));
+    string->capacity = 16;
+    string->data = malloc(string->capacity);
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    free(string->data);
+    free(string);
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+static void furi_string_reserve(FuriString* string, size_t size) {
+    if(size + 1 <= string->capacity) return;
+    while(string->capacity < size + 1) string->capacity *= 2;
+    string->data = realloc(string->data, string->capacity);
+    furi_check(string->data);
+}
+
+void furi_string_set_str(FuriString* string, const char* source) {
+    string->size = strlen(source);
+    furi_string_reserve(string, string->size);
+    memmove(string->data, source, string->size + 1);
+}
+
+void furi_string_set_string(FuriString* string, const FuriString* source) {
+    furi_string_set_str(string, source->data);
+}
+
+void furi_string_push_back(FuriString* string, char c) {
+    furi_string_reserve(string, string->size + 1);
+    string->data[string->size++] = c;
+    string->data[string->size] = '\0';
+}
+
+bool furi_string_start_with_str(const FuriString* string, const char* start) {
+    return strncmp(string->data, start, strlen(start)) == 0;
+}
+
+static int furi_string_vcat_printf(FuriString* string, const char format[], va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int size = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if(size < 0) return size;
+    furi_string_reserve(string, string->size + size);
+    vsnprintf(string->data + string->size, size + 1, format, args);
+    string->size += size;
+    return size;
+}
+
+int furi_string_printf(FuriString* string, const char format[], ...) {
+    string->size = 0;
+    string->data[0] = '\0';
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+int furi_string_cat_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+uint32_t furi_get_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000U + ts.tv_nsec / 1000000U;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    UNUSED(milliseconds);
+}
+
+void furi_thread_yield(void) {
+    sched_yield();
+}
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+    return NULL;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+uint8_t furi_hal_subghz_get_rolling_counter_mult(void) {
+    return 1;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    UNUSED(path);
+    return false;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    UNUSED(path);
+    return false;
+}
+
+/* Environment */
+
+struct SubGhzEnvironment {
+    SubGhzKeystore keystore;
+    const SubGhzProtocolRegistry* protocol_registry;
+};
+
+SubGhzEnvironment* subghz_environment_alloc() {
+    SubGhzEnvironment* instance = malloc(sizeof(SubGhzEnvironment));
+    SubGhzKeyArray_init(instance->keystore.data);
+    instance->keystore.mfname = "";
+    return instance;
+}
+
+static void subghz_keystore_index_clear(SubGhzKeystoreIndex* index) {
+    free(index->key);
+    free(index->type);
+    free(index->name_id);
+    free(index->name);
+    memset(index, 0, sizeof(SubGhzKeystoreIndex));
+}
+
+void subghz_environment_free(SubGhzEnvironment* instance) {
+    subghz_keystore_index_clear(&instance->keystore.index);
+    for
+        M_EACH(manufacture_code, instance->keystore.data, SubGhzKeyArray_t) {
+            furi_string_free(manufacture_code->name);
+        }
+    SubGhzKeyArray_clear(instance->keystore.data);
+    free(instance);
+}
+
+SubGhzKeystore* subghz_environment_get_keystore(SubGhzEnvironment* instance) {
+    return &instance->keystore;
+}
+
+void subghz_environment_set_protocol_registry(
+    SubGhzEnvironment* instance,
+    void* protocol_registry_items) {
+    instance->protocol_registry = protocol_registry_items;
+}
+
+void* subghz_environment_get_protocol_registry(SubGhzEnvironment* instance) {
+    return (void*)instance->protocol_registry;
+}
+
+const char* subghz_environment_get_nice_flor_s_rainbow_table_file_name(
+    SubGhzEnvironment* instance) {
+    UNUSED(instance);
+    return NULL;
+}
+
+const char* subghz_environment_get_alutech_at_4n_rainbow_table_file_name(
+    SubGhzEnvironment* instance) {
+    UNUSED(instance);
+    return NULL;
+}
+
+SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
+    return &instance->data;
+}
+
+const SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance) {
+    SubGhzKeystoreIndex* index = &instance->index;
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(index->count == count) return index;
+
+    subghz_keystore_index_clear(index);
+    index->key = malloc(sizeof(uint64_t) * count);
+    index->type = malloc(sizeof(uint8_t) * count);
+    index->name_id = malloc(sizeof(uint16_t) * count);
+    index->name = malloc(sizeof(const char*) * count);
+    for
+        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
+            const char* name = furi_string_get_cstr(manufacture_code->name);
+            size_t name_id = 0;
+            while(name_id < index->name_count && strcmp(index->name[name_id], name)) {
+                name_id++;
+            }
+            if(name_id == index->name_count) {
+                index->name[index->name_count++] = name;
+            }
+            index->key[index->count] = manufacture_code->key;
+            index->type[index->count] = manufacture_code->type;
+            index->name_id[index->count] = name_id;
+            index->count++;
+        }
+    return index;
+}
+
+bool subghz_keystore_find_name_id(SubGhzKeystore* instance, const char* name, uint16_t* name_id) {
+    const SubGhzKeystoreIndex* index = subghz_keystore_get_index(instance);
+    for(size_t i = 0; i < index->name_count; i++) {
+        if(strcmp(index->name[i], name) == 0) {
+            *name_id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool subghz_keystore_raw_get_data(
+    const char* file_name,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    UNUSED(file_name);
+    UNUSED(offset);
+    UNUSED(data);
+    UNUSED(len);
+    return false;
+}
+
+/* Files and streams */
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return NULL;
+}
+
+void flipper_format_free(FlipperFormat* flipper_format) {
+    UNUSED(flipper_format);
+}
+
+bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
+    UNUSED(flipper_format);
+    UNUSED(path);
+    return false;
+}
+
+bool flipper_format_file_close(FlipperFormat* flipper_format) {
+    UNUSED(flipper_format);
+    return false;
+}
+
+Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
+    UNUSED(flipper_format);
+    return NULL;
+}
+
+bool flipper_format_rewind(FlipperFormat* flipper_format) {
+    UNUSED(flipper_format);
+    return false;
+}
+
+bool flipper_format_write_header_cstr(
+    FlipperFormat* flipper_format,
+    const char* filetype,
+    const uint32_t version) {
+    UNUSED(flipper_format);
+    UNUSED(filetype);
+    UNUSED(version);
+    return false;
+}
+
+bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    return false;
+}
+
+bool flipper_format_write_string_cstr(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const char* data) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    return false;
+}
+
+bool flipper_format_read_uint32(
+    FlipperFormat* flipper_format,
+    const char* key,
+    uint32_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_write_uint32(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const uint32_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_update_uint32(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const uint32_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_write_int32(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const int32_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_read_hex(
+    FlipperFormat* flipper_format,
+    const char* key,
+    uint8_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_write_hex(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const uint8_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_update_hex(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const uint8_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+Stream* file_stream_alloc(Storage* storage) {
+    UNUSED(storage);
+    return NULL;
+}
+
+bool file_stream_open(
+    Stream* stream,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    UNUSED(stream);
+    UNUSED(path);
+    UNUSED(access_mode);
+    UNUSED(open_mode);
+    return false;
+}
+
+bool file_stream_close(Stream* stream) {
+    UNUSED(stream);
+    return false;
+}
+
+void stream_free(Stream* stream) {
+    UNUSED(stream);
+}
+
+void stream_clean(Stream* stream) {
+    UNUSED(stream);
+}
+
+bool stream_seek(Stream* stream, int32_t offset, StreamOffset offset_type) {
+    UNUSED(stream);
+    UNUSED(offset);
+    UNUSED(offset_type);
+    return false;
+}
+
+size_t stream_read(Stream* stream, uint8_t* data, size_t count) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(count);
+    return 0;
+}
+
+bool stream_read_line(Stream* stream, FuriString* str_result) {
+    UNUSED(stream);
+    UNUSED(str_result);
+    return false;
+}
+
+size_t stream_write(Stream* stream, const uint8_t* data, size_t size) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(size);
+    return 0;
+}
+
+size_t stream_write_string(Stream* stream, FuriString* string) {
+    UNUSED(stream);
+    UNUSED(string);
+    return 0;
+}
+
+size_t stream_write_format(Stream* stream, const char* format, ...) {
+    UNUSED(stream);
+    UNUSED(format);
+    return 0;
+}
+
+SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
+    return NULL;
+}
+
+void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+}
+
+void subghz_file_encoder_worker_callback_end(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerCallbackEnd callback_end,
+    void* context_end) {
+    UNUSED(instance);
+    UNUSED(callback_end);
+    UNUSED(context_end);
+}
+
+bool subghz_file_encoder_worker_start(SubGhzFileEncoderWorker* instance, const char* file_path) {
+    UNUSED(instance);
+    UNUSED(file_path);
+    return false;
+}
+
+void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+}
+
+bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+    return false;
+}
+
+LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
+    UNUSED(context);
+    return level_duration_reset();
+}
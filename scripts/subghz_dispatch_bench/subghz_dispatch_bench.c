@@ -0,0 +1,232 @@
+/* Host benchmark of Sub-GHz receiver dispatch on recorded signals.
+ *
+ *   S=../../lib/subghz
+ *   cc -O2 -pthread -I stub -I ../../furi -I ../.. -I ../../lib -I ../../lib/mlib -I $S \
+ *       -o subghz_dispatch_bench subghz_dispatch_bench.c stub/stub.c $S/receiver.c \
+ *       $S/registry.c $S/subghz_raw_binary.c $S/protocols/[a-z]*.c $S/blocks/[a-z]*.c \
+ *       ../../lib/toolbox/manchester_decoder.c ../../lib/toolbox/manchester_encoder.c \
+ *       ../../lib/toolbox/float_tools.c ../../lib/toolbox/varint.c -lm
+ *   ./subghz_dispatch_bench ../../assets/unit_tests/subghz/[a-z]*_raw.sub
+ *
+ * RAW_Data of the given .sub recordings is replayed through every decodable
+ * protocol three ways: the per slot loop receiver used before the dispatch
+ * table, the dispatch table, and the dispatch table with timing pre-screen.
+ * A fourth pass decodes with the pre-screen while another thread keeps
+ * toggling it, like the app changing filters during RX. Every pass must
+ * decode the same keys on the same edges as the per slot loop. stub/
+ * provides host versions of furi, storage and the services decoders link.
+ */
+
+#include <subghz/receiver.h>
+#include <subghz/protocols/protocol_items.h>
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS (16U)
+
+typedef enum {
+    BenchModeLegacy,
+    BenchModeTable,
+    BenchModeTableTiming,
+    BenchModeTableSwap,
+    BenchModeNum,
+} BenchMode;
+
+static const char* const bench_mode_name[BenchModeNum] = {
+    [BenchModeLegacy] = "legacy",
+    [BenchModeTable] = "table",
+    [BenchModeTableTiming] = "table+timing",
+    [BenchModeTableSwap] = "table+swap",
+};
+
+typedef struct {
+    int32_t* items; /* Sign is level, like RAW_Data */
+    size_t count;
+} Edges;
+
+typedef struct {
+    uint32_t decoded;
+    uint32_t edge_keys; /* Sum of keys decoded on current edge */
+    uint32_t digest; /* Digest of keys decoded on every edge, in edge order */
+} BenchResult;
+
+typedef struct {
+    SubGhzReceiver* receiver;
+    bool stop;
+    uint32_t swaps;
+} BenchSwapper;
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool bench_load(Edges* edges, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    char line[4096];
+    size_t capacity = edges->count;
+    while(fgets(line, sizeof(line), file)) {
+        if(strncmp(line, "RAW_Data:", strlen("RAW_Data:"))) continue;
+        char* value = line + strlen("RAW_Data:");
+        char* end;
+        for(long duration; (duration = strtol(value, &end, 10)), end != value; value = end) {
+            if(duration == 0) continue;
+            if(edges->count == capacity) {
+                capacity = capacity ? capacity * 2 : 1024;
+                edges->items = realloc(edges->items, capacity * sizeof(int32_t));
+            }
+            edges->items[edges->count++] = duration;
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static void bench_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    BenchResult* result = context;
+    result->decoded++;
+    /* FNV-1a over protocol name and key hash */
+    uint32_t key = 2166136261U;
+    for(const char* c = decoder_base->protocol->name; *c; c++) {
+        key = (key ^ (uint8_t)*c) * 16777619U;
+    }
+    key = (key ^ subghz_protocol_decoder_base_get_hash_data(decoder_base)) * 16777619U;
+    /* Table is sorted by timing, keys decoded on the same edge may come in another order */
+    result->edge_keys += key;
+}
+
+static void* bench_swapper(void* context) {
+    BenchSwapper* swapper = context;
+    while(!__atomic_load_n(&swapper->stop, __ATOMIC_RELAXED)) {
+        subghz_receiver_set_timing_filter(swapper->receiver, swapper->swaps++ % 2 == 0);
+    }
+    return NULL;
+}
+
+/* Every pass gets its own receiver, some decoders keep state that reset() does not clear */
+static double bench_run(
+    SubGhzEnvironment* environment,
+    const Edges* edges,
+    BenchMode mode,
+    BenchResult* result) {
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_timing_filter(receiver, mode == BenchModeTableTiming);
+
+    // Per slot dispatch the way receiver did it before the dispatch table
+    size_t decoders_count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    SubGhzProtocolDecoderBase** decoders = malloc(sizeof(void*) * decoders_count);
+    for(size_t i = 0; i < decoders_count; i++) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i);
+        decoders[i] = subghz_receiver_search_decoder_base_by_name(receiver, protocol->name);
+    }
+
+    BenchSwapper swapper = {.receiver = receiver, .stop = false, .swaps = 0};
+    pthread_t thread;
+    if(mode == BenchModeTableSwap) {
+        furi_check(pthread_create(&thread, NULL, bench_swapper, &swapper) == 0);
+    }
+
+    memset(result, 0, sizeof(BenchResult));
+    result->digest = 2166136261U;
+    subghz_receiver_set_rx_callback(receiver, bench_rx_callback, result);
+
+    double start = bench_now();
+    for(size_t round = 0; round < ROUNDS; round++) {
+        subghz_receiver_reset(receiver);
+        for(size_t i = 0; i < edges->count; i++) {
+            bool level = edges->items[i] > 0;
+            uint32_t duration = level ? edges->items[i] : -edges->items[i];
+            if(mode == BenchModeLegacy) {
+                for(size_t j = 0; j < decoders_count; j++) {
+                    SubGhzProtocolDecoderBase* decoder = decoders[j];
+                    if(decoder && (decoder->protocol->flag & SubGhzProtocolFlag_Decodable) != 0) {
+                        decoder->protocol->decoder->feed(decoder, level, duration);
+                    }
+                }
+            } else {
+                subghz_receiver_decode(receiver, level, duration);
+            }
+            if(result->edge_keys) {
+                result->digest = (result->digest ^ result->edge_keys ^ i) * 16777619U;
+                result->edge_keys = 0;
+            }
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    if(mode == BenchModeTableSwap) {
+        __atomic_store_n(&swapper.stop, true, __ATOMIC_RELAXED);
+        pthread_join(thread, NULL);
+        printf("  %" PRIu32 " filter swaps during decode\n", swapper.swaps);
+    }
+
+    free(decoders);
+    subghz_receiver_free(receiver);
+
+    return elapsed;
+}
+
+int main(int argc, char** argv) {
+    Edges edges = {0};
+    for(int i = 1; i < argc; i++) {
+        if(!bench_load(&edges, argv[i])) {
+            fprintf(stderr, "Can't load %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if(edges.count == 0) {
+        fprintf(stderr, "Usage: %s <RAW .sub files>\n", argv[0]);
+        return 1;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+
+    printf(
+        "%zu edges from %d files, %zu protocols, %u rounds\n",
+        edges.count,
+        argc - 1,
+        subghz_protocol_registry_count(&subghz_protocol_registry),
+        ROUNDS);
+
+    bool ok = true;
+    BenchResult reference = {0};
+    double reference_time = 0;
+    for(BenchMode mode = 0; mode < BenchModeNum; mode++) {
+        BenchResult result;
+        double elapsed = bench_run(environment, &edges, mode, &result);
+        if(mode == BenchModeLegacy) {
+            reference = result;
+            reference_time = elapsed;
+        }
+        bool match = result.decoded == reference.decoded && result.digest == reference.digest;
+        ok &= match;
+        printf(
+            "%-13s %7.1f ns/edge %5.2fx %6" PRIu32 " decoded digest %08" PRIx32 "%s\n",
+            bench_mode_name[mode],
+            elapsed * 1e9 / (edges.count * ROUNDS),
+            reference_time / elapsed,
+            result.decoded,
+            result.digest,
+            match ? "" : " MISMATCH");
+    }
+
+    subghz_environment_free(environment);
+    free(edges.items);
+
+    return ok ? 0 : 1;
+}
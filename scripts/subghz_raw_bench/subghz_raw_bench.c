@@ -0,0 +1,178 @@
+/* Host benchmark of SubGhz RAW data parsing, text RAW_Data lines vs binary blocks.
+ *
+ *   cc -O2 -iquote ../../lib/subghz -I ../../lib -o subghz_raw_bench \
+ *       subghz_raw_bench.c ../../lib/subghz/subghz_raw_binary.c ../../lib/toolbox/varint.c
+ *   ./subghz_raw_bench [SAMPLES] [SEED]
+ *
+ * Synthetic recording is OOK-like: short and long pulses with jitter and
+ * occasional long gaps, 512 samples per line as written by RAW decoder.
+ * Text parser is the one from subghz_file_encoder_worker.c, binary parser
+ * is block validation and decode as done by the same worker.
+ */
+
+#include "subghz_raw_binary.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SAMPLES_DEFAULT (1000000U)
+#define LINE_SAMPLES (512U)
+#define ROUNDS (8U)
+
+typedef struct {
+    int32_t* data;
+    size_t count;
+} Samples;
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_generate(Samples* samples, size_t count, unsigned seed) {
+    srand(seed);
+    samples->data = malloc(count * sizeof(int32_t));
+    samples->count = count;
+    for(size_t i = 0; i < count; i++) {
+        int32_t duration = (rand() % 4 ? 400 : 1200) + rand() % 100 - 50;
+        if(rand() % 256 == 0) duration = 5000 + rand() % 60000;
+        samples->data[i] = (i % 2) ? -duration : duration;
+    }
+}
+
+static char* bench_text_build(const Samples* samples, size_t* size) {
+    // Up to 8 characters per sample and key per line
+    size_t capacity = samples->count * 8 + (samples->count / LINE_SAMPLES + 1) * 16;
+    char* text = malloc(capacity);
+    size_t offset = 0;
+    for(size_t i = 0; i < samples->count; i += LINE_SAMPLES) {
+        offset += sprintf(&text[offset], "RAW_Data:");
+        for(size_t j = i; j < i + LINE_SAMPLES && j < samples->count; j++) {
+            offset += sprintf(&text[offset], " %" PRId32, samples->data[j]);
+        }
+        text[offset++] = '\n';
+    }
+    text[offset] = '\0';
+    *size = offset;
+    return text;
+}
+
+static uint8_t* bench_binary_build(const Samples* samples, size_t* size) {
+    size_t capacity =
+        (samples->count / LINE_SAMPLES + 1) *
+        (sizeof(SubGhzRawBinaryBlockHeader) + SUBGHZ_RAW_BINARY_PAYLOAD_SIZE_MAX);
+    uint8_t* binary = malloc(capacity);
+    size_t offset = 0;
+    for(size_t i = 0; i < samples->count; i += LINE_SAMPLES) {
+        size_t count = samples->count - i < LINE_SAMPLES ? samples->count - i : LINE_SAMPLES;
+        offset += subghz_raw_binary_block_encode(&samples->data[i], count, &binary[offset]);
+    }
+    *size = offset;
+    return binary;
+}
+
+/* Same algorithm as subghz_file_encoder_worker_data_parse, line is copied
+ * out first as stream_read_line does */
+static size_t bench_text_parse(const char* text, size_t size, int32_t* output) {
+    size_t count = 0;
+    const char* end = text + size;
+    char* line = malloc(LINE_SAMPLES * 8 + 16);
+    while(text < end) {
+        const char* eol = memchr(text, '\n', end - text);
+        size_t length = eol ? (size_t)(eol - text) : (size_t)(end - text);
+        memcpy(line, text, length);
+        line[length] = '\0';
+        text += length + 1;
+
+        char* str1 = strstr(line, "RAW_Data: ");
+        if(str1 == NULL) break;
+        str1 = strchr(str1, ' ');
+        while(strchr(str1, ' ') != NULL) {
+            str1 = strchr(str1, ' ');
+            str1 += 1;
+            output[count++] = atoi(str1);
+        }
+    }
+    free(line);
+    return count;
+}
+
+static size_t bench_binary_parse(const uint8_t* binary, size_t size, int32_t* output) {
+    size_t count = 0;
+    size_t offset = 0;
+    while(offset + sizeof(SubGhzRawBinaryBlockHeader) <= size) {
+        SubGhzRawBinaryBlockHeader header;
+        memcpy(&header, &binary[offset], sizeof(header));
+        offset += sizeof(header);
+        if(!subghz_raw_binary_block_header_is_valid(&header) ||
+           offset + header.payload_size > size ||
+           !subghz_raw_binary_block_decode(&header, &binary[offset], &output[count])) {
+            fprintf(stderr, "Broken block at %zu\n", offset);
+            break;
+        }
+        offset += header.payload_size;
+        count += header.sample_count;
+    }
+    return count;
+}
+
+static void bench_report(
+    const char* name,
+    const Samples* samples,
+    size_t size,
+    double elapsed,
+    const int32_t* output,
+    size_t count) {
+    bool match = count == samples->count &&
+                 memcmp(output, samples->data, count * sizeof(int32_t)) == 0;
+    double rate = samples->count * ROUNDS / elapsed;
+    printf(
+        "%-7s %10zu bytes %6.2f bytes/sample %8.2f Msamples/s %s\n",
+        name,
+        size,
+        (double)size / samples->count,
+        rate / 1e6,
+        match ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 0) : SAMPLES_DEFAULT;
+    unsigned seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    if(count == 0) {
+        fprintf(stderr, "Usage: %s [SAMPLES] [SEED]\n", argv[0]);
+        return 1;
+    }
+
+    Samples samples;
+    bench_generate(&samples, count, seed);
+
+    size_t text_size = 0;
+    size_t binary_size = 0;
+    char* text = bench_text_build(&samples, &text_size);
+    uint8_t* binary = bench_binary_build(&samples, &binary_size);
+    int32_t* output = malloc(count * sizeof(int32_t));
+
+    size_t parsed = 0;
+    double start = bench_now();
+    for(size_t i = 0; i < ROUNDS; i++) {
+        parsed = bench_text_parse(text, text_size, output);
+    }
+    bench_report("text", &samples, text_size, bench_now() - start, output, parsed);
+
+    memset(output, 0, count * sizeof(int32_t));
+    start = bench_now();
+    for(size_t i = 0; i < ROUNDS; i++) {
+        parsed = bench_binary_parse(binary, binary_size, output);
+    }
+    bench_report("binary", &samples, binary_size, bench_now() - start, output, parsed);
+
+    free(output);
+    free(binary);
+    free(text);
+    free(samples.data);
+    return 0;
+}
@@ -0,0 +1,5 @@
+/* Host replacement of furi common_defines.h for SubGhz transmitter bench */
+#pragma once
+
+#include <stdbool.h>
+#include <core/core_defines.h>
@@ -0,0 +1,165 @@
+/* Host replacement of furi string.h for SubGhz transmitter bench, only what FlipperFormat,
+ * streams and static protocols use */
+#pragma once
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define FURI_STRING_FAILURE ((size_t)-1)
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} FuriString;
+
+static inline void furi_string_reserve_size(FuriString* string, size_t size) {
+    if(size + 1 > string->capacity) {
+        string->capacity = (size + 1) * 2;
+        string->data = realloc(string->data, string->capacity);
+    }
+}
+
+static inline FuriString* furi_string_alloc(void) {
+    FuriString* string = calloc(1, sizeof(FuriString));
+    furi_string_reserve_size(string, 16);
+    string->data[0] = '\0';
+    return string;
+}
+
+static inline void furi_string_free(FuriString* string) {
+    free(string->data);
+    free(string);
+}
+
+static inline const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+static inline size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+static inline void furi_string_reset(FuriString* string) {
+    string->size = 0;
+    string->data[0] = '\0';
+}
+
+static inline char furi_string_get_char(const FuriString* string, size_t index) {
+    return string->data[index];
+}
+
+static inline void furi_string_set_char(FuriString* string, size_t index, const char c) {
+    string->data[index] = c;
+}
+
+static inline void furi_string_push_back(FuriString* string, char c) {
+    furi_string_reserve_size(string, string->size + 1);
+    string->data[string->size++] = c;
+    string->data[string->size] = '\0';
+}
+
+static inline void furi_string_cat_str(FuriString* string, const char cstr[]) {
+    size_t length = strlen(cstr);
+    furi_string_reserve_size(string, string->size + length);
+    memcpy(string->data + string->size, cstr, length + 1);
+    string->size += length;
+}
+
+static inline void furi_string_cat_string(FuriString* string, const FuriString* source) {
+    furi_string_cat_str(string, source->data);
+}
+
+static inline void furi_string_set_str(FuriString* string, const char cstr[]) {
+    furi_string_reset(string);
+    furi_string_cat_str(string, cstr);
+}
+
+static inline void furi_string_set_string(FuriString* string, const FuriString* source) {
+    furi_string_set_str(string, source->data);
+}
+
+static inline int furi_string_cat_vprintf(FuriString* string, const char format[], va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    furi_string_reserve_size(string, string->size + length);
+    vsnprintf(string->data + string->size, length + 1, format, args);
+    string->size += length;
+    return length;
+}
+
+static inline int furi_string_cat_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    int length = furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+static inline int furi_string_printf(FuriString* string, const char format[], ...) {
+    furi_string_reset(string);
+    va_list args;
+    va_start(args, format);
+    int length = furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+static inline FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
+    FuriString* string = furi_string_alloc();
+    furi_string_cat_vprintf(string, format, args);
+    return string;
+}
+
+static inline FuriString* furi_string_alloc_set_str(const char cstr[]) {
+    FuriString* string = furi_string_alloc();
+    furi_string_set_str(string, cstr);
+    return string;
+}
+
+static inline void furi_string_left(FuriString* string, size_t index) {
+    if(index < string->size) {
+        string->size = index;
+        string->data[index] = '\0';
+    }
+}
+
+static inline void furi_string_replace_at(
+    FuriString* string,
+    size_t pos,
+    size_t len,
+    const char replace[]) {
+    FuriString* tail = furi_string_alloc_set_str(string->data + pos + len);
+    furi_string_left(string, pos);
+    furi_string_cat_str(string, replace);
+    furi_string_cat_str(string, tail->data);
+    furi_string_free(tail);
+}
+
+static inline int furi_string_cmp_str(const FuriString* string, const char cstr[]) {
+    return strcmp(string->data, cstr);
+}
+
+static inline int furi_string_cmpi_str(const FuriString* string, const char cstr[]) {
+    return strcasecmp(string->data, cstr);
+}
+
+#define FURI_STRING_SELECT(func_string, func_cstr, b) \
+    _Generic((b), char*: func_cstr, const char*: func_cstr, default: func_string)
+
+#define furi_string_set(a, b) \
+    FURI_STRING_SELECT(furi_string_set_string, furi_string_set_str, b)(a, b)
+#define furi_string_cat(a, b) \
+    FURI_STRING_SELECT(furi_string_cat_string, furi_string_cat_str, b)(a, b)
+#define furi_string_cmp(a, b) furi_string_cmp_str(a, b)
+#define furi_string_cmpi(a, b) furi_string_cmpi_str(a, b)
+#define furi_string_alloc_set(a) furi_string_alloc_set_str(a)
@@ -0,0 +1,26 @@
+/* Host replacement of furi.h for SubGhz transmitter bench */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/core_defines.h>
+#include <core/check.h>
+#include <core/string.h>
+
+/* Firmware heap returns zeroed memory and library code relies on it */
+#define malloc(size) calloc(1, size)
+
+/* Comes from newlib sys/cdefs.h on target */
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
+
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_W(tag, ...)
@@ -0,0 +1,2 @@
+/* Host replacement of furi_hal.h for SubGhz transmitter bench, encoders don't touch hardware */
+#pragma once
@@ -0,0 +1,4 @@
+/* Host replacement of mlib m-array.h for SubGhz transmitter bench, keystore is not used */
+#pragma once
+
+#define ARRAY_DEF(name, type, oplist) typedef struct name##_s* name##_t;
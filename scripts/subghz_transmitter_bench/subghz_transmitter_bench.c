@@ -0,0 +1,257 @@
+/* Host benchmark of Sub-GHz brute force key stepping through SubGhzTransmitter.
+ *
+ *   cc -O2 -ffunction-sections -Wl,--gc-sections -I stub -I ../../furi -I ../../lib -I ../.. \
+ *       -o subghz_transmitter_bench subghz_transmitter_bench.c \
+ *       ../../lib/subghz/transmitter.c ../../lib/subghz/registry.c \
+ *       ../../lib/subghz/environment.c ../../lib/subghz/blocks/[dgem]*.c \
+ *       ../../lib/subghz/protocols/{came,nice_flo,princeton,gate_tx}.c \
+ *       ../../lib/flipper_format/flipper_format*.c ../../lib/toolbox/hex.c \
+ *       ../../lib/toolbox/stream/stream.c ../../lib/toolbox/stream/string_stream.c
+ *   ./subghz_transmitter_bench [KEYS]
+ *
+ * Every key is rendered and its upload drained through subghz_transmitter_yield three ways:
+ * text FlipperFormat and a new transmitter per key as brute force did before,
+ * subghz_transmitter_set_key on one transmitter, and subghz_transmitter_queue_key that
+ * renders the next key while the current one is yielded. All ways must produce the same
+ * level and duration stream. GateTX has no set_key and goes through the FlipperFormat
+ * fallback of the transmitter. stub/ provides host versions of furi headers.
+ */
+
+#include <lib/subghz/transmitter.h>
+#include <lib/subghz/registry.h>
+#include <lib/subghz/protocols/came.h>
+#include <lib/subghz/protocols/gate_tx.h>
+#include <lib/subghz/protocols/nice_flo.h>
+#include <lib/subghz/protocols/princeton.h>
+#include <lib/flipper_format/flipper_format_i.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KEYS_DEFAULT (4096U)
+#define ROUNDS (8U)
+#define REPEAT (3U)
+
+typedef struct {
+    const char* name;
+    uint16_t bits;
+    uint32_t te;
+} BenchProtocol;
+
+typedef struct {
+    uint64_t hash;
+    uint64_t duration;
+    size_t count;
+} BenchStream;
+
+typedef bool (*BenchRun)(
+    SubGhzEnvironment* environment,
+    const BenchProtocol* protocol,
+    size_t keys,
+    BenchStream* stream);
+
+static const SubGhzProtocol* bench_protocol_items[] = {
+    &subghz_protocol_came,
+    &subghz_protocol_nice_flo,
+    &subghz_protocol_princeton,
+    &subghz_protocol_gate_tx,
+};
+
+static const SubGhzProtocolRegistry bench_protocol_registry = {
+    .items = bench_protocol_items,
+    .size = sizeof(bench_protocol_items) / sizeof(bench_protocol_items[0]),
+};
+
+static const BenchProtocol bench_protocols[] = {
+    {SUBGHZ_PROTOCOL_CAME_NAME, 12, 0},
+    {SUBGHZ_PROTOCOL_NICE_FLO_NAME, 12, 0},
+    {SUBGHZ_PROTOCOL_PRINCETON_NAME, 24, 400},
+    {SUBGHZ_PROTOCOL_GATE_TX_NAME, 24, 0},
+};
+
+/* Keystore is used by dynamic protocols only */
+SubGhzKeystore* subghz_keystore_alloc() {
+    return NULL;
+}
+
+void subghz_keystore_free(SubGhzKeystore* instance) {
+    UNUSED(instance);
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_key(const BenchProtocol* protocol, size_t index) {
+    return (index * 0x9E3779B97F4A7C15ULL) >> (64 - protocol->bits);
+}
+
+/* Yields until the end of the upload or until the queued key is taken */
+static void bench_drain(SubGhzTransmitter* transmitter, BenchStream* stream, bool until_queued) {
+    while(!until_queued || subghz_transmitter_is_key_queued(transmitter)) {
+        LevelDuration level_duration = subghz_transmitter_yield(transmitter);
+        if(level_duration_is_reset(level_duration)) break;
+
+        uint32_t duration = level_duration_get_duration(level_duration);
+        stream->hash = (stream->hash ^ duration ^ level_duration_get_level(level_duration)) *
+                       0x100000001B3ULL;
+        stream->duration += duration;
+        stream->count++;
+    }
+}
+
+/* Same payload as brute force app generated for every step */
+static bool bench_run_text(
+    SubGhzEnvironment* environment,
+    const BenchProtocol* protocol,
+    size_t keys,
+    BenchStream* stream) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* text = flipper_format_get_raw_stream(flipper_format);
+    bool result = true;
+
+    for(size_t i = 0; i < keys && result; i++) {
+        uint64_t key = bench_key(protocol, i);
+        char key_text[3 * sizeof(uint64_t) + 1];
+        for(size_t j = 0; j < sizeof(uint64_t); j++) {
+            snprintf(&key_text[3 * j], 4, "%02X ", (uint8_t)(key >> 8 * (7 - j)));
+        }
+        key_text[3 * sizeof(uint64_t) - 1] = '\0';
+
+        stream_clean(text);
+        if(protocol->te) {
+            stream_write_format(
+                text,
+                "Bit: %d\nKey: %s\nTE: %d\nRepeat: %d\n",
+                protocol->bits,
+                key_text,
+                (int)protocol->te,
+                REPEAT);
+        } else {
+            stream_write_format(
+                text, "Bit: %d\nKey: %s\nRepeat: %d\n", protocol->bits, key_text, REPEAT);
+        }
+        flipper_format_rewind(flipper_format);
+
+        SubGhzTransmitter* transmitter =
+            subghz_transmitter_alloc_init(environment, protocol->name);
+        result = subghz_transmitter_deserialize(transmitter, flipper_format) ==
+                 SubGhzProtocolStatusOk;
+        bench_drain(transmitter, stream, false);
+        subghz_transmitter_free(transmitter);
+    }
+
+    flipper_format_free(flipper_format);
+    return result;
+}
+
+static bool bench_run_set_key(
+    SubGhzEnvironment* environment,
+    const BenchProtocol* protocol,
+    size_t keys,
+    BenchStream* stream) {
+    SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment, protocol->name);
+    bool result = true;
+
+    for(size_t i = 0; i < keys && result; i++) {
+        result = subghz_transmitter_set_key(
+                     transmitter, bench_key(protocol, i), protocol->bits, protocol->te, REPEAT) ==
+                 SubGhzProtocolStatusOk;
+        bench_drain(transmitter, stream, false);
+    }
+
+    subghz_transmitter_free(transmitter);
+    return result;
+}
+
+static bool bench_run_queue_key(
+    SubGhzEnvironment* environment,
+    const BenchProtocol* protocol,
+    size_t keys,
+    BenchStream* stream) {
+    SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment, protocol->name);
+    bool result = subghz_transmitter_set_key(
+                      transmitter, bench_key(protocol, 0), protocol->bits, protocol->te, REPEAT) ==
+                  SubGhzProtocolStatusOk;
+
+    for(size_t i = 1; i < keys && result; i++) {
+        result = subghz_transmitter_queue_key(
+                     transmitter, bench_key(protocol, i), protocol->bits, protocol->te, REPEAT) ==
+                 SubGhzProtocolStatusOk;
+        bench_drain(transmitter, stream, true);
+    }
+    bench_drain(transmitter, stream, false);
+
+    subghz_transmitter_free(transmitter);
+    return result;
+}
+
+static double bench_measure(
+    BenchRun run,
+    SubGhzEnvironment* environment,
+    const BenchProtocol* protocol,
+    size_t keys,
+    BenchStream* stream,
+    bool* result) {
+    double best = 0;
+    for(size_t round = 0; round < ROUNDS; round++) {
+        BenchStream round_stream = {0};
+        double start = bench_now();
+        *result = run(environment, protocol, keys, &round_stream) && *result;
+        double elapsed = bench_now() - start;
+        if(round == 0 || elapsed < best) best = elapsed;
+        *stream = round_stream;
+    }
+    return keys / best;
+}
+
+int main(int argc, char** argv) {
+    size_t keys = argc > 1 ? strtoul(argv[1], NULL, 0) : KEYS_DEFAULT;
+    if(keys == 0) {
+        fprintf(stderr, "Usage: %s [KEYS]\n", argv[0]);
+        return 1;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&bench_protocol_registry);
+    bool match = true;
+
+    printf("protocol     set_key  text keys/s  set_key keys/s  queue keys/s  air ms/key\n");
+    for(size_t i = 0; i < sizeof(bench_protocols) / sizeof(bench_protocols[0]); i++) {
+        const BenchProtocol* protocol = &bench_protocols[i];
+        const SubGhzProtocol* item =
+            subghz_protocol_registry_get_by_name(&bench_protocol_registry, protocol->name);
+        BenchStream text, set_key, queue_key;
+        bool result = true;
+
+        double text_rate =
+            bench_measure(bench_run_text, environment, protocol, keys, &text, &result);
+        double set_key_rate =
+            bench_measure(bench_run_set_key, environment, protocol, keys, &set_key, &result);
+        double queue_key_rate =
+            bench_measure(bench_run_queue_key, environment, protocol, keys, &queue_key, &result);
+
+        bool protocol_match = result && text.count && (text.hash == set_key.hash) &&
+                              (text.count == set_key.count) && (text.hash == queue_key.hash) &&
+                              (text.count == queue_key.count);
+        printf(
+            "%-12s %-7s %12.0f %15.0f %13.0f %11.1f%s\n",
+            protocol->name,
+            item->encoder->set_key ? "yes" : "no",
+            text_rate,
+            set_key_rate,
+            queue_key_rate,
+            text.duration / 1e3 / keys,
+            protocol_match ? "" : "  MISMATCH");
+        match = match && protocol_match;
+    }
+
+    subghz_environment_free(environment);
+    printf("%zu keys per protocol %s\n", keys, match ? "ok" : "MISMATCH");
+    return match ? 0 : 1;
+}